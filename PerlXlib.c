@@ -4,11 +4,16 @@
 #include "ppport.h"
 
 #include <X11/Xlib.h>
+#include <X11/Xlibint.h>
 #include <X11/Xutil.h>
+#include <X11/XKBlib.h>
 #include <X11/extensions/XTest.h>
 #ifdef HAVE_XRENDER
 #include <X11/extensions/Xrender.h>
 #endif
+#ifdef HAVE_XI
+#include <X11/extensions/XInput2.h>
+#endif
 
 #include "PerlXlib.h"
 
@@ -18,9 +23,9 @@
 #define AUTOCREATE PerlXlib_AUTOCREATE
 
 static const char* T_DISPLAY= "Display";
-static const char* OBJ_CACHE_NAME= "X11::Xlib::_obj_cache";
 
 static struct PerlXlib_fields* PerlXlib_get_magic_fields(SV *sv, int create_flag);
+static int PerlXlib_is_struct_view(SV *sv);
 
 /*-----------------------------------------------------------------------------------
  * This struct is attached to each of the X11::Xlib objects that reference C structs.
@@ -31,10 +36,14 @@ struct PerlXlib_fields {
     void *ptr;             /* struct/opaque pointer to something in xlib */
     const char *ptr_type;  /* static string identifying the type of the object */
     int xfree_cleanup: 1;  /* whether to call XFree(ptr) during destructor */
+    unsigned cache_conn: 1; /* whether it is in the connection registry */
+    void *cache_key;       /* pointer this object is registered under in the object cache */
     struct PerlXlib_fields *parent; /* Object whose ->ptr owns the lifespan of this ->ptr */
     AV *dependents;        /* weak references to X11::Xlib objects whose ptr depends on this object */
 };
 
+#include "obj_cache.c"
+
 static void PerlXlib_fields_init(struct PerlXlib_fields *fields, SV *self) {
     Zero(fields, 1, struct PerlXlib_fields);
     fields->self= self;
@@ -45,27 +54,14 @@ static void PerlXlib_fields_init(struct PerlXlib_fields *fields, SV *self) {
  * obj is the *inner* SV/HV/AV of the object not a RV pointing to it.
  */
 static void PerlXlib_fields_set_ptr(struct PerlXlib_fields *fields, void *ptr, const char *type) {
-    HV *cache= NULL;
-    SV **ent, *sv;
     if (fields->ptr == ptr)
         return; /* nothing to do */
-    if (fields->ptr) { /* remove any previous object from cache */
-        cache= get_hv(OBJ_CACHE_NAME, GV_ADD);
-        hv_delete(cache, (void*) &fields->ptr, sizeof(void*), G_DISCARD);
-    }
+    PerlXlib_fields_uncache(fields); /* remove any previous object from cache */
     fields->ptr= ptr;
     fields->ptr_type= ptr? type : NULL;
     fields->xfree_cleanup= 0;
-    if (fields->self && fields->ptr) {
-        if (!cache) cache= get_hv(OBJ_CACHE_NAME, GV_ADD);
-        sv= newRV_inc(fields->self); /* create new weak-ref to the object */
-        sv_rvweaken(sv);
-        ent= hv_store(cache, (void*) &fields->ptr, sizeof(void*), sv, 0);
-        if (!ent) {
-            sv_2mortal(sv);
-            croak("Can't cache X11 wrapper object into %s", OBJ_CACHE_NAME);
-        }
-    }
+    if (fields->self && fields->ptr)
+        PerlXlib_fields_cache(fields, ptr, type == T_DISPLAY);
 }
 
 /* Set 'fields' as the parent of 'dep', adding a weak-ref to 'dep' in the dependents list.
@@ -133,12 +129,20 @@ static void PerlXlib_fields_invalidate_dependents(struct PerlXlib_fields *fields
 
 /* Called automatically when the magic-bearing object is freed */
 static void PerlXlib_fields_free(struct PerlXlib_fields *fields) {
+    /* a display object can be freed with its stats or tracing still enabled */
+    if (fields->self) {
+        if (PerlXlib_display_stats_active)
+            PerlXlib_display_stats_release(fields->self);
+        PerlXlib_trace_release(fields->self);
+    }
     /* un-set the ->ptr, which by extension removes the containing object from the object cache */
     if (fields->ptr) {
         if (fields->xfree_cleanup)
             XFree(fields->ptr);
         PerlXlib_fields_set_ptr(fields, NULL, NULL);
     }
+    /* a dead connection can still be registered without a ->ptr */
+    PerlXlib_fields_uncache(fields);
     /* release the reference to the X11::Xlib instance if this object was holding one */
     if (fields->display_sv) {
         sv_2mortal(fields->display_sv);
@@ -225,19 +229,14 @@ static struct PerlXlib_fields* PerlXlib_get_magic_fields(SV *sv, int create_flag
 extern SV * PerlXlib_get_objref(void *thing, int create_flag,
     const char *thing_type, int svtype, const char *thing_class, void *parent
 ) {
-    HV *cache, *pkg;
+    HV *pkg;
     GV *build_method;
-    AV *isa;
-    SV **ent, *ret, *parent_objref;
+    SV *cached, *ret, *parent_objref;
     struct PerlXlib_fields *f, *parent_fields;
 
-    if (thing) {
-        ent= hv_fetch(get_hv(OBJ_CACHE_NAME, GV_ADD), (void*) &thing, sizeof(thing), 0);
-        /* Return existing object?  It's a weak-ref, so check that it still points to something. */
-        if (ent && SvROK(*ent))
-            /* create strong-ref from weakref */
-            return sv_mortalcopy(*ent);
-    }
+    /* Return existing object?  The cache doesn't hold a reference, so make a strong one */
+    if (thing && (cached= PerlXlib_obj_cache_find(thing)))
+        return sv_2mortal(newRV_inc(cached));
 
     if (create_flag == OR_NULL)
         return NULL;
@@ -272,7 +271,7 @@ extern SV * PerlXlib_get_objref(void *thing, int create_flag,
         croak("Unsupported svtype in PerlXlib_get_obj_for_ptr");
 
     f= PerlXlib_get_magic_fields(SvRV(ret), AUTOCREATE);
-    PerlXlib_fields_set_ptr(f, thing, thing_type); /* adds weak-ref to cache */
+    PerlXlib_fields_set_ptr(f, thing, thing_type); /* adds it to the cache */
     /* If there is an owner, add this object to the owner's list */
     if (parent) {
         parent_objref= PerlXlib_get_objref(parent, OR_NULL, NULL, 0, NULL, NULL);
@@ -335,6 +334,22 @@ extern void PerlXlib_objref_set_pointer(SV *objref, void *pointer, const char *p
     PerlXlib_fields_set_ptr(f, pointer, ptr_type);
 }
 
+/* Register an object under a pointer it doesn't (or no longer) wrap, like a
+ * dead connection which should still be found by its Display*.  The entry is
+ * removed when the object is freed or gets a pointer.
+ */
+extern void PerlXlib_objref_cache_pointer(SV *objref, void *pointer) {
+    struct PerlXlib_fields *f;
+    if (!sv_isobject(objref))
+        croak("Not an object");
+    f= PerlXlib_get_magic_fields(SvRV(objref), AUTOCREATE);
+    if (f->ptr)
+        croak("Object already has a pointer");
+    PerlXlib_fields_uncache(f);
+    if (pointer)
+        PerlXlib_fields_cache(f, pointer, sv_derived_from(objref, "X11::Xlib"));
+}
+
 /* Same as PerlXlib_get_objref, but with a few special cases.
  * When given a pointer and the create flag is false, this returns the pointer as an integer.
  * This handles cases like returning the event->display field which might have been corrupted with
@@ -501,6 +516,8 @@ void PerlXlib_sanity_check_data_structures() {
     Display *dpy;
     void *opaque;
     
+    PerlXlib_obj_cache_check();
+
     dpys= get_hv("X11::Xlib::_connections", GV_ADD);
     /*hv_assert(dpys);*/
     
@@ -551,12 +568,10 @@ void PerlXlib_sanity_check_data_structures() {
  *   Annoyingly, Xlib doesn't seem to have any way to query the size of the struct,
  *   only allocate it.
  * Instead of using XAllocFoo sillyness (and the memory management hassle it
- *   would cause), just pad the struct with some extra bytes.
+ *   would cause), just pad the struct with some extra bytes
+ *   (X11_Xlib_Struct_Padding, defined in PerlXlib.h).
  * Perl modules will probably always be compiled fresh anyway.
  */
-#ifndef X11_Xlib_Struct_Padding
-#define X11_Xlib_Struct_Padding 64
-#endif
 /* Coercions allowed for RValue:
  *   foo( "buffer_of_the_correct_length_or_more" );
  *   foo( \"ref_to_buffer_of_the_correct_length_or_more" );
@@ -623,12 +638,282 @@ void* PerlXlib_get_struct_ptr(SV *sv, int lvalue, const char* pkg, int struct_si
         croak("Paramters requiring %s can only be coerced from string, string ref, hashref, or undef", pkg);
     else if (SvCUR(sv) < struct_size)
         croak("Scalars used as %s must be at least length %d (got %d)", pkg, (int) struct_size, (int) SvCUR(sv));
+    /* Element views of a StructArray already have padding (or the next element)
+     * after them, and must keep pointing into the array */
+    else if (SvLEN(sv) == 0 && PerlXlib_is_struct_view(sv))
+        return SvPVX(sv);
     /* Make sure we have the padding even if the user tinkered with the buffer */
     SvPV_force(sv, n);
     SvGROW(sv, struct_size+X11_Xlib_Struct_Padding);
     return SvPVX(sv);
 }
 
+/* Coercions allowed for arrays of structs (always RValue):
+ *   foo( $packed_structs );    # length must be a multiple of the struct size
+ *   foo( \$packed_structs );
+ *   foo( [ $struct_obj, \%fields, [ $x, $y, ... ], ... ] );
+ * The arrayref form is converted into one mortal buffer.  Plain arrayref elements
+ * are only supported for the Xlib shape structs (XPoint, XSegment, XRectangle, XArc)
+ * whose fields are all 16 bits wide, and are given in the order of the C struct.
+ */
+/* Store one element of a struct array into 'dst', from a struct object, hashref,
+ * or arrayref of 16-bit field values.
+ */
+static void PerlXlib_struct_array_elem(SV *elem, char *dst, const char* pkg, int struct_size, int n_fields,
+    PerlXlib_struct_pack_fn *packer, int i
+) {
+    short *fields;
+    int j;
+    if (SvROK(elem) && SvTYPE(SvRV(elem)) == SVt_PVAV) {
+        if (av_len((AV*) SvRV(elem)) + 1 != n_fields)
+            croak("Element %d of %s array should have %d values", i, pkg, n_fields);
+        fields= (short*) dst;
+        for (j= 0; j < n_fields; j++) {
+            SV **v= av_fetch((AV*) SvRV(elem), j, 0);
+            fields[j]= (v && *v)? (short) SvIV(*v) : 0;
+        }
+    }
+    else if (SvROK(elem) && SvTYPE(SvRV(elem)) == SVt_PVHV && !packer)
+        croak("Element %d of %s array can't be a hashref", i, pkg);
+    else
+        memcpy(dst, PerlXlib_get_struct_ptr(elem, 0, pkg, struct_size, packer), struct_size);
+}
+
+void* PerlXlib_get_struct_array(SV *sv, const char* pkg, int struct_size, int n_fields,
+    PerlXlib_struct_pack_fn *packer, int *count
+) {
+    SV *tmp, **elem;
+    AV *av;
+    char *buf;
+    STRLEN n;
+    int i, len;
+    PerlXlib_struct_array *arr;
+
+    /* A StructArray of the right type is used in-place */
+    if (sv_isobject(sv) && (arr= PerlXlib_get_struct_array_info(sv, 0))) {
+        if (strcmp(arr->type->pkg, pkg) != 0)
+            croak("Expected %s array, but got array of %s", pkg, arr->type->pkg);
+        *count= SvCUR(SvRV(sv)) / struct_size;
+        return SvPVX(SvRV(sv));
+    }
+    if (SvROK(sv) && SvTYPE(SvRV(sv)) == SVt_PVAV) {
+        av= (AV*) SvRV(sv);
+        len= av_len(av) + 1;
+        tmp= sv_2mortal(newSV(len * struct_size + 1));
+        buf= SvPVX(tmp);
+        memset(buf, 0, len * struct_size);
+        for (i= 0; i < len; i++) {
+            elem= av_fetch(av, i, 0);
+            if (!elem || !*elem)
+                croak("Element %d of %s array is undefined", i, pkg);
+            PerlXlib_struct_array_elem(*elem, buf + i * struct_size, pkg, struct_size, n_fields, packer, i);
+        }
+        *count= len;
+        return buf;
+    }
+    if (SvROK(sv) && !sv_isobject(sv) && SvTYPE(SvRV(sv)) < SVt_PVAV)
+        sv= SvRV(sv);
+    if (SvROK(sv) || !SvOK(sv))
+        croak("Expected packed string or arrayref of %s", pkg);
+    buf= SvPVbyte(sv, n);
+    if (n % struct_size)
+        croak("Length of packed %s array (%ld) is not a multiple of %d", pkg, (long) n, struct_size);
+    *count= n / struct_size;
+    return buf;
+}
+
+/*----------------------------------------------------------------------------------------
+ * X11::Xlib::StructArray
+ *
+ * The object is a blessed scalar ref whose buffer holds 'count' structs back to
+ * back, followed by X11_Xlib_Struct_Padding bytes.  Magic on the buffer SV
+ * records the element type and how many element views are alive.  A view is an
+ * ordinary struct object whose PV points into the array's buffer (with SvLEN 0,
+ * so perl never frees or reallocates it) and whose magic holds a reference to
+ * the array's buffer SV to keep it alive.  The buffer may not be reallocated
+ * while views exist.
+ */
+
+static const PerlXlib_struct_type PerlXlib_struct_types[]= {
+    { "X11::Xlib::XEvent",                   sizeof(XEvent),                   0, (PerlXlib_struct_pack_fn*) &PerlXlib_XEvent_pack },
+    { "X11::Xlib::XVisualInfo",              sizeof(XVisualInfo),              0, (PerlXlib_struct_pack_fn*) &PerlXlib_XVisualInfo_pack },
+    { "X11::Xlib::XWindowChanges",           sizeof(XWindowChanges),           0, (PerlXlib_struct_pack_fn*) &PerlXlib_XWindowChanges_pack },
+    { "X11::Xlib::XWindowAttributes",        sizeof(XWindowAttributes),        0, (PerlXlib_struct_pack_fn*) &PerlXlib_XWindowAttributes_pack },
+    { "X11::Xlib::XSetWindowAttributes",     sizeof(XSetWindowAttributes),     0, (PerlXlib_struct_pack_fn*) &PerlXlib_XSetWindowAttributes_pack },
+    { "X11::Xlib::XSizeHints",               sizeof(XSizeHints),               0, (PerlXlib_struct_pack_fn*) &PerlXlib_XSizeHints_pack },
+    { "X11::Xlib::XRectangle",               sizeof(XRectangle),               4, (PerlXlib_struct_pack_fn*) &PerlXlib_XRectangle_pack },
+    { "X11::Xlib::XGCValues",                sizeof(XGCValues),                0, (PerlXlib_struct_pack_fn*) &PerlXlib_XGCValues_pack },
+    { "X11::Xlib::XRenderPictFormat",        sizeof(XRenderPictFormat),        0, (PerlXlib_struct_pack_fn*) &PerlXlib_XRenderPictFormat_pack },
+    { "X11::Xlib::XRenderPictureAttributes", sizeof(XRenderPictureAttributes), 0, (PerlXlib_struct_pack_fn*) &PerlXlib_XRenderPictureAttributes_pack },
+    { "X11::Xlib::XRenderColor",             sizeof(XRenderColor),             4, (PerlXlib_struct_pack_fn*) &PerlXlib_XRenderColor_pack },
+    { "X11::Xlib::XGlyphInfo",               sizeof(XGlyphInfo),               6, (PerlXlib_struct_pack_fn*) &PerlXlib_XGlyphInfo_pack },
+    { NULL, 0, 0, NULL }
+};
+
+/* Look up a struct type by package name, with or without the "X11::Xlib::" prefix */
+const PerlXlib_struct_type* PerlXlib_find_struct_type(const char *pkg) {
+    const PerlXlib_struct_type *t;
+    if (0 == strncmp(pkg, "X11::Xlib::", 11))
+        pkg += 11;
+    for (t= PerlXlib_struct_types; t->pkg; t++)
+        if (0 == strcmp(t->pkg + 11, pkg))
+            return t;
+    return NULL;
+}
+
+static int PerlXlib_struct_array_magic_free(pTHX_ SV* sv, MAGIC* mg) {
+    if (mg->mg_ptr)
+        Safefree(mg->mg_ptr);
+    return 0;
+}
+/* The array info of the StructArray a view's magic points to, or NULL */
+static PerlXlib_struct_array* PerlXlib_struct_view_array(MAGIC *mg) {
+    MAGIC *amg;
+    if (mg->mg_obj && SvMAGICAL(mg->mg_obj)) {
+        for (amg= SvMAGIC(mg->mg_obj); amg; amg= amg->mg_moremagic)
+            if (amg->mg_type == PERL_MAGIC_ext && amg->mg_ptr && amg->mg_virtual
+                && amg->mg_virtual->svt_free == PerlXlib_struct_array_magic_free
+            )
+                return (PerlXlib_struct_array*) amg->mg_ptr;
+    }
+    return NULL;
+}
+/* Assigning to $$view would give it a buffer of its own (or none at all) and
+ * silently detach it from the array, so put the element back and croak.
+ * mg_ptr of a view is the address of its element.
+ */
+static int PerlXlib_struct_view_magic_set(pTHX_ SV* sv, MAGIC* mg) {
+    PerlXlib_struct_array *arr;
+    if (SvPOK(sv) && SvPVX(sv) == mg->mg_ptr && !SvLEN(sv))
+        return 0;
+    arr= PerlXlib_struct_view_array(mg);
+    if (SvLEN(sv))
+        SvPV_free(sv);
+    SvPV_set(sv, mg->mg_ptr);
+    SvLEN_set(sv, 0);
+    SvCUR_set(sv, arr? arr->type->size : 0);
+    SvPOK_only(sv);
+    croak("Can't assign to an element view of X11::Xlib::StructArray (set its fields instead)");
+    return 0;
+}
+static int PerlXlib_struct_view_magic_free(pTHX_ SV* sv, MAGIC* mg) {
+    PerlXlib_struct_array *arr= PerlXlib_struct_view_array(mg);
+    /* detach the PV from the array's buffer before perl looks at it again */
+    if (!SvLEN(sv)) {
+        SvPV_set(sv, NULL);
+        SvCUR_set(sv, 0);
+        SvPOK_off(sv);
+    }
+    if (arr)
+        arr->views--;
+    return 0;
+}
+static MGVTBL PerlXlib_struct_array_magic_vt= {
+    0, 0, 0, 0, PerlXlib_struct_array_magic_free, 0, PerlXlib_magic_dup
+#ifdef MGf_LOCAL
+    ,0
+#endif
+};
+static MGVTBL PerlXlib_struct_view_magic_vt= {
+    0, PerlXlib_struct_view_magic_set, 0, 0, PerlXlib_struct_view_magic_free, 0, PerlXlib_magic_dup
+#ifdef MGf_LOCAL
+    ,0
+#endif
+};
+
+/* Return the array info of a StructArray object, or NULL (or croak, with OR_DIE) */
+PerlXlib_struct_array* PerlXlib_get_struct_array_info(SV *objref, int fail_flag) {
+    MAGIC *mg;
+    SV *sv= SvROK(objref)? SvRV(objref) : NULL;
+    if (sv && SvMAGICAL(sv) && SvTYPE(sv) < SVt_PVAV)
+        for (mg= SvMAGIC(sv); mg; mg= mg->mg_moremagic)
+            if (mg->mg_type == PERL_MAGIC_ext && mg->mg_virtual == &PerlXlib_struct_array_magic_vt)
+                return (PerlXlib_struct_array*) mg->mg_ptr;
+    if (fail_flag == OR_DIE)
+        croak("Not an X11::Xlib::StructArray");
+    return NULL;
+}
+
+/* True if the SV is the buffer of an element view */
+static int PerlXlib_is_struct_view(SV *sv) {
+    MAGIC *mg;
+    if (SvMAGICAL(sv))
+        for (mg= SvMAGIC(sv); mg; mg= mg->mg_moremagic)
+            if (mg->mg_type == PERL_MAGIC_ext && mg->mg_virtual == &PerlXlib_struct_view_magic_vt)
+                return 1;
+    return 0;
+}
+
+/* Create a new StructArray of 'count' zeroed elements.  Returns a mortal ref. */
+SV* PerlXlib_new_struct_array(const PerlXlib_struct_type *type, const char *class, size_t count) {
+    PerlXlib_struct_array *arr;
+    SV *buf= newSV(count * type->size + X11_Xlib_Struct_Padding);
+    SV *ret= sv_2mortal(newRV_noinc(buf));
+    sv_setpvn(buf, "", 0);
+    SvGROW(buf, count * type->size + X11_Xlib_Struct_Padding);
+    memset(SvPVX(buf), 0, count * type->size + X11_Xlib_Struct_Padding);
+    SvCUR_set(buf, count * type->size);
+    Newxz(arr, 1, PerlXlib_struct_array);
+    arr->type= type;
+    sv_magicext(buf, NULL, PERL_MAGIC_ext, &PerlXlib_struct_array_magic_vt, (const char*) arr, 0);
+    sv_bless(ret, gv_stashpv(class? class : "X11::Xlib::StructArray", GV_ADD));
+    return ret;
+}
+
+/* Change the number of elements, zero-filling new ones.  Returns the buffer. */
+char* PerlXlib_struct_array_resize(SV *objref, size_t count) {
+    PerlXlib_struct_array *arr= PerlXlib_get_struct_array_info(objref, OR_DIE);
+    SV *buf= SvRV(objref);
+    size_t old= SvCUR(buf), need= count * arr->type->size + X11_Xlib_Struct_Padding;
+    if (SvLEN(buf) < need) {
+        if (arr->views)
+            croak("Can't grow X11::Xlib::StructArray while %ld element views exist", (long) arr->views);
+        /* grow geometrically so that repeated push is linear */
+        SvGROW(buf, need + (SvLEN(buf) > need? 0 : SvLEN(buf) / 2));
+    }
+    SvCUR_set(buf, count * arr->type->size);
+    if (SvCUR(buf) > old)
+        memset(SvPVX(buf) + old, 0, SvCUR(buf) - old);
+    /* keep the padding zeroed, since it may be read by the last element */
+    memset(SvPVX(buf) + SvCUR(buf), 0, X11_Xlib_Struct_Padding);
+    return SvPVX(buf);
+}
+
+/* Store elements from a list of SVs, starting at index 'start' */
+void PerlXlib_struct_array_store(SV *objref, size_t start, SV **elems, size_t n) {
+    PerlXlib_struct_array *arr= PerlXlib_get_struct_array_info(objref, OR_DIE);
+    const PerlXlib_struct_type *t= arr->type;
+    size_t i;
+    for (i= 0; i < n; i++)
+        PerlXlib_struct_array_elem(elems[i], SvPVX(SvRV(objref)) + (start + i) * t->size,
+            t->pkg, t->size, t->n_fields, t->packer, (int) i);
+}
+
+/* Return a mortal struct object for element 'idx'.  If 'view' is true, it
+ * refers to the array's memory, else it is a copy.
+ */
+SV* PerlXlib_struct_array_elem_obj(SV *objref, size_t idx, int view) {
+    PerlXlib_struct_array *arr= PerlXlib_get_struct_array_info(objref, OR_DIE);
+    const PerlXlib_struct_type *t= arr->type;
+    SV *buf= SvRV(objref), *sv;
+    char *p= SvPVX(buf) + idx * t->size;
+    const char *pkg= t->pkg;
+    if (idx >= SvCUR(buf) / t->size)
+        croak("Index %ld out of bounds for X11::Xlib::StructArray of %ld", (long) idx, (long) (SvCUR(buf) / t->size));
+    if (t->packer == (PerlXlib_struct_pack_fn*) &PerlXlib_XEvent_pack)
+        pkg= PerlXlib_xevent_pkg_for_event((XEvent*) p);
+    if (!view)
+        return sv_2mortal(sv_setref_pvn(newSV(0), pkg, p, t->size));
+    sv= newSV_type(SVt_PVMG);
+    SvPV_set(sv, p);
+    SvCUR_set(sv, t->size);
+    SvLEN_set(sv, 0);
+    SvPOK_only(sv);
+    sv_magicext(sv, buf, PERL_MAGIC_ext, &PerlXlib_struct_view_magic_vt, p, 0);
+    arr->views++;
+    return sv_bless(sv_2mortal(newRV_noinc(sv)), gv_stashpv(pkg, GV_ADD));
+}
+
 #include "keysym_to_codepoint.c"
 
 KeySym PerlXlib_codepoint_to_keysym(int uc) {
@@ -674,33 +959,52 @@ KeySym PerlXlib_sv_to_keysym(SV *sv) {
     
     if (!sv || !SvOK(sv))
         return NoSymbol;
-    /* First try to process it as an X11 symbol name */
     name= SvPV(sv, len);
+    /* A single character is looked up directly.  (Every single-character
+     * KeySym name is a letter or digit whose KeySym is the same.)
+     */
+    if (len == 1 || (DO_UTF8(sv) && len <= UTF8_MAXBYTES && sv_len_utf8(sv) == 1)) {
+        codepoint= NATIVE_TO_UNI(DO_UTF8(sv)? utf8n_to_uvchr(name, len, &len, 0) : (name[0] & 0xFF));
+        return PerlXlib_codepoint_to_keysym(codepoint);
+    }
+    /* Else try to process it as an X11 symbol name */
     sym= XStringToKeysym(name);
-    /* Else, use multi-digit numbers directly, and single-digit as a char lookup */
+    /* Else, use multi-digit numbers directly */
     if (sym == NoSymbol) {
         if (SvIOK(sv) && SvIV(sv) > 9)
             sym= SvIV(sv);
         else if ((ival= strtol(name, &endp, 0)) && (endp - name > 1) && *endp == 0)
             sym= ival;
-        /* If it is a single character, try looking up a keysym for it */
-        else if ((DO_UTF8(sv)? sv_len_utf8(sv) : len) == 1) {
-            codepoint= NATIVE_TO_UNI(DO_UTF8(sv)? utf8n_to_uvchr(name, len, &len, 0) : (name[0] & 0xFF));
-            sym= PerlXlib_codepoint_to_keysym(codepoint);
-        }
     }
     return sym;
 }
 
+/* The error ring of a display object, or NULL if it doesn't have one */
+PerlXlib_error_ring * PerlXlib_display_error_ring(SV *dpy_obj) {
+    SV **ent;
+    if (!dpy_obj || !SvROK(dpy_obj) || SvTYPE(SvRV(dpy_obj)) != SVt_PVHV)
+        return NULL;
+    ent= hv_fetch((HV*) SvRV(dpy_obj), "_error_ring", 11, 0);
+    return ent && SvPOK(*ent) && SvCUR(*ent) >= sizeof(PerlXlib_error_ring)
+        ? (PerlXlib_error_ring*) SvPVX(*ent) : NULL;
+}
+
 int PerlXlib_X_error_handler(Display *d, XErrorEvent *e) {
+    PerlXlib_error_ring *ring;
     dSP;
     ENTER;
     SAVETMPS;
-    PUSHMARK(SP);
-    EXTEND(SP, 1);
-    PUSHs(sv_2mortal(sv_setref_pvn(newSV(0), "X11::Xlib::XErrorEvent", (void*) e, sizeof(XEvent))));
-    PUTBACK;
-    call_pv("X11::Xlib::_error_nonfatal", G_VOID|G_DISCARD|G_EVAL|G_KEEPERR);
+    /* Displays with an error ring just record the error, without calling perl */
+    ring= PerlXlib_display_error_ring(PerlXlib_get_display_objref(d, OR_UNDEF));
+    if (ring)
+        PerlXlib_error_ring_push(ring, e);
+    else {
+        PUSHMARK(SP);
+        EXTEND(SP, 1);
+        PUSHs(sv_2mortal(sv_setref_pvn(newSV(0), "X11::Xlib::XErrorEvent", (void*) e, sizeof(XEvent))));
+        PUTBACK;
+        call_pv("X11::Xlib::_error_nonfatal", G_VOID|G_DISCARD|G_EVAL|G_KEEPERR);
+    }
     FREETMPS;
     LEAVE;
     return 0;
@@ -754,6 +1058,129 @@ void PerlXlib_install_error_handlers(Bool nonfatal, Bool fatal) {
     }
 }
 
+#include "pixel_convert.c"
+#include "tile_hash.c"
+#include "region.c"
+#include "visual_index.c"
+#include "keymap_index.c"
+#include "xkb_keymap.c"
+#include "key_sequence.c"
+#include "input_player.c"
+#include "pointer_path.c"
+#include "error_ring.c"
+#include "display_stats.c"
+#include "request_trace.c"
+#ifdef HAVE_XI
+#include "xi2_events.c"
+#endif
+#ifdef HAVE_FREETYPE
+#include "glyph_raster.c"
+#endif
+
+/* Extension events (DamageNotify etc.) get their type number assigned by the
+ * server at runtime, so they can't be part of the generated switch statements
+ * below.  The XS for each extension registers its package and pack/unpack
+ * functions here once it learns the event base of a connection, and the
+ * default case of the generated code consults this table.  The same type
+ * number can mean different events on different connections, so entries are
+ * keyed by (Display*, type) and are removed when the display is closed.
+ */
+static struct PerlXlib_ext_event {
+    Display *dpy;
+    int type;
+    const char *pkg;
+    PerlXlib_xevent_pack_fn *pack;
+    PerlXlib_xevent_unpack_fn *unpack;
+} *PerlXlib_ext_events= NULL;
+static int PerlXlib_ext_event_count= 0, PerlXlib_ext_event_alloc= 0;
+
+/* Find the entry for this type on 'dpy'.  Events built by hand might not have
+ * a display; those match only if every connection agrees on the type.
+ */
+static struct PerlXlib_ext_event * PerlXlib_ext_event_find(Display *dpy, int type) {
+    struct PerlXlib_ext_event *found= NULL, *e;
+    int i;
+    if (type < LASTEvent || type >= 128)
+        return NULL;
+    for (i= 0; i < PerlXlib_ext_event_count; i++) {
+        e= PerlXlib_ext_events + i;
+        if (e->type != type) continue;
+        if (dpy) {
+            if (e->dpy == dpy) return e;
+        }
+        else if (found && found->pkg != e->pkg)
+            return NULL;
+        else
+            found= e;
+    }
+    return dpy? NULL : found;
+}
+
+void PerlXlib_register_ext_event_type(Display *dpy, int type, const char *pkg,
+    PerlXlib_xevent_pack_fn *pack, PerlXlib_xevent_unpack_fn *unpack
+) {
+    struct PerlXlib_ext_event *e= NULL;
+    int i;
+    if (type < LASTEvent || type >= 128)
+        croak("Extension event type %d out of range", type);
+    for (i= 0; i < PerlXlib_ext_event_count && !e; i++)
+        if (PerlXlib_ext_events[i].dpy == dpy && PerlXlib_ext_events[i].pkg == pkg)
+            e= PerlXlib_ext_events + i;
+    if (!e) {
+        if (PerlXlib_ext_event_count >= PerlXlib_ext_event_alloc) {
+            PerlXlib_ext_event_alloc= PerlXlib_ext_event_alloc? PerlXlib_ext_event_alloc * 2 : 8;
+            Renew(PerlXlib_ext_events, PerlXlib_ext_event_alloc, struct PerlXlib_ext_event);
+        }
+        e= PerlXlib_ext_events + PerlXlib_ext_event_count++;
+    }
+    e->dpy= dpy;
+    e->type= type;
+    e->pkg= pkg;
+    e->pack= pack;
+    e->unpack= unpack;
+}
+
+/* Forget the extension events of a display which is being closed */
+void PerlXlib_unregister_ext_events(Display *dpy) {
+    int i, dst;
+    for (i= 0, dst= 0; i < PerlXlib_ext_event_count; i++)
+        if (PerlXlib_ext_events[i].dpy != dpy)
+            PerlXlib_ext_events[dst++]= PerlXlib_ext_events[i];
+    PerlXlib_ext_event_count= dst;
+}
+
+const char* PerlXlib_xevent_ext_pkg_for_type(int type) {
+    struct PerlXlib_ext_event *e= PerlXlib_ext_event_find(NULL, type);
+    return e? e->pkg : "X11::Xlib::XEvent";
+}
+
+/* Like PerlXlib_xevent_pkg_for_type, but extension events are looked up for
+ * the connection the event came from.
+ */
+const char* PerlXlib_xevent_pkg_for_event(XEvent *s) {
+    struct PerlXlib_ext_event *e;
+    if (s->type < LASTEvent)
+        return PerlXlib_xevent_pkg_for_type(s->type);
+    e= PerlXlib_ext_event_find(s->xany.display, s->type);
+    return e? e->pkg : "X11::Xlib::XEvent";
+}
+
+Bool PerlXlib_xevent_ext_pack(XEvent *s, HV *fields, Bool consume) {
+    struct PerlXlib_ext_event *e= PerlXlib_ext_event_find(s->xany.display, s->type);
+    if (!e || !e->pack)
+        return 0;
+    e->pack(s, fields, consume);
+    return 1;
+}
+
+Bool PerlXlib_xevent_ext_unpack(XEvent *s, HV *fields) {
+    struct PerlXlib_ext_event *e= PerlXlib_ext_event_find(s->xany.display, s->type);
+    if (!e || !e->unpack)
+        return 0;
+    e->unpack(s, fields);
+    return 1;
+}
+
 /*--------------------------------------------------------------------------*/
 /* BEGIN GENERATED X11_Xlib_XEvent */
 
@@ -794,7 +1221,7 @@ const char* PerlXlib_xevent_pkg_for_type(int type) {
   case SelectionRequest: return "X11::Xlib::XSelectionRequestEvent";
   case UnmapNotify: return "X11::Xlib::XUnmapEvent";
   case VisibilityNotify: return "X11::Xlib::XVisibilityEvent";
-  default: return "X11::Xlib::XEvent";
+  default: return PerlXlib_xevent_ext_pkg_for_type(type);
   }
 }
 
@@ -1231,7 +1658,8 @@ void PerlXlib_XEvent_pack(XEvent *s, HV *fields, Bool consume) {
       if (fp && *fp) { s->xvisibility.window= PerlXlib_sv_to_xid(*fp);; if (consume) hv_delete(fields, "window", 6, G_DISCARD); }
       break;
     default:
-      warn("Unknown XEvent type %d", s->type);
+      if (!PerlXlib_xevent_ext_pack(s, fields, consume))
+        warn("Unknown XEvent type %d", s->type);
     }
 }
 
@@ -1483,7 +1911,8 @@ void PerlXlib_XEvent_unpack(XEvent *s, HV *fields) {
       if (!hv_store(fields, "window"     ,  6, (sv=newSVuv(s->xvisibility.window)), 0)) goto store_fail;
       break;
     default:
-      warn("Unknown XEvent type %d", s->type);
+      if (!PerlXlib_xevent_ext_unpack(s, fields))
+        warn("Unknown XEvent type %d", s->type);
     }
     return;
     store_fail:
@@ -1999,6 +2428,274 @@ void PerlXlib_XRenderPictFormat_unpack_obj(XRenderPictFormat *s, HV *fields, SV
 
 /* END GENERATED X11_Xlib_XRenderPictFormat */
 /*--------------------------------------------------------------------------*/
+/* BEGIN GENERATED X11_Xlib_XGCValues */
+
+void PerlXlib_XGCValues_pack(XGCValues *s, HV *fields, Bool consume) {
+    SV **fp;
+    Display *dpy= NULL; /* not available.  Magic display attribute is handled by caller. */
+
+    fp= hv_fetch(fields, "arc_mode", 8, 0);
+    if (fp && *fp) { s->arc_mode= SvIV(*fp); if (consume) hv_delete(fields, "arc_mode", 8, G_DISCARD); }
+
+    fp= hv_fetch(fields, "background", 10, 0);
+    if (fp && *fp) { s->background= SvUV(*fp); if (consume) hv_delete(fields, "background", 10, G_DISCARD); }
+
+    fp= hv_fetch(fields, "cap_style", 9, 0);
+    if (fp && *fp) { s->cap_style= SvIV(*fp); if (consume) hv_delete(fields, "cap_style", 9, G_DISCARD); }
+
+    fp= hv_fetch(fields, "clip_mask", 9, 0);
+    if (fp && *fp) { s->clip_mask= PerlXlib_sv_to_xid(*fp); if (consume) hv_delete(fields, "clip_mask", 9, G_DISCARD); }
+
+    fp= hv_fetch(fields, "clip_x_origin", 13, 0);
+    if (fp && *fp) { s->clip_x_origin= SvIV(*fp); if (consume) hv_delete(fields, "clip_x_origin", 13, G_DISCARD); }
+
+    fp= hv_fetch(fields, "clip_y_origin", 13, 0);
+    if (fp && *fp) { s->clip_y_origin= SvIV(*fp); if (consume) hv_delete(fields, "clip_y_origin", 13, G_DISCARD); }
+
+    fp= hv_fetch(fields, "dash_offset", 11, 0);
+    if (fp && *fp) { s->dash_offset= SvIV(*fp); if (consume) hv_delete(fields, "dash_offset", 11, G_DISCARD); }
+
+    fp= hv_fetch(fields, "dashes", 6, 0);
+    if (fp && *fp) { s->dashes= SvIV(*fp); if (consume) hv_delete(fields, "dashes", 6, G_DISCARD); }
+
+    fp= hv_fetch(fields, "fill_rule", 9, 0);
+    if (fp && *fp) { s->fill_rule= SvIV(*fp); if (consume) hv_delete(fields, "fill_rule", 9, G_DISCARD); }
+
+    fp= hv_fetch(fields, "fill_style", 10, 0);
+    if (fp && *fp) { s->fill_style= SvIV(*fp); if (consume) hv_delete(fields, "fill_style", 10, G_DISCARD); }
+
+    fp= hv_fetch(fields, "font", 4, 0);
+    if (fp && *fp) { s->font= PerlXlib_sv_to_xid(*fp); if (consume) hv_delete(fields, "font", 4, G_DISCARD); }
+
+    fp= hv_fetch(fields, "foreground", 10, 0);
+    if (fp && *fp) { s->foreground= SvUV(*fp); if (consume) hv_delete(fields, "foreground", 10, G_DISCARD); }
+
+    fp= hv_fetch(fields, "function", 8, 0);
+    if (fp && *fp) { s->function= SvIV(*fp); if (consume) hv_delete(fields, "function", 8, G_DISCARD); }
+
+    fp= hv_fetch(fields, "graphics_exposures", 18, 0);
+    if (fp && *fp) { s->graphics_exposures= SvIV(*fp); if (consume) hv_delete(fields, "graphics_exposures", 18, G_DISCARD); }
+
+    fp= hv_fetch(fields, "join_style", 10, 0);
+    if (fp && *fp) { s->join_style= SvIV(*fp); if (consume) hv_delete(fields, "join_style", 10, G_DISCARD); }
+
+    fp= hv_fetch(fields, "line_style", 10, 0);
+    if (fp && *fp) { s->line_style= SvIV(*fp); if (consume) hv_delete(fields, "line_style", 10, G_DISCARD); }
+
+    fp= hv_fetch(fields, "line_width", 10, 0);
+    if (fp && *fp) { s->line_width= SvIV(*fp); if (consume) hv_delete(fields, "line_width", 10, G_DISCARD); }
+
+    fp= hv_fetch(fields, "plane_mask", 10, 0);
+    if (fp && *fp) { s->plane_mask= SvUV(*fp); if (consume) hv_delete(fields, "plane_mask", 10, G_DISCARD); }
+
+    fp= hv_fetch(fields, "stipple", 7, 0);
+    if (fp && *fp) { s->stipple= PerlXlib_sv_to_xid(*fp); if (consume) hv_delete(fields, "stipple", 7, G_DISCARD); }
+
+    fp= hv_fetch(fields, "subwindow_mode", 14, 0);
+    if (fp && *fp) { s->subwindow_mode= SvIV(*fp); if (consume) hv_delete(fields, "subwindow_mode", 14, G_DISCARD); }
+
+    fp= hv_fetch(fields, "tile", 4, 0);
+    if (fp && *fp) { s->tile= PerlXlib_sv_to_xid(*fp); if (consume) hv_delete(fields, "tile", 4, G_DISCARD); }
+
+    fp= hv_fetch(fields, "ts_x_origin", 11, 0);
+    if (fp && *fp) { s->ts_x_origin= SvIV(*fp); if (consume) hv_delete(fields, "ts_x_origin", 11, G_DISCARD); }
+
+    fp= hv_fetch(fields, "ts_y_origin", 11, 0);
+    if (fp && *fp) { s->ts_y_origin= SvIV(*fp); if (consume) hv_delete(fields, "ts_y_origin", 11, G_DISCARD); }
+}
+
+void PerlXlib_XGCValues_unpack_obj(XGCValues *s, HV *fields, SV *obj_ref) {
+    /* hv_store may return NULL if there is an error, or if the hash is tied.
+     * If it does, we need to release the reference to the value we almost inserted,
+     * so track allocated SV in this var.
+     */
+    SV *sv= NULL;
+    if (!hv_store(fields, "arc_mode"  ,  8, (sv=newSViv(s->arc_mode)), 0)) goto store_fail;
+    if (!hv_store(fields, "background", 10, (sv=newSVuv(s->background)), 0)) goto store_fail;
+    if (!hv_store(fields, "cap_style" ,  9, (sv=newSViv(s->cap_style)), 0)) goto store_fail;
+    if (!hv_store(fields, "clip_mask" ,  9, (sv=newSVuv(s->clip_mask)), 0)) goto store_fail;
+    if (!hv_store(fields, "clip_x_origin", 13, (sv=newSViv(s->clip_x_origin)), 0)) goto store_fail;
+    if (!hv_store(fields, "clip_y_origin", 13, (sv=newSViv(s->clip_y_origin)), 0)) goto store_fail;
+    if (!hv_store(fields, "dash_offset", 11, (sv=newSViv(s->dash_offset)), 0)) goto store_fail;
+    if (!hv_store(fields, "dashes"    ,  6, (sv=newSViv(s->dashes)), 0)) goto store_fail;
+    if (!hv_store(fields, "fill_rule" ,  9, (sv=newSViv(s->fill_rule)), 0)) goto store_fail;
+    if (!hv_store(fields, "fill_style", 10, (sv=newSViv(s->fill_style)), 0)) goto store_fail;
+    if (!hv_store(fields, "font"      ,  4, (sv=newSVuv(s->font)), 0)) goto store_fail;
+    if (!hv_store(fields, "foreground", 10, (sv=newSVuv(s->foreground)), 0)) goto store_fail;
+    if (!hv_store(fields, "function"  ,  8, (sv=newSViv(s->function)), 0)) goto store_fail;
+    if (!hv_store(fields, "graphics_exposures", 18, (sv=newSViv(s->graphics_exposures)), 0)) goto store_fail;
+    if (!hv_store(fields, "join_style", 10, (sv=newSViv(s->join_style)), 0)) goto store_fail;
+    if (!hv_store(fields, "line_style", 10, (sv=newSViv(s->line_style)), 0)) goto store_fail;
+    if (!hv_store(fields, "line_width", 10, (sv=newSViv(s->line_width)), 0)) goto store_fail;
+    if (!hv_store(fields, "plane_mask", 10, (sv=newSVuv(s->plane_mask)), 0)) goto store_fail;
+    if (!hv_store(fields, "stipple"   ,  7, (sv=newSVuv(s->stipple)), 0)) goto store_fail;
+    if (!hv_store(fields, "subwindow_mode", 14, (sv=newSViv(s->subwindow_mode)), 0)) goto store_fail;
+    if (!hv_store(fields, "tile"      ,  4, (sv=newSVuv(s->tile)), 0)) goto store_fail;
+    if (!hv_store(fields, "ts_x_origin", 11, (sv=newSViv(s->ts_x_origin)), 0)) goto store_fail;
+    if (!hv_store(fields, "ts_y_origin", 11, (sv=newSViv(s->ts_y_origin)), 0)) goto store_fail;
+    return;
+    store_fail:
+        if (sv) sv_2mortal(sv);
+        croak("Can't store field in supplied hash (tied maybe?)");
+}
+
+/* END GENERATED X11_Xlib_XGCValues */
+/*--------------------------------------------------------------------------*/
+/* BEGIN GENERATED X11_Xlib_XRenderPictureAttributes */
+
+void PerlXlib_XRenderPictureAttributes_pack(XRenderPictureAttributes *s, HV *fields, Bool consume) {
+    SV **fp;
+    Display *dpy= NULL; /* not available.  Magic display attribute is handled by caller. */
+
+    fp= hv_fetch(fields, "alpha_map", 9, 0);
+    if (fp && *fp) { s->alpha_map= PerlXlib_sv_to_xid(*fp); if (consume) hv_delete(fields, "alpha_map", 9, G_DISCARD); }
+
+    fp= hv_fetch(fields, "alpha_x_origin", 14, 0);
+    if (fp && *fp) { s->alpha_x_origin= SvIV(*fp); if (consume) hv_delete(fields, "alpha_x_origin", 14, G_DISCARD); }
+
+    fp= hv_fetch(fields, "alpha_y_origin", 14, 0);
+    if (fp && *fp) { s->alpha_y_origin= SvIV(*fp); if (consume) hv_delete(fields, "alpha_y_origin", 14, G_DISCARD); }
+
+    fp= hv_fetch(fields, "clip_mask", 9, 0);
+    if (fp && *fp) { s->clip_mask= PerlXlib_sv_to_xid(*fp); if (consume) hv_delete(fields, "clip_mask", 9, G_DISCARD); }
+
+    fp= hv_fetch(fields, "clip_x_origin", 13, 0);
+    if (fp && *fp) { s->clip_x_origin= SvIV(*fp); if (consume) hv_delete(fields, "clip_x_origin", 13, G_DISCARD); }
+
+    fp= hv_fetch(fields, "clip_y_origin", 13, 0);
+    if (fp && *fp) { s->clip_y_origin= SvIV(*fp); if (consume) hv_delete(fields, "clip_y_origin", 13, G_DISCARD); }
+
+    fp= hv_fetch(fields, "component_alpha", 15, 0);
+    if (fp && *fp) { s->component_alpha= SvIV(*fp); if (consume) hv_delete(fields, "component_alpha", 15, G_DISCARD); }
+
+    fp= hv_fetch(fields, "dither", 6, 0);
+    if (fp && *fp) { s->dither= PerlXlib_sv_to_xid(*fp); if (consume) hv_delete(fields, "dither", 6, G_DISCARD); }
+
+    fp= hv_fetch(fields, "graphics_exposures", 18, 0);
+    if (fp && *fp) { s->graphics_exposures= SvIV(*fp); if (consume) hv_delete(fields, "graphics_exposures", 18, G_DISCARD); }
+
+    fp= hv_fetch(fields, "poly_edge", 9, 0);
+    if (fp && *fp) { s->poly_edge= SvIV(*fp); if (consume) hv_delete(fields, "poly_edge", 9, G_DISCARD); }
+
+    fp= hv_fetch(fields, "poly_mode", 9, 0);
+    if (fp && *fp) { s->poly_mode= SvIV(*fp); if (consume) hv_delete(fields, "poly_mode", 9, G_DISCARD); }
+
+    fp= hv_fetch(fields, "repeat", 6, 0);
+    if (fp && *fp) { s->repeat= SvIV(*fp); if (consume) hv_delete(fields, "repeat", 6, G_DISCARD); }
+
+    fp= hv_fetch(fields, "subwindow_mode", 14, 0);
+    if (fp && *fp) { s->subwindow_mode= SvIV(*fp); if (consume) hv_delete(fields, "subwindow_mode", 14, G_DISCARD); }
+}
+
+void PerlXlib_XRenderPictureAttributes_unpack_obj(XRenderPictureAttributes *s, HV *fields, SV *obj_ref) {
+    /* hv_store may return NULL if there is an error, or if the hash is tied.
+     * If it does, we need to release the reference to the value we almost inserted,
+     * so track allocated SV in this var.
+     */
+    SV *sv= NULL;
+    if (!hv_store(fields, "alpha_map" ,  9, (sv=newSVuv(s->alpha_map)), 0)) goto store_fail;
+    if (!hv_store(fields, "alpha_x_origin", 14, (sv=newSViv(s->alpha_x_origin)), 0)) goto store_fail;
+    if (!hv_store(fields, "alpha_y_origin", 14, (sv=newSViv(s->alpha_y_origin)), 0)) goto store_fail;
+    if (!hv_store(fields, "clip_mask" ,  9, (sv=newSVuv(s->clip_mask)), 0)) goto store_fail;
+    if (!hv_store(fields, "clip_x_origin", 13, (sv=newSViv(s->clip_x_origin)), 0)) goto store_fail;
+    if (!hv_store(fields, "clip_y_origin", 13, (sv=newSViv(s->clip_y_origin)), 0)) goto store_fail;
+    if (!hv_store(fields, "component_alpha", 15, (sv=newSViv(s->component_alpha)), 0)) goto store_fail;
+    if (!hv_store(fields, "dither"    ,  6, (sv=newSVuv(s->dither)), 0)) goto store_fail;
+    if (!hv_store(fields, "graphics_exposures", 18, (sv=newSViv(s->graphics_exposures)), 0)) goto store_fail;
+    if (!hv_store(fields, "poly_edge" ,  9, (sv=newSViv(s->poly_edge)), 0)) goto store_fail;
+    if (!hv_store(fields, "poly_mode" ,  9, (sv=newSViv(s->poly_mode)), 0)) goto store_fail;
+    if (!hv_store(fields, "repeat"    ,  6, (sv=newSViv(s->repeat)), 0)) goto store_fail;
+    if (!hv_store(fields, "subwindow_mode", 14, (sv=newSViv(s->subwindow_mode)), 0)) goto store_fail;
+    return;
+    store_fail:
+        if (sv) sv_2mortal(sv);
+        croak("Can't store field in supplied hash (tied maybe?)");
+}
+
+/* END GENERATED X11_Xlib_XRenderPictureAttributes */
+/*--------------------------------------------------------------------------*/
+/* BEGIN GENERATED X11_Xlib_XRenderColor */
+
+void PerlXlib_XRenderColor_pack(XRenderColor *s, HV *fields, Bool consume) {
+    SV **fp;
+    Display *dpy= NULL; /* not available.  Magic display attribute is handled by caller. */
+
+    fp= hv_fetch(fields, "alpha", 5, 0);
+    if (fp && *fp) { s->alpha= SvUV(*fp); if (consume) hv_delete(fields, "alpha", 5, G_DISCARD); }
+
+    fp= hv_fetch(fields, "blue", 4, 0);
+    if (fp && *fp) { s->blue= SvUV(*fp); if (consume) hv_delete(fields, "blue", 4, G_DISCARD); }
+
+    fp= hv_fetch(fields, "green", 5, 0);
+    if (fp && *fp) { s->green= SvUV(*fp); if (consume) hv_delete(fields, "green", 5, G_DISCARD); }
+
+    fp= hv_fetch(fields, "red", 3, 0);
+    if (fp && *fp) { s->red= SvUV(*fp); if (consume) hv_delete(fields, "red", 3, G_DISCARD); }
+}
+
+void PerlXlib_XRenderColor_unpack_obj(XRenderColor *s, HV *fields, SV *obj_ref) {
+    /* hv_store may return NULL if there is an error, or if the hash is tied.
+     * If it does, we need to release the reference to the value we almost inserted,
+     * so track allocated SV in this var.
+     */
+    SV *sv= NULL;
+    if (!hv_store(fields, "alpha"     ,  5, (sv=newSVuv(s->alpha)), 0)) goto store_fail;
+    if (!hv_store(fields, "blue"      ,  4, (sv=newSVuv(s->blue)), 0)) goto store_fail;
+    if (!hv_store(fields, "green"     ,  5, (sv=newSVuv(s->green)), 0)) goto store_fail;
+    if (!hv_store(fields, "red"       ,  3, (sv=newSVuv(s->red)), 0)) goto store_fail;
+    return;
+    store_fail:
+        if (sv) sv_2mortal(sv);
+        croak("Can't store field in supplied hash (tied maybe?)");
+}
+
+/* END GENERATED X11_Xlib_XRenderColor */
+/*--------------------------------------------------------------------------*/
+/* BEGIN GENERATED X11_Xlib_XGlyphInfo */
+
+void PerlXlib_XGlyphInfo_pack(XGlyphInfo *s, HV *fields, Bool consume) {
+    SV **fp;
+    Display *dpy= NULL; /* not available.  Magic display attribute is handled by caller. */
+
+    fp= hv_fetch(fields, "height", 6, 0);
+    if (fp && *fp) { s->height= SvUV(*fp); if (consume) hv_delete(fields, "height", 6, G_DISCARD); }
+
+    fp= hv_fetch(fields, "width", 5, 0);
+    if (fp && *fp) { s->width= SvUV(*fp); if (consume) hv_delete(fields, "width", 5, G_DISCARD); }
+
+    fp= hv_fetch(fields, "x", 1, 0);
+    if (fp && *fp) { s->x= SvIV(*fp); if (consume) hv_delete(fields, "x", 1, G_DISCARD); }
+
+    fp= hv_fetch(fields, "xOff", 4, 0);
+    if (fp && *fp) { s->xOff= SvIV(*fp); if (consume) hv_delete(fields, "xOff", 4, G_DISCARD); }
+
+    fp= hv_fetch(fields, "y", 1, 0);
+    if (fp && *fp) { s->y= SvIV(*fp); if (consume) hv_delete(fields, "y", 1, G_DISCARD); }
+
+    fp= hv_fetch(fields, "yOff", 4, 0);
+    if (fp && *fp) { s->yOff= SvIV(*fp); if (consume) hv_delete(fields, "yOff", 4, G_DISCARD); }
+}
+
+void PerlXlib_XGlyphInfo_unpack_obj(XGlyphInfo *s, HV *fields, SV *obj_ref) {
+    /* hv_store may return NULL if there is an error, or if the hash is tied.
+     * If it does, we need to release the reference to the value we almost inserted,
+     * so track allocated SV in this var.
+     */
+    SV *sv= NULL;
+    if (!hv_store(fields, "height"    ,  6, (sv=newSVuv(s->height)), 0)) goto store_fail;
+    if (!hv_store(fields, "width"     ,  5, (sv=newSVuv(s->width)), 0)) goto store_fail;
+    if (!hv_store(fields, "x"         ,  1, (sv=newSViv(s->x)), 0)) goto store_fail;
+    if (!hv_store(fields, "xOff"      ,  4, (sv=newSViv(s->xOff)), 0)) goto store_fail;
+    if (!hv_store(fields, "y"         ,  1, (sv=newSViv(s->y)), 0)) goto store_fail;
+    if (!hv_store(fields, "yOff"      ,  4, (sv=newSViv(s->yOff)), 0)) goto store_fail;
+    return;
+    store_fail:
+        if (sv) sv_2mortal(sv);
+        croak("Can't store field in supplied hash (tied maybe?)");
+}
+
+/* END GENERATED X11_Xlib_XGlyphInfo */
+/*--------------------------------------------------------------------------*/
 
 /* provide these exports for back-compat */
 extern void PerlXlib_XVisualInfo_unpack(XVisualInfo *s, HV *fields) {
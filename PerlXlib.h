@@ -20,6 +20,14 @@ extern SV * PerlXlib_get_objref(void *thing, int create_flag,
 extern void * PerlXlib_objref_get_pointer(SV *objref, const char *ptr_type, int fail_flag);
 /* set the pointer wrapped by an object */
 extern void PerlXlib_objref_set_pointer(SV *objref, void *pointer, const char *ptr_type);
+/* keep finding an object (that has no pointer) by this pointer, until it is freed */
+extern void PerlXlib_objref_cache_pointer(SV *objref, void *pointer);
+
+/* The object cache (see obj_cache.c) */
+extern void PerlXlib_obj_cache_boot(void);
+extern void PerlXlib_obj_cache_clone(void);
+extern SV * PerlXlib_obj_cache_find(void *ptr);
+extern AV * PerlXlib_all_connections(void);
 
 /* Special cases for wrap/get/set Display* on a X11::Xlib instance */
 extern SV * PerlXlib_get_display_objref(Display *dpy, int create_flag);
@@ -57,8 +65,46 @@ extern SV * PerlXlib_get_screen_objref(Screen *screen, int create_flag);
  * be exported to maintain the previous public C API.
  */
 typedef void PerlXlib_struct_pack_fn(void*, HV*, Bool consume);
+/* Extra bytes allocated after every struct buffer, see PerlXlib.c */
+#ifndef X11_Xlib_Struct_Padding
+#define X11_Xlib_Struct_Padding 64
+#endif
 extern void* PerlXlib_get_struct_ptr(SV *sv, int lvalue, const char* pkg, int struct_size, PerlXlib_struct_pack_fn *packer);
+/* Get a buffer of 'count' consecutive structs from either a packed string or an
+ * arrayref of structs.  Elements of the arrayref may be struct objects, hashrefs
+ * (if 'packer' is given), or arrayrefs of 16-bit field values in struct order.
+ */
+extern void* PerlXlib_get_struct_array(SV *sv, const char* pkg, int struct_size, int n_fields,
+    PerlXlib_struct_pack_fn *packer, int *count);
+/* X11::Xlib::StructArray: N structs of one type stored contiguously.
+ * PerlXlib_get_struct_array returns the buffer of one of these directly.
+ */
+typedef struct PerlXlib_struct_type {
+    const char *pkg;
+    int size;
+    int n_fields;  /* number of 16-bit fields, if the struct is only made of those */
+    PerlXlib_struct_pack_fn *packer;
+} PerlXlib_struct_type;
+typedef struct PerlXlib_struct_array {
+    const PerlXlib_struct_type *type;
+    IV views;      /* number of live element views pointing into the buffer */
+} PerlXlib_struct_array;
+extern const PerlXlib_struct_type* PerlXlib_find_struct_type(const char *pkg);
+extern PerlXlib_struct_array* PerlXlib_get_struct_array_info(SV *objref, int fail_flag);
+extern SV* PerlXlib_new_struct_array(const PerlXlib_struct_type *type, const char *class, size_t count);
+extern char* PerlXlib_struct_array_resize(SV *objref, size_t count);
+extern void PerlXlib_struct_array_store(SV *objref, size_t start, SV **elems, size_t n);
+extern SV* PerlXlib_struct_array_elem_obj(SV *objref, size_t idx, int view);
 extern const char* PerlXlib_xevent_pkg_for_type(int type);
+typedef void PerlXlib_xevent_pack_fn(XEvent*, HV*, Bool);
+typedef void PerlXlib_xevent_unpack_fn(XEvent*, HV*);
+extern void PerlXlib_register_ext_event_type(Display *dpy, int type, const char *pkg,
+    PerlXlib_xevent_pack_fn *pack, PerlXlib_xevent_unpack_fn *unpack);
+extern void PerlXlib_unregister_ext_events(Display *dpy);
+extern const char* PerlXlib_xevent_ext_pkg_for_type(int type);
+extern const char* PerlXlib_xevent_pkg_for_event(XEvent *s);
+extern Bool PerlXlib_xevent_ext_pack(XEvent *s, HV *fields, Bool consume);
+extern Bool PerlXlib_xevent_ext_unpack(XEvent *s, HV *fields);
 extern void PerlXlib_XEvent_pack(XEvent *s, HV *fields, Bool consume);
 extern void PerlXlib_XEvent_unpack(XEvent *s, HV *fields);
 extern void PerlXlib_XVisualInfo_pack(XVisualInfo *s, HV *fields, Bool consume);
@@ -79,6 +125,8 @@ extern void PerlXlib_XSizeHints_unpack_obj(XSizeHints *s, HV *fields, SV *obj_re
 extern void PerlXlib_XRectangle_pack(XRectangle *s, HV *fields, Bool consume);
 extern void PerlXlib_XRectangle_unpack(XRectangle *s, HV *fields);
 extern void PerlXlib_XRectangle_unpack_obj(XRectangle *s, HV *fields, SV *obj_ref);
+extern void PerlXlib_XGCValues_pack(XGCValues *s, HV *fields, Bool consume);
+extern void PerlXlib_XGCValues_unpack_obj(XGCValues *s, HV *fields, SV *obj_ref);
 #ifndef HAVE_XRENDER
 /* Copied from X11/extensions/Xrender.h because I decided it was better to define the struct
    than to have the perl interface change depending on whether it found a header file or not.
@@ -103,19 +151,332 @@ typedef struct {
     XRenderDirectFormat direct;
     Colormap            colormap;
 } XRenderPictFormat;
+typedef XID Picture;
+typedef struct _XRenderPictureAttributes {
+    int                 repeat;
+    Picture             alpha_map;
+    int                 alpha_x_origin;
+    int                 alpha_y_origin;
+    int                 clip_x_origin;
+    int                 clip_y_origin;
+    Pixmap              clip_mask;
+    Bool                graphics_exposures;
+    int                 subwindow_mode;
+    int                 poly_edge;
+    int                 poly_mode;
+    Atom                dither;
+    Bool                component_alpha;
+} XRenderPictureAttributes;
+typedef struct {
+    unsigned short      red;
+    unsigned short      green;
+    unsigned short      blue;
+    unsigned short      alpha;
+} XRenderColor;
+typedef XID Glyph;
+typedef XID GlyphSet;
+typedef struct _XGlyphInfo {
+    unsigned short      width;
+    unsigned short      height;
+    short               x;
+    short               y;
+    short               xOff;
+    short               yOff;
+} XGlyphInfo;
 #endif
 extern void PerlXlib_XRenderPictFormat_pack(XRenderPictFormat *s, HV *fields, Bool consume);
 extern void PerlXlib_XRenderPictFormat_unpack(XRenderPictFormat *s, HV *fields);
 extern void PerlXlib_XRenderPictFormat_unpack_obj(XRenderPictFormat *s, HV *fields, SV *obj_ref);
+extern void PerlXlib_XRenderPictureAttributes_pack(XRenderPictureAttributes *s, HV *fields, Bool consume);
+extern void PerlXlib_XRenderPictureAttributes_unpack_obj(XRenderPictureAttributes *s, HV *fields, SV *obj_ref);
+extern void PerlXlib_XRenderColor_pack(XRenderColor *s, HV *fields, Bool consume);
+extern void PerlXlib_XRenderColor_unpack_obj(XRenderColor *s, HV *fields, SV *obj_ref);
+extern void PerlXlib_XGlyphInfo_pack(XGlyphInfo *s, HV *fields, Bool consume);
+extern void PerlXlib_XGlyphInfo_unpack_obj(XGlyphInfo *s, HV *fields, SV *obj_ref);
 
 /* Keysym/unicode utility functions */
 extern int PerlXlib_keysym_to_codepoint(KeySym keysym);
 extern KeySym PerlXlib_codepoint_to_keysym(int codepoint);
+extern KeySym PerlXlib_codepoint_to_legacy_keysym(int codepoint);
 extern SV * PerlXlib_keysym_to_sv(KeySym keysym, int symbolic);
 extern KeySym PerlXlib_sv_to_keysym(SV *sv);
 
+/* Pixel format conversion.  The format codes are the bytes per output pixel. */
+#define PerlXlib_PIXFMT_GRAY 1
+#define PerlXlib_PIXFMT_RGB  3
+#define PerlXlib_PIXFMT_RGBA 4
+#define PerlXlib_PIXCONV_SCALAR 0
+#define PerlXlib_PIXCONV_SSE2   1
+#define PerlXlib_PIXCONV_SSSE3  2
+#define PerlXlib_PIXCONV_AVX2   3
+extern void PerlXlib_convert_pixels(const char *src, size_t src_stride, int width, int height,
+    int bits_per_pixel, int byte_order,
+    unsigned long red_mask, unsigned long green_mask, unsigned long blue_mask,
+    int dst_format, char *dst);
+extern int PerlXlib_pixconv_level(int max_level);
+
+/* Tile hashing for change detection */
+#include <stdint.h>
+extern size_t PerlXlib_tile_hash_diff(const char *src, size_t stride, int width, int height,
+    int bytes_per_pixel, int tile_width, int tile_height, uint64_t *hashes, U8 *changed);
+
+/* Per-display index of all visuals (see visual_index.c).  dpy_obj is the
+ * X11::Xlib display object, which holds the index.
+ */
+extern const XVisualInfo* PerlXlib_visual_index_list(SV *dpy_obj, int *count);
+extern const XVisualInfo* PerlXlib_visual_index_by_id(SV *dpy_obj, VisualID id);
+extern const XVisualInfo* PerlXlib_visual_index_for_visual(SV *dpy_obj, Visual *vis);
+extern int PerlXlib_visual_index_search(SV *dpy_obj, long mask, const XVisualInfo *tpl, int *out);
+
+/* Client-side regions: banded lists of boxes (see region.c) */
+typedef struct PerlXlib_box { I32 x1, y1, x2, y2; } PerlXlib_box;
+#define PerlXlib_REGION_UNION     1
+#define PerlXlib_REGION_INTERSECT 2
+#define PerlXlib_REGION_SUBTRACT  3
+extern void PerlXlib_region_from_boxes(SV *out, const PerlXlib_box *boxes, size_t n);
+extern void PerlXlib_region_op(SV *out, const PerlXlib_box *a, size_t na, const PerlXlib_box *b, size_t nb, int op);
+extern int PerlXlib_region_contains_point(const PerlXlib_box *boxes, size_t n, I32 x, I32 y);
+
+/* Keymap as a keycode x level table plus a reverse KeySym index (see keymap_index.c).
+ * Modifier fields are the modmap group (0..7) of that function, or -1.
+ * xkb_off is the offset of a PerlXlib_keymap_xkb section, or 0.
+ */
+typedef struct PerlXlib_keymap_index {
+    int min_keycode, max_keycode, nsym, max_keypermod;
+    int capslock, shiftlock, numlock, mode;
+    U32 rev_mask, xkb_off;
+} PerlXlib_keymap_index;
+extern void PerlXlib_keymap_index_build(SV *out, const KeySym *syms, int min_keycode, int max_keycode, int nsym,
+    const KeyCode *modmap, int max_keypermod);
+extern void PerlXlib_keymap_index_update(SV *idx, const KeySym *syms, int first, int count, int nsym);
+extern void PerlXlib_keymap_index_set_modmap(SV *idx, const KeyCode *modmap, int max_keypermod);
+extern KeySym PerlXlib_keymap_index_get(const PerlXlib_keymap_index *ki, int keycode, int level);
+extern const KeySym* PerlXlib_keymap_index_rows(const PerlXlib_keymap_index *ki, int keycode);
+extern int PerlXlib_keymap_index_diff(const PerlXlib_keymap_index *a, const PerlXlib_keymap_index *b,
+    int min, int max, int gap, int *ranges);
+extern const KeyCode* PerlXlib_keymap_index_modmap(const PerlXlib_keymap_index *ki);
+extern int PerlXlib_keymap_index_level_mods(const PerlXlib_keymap_index *ki, int level);
+extern int PerlXlib_keymap_index_find_keycode(const PerlXlib_keymap_index *ki, KeySym sym, int *level);
+extern KeySym PerlXlib_keymap_index_find_keysym(const PerlXlib_keymap_index *ki, int keycode, unsigned modifiers);
+extern int PerlXlib_keymap_index_key_mods(const PerlXlib_keymap_index *ki, int keycode, int level);
+extern void PerlXlib_keymap_index_attach_xkb(SV *idx, const char *xkb, STRLEN len);
+
+/* XKB key types and the groups of each key, appended to an index loaded with
+ * XkbGetMap (see xkb_keymap.c).  It is followed by ntypes type records, then
+ * nentries map entries.  Modifier masks are the effective (real) modifiers.
+ * A key with num_groups 0 falls back to the core rules.
+ */
+typedef struct PerlXlib_keymap_xkb_type {
+    U8 mods, num_levels;
+    U16 first_entry, map_count;
+} PerlXlib_keymap_xkb_type;
+typedef struct PerlXlib_keymap_xkb_entry {
+    U8 mods, level, preserve, active;
+} PerlXlib_keymap_xkb_entry;
+typedef struct PerlXlib_keymap_xkb {
+    U16 ntypes, nentries;
+    U8 num_groups[256], group_info[256], kt[256][4];
+} PerlXlib_keymap_xkb;
+extern int PerlXlib_keymap_index_load_xkb(Display *dpy, SV *out);
+extern int PerlXlib_keymap_index_reload_xkb(Display *dpy, int types, int first_sym, int last_sym,
+    int first_mod, int last_mod, SV **idx, int n);
+extern KeySym PerlXlib_keymap_xkb_keysym(const PerlXlib_keymap_index *ki, int keycode, int group, int level);
+extern KeySym PerlXlib_keymap_xkb_translate(const PerlXlib_keymap_index *ki, int keycode, unsigned state);
+extern int PerlXlib_keymap_xkb_key_mods(const PerlXlib_keymap_index *ki, int keycode, int level);
+
+/* One step of typing a string (see key_sequence.c).  'wait' says which of the
+ * caller's delays to apply before the step.
+ */
+typedef struct PerlXlib_key_step {
+    KeySym sym;
+    U8 op, keycode, wait, pad;
+} PerlXlib_key_step;
+#define PerlXlib_KEY_PRESS     1
+#define PerlXlib_KEY_RELEASE   2
+#define PerlXlib_KEY_REMAP     3  /* map keycode to 'sym' */
+#define PerlXlib_KEY_RESTORE   4  /* map keycode back to its KeySyms in the index */
+#define PerlXlib_KEY_SYNC      5  /* wait until clients have read the events so far */
+#define PerlXlib_KEY_WAIT_NONE  0
+#define PerlXlib_KEY_WAIT_DELAY 1  /* pause between characters */
+#define PerlXlib_KEY_WAIT_HOLD  2  /* time a key is held down */
+/* Worst case: a sync, releasing and pressing all 8 modifiers, a remap, press
+ * and release per character, then 8 modifier releases, a sync and a restore
+ * per spare.
+ */
+#define PerlXlib_KEY_STEPS_MAX(n, nspare) ((n) * 20 + 9 + (nspare))
+extern int PerlXlib_keymap_index_spare_keycodes(const PerlXlib_keymap_index *ki, KeyCode *out);
+extern int PerlXlib_keymap_index_plan_text(const PerlXlib_keymap_index *ki, const UV *codepoints, int n,
+    const KeyCode *spare, int nspare, PerlXlib_key_step *out);
+
+/* One fake input event for PerlXlib_input_play (see input_player.c).  'type'
+ * is KeyPress, KeyRelease, ButtonPress, ButtonRelease or MotionNotify, and
+ * 'detail' the keycode, button, or screen of the motion (-1 for the current
+ * one).  'delay_ms' is counted from the previous action's scheduled time.
+ * This is the layout of pack('l5') in Perl.
+ */
+typedef struct PerlXlib_input_action {
+    I32 type, detail, x, y, delay_ms;
+} PerlXlib_input_action;
+/* Not an X event type: XTestFakeRelativeMotionEvent by (x, y) */
+#define PerlXlib_INPUT_RELATIVE_MOTION (LASTEvent + 1)
+extern const char* PerlXlib_input_action_check(const PerlXlib_input_action *act);
+extern I64 PerlXlib_input_play(Display *dpy, const PerlXlib_input_action *acts, int n, I64 *late_us);
+extern void PerlXlib_sleep_ms(int ms);
+
+/* A gesture for PerlXlib_pointer_path_actions (see pointer_path.c).  'points'
+ * is npoints (x, y) pairs.  If 'button' is nonzero it is held down for the
+ * whole path.  If 'relative' is set, the motion is relative to wherever the
+ * pointer is, and the points are only used for their differences.
+ */
+typedef struct PerlXlib_pointer_path {
+    const double *points;
+    int npoints, curve, ease, duration_ms, rate, button, screen, relative;
+} PerlXlib_pointer_path;
+#define PerlXlib_PATH_LINEAR 0
+#define PerlXlib_PATH_BEZIER 1
+#define PerlXlib_PATH_EASE_NONE   0
+#define PerlXlib_PATH_EASE_IN     1
+#define PerlXlib_PATH_EASE_OUT    2
+#define PerlXlib_PATH_EASE_IN_OUT 3
+/* Paths are limited to this many motion steps, so the action buffer stays
+ * a sane size and the step count fits in an int. */
+#define PerlXlib_POINTER_PATH_STEPS_MAX 1000000
+#define PerlXlib_POINTER_PATH_STEPS(p) \
+    ((int) ((I64) (p)->duration_ms * (p)->rate < 1000? 1 \
+        : (I64) (p)->duration_ms * (p)->rate / 1000 > PerlXlib_POINTER_PATH_STEPS_MAX? PerlXlib_POINTER_PATH_STEPS_MAX \
+        : (I64) (p)->duration_ms * (p)->rate / 1000))
+#define PerlXlib_POINTER_PATH_MAX_ACTIONS(p) (PerlXlib_POINTER_PATH_STEPS(p) + 3)
+extern int PerlXlib_pointer_path_actions(const PerlXlib_pointer_path *path, double *scratch, PerlXlib_input_action *out);
+
+/* An XI2 device or raw event (see xi2_events.c).  Valuator i (for i below
+ * PerlXlib_XI2_VALUATORS) is in values[i] if bit i of valuator_mask is set.
+ * raw_values are only for raw events, and window and the coordinates only for
+ * device events.  This is the layout of pack('L8 d20') in Perl.
+ */
+#define PerlXlib_XI2_VALUATORS 8
+typedef struct PerlXlib_xi2_record {
+    U32 evtype, deviceid, sourceid, detail, time, flags, valuator_mask, window;
+    double event_x, event_y, root_x, root_y;
+    double values[PerlXlib_XI2_VALUATORS], raw_values[PerlXlib_XI2_VALUATORS];
+} PerlXlib_xi2_record;
+#ifdef HAVE_XI
+extern int PerlXlib_xi2_is_record_type(int evtype);
+extern int PerlXlib_xi2_decode(const XGenericEventCookie *cookie, PerlXlib_xi2_record *rec);
+#endif
+
+#ifdef HAVE_FREETYPE
+/* Rasterize one glyph from a font file as an A8 image for XRenderAddGlyphs */
+extern SV * PerlXlib_ft_render_glyph(const char *path, int pixel_size, UV codepoint, XGlyphInfo *info);
+#endif
+
 extern void PerlXlib_install_error_handlers(Bool nonfatal, Bool fatal);
 
+/* The fields of an XErrorEvent that the error ring keeps (see error_ring.c) */
+typedef struct PerlXlib_error_record {
+    unsigned long serial;
+    XID resourceid;
+    U8 error_code, request_code, minor_code, pad;
+} PerlXlib_error_record;
+/* A ring of the most recent errors of a display.  'rec' has mask+1 entries
+ * and the oldest is rec[head].  'dropped' counts records overwritten when full.
+ */
+typedef struct PerlXlib_error_ring {
+    U32 mask, head, count, pad;
+    UV dropped;
+    PerlXlib_error_record rec[1];
+} PerlXlib_error_ring;
+#define PerlXlib_ERROR_RING_SIZE(capacity) \
+    (sizeof(PerlXlib_error_ring) + ((capacity) - 1) * sizeof(PerlXlib_error_record))
+/* Which records to count or take.  A code of -1 matches any, and the
+ * resourceid is only compared if has_resourceid is set.
+ */
+typedef struct PerlXlib_error_filter {
+    int error_code, request_code, minor_code, has_resourceid;
+    XID resourceid;
+    unsigned long min_serial, max_serial;
+} PerlXlib_error_filter;
+extern void PerlXlib_error_ring_init(PerlXlib_error_ring *ring, U32 capacity);
+extern void PerlXlib_error_ring_push(PerlXlib_error_ring *ring, const XErrorEvent *e);
+extern void PerlXlib_error_filter_init(PerlXlib_error_filter *filter);
+extern int PerlXlib_error_ring_count(const PerlXlib_error_ring *ring, const PerlXlib_error_filter *filter);
+extern int PerlXlib_error_ring_take(PerlXlib_error_ring *ring, const PerlXlib_error_filter *filter,
+    PerlXlib_error_record *out);
+extern PerlXlib_error_ring * PerlXlib_display_error_ring(SV *dpy_obj);
+
+/* The Xlib calls that wait for a reply, which the display stats count
+ * separately (see display_stats.c).  Keep PerlXlib_display_stats_names in
+ * the same order.
+ */
+enum {
+    PerlXlib_STAT_XSync, PerlXlib_STAT_XInternAtom, PerlXlib_STAT_XInternAtoms,
+    PerlXlib_STAT_XGetAtomName, PerlXlib_STAT_XGetAtomNames, PerlXlib_STAT_XGetGeometry,
+    PerlXlib_STAT_XListProperties, PerlXlib_STAT_XGetWindowProperty, PerlXlib_STAT_XGetWMProtocols,
+    PerlXlib_STAT_XGetWMSizeHints, PerlXlib_STAT_XGetWMNormalHints, PerlXlib_STAT_XGetWindowAttributes,
+    PerlXlib_STAT_XQueryTree, PerlXlib_STAT_XTranslateCoordinates, PerlXlib_STAT_XQueryKeymap,
+    PerlXlib_STAT_XQueryPointer, PerlXlib_STAT_XGrabKeyboard, PerlXlib_STAT_XGrabPointer,
+    PerlXlib_STAT_XGetKeyboardMapping, PerlXlib_STAT_XGetModifierMapping, PerlXlib_STAT_XkbGetMap,
+    PerlXlib_STAT_XkbGetMapChanges, PerlXlib_STAT_XFixesFetchRegion, PerlXlib_STAT_XIQueryDevice,
+    PerlXlib_STAT_XQueryExtension,
+    PerlXlib_STAT_COUNT
+};
+/* Wait times go in log2 buckets of microseconds; bucket i counts waits of
+ * 2**i up to 2**(i+1) us, except that bucket 0 starts at 0 and the last
+ * bucket has no upper limit.
+ */
+#define PerlXlib_STATS_BUCKETS 24
+typedef struct PerlXlib_display_stats {
+    unsigned long base_serial; /* NextRequest at the last reset */
+    UV bytes_flushed;
+    UV calls[PerlXlib_STAT_COUNT];
+    I64 wait_ns[PerlXlib_STAT_COUNT];
+    UV wait_histogram[PerlXlib_STATS_BUCKETS];
+} PerlXlib_display_stats;
+extern int PerlXlib_display_stats_active;
+extern const char * PerlXlib_display_stats_names[PerlXlib_STAT_COUNT];
+extern I64 PerlXlib_stats_now_ns(void);
+extern void PerlXlib_display_stats_wait(Display *dpy, int call, I64 start_ns);
+extern void PerlXlib_display_stats_reset(Display *dpy, PerlXlib_display_stats *stats);
+extern void PerlXlib_display_stats_hook(Display *dpy);
+extern void PerlXlib_display_stats_release(SV *dpy_hv);
+extern PerlXlib_display_stats * PerlXlib_display_stats_of(SV *dpy_obj);
+/* One traced XS call (see request_trace.c).  'fn' indexes the table of
+ * wrapped functions and 'file' the table of caller file names.
+ */
+typedef struct PerlXlib_trace_record {
+    I64 start_ns, end_ns;
+    unsigned long serial_begin, serial_end;
+    U32 fn, file, line, pad;
+} PerlXlib_trace_record;
+/* The ring of the most recent calls on a display.  'rec' has mask+1 entries,
+ * and 'head' counts every record written, so the oldest kept is head-mask-1.
+ */
+typedef struct PerlXlib_trace_ring {
+    U32 mask, pad;
+    UV head;
+    PerlXlib_trace_record rec[1];
+} PerlXlib_trace_ring;
+#define PerlXlib_TRACE_RING_SIZE(capacity) \
+    (sizeof(PerlXlib_trace_ring) + ((capacity) - 1) * sizeof(PerlXlib_trace_record))
+extern void PerlXlib_trace_install(Bool enable);
+extern void PerlXlib_trace_boot(void);
+extern void PerlXlib_trace_clone(void);
+extern void PerlXlib_trace_release(SV *dpy_hv);
+extern PerlXlib_trace_ring * PerlXlib_display_trace_ring(SV *dpy_obj);
+extern SV * PerlXlib_trace_json(const PerlXlib_trace_ring *ring);
+
+/* Run the statements of a call that waits for a reply, and time it if any
+ * display has stats enabled.
+ */
+#define PerlXlib_ROUND_TRIP(dpy, call, ...) do { \
+    if (PerlXlib_display_stats_active) { \
+        I64 stats_start_= PerlXlib_stats_now_ns(); \
+        __VA_ARGS__; \
+        PerlXlib_display_stats_wait(dpy, PerlXlib_STAT_##call, stats_start_); \
+    } else { \
+        __VA_ARGS__; \
+    } \
+} while (0)
+
 /* Back-compat, deprecated */
 extern Display * PerlXlib_get_magic_dpy(SV *sv, Bool not_null);
 extern SV * PerlXlib_set_magic_dpy(SV *sv, Display *dpy);
@@ -9,6 +9,7 @@
 #include <X11/Xlib.h>
 #include <X11/Xutil.h>
 #include <X11/Xlibint.h>
+#include <X11/XKBlib.h>
 #include <X11/extensions/XTest.h>
 #ifdef HAVE_XCOMPOSITE
 #include <X11/extensions/Xcomposite.h>
@@ -19,6 +20,12 @@
 #ifdef HAVE_XRENDER
 #include <X11/extensions/Xrender.h>
 #endif
+#ifdef HAVE_XDAMAGE
+#include <X11/extensions/Xdamage.h>
+#endif
+#ifdef HAVE_XI
+#include <X11/extensions/XInput2.h>
+#endif
 
 #include "PerlXlib.h"
 void PerlXlib_sanity_check_data_structures();
@@ -69,6 +76,580 @@ static Bool is_an_integer(SV *sv) {
     return len > 0;
 }
 
+/* X11::Xlib::Region objects are blessed scalar refs whose buffer is an array
+ * of PerlXlib_box in banded order.
+ */
+static PerlXlib_box* _region_boxes(SV *region, size_t *n) {
+    if (!sv_isobject(region) || !sv_derived_from(region, "X11::Xlib::Region") || SvTYPE(SvRV(region)) >= SVt_PVAV)
+        croak("Expected X11::Xlib::Region");
+    *n= SvPOK(SvRV(region))? SvCUR(SvRV(region)) / sizeof(PerlXlib_box) : 0;
+    return *n? (PerlXlib_box*) SvPVX(SvRV(region)) : NULL;
+}
+
+/* Build a region in 'out' from anything PerlXlib_get_struct_array accepts as
+ * a list of XRectangle.
+ */
+static void _region_from_rects(SV *out, SV *rects_sv) {
+    XRectangle *r;
+    PerlXlib_box *boxes;
+    int n, i;
+    r= (XRectangle*) PerlXlib_get_struct_array(rects_sv, "X11::Xlib::XRectangle", sizeof(XRectangle), 4,
+        (PerlXlib_struct_pack_fn*) &PerlXlib_XRectangle_pack, &n);
+    if (!n) return;
+    Newx(boxes, n, PerlXlib_box);
+    SAVEFREEPV(boxes);
+    for (i= 0; i < n; i++) {
+        boxes[i].x1= r[i].x;
+        boxes[i].y1= r[i].y;
+        boxes[i].x2= (I32) r[i].x + r[i].width;
+        boxes[i].y2= (I32) r[i].y + r[i].height;
+    }
+    PerlXlib_region_from_boxes(out, boxes, n);
+}
+
+/* Accept either a Region or a list of rectangles as the argument of a region
+ * operation.
+ */
+static PerlXlib_box* _region_arg(SV *sv, size_t *n) {
+    SV *tmp;
+    if (sv_isobject(sv) && sv_derived_from(sv, "X11::Xlib::Region"))
+        return _region_boxes(sv, n);
+    tmp= sv_2mortal(newSVpvn("", 0));
+    _region_from_rects(tmp, sv);
+    *n= SvCUR(tmp) / sizeof(PerlXlib_box);
+    return (PerlXlib_box*) SvPVX(tmp);
+}
+
+/* Wrap a region buffer as a new object of the same class as 'self' */
+static SV* _region_wrap(SV *self, SV *buf) {
+    const char *class= sv_isobject(self)? sv_reftype(SvRV(self), 1) : SvPV_nolen(self);
+    return sv_bless(sv_2mortal(newRV_noinc(buf)), gv_stashpv(class, GV_ADD));
+}
+
+static I32 _region_clamp(IV v, IV lo, IV hi) {
+    return v < lo? lo : v > hi? hi : v;
+}
+
+/* Add an offset to a coordinate, saturating at the limits of I32 */
+static I32 _region_shift(I32 v, IV d) {
+    return d > 0 && v > I32_MAX - d? I32_MAX
+        : d < 0 && v < I32_MIN - d? I32_MIN
+        : (I32)(v + d);
+}
+
+/* Convert a box to an XRectangle, clamping to the 16-bit protocol limits */
+static void _region_box_to_rect(const PerlXlib_box *b, XRectangle *r) {
+    I32 x1= _region_clamp(b->x1, -32768, 32767), y1= _region_clamp(b->y1, -32768, 32767);
+    r->x= x1;
+    r->y= y1;
+    r->width=  _region_clamp((IV) b->x2 - x1, 0, 65535);
+    r->height= _region_clamp((IV) b->y2 - y1, 0, 65535);
+}
+
+/* The index built by X11::Xlib::Keymap->_index is a PV holding a
+ * PerlXlib_keymap_index and its tables.
+ */
+static PerlXlib_keymap_index* _keymap_index_arg(SV *sv) {
+    if (!SvPOK(sv) || SvCUR(sv) < sizeof(PerlXlib_keymap_index))
+        croak("Expected X11::Xlib::Keymap index");
+    return (PerlXlib_keymap_index*) SvPVX(sv);
+}
+
+/* Convert 'count' rows of a keymap arrayref (in the form load_keymap returns),
+ * starting from element 'from' which describes keycode 'keycode', into a
+ * KeySym array with *nsym per row.  Rows that aren't arrayrefs stay empty.
+ */
+static KeySym* _keymap_av_syms(AV *kmap, int from, int count, int keycode, int *nsym) {
+    KeySym *syms;
+    SV **elem;
+    AV *row;
+    int i, j, n;
+    *nsym= 1;
+    for (i= 0; i < count; i++) {
+        elem= av_fetch(kmap, from + i, 0);
+        if (elem && *elem && SvROK(*elem) && SvTYPE(SvRV(*elem)) == SVt_PVAV
+            && *nsym < (n= av_len((AV*) SvRV(*elem)) + 1))
+            *nsym= n;
+    }
+    Newxz(syms, count * *nsym + 1, KeySym);
+    SAVEFREEPV(syms);
+    for (i= 0; i < count; i++) {
+        elem= av_fetch(kmap, from + i, 0);
+        if (!elem || !*elem || !SvROK(*elem) || SvTYPE(SvRV(*elem)) != SVt_PVAV)
+            continue;
+        row= (AV*) SvRV(*elem);
+        for (j= 0, n= av_len(row) + 1; j < n; j++) {
+            elem= av_fetch(row, j, 0);
+            if (elem && *elem && SvOK(*elem)) {
+                if ((syms[i * *nsym + j]= PerlXlib_sv_to_keysym(*elem)) == NoSymbol)
+                    croak("No such KeySym %s (slot %d of keycode %d)", SvPV_nolen(*elem), j, keycode + i);
+            }
+        }
+    }
+    return syms;
+}
+
+/* Convert a modmap arrayref (in the form XGetModifierMapping returns) to
+ * the packed form of XModifierKeymap, returning max_keypermod.
+ */
+static int _keymap_av_modmap(AV *mmap, KeyCode keycodes[64]) {
+    int max_keypermod= 0, i, j, n;
+    SV **elem;
+    AV *row;
+    memset(keycodes, 0, 64);
+    if (av_len(mmap) != 7)
+        croak("Expected arrayref of length 8");
+    for (i= 0; i < 8; i++) {
+        elem= av_fetch(mmap, i, 0);
+        if (!elem || !*elem || !SvROK(*elem) || SvTYPE(SvRV(*elem)) != SVt_PVAV)
+            croak("Expected arrayref of arrayrefs");
+        row= (AV*) SvRV(*elem);
+        n= av_len(row) + 1;
+        if (n > 8)
+            croak("There can be at most 8 keys per modifier");
+        if (n > max_keypermod)
+            max_keypermod= n;
+        for (j= 0; j < n; j++) {
+            elem= av_fetch(row, j, 0);
+            if (elem && *elem && SvOK(*elem)) {
+                if (SvIV(*elem) < 0 || SvIV(*elem) > 255)
+                    croak("Keycode %ld out of range", (long) SvIV(*elem));
+                keycodes[i*8+j]= SvIV(*elem);
+            }
+        }
+    }
+    /* pack the rows to max_keypermod */
+    for (i= 1; i < 8; i++)
+        for (j= 0; j < max_keypermod; j++)
+            keycodes[i * max_keypermod + j]= keycodes[i*8+j];
+    return max_keypermod;
+}
+
+/* Plan the key events to type a string with a keymap index.  'spare' is an
+ * arrayref of keycodes that may be remapped for characters the keymap lacks,
+ * or undef for every keycode the index shows as unused.  Returns a temporary
+ * array of steps, and croaks if a character can't be typed.
+ */
+static PerlXlib_key_step* _keymap_type_plan(SV *idx, SV *str, SV *spare, int *nsteps, int *nchars) {
+    PerlXlib_keymap_index *ki= _keymap_index_arg(idx);
+    PerlXlib_key_step *steps;
+    KeyCode spare_kc[256];
+    UV *codepoints;
+    STRLEN len, clen;
+    U8 *s, *end;
+    SV **elem;
+    AV *av;
+    int nspare= 0, n= 0, i;
+    if (SvOK(spare)) {
+        if (!SvROK(spare) || SvTYPE(SvRV(spare)) != SVt_PVAV)
+            croak("Expected arrayref of spare keycodes");
+        av= (AV*) SvRV(spare);
+        for (i= 0; i <= av_len(av) && nspare < 256; i++) {
+            elem= av_fetch(av, i, 0);
+            if (!elem || !*elem || !SvOK(*elem)) continue;
+            if (SvIV(*elem) < ki->min_keycode || SvIV(*elem) > ki->max_keycode)
+                croak("Keycode %ld out of range", (long) SvIV(*elem));
+            spare_kc[nspare++]= SvIV(*elem);
+        }
+    }
+    else
+        nspare= PerlXlib_keymap_index_spare_keycodes(ki, spare_kc);
+    s= (U8*) SvPV(str, len);
+    end= s + len;
+    Newx(codepoints, len + 1, UV);
+    SAVEFREEPV(codepoints);
+    while (s < end) {
+        if (DO_UTF8(str)) {
+            codepoints[n++]= NATIVE_TO_UNI(utf8n_to_uvchr(s, end - s, &clen, 0));
+            s += clen? clen : 1;
+        } else
+            codepoints[n++]= NATIVE_TO_UNI(*s++);
+    }
+    Newx(steps, PerlXlib_KEY_STEPS_MAX(n, nspare), PerlXlib_key_step);
+    SAVEFREEPV(steps);
+    *nsteps= PerlXlib_keymap_index_plan_text(ki, codepoints, n, spare_kc, nspare, steps);
+    if (*nsteps < 0)
+        croak("No key for character U+%04lX and no spare keycodes to map it to",
+            (unsigned long) codepoints[-1 - *nsteps]);
+    *nchars= n;
+    return steps;
+}
+
+/* Get the actions for play_input from a packed string, or an arrayref of
+ * [ type, detail, x, y, delay_ms ] arrayrefs.  Returns a temporary array.
+ */
+static PerlXlib_input_action* _input_actions_arg(SV *actions, int *n) {
+    PerlXlib_input_action *acts;
+    const char *problem;
+    STRLEN len;
+    SV **elem, **field;
+    AV *list, *row;
+    int i;
+    if (SvROK(actions) && SvTYPE(SvRV(actions)) == SVt_PVAV) {
+        list= (AV*) SvRV(actions);
+        *n= av_len(list) + 1;
+        Newxz(acts, *n + 1, PerlXlib_input_action);
+        SAVEFREEPV(acts);
+        for (i= 0; i < *n; i++) {
+            elem= av_fetch(list, i, 0);
+            if (!elem || !*elem || !SvROK(*elem) || SvTYPE(SvRV(*elem)) != SVt_PVAV)
+                croak("Expected arrayref of [ type, detail, x, y, delay_ms ]");
+            row= (AV*) SvRV(*elem);
+#define INPUT_ACTION_FIELD(idx, f) \
+            if ((field= av_fetch(row, idx, 0)) && *field && SvOK(*field)) acts[i].f= SvIV(*field);
+            INPUT_ACTION_FIELD(0, type)
+            INPUT_ACTION_FIELD(1, detail)
+            INPUT_ACTION_FIELD(2, x)
+            INPUT_ACTION_FIELD(3, y)
+            INPUT_ACTION_FIELD(4, delay_ms)
+#undef INPUT_ACTION_FIELD
+        }
+    }
+    else if (SvOK(actions) && !SvROK(actions)) {
+        SvPV(actions, len);
+        if (len % sizeof(PerlXlib_input_action))
+            croak("Length of packed actions is not a multiple of %d", (int) sizeof(PerlXlib_input_action));
+        *n= len / sizeof(PerlXlib_input_action);
+        /* copy, since the string buffer might not be aligned */
+        Newx(acts, *n + 1, PerlXlib_input_action);
+        SAVEFREEPV(acts);
+        memcpy(acts, SvPVX(actions), len);
+    }
+    else
+        croak("Expected packed string or arrayref of actions");
+    for (i= 0; i < *n; i++)
+        if ((problem= PerlXlib_input_action_check(acts + i)))
+            croak("Action %d: %s", i, problem);
+    return acts;
+}
+
+static int _input_cmp_i64(const void *a, const void *b) {
+    I64 x= *(const I64*) a, y= *(const I64*) b;
+    return x < y? -1 : x > y? 1 : 0;
+}
+
+/* Keymap::save sends each range of changed keys as one XChangeKeyboardMapping,
+ * and every one of those makes every client on the server reload that range,
+ * so runs of changes up to this many keys apart are sent together.
+ */
+#define KEYMAP_SAVE_MERGE_GAP 8
+
+/* Push the KeySym in the same form load_keymap would use, or undef */
+static SV* _keymap_sym_sv(KeySym sym, int symbolic) {
+    SV *sv;
+    if (sym == NoSymbol) return &PL_sv_undef;
+    sv= PerlXlib_keysym_to_sv(sym, symbolic);
+    return sv? sv_2mortal(sv) : sv_2mortal(newSVuv(sym));
+}
+
+#ifdef HAVE_XDAMAGE
+
+/* Return a hashref stored in the display object's hash under 'key', creating
+ * it if needed.  This is where per-connection caches get stored so that they
+ * are freed along with the Display object.
+ */
+static HV* _display_hv_slot(SV *dpy_obj, const char *key) {
+    SV **ent;
+    HV *hv= NULL;
+    if (SvROK(dpy_obj) && SvTYPE(SvRV(dpy_obj)) == SVt_PVHV) {
+        if ((ent= hv_fetch((HV*) SvRV(dpy_obj), key, strlen(key), 1))) {
+            if (SvROK(*ent) && SvTYPE(SvRV(*ent)) == SVt_PVHV)
+                hv= (HV*) SvRV(*ent);
+            else
+                sv_setsv(*ent, sv_2mortal(newRV_noinc((SV*) (hv= newHV()))));
+        }
+    }
+    if (!hv)
+        croak("%s is not a hashref", key);
+    return hv;
+}
+
+/* Number of rectangles kept per Damage object between calls to
+ * damage_take_rects.  The rectangles collected by each damage_accumulate are
+ * merged into one region with the rectangles already pending; if that region
+ * needs more than this many rectangles, it is replaced by its bounding box,
+ * trading some over-repaint for a list that stays short no matter how many
+ * events arrive.  Raw rectangles are also merged whenever this many times
+ * four have piled up, so a long burst of events doesn't grow the buffer.
+ */
+#define DAMAGE_ACCUM_MAX_RECTS 32
+
+/* Replace the packed XRectangle list in 'buf' with the rectangles of the
+ * banded region covering the same area, or with its bounding box.
+ */
+static void _damage_accum_merge(SV *buf) {
+    XRectangle *rects= (XRectangle*) SvPVX(buf);
+    size_t n= SvCUR(buf) / sizeof(XRectangle), i;
+    PerlXlib_box *boxes, bbox;
+    SV *region;
+    if (n < 2) return;
+    ENTER;
+    Newx(boxes, n, PerlXlib_box);
+    SAVEFREEPV(boxes);
+    for (i= 0; i < n; i++) {
+        boxes[i].x1= rects[i].x;
+        boxes[i].y1= rects[i].y;
+        boxes[i].x2= rects[i].x + rects[i].width;
+        boxes[i].y2= rects[i].y + rects[i].height;
+    }
+    region= newSVpvn("", 0);
+    SAVEFREESV(region);
+    PerlXlib_region_from_boxes(region, boxes, n);
+    boxes= (PerlXlib_box*) SvPVX(region);
+    n= SvCUR(region) / sizeof(PerlXlib_box);
+    if (n > DAMAGE_ACCUM_MAX_RECTS) {
+        bbox= boxes[0];
+        for (i= 1; i < n; i++) {
+            if (boxes[i].x1 < bbox.x1) bbox.x1= boxes[i].x1;
+            if (boxes[i].x2 > bbox.x2) bbox.x2= boxes[i].x2;
+            if (boxes[i].y2 > bbox.y2) bbox.y2= boxes[i].y2;
+        }
+        boxes= &bbox;
+        n= 1;
+    }
+    rects= (XRectangle*) SvGROW(buf, n * sizeof(XRectangle) + 1);
+    for (i= 0; i < n; i++) {
+        rects[i].x= boxes[i].x1;
+        rects[i].y= boxes[i].y1;
+        rects[i].width=  boxes[i].x2 - boxes[i].x1 > 0xFFFF? 0xFFFF : boxes[i].x2 - boxes[i].x1;
+        rects[i].height= boxes[i].y2 - boxes[i].y1 > 0xFFFF? 0xFFFF : boxes[i].y2 - boxes[i].y1;
+    }
+    SvCUR_set(buf, n * sizeof(XRectangle));
+    LEAVE;
+}
+
+/* Append one rectangle to a packed buffer of XRectangle */
+static void _damage_accum_add(SV *buf, XRectangle *r) {
+    STRLEN len= SvCUR(buf);
+    if (!r->width || !r->height)
+        return;
+    if (len >= DAMAGE_ACCUM_MAX_RECTS * 4 * sizeof(XRectangle)) {
+        _damage_accum_merge(buf);
+        len= SvCUR(buf);
+    }
+    memcpy(SvGROW(buf, len + sizeof(XRectangle) + 1) + len, r, sizeof(XRectangle));
+    SvCUR_set(buf, len + sizeof(XRectangle));
+}
+
+static void _damage_event_pack(XEvent *e, HV *fields, Bool consume) {
+    XDamageNotifyEvent *s= (XDamageNotifyEvent*) e;
+    SV **fp;
+    if ((fp= hv_fetch(fields, "drawable", 8, 0)) && *fp) s->drawable= PerlXlib_sv_to_xid(*fp);
+    if ((fp= hv_fetch(fields, "damage", 6, 0)) && *fp) s->damage= PerlXlib_sv_to_xid(*fp);
+    if ((fp= hv_fetch(fields, "level", 5, 0)) && *fp) s->level= SvIV(*fp);
+    if ((fp= hv_fetch(fields, "more", 4, 0)) && *fp) s->more= SvTRUE(*fp);
+    if ((fp= hv_fetch(fields, "timestamp", 9, 0)) && *fp) s->timestamp= SvUV(*fp);
+    if ((fp= hv_fetch(fields, "area", 4, 0)) && *fp)
+        s->area= *(XRectangle*) PerlXlib_get_struct_ptr(*fp, 0, "X11::Xlib::XRectangle",
+            sizeof(XRectangle), (PerlXlib_struct_pack_fn*) &PerlXlib_XRectangle_pack);
+    if ((fp= hv_fetch(fields, "geometry", 8, 0)) && *fp)
+        s->geometry= *(XRectangle*) PerlXlib_get_struct_ptr(*fp, 0, "X11::Xlib::XRectangle",
+            sizeof(XRectangle), (PerlXlib_struct_pack_fn*) &PerlXlib_XRectangle_pack);
+    if (consume) {
+        hv_delete(fields, "drawable", 8, G_DISCARD);
+        hv_delete(fields, "damage", 6, G_DISCARD);
+        hv_delete(fields, "level", 5, G_DISCARD);
+        hv_delete(fields, "more", 4, G_DISCARD);
+        hv_delete(fields, "timestamp", 9, G_DISCARD);
+        hv_delete(fields, "area", 4, G_DISCARD);
+        hv_delete(fields, "geometry", 8, G_DISCARD);
+    }
+}
+
+static void _damage_event_unpack(XEvent *e, HV *fields) {
+    XDamageNotifyEvent *s= (XDamageNotifyEvent*) e;
+    SV *sv= NULL;
+    if (!hv_store(fields, "drawable", 8, (sv=newSVuv(s->drawable)), 0)) goto store_fail;
+    if (!hv_store(fields, "damage", 6, (sv=newSVuv(s->damage)), 0)) goto store_fail;
+    if (!hv_store(fields, "level", 5, (sv=newSViv(s->level)), 0)) goto store_fail;
+    if (!hv_store(fields, "more", 4, (sv=newSViv(s->more)), 0)) goto store_fail;
+    if (!hv_store(fields, "timestamp", 9, (sv=newSVuv(s->timestamp)), 0)) goto store_fail;
+    if (!hv_store(fields, "area", 4,
+        (sv=sv_setref_pvn(newSV(0), "X11::Xlib::XRectangle", (char*) &s->area, sizeof(XRectangle))), 0)
+    ) goto store_fail;
+    if (!hv_store(fields, "geometry", 8,
+        (sv=sv_setref_pvn(newSV(0), "X11::Xlib::XRectangle", (char*) &s->geometry, sizeof(XRectangle))), 0)
+    ) goto store_fail;
+    return;
+    store_fail:
+        if (sv) sv_2mortal(sv);
+        croak("Can't store field in supplied hash (tied maybe?)");
+}
+
+/* The XDamageNotifyEvent accessors take any XEvent, so check that it really
+ * is a DamageNotify of its connection before reading the fields.
+ */
+static XDamageNotifyEvent * _damage_event(XEvent *e) {
+    if (strcmp(PerlXlib_xevent_pkg_for_event(e), "X11::Xlib::XDamageNotifyEvent") != 0)
+        croak("Can't access XDamageNotifyEvent fields for type=%d", e->type);
+    return (XDamageNotifyEvent*) e;
+}
+
+
+/* Look up the event base of the DAMAGE extension, and make sure DamageNotify
+ * events get blessed into the right class.  Libxdamage caches the answer, so
+ * this doesn't cost a round trip after the first call.
+ */
+static Bool _damage_init(Display *dpy, int *event_base, int *error_base) {
+    if (!XDamageQueryExtension(dpy, event_base, error_base))
+        return 0;
+    PerlXlib_register_ext_event_type(dpy, *event_base + XDamageNotify,
+        "X11::Xlib::XDamageNotifyEvent", &_damage_event_pack, &_damage_event_unpack);
+    return 1;
+}
+
+#endif /* HAVE_XDAMAGE */
+
+/* Parse the key/value arguments of error_ring_count and error_ring_drain */
+static void _error_filter_from_args(PerlXlib_error_filter *filter, SV **args, int n) {
+    const char *key;
+    int i;
+    PerlXlib_error_filter_init(filter);
+    if (n & 1)
+        croak("Expected key => value pairs for the error filter");
+    for (i= 0; i < n; i += 2) {
+        key= SvPV_nolen(args[i]);
+        if (!strcmp(key, "error_code"))
+            filter->error_code= SvIV(args[i+1]);
+        else if (!strcmp(key, "request_code"))
+            filter->request_code= SvIV(args[i+1]);
+        else if (!strcmp(key, "minor_code"))
+            filter->minor_code= SvIV(args[i+1]);
+        else if (!strcmp(key, "resourceid")) {
+            filter->resourceid= SvUV(args[i+1]);
+            filter->has_resourceid= 1;
+        }
+        else if (!strcmp(key, "min_serial"))
+            filter->min_serial= SvUV(args[i+1]);
+        else if (!strcmp(key, "max_serial"))
+            filter->max_serial= SvUV(args[i+1]);
+        else
+            croak("Unknown error filter '%s'", key);
+    }
+}
+
+static PerlXlib_error_ring * _error_ring(SV *dpy_obj) {
+    PerlXlib_error_ring *ring= PerlXlib_display_error_ring(dpy_obj);
+    if (!ring)
+        croak("Display has no error ring (call error_ring_enable first)");
+    return ring;
+}
+
+static SV * _error_record_hv(const PerlXlib_error_record *rec) {
+    HV *hv= newHV();
+    hv_store(hv, "serial", 6, newSVuv(rec->serial), 0);
+    hv_store(hv, "error_code", 10, newSViv(rec->error_code), 0);
+    hv_store(hv, "request_code", 12, newSViv(rec->request_code), 0);
+    hv_store(hv, "minor_code", 10, newSViv(rec->minor_code), 0);
+    hv_store(hv, "resourceid", 10, newSVuv(rec->resourceid), 0);
+    return newRV_noinc((SV*) hv);
+}
+
+#ifdef HAVE_XI
+
+/* XI2 events arrive as GenericEvent with the major opcode of XInputExtension.
+ * Look it up once per connection, and keep it in the display object.
+ */
+static int _xi2_opcode(SV *dpy_obj, Display *dpy) {
+    int opcode, event_base, error_base, ok;
+    SV **ent;
+    if (!SvROK(dpy_obj) || SvTYPE(SvRV(dpy_obj)) != SVt_PVHV)
+        croak("Expected X11::Xlib display object");
+    ent= hv_fetch((HV*) SvRV(dpy_obj), "_xi2_opcode", 11, 1);
+    if (!ent) croak("Can't store _xi2_opcode");
+    if (!SvOK(*ent)) {
+        PerlXlib_ROUND_TRIP(dpy, XQueryExtension,
+            ok= XQueryExtension(dpy, "XInputExtension", &opcode, &event_base, &error_base));
+        sv_setiv(*ent, ok? opcode : -1);
+    }
+    return SvIV(*ent);
+}
+
+static Bool _xi2_record_pred(Display *dpy, XEvent *e, XPointer opcode) {
+    return e->type == GenericEvent && e->xcookie.extension == *(int*) opcode
+        && PerlXlib_xi2_is_record_type(e->xcookie.evtype);
+}
+
+/* Convert a record to a hashref, leaving out fields that don't apply */
+static SV* _xi2_record_hv(const PerlXlib_xi2_record *rec) {
+    HV *hv= newHV();
+    HV *values, *raw= NULL;
+    int i, is_raw= (rec->evtype >= XI_RawKeyPress && rec->evtype <= XI_RawMotion)
+#ifdef XI_RawTouchBegin
+        || (rec->evtype >= XI_RawTouchBegin && rec->evtype <= XI_RawTouchEnd)
+#endif
+        ;
+    hv_stores(hv, "evtype",   newSViv(rec->evtype));
+    hv_stores(hv, "deviceid", newSViv(rec->deviceid));
+    hv_stores(hv, "sourceid", newSViv(rec->sourceid));
+    hv_stores(hv, "detail",   newSViv(rec->detail));
+    hv_stores(hv, "time",     newSVuv(rec->time));
+    hv_stores(hv, "flags",    newSVuv(rec->flags));
+    if (!is_raw) {
+        hv_stores(hv, "window",  newSVuv(rec->window));
+        hv_stores(hv, "event_x", newSVnv(rec->event_x));
+        hv_stores(hv, "event_y", newSVnv(rec->event_y));
+        hv_stores(hv, "root_x",  newSVnv(rec->root_x));
+        hv_stores(hv, "root_y",  newSVnv(rec->root_y));
+    }
+    values= newHV();
+    hv_stores(hv, "valuators", newRV_noinc((SV*) values));
+    if (is_raw) {
+        raw= newHV();
+        hv_stores(hv, "raw_values", newRV_noinc((SV*) raw));
+    }
+    for (i= 0; i < PerlXlib_XI2_VALUATORS; i++) {
+        if (!(rec->valuator_mask & (1 << i))) continue;
+        hv_store_ent(values, sv_2mortal(newSViv(i)), newSVnv(rec->values[i]), 0);
+        if (raw) hv_store_ent(raw, sv_2mortal(newSViv(i)), newSVnv(rec->raw_values[i]), 0);
+    }
+    return newRV_noinc((SV*) hv);
+}
+
+static SV* _xi2_class_hv(const XIAnyClassInfo *any) {
+    HV *hv= newHV();
+    hv_stores(hv, "type",     newSViv(any->type));
+    hv_stores(hv, "sourceid", newSViv(any->sourceid));
+    switch (any->type) {
+    case XIKeyClass:
+        hv_stores(hv, "num_keycodes", newSViv(((const XIKeyClassInfo*) any)->num_keycodes));
+        break;
+    case XIButtonClass:
+        hv_stores(hv, "num_buttons", newSViv(((const XIButtonClassInfo*) any)->num_buttons));
+        break;
+    case XIValuatorClass: {
+        const XIValuatorClassInfo *v= (const XIValuatorClassInfo*) any;
+        hv_stores(hv, "number",     newSViv(v->number));
+        hv_stores(hv, "label",      newSVuv(v->label));
+        hv_stores(hv, "min",        newSVnv(v->min));
+        hv_stores(hv, "max",        newSVnv(v->max));
+        hv_stores(hv, "value",      newSVnv(v->value));
+        hv_stores(hv, "resolution", newSViv(v->resolution));
+        hv_stores(hv, "mode",       newSViv(v->mode));
+        break;
+    }
+#ifdef XIScrollClass
+    case XIScrollClass: {
+        const XIScrollClassInfo *sc= (const XIScrollClassInfo*) any;
+        hv_stores(hv, "number",      newSViv(sc->number));
+        hv_stores(hv, "scroll_type", newSViv(sc->scroll_type));
+        hv_stores(hv, "increment",   newSVnv(sc->increment));
+        hv_stores(hv, "flags",       newSViv(sc->flags));
+        break;
+    }
+#endif
+#ifdef XITouchClass
+    case XITouchClass:
+        hv_stores(hv, "mode",        newSViv(((const XITouchClassInfo*) any)->mode));
+        hv_stores(hv, "num_touches", newSViv(((const XITouchClassInfo*) any)->num_touches));
+        break;
+#endif
+    }
+    return newRV_noinc((SV*) hv);
+}
+
+#endif /* HAVE_XI */
+
 MODULE = X11::Xlib                PACKAGE = X11::Xlib
 
 void
@@ -76,6 +657,15 @@ _sanity_check_data_structures()
     PPCODE:
         PerlXlib_sanity_check_data_structures();
 
+void
+CLONE(...)
+    PPCODE:
+        /* called once per package that can('CLONE'), so only act for the base class */
+        if (items && SvPOK(ST(0)) && strEQ(SvPVX(ST(0)), "X11::Xlib")) {
+            PerlXlib_obj_cache_clone();
+            PerlXlib_trace_clone();
+        }
+
 Bool
 _is_an_integer(str=NULL)
     SV *str
@@ -198,6 +788,40 @@ _set_pointer_value(obj, dpy_val)
             croak("Invalid pointer value (should be scalar of %d bytes)", (int) sizeof(Display*));
         PerlXlib_objref_set_pointer(obj, SvOK(dpy_val)? (Display*)(void*)SvPVX(dpy_val) : NULL, "Display");
 
+void
+_cache_pointer_value(obj, dpy_val)
+    SV *obj
+    SV *dpy_val
+    PPCODE:
+        if (!SvPOK(dpy_val) || SvCUR(dpy_val) != sizeof(Display*))
+            croak("Invalid pointer value (should be scalar of %d bytes)", (int) sizeof(Display*));
+        PerlXlib_objref_cache_pointer(obj, *(Display**)SvPVX(dpy_val));
+
+void
+_obj_cache_get(dpy_val)
+    SV *dpy_val
+    INIT:
+        SV *obj;
+    PPCODE:
+        if (!SvPOK(dpy_val) || SvCUR(dpy_val) != sizeof(void*))
+            croak("Invalid pointer value (should be scalar of %d bytes)", (int) sizeof(void*));
+        obj= PerlXlib_obj_cache_find(*(void**)SvPVX(dpy_val));
+        PUSHs(obj? sv_2mortal(newRV_inc(obj)) : &PL_sv_undef);
+
+void
+_all_connections(...)
+    INIT:
+        AV *conns= PerlXlib_all_connections();
+        SSize_t i, n= av_len(conns) + 1;
+    PPCODE:
+        if (GIMME_V == G_SCALAR) {
+            PUSHs(sv_2mortal(newSViv(n)));
+            XSRETURN(1);
+        }
+        EXTEND(SP, n);
+        for (i= 0; i < n; i++)
+            PUSHs(*av_fetch(conns, i, 0));
+
 char *
 XServerVendor(dpy)
     Display * dpy
@@ -210,6 +834,14 @@ int
 ConnectionNumber(dpy)
     Display * dpy
 
+unsigned long
+NextRequest(dpy)
+    Display * dpy
+
+unsigned long
+LastKnownRequestProcessed(dpy)
+    Display * dpy
+
 void
 XSetCloseDownMode(dpy, close_mode)
     Display * dpy
@@ -224,7 +856,12 @@ XCloseDisplay(dpy_sv)
         Display *dpy;
     CODE:
         dpy= PerlXlib_display_objref_get_pointer(dpy_sv, PerlXlib_OR_DIE);
+        PerlXlib_unregister_ext_events(dpy);
         XCloseDisplay(dpy);
+        if (PerlXlib_display_stats_of(dpy_sv)) {
+            hv_delete((HV*)SvRV(dpy_sv), "_stats", 6, G_DISCARD);
+            PerlXlib_display_stats_active--;
+        }
         PerlXlib_objref_set_pointer(dpy_sv, NULL, NULL); /* mark as closed */
         hv_delete((HV*)SvRV(dpy_sv), "autoclose", 9, G_DISCARD);
 
@@ -235,6 +872,10 @@ XInternAtom(dpy, atom_name, only_if_exists)
     Display *dpy
     char *atom_name
     Bool only_if_exists
+    CODE:
+        PerlXlib_ROUND_TRIP(dpy, XInternAtom, RETVAL= XInternAtom(dpy, atom_name, only_if_exists));
+    OUTPUT:
+        RETVAL
 
 void
 XInternAtoms(dpy, atom_names, only_if_exists)
@@ -259,7 +900,7 @@ XInternAtoms(dpy, atom_names, only_if_exists)
                 croak("Atom name must be a string");
             name_array[i]= SvPV_nolen(*elem);
         }
-        XInternAtoms(dpy, name_array, n, only_if_exists, atom_array);
+        PerlXlib_ROUND_TRIP(dpy, XInternAtoms, XInternAtoms(dpy, name_array, n, only_if_exists, atom_array));
         ret_av= newAV();
         PUSHs(sv_2mortal(newRV_noinc((SV*)ret_av)));
         for (i= 0; i < n; i++)
@@ -272,7 +913,7 @@ XGetAtomName(dpy, atom)
     INIT:
         char *name= NULL;
     PPCODE:
-        name= XGetAtomName(dpy, atom);
+        PerlXlib_ROUND_TRIP(dpy, XGetAtomName, name= XGetAtomName(dpy, atom));
         if (name) {
             PUSHs(sv_2mortal(newSVpv(name, 0)));
             XFree(name);
@@ -300,7 +941,7 @@ XGetAtomNames(dpy, atoms)
                 croak("Atom values must be integers");
             atom_array[i]= SvIV(*elem);
         }
-        XGetAtomNames(dpy, atom_array, n, name_array);
+        PerlXlib_ROUND_TRIP(dpy, XGetAtomNames, XGetAtomNames(dpy, atom_array, n, name_array));
         ret_av= newAV();
         PUSHs(sv_2mortal(newRV_noinc((SV*)ret_av)));
         for (i= 0; i < n; i++) {
@@ -380,7 +1021,8 @@ _resolve_atoms(dpy_obj, ...)
             }
         }
         if (n_name_lookup) {
-            XInternAtoms(dpy, name_array, n_name_lookup, ix == 0? 1 : 0, atom_array + n_atom_lookup);
+            PerlXlib_ROUND_TRIP(dpy, XInternAtoms,
+                XInternAtoms(dpy, name_array, n_name_lookup, ix == 0? 1 : 0, atom_array + n_atom_lookup));
             for (i= 0; i < n_name_lookup; i++) {
                 if (atom_array[n_atom_lookup + i]) {
                     sv= _cache_atom(cache, atom_array[n_atom_lookup + i], name_array[i]);
@@ -389,7 +1031,8 @@ _resolve_atoms(dpy_obj, ...)
             }
         }
         if (n_atom_lookup) {
-            XGetAtomNames(dpy, atom_array, n_atom_lookup, name_array + n_name_lookup);
+            PerlXlib_ROUND_TRIP(dpy, XGetAtomNames,
+                XGetAtomNames(dpy, atom_array, n_atom_lookup, name_array + n_name_lookup));
             for (i= 0; i < n_atom_lookup; i++) {
                 if (name_array[n_name_lookup + i]) {
                     sv= _cache_atom(cache, atom_array[i], name_array[n_name_lookup + i]);
@@ -432,7 +1075,7 @@ XNextEvent(dpy, event_sv)
             (PerlXlib_struct_pack_fn*) PerlXlib_XEvent_pack
         );
         XNextEvent(dpy, event);
-        sv_bless(event_sv, gv_stashpv(PerlXlib_xevent_pkg_for_type(event->type), GV_ADD));
+        sv_bless(event_sv, gv_stashpv(PerlXlib_xevent_pkg_for_event(event), GV_ADD));
 
 Bool
 XCheckWindowEvent(dpy, wnd, event_mask, event_return)
@@ -447,7 +1090,7 @@ XCheckWindowEvent(dpy, wnd, event_mask, event_return)
         if (RETVAL) {
             dest= (XEvent*) PerlXlib_get_struct_ptr(
                 event_return, 2,
-                PerlXlib_xevent_pkg_for_type(event.type), sizeof(XEvent),
+                PerlXlib_xevent_pkg_for_event(&event), sizeof(XEvent),
                 (PerlXlib_struct_pack_fn*) PerlXlib_XEvent_pack
             );
             memcpy(dest, &event, sizeof(event));
@@ -468,7 +1111,7 @@ XCheckTypedWindowEvent(dpy, wnd, event_type, event_return)
         if (RETVAL) {
             dest= (XEvent*) PerlXlib_get_struct_ptr(
                 event_return, 2,
-                PerlXlib_xevent_pkg_for_type(event.type), sizeof(XEvent),
+                PerlXlib_xevent_pkg_for_event(&event), sizeof(XEvent),
                 (PerlXlib_struct_pack_fn*) PerlXlib_XEvent_pack
             );
             memcpy(dest, &event, sizeof(event));
@@ -488,7 +1131,7 @@ XCheckMaskEvent(dpy, event_mask, event_return)
         if (RETVAL) {
             dest= (XEvent*) PerlXlib_get_struct_ptr(
                 event_return, 2,
-                PerlXlib_xevent_pkg_for_type(event.type), sizeof(XEvent),
+                PerlXlib_xevent_pkg_for_event(&event), sizeof(XEvent),
                 (PerlXlib_struct_pack_fn*) PerlXlib_XEvent_pack
             );
             memcpy(dest, &event, sizeof(event));
@@ -508,7 +1151,7 @@ XCheckTypedEvent(dpy, event_type, event_return)
         if (RETVAL) {
             dest= (XEvent*) PerlXlib_get_struct_ptr(
                 event_return, 2,
-                PerlXlib_xevent_pkg_for_type(event.type), sizeof(XEvent),
+                PerlXlib_xevent_pkg_for_event(&event), sizeof(XEvent),
                 (PerlXlib_struct_pack_fn*) PerlXlib_XEvent_pack
             );
             memcpy(dest, &event, sizeof(event));
@@ -529,6 +1172,33 @@ XPutBackEvent(dpy, event)
     Display * dpy
     XEvent *event
 
+Bool
+XGetEventData(dpy, event_sv)
+    Display *dpy
+    SV *event_sv
+    INIT:
+        XEvent *event= (XEvent*) PerlXlib_get_struct_ptr(
+            event_sv, 1, "X11::Xlib::XEvent", sizeof(XEvent),
+            (PerlXlib_struct_pack_fn*) PerlXlib_XEvent_pack
+        );
+    CODE:
+        RETVAL= event->type == GenericEvent && XGetEventData(dpy, &event->xcookie);
+    OUTPUT:
+        RETVAL
+
+void
+XFreeEventData(dpy, event_sv)
+    Display *dpy
+    SV *event_sv
+    INIT:
+        XEvent *event= (XEvent*) PerlXlib_get_struct_ptr(
+            event_sv, 1, "X11::Xlib::XEvent", sizeof(XEvent),
+            (PerlXlib_struct_pack_fn*) PerlXlib_XEvent_pack
+        );
+    CODE:
+        if (event->type == GenericEvent)
+            XFreeEventData(dpy, &event->xcookie);
+
 void
 XFlush(dpy)
     Display * dpy
@@ -537,6 +1207,8 @@ void
 XSync(dpy, discard=0)
     Display *  dpy
     int discard
+    CODE:
+        PerlXlib_ROUND_TRIP(dpy, XSync, XSync(dpy, discard));
 
 void
 XSelectInput(dpy, wnd, mask)
@@ -578,7 +1250,7 @@ _wait_event(dpy, wnd, event_type, event_mask, event_return, max_wait_msec)
         if (RETVAL) {
             dest= (XEvent*) PerlXlib_get_struct_ptr(
                 event_return, 1,
-                PerlXlib_xevent_pkg_for_type(event.type), sizeof(XEvent),
+                PerlXlib_xevent_pkg_for_event(&event), sizeof(XEvent),
                 (PerlXlib_struct_pack_fn*) PerlXlib_XEvent_pack
             );
             memcpy(dest, &event, sizeof(event));
@@ -739,6 +1411,29 @@ XGetVisualInfo(dpy, vinfo_mask, vinfo_template)
             XFree(list);
         }
 
+void
+_visual_index_search(dpy_obj, mask, tpl, limit= -1)
+    SV *dpy_obj
+    long mask
+    XVisualInfo *tpl
+    int limit
+    INIT:
+        const XVisualInfo *list;
+        int n, i, *found;
+        SV *obj;
+    PPCODE:
+        list= PerlXlib_visual_index_list(dpy_obj, &n);
+        Newx(found, n + 1, int);
+        SAVEFREEPV(found);
+        n= PerlXlib_visual_index_search(dpy_obj, mask, tpl, found);
+        if (limit >= 0 && n > limit) n= limit;
+        EXTEND(SP, n);
+        for (i= 0; i < n; i++) {
+            obj= sv_2mortal(sv_setref_pvn(newSV(0), "X11::Xlib::XVisualInfo", (void*)(list + found[i]), sizeof(XVisualInfo)));
+            PerlXlib_objref_set_display(obj, dpy_obj);
+            PUSHs(obj);
+        }
+
 int
 XVisualIDFromVisual(vis)
     Visual *vis
@@ -801,6 +1496,320 @@ XCreatePixmapFromBitmapData(dpy, drw, data, width, height, fg, bg, depth)
     OUTPUT:
         RETVAL
 
+# Graphics Context Functions (fn_gc) -----------------------------------------
+
+GC
+XCreateGC(dpy, drw, valuemask= 0, values= NULL)
+    Display * dpy
+    Drawable drw
+    unsigned long valuemask
+    XGCValues *values
+    CODE:
+        if (valuemask && !values)
+            croak("values may only be NULL if valuemask is 0");
+        RETVAL = XCreateGC(dpy, drw, valuemask, values);
+    OUTPUT:
+        RETVAL
+
+void
+XChangeGC(dpy, gc, valuemask, values)
+    Display * dpy
+    GC gc
+    unsigned long valuemask
+    XGCValues *values
+
+int
+XGetGCValues(dpy, gc, valuemask, values_out)
+    Display * dpy
+    GC gc
+    unsigned long valuemask
+    SV *values_out
+    INIT:
+        XGCValues *values;
+    CODE:
+        values= (XGCValues*) PerlXlib_get_struct_ptr(values_out, 1, "X11::Xlib::XGCValues", sizeof(XGCValues),
+            (PerlXlib_struct_pack_fn*) &PerlXlib_XGCValues_pack);
+        RETVAL = XGetGCValues(dpy, gc, valuemask, values);
+    OUTPUT:
+        RETVAL
+
+void
+XFreeGC(dpy, gc_sv)
+    Display * dpy
+    SV *gc_sv
+    INIT:
+        GC gc= (GC) PerlXlib_objref_get_pointer(gc_sv, "GC", PerlXlib_OR_DIE);
+    CODE:
+        XFreeGC(dpy, gc);
+        PerlXlib_objref_set_pointer(gc_sv, NULL, "GC");
+
+void
+XSetForeground(dpy, gc, pixel)
+    Display * dpy
+    GC gc
+    unsigned long pixel
+
+void
+XSetBackground(dpy, gc, pixel)
+    Display * dpy
+    GC gc
+    unsigned long pixel
+
+void
+XDrawPoints(dpy, drw, gc, points, mode= CoordModeOrigin)
+    Display * dpy
+    Drawable drw
+    GC gc
+    SV *points
+    int mode
+    INIT:
+        int n;
+        XPoint *p= (XPoint*) PerlXlib_get_struct_array(points, "XPoint", sizeof(XPoint), 2, NULL, &n);
+    CODE:
+        if (n) XDrawPoints(dpy, drw, gc, p, n, mode);
+
+void
+XDrawLines(dpy, drw, gc, points, mode= CoordModeOrigin)
+    Display * dpy
+    Drawable drw
+    GC gc
+    SV *points
+    int mode
+    INIT:
+        int n;
+        XPoint *p= (XPoint*) PerlXlib_get_struct_array(points, "XPoint", sizeof(XPoint), 2, NULL, &n);
+    CODE:
+        if (n) XDrawLines(dpy, drw, gc, p, n, mode);
+
+void
+XDrawSegments(dpy, drw, gc, segments)
+    Display * dpy
+    Drawable drw
+    GC gc
+    SV *segments
+    INIT:
+        int n;
+        XSegment *s= (XSegment*) PerlXlib_get_struct_array(segments, "XSegment", sizeof(XSegment), 4, NULL, &n);
+    CODE:
+        if (n) XDrawSegments(dpy, drw, gc, s, n);
+
+void
+XDrawRectangles(dpy, drw, gc, rects)
+    Display * dpy
+    Drawable drw
+    GC gc
+    SV *rects
+    INIT:
+        int n;
+        XRectangle *r= (XRectangle*) PerlXlib_get_struct_array(rects, "X11::Xlib::XRectangle", sizeof(XRectangle), 4,
+            (PerlXlib_struct_pack_fn*) &PerlXlib_XRectangle_pack, &n);
+    CODE:
+        if (n) XDrawRectangles(dpy, drw, gc, r, n);
+
+void
+XFillRectangles(dpy, drw, gc, rects)
+    Display * dpy
+    Drawable drw
+    GC gc
+    SV *rects
+    INIT:
+        int n;
+        XRectangle *r= (XRectangle*) PerlXlib_get_struct_array(rects, "X11::Xlib::XRectangle", sizeof(XRectangle), 4,
+            (PerlXlib_struct_pack_fn*) &PerlXlib_XRectangle_pack, &n);
+    CODE:
+        if (n) XFillRectangles(dpy, drw, gc, r, n);
+
+void
+XDrawArcs(dpy, drw, gc, arcs)
+    Display * dpy
+    Drawable drw
+    GC gc
+    SV *arcs
+    INIT:
+        int n;
+        XArc *a= (XArc*) PerlXlib_get_struct_array(arcs, "XArc", sizeof(XArc), 6, NULL, &n);
+    CODE:
+        if (n) XDrawArcs(dpy, drw, gc, a, n);
+
+void
+XFillArcs(dpy, drw, gc, arcs)
+    Display * dpy
+    Drawable drw
+    GC gc
+    SV *arcs
+    INIT:
+        int n;
+        XArc *a= (XArc*) PerlXlib_get_struct_array(arcs, "XArc", sizeof(XArc), 6, NULL, &n);
+    CODE:
+        if (n) XFillArcs(dpy, drw, gc, a, n);
+
+# Image Functions (fn_image) ------------------------------------------------
+
+void
+convert_pixels(vinfo, src, width, height, bits_per_pixel, bytes_per_line= 0, dst_format= "RGBA", byte_order= LSBFirst)
+    XVisualInfo *vinfo
+    SV *src
+    int width
+    int height
+    int bits_per_pixel
+    int bytes_per_line
+    const char *dst_format
+    int byte_order
+    INIT:
+        const char *src_p;
+        STRLEN src_len;
+        size_t row_len, dst_len;
+        int fmt;
+        SV *dst;
+    PPCODE:
+        fmt= !strcmp(dst_format, "RGBA")? PerlXlib_PIXFMT_RGBA
+            : !strcmp(dst_format, "RGB")? PerlXlib_PIXFMT_RGB
+            : !strcmp(dst_format, "GRAY")? PerlXlib_PIXFMT_GRAY
+            : 0;
+        if (!fmt)
+            croak("Unknown destination format '%s' (expected RGBA, RGB, or GRAY)", dst_format);
+        if (width < 0 || height < 0)
+            croak("Invalid image dimensions %dx%d", width, height);
+        if (bits_per_pixel != 8 && bits_per_pixel != 16 && bits_per_pixel != 24 && bits_per_pixel != 32)
+            croak("Unsupported bits_per_pixel %d", bits_per_pixel);
+        row_len= (size_t) width * (bits_per_pixel / 8);
+        if (bytes_per_line < 0)
+            croak("Invalid bytes_per_line %d", bytes_per_line);
+        if (!bytes_per_line) {
+            if (row_len > INT_MAX)
+                croak("Image row of %ld bytes is too long", (long) row_len);
+            bytes_per_line= row_len;
+        }
+        else if ((size_t) bytes_per_line < row_len)
+            croak("bytes_per_line %d is less than width * bytes per pixel (%ld)", bytes_per_line, (long) row_len);
+        src_p= SvPVbyte(SvROK(src)? SvRV(src) : src, src_len);
+        if (height && src_len < (size_t)(height-1) * bytes_per_line + row_len)
+            croak("Image buffer is too short: need %ld bytes, have %ld",
+                (long)((size_t)(height-1) * bytes_per_line + row_len), (long) src_len);
+        dst_len= (size_t) width * height * fmt;
+        dst= sv_2mortal(newSV(dst_len ? dst_len : 1));
+        SvPOK_on(dst);
+        SvCUR_set(dst, dst_len);
+        PerlXlib_convert_pixels(src_p, bytes_per_line, width, height, bits_per_pixel, byte_order,
+            vinfo->red_mask, vinfo->green_mask, vinfo->blue_mask, fmt, SvPVX(dst));
+        *SvEND(dst)= '\0';
+        PUSHs(dst);
+
+void
+tile_diff(state, src, width, height, bits_per_pixel, bytes_per_line= 0, tile_width= 64, tile_height= 64)
+    SV *state
+    SV *src
+    int width
+    int height
+    int bits_per_pixel
+    int bytes_per_line
+    int tile_width
+    int tile_height
+    INIT:
+        /* 'state' holds this header followed by one 64-bit hash per tile */
+        struct tile_diff_state { U32 magic, width, height, bytes_per_pixel, tile_width, tile_height, pad[2]; } *hdr;
+        const char *src_p;
+        STRLEN src_len;
+        size_t row_len, n, state_len, i;
+        int cols, rows, tx, ty, run, n_rects= 0, n_open= 0, n_next, p;
+        Bool fresh;
+        U8 *changed;
+        XRectangle *rects;
+        int *open, *next;
+    PPCODE:
+        if (width <= 0 || height <= 0 || width > 0x7FFF || height > 0x7FFF)
+            croak("Invalid image dimensions %dx%d", width, height);
+        if (tile_width <= 0 || tile_height <= 0)
+            croak("Invalid tile size %dx%d", tile_width, tile_height);
+        if (bits_per_pixel != 8 && bits_per_pixel != 16 && bits_per_pixel != 24 && bits_per_pixel != 32)
+            croak("Unsupported bits_per_pixel %d", bits_per_pixel);
+        row_len= (size_t) width * (bits_per_pixel / 8);
+        if (bytes_per_line < 0)
+            croak("Invalid bytes_per_line %d", bytes_per_line);
+        if (!bytes_per_line)
+            bytes_per_line= row_len;
+        else if ((size_t) bytes_per_line < row_len)
+            croak("bytes_per_line %d is less than width * bytes per pixel (%ld)", bytes_per_line, (long) row_len);
+        src_p= SvPVbyte(SvROK(src)? SvRV(src) : src, src_len);
+        if (src_len < (size_t)(height-1) * bytes_per_line + row_len)
+            croak("Image buffer is too short: need %ld bytes, have %ld",
+                (long)((size_t)(height-1) * bytes_per_line + row_len), (long) src_len);
+        cols= (width + tile_width - 1) / tile_width;
+        rows= (height + tile_height - 1) / tile_height;
+        n= (size_t) cols * rows;
+        state_len= sizeof(*hdr) + n * sizeof(uint64_t);
+        /* Start over if the state is from a different geometry (or is new) */
+        hdr= SvPOK(state) && SvCUR(state) == state_len? (struct tile_diff_state*) SvPVX(state) : NULL;
+        fresh= !hdr || hdr->magic != 0x54494C45 || hdr->width != width || hdr->height != height
+            || hdr->bytes_per_pixel != bits_per_pixel / 8
+            || hdr->tile_width != tile_width || hdr->tile_height != tile_height;
+        if (fresh) {
+            sv_setpvn(state, "", 0);
+            hdr= (struct tile_diff_state*) SvGROW(state, state_len + 1);
+            memset(hdr, 0, state_len);
+            hdr->magic= 0x54494C45;
+            hdr->width= width;
+            hdr->height= height;
+            hdr->bytes_per_pixel= bits_per_pixel / 8;
+            hdr->tile_width= tile_width;
+            hdr->tile_height= tile_height;
+            SvCUR_set(state, state_len);
+        }
+        Newx(changed, n, U8);
+        SAVEFREEPV(changed);
+        if (!PerlXlib_tile_hash_diff(src_p, bytes_per_line, width, height, bits_per_pixel / 8,
+            tile_width, tile_height, (uint64_t*)(hdr + 1), changed) && !fresh
+        ) {
+            SvSETMAGIC(state);
+            XSRETURN(0);
+        }
+        if (fresh)
+            memset(changed, 1, n);
+        SvSETMAGIC(state);
+        /* Merge runs of changed tiles in each row, then merge runs with the same
+         * horizontal extent as a run directly above them. */
+        Newx(rects, n, XRectangle);
+        SAVEFREEPV(rects);
+        Newx(open, cols * 2, int);
+        SAVEFREEPV(open);
+        next= open + cols;
+        for (ty= 0; ty < rows; ty++) {
+            n_next= 0;
+            p= 0;
+            for (tx= 0; tx < cols; tx++) {
+                if (!changed[ty * cols + tx]) continue;
+                for (run= 1; tx + run < cols && changed[ty * cols + tx + run]; run++);
+                rects[n_rects].x= tx * tile_width;
+                rects[n_rects].y= ty * tile_height;
+                rects[n_rects].width= ((tx + run) * tile_width < width? (tx + run) * tile_width : width) - rects[n_rects].x;
+                rects[n_rects].height= ((ty + 1) * tile_height < height? (ty + 1) * tile_height : height) - rects[n_rects].y;
+                while (p < n_open && rects[open[p]].x < rects[n_rects].x) p++;
+                if (p < n_open && rects[open[p]].x == rects[n_rects].x && rects[open[p]].width == rects[n_rects].width) {
+                    rects[open[p]].height += rects[n_rects].height;
+                    next[n_next++]= open[p];
+                }
+                else
+                    next[n_next++]= n_rects++;
+                tx += run;
+            }
+            /* swap the lists */
+            n_open= n_next;
+            { int *tmp= open; open= next; next= tmp; }
+        }
+        EXTEND(SP, n_rects);
+        for (i= 0; i < n_rects; i++)
+            PUSHs(sv_2mortal(
+                sv_setref_pvn(newSV(0), "X11::Xlib::XRectangle", (char*)(rects+i), sizeof(XRectangle))
+            ));
+
+void
+_pixconv_level(max_level= -1)
+    int max_level
+    INIT:
+        static const char *names[]= { "scalar", "sse2", "ssse3", "avx2" };
+    PPCODE:
+        PUSHs(sv_2mortal(newSVpv(names[PerlXlib_pixconv_level(max_level)], 0)));
+
 # Window Functions (fn_win) --------------------------------------------------
 
 Window
@@ -867,7 +1876,7 @@ XGetGeometry(dpy, wnd, root_out=NULL, x_out=NULL, y_out=NULL, width_out=NULL, he
         int x, y, ret;
         unsigned int w, h, bw, d;
     PPCODE:
-        ret = XGetGeometry(dpy, wnd, &root, &x, &y, &w, &h, &bw, &d);
+        PerlXlib_ROUND_TRIP(dpy, XGetGeometry, ret= XGetGeometry(dpy, wnd, &root, &x, &y, &w, &h, &bw, &d));
         if (items > 2) {
             /* C-style API */
             warn("C-style XGetGeometry is deprecated; use 2 arguments to return a list, instead");
@@ -901,7 +1910,7 @@ XListProperties(dpy, wnd)
         AV *prop_av;
         Atom *atom_array;
     PPCODE:
-        atom_array= XListProperties(dpy, wnd, &num_props);
+        PerlXlib_ROUND_TRIP(dpy, XListProperties, atom_array= XListProperties(dpy, wnd, &num_props));
         if (atom_array) {
             EXTEND(SP, num_props);
             for (i= 0; i < num_props; i++)
@@ -929,8 +1938,9 @@ XGetWindowProperty(dpy, wnd, prop_atom, long_offset, long_length, delete, req_ty
         unsigned long nitems, bytes_after;
         char *data= NULL;
     CODE:
-        RETVAL = XGetWindowProperty(dpy, wnd, prop_atom, long_offset, long_length, delete, req_type,
-            &actual_type, &actual_format, &nitems, &bytes_after, (unsigned char**)&data);
+        PerlXlib_ROUND_TRIP(dpy, XGetWindowProperty,
+            RETVAL= XGetWindowProperty(dpy, wnd, prop_atom, long_offset, long_length, delete, req_type,
+                &actual_type, &actual_format, &nitems, &bytes_after, (unsigned char**)&data));
         if (RETVAL == Success) {
             if (actual_format == 8) {
                 sv_setpvn(data_out, data, nitems*sizeof(char));
@@ -991,8 +2001,10 @@ XGetWMProtocols(dpy, wnd)
     INIT:
         Atom *protocols_array= NULL;
         int n= 0, i;
+        Status ok;
     PPCODE:
-        if (XGetWMProtocols(dpy, wnd, &protocols_array, &n)) {
+        PerlXlib_ROUND_TRIP(dpy, XGetWMProtocols, ok= XGetWMProtocols(dpy, wnd, &protocols_array, &n));
+        if (ok) {
             EXTEND(SP, n);
             for (i= 0; i < n; i++)
                 PUSHs(sv_2mortal(newSVuv(protocols_array[i])));
@@ -1032,7 +2044,7 @@ XGetWMSizeHints(dpy, wnd, hints_out, supplied_out, property)
     INIT:
         long supplied;
     CODE:
-        RETVAL = XGetWMSizeHints(dpy, wnd, hints_out, &supplied, property);
+        PerlXlib_ROUND_TRIP(dpy, XGetWMSizeHints, RETVAL= XGetWMSizeHints(dpy, wnd, hints_out, &supplied, property));
         sv_setiv(supplied_out, supplied);
     OUTPUT:
         RETVAL
@@ -1054,7 +2066,7 @@ XGetWMNormalHints(dpy, wnd, hints_out, supplied_out)
         long supplied;
         XSizeHints szhints, *dest;
     CODE:
-        RETVAL = XGetWMNormalHints(dpy, wnd, &szhints, &supplied);
+        PerlXlib_ROUND_TRIP(dpy, XGetWMNormalHints, RETVAL= XGetWMNormalHints(dpy, wnd, &szhints, &supplied));
         if (RETVAL) {
             dest= (XSizeHints*) PerlXlib_get_struct_ptr(
                 hints_out, 1,
@@ -1081,7 +2093,7 @@ XGetWindowAttributes(dpy, wnd, attrs_out)
     INIT:
         XWindowAttributes attr, *dest;
     CODE:
-        RETVAL = XGetWindowAttributes(dpy, wnd, &attr);
+        PerlXlib_ROUND_TRIP(dpy, XGetWindowAttributes, RETVAL= XGetWindowAttributes(dpy, wnd, &attr));
         if (RETVAL) {
             dest= (XWindowAttributes*) PerlXlib_get_struct_ptr(
                 attrs_out, 1,
@@ -1192,8 +2204,10 @@ XQueryTree(dpy, wnd)
     INIT:
         Window root, parent, *children;
         int nchildren, i;
+        Status ok;
     PPCODE:
-        if (XQueryTree(dpy, wnd, &root, &parent, &children, &nchildren)) {
+        PerlXlib_ROUND_TRIP(dpy, XQueryTree, ok= XQueryTree(dpy, wnd, &root, &parent, &children, &nchildren));
+        if (ok) {
             PUSHs(sv_2mortal(newSViv(root)));
             PUSHs(sv_2mortal(newSViv(parent)));
             for (i= 0; i < nchildren; i++)
@@ -1246,8 +2260,11 @@ XTranslateCoordinates(dpy, src_wnd, dest_wnd, src_x, src_y)
     INIT:
         int dest_x, dest_y;
         Window child;
+        Bool ok;
     PPCODE:
-        if (XTranslateCoordinates(dpy, src_wnd, dest_wnd, src_x, src_y, &dest_x, &dest_y, &child)) {
+        PerlXlib_ROUND_TRIP(dpy, XTranslateCoordinates,
+            ok= XTranslateCoordinates(dpy, src_wnd, dest_wnd, src_x, src_y, &dest_x, &dest_y, &child));
+        if (ok) {
             PUSHs(sv_2mortal(newSViv(dest_x)));
             PUSHs(sv_2mortal(newSViv(dest_y)));
             PUSHs(sv_2mortal(newSViv(child)));
@@ -1277,9 +2294,102 @@ XTestFakeKeyEvent(dpy, kc, pressed, EventSendDelay = 10)
     int pressed
     int EventSendDelay
 
-# KeySym Utility Functions (fn_keysym) ---------------------------------------
+void
+play_input(dpy, actions, samples= 0)
+    Display *dpy
+    SV *actions
+    int samples
+    INIT:
+        PerlXlib_input_action *acts;
+        I64 *late, *sorted, total= 0, sched= 0, duration;
+        HV *report;
+        AV *list;
+        int n, i;
+    PPCODE:
+        acts= _input_actions_arg(actions, &n);
+        Newx(late, n * 2 + 1, I64);
+        SAVEFREEPV(late);
+        sorted= late + n;
+        duration= PerlXlib_input_play(dpy, acts, n, late);
+        report= newHV();
+        PUSHs(sv_2mortal(newRV_noinc((SV*) report)));
+        for (i= 0; i < n; i++) {
+            total += late[i];
+            sched += (I64) acts[i].delay_ms * 1000;
+        }
+        memcpy(sorted, late, n * sizeof(I64));
+        qsort(sorted, n, sizeof(I64), _input_cmp_i64);
+        hv_stores(report, "count",        newSViv(n));
+        hv_stores(report, "duration_us",  newSVnv((NV) duration));
+        hv_stores(report, "scheduled_us", newSVnv((NV) sched));
+        if (n) {
+            hv_stores(report, "late_mean_us", newSVnv((NV) total / n));
+            hv_stores(report, "late_max_us",  newSVnv((NV) sorted[n-1]));
+            hv_stores(report, "late_p50_us",  newSVnv((NV) sorted[(n-1) / 2]));
+            hv_stores(report, "late_p99_us",  newSVnv((NV) sorted[(n-1) * 99 / 100]));
+        }
+        if (samples) {
+            list= newAV();
+            hv_stores(report, "late_us", newRV_noinc((SV*) list));
+            av_extend(list, n);
+            for (i= 0; i < n; i++)
+                av_push(list, newSVnv((NV) late[i]));
+        }
 
-char *
+void
+_pointer_path_actions(points, curve, ease, duration_ms, rate, button= 0, screen= -1, relative= 0)
+    AV *points
+    int curve
+    int ease
+    IV duration_ms
+    IV rate
+    int button
+    int screen
+    int relative
+    INIT:
+        PerlXlib_pointer_path path;
+        double *coords;
+        SV **elem, **field;
+        AV *pt;
+        SV *out;
+        int i;
+    PPCODE:
+        if (duration_ms < 0 || rate < 1 || duration_ms > INT_MAX || rate > INT_MAX)
+            croak("Expected positive duration and rate");
+        if ((I64) duration_ms * rate / 1000 > PerlXlib_POINTER_PATH_STEPS_MAX)
+            croak("Path of %"IVdf" ms at %"IVdf"/s exceeds %d steps", duration_ms, rate, PerlXlib_POINTER_PATH_STEPS_MAX);
+        path.npoints= av_len(points) + 1;
+        if (path.npoints < 1)
+            croak("Path needs at least one point");
+        Newx(coords, path.npoints * 5, double);
+        SAVEFREEPV(coords);
+        for (i= 0; i < path.npoints; i++) {
+            elem= av_fetch(points, i, 0);
+            if (!elem || !*elem || !SvROK(*elem) || SvTYPE(SvRV(*elem)) != SVt_PVAV)
+                croak("Expected arrayref of [ x, y ]");
+            pt= (AV*) SvRV(*elem);
+            field= av_fetch(pt, 0, 0);
+            coords[i*2]= field && *field? SvNV(*field) : 0;
+            field= av_fetch(pt, 1, 0);
+            coords[i*2+1]= field && *field? SvNV(*field) : 0;
+        }
+        path.points= coords;
+        path.curve= curve;
+        path.ease= ease;
+        path.duration_ms= duration_ms;
+        path.rate= rate;
+        path.button= button;
+        path.screen= screen;
+        path.relative= relative;
+        out= sv_2mortal(newSVpvn("", 0));
+        i= PerlXlib_pointer_path_actions(&path, coords + path.npoints * 2,
+            (PerlXlib_input_action*) SvGROW(out, PerlXlib_POINTER_PATH_MAX_ACTIONS(&path) * sizeof(PerlXlib_input_action) + 1));
+        SvCUR_set(out, i * sizeof(PerlXlib_input_action));
+        PUSHs(out);
+
+# KeySym Utility Functions (fn_keysym) ---------------------------------------
+
+char *
 XKeysymToString(keysym)
     KeySym keysym
     CODE:
@@ -1340,6 +2450,66 @@ char_to_keysym(str)
         if (codepoint > 0 && sym > 0) PUSHs(sv_2mortal(newSViv(sym)));
         else PUSHs(&PL_sv_undef);
 
+void
+keysyms_to_string(syms, replacement=NULL)
+    AV *syms
+    SV *replacement
+    INIT:
+        SSize_t n= av_len(syms) + 1, i;
+        UV repl= 0;
+        int codepoint;
+        U8 *p;
+        SV **elem, *out;
+        char *s;
+        STRLEN len;
+    PPCODE:
+        if (replacement && SvOK(replacement) && (s= SvPV(replacement, len), len))
+            repl= DO_UTF8(replacement)? utf8n_to_uvchr((U8*) s, len, &len, 0) : (U8) s[0];
+        out= sv_2mortal(newSV(n * UTF8_MAXBYTES + 1));
+        SvPOK_on(out);
+        p= (U8*) SvPVX(out);
+        for (i= 0; i < n; i++) {
+            elem= av_fetch(syms, i, 0);
+            codepoint= (elem && *elem && SvOK(*elem))? PerlXlib_keysym_to_codepoint(SvUV(*elem)) : -1;
+            if (codepoint >= 0)
+                p= uvchr_to_utf8(p, UNI_TO_NATIVE(codepoint));
+            else if (repl)
+                p= uvchr_to_utf8(p, repl);
+        }
+        *p= '\0';
+        SvCUR_set(out, (char*) p - SvPVX(out));
+        SvUTF8_on(out);
+        PUSHs(out);
+
+void
+string_to_keysyms(str, legacy=0)
+    SV *str
+    int legacy
+    INIT:
+        STRLEN len, clen;
+        U8 *s, *end;
+        UV codepoint;
+        KeySym sym;
+        Bool utf8;
+    PPCODE:
+        s= (U8*) SvPV(str, len);
+        end= s + len;
+        utf8= DO_UTF8(str);
+        EXTEND(SP, utf8? sv_len_utf8(str) : len);
+        while (s < end) {
+            if (utf8) {
+                codepoint= NATIVE_TO_UNI(utf8n_to_uvchr(s, end - s, &clen, 0));
+                s += clen? clen : 1;
+            } else
+                codepoint= NATIVE_TO_UNI(*s++);
+            sym= NoSymbol;
+            if (legacy)
+                sym= PerlXlib_codepoint_to_legacy_keysym(codepoint);
+            if (sym == NoSymbol)
+                sym= PerlXlib_codepoint_to_keysym(codepoint);
+            PUSHs(sv_2mortal(newSVuv(sym)));
+        }
+
 int
 IsKeypadKey(keysym)
     unsigned long keysym
@@ -1392,7 +2562,7 @@ XQueryKeymap(dpy)
         char keys_return[32];
         int i, j;
     PPCODE:
-        XQueryKeymap(dpy, keys_return);
+        PerlXlib_ROUND_TRIP(dpy, XQueryKeymap, XQueryKeymap(dpy, keys_return));
         for(i=0; i<32; i++) {
             for (j=0; j<8;j++) {
                 if (keys_return[i] & (1 << j))
@@ -1408,6 +2578,11 @@ XGrabKeyboard(dpy, wnd, owner_events, pointer_mode, keyboard_mode, timestamp)
     int pointer_mode
     int keyboard_mode
     Time timestamp
+    CODE:
+        PerlXlib_ROUND_TRIP(dpy, XGrabKeyboard,
+            RETVAL= XGrabKeyboard(dpy, wnd, owner_events, pointer_mode, keyboard_mode, timestamp));
+    OUTPUT:
+        RETVAL
 
 void
 XUngrabKeyboard(dpy, timestamp)
@@ -1439,8 +2614,11 @@ XQueryPointer(dpy, wnd)
         Window root, child;
         int root_x, root_y, win_x, win_y;
         unsigned mask;
+        Bool ok;
     PPCODE:
-        if (XQueryPointer(dpy, wnd, &root, &child, &root_x, &root_y, &win_x, &win_y, &mask)) {
+        PerlXlib_ROUND_TRIP(dpy, XQueryPointer,
+            ok= XQueryPointer(dpy, wnd, &root, &child, &root_x, &root_y, &win_x, &win_y, &mask));
+        if (ok) {
             EXTEND(SP, 7);
             PUSHs(sv_2mortal(newSVuv(root)));
             PUSHs(sv_2mortal(newSVuv(child)));
@@ -1462,6 +2640,11 @@ XGrabPointer(dpy, wnd, owner_events, event_mask, pointer_mode, keyboard_mode, co
     Window confine_to
     Cursor cursor
     Time timestamp
+    CODE:
+        PerlXlib_ROUND_TRIP(dpy, XGrabPointer, RETVAL= XGrabPointer(dpy, wnd, owner_events, event_mask,
+            pointer_mode, keyboard_mode, confine_to, cursor, timestamp));
+    OUTPUT:
+        RETVAL
 
 void
 XUngrabPointer(dpy, timestamp)
@@ -1549,7 +2732,7 @@ XGetKeyboardMapping(dpy, fkeycode, count = 1)
         KeySym * keysym;
         int i = 0;
     PPCODE:
-        keysym = XGetKeyboardMapping(dpy, fkeycode, count, &creturn);
+        PerlXlib_ROUND_TRIP(dpy, XGetKeyboardMapping, keysym= XGetKeyboardMapping(dpy, fkeycode, count, &creturn));
         EXTEND(SP, creturn * count -1);
         for (i=0; i < creturn * count; i++)
             XPUSHs(sv_2mortal(newSVuv(keysym[i])));
@@ -1570,7 +2753,7 @@ load_keymap(dpy, symbolic=2, minkey=0, maxkey=255)
         XDisplayKeycodes(dpy, &xmin, &xmax);
         if (xmin < minkey) xmin= minkey;
         if (xmax > maxkey) xmax= maxkey;
-        syms= XGetKeyboardMapping(dpy, xmin, xmax-xmin+1, &nsym);
+        PerlXlib_ROUND_TRIP(dpy, XGetKeyboardMapping, syms= XGetKeyboardMapping(dpy, xmin, xmax-xmin+1, &nsym));
         if (!syms)
             croak("XGetKeyboardMapping failed");
         tbl= newAV();
@@ -1661,7 +2844,7 @@ XGetModifierMapping(dpy)
         AV *tbl, *row;
         int i, j;
     PPCODE:
-        modmap= XGetModifierMapping(dpy);
+        PerlXlib_ROUND_TRIP(dpy, XGetModifierMapping, modmap= XGetModifierMapping(dpy));
         tbl= newAV();
         av_extend(tbl, 8);
         for (i= 0; i < 8; i++) {
@@ -1816,6 +2999,343 @@ _install_error_handlers(nonfatal,fatal)
     CODE:
         PerlXlib_install_error_handlers(nonfatal, fatal);
 
+# Error Ring Functions () ----------------------------------------------------
+
+void
+error_ring_enable(dpy_obj, capacity= 1024)
+    SV *dpy_obj
+    int capacity
+    INIT:
+        PerlXlib_error_ring *ring, *old;
+        PerlXlib_error_record *recs;
+        PerlXlib_error_filter all;
+        U32 cap= 1;
+        int n, keep;
+        SV *buf;
+    PPCODE:
+        PerlXlib_display_objref_get_pointer(dpy_obj, PerlXlib_OR_DIE);
+        if (capacity < 1 || capacity > (1 << 20))
+            croak("Error ring capacity must be between 1 and %d", 1 << 20);
+        while (cap < capacity) cap <<= 1;
+        buf= newSV(PerlXlib_ERROR_RING_SIZE(cap));
+        SvPOK_on(buf);
+        SvCUR_set(buf, PerlXlib_ERROR_RING_SIZE(cap));
+        ring= (PerlXlib_error_ring*) SvPVX(buf);
+        PerlXlib_error_ring_init(ring, cap);
+        /* Re-enabling keeps the newest records of the old ring */
+        if ((old= PerlXlib_display_error_ring(dpy_obj))) {
+            PerlXlib_error_filter_init(&all);
+            Newx(recs, old->count + 1, PerlXlib_error_record);
+            SAVEFREEPV(recs);
+            n= PerlXlib_error_ring_take(old, &all, recs);
+            keep= n < cap? n : cap;
+            Copy(recs + n - keep, ring->rec, keep, PerlXlib_error_record);
+            ring->count= keep;
+            ring->dropped= old->dropped + n - keep;
+        }
+        if (!hv_store((HV*) SvRV(dpy_obj), "_error_ring", 11, buf, 0)) {
+            sv_2mortal(buf);
+            croak("Can't store _error_ring");
+        }
+        PerlXlib_install_error_handlers(1, 0);
+
+void
+error_ring_disable(dpy_obj)
+    SV *dpy_obj
+    PPCODE:
+        if (PerlXlib_display_error_ring(dpy_obj))
+            hv_delete((HV*) SvRV(dpy_obj), "_error_ring", 11, G_DISCARD);
+
+int
+error_ring_count(dpy_obj, ...)
+    SV *dpy_obj
+    INIT:
+        PerlXlib_error_filter filter;
+        PerlXlib_error_ring *ring= _error_ring(dpy_obj);
+    CODE:
+        _error_filter_from_args(&filter, &ST(1), items - 1);
+        RETVAL= PerlXlib_error_ring_count(ring, &filter);
+    OUTPUT:
+        RETVAL
+
+void
+error_ring_drain(dpy_obj, ...)
+    SV *dpy_obj
+    INIT:
+        PerlXlib_error_filter filter;
+        PerlXlib_error_ring *ring= _error_ring(dpy_obj);
+        PerlXlib_error_record *recs;
+        int i, n;
+    PPCODE:
+        _error_filter_from_args(&filter, &ST(1), items - 1);
+        Newx(recs, ring->count + 1, PerlXlib_error_record);
+        SAVEFREEPV(recs);
+        n= PerlXlib_error_ring_take(ring, &filter, recs);
+        EXTEND(SP, n);
+        for (i= 0; i < n; i++)
+            PUSHs(sv_2mortal(_error_record_hv(recs + i)));
+
+UV
+error_ring_dropped(dpy_obj)
+    SV *dpy_obj
+    CODE:
+        RETVAL= _error_ring(dpy_obj)->dropped;
+    OUTPUT:
+        RETVAL
+
+Bool
+_error_trap_poll(dpy, last_serial, block)
+    Display *dpy
+    unsigned long last_serial
+    Bool block
+    CODE:
+        /* Read whatever the server has already sent, or wait for everything */
+        if (LastKnownRequestProcessed(dpy) < last_serial) {
+            if (block)
+                PerlXlib_ROUND_TRIP(dpy, XSync, XSync(dpy, False));
+            else
+                XEventsQueued(dpy, QueuedAfterFlush);
+        }
+        RETVAL= LastKnownRequestProcessed(dpy) >= last_serial;
+    OUTPUT:
+        RETVAL
+
+# Display Statistics () -----------------------------------------------------
+
+void
+stats_enable(dpy_obj)
+    SV *dpy_obj
+    INIT:
+        Display *dpy= PerlXlib_display_objref_get_pointer(dpy_obj, PerlXlib_OR_DIE);
+        HV *hv= (HV*) SvRV(dpy_obj);
+        SV *buf;
+    PPCODE:
+        if (!PerlXlib_display_stats_of(dpy_obj)) {
+            if (!hv_exists(hv, "_stats_hooked", 13)) {
+                PerlXlib_display_stats_hook(dpy);
+                hv_store(hv, "_stats_hooked", 13, newSViv(1), 0);
+            }
+            buf= newSV(sizeof(PerlXlib_display_stats));
+            SvPOK_on(buf);
+            SvCUR_set(buf, sizeof(PerlXlib_display_stats));
+            PerlXlib_display_stats_reset(dpy, (PerlXlib_display_stats*) SvPVX(buf));
+            if (!hv_store(hv, "_stats", 6, buf, 0)) {
+                sv_2mortal(buf);
+                croak("Can't store _stats");
+            }
+            PerlXlib_display_stats_active++;
+        }
+
+void
+stats_disable(dpy_obj)
+    SV *dpy_obj
+    PPCODE:
+        if (PerlXlib_display_stats_of(dpy_obj)) {
+            hv_delete((HV*) SvRV(dpy_obj), "_stats", 6, G_DISCARD);
+            PerlXlib_display_stats_active--;
+        }
+
+int
+_stats_active()
+    CODE:
+        RETVAL= PerlXlib_display_stats_active;
+    OUTPUT:
+        RETVAL
+
+void
+stats(dpy_obj, reset= 0)
+    SV *dpy_obj
+    Bool reset
+    INIT:
+        Display *dpy= PerlXlib_display_objref_get_pointer(dpy_obj, PerlXlib_OR_DIE);
+        PerlXlib_display_stats *stats= PerlXlib_display_stats_of(dpy_obj);
+        HV *ret, *calls, *call;
+        AV *hist;
+        UV round_trips= 0;
+        I64 wait_ns= 0;
+        int i;
+    PPCODE:
+        if (!stats)
+            croak("Display has no stats (call stats_enable first)");
+        ret= newHV();
+        PUSHs(sv_2mortal(newRV_noinc((SV*) ret)));
+        calls= newHV();
+        for (i= 0; i < PerlXlib_STAT_COUNT; i++) {
+            if (!stats->calls[i]) continue;
+            call= newHV();
+            hv_store(call, "count", 5, newSVuv(stats->calls[i]), 0);
+            hv_store(call, "wait_us", 7, newSVnv(stats->wait_ns[i] / 1000.0), 0);
+            hv_store(calls, PerlXlib_display_stats_names[i], strlen(PerlXlib_display_stats_names[i]),
+                newRV_noinc((SV*) call), 0);
+            round_trips += stats->calls[i];
+            wait_ns += stats->wait_ns[i];
+        }
+        hist= newAV();
+        av_extend(hist, PerlXlib_STATS_BUCKETS - 1);
+        for (i= 0; i < PerlXlib_STATS_BUCKETS; i++)
+            av_push(hist, newSVuv(stats->wait_histogram[i]));
+        hv_store(ret, "requests", 8, newSVuv(NextRequest(dpy) - stats->base_serial), 0);
+        hv_store(ret, "bytes_flushed", 13, newSVuv(stats->bytes_flushed), 0);
+        hv_store(ret, "round_trips", 11, newSVuv(round_trips), 0);
+        hv_store(ret, "wait_us", 7, newSVnv(wait_ns / 1000.0), 0);
+        hv_store(ret, "calls", 5, newRV_noinc((SV*) calls), 0);
+        hv_store(ret, "wait_histogram", 14, newRV_noinc((SV*) hist), 0);
+        if (reset)
+            PerlXlib_display_stats_reset(dpy, stats);
+
+void
+stats_reset(dpy_obj)
+    SV *dpy_obj
+    INIT:
+        Display *dpy= PerlXlib_display_objref_get_pointer(dpy_obj, PerlXlib_OR_DIE);
+        PerlXlib_display_stats *stats= PerlXlib_display_stats_of(dpy_obj);
+    PPCODE:
+        if (stats)
+            PerlXlib_display_stats_reset(dpy, stats);
+
+# Request Tracing () --------------------------------------------------------
+
+void
+trace_enable(dpy_obj, capacity= 65536)
+    SV *dpy_obj
+    int capacity
+    INIT:
+        PerlXlib_trace_ring *ring;
+        U32 cap= 1;
+        SV *buf;
+    PPCODE:
+        PerlXlib_display_objref_get_pointer(dpy_obj, PerlXlib_OR_DIE);
+        if (capacity < 1 || capacity > (1 << 24))
+            croak("Trace capacity must be between 1 and %d", 1 << 24);
+        while (cap < capacity) cap <<= 1;
+        if (!PerlXlib_display_trace_ring(dpy_obj))
+            PerlXlib_trace_install(1);
+        buf= newSV(PerlXlib_TRACE_RING_SIZE(cap));
+        SvPOK_on(buf);
+        SvCUR_set(buf, PerlXlib_TRACE_RING_SIZE(cap));
+        ring= (PerlXlib_trace_ring*) SvPVX(buf);
+        memset(ring, 0, sizeof(*ring));
+        ring->mask= cap - 1;
+        if (!hv_store((HV*) SvRV(dpy_obj), "_trace", 6, buf, 0)) {
+            sv_2mortal(buf);
+            croak("Can't store _trace");
+        }
+
+void
+trace_disable(dpy_obj)
+    SV *dpy_obj
+    PPCODE:
+        if (PerlXlib_display_trace_ring(dpy_obj)) {
+            hv_delete((HV*) SvRV(dpy_obj), "_trace", 6, G_DISCARD);
+            PerlXlib_trace_install(0);
+        }
+
+void
+trace_clear(dpy_obj)
+    SV *dpy_obj
+    INIT:
+        PerlXlib_trace_ring *ring= PerlXlib_display_trace_ring(dpy_obj);
+    PPCODE:
+        if (ring)
+            ring->head= 0;
+
+SV *
+trace_json(dpy_obj)
+    SV *dpy_obj
+    INIT:
+        PerlXlib_trace_ring *ring= PerlXlib_display_trace_ring(dpy_obj);
+    CODE:
+        if (!ring)
+            croak("Display is not traced (call trace_enable first)");
+        RETVAL= PerlXlib_trace_json(ring);
+    OUTPUT:
+        RETVAL
+
+# Benchmark Functions () -----------------------------------------------------
+
+void
+_bench_c(func, arg, count)
+    const char *func
+    SV *arg
+    UV count
+    INIT:
+        SV * volatile varg= arg; /* re-read each time, so the loop isn't optimized away */
+        volatile UV sink= 0;
+        void *ptr= NULL;
+        I64 start_ns;
+        IV svs= 0, before;
+        UV i, j, batch;
+        int which= strEQ(func, "is_an_integer")? 0
+            : strEQ(func, "sv_to_keysym")? 1
+            : strEQ(func, "keysym_to_codepoint")? 2
+            : strEQ(func, "codepoint_to_keysym")? 3
+            : strEQ(func, "get_struct_ptr")? 4
+            : strEQ(func, "get_objref")? 5
+            : -1;
+    PPCODE:
+        if (which < 0)
+            croak("Unknown function '%s'", func);
+        if (which == 5)
+            ptr= sv_isobject(arg)? PerlXlib_objref_get_pointer(arg, NULL, PerlXlib_OR_DIE) : INT2PTR(void*, SvUV(arg));
+        start_ns= PerlXlib_stats_now_ns();
+        /* Mortals are freed once per batch, after counting the SVs still
+         * allocated, which are the allocations of the calls in that batch. */
+        for (i= 0; i < count; i += batch) {
+            batch= count - i < 256? count - i : 256;
+            ENTER;
+            SAVETMPS;
+            before= PL_sv_count;
+            for (j= 0; j < batch; j++) {
+                switch (which) {
+                case 0: sink += is_an_integer(varg); break;
+                case 1: sink += PerlXlib_sv_to_keysym(varg); break;
+                case 2: sink += PerlXlib_keysym_to_codepoint(SvUV(varg)); break;
+                case 3: sink += PerlXlib_codepoint_to_keysym(SvIV(varg)); break;
+                case 4: sink += PTR2UV(PerlXlib_get_struct_ptr(varg, 0, "X11::Xlib::XEvent", sizeof(XEvent),
+                            (PerlXlib_struct_pack_fn*) &PerlXlib_XEvent_pack)); break;
+                case 5: sink += PTR2UV(PerlXlib_get_objref(ptr, PerlXlib_OR_NULL, NULL, 0, NULL, NULL)); break;
+                }
+            }
+            svs += PL_sv_count - before;
+            FREETMPS;
+            LEAVE;
+        }
+        PUSHs(sv_2mortal(newSVnv((PerlXlib_stats_now_ns() - start_ns) / 1e9)));
+        PUSHs(sv_2mortal(newSViv(svs)));
+
+void
+_bench_call(code, count)
+    SV *code
+    UV count
+    INIT:
+        I64 start_ns;
+        IV svs= 0, before;
+        UV i, j, batch;
+    PPCODE:
+        start_ns= PerlXlib_stats_now_ns();
+        for (i= 0; i < count; i += batch) {
+            batch= count - i < 256? count - i : 256;
+            ENTER;
+            SAVETMPS;
+            before= PL_sv_count;
+            ENTER;
+            for (j= 0; j < batch; j++) {
+                /* raise the floor, so the next call doesn't free these mortals */
+                SAVETMPS;
+                PUSHMARK(SP);
+                PUTBACK;
+                call_sv(code, G_SCALAR);
+                SPAGAIN;
+                SP--;
+            }
+            LEAVE;
+            svs += PL_sv_count - before;
+            FREETMPS;
+            LEAVE;
+        }
+        PUSHs(sv_2mortal(newSVnv((PerlXlib_stats_now_ns() - start_ns) / 1e9)));
+        PUSHs(sv_2mortal(newSViv(svs)));
+
 # Xcomposite Extension () ----------------------------------------------------
 
 #ifdef XCOMPOSITE_VERSION
@@ -1928,35 +3448,49 @@ XFixesVersion()
 #if XFIXES_MAJOR >= 2
 
 XserverRegion
-XFixesCreateRegion(dpy, rect_av)
+XFixesCreateRegion(dpy, rects_sv)
     Display *dpy
-    AV *rect_av
+    SV *rects_sv
     INIT:
-        XRectangle *rects, *rect;
+        XRectangle *rects;
+        PerlXlib_box *boxes;
         int nrects, i;
-        SV **elem;
+        size_t nboxes;
     CODE:
-        nrects= av_len(rect_av)+1;
-        if (nrects) {
-            Newx(rects, nrects, XRectangle);
+        if (sv_isobject(rects_sv) && sv_derived_from(rects_sv, "X11::Xlib::Region")) {
+            boxes= _region_boxes(rects_sv, &nboxes);
+            nrects= nboxes;
+            Newx(rects, nrects + 1, XRectangle);
             SAVEFREEPV(rects);
-            for (i= 0; i < nrects; i++) {
-                elem= av_fetch(rect_av, i, 0);
-                if (!elem) croak("Can't read array elem %d", i);
-                rect= (XRectangle*) PerlXlib_get_struct_ptr(
-                    *elem, 0,
-                    "X11::Xlib::XRectangle", sizeof(XRectangle),
-                    (PerlXlib_struct_pack_fn*) PerlXlib_XRectangle_pack
-                );
-                memcpy(rects+i, rect, sizeof(XRectangle));
-            }
-        } else {
-            rects= NULL;
+            for (i= 0; i < nrects; i++)
+                _region_box_to_rect(boxes + i, rects + i);
+        }
+        else {
+            rects= (XRectangle*) PerlXlib_get_struct_array(rects_sv, "X11::Xlib::XRectangle", sizeof(XRectangle), 4,
+                (PerlXlib_struct_pack_fn*) &PerlXlib_XRectangle_pack, &nrects);
         }
-        RETVAL = XFixesCreateRegion(dpy, rects, nrects);
+        RETVAL = XFixesCreateRegion(dpy, nrects? rects : NULL, nrects);
     OUTPUT:
         RETVAL
 
+void
+XFixesFetchRegion(dpy, region)
+    Display *dpy
+    XserverRegion region
+    INIT:
+        XRectangle *rects;
+        int nrects, i;
+    PPCODE:
+        PerlXlib_ROUND_TRIP(dpy, XFixesFetchRegion, rects= XFixesFetchRegion(dpy, region, &nrects));
+        if (rects) {
+            EXTEND(SP, nrects);
+            for (i= 0; i < nrects; i++)
+                PUSHs(sv_2mortal(
+                    sv_setref_pvn(newSV(0), "X11::Xlib::XRectangle", (char*)(rects+i), sizeof(XRectangle))
+                ));
+            XFree(rects);
+        }
+
 void
 XFixesDestroyRegion(dpy, region)
     Display *dpy
@@ -2026,6 +3560,250 @@ XRenderFindVisualFormat(dpy, vis)
         }
         /* doesn't need freed? */
 
+void
+XRenderFindStandardFormat(dpy, format)
+    Display *dpy
+    int format
+    INIT:
+        XRenderPictFormat *fmt;
+    PPCODE:
+        fmt= XRenderFindStandardFormat(dpy, format);
+        if (fmt) {
+            PUSHs(sv_2mortal(
+                sv_setref_pvn(newSV(0), "X11::Xlib::XRenderPictFormat", (char*)fmt, sizeof(XRenderPictFormat))
+            ));
+        }
+
+Picture
+XRenderCreatePicture(dpy, drawable, format, valuemask= 0, attrs= NULL)
+    Display *dpy
+    Drawable drawable
+    XRenderPictFormat *format
+    unsigned long valuemask
+    XRenderPictureAttributes *attrs
+    CODE:
+        if (valuemask && !attrs)
+            croak("attrs may only be NULL if valuemask is 0");
+        RETVAL = XRenderCreatePicture(dpy, drawable, format, valuemask, attrs);
+    OUTPUT:
+        RETVAL
+
+void
+XRenderChangePicture(dpy, picture, valuemask, attrs)
+    Display *dpy
+    Picture picture
+    unsigned long valuemask
+    XRenderPictureAttributes *attrs
+
+void
+XRenderFreePicture(dpy, picture)
+    Display *dpy
+    Picture picture
+
+void
+XRenderComposite(dpy, op, src, mask, dst, src_x, src_y, mask_x, mask_y, dst_x, dst_y, width, height)
+    Display *dpy
+    int op
+    Picture src
+    Picture mask
+    Picture dst
+    int src_x
+    int src_y
+    int mask_x
+    int mask_y
+    int dst_x
+    int dst_y
+    unsigned int width
+    unsigned int height
+
+void
+XRenderFillRectangles(dpy, op, dst, color, rects)
+    Display *dpy
+    int op
+    Picture dst
+    XRenderColor *color
+    SV *rects
+    INIT:
+        int n;
+        XRectangle *r= (XRectangle*) PerlXlib_get_struct_array(rects, "X11::Xlib::XRectangle", sizeof(XRectangle), 4,
+            (PerlXlib_struct_pack_fn*) &PerlXlib_XRectangle_pack, &n);
+    CODE:
+        if (n) XRenderFillRectangles(dpy, op, dst, color, r, n);
+
+void
+XRenderSetPictureTransform(dpy, picture, matrix)
+    Display *dpy
+    Picture picture
+    AV *matrix
+    INIT:
+        XTransform xform;
+        SV **row, **elem;
+        int i, j;
+    CODE:
+        /* accept either [ [a,b,c], [d,e,f], [g,h,i] ] or the flat list of 9 values */
+        if (av_len(matrix) == 2) {
+            for (i= 0; i < 3; i++) {
+                row= av_fetch(matrix, i, 0);
+                if (!row || !*row || !SvROK(*row) || SvTYPE(SvRV(*row)) != SVt_PVAV || av_len((AV*) SvRV(*row)) != 2)
+                    croak("Transform row %d must be an arrayref of 3 numbers", i);
+                for (j= 0; j < 3; j++) {
+                    elem= av_fetch((AV*) SvRV(*row), j, 0);
+                    xform.matrix[i][j]= XDoubleToFixed(elem && *elem? SvNV(*elem) : 0);
+                }
+            }
+        }
+        else if (av_len(matrix) == 8) {
+            for (i= 0; i < 9; i++) {
+                elem= av_fetch(matrix, i, 0);
+                xform.matrix[i/3][i%3]= XDoubleToFixed(elem && *elem? SvNV(*elem) : 0);
+            }
+        }
+        else croak("Transform must be a 3x3 matrix");
+        XRenderSetPictureTransform(dpy, picture, &xform);
+
+void
+XRenderSetPictureFilter(dpy, picture, filter, params= NULL)
+    Display *dpy
+    Picture picture
+    const char *filter
+    AV *params
+    INIT:
+        XFixed *fixed= NULL;
+        SV **elem;
+        int i, n= params? av_len(params) + 1 : 0;
+    CODE:
+        if (n) {
+            Newx(fixed, n, XFixed);
+            SAVEFREEPV(fixed);
+            for (i= 0; i < n; i++) {
+                elem= av_fetch(params, i, 0);
+                fixed[i]= XDoubleToFixed(elem && *elem? SvNV(*elem) : 0);
+            }
+        }
+        XRenderSetPictureFilter(dpy, picture, filter, fixed, n);
+
+GlyphSet
+XRenderCreateGlyphSet(dpy, format)
+    Display *dpy
+    XRenderPictFormat *format
+
+void
+XRenderFreeGlyphSet(dpy, glyphset)
+    Display *dpy
+    GlyphSet glyphset
+
+void
+XRenderAddGlyphs(dpy, glyphset, gids, infos, images)
+    Display *dpy
+    GlyphSet glyphset
+    AV *gids
+    SV *infos
+    SV *images
+    INIT:
+        Glyph *gid_array;
+        XGlyphInfo *info_array;
+        const char *img;
+        STRLEN img_len;
+        SV **elem;
+        int n_info, i, n= av_len(gids) + 1;
+    CODE:
+        info_array= (XGlyphInfo*) PerlXlib_get_struct_array(infos, "X11::Xlib::XGlyphInfo", sizeof(XGlyphInfo), 6,
+            (PerlXlib_struct_pack_fn*) &PerlXlib_XGlyphInfo_pack, &n_info);
+        if (n_info != n)
+            croak("Got %d glyph ids but %d XGlyphInfo", n, n_info);
+        img= SvPVbyte(images, img_len);
+        if (n) {
+            Newx(gid_array, n, Glyph);
+            SAVEFREEPV(gid_array);
+            for (i= 0; i < n; i++) {
+                elem= av_fetch(gids, i, 0);
+                gid_array[i]= elem && *elem? SvUV(*elem) : 0;
+            }
+            XRenderAddGlyphs(dpy, glyphset, gid_array, info_array, n, img, img_len);
+        }
+
+void
+XRenderFreeGlyphs(dpy, glyphset, gids)
+    Display *dpy
+    GlyphSet glyphset
+    AV *gids
+    INIT:
+        Glyph *gid_array;
+        SV **elem;
+        int i, n= av_len(gids) + 1;
+    CODE:
+        if (n) {
+            Newx(gid_array, n, Glyph);
+            SAVEFREEPV(gid_array);
+            for (i= 0; i < n; i++) {
+                elem= av_fetch(gids, i, 0);
+                gid_array[i]= elem && *elem? SvUV(*elem) : 0;
+            }
+            XRenderFreeGlyphs(dpy, glyphset, gid_array, n);
+        }
+
+void
+XRenderCompositeString32(dpy, op, src, dst, mask_format, glyphset, src_x, src_y, dst_x, dst_y, glyphs)
+    Display *dpy
+    int op
+    Picture src
+    Picture dst
+    SV *mask_format
+    GlyphSet glyphset
+    int src_x
+    int src_y
+    int dst_x
+    int dst_y
+    SV *glyphs
+    INIT:
+        XRenderPictFormat *mfmt= NULL;
+        unsigned int *ids;
+        const char *packed;
+        STRLEN len;
+        SV **elem;
+        int i, n;
+    CODE:
+        if (SvOK(mask_format))
+            mfmt= (XRenderPictFormat*) PerlXlib_get_struct_ptr(mask_format, 0, "X11::Xlib::XRenderPictFormat",
+                sizeof(XRenderPictFormat), (PerlXlib_struct_pack_fn*) &PerlXlib_XRenderPictFormat_pack);
+        /* glyphs are either a packed string of 32-bit ids, or an arrayref of ids */
+        if (SvROK(glyphs) && SvTYPE(SvRV(glyphs)) == SVt_PVAV) {
+            n= av_len((AV*) SvRV(glyphs)) + 1;
+            Newx(ids, n? n : 1, unsigned int);
+            SAVEFREEPV(ids);
+            for (i= 0; i < n; i++) {
+                elem= av_fetch((AV*) SvRV(glyphs), i, 0);
+                ids[i]= elem && *elem? SvUV(*elem) : 0;
+            }
+        }
+        else {
+            packed= SvPVbyte(glyphs, len);
+            if (len % sizeof(unsigned int))
+                croak("Length of packed glyph string (%ld) is not a multiple of %d", (long) len, (int) sizeof(unsigned int));
+            n= len / sizeof(unsigned int);
+            ids= (unsigned int*) packed;
+        }
+        if (n)
+            XRenderCompositeString32(dpy, op, src, dst, mfmt, glyphset, src_x, src_y, dst_x, dst_y, ids, n);
+
+#ifdef HAVE_FREETYPE
+
+void
+ft_render_glyph(font_file, pixel_size, codepoint)
+    const char *font_file
+    int pixel_size
+    UV codepoint
+    INIT:
+        XGlyphInfo info;
+        SV *img;
+    PPCODE:
+        img= PerlXlib_ft_render_glyph(font_file, pixel_size, codepoint, &info);
+        EXTEND(SP, 2);
+        PUSHs(sv_2mortal(img));
+        PUSHs(sv_2mortal(sv_setref_pvn(newSV(0), "X11::Xlib::XGlyphInfo", (char*) &info, sizeof(info))));
+
+#endif /* HAVE_FREETYPE */
+
 #else /* (not) HAVE_XRENDER */
 
 #define PictFormatID        (1 << 0)
@@ -2041,1190 +3819,3352 @@ XRenderFindVisualFormat(dpy, vis)
 #define PictFormatAlphaMask (1 << 10)
 #define PictFormatColormap  (1 << 11)
 
+#define PictOpClear          0
+#define PictOpSrc            1
+#define PictOpDst            2
+#define PictOpOver           3
+#define PictOpOverReverse    4
+#define PictOpIn             5
+#define PictOpInReverse      6
+#define PictOpOut            7
+#define PictOpOutReverse     8
+#define PictOpAtop           9
+#define PictOpAtopReverse    10
+#define PictOpXor            11
+#define PictOpAdd            12
+#define PictOpSaturate       13
+#define PictStandardARGB32   0
+#define PictStandardRGB24    1
+#define PictStandardA8       2
+#define PictStandardA4       3
+#define PictStandardA1       4
+#define CPRepeat             (1 << 0)
+#define CPAlphaMap           (1 << 1)
+#define CPAlphaXOrigin       (1 << 2)
+#define CPAlphaYOrigin       (1 << 3)
+#define CPClipXOrigin        (1 << 4)
+#define CPClipYOrigin        (1 << 5)
+#define CPClipMask           (1 << 6)
+#define CPGraphicsExposure   (1 << 7)
+#define CPSubwindowMode      (1 << 8)
+#define CPPolyEdge           (1 << 9)
+#define CPPolyMode           (1 << 10)
+#define CPDither             (1 << 11)
+#define CPComponentAlpha     (1 << 12)
+#define RepeatNone           0
+#define RepeatNormal         1
+#define RepeatPad            2
+#define RepeatReflect        3
+
 #endif /* HAVE_XRENDER */
 
-MODULE = X11::Xlib                PACKAGE = X11::Xlib::Opaque
+# Xdamage Extension () -------------------------------------------------------
+
+#ifdef HAVE_XDAMAGE
 
 void
-display(self, dpy_sv= NULL)
-    SV *self
-    SV *dpy_sv
+XDamageQueryExtension(dpy)
+    Display *dpy
+    INIT:
+        int event_base, error_base;
     PPCODE:
-        if (dpy_sv)
-            PerlXlib_objref_set_display(self, dpy_sv);
-        else
-            dpy_sv= PerlXlib_objref_get_display(self);
-        PUSHs(sv_mortalcopy(dpy_sv));
+        if (_damage_init(dpy, &event_base, &error_base)) {
+            XPUSHs(sv_2mortal(newSViv(event_base)));
+            XPUSHs(sv_2mortal(newSViv(error_base)));
+        }
 
 void
-pointer_int(self)
-    SV *self
+XDamageQueryVersion(dpy)
+    Display *dpy
     INIT:
-        void *opaque= PerlXlib_objref_get_pointer(self, NULL, PerlXlib_OR_NULL);
+        int major, minor;
     PPCODE:
-        PUSHs(sv_2mortal(newSVuv(PTR2UV(opaque))));
+        if (XDamageQueryVersion(dpy, &major, &minor)) {
+            XPUSHs(sv_2mortal(newSViv(major)));
+            XPUSHs(sv_2mortal(newSViv(minor)));
+        }
+
+Damage
+XDamageCreate(dpy, drawable, level)
+    Display *dpy
+    Drawable drawable
+    int level
+    INIT:
+        int event_base, error_base;
+    CODE:
+        _damage_init(dpy, &event_base, &error_base);
+        RETVAL = XDamageCreate(dpy, drawable, level);
+    OUTPUT:
+        RETVAL
 
 void
-pointer_bytes(self)
-    SV *self
+XDamageDestroy(dpy, damage)
+    Display *dpy
+    Damage damage
+
+void
+XDamageSubtract(dpy, damage, repair, parts)
+    Display *dpy
+    Damage damage
+    XserverRegion repair
+    XserverRegion parts
+
+void
+XDamageAdd(dpy, drawable, region)
+    Display *dpy
+    Drawable drawable
+    XserverRegion region
+
+void
+damage_accumulate(dpy_obj, max_events= -1)
+    SV *dpy_obj
+    int max_events
     INIT:
-        void *opaque= PerlXlib_objref_get_pointer(self, NULL, PerlXlib_OR_NULL);
+        Display *dpy= PerlXlib_display_objref_get_pointer(dpy_obj, PerlXlib_OR_DIE);
+        HV *accum= _display_hv_slot(dpy_obj, "_damage_accum");
+        XEvent event;
+        XDamageNotifyEvent *dev= (XDamageNotifyEvent*) &event;
+        Damage prev= None, damage;
+        SV **ent, *buf= NULL;
+        HE *he;
+        int event_base, error_base, n= 0;
     PPCODE:
-        PUSHs(sv_2mortal(newSVpvn((void*) &opaque, sizeof(opaque))));
+        if (!_damage_init(dpy, &event_base, &error_base))
+            croak("DAMAGE extension is not available");
+        /* Pull every queued DamageNotify out of the Xlib queue, leaving other
+         * events in place, and fold each area into the per-Damage list. */
+        while ((max_events < 0 || n < max_events)
+            && XCheckTypedEvent(dpy, event_base + XDamageNotify, &event)
+        ) {
+            ++n;
+            if (!buf || dev->damage != prev) {
+                ent= hv_fetch(accum, (char*) &dev->damage, sizeof(Damage), 1);
+                if (!ent) croak("Can't store damage in _damage_accum");
+                buf= *ent;
+                if (!SvPOK(buf)) sv_setpvn(buf, "", 0);
+                prev= dev->damage;
+            }
+            _damage_accum_add(buf, &dev->area);
+        }
+        /* Merge the pending area of each Damage into one region, and return
+         * the XID of every Damage that has some */
+        hv_iterinit(accum);
+        while ((he= hv_iternext(accum))) {
+            if (HeKLEN(he) == sizeof(Damage) && SvPOK(HeVAL(he)) && SvCUR(HeVAL(he))) {
+                _damage_accum_merge(HeVAL(he));
+                memcpy(&damage, HeKEY(he), sizeof(Damage));
+                mXPUSHu(damage);
+            }
+        }
 
-MODULE = X11::Xlib                PACKAGE = X11::Xlib::Visual
+void
+damage_take_rects(dpy_obj, damage)
+    SV *dpy_obj
+    Damage damage
+    INIT:
+        HV *accum= _display_hv_slot(dpy_obj, "_damage_accum");
+        SV **ent;
+        XRectangle *rects;
+        size_t n, i;
+    PPCODE:
+        ent= hv_fetch(accum, (char*) &damage, sizeof(Damage), 0);
+        if (ent && SvPOK(*ent)) {
+            rects= (XRectangle*) SvPVX(*ent);
+            n= SvCUR(*ent) / sizeof(XRectangle);
+            EXTEND(SP, n);
+            for (i= 0; i < n; i++)
+                PUSHs(sv_2mortal(
+                    sv_setref_pvn(newSV(0), "X11::Xlib::XRectangle", (char*)(rects+i), sizeof(XRectangle))
+                ));
+            hv_delete(accum, (char*) &damage, sizeof(Damage), G_DISCARD);
+        }
+
+#else /* (not) HAVE_XDAMAGE */
+
+#define XDamageReportRawRectangles   0
+#define XDamageReportDeltaRectangles 1
+#define XDamageReportBoundingBox     2
+#define XDamageReportNonEmpty        3
+#define XDamageNotify                0
+
+#endif /* HAVE_XDAMAGE */
+
+# XInput2 Extension () -------------------------------------------------------
+
+#ifdef HAVE_XI
+
+void
+XIQueryVersion(dpy, major= 2, minor= 2)
+    Display *dpy
+    int major
+    int minor
+    PPCODE:
+        if (XIQueryVersion(dpy, &major, &minor) == Success) {
+            XPUSHs(sv_2mortal(newSViv(major)));
+            XPUSHs(sv_2mortal(newSViv(minor)));
+        }
 
 int
-id(visual)
-    Visual *visual
+XISelectEvents(dpy, wnd, masks)
+    Display *dpy
+    Window wnd
+    HV *masks
+    INIT:
+        int mask_len= XIMaskLen(XI_LASTEVENT), n= 0, i, evtype;
+        XIEventMask *xm;
+        unsigned char *bits;
+        AV *types;
+        SV **elem;
+        HE *he;
     CODE:
-        RETVAL = XVisualIDFromVisual(visual);
+        i= hv_iterinit(masks);
+        Newxz(xm, i + 1, XIEventMask);
+        SAVEFREEPV(xm);
+        Newxz(bits, (i + 1) * mask_len, unsigned char);
+        SAVEFREEPV(bits);
+        while ((he= hv_iternext(masks))) {
+            xm[n].deviceid= SvIV(hv_iterkeysv(he));
+            xm[n].mask_len= mask_len;
+            xm[n].mask= bits + n * mask_len;
+            if (!SvROK(HeVAL(he)) || SvTYPE(SvRV(HeVAL(he))) != SVt_PVAV)
+                croak("Expected arrayref of event types for device %d", xm[n].deviceid);
+            types= (AV*) SvRV(HeVAL(he));
+            for (i= 0; i <= av_len(types); i++) {
+                if (!(elem= av_fetch(types, i, 0)) || !*elem) continue;
+                evtype= SvIV(*elem);
+                if (evtype < 0 || evtype > XI_LASTEVENT)
+                    croak("Unknown XI2 event type %d", evtype);
+                XISetMask(xm[n].mask, evtype);
+            }
+            n++;
+        }
+        RETVAL= XISelectEvents(dpy, wnd, xm, n);
     OUTPUT:
         RETVAL
 
-MODULE = X11::Xlib                PACKAGE = X11::Xlib::XEvent
-
-# ----------------------------------------------------------------------------
-# BEGIN GENERATED X11_Xlib_XEvent
 void
-_initialize(s)
-    SV *s
+XIQueryDevice(dpy, deviceid= XIAllDevices)
+    Display *dpy
+    int deviceid
     INIT:
-        void *sptr;
+        XIDeviceInfo *info;
+        HV *dev;
+        AV *classes;
+        int n= 0, i, j;
     PPCODE:
-        sptr= PerlXlib_get_struct_ptr(s, 1, "X11::Xlib::XEvent", sizeof(XEvent),
-            (PerlXlib_struct_pack_fn*) &PerlXlib_XEvent_pack
-        );
-        memset((void*) sptr, 0, sizeof(XEvent));
+        PerlXlib_ROUND_TRIP(dpy, XIQueryDevice, info= XIQueryDevice(dpy, deviceid, &n));
+        if (info) {
+            EXTEND(SP, n);
+            for (i= 0; i < n; i++) {
+                dev= newHV();
+                PUSHs(sv_2mortal(newRV_noinc((SV*) dev)));
+                hv_stores(dev, "deviceid",   newSViv(info[i].deviceid));
+                hv_stores(dev, "name",       newSVpv(info[i].name? info[i].name : "", 0));
+                hv_stores(dev, "use",        newSViv(info[i].use));
+                hv_stores(dev, "attachment", newSViv(info[i].attachment));
+                hv_stores(dev, "enabled",    newSViv(info[i].enabled));
+                classes= newAV();
+                hv_stores(dev, "classes", newRV_noinc((SV*) classes));
+                for (j= 0; j < info[i].num_classes; j++)
+                    av_push(classes, _xi2_class_hv(info[i].classes[j]));
+            }
+            XIFreeDeviceInfo(info);
+        }
 
-int
-_sizeof(ignored)
-    SV *ignored
+SV *
+xi2_decode(dpy, event_sv)
+    Display *dpy
+    SV *event_sv
+    INIT:
+        XEvent *event= (XEvent*) PerlXlib_get_struct_ptr(
+            event_sv, 1, "X11::Xlib::XEvent", sizeof(XEvent),
+            (PerlXlib_struct_pack_fn*) PerlXlib_XEvent_pack
+        );
+        PerlXlib_xi2_record rec;
+        Bool fetched= 0, ok= 0;
     CODE:
-        RETVAL = sizeof(XEvent);
+        if (event->type == GenericEvent) {
+            /* fetch the data unless the caller already did */
+            if (!event->xcookie.data)
+                fetched= XGetEventData(dpy, &event->xcookie);
+            ok= PerlXlib_xi2_decode(&event->xcookie, &rec);
+            if (fetched)
+                XFreeEventData(dpy, &event->xcookie);
+        }
+        RETVAL= ok? newSVpvn((char*) &rec, sizeof(rec)) : newSV(0);
     OUTPUT:
         RETVAL
 
 void
-_pack(e, fields, consume)
-    XEvent *e
-    HV *fields
-    Bool consume
+xi2_drain(dpy_obj, max_events= -1)
+    SV *dpy_obj
+    int max_events
     INIT:
-        const char *oldpkg, *newpkg;
+        Display *dpy= PerlXlib_display_objref_get_pointer(dpy_obj, PerlXlib_OR_DIE);
+        int opcode= _xi2_opcode(dpy_obj, dpy), n= 0;
+        PerlXlib_xi2_record *rec;
+        XEvent event;
+        SV *out;
     PPCODE:
-        oldpkg= PerlXlib_xevent_pkg_for_type(e->type);
-        PerlXlib_XEvent_pack(e, fields, consume);
-        newpkg= PerlXlib_xevent_pkg_for_type(e->type);
-        /* re-bless the object if the thing passed to us was actually an object */
-        if (oldpkg != newpkg && sv_derived_from(ST(0), "X11::Xlib::XEvent"))
-            sv_bless(ST(0), gv_stashpv(newpkg, GV_ADD));
+        out= sv_2mortal(newSVpvn("", 0));
+        /* Take only the XI2 device and raw events out of the queue, and leave
+         * everything else (including other XI2 events) in order. */
+        while (opcode >= 0 && (max_events < 0 || n < max_events)
+            && XCheckIfEvent(dpy, &event, &_xi2_record_pred, (XPointer) &opcode)
+        ) {
+            if (!XGetEventData(dpy, &event.xcookie))
+                continue;
+            rec= (PerlXlib_xi2_record*) (SvGROW(out, (n + 1) * sizeof(*rec) + 1) + n * sizeof(*rec));
+            if (PerlXlib_xi2_decode(&event.xcookie, rec))
+                n++;
+            XFreeEventData(dpy, &event.xcookie);
+        }
+        SvCUR_set(out, n * sizeof(*rec));
+        PUSHs(out);
 
 void
-_unpack(e, fields)
-    XEvent *e
-    HV *fields
+xi2_records(packed)
+    SV *packed
+    INIT:
+        PerlXlib_xi2_record rec;
+        const char *p;
+        STRLEN len, i;
     PPCODE:
-        PerlXlib_XEvent_unpack(e, fields);
+        p= SvPVbyte(packed, len);
+        if (len % sizeof(rec))
+            croak("Length of packed records is not a multiple of %d", (int) sizeof(rec));
+        EXTEND(SP, len / sizeof(rec));
+        for (i= 0; i < len; i += sizeof(rec)) {
+            /* copy, since the string buffer might not be aligned */
+            memcpy(&rec, p + i, sizeof(rec));
+            PUSHs(sv_2mortal(_xi2_record_hv(&rec)));
+        }
 
-void
-_above(event, value=NULL)
-  XEvent *event
-  SV *value
-  INIT:
-    Window c_value= 0;
-  PPCODE:
-    if (value) { c_value= PerlXlib_sv_to_xid(value); }
-    switch (event->type) {
-    case ConfigureNotify:
-      if (value) { event->xconfigure.above = c_value; } else { c_value= event->xconfigure.above; } break;
-    case ConfigureRequest:
-      if (value) { event->xconfigurerequest.above = c_value; } else { c_value= event->xconfigurerequest.above; } break;
-    default: croak("Can't access XEvent.above for type=%d", event->type);
-    }
-    PUSHs(value? value : sv_2mortal(newSVuv(c_value)));
+#else /* (not) HAVE_XI */
+
+#define XIAllDevices              0
+#define XIAllMasterDevices        1
+#define XI_DeviceChanged          1
+#define XI_KeyPress               2
+#define XI_KeyRelease             3
+#define XI_ButtonPress            4
+#define XI_ButtonRelease          5
+#define XI_Motion                 6
+#define XI_Enter                  7
+#define XI_Leave                  8
+#define XI_FocusIn                9
+#define XI_FocusOut              10
+#define XI_HierarchyChanged      11
+#define XI_PropertyEvent         12
+#define XI_RawKeyPress           13
+#define XI_RawKeyRelease         14
+#define XI_RawButtonPress        15
+#define XI_RawButtonRelease      16
+#define XI_RawMotion             17
+#define XIMasterPointer           1
+#define XIMasterKeyboard          2
+#define XISlavePointer            3
+#define XISlaveKeyboard           4
+#define XIFloatingSlave           5
+#define XIKeyClass                0
+#define XIButtonClass             1
+#define XIValuatorClass           2
+
+#endif /* HAVE_XI */
+
+#ifndef XI_TouchBegin
+#define XI_TouchBegin            18
+#define XI_TouchUpdate           19
+#define XI_TouchEnd              20
+#define XI_RawTouchBegin         22
+#define XI_RawTouchUpdate        23
+#define XI_RawTouchEnd           24
+#endif
+#ifndef XIScrollClass
+#define XIScrollClass             3
+#endif
+#ifndef XITouchClass
+#define XITouchClass              8
+#endif
 
-void
-_atom(event, value=NULL)
-  XEvent *event
-  SV *value
-  INIT:
-    Atom c_value= 0;
-  PPCODE:
-    if (value) { c_value= PerlXlib_sv_to_xid(value); }
-    switch (event->type) {
-    case PropertyNotify:
-      if (value) { event->xproperty.atom = c_value; } else { c_value= event->xproperty.atom; } break;
-    default: croak("Can't access XEvent.atom for type=%d", event->type);
-    }
-    PUSHs(value? value : sv_2mortal(newSVuv(c_value)));
+MODULE = X11::Xlib                PACKAGE = X11::Xlib::Region
 
-void
-_b(event, value=NULL)
-  XEvent *event
-  SV *value
-  PPCODE:
-    switch (event->type) {
-    case ClientMessage:
-      if (value) { { if (!SvPOK(value) || SvCUR(value) != sizeof(char)*20)  croak("Expected scalar of length %ld but got %ld", (long)(sizeof(char)*20), (long) SvCUR(value)); memcpy(event->xclient.data.b, SvPVX(value), sizeof(char)*20);} } else { PUSHs(sv_2mortal(newSVpvn((void*)event->xclient.data.b, sizeof(char)*20))); } break;
-    default: croak("Can't access XEvent.b for type=%d", event->type);
-    }
+SV *
+_from_rects(class, rects_sv)
+    SV *class
+    SV *rects_sv
+    INIT:
+        SV *buf= newSVpvn("", 0);
+    CODE:
+        RETVAL= _region_wrap(class, buf);
+        _region_from_rects(buf, rects_sv);
+        SvREFCNT_inc(RETVAL);
+    OUTPUT:
+        RETVAL
 
-void
-_border_width(event, value=NULL)
-  XEvent *event
-  SV *value
-  INIT:
-    int c_value= 0;
-  PPCODE:
-    if (value) { c_value= SvIV(value); }
-    switch (event->type) {
-    case ConfigureNotify:
-      if (value) { event->xconfigure.border_width = c_value; } else { c_value= event->xconfigure.border_width; } break;
-    case ConfigureRequest:
-      if (value) { event->xconfigurerequest.border_width = c_value; } else { c_value= event->xconfigurerequest.border_width; } break;
-    case CreateNotify:
-      if (value) { event->xcreatewindow.border_width = c_value; } else { c_value= event->xcreatewindow.border_width; } break;
-    default: croak("Can't access XEvent.border_width for type=%d", event->type);
-    }
-    PUSHs(value? value : sv_2mortal(newSViv(c_value)));
+SV *
+union(self, other)
+    SV *self
+    SV *other
+    ALIAS:
+        union= PerlXlib_REGION_UNION
+        intersect= PerlXlib_REGION_INTERSECT
+        subtract= PerlXlib_REGION_SUBTRACT
+    INIT:
+        PerlXlib_box *a, *b;
+        size_t na, nb;
+        SV *buf= newSVpvn("", 0);
+    CODE:
+        RETVAL= _region_wrap(self, buf);
+        a= _region_boxes(self, &na);
+        b= _region_arg(other, &nb);
+        PerlXlib_region_op(buf, a, na, b, nb, ix);
+        SvREFCNT_inc(RETVAL);
+    OUTPUT:
+        RETVAL
 
-void
-_button(event, value=NULL)
-  XEvent *event
-  SV *value
-  INIT:
-    unsigned int c_value= 0;
-  PPCODE:
-    if (value) { c_value= SvUV(value); }
-    switch (event->type) {
-    case ButtonPress:
-    case ButtonRelease:
-      if (value) { event->xbutton.button = c_value; } else { c_value= event->xbutton.button; } break;
-    default: croak("Can't access XEvent.button for type=%d", event->type);
-    }
-    PUSHs(value? value : sv_2mortal(newSVuv(c_value)));
+SV *
+translate(self, dx, dy)
+    SV *self
+    IV dx
+    IV dy
+    INIT:
+        PerlXlib_box *src, *dst;
+        size_t n, i;
+        SV *buf, *tmp;
+        Bool clipped= 0;
+    CODE:
+        src= _region_boxes(self, &n);
+        buf= newSVpvn(n? (char*) src : "", n * sizeof(PerlXlib_box));
+        RETVAL= _region_wrap(self, buf);
+        dst= (PerlXlib_box*) SvPVX(buf);
+        for (i= 0; i < n; i++) {
+            dst[i].x1= _region_shift(src[i].x1, dx); dst[i].x2= _region_shift(src[i].x2, dx);
+            dst[i].y1= _region_shift(src[i].y1, dy); dst[i].y2= _region_shift(src[i].y2, dy);
+            if ((IV) dst[i].x2 - dst[i].x1 != (IV) src[i].x2 - src[i].x1
+                || (IV) dst[i].y2 - dst[i].y1 != (IV) src[i].y2 - src[i].y1)
+                clipped= 1;
+        }
+        /* Boxes squashed against the limits might now be empty or touch, so
+         * build the region again to keep it in canonical form. */
+        if (clipped) {
+            tmp= sv_2mortal(newSVpvn(SvPVX(buf), SvCUR(buf)));
+            SvCUR_set(buf, 0);
+            PerlXlib_region_from_boxes(buf, (PerlXlib_box*) SvPVX(tmp), n);
+        }
+        SvREFCNT_inc(RETVAL);
+    OUTPUT:
+        RETVAL
 
 void
-_colormap(event, value=NULL)
-  XEvent *event
-  SV *value
-  INIT:
-    Colormap c_value= 0;
-  PPCODE:
-    if (value) { c_value= PerlXlib_sv_to_xid(value); }
-    switch (event->type) {
-    case ColormapNotify:
-      if (value) { event->xcolormap.colormap = c_value; } else { c_value= event->xcolormap.colormap; } break;
-    default: croak("Can't access XEvent.colormap for type=%d", event->type);
-    }
-    PUSHs(value? value : sv_2mortal(newSVuv(c_value)));
+bbox(self)
+    SV *self
+    INIT:
+        PerlXlib_box *boxes, bb;
+        XRectangle r;
+        size_t n, i;
+    PPCODE:
+        boxes= _region_boxes(self, &n);
+        if (n) {
+            bb= boxes[0];
+            bb.y2= boxes[n-1].y2;
+            for (i= 1; i < n; i++) {
+                if (boxes[i].x1 < bb.x1) bb.x1= boxes[i].x1;
+                if (boxes[i].x2 > bb.x2) bb.x2= boxes[i].x2;
+            }
+            _region_box_to_rect(&bb, &r);
+            PUSHs(sv_2mortal(sv_setref_pvn(newSV(0), "X11::Xlib::XRectangle", (char*) &r, sizeof(r))));
+        }
 
-void
-_cookie(event, value=NULL)
-  XEvent *event
-  SV *value
-  INIT:
-    unsigned int c_value= 0;
-  PPCODE:
-    if (value) { c_value= SvUV(value); }
-    switch (event->type) {
-    default: croak("Can't access XEvent.cookie for type=%d", event->type);
-    }
-    PUSHs(value? value : sv_2mortal(newSVuv(c_value)));
+int
+contains_point(self, x, y)
+    SV *self
+    IV x
+    IV y
+    INIT:
+        PerlXlib_box *boxes;
+        size_t n;
+    CODE:
+        boxes= _region_boxes(self, &n);
+        RETVAL= PerlXlib_region_contains_point(boxes, n, x, y);
+    OUTPUT:
+        RETVAL
 
-void
-_count(event, value=NULL)
-  XEvent *event
-  SV *value
-  INIT:
-    int c_value= 0;
-  PPCODE:
-    if (value) { c_value= SvIV(value); }
+IV
+count(self)
+    SV *self
+    ALIAS:
+        is_empty= 1
+    INIT:
+        size_t n;
+    CODE:
+        _region_boxes(self, &n);
+        RETVAL= ix? !n : n;
+    OUTPUT:
+        RETVAL
+
+int
+equal(self, other)
+    SV *self
+    SV *other
+    INIT:
+        PerlXlib_box *a, *b;
+        size_t na, nb;
+    CODE:
+        a= _region_boxes(self, &na);
+        b= _region_arg(other, &nb);
+        /* banded form is canonical, so equal regions have identical boxes */
+        RETVAL= na == nb && (!na || 0 == memcmp(a, b, na * sizeof(PerlXlib_box)));
+    OUTPUT:
+        RETVAL
+
+void
+rects(self)
+    SV *self
+    INIT:
+        PerlXlib_box *boxes;
+        XRectangle r;
+        size_t n, i;
+    PPCODE:
+        boxes= _region_boxes(self, &n);
+        EXTEND(SP, n);
+        for (i= 0; i < n; i++) {
+            _region_box_to_rect(boxes + i, &r);
+            PUSHs(sv_2mortal(sv_setref_pvn(newSV(0), "X11::Xlib::XRectangle", (char*) &r, sizeof(r))));
+        }
+
+SV *
+packed_rects(self)
+    SV *self
+    INIT:
+        PerlXlib_box *boxes;
+        XRectangle *r;
+        size_t n, i;
+    CODE:
+        boxes= _region_boxes(self, &n);
+        RETVAL= newSV(n * sizeof(XRectangle) + 1);
+        SvPOK_on(RETVAL);
+        SvCUR_set(RETVAL, n * sizeof(XRectangle));
+        r= (XRectangle*) SvPVX(RETVAL);
+        for (i= 0; i < n; i++)
+            _region_box_to_rect(boxes + i, r + i);
+    OUTPUT:
+        RETVAL
+
+SV *
+boxes(self)
+    SV *self
+    INIT:
+        PerlXlib_box *boxes;
+        size_t n, i;
+        AV *av;
+    CODE:
+        boxes= _region_boxes(self, &n);
+        av= newAV();
+        RETVAL= newRV_noinc((SV*) av);
+        if (n) av_extend(av, n-1);
+        for (i= 0; i < n; i++) {
+            AV *box= newAV();
+            av_push(box, newSViv(boxes[i].x1));
+            av_push(box, newSViv(boxes[i].y1));
+            av_push(box, newSViv(boxes[i].x2));
+            av_push(box, newSViv(boxes[i].y2));
+            av_push(av, newRV_noinc((SV*) box));
+        }
+    OUTPUT:
+        RETVAL
+
+#if defined(XFIXES_VERSION) && XFIXES_MAJOR >= 2
+
+SV *
+from_server(class, dpy, region)
+    SV *class
+    Display *dpy
+    XserverRegion region
+    INIT:
+        XRectangle *rects;
+        PerlXlib_box *boxes;
+        int nrects, i;
+        SV *buf= newSVpvn("", 0);
+    CODE:
+        RETVAL= _region_wrap(class, buf);
+        PerlXlib_ROUND_TRIP(dpy, XFixesFetchRegion, rects= XFixesFetchRegion(dpy, region, &nrects));
+        if (rects && nrects) {
+            Newx(boxes, nrects, PerlXlib_box);
+            SAVEFREEPV(boxes);
+            for (i= 0; i < nrects; i++) {
+                boxes[i].x1= rects[i].x;
+                boxes[i].y1= rects[i].y;
+                boxes[i].x2= (I32) rects[i].x + rects[i].width;
+                boxes[i].y2= (I32) rects[i].y + rects[i].height;
+            }
+            /* the server's list is already banded, but re-banding is cheap
+             * and guarantees the canonical form that 'equal' relies on */
+            PerlXlib_region_from_boxes(buf, boxes, nrects);
+        }
+        if (rects) XFree(rects);
+        SvREFCNT_inc(RETVAL);
+    OUTPUT:
+        RETVAL
+
+#endif
+
+MODULE = X11::Xlib                PACKAGE = X11::Xlib::Keymap
+
+void
+_index_load(dpy)
+    Display *dpy
+    INIT:
+        int xmin, xmax, nsym;
+        KeySym *syms;
+        XModifierKeymap *modmap;
+        SV *out;
+    PPCODE:
+        XDisplayKeycodes(dpy, &xmin, &xmax);
+        PerlXlib_ROUND_TRIP(dpy, XGetKeyboardMapping, syms= XGetKeyboardMapping(dpy, xmin, xmax-xmin+1, &nsym));
+        if (!syms)
+            croak("XGetKeyboardMapping failed");
+        PerlXlib_ROUND_TRIP(dpy, XGetModifierMapping, modmap= XGetModifierMapping(dpy));
+        if (!modmap) {
+            XFree(syms);
+            croak("XGetModifierMapping failed");
+        }
+        out= sv_2mortal(newSVpvn("", 0));
+        PerlXlib_keymap_index_build(out, syms, xmin, xmax, nsym, modmap->modifiermap, modmap->max_keypermod);
+        XFree(syms);
+        XFreeModifiermap(modmap);
+        PUSHs(out);
+
+void
+_index_load_xkb(dpy)
+    Display *dpy
+    INIT:
+        int opcode, event_base, error_base, major= XkbMajorVersion, minor= XkbMinorVersion;
+        unsigned int parts= XkbKeyTypesMask | XkbKeySymsMask | XkbModifierMapMask;
+        SV *out;
+    PPCODE:
+        if (!XkbQueryExtension(dpy, &opcode, &event_base, &error_base, &major, &minor))
+            XSRETURN_EMPTY;
+        /* select first, so no change can slip in between loading and listening */
+        XkbSelectEventDetails(dpy, XkbUseCoreKbd, XkbMapNotify, parts, parts);
+        out= sv_2mortal(newSVpvn("", 0));
+        if (!PerlXlib_keymap_index_load_xkb(dpy, out))
+            XSRETURN_EMPTY;
+        EXTEND(SP, 2);
+        PUSHs(out);
+        PUSHs(sv_2mortal(newSViv(event_base)));
+
+void
+_index_reload_xkb(dpy, types, first_sym, last_sym, first_mod, last_mod, ...)
+    Display *dpy
+    int types
+    int first_sym
+    int last_sym
+    int first_mod
+    int last_mod
+    INIT:
+        int i;
+    PPCODE:
+        /* every index after the first 6 arguments gets the same changes */
+        for (i= 6; i < items; i++)
+            _keymap_index_arg(ST(i));
+        if (!PerlXlib_keymap_index_reload_xkb(dpy, types, first_sym, last_sym, first_mod, last_mod, &ST(6), items - 6))
+            croak("Can't fetch XKB keymap changes");
+
+void
+_xkb_map_notify(event, event_base)
+    XEvent *event
+    int event_base
+    INIT:
+        XkbMapNotifyEvent *mn= (XkbMapNotifyEvent*) event;
+    PPCODE:
+        /* (types_changed, first_sym, last_sym, first_mod, last_mod), or empty */
+        if (event->type != event_base || mn->xkb_type != XkbMapNotify)
+            XSRETURN_EMPTY;
+        EXTEND(SP, 5);
+        PUSHs(sv_2mortal(newSViv(mn->changed & XkbKeyTypesMask? 1 : 0)));
+        if (mn->changed & XkbKeySymsMask) {
+            PUSHs(sv_2mortal(newSViv(mn->first_key_sym)));
+            PUSHs(sv_2mortal(newSViv(mn->first_key_sym + mn->num_key_syms - 1)));
+        } else {
+            PUSHs(sv_2mortal(newSViv(1)));
+            PUSHs(sv_2mortal(newSViv(0)));
+        }
+        if (mn->changed & XkbModifierMapMask) {
+            PUSHs(sv_2mortal(newSViv(mn->first_modmap_key)));
+            PUSHs(sv_2mortal(newSViv(mn->first_modmap_key + mn->num_modmap_keys - 1)));
+        } else {
+            PUSHs(sv_2mortal(newSViv(1)));
+            PUSHs(sv_2mortal(newSViv(0)));
+        }
+
+void
+_index_set_xkb(idx, section)
+    SV *idx
+    SV *section
+    INIT:
+        const char *p;
+        STRLEN len;
+        const PerlXlib_keymap_xkb *xkb;
+    PPCODE:
+        _keymap_index_arg(idx);
+        p= SvPVbyte(section, len);
+        xkb= (const PerlXlib_keymap_xkb*) p;
+        if (len && (len < sizeof(*xkb) || len != sizeof(*xkb) + xkb->ntypes * sizeof(PerlXlib_keymap_xkb_type)
+            + xkb->nentries * sizeof(PerlXlib_keymap_xkb_entry)))
+            croak("Wrong length for XKB section");
+        PerlXlib_keymap_index_attach_xkb(idx, p, len);
+
+void
+_index_reload(dpy, minkey, maxkey, ...)
+    Display *dpy
+    int minkey
+    int maxkey
+    INIT:
+        int xmin, xmax, nsym, i;
+        KeySym *syms;
+    PPCODE:
+        /* every index after the first 3 arguments gets the same rows */
+        for (i= 3; i < items; i++)
+            _keymap_index_arg(ST(i));
+        XDisplayKeycodes(dpy, &xmin, &xmax);
+        if (xmin < minkey) xmin= minkey;
+        if (xmax > maxkey) xmax= maxkey;
+        if (xmin <= xmax) {
+            PerlXlib_ROUND_TRIP(dpy, XGetKeyboardMapping, syms= XGetKeyboardMapping(dpy, xmin, xmax-xmin+1, &nsym));
+            if (!syms)
+                croak("XGetKeyboardMapping failed");
+            for (i= 3; i < items; i++)
+                PerlXlib_keymap_index_update(ST(i), syms, xmin, xmax-xmin+1, nsym);
+            XFree(syms);
+        }
+
+void
+_index_update(idx, first_keycode, kmap)
+    SV *idx
+    int first_keycode
+    AV *kmap
+    INIT:
+        KeySym *syms;
+        int nsym, count= av_len(kmap) + 1;
+    PPCODE:
+        _keymap_index_arg(idx);
+        if (count > 0) {
+            syms= _keymap_av_syms(kmap, 0, count, first_keycode, &nsym);
+            PerlXlib_keymap_index_update(idx, syms, first_keycode, count, nsym);
+        }
+
+void
+_index_reload_modmap(dpy, ...)
+    Display *dpy
+    INIT:
+        XModifierKeymap *modmap;
+        int i;
+    PPCODE:
+        for (i= 1; i < items; i++)
+            _keymap_index_arg(ST(i));
+        PerlXlib_ROUND_TRIP(dpy, XGetModifierMapping, modmap= XGetModifierMapping(dpy));
+        if (!modmap)
+            croak("XGetModifierMapping failed");
+        for (i= 1; i < items; i++)
+            PerlXlib_keymap_index_set_modmap(ST(i), modmap->modifiermap, modmap->max_keypermod);
+        XFreeModifiermap(modmap);
+
+void
+_index_set_modmap(idx, mmap)
+    SV *idx
+    AV *mmap
+    INIT:
+        KeyCode keycodes[64];
+        int max_keypermod;
+    PPCODE:
+        _keymap_index_arg(idx);
+        max_keypermod= _keymap_av_modmap(mmap, keycodes);
+        PerlXlib_keymap_index_set_modmap(idx, keycodes, max_keypermod);
+
+void
+_index_diff(idx_a, idx_b, minkey=0, maxkey=255, gap=KEYMAP_SAVE_MERGE_GAP)
+    SV *idx_a
+    SV *idx_b
+    int minkey
+    int maxkey
+    int gap
+    INIT:
+        int ranges[512], n, i;
+        AV *pair;
+    PPCODE:
+        n= PerlXlib_keymap_index_diff(_keymap_index_arg(idx_a), _keymap_index_arg(idx_b), minkey, maxkey, gap, ranges);
+        EXTEND(SP, n);
+        for (i= 0; i < n; i++) {
+            pair= newAV();
+            av_push(pair, newSViv(ranges[i*2]));
+            av_push(pair, newSViv(ranges[i*2+1]));
+            PUSHs(sv_2mortal(newRV_noinc((SV*) pair)));
+        }
+
+int
+_index_save(dpy, idx, server_idx, minkey=0, maxkey=255)
+    Display *dpy
+    SV *idx
+    SV *server_idx
+    int minkey
+    int maxkey
+    INIT:
+        PerlXlib_keymap_index *ki= _keymap_index_arg(idx), *srv= _keymap_index_arg(server_idx);
+        int ranges[512], n, i, first, count;
+        const KeySym *rows;
+    CODE:
+        /* only keycodes the server has, and the new keymap describes */
+        if (minkey < srv->min_keycode) minkey= srv->min_keycode;
+        if (minkey < ki->min_keycode)  minkey= ki->min_keycode;
+        if (maxkey > srv->max_keycode) maxkey= srv->max_keycode;
+        if (maxkey > ki->max_keycode)  maxkey= ki->max_keycode;
+        n= PerlXlib_keymap_index_diff(ki, srv, minkey, maxkey, KEYMAP_SAVE_MERGE_GAP, ranges);
+        for (i= 0; i < n; i++) {
+            first= ranges[i*2];
+            count= ranges[i*2+1] - first + 1;
+            rows= PerlXlib_keymap_index_rows(ki, first);
+            XChangeKeyboardMapping(dpy, first, ki->nsym, (KeySym*) rows, count);
+            /* the server now has these rows */
+            PerlXlib_keymap_index_update(server_idx, rows, first, count, ki->nsym);
+        }
+        RETVAL= n;
+    OUTPUT:
+        RETVAL
+
+void
+_index_spare_keycodes(idx)
+    SV *idx
+    INIT:
+        KeyCode keycodes[256];
+        int n, i;
+    PPCODE:
+        n= PerlXlib_keymap_index_spare_keycodes(_keymap_index_arg(idx), keycodes);
+        EXTEND(SP, n);
+        for (i= 0; i < n; i++)
+            PUSHs(sv_2mortal(newSViv(keycodes[i])));
+
+void
+_type_plan(idx, str, spare= &PL_sv_undef)
+    SV *idx
+    SV *str
+    SV *spare
+    INIT:
+        static const char *op_names[]= { "", "press", "release", "remap", "restore", "sync" };
+        static const char *wait_names[]= { "", "delay", "hold" };
+        PerlXlib_key_step *steps;
+        int nsteps, nchars, i;
+        AV *step;
+    PPCODE:
+        steps= _keymap_type_plan(idx, str, spare, &nsteps, &nchars);
+        EXTEND(SP, nsteps);
+        for (i= 0; i < nsteps; i++) {
+            step= newAV();
+            av_push(step, newSVpv(op_names[steps[i].op], 0));
+            av_push(step, newSViv(steps[i].keycode));
+            if (steps[i].op == PerlXlib_KEY_REMAP)
+                av_push(step, newSVuv(steps[i].sym));
+            else if (steps[i].wait)
+                av_push(step, newSVpv(wait_names[steps[i].wait], 0));
+            PUSHs(sv_2mortal(newRV_noinc((SV*) step)));
+        }
+
+int
+_type_text(dpy, idx, str, spare= &PL_sv_undef, delay= 0, hold= 0, settle= 50)
+    Display *dpy
+    SV *idx
+    SV *str
+    SV *spare
+    int delay
+    int hold
+    int settle
+    INIT:
+        PerlXlib_keymap_index *ki= _keymap_index_arg(idx);
+        PerlXlib_key_step *steps;
+        KeySym remap[2];
+        int nsteps, nchars, i, wait;
+    CODE:
+        steps= _keymap_type_plan(idx, str, spare, &nsteps, &nchars);
+        for (i= 0; i < nsteps; i++) {
+            /* XTest delays are applied by the server, so everything up to a
+             * sync can be sent at once */
+            wait= steps[i].wait == PerlXlib_KEY_WAIT_DELAY? delay
+                : steps[i].wait == PerlXlib_KEY_WAIT_HOLD? hold
+                : 0;
+            switch (steps[i].op) {
+            case PerlXlib_KEY_PRESS:
+            case PerlXlib_KEY_RELEASE:
+                XTestFakeKeyEvent(dpy, steps[i].keycode, steps[i].op == PerlXlib_KEY_PRESS, wait);
+                break;
+            case PerlXlib_KEY_REMAP:
+                remap[0]= remap[1]= steps[i].sym;
+                XChangeKeyboardMapping(dpy, steps[i].keycode, 2, remap, 1);
+                break;
+            case PerlXlib_KEY_RESTORE:
+                XChangeKeyboardMapping(dpy, steps[i].keycode, ki->nsym,
+                    (KeySym*) PerlXlib_keymap_index_rows(ki, steps[i].keycode), 1);
+                break;
+            case PerlXlib_KEY_SYNC:
+                /* XSync returns once the server has generated the (delayed)
+                 * events, then give clients time to read them before the
+                 * MappingNotify of the next remap makes them fetch the keymap */
+                PerlXlib_ROUND_TRIP(dpy, XSync, XSync(dpy, False));
+                if (settle > 0)
+                    PerlXlib_sleep_ms(settle);
+                break;
+            }
+        }
+        XFlush(dpy);
+        RETVAL= nchars;
+    OUTPUT:
+        RETVAL
+
+void
+_index_from_tables(kmap, mmap)
+    AV *kmap
+    AV *mmap
+    INIT:
+        int kmin= -1, kmax= -1, nsym, max_keypermod, i;
+        KeySym *syms;
+        KeyCode keycodes[64];
+        SV **elem, *out;
+    PPCODE:
+        /* rows that aren't arrayrefs are keycodes the server doesn't use */
+        for (i= 0; i <= av_len(kmap) && i < 256; i++) {
+            elem= av_fetch(kmap, i, 0);
+            if (!elem || !*elem || !SvROK(*elem) || SvTYPE(SvRV(*elem)) != SVt_PVAV)
+                continue;
+            if (kmin < 0) kmin= i;
+            kmax= i;
+        }
+        if (kmin < 0) kmin= 1, kmax= 0;
+        syms= _keymap_av_syms(kmap, kmin, kmax - kmin + 1, kmin, &nsym);
+        max_keypermod= _keymap_av_modmap(mmap, keycodes);
+        out= sv_2mortal(newSVpvn("", 0));
+        PerlXlib_keymap_index_build(out, syms, kmin, kmax, nsym, keycodes, max_keypermod);
+        PUSHs(out);
+
+void
+_index_keymap(idx, symbolic=2, minkey=0, maxkey=255)
+    SV *idx
+    int symbolic
+    int minkey
+    int maxkey
+    INIT:
+        PerlXlib_keymap_index *ki= _keymap_index_arg(idx);
+        int xmin= ki->min_keycode < minkey? minkey : ki->min_keycode;
+        int xmax= ki->max_keycode > maxkey? maxkey : ki->max_keycode;
+        KeySym sym;
+        AV *tbl, *row;
+        SV *sv;
+        int i, j;
+    PPCODE:
+        /* same layout as load_keymap: element 0 is keycode minkey */
+        tbl= newAV();
+        PUSHs(sv_2mortal(newRV_noinc((SV*) tbl)));
+        if (xmax >= xmin) {
+            av_extend(tbl, xmax - minkey);
+            for (i= minkey; i < xmin; i++)
+                av_push(tbl, newSVsv(&PL_sv_undef));
+            for (i= xmin; i <= xmax; i++) {
+                row= newAV();
+                av_push(tbl, newRV_noinc((SV*) row));
+                for (j= 0; j < ki->nsym; j++) {
+                    if ((sym= PerlXlib_keymap_index_get(ki, i, j)) != NoSymbol) {
+                        if (!(sv= PerlXlib_keysym_to_sv(sym, symbolic)))
+                            croak("Your keymap includes KeySym 0x%x that can't be un-ambiguously represented by a string", (unsigned) sym);
+                        av_store(row, j, sv);
+                    }
+                }
+            }
+        }
+
+void
+_index_modmap(idx)
+    SV *idx
+    INIT:
+        PerlXlib_keymap_index *ki= _keymap_index_arg(idx);
+        const KeyCode *codes= PerlXlib_keymap_index_modmap(ki);
+        AV *tbl, *row;
+        int i, j;
+    PPCODE:
+        tbl= newAV();
+        PUSHs(sv_2mortal(newRV_noinc((SV*) tbl)));
+        av_extend(tbl, 8);
+        for (i= 0; i < 8; i++) {
+            row= newAV();
+            av_extend(row, ki->max_keypermod);
+            for (j= 0; j < ki->max_keypermod; j++)
+                av_push(row, newSViv(codes[i * ki->max_keypermod + j]));
+            av_push(tbl, newRV_noinc((SV*) row));
+        }
+
+void
+_find_key(idx, sym_sv)
+    SV *idx
+    SV *sym_sv
+    INIT:
+        PerlXlib_keymap_index *ki= _keymap_index_arg(idx);
+        int keycode, level= 0;
+    PPCODE:
+        keycode= PerlXlib_keymap_index_find_keycode(ki, PerlXlib_sv_to_keysym(sym_sv), &level);
+        if (!keycode) {
+            if (GIMME_V == G_ARRAY) XSRETURN_EMPTY;
+            XSRETURN_UNDEF;
+        }
+        PUSHs(sv_2mortal(newSViv(keycode)));
+        if (GIMME_V == G_ARRAY) {
+            EXTEND(SP, 3);
+            keycode= PerlXlib_keymap_index_key_mods(ki, keycode, level);
+            PUSHs(keycode < 0? &PL_sv_undef : sv_2mortal(newSViv(keycode)));
+            PUSHs(sv_2mortal(newSViv(level)));
+        }
+
+void
+_find_keysym(idx, keycode, modifiers, symbolic=2)
+    SV *idx
+    int keycode
+    unsigned int modifiers
+    int symbolic
+    INIT:
+        PerlXlib_keymap_index *ki= _keymap_index_arg(idx);
+    PPCODE:
+        PUSHs(_keymap_sym_sv(PerlXlib_keymap_index_find_keysym(ki, keycode, modifiers), symbolic));
+
+void
+_xkb_keysym(idx, keycode, group, level, symbolic=2)
+    SV *idx
+    int keycode
+    int group
+    int level
+    int symbolic
+    INIT:
+        PerlXlib_keymap_index *ki= _keymap_index_arg(idx);
+    PPCODE:
+        PUSHs(_keymap_sym_sv(PerlXlib_keymap_xkb_keysym(ki, keycode, group, level), symbolic));
+
+int
+_index_has_xkb(idx)
+    SV *idx
+    CODE:
+        RETVAL= _keymap_index_arg(idx)->xkb_off != 0;
+    OUTPUT:
+        RETVAL
+
+MODULE = X11::Xlib                PACKAGE = X11::Xlib::StructArray
+
+void
+_new(class, type_name)
+    SV *class
+    const char *type_name
+    INIT:
+        const PerlXlib_struct_type *type= PerlXlib_find_struct_type(type_name);
+    PPCODE:
+        if (!type)
+            croak("No struct type %s for X11::Xlib::StructArray", type_name);
+        PUSHs(PerlXlib_new_struct_array(type, sv_isobject(class)? sv_reftype(SvRV(class), 1) : SvPV_nolen(class), 0));
+
+void
+elem_class(self)
+    SV *self
+    ALIAS:
+        elem_size= 1
+        count= 2
+        capacity= 3
+    INIT:
+        PerlXlib_struct_array *arr= PerlXlib_get_struct_array_info(self, PerlXlib_OR_DIE);
+        SV *buf= SvRV(self);
+    PPCODE:
+        PUSHs(ix == 0? sv_2mortal(newSVpv(arr->type->pkg, 0))
+            : sv_2mortal(newSViv(
+                ix == 1? arr->type->size
+                : ix == 2? SvCUR(buf) / arr->type->size
+                : (SvLEN(buf) - X11_Xlib_Struct_Padding) / arr->type->size
+            )));
+
+void
+reserve(self, count)
+    SV *self
+    IV count
+    INIT:
+        PerlXlib_struct_array *arr= PerlXlib_get_struct_array_info(self, PerlXlib_OR_DIE);
+        SV *buf= SvRV(self);
+        size_t n= SvCUR(buf) / arr->type->size;
+    PPCODE:
+        if (count > 0 && (size_t) count > n) {
+            PerlXlib_struct_array_resize(self, count);
+            PerlXlib_struct_array_resize(self, n);
+        }
+        PUSHs(self);
+
+void
+elem(self, idx)
+    SV *self
+    IV idx
+    ALIAS:
+        get= 1
+    INIT:
+        PerlXlib_struct_array *arr= PerlXlib_get_struct_array_info(self, PerlXlib_OR_DIE);
+        IV n= SvCUR(SvRV(self)) / arr->type->size;
+    PPCODE:
+        if (idx < 0) idx += n;
+        if (idx < 0 || idx >= n)
+            croak("Index out of bounds for X11::Xlib::StructArray of %ld", (long) n);
+        PUSHs(PerlXlib_struct_array_elem_obj(self, idx, ix == 0));
+
+void
+set(self, idx, value)
+    SV *self
+    IV idx
+    SV *value
+    INIT:
+        PerlXlib_struct_array *arr= PerlXlib_get_struct_array_info(self, PerlXlib_OR_DIE);
+        IV n= SvCUR(SvRV(self)) / arr->type->size;
+    PPCODE:
+        if (idx < 0) idx += n;
+        if (idx < 0 || idx >= n)
+            croak("Index out of bounds for X11::Xlib::StructArray of %ld", (long) n);
+        PerlXlib_struct_array_store(self, idx, &value, 1);
+        PUSHs(self);
+
+void
+push(self, ...)
+    SV *self
+    INIT:
+        PerlXlib_struct_array *arr= PerlXlib_get_struct_array_info(self, PerlXlib_OR_DIE);
+        size_t n= SvCUR(SvRV(self)) / arr->type->size;
+    PPCODE:
+        if (items > 1) {
+            PerlXlib_struct_array_resize(self, n + items - 1);
+            PerlXlib_struct_array_store(self, n, &ST(1), items - 1);
+        }
+        PUSHs(sv_2mortal(newSViv(n + items - 1)));
+
+void
+splice(self, offset, length_sv= &PL_sv_undef, ...)
+    SV *self
+    IV offset
+    SV *length_sv
+    ALIAS:
+        slice= 1
+    INIT:
+        PerlXlib_struct_array *arr= PerlXlib_get_struct_array_info(self, PerlXlib_OR_DIE);
+        size_t size= arr->type->size;
+        IV n= SvCUR(SvRV(self)) / size, len, n_ins= items > 3? items - 3 : 0;
+        SV *ret;
+        char *buf;
+    PPCODE:
+        if (offset < 0) offset += n;
+        if (offset < 0 || offset > n)
+            croak("Offset out of bounds for X11::Xlib::StructArray of %ld", (long) n);
+        len= SvOK(length_sv)? SvIV(length_sv) : n - offset;
+        if (len < 0) len += n - offset;
+        if (len < 0) len= 0;
+        if (len > n - offset) len= n - offset;
+        if (ix == 1 && n_ins)
+            croak("Too many arguments for slice");
+        /* the removed (or sliced) elements become a new array of the same type and class */
+        ret= PerlXlib_new_struct_array(arr->type, sv_reftype(SvRV(self), 1), len);
+        memcpy(SvPVX(SvRV(ret)), SvPVX(SvRV(self)) + offset * size, len * size);
+        if (ix == 0 && (len || n_ins)) {
+            if (n_ins > len)
+                PerlXlib_struct_array_resize(self, n - len + n_ins);
+            buf= SvPVX(SvRV(self));
+            memmove(buf + (offset + n_ins) * size, buf + (offset + len) * size, (n - offset - len) * size);
+            if (n_ins <= len)
+                PerlXlib_struct_array_resize(self, n - len + n_ins);
+            PerlXlib_struct_array_store(self, offset, &ST(3), n_ins);
+        }
+        PUSHs(ret);
+
+MODULE = X11::Xlib                PACKAGE = X11::Xlib::Opaque
+
+void
+display(self, dpy_sv= NULL)
+    SV *self
+    SV *dpy_sv
+    PPCODE:
+        if (dpy_sv)
+            PerlXlib_objref_set_display(self, dpy_sv);
+        else
+            dpy_sv= PerlXlib_objref_get_display(self);
+        PUSHs(sv_mortalcopy(dpy_sv));
+
+void
+pointer_int(self)
+    SV *self
+    INIT:
+        void *opaque= PerlXlib_objref_get_pointer(self, NULL, PerlXlib_OR_NULL);
+    PPCODE:
+        PUSHs(sv_2mortal(newSVuv(PTR2UV(opaque))));
+
+void
+pointer_bytes(self)
+    SV *self
+    INIT:
+        void *opaque= PerlXlib_objref_get_pointer(self, NULL, PerlXlib_OR_NULL);
+    PPCODE:
+        PUSHs(sv_2mortal(newSVpvn((void*) &opaque, sizeof(opaque))));
+
+MODULE = X11::Xlib                PACKAGE = X11::Xlib::Visual
+
+int
+id(visual)
+    Visual *visual
+    CODE:
+        RETVAL = XVisualIDFromVisual(visual);
+    OUTPUT:
+        RETVAL
+
+#ifdef HAVE_XDAMAGE
+
+MODULE = X11::Xlib                PACKAGE = X11::Xlib::XDamageNotifyEvent
+
+void
+drawable(event, value=NULL)
+    XEvent *event
+    SV *value
+    ALIAS:
+        damage = 1
+    INIT:
+        XDamageNotifyEvent *s= _damage_event(event);
+        XID *field= ix == 0? &s->drawable : &s->damage;
+    PPCODE:
+        if (value) *field= PerlXlib_sv_to_xid(value);
+        PUSHs(value? value : sv_2mortal(newSVuv(*field)));
+
+void
+level(event, value=NULL)
+    XEvent *event
+    SV *value
+    INIT:
+        XDamageNotifyEvent *s= _damage_event(event);
+    PPCODE:
+        if (value) s->level= SvIV(value);
+        PUSHs(value? value : sv_2mortal(newSViv(s->level)));
+
+void
+more(event, value=NULL)
+    XEvent *event
+    SV *value
+    INIT:
+        XDamageNotifyEvent *s= _damage_event(event);
+    PPCODE:
+        if (value) s->more= SvTRUE(value);
+        PUSHs(value? value : sv_2mortal(newSViv(s->more)));
+
+void
+timestamp(event, value=NULL)
+    XEvent *event
+    SV *value
+    INIT:
+        XDamageNotifyEvent *s= _damage_event(event);
+    PPCODE:
+        if (value) s->timestamp= SvUV(value);
+        PUSHs(value? value : sv_2mortal(newSVuv(s->timestamp)));
+
+void
+area(event, value=NULL)
+    XEvent *event
+    SV *value
+    ALIAS:
+        geometry = 1
+    INIT:
+        XDamageNotifyEvent *s= _damage_event(event);
+        XRectangle *field= ix == 0? &s->area : &s->geometry;
+    PPCODE:
+        if (value)
+            *field= *(XRectangle*) PerlXlib_get_struct_ptr(value, 0, "X11::Xlib::XRectangle",
+                sizeof(XRectangle), (PerlXlib_struct_pack_fn*) &PerlXlib_XRectangle_pack);
+        PUSHs(value? value : sv_2mortal(
+            sv_setref_pvn(newSV(0), "X11::Xlib::XRectangle", (char*) field, sizeof(XRectangle))
+        ));
+
+#endif /* HAVE_XDAMAGE */
+
+MODULE = X11::Xlib                PACKAGE = X11::Xlib::XEvent
+
+# ----------------------------------------------------------------------------
+# BEGIN GENERATED X11_Xlib_XEvent
+void
+_initialize(s)
+    SV *s
+    INIT:
+        void *sptr;
+    PPCODE:
+        sptr= PerlXlib_get_struct_ptr(s, 1, "X11::Xlib::XEvent", sizeof(XEvent),
+            (PerlXlib_struct_pack_fn*) &PerlXlib_XEvent_pack
+        );
+        memset((void*) sptr, 0, sizeof(XEvent));
+
+int
+_sizeof(ignored)
+    SV *ignored
+    CODE:
+        RETVAL = sizeof(XEvent);
+    OUTPUT:
+        RETVAL
+
+void
+_pack(e, fields, consume)
+    XEvent *e
+    HV *fields
+    Bool consume
+    INIT:
+        const char *oldpkg, *newpkg;
+    PPCODE:
+        oldpkg= PerlXlib_xevent_pkg_for_event(e);
+        PerlXlib_XEvent_pack(e, fields, consume);
+        newpkg= PerlXlib_xevent_pkg_for_event(e);
+        /* re-bless the object if the thing passed to us was actually an object */
+        if (oldpkg != newpkg && sv_derived_from(ST(0), "X11::Xlib::XEvent"))
+            sv_bless(ST(0), gv_stashpv(newpkg, GV_ADD));
+
+void
+_unpack(e, fields)
+    XEvent *e
+    HV *fields
+    PPCODE:
+        PerlXlib_XEvent_unpack(e, fields);
+
+void
+_above(event, value=NULL)
+  XEvent *event
+  SV *value
+  INIT:
+    Window c_value= 0;
+  PPCODE:
+    if (value) { c_value= PerlXlib_sv_to_xid(value); }
+    switch (event->type) {
+    case ConfigureNotify:
+      if (value) { event->xconfigure.above = c_value; } else { c_value= event->xconfigure.above; } break;
+    case ConfigureRequest:
+      if (value) { event->xconfigurerequest.above = c_value; } else { c_value= event->xconfigurerequest.above; } break;
+    default: croak("Can't access XEvent.above for type=%d", event->type);
+    }
+    PUSHs(value? value : sv_2mortal(newSVuv(c_value)));
+
+void
+_atom(event, value=NULL)
+  XEvent *event
+  SV *value
+  INIT:
+    Atom c_value= 0;
+  PPCODE:
+    if (value) { c_value= PerlXlib_sv_to_xid(value); }
+    switch (event->type) {
+    case PropertyNotify:
+      if (value) { event->xproperty.atom = c_value; } else { c_value= event->xproperty.atom; } break;
+    default: croak("Can't access XEvent.atom for type=%d", event->type);
+    }
+    PUSHs(value? value : sv_2mortal(newSVuv(c_value)));
+
+void
+_b(event, value=NULL)
+  XEvent *event
+  SV *value
+  PPCODE:
+    switch (event->type) {
+    case ClientMessage:
+      if (value) { { if (!SvPOK(value) || SvCUR(value) != sizeof(char)*20)  croak("Expected scalar of length %ld but got %ld", (long)(sizeof(char)*20), (long) SvCUR(value)); memcpy(event->xclient.data.b, SvPVX(value), sizeof(char)*20);} } else { PUSHs(sv_2mortal(newSVpvn((void*)event->xclient.data.b, sizeof(char)*20))); } break;
+    default: croak("Can't access XEvent.b for type=%d", event->type);
+    }
+
+void
+_border_width(event, value=NULL)
+  XEvent *event
+  SV *value
+  INIT:
+    int c_value= 0;
+  PPCODE:
+    if (value) { c_value= SvIV(value); }
+    switch (event->type) {
+    case ConfigureNotify:
+      if (value) { event->xconfigure.border_width = c_value; } else { c_value= event->xconfigure.border_width; } break;
+    case ConfigureRequest:
+      if (value) { event->xconfigurerequest.border_width = c_value; } else { c_value= event->xconfigurerequest.border_width; } break;
+    case CreateNotify:
+      if (value) { event->xcreatewindow.border_width = c_value; } else { c_value= event->xcreatewindow.border_width; } break;
+    default: croak("Can't access XEvent.border_width for type=%d", event->type);
+    }
+    PUSHs(value? value : sv_2mortal(newSViv(c_value)));
+
+void
+_button(event, value=NULL)
+  XEvent *event
+  SV *value
+  INIT:
+    unsigned int c_value= 0;
+  PPCODE:
+    if (value) { c_value= SvUV(value); }
+    switch (event->type) {
+    case ButtonPress:
+    case ButtonRelease:
+      if (value) { event->xbutton.button = c_value; } else { c_value= event->xbutton.button; } break;
+    default: croak("Can't access XEvent.button for type=%d", event->type);
+    }
+    PUSHs(value? value : sv_2mortal(newSVuv(c_value)));
+
+void
+_colormap(event, value=NULL)
+  XEvent *event
+  SV *value
+  INIT:
+    Colormap c_value= 0;
+  PPCODE:
+    if (value) { c_value= PerlXlib_sv_to_xid(value); }
+    switch (event->type) {
+    case ColormapNotify:
+      if (value) { event->xcolormap.colormap = c_value; } else { c_value= event->xcolormap.colormap; } break;
+    default: croak("Can't access XEvent.colormap for type=%d", event->type);
+    }
+    PUSHs(value? value : sv_2mortal(newSVuv(c_value)));
+
+void
+_cookie(event, value=NULL)
+  XEvent *event
+  SV *value
+  INIT:
+    unsigned int c_value= 0;
+  PPCODE:
+    if (value) { c_value= SvUV(value); }
+    switch (event->type) {
+    default: croak("Can't access XEvent.cookie for type=%d", event->type);
+    }
+    PUSHs(value? value : sv_2mortal(newSVuv(c_value)));
+
+void
+_count(event, value=NULL)
+  XEvent *event
+  SV *value
+  INIT:
+    int c_value= 0;
+  PPCODE:
+    if (value) { c_value= SvIV(value); }
+    switch (event->type) {
+    case Expose:
+      if (value) { event->xexpose.count = c_value; } else { c_value= event->xexpose.count; } break;
+    case GraphicsExpose:
+      if (value) { event->xgraphicsexpose.count = c_value; } else { c_value= event->xgraphicsexpose.count; } break;
+    case MappingNotify:
+      if (value) { event->xmapping.count = c_value; } else { c_value= event->xmapping.count; } break;
+    default: croak("Can't access XEvent.count for type=%d", event->type);
+    }
+    PUSHs(value? value : sv_2mortal(newSViv(c_value)));
+
+void
+_detail(event, value=NULL)
+  XEvent *event
+  SV *value
+  INIT:
+    int c_value= 0;
+  PPCODE:
+    if (value) { c_value= SvIV(value); }
+    switch (event->type) {
+    case ConfigureRequest:
+      if (value) { event->xconfigurerequest.detail = c_value; } else { c_value= event->xconfigurerequest.detail; } break;
+    case EnterNotify:
+    case LeaveNotify:
+      if (value) { event->xcrossing.detail = c_value; } else { c_value= event->xcrossing.detail; } break;
+    case FocusIn:
+    case FocusOut:
+      if (value) { event->xfocus.detail = c_value; } else { c_value= event->xfocus.detail; } break;
+    default: croak("Can't access XEvent.detail for type=%d", event->type);
+    }
+    PUSHs(value? value : sv_2mortal(newSViv(c_value)));
+
+void
+display(event, value=NULL)
+  XEvent *event
+  SV *value
+  PPCODE:
+    if (value) {
+      if (event->type) event->xany.display= PerlXlib_display_objref_get_pointer(value, PerlXlib_OR_NULL); else event->xerror.display= PerlXlib_display_objref_get_pointer(value, PerlXlib_OR_NULL);
+      PUSHs(value);
+    } else {
+      PUSHs(sv_2mortal(newSVsv(PerlXlib_get_display_objref((event->type? event->xany.display : event->xerror.display), PerlXlib_AUTOCREATE))));
+    }
+
+void
+_drawable(event, value=NULL)
+  XEvent *event
+  SV *value
+  INIT:
+    Drawable c_value= 0;
+  PPCODE:
+    if (value) { c_value= PerlXlib_sv_to_xid(value); }
+    switch (event->type) {
+    case GraphicsExpose:
+      if (value) { event->xgraphicsexpose.drawable = c_value; } else { c_value= event->xgraphicsexpose.drawable; } break;
+    case NoExpose:
+      if (value) { event->xnoexpose.drawable = c_value; } else { c_value= event->xnoexpose.drawable; } break;
+    default: croak("Can't access XEvent.drawable for type=%d", event->type);
+    }
+    PUSHs(value? value : sv_2mortal(newSVuv(c_value)));
+
+void
+_error_code(event, value=NULL)
+  XEvent *event
+  SV *value
+  INIT:
+    unsigned char c_value= 0;
+  PPCODE:
+    if (value) { c_value= SvUV(value); }
+    switch (event->type) {
+    case 0:
+      if (value) { event->xerror.error_code = c_value; } else { c_value= event->xerror.error_code; } break;
+    default: croak("Can't access XEvent.error_code for type=%d", event->type);
+    }
+    PUSHs(value? value : sv_2mortal(newSVuv(c_value)));
+
+void
+_event(event, value=NULL)
+  XEvent *event
+  SV *value
+  INIT:
+    Window c_value= 0;
+  PPCODE:
+    if (value) { c_value= PerlXlib_sv_to_xid(value); }
+    switch (event->type) {
+    case CirculateNotify:
+      if (value) { event->xcirculate.event = c_value; } else { c_value= event->xcirculate.event; } break;
+    case ConfigureNotify:
+      if (value) { event->xconfigure.event = c_value; } else { c_value= event->xconfigure.event; } break;
+    case DestroyNotify:
+      if (value) { event->xdestroywindow.event = c_value; } else { c_value= event->xdestroywindow.event; } break;
+    case GravityNotify:
+      if (value) { event->xgravity.event = c_value; } else { c_value= event->xgravity.event; } break;
+    case MapNotify:
+      if (value) { event->xmap.event = c_value; } else { c_value= event->xmap.event; } break;
+    case ReparentNotify:
+      if (value) { event->xreparent.event = c_value; } else { c_value= event->xreparent.event; } break;
+    case UnmapNotify:
+      if (value) { event->xunmap.event = c_value; } else { c_value= event->xunmap.event; } break;
+    default: croak("Can't access XEvent.event for type=%d", event->type);
+    }
+    PUSHs(value? value : sv_2mortal(newSVuv(c_value)));
+
+void
+_evtype(event, value=NULL)
+  XEvent *event
+  SV *value
+  INIT:
+    int c_value= 0;
+  PPCODE:
+    if (value) { c_value= SvIV(value); }
+    switch (event->type) {
+    case GenericEvent:
+      if (value) { event->xgeneric.evtype = c_value; } else { c_value= event->xgeneric.evtype; } break;
+    default: croak("Can't access XEvent.evtype for type=%d", event->type);
+    }
+    PUSHs(value? value : sv_2mortal(newSViv(c_value)));
+
+void
+_extension(event, value=NULL)
+  XEvent *event
+  SV *value
+  INIT:
+    int c_value= 0;
+  PPCODE:
+    if (value) { c_value= SvIV(value); }
+    switch (event->type) {
+    case GenericEvent:
+      if (value) { event->xgeneric.extension = c_value; } else { c_value= event->xgeneric.extension; } break;
+    default: croak("Can't access XEvent.extension for type=%d", event->type);
+    }
+    PUSHs(value? value : sv_2mortal(newSViv(c_value)));
+
+void
+_first_keycode(event, value=NULL)
+  XEvent *event
+  SV *value
+  INIT:
+    int c_value= 0;
+  PPCODE:
+    if (value) { c_value= SvIV(value); }
+    switch (event->type) {
+    case MappingNotify:
+      if (value) { event->xmapping.first_keycode = c_value; } else { c_value= event->xmapping.first_keycode; } break;
+    default: croak("Can't access XEvent.first_keycode for type=%d", event->type);
+    }
+    PUSHs(value? value : sv_2mortal(newSViv(c_value)));
+
+void
+_focus(event, value=NULL)
+  XEvent *event
+  SV *value
+  INIT:
+    Bool c_value= 0;
+  PPCODE:
+    if (value) { c_value= SvIV(value); }
+    switch (event->type) {
+    case EnterNotify:
+    case LeaveNotify:
+      if (value) { event->xcrossing.focus = c_value; } else { c_value= event->xcrossing.focus; } break;
+    default: croak("Can't access XEvent.focus for type=%d", event->type);
+    }
+    PUSHs(value? value : sv_2mortal(newSViv(c_value)));
+
+void
+_format(event, value=NULL)
+  XEvent *event
+  SV *value
+  INIT:
+    int c_value= 0;
+  PPCODE:
+    if (value) { c_value= SvIV(value); }
+    switch (event->type) {
+    case ClientMessage:
+      if (value) { event->xclient.format = c_value; } else { c_value= event->xclient.format; } break;
+    default: croak("Can't access XEvent.format for type=%d", event->type);
+    }
+    PUSHs(value? value : sv_2mortal(newSViv(c_value)));
+
+void
+_from_configure(event, value=NULL)
+  XEvent *event
+  SV *value
+  INIT:
+    Bool c_value= 0;
+  PPCODE:
+    if (value) { c_value= SvIV(value); }
+    switch (event->type) {
+    case UnmapNotify:
+      if (value) { event->xunmap.from_configure = c_value; } else { c_value= event->xunmap.from_configure; } break;
+    default: croak("Can't access XEvent.from_configure for type=%d", event->type);
+    }
+    PUSHs(value? value : sv_2mortal(newSViv(c_value)));
+
+void
+_height(event, value=NULL)
+  XEvent *event
+  SV *value
+  INIT:
+    int c_value= 0;
+  PPCODE:
+    if (value) { c_value= SvIV(value); }
+    switch (event->type) {
+    case ConfigureNotify:
+      if (value) { event->xconfigure.height = c_value; } else { c_value= event->xconfigure.height; } break;
+    case ConfigureRequest:
+      if (value) { event->xconfigurerequest.height = c_value; } else { c_value= event->xconfigurerequest.height; } break;
+    case CreateNotify:
+      if (value) { event->xcreatewindow.height = c_value; } else { c_value= event->xcreatewindow.height; } break;
+    case Expose:
+      if (value) { event->xexpose.height = c_value; } else { c_value= event->xexpose.height; } break;
+    case GraphicsExpose:
+      if (value) { event->xgraphicsexpose.height = c_value; } else { c_value= event->xgraphicsexpose.height; } break;
+    case ResizeRequest:
+      if (value) { event->xresizerequest.height = c_value; } else { c_value= event->xresizerequest.height; } break;
+    default: croak("Can't access XEvent.height for type=%d", event->type);
+    }
+    PUSHs(value? value : sv_2mortal(newSViv(c_value)));
+
+void
+_is_hint(event, value=NULL)
+  XEvent *event
+  SV *value
+  INIT:
+    char c_value= 0;
+  PPCODE:
+    if (value) { c_value= SvIV(value); }
+    switch (event->type) {
+    case MotionNotify:
+      if (value) { event->xmotion.is_hint = c_value; } else { c_value= event->xmotion.is_hint; } break;
+    default: croak("Can't access XEvent.is_hint for type=%d", event->type);
+    }
+    PUSHs(value? value : sv_2mortal(newSViv(c_value)));
+
+void
+_key_vector(event, value=NULL)
+  XEvent *event
+  SV *value
+  PPCODE:
+    switch (event->type) {
+    case KeymapNotify:
+      if (value) { { if (!SvPOK(value) || SvCUR(value) != sizeof(char)*32)  croak("Expected scalar of length %ld but got %ld", (long)(sizeof(char)*32), (long) SvCUR(value)); memcpy(event->xkeymap.key_vector, SvPVX(value), sizeof(char)*32);} } else { PUSHs(sv_2mortal(newSVpvn((void*)event->xkeymap.key_vector, sizeof(char)*32))); } break;
+    default: croak("Can't access XEvent.key_vector for type=%d", event->type);
+    }
+
+void
+_keycode(event, value=NULL)
+  XEvent *event
+  SV *value
+  INIT:
+    unsigned int c_value= 0;
+  PPCODE:
+    if (value) { c_value= SvUV(value); }
+    switch (event->type) {
+    case KeyPress:
+    case KeyRelease:
+      if (value) { event->xkey.keycode = c_value; } else { c_value= event->xkey.keycode; } break;
+    default: croak("Can't access XEvent.keycode for type=%d", event->type);
+    }
+    PUSHs(value? value : sv_2mortal(newSVuv(c_value)));
+
+void
+_l(event, value=NULL)
+  XEvent *event
+  SV *value
+  PPCODE:
+    switch (event->type) {
+    case ClientMessage:
+      if (value) { { if (!SvPOK(value) || SvCUR(value) != sizeof(long)*5)  croak("Expected scalar of length %ld but got %ld", (long)(sizeof(long)*5), (long) SvCUR(value)); memcpy(event->xclient.data.l, SvPVX(value), sizeof(long)*5);} } else { PUSHs(sv_2mortal(newSVpvn((void*)event->xclient.data.l, sizeof(long)*5))); } break;
+    default: croak("Can't access XEvent.l for type=%d", event->type);
+    }
+
+void
+_major_code(event, value=NULL)
+  XEvent *event
+  SV *value
+  INIT:
+    int c_value= 0;
+  PPCODE:
+    if (value) { c_value= SvIV(value); }
+    switch (event->type) {
+    case GraphicsExpose:
+      if (value) { event->xgraphicsexpose.major_code = c_value; } else { c_value= event->xgraphicsexpose.major_code; } break;
+    case NoExpose:
+      if (value) { event->xnoexpose.major_code = c_value; } else { c_value= event->xnoexpose.major_code; } break;
+    default: croak("Can't access XEvent.major_code for type=%d", event->type);
+    }
+    PUSHs(value? value : sv_2mortal(newSViv(c_value)));
+
+void
+_message_type(event, value=NULL)
+  XEvent *event
+  SV *value
+  INIT:
+    Atom c_value= 0;
+  PPCODE:
+    if (value) { c_value= PerlXlib_sv_to_xid(value); }
+    switch (event->type) {
+    case ClientMessage:
+      if (value) { event->xclient.message_type = c_value; } else { c_value= event->xclient.message_type; } break;
+    default: croak("Can't access XEvent.message_type for type=%d", event->type);
+    }
+    PUSHs(value? value : sv_2mortal(newSVuv(c_value)));
+
+void
+_minor_code(event, value=NULL)
+  XEvent *event
+  SV *value
+  PPCODE:
+    switch (event->type) {
+    case 0:
+      if (value) { event->xerror.minor_code= SvUV(value); } else { PUSHs(sv_2mortal(newSVuv(event->xerror.minor_code))); } break;
+    case GraphicsExpose:
+      if (value) { event->xgraphicsexpose.minor_code= SvIV(value); } else { PUSHs(sv_2mortal(newSViv(event->xgraphicsexpose.minor_code))); } break;
+    case NoExpose:
+      if (value) { event->xnoexpose.minor_code= SvIV(value); } else { PUSHs(sv_2mortal(newSViv(event->xnoexpose.minor_code))); } break;
+    default: croak("Can't access XEvent.minor_code for type=%d", event->type);
+    }
+
+void
+_mode(event, value=NULL)
+  XEvent *event
+  SV *value
+  INIT:
+    int c_value= 0;
+  PPCODE:
+    if (value) { c_value= SvIV(value); }
+    switch (event->type) {
+    case EnterNotify:
+    case LeaveNotify:
+      if (value) { event->xcrossing.mode = c_value; } else { c_value= event->xcrossing.mode; } break;
+    case FocusIn:
+    case FocusOut:
+      if (value) { event->xfocus.mode = c_value; } else { c_value= event->xfocus.mode; } break;
+    default: croak("Can't access XEvent.mode for type=%d", event->type);
+    }
+    PUSHs(value? value : sv_2mortal(newSViv(c_value)));
+
+void
+_new(event, value=NULL)
+  XEvent *event
+  SV *value
+  INIT:
+    Bool c_value= 0;
+  PPCODE:
+    if (value) { c_value= SvIV(value); }
+    switch (event->type) {
+    case ColormapNotify:
+      if (value) { event->xcolormap.new = c_value; } else { c_value= event->xcolormap.new; } break;
+    default: croak("Can't access XEvent.new for type=%d", event->type);
+    }
+    PUSHs(value? value : sv_2mortal(newSViv(c_value)));
+
+void
+_override_redirect(event, value=NULL)
+  XEvent *event
+  SV *value
+  INIT:
+    Bool c_value= 0;
+  PPCODE:
+    if (value) { c_value= SvIV(value); }
+    switch (event->type) {
+    case ConfigureNotify:
+      if (value) { event->xconfigure.override_redirect = c_value; } else { c_value= event->xconfigure.override_redirect; } break;
+    case CreateNotify:
+      if (value) { event->xcreatewindow.override_redirect = c_value; } else { c_value= event->xcreatewindow.override_redirect; } break;
+    case MapNotify:
+      if (value) { event->xmap.override_redirect = c_value; } else { c_value= event->xmap.override_redirect; } break;
+    case ReparentNotify:
+      if (value) { event->xreparent.override_redirect = c_value; } else { c_value= event->xreparent.override_redirect; } break;
+    default: croak("Can't access XEvent.override_redirect for type=%d", event->type);
+    }
+    PUSHs(value? value : sv_2mortal(newSViv(c_value)));
+
+void
+_owner(event, value=NULL)
+  XEvent *event
+  SV *value
+  INIT:
+    Window c_value= 0;
+  PPCODE:
+    if (value) { c_value= PerlXlib_sv_to_xid(value); }
+    switch (event->type) {
+    case SelectionRequest:
+      if (value) { event->xselectionrequest.owner = c_value; } else { c_value= event->xselectionrequest.owner; } break;
+    default: croak("Can't access XEvent.owner for type=%d", event->type);
+    }
+    PUSHs(value? value : sv_2mortal(newSVuv(c_value)));
+
+void
+_pad(event, value=NULL)
+  XEvent *event
+  SV *value
+  PPCODE:
+    switch (event->type) {
+    default: croak("Can't access XEvent.pad for type=%d", event->type);
+    }
+
+void
+_parent(event, value=NULL)
+  XEvent *event
+  SV *value
+  INIT:
+    Window c_value= 0;
+  PPCODE:
+    if (value) { c_value= PerlXlib_sv_to_xid(value); }
+    switch (event->type) {
+    case CirculateRequest:
+      if (value) { event->xcirculaterequest.parent = c_value; } else { c_value= event->xcirculaterequest.parent; } break;
+    case ConfigureRequest:
+      if (value) { event->xconfigurerequest.parent = c_value; } else { c_value= event->xconfigurerequest.parent; } break;
+    case CreateNotify:
+      if (value) { event->xcreatewindow.parent = c_value; } else { c_value= event->xcreatewindow.parent; } break;
+    case MapRequest:
+      if (value) { event->xmaprequest.parent = c_value; } else { c_value= event->xmaprequest.parent; } break;
+    case ReparentNotify:
+      if (value) { event->xreparent.parent = c_value; } else { c_value= event->xreparent.parent; } break;
+    default: croak("Can't access XEvent.parent for type=%d", event->type);
+    }
+    PUSHs(value? value : sv_2mortal(newSVuv(c_value)));
+
+void
+_place(event, value=NULL)
+  XEvent *event
+  SV *value
+  INIT:
+    int c_value= 0;
+  PPCODE:
+    if (value) { c_value= SvIV(value); }
+    switch (event->type) {
+    case CirculateNotify:
+      if (value) { event->xcirculate.place = c_value; } else { c_value= event->xcirculate.place; } break;
+    case CirculateRequest:
+      if (value) { event->xcirculaterequest.place = c_value; } else { c_value= event->xcirculaterequest.place; } break;
+    default: croak("Can't access XEvent.place for type=%d", event->type);
+    }
+    PUSHs(value? value : sv_2mortal(newSViv(c_value)));
+
+void
+_property(event, value=NULL)
+  XEvent *event
+  SV *value
+  INIT:
+    Atom c_value= 0;
+  PPCODE:
+    if (value) { c_value= PerlXlib_sv_to_xid(value); }
+    switch (event->type) {
+    case SelectionNotify:
+      if (value) { event->xselection.property = c_value; } else { c_value= event->xselection.property; } break;
+    case SelectionRequest:
+      if (value) { event->xselectionrequest.property = c_value; } else { c_value= event->xselectionrequest.property; } break;
+    default: croak("Can't access XEvent.property for type=%d", event->type);
+    }
+    PUSHs(value? value : sv_2mortal(newSVuv(c_value)));
+
+void
+_request(event, value=NULL)
+  XEvent *event
+  SV *value
+  INIT:
+    int c_value= 0;
+  PPCODE:
+    if (value) { c_value= SvIV(value); }
+    switch (event->type) {
+    case MappingNotify:
+      if (value) { event->xmapping.request = c_value; } else { c_value= event->xmapping.request; } break;
+    default: croak("Can't access XEvent.request for type=%d", event->type);
+    }
+    PUSHs(value? value : sv_2mortal(newSViv(c_value)));
+
+void
+_request_code(event, value=NULL)
+  XEvent *event
+  SV *value
+  INIT:
+    unsigned char c_value= 0;
+  PPCODE:
+    if (value) { c_value= SvUV(value); }
+    switch (event->type) {
+    case 0:
+      if (value) { event->xerror.request_code = c_value; } else { c_value= event->xerror.request_code; } break;
+    default: croak("Can't access XEvent.request_code for type=%d", event->type);
+    }
+    PUSHs(value? value : sv_2mortal(newSVuv(c_value)));
+
+void
+_requestor(event, value=NULL)
+  XEvent *event
+  SV *value
+  INIT:
+    Window c_value= 0;
+  PPCODE:
+    if (value) { c_value= PerlXlib_sv_to_xid(value); }
+    switch (event->type) {
+    case SelectionNotify:
+      if (value) { event->xselection.requestor = c_value; } else { c_value= event->xselection.requestor; } break;
+    case SelectionRequest:
+      if (value) { event->xselectionrequest.requestor = c_value; } else { c_value= event->xselectionrequest.requestor; } break;
+    default: croak("Can't access XEvent.requestor for type=%d", event->type);
+    }
+    PUSHs(value? value : sv_2mortal(newSVuv(c_value)));
+
+void
+_resourceid(event, value=NULL)
+  XEvent *event
+  SV *value
+  INIT:
+    XID c_value= 0;
+  PPCODE:
+    if (value) { c_value= PerlXlib_sv_to_xid(value); }
+    switch (event->type) {
+    case 0:
+      if (value) { event->xerror.resourceid = c_value; } else { c_value= event->xerror.resourceid; } break;
+    default: croak("Can't access XEvent.resourceid for type=%d", event->type);
+    }
+    PUSHs(value? value : sv_2mortal(newSVuv(c_value)));
+
+void
+_root(event, value=NULL)
+  XEvent *event
+  SV *value
+  INIT:
+    Window c_value= 0;
+  PPCODE:
+    if (value) { c_value= PerlXlib_sv_to_xid(value); }
+    switch (event->type) {
+    case ButtonPress:
+    case ButtonRelease:
+      if (value) { event->xbutton.root = c_value; } else { c_value= event->xbutton.root; } break;
+    case EnterNotify:
+    case LeaveNotify:
+      if (value) { event->xcrossing.root = c_value; } else { c_value= event->xcrossing.root; } break;
+    case KeyPress:
+    case KeyRelease:
+      if (value) { event->xkey.root = c_value; } else { c_value= event->xkey.root; } break;
+    case MotionNotify:
+      if (value) { event->xmotion.root = c_value; } else { c_value= event->xmotion.root; } break;
+    default: croak("Can't access XEvent.root for type=%d", event->type);
+    }
+    PUSHs(value? value : sv_2mortal(newSVuv(c_value)));
+
+void
+_s(event, value=NULL)
+  XEvent *event
+  SV *value
+  PPCODE:
+    switch (event->type) {
+    case ClientMessage:
+      if (value) { { if (!SvPOK(value) || SvCUR(value) != sizeof(short)*10)  croak("Expected scalar of length %ld but got %ld", (long)(sizeof(short)*10), (long) SvCUR(value)); memcpy(event->xclient.data.s, SvPVX(value), sizeof(short)*10);} } else { PUSHs(sv_2mortal(newSVpvn((void*)event->xclient.data.s, sizeof(short)*10))); } break;
+    default: croak("Can't access XEvent.s for type=%d", event->type);
+    }
+
+void
+_same_screen(event, value=NULL)
+  XEvent *event
+  SV *value
+  INIT:
+    Bool c_value= 0;
+  PPCODE:
+    if (value) { c_value= SvIV(value); }
+    switch (event->type) {
+    case ButtonPress:
+    case ButtonRelease:
+      if (value) { event->xbutton.same_screen = c_value; } else { c_value= event->xbutton.same_screen; } break;
+    case EnterNotify:
+    case LeaveNotify:
+      if (value) { event->xcrossing.same_screen = c_value; } else { c_value= event->xcrossing.same_screen; } break;
+    case KeyPress:
+    case KeyRelease:
+      if (value) { event->xkey.same_screen = c_value; } else { c_value= event->xkey.same_screen; } break;
+    case MotionNotify:
+      if (value) { event->xmotion.same_screen = c_value; } else { c_value= event->xmotion.same_screen; } break;
+    default: croak("Can't access XEvent.same_screen for type=%d", event->type);
+    }
+    PUSHs(value? value : sv_2mortal(newSViv(c_value)));
+
+void
+_selection(event, value=NULL)
+  XEvent *event
+  SV *value
+  INIT:
+    Atom c_value= 0;
+  PPCODE:
+    if (value) { c_value= PerlXlib_sv_to_xid(value); }
+    switch (event->type) {
+    case SelectionNotify:
+      if (value) { event->xselection.selection = c_value; } else { c_value= event->xselection.selection; } break;
+    case SelectionClear:
+      if (value) { event->xselectionclear.selection = c_value; } else { c_value= event->xselectionclear.selection; } break;
+    case SelectionRequest:
+      if (value) { event->xselectionrequest.selection = c_value; } else { c_value= event->xselectionrequest.selection; } break;
+    default: croak("Can't access XEvent.selection for type=%d", event->type);
+    }
+    PUSHs(value? value : sv_2mortal(newSVuv(c_value)));
+
+void
+send_event(event, value=NULL)
+  XEvent *event
+  SV *value
+  PPCODE:
+    if (!event->type) croak("Can't access XEvent.send_event for type=%d", event->type);
+    if (value) {
+      event->xany.send_event= SvIV(value);
+      PUSHs(value);
+    } else {
+      PUSHs(sv_2mortal(newSViv(event->xany.send_event)));
+    }
+
+void
+serial(event, value=NULL)
+  XEvent *event
+  SV *value
+  PPCODE:
+    if (value) {
+      if (event->type) event->xany.serial= SvUV(value); else event->xerror.serial= SvUV(value);
+      PUSHs(value);
+    } else {
+      PUSHs(sv_2mortal(newSVuv((event->type? event->xany.serial : event->xerror.serial))));
+    }
+
+void
+_state(event, value=NULL)
+  XEvent *event
+  SV *value
+  PPCODE:
+    switch (event->type) {
+    case ButtonPress:
+    case ButtonRelease:
+      if (value) { event->xbutton.state= SvUV(value); } else { PUSHs(sv_2mortal(newSVuv(event->xbutton.state))); } break;
+    case ColormapNotify:
+      if (value) { event->xcolormap.state= SvIV(value); } else { PUSHs(sv_2mortal(newSViv(event->xcolormap.state))); } break;
+    case EnterNotify:
+    case LeaveNotify:
+      if (value) { event->xcrossing.state= SvUV(value); } else { PUSHs(sv_2mortal(newSVuv(event->xcrossing.state))); } break;
+    case KeyPress:
+    case KeyRelease:
+      if (value) { event->xkey.state= SvUV(value); } else { PUSHs(sv_2mortal(newSVuv(event->xkey.state))); } break;
+    case MotionNotify:
+      if (value) { event->xmotion.state= SvUV(value); } else { PUSHs(sv_2mortal(newSVuv(event->xmotion.state))); } break;
+    case PropertyNotify:
+      if (value) { event->xproperty.state= SvIV(value); } else { PUSHs(sv_2mortal(newSViv(event->xproperty.state))); } break;
+    case VisibilityNotify:
+      if (value) { event->xvisibility.state= SvIV(value); } else { PUSHs(sv_2mortal(newSViv(event->xvisibility.state))); } break;
+    default: croak("Can't access XEvent.state for type=%d", event->type);
+    }
+
+void
+_subwindow(event, value=NULL)
+  XEvent *event
+  SV *value
+  INIT:
+    Window c_value= 0;
+  PPCODE:
+    if (value) { c_value= PerlXlib_sv_to_xid(value); }
+    switch (event->type) {
+    case ButtonPress:
+    case ButtonRelease:
+      if (value) { event->xbutton.subwindow = c_value; } else { c_value= event->xbutton.subwindow; } break;
+    case EnterNotify:
+    case LeaveNotify:
+      if (value) { event->xcrossing.subwindow = c_value; } else { c_value= event->xcrossing.subwindow; } break;
+    case KeyPress:
+    case KeyRelease:
+      if (value) { event->xkey.subwindow = c_value; } else { c_value= event->xkey.subwindow; } break;
+    case MotionNotify:
+      if (value) { event->xmotion.subwindow = c_value; } else { c_value= event->xmotion.subwindow; } break;
+    default: croak("Can't access XEvent.subwindow for type=%d", event->type);
+    }
+    PUSHs(value? value : sv_2mortal(newSVuv(c_value)));
+
+void
+_target(event, value=NULL)
+  XEvent *event
+  SV *value
+  INIT:
+    Atom c_value= 0;
+  PPCODE:
+    if (value) { c_value= PerlXlib_sv_to_xid(value); }
+    switch (event->type) {
+    case SelectionNotify:
+      if (value) { event->xselection.target = c_value; } else { c_value= event->xselection.target; } break;
+    case SelectionRequest:
+      if (value) { event->xselectionrequest.target = c_value; } else { c_value= event->xselectionrequest.target; } break;
+    default: croak("Can't access XEvent.target for type=%d", event->type);
+    }
+    PUSHs(value? value : sv_2mortal(newSVuv(c_value)));
+
+void
+_time(event, value=NULL)
+  XEvent *event
+  SV *value
+  INIT:
+    Time c_value= 0;
+  PPCODE:
+    if (value) { c_value= SvUV(value); }
+    switch (event->type) {
+    case ButtonPress:
+    case ButtonRelease:
+      if (value) { event->xbutton.time = c_value; } else { c_value= event->xbutton.time; } break;
+    case EnterNotify:
+    case LeaveNotify:
+      if (value) { event->xcrossing.time = c_value; } else { c_value= event->xcrossing.time; } break;
+    case KeyPress:
+    case KeyRelease:
+      if (value) { event->xkey.time = c_value; } else { c_value= event->xkey.time; } break;
+    case MotionNotify:
+      if (value) { event->xmotion.time = c_value; } else { c_value= event->xmotion.time; } break;
+    case PropertyNotify:
+      if (value) { event->xproperty.time = c_value; } else { c_value= event->xproperty.time; } break;
+    case SelectionNotify:
+      if (value) { event->xselection.time = c_value; } else { c_value= event->xselection.time; } break;
+    case SelectionClear:
+      if (value) { event->xselectionclear.time = c_value; } else { c_value= event->xselectionclear.time; } break;
+    case SelectionRequest:
+      if (value) { event->xselectionrequest.time = c_value; } else { c_value= event->xselectionrequest.time; } break;
+    default: croak("Can't access XEvent.time for type=%d", event->type);
+    }
+    PUSHs(value? value : sv_2mortal(newSVuv(c_value)));
+
+void
+type(event, value=NULL)
+  XEvent *event
+  SV *value
+  INIT:
+    const char *oldpkg, *newpkg;
+  PPCODE:
+    if (value) {
+      if (event->type != SvIV(value)) {
+        oldpkg= PerlXlib_xevent_pkg_for_type(event->type);
+        event->type= SvIV(value);
+        newpkg= PerlXlib_xevent_pkg_for_type(event->type);
+        if (oldpkg != newpkg) {
+          /* re-initialize all fields in the area that changed */
+          memset( ((char*)(void*)event) + sizeof(XAnyEvent), 0, sizeof(XEvent)-sizeof(XAnyEvent) );
+          /* re-bless the object if the thing passed to us was actually an object */
+          if (sv_derived_from(ST(0), "X11::Xlib::XEvent"))
+            sv_bless(ST(0), gv_stashpv(newpkg, GV_ADD));
+        }
+      }
+    }
+    PUSHs(sv_2mortal(newSViv(event->type)));
+
+void
+_value_mask(event, value=NULL)
+  XEvent *event
+  SV *value
+  INIT:
+    unsigned long c_value= 0;
+  PPCODE:
+    if (value) { c_value= SvUV(value); }
+    switch (event->type) {
+    case ConfigureRequest:
+      if (value) { event->xconfigurerequest.value_mask = c_value; } else { c_value= event->xconfigurerequest.value_mask; } break;
+    default: croak("Can't access XEvent.value_mask for type=%d", event->type);
+    }
+    PUSHs(value? value : sv_2mortal(newSVuv(c_value)));
+
+void
+_width(event, value=NULL)
+  XEvent *event
+  SV *value
+  INIT:
+    int c_value= 0;
+  PPCODE:
+    if (value) { c_value= SvIV(value); }
+    switch (event->type) {
+    case ConfigureNotify:
+      if (value) { event->xconfigure.width = c_value; } else { c_value= event->xconfigure.width; } break;
+    case ConfigureRequest:
+      if (value) { event->xconfigurerequest.width = c_value; } else { c_value= event->xconfigurerequest.width; } break;
+    case CreateNotify:
+      if (value) { event->xcreatewindow.width = c_value; } else { c_value= event->xcreatewindow.width; } break;
+    case Expose:
+      if (value) { event->xexpose.width = c_value; } else { c_value= event->xexpose.width; } break;
+    case GraphicsExpose:
+      if (value) { event->xgraphicsexpose.width = c_value; } else { c_value= event->xgraphicsexpose.width; } break;
+    case ResizeRequest:
+      if (value) { event->xresizerequest.width = c_value; } else { c_value= event->xresizerequest.width; } break;
+    default: croak("Can't access XEvent.width for type=%d", event->type);
+    }
+    PUSHs(value? value : sv_2mortal(newSViv(c_value)));
+
+void
+_window(event, value=NULL)
+  XEvent *event
+  SV *value
+  INIT:
+    Window c_value= 0;
+  PPCODE:
+    if (value) { c_value= PerlXlib_sv_to_xid(value); }
+    switch (event->type) {
+    case ButtonPress:
+    case ButtonRelease:
+      if (value) { event->xbutton.window = c_value; } else { c_value= event->xbutton.window; } break;
+    case CirculateNotify:
+      if (value) { event->xcirculate.window = c_value; } else { c_value= event->xcirculate.window; } break;
+    case CirculateRequest:
+      if (value) { event->xcirculaterequest.window = c_value; } else { c_value= event->xcirculaterequest.window; } break;
+    case ClientMessage:
+      if (value) { event->xclient.window = c_value; } else { c_value= event->xclient.window; } break;
+    case ColormapNotify:
+      if (value) { event->xcolormap.window = c_value; } else { c_value= event->xcolormap.window; } break;
+    case ConfigureNotify:
+      if (value) { event->xconfigure.window = c_value; } else { c_value= event->xconfigure.window; } break;
+    case ConfigureRequest:
+      if (value) { event->xconfigurerequest.window = c_value; } else { c_value= event->xconfigurerequest.window; } break;
+    case CreateNotify:
+      if (value) { event->xcreatewindow.window = c_value; } else { c_value= event->xcreatewindow.window; } break;
+    case EnterNotify:
+    case LeaveNotify:
+      if (value) { event->xcrossing.window = c_value; } else { c_value= event->xcrossing.window; } break;
+    case DestroyNotify:
+      if (value) { event->xdestroywindow.window = c_value; } else { c_value= event->xdestroywindow.window; } break;
+    case Expose:
+      if (value) { event->xexpose.window = c_value; } else { c_value= event->xexpose.window; } break;
+    case FocusIn:
+    case FocusOut:
+      if (value) { event->xfocus.window = c_value; } else { c_value= event->xfocus.window; } break;
+    case GravityNotify:
+      if (value) { event->xgravity.window = c_value; } else { c_value= event->xgravity.window; } break;
+    case KeyPress:
+    case KeyRelease:
+      if (value) { event->xkey.window = c_value; } else { c_value= event->xkey.window; } break;
+    case KeymapNotify:
+      if (value) { event->xkeymap.window = c_value; } else { c_value= event->xkeymap.window; } break;
+    case MapNotify:
+      if (value) { event->xmap.window = c_value; } else { c_value= event->xmap.window; } break;
+    case MappingNotify:
+      if (value) { event->xmapping.window = c_value; } else { c_value= event->xmapping.window; } break;
+    case MapRequest:
+      if (value) { event->xmaprequest.window = c_value; } else { c_value= event->xmaprequest.window; } break;
+    case MotionNotify:
+      if (value) { event->xmotion.window = c_value; } else { c_value= event->xmotion.window; } break;
+    case PropertyNotify:
+      if (value) { event->xproperty.window = c_value; } else { c_value= event->xproperty.window; } break;
+    case ReparentNotify:
+      if (value) { event->xreparent.window = c_value; } else { c_value= event->xreparent.window; } break;
+    case ResizeRequest:
+      if (value) { event->xresizerequest.window = c_value; } else { c_value= event->xresizerequest.window; } break;
+    case SelectionClear:
+      if (value) { event->xselectionclear.window = c_value; } else { c_value= event->xselectionclear.window; } break;
+    case UnmapNotify:
+      if (value) { event->xunmap.window = c_value; } else { c_value= event->xunmap.window; } break;
+    case VisibilityNotify:
+      if (value) { event->xvisibility.window = c_value; } else { c_value= event->xvisibility.window; } break;
+    default: croak("Can't access XEvent.window for type=%d", event->type);
+    }
+    PUSHs(value? value : sv_2mortal(newSVuv(c_value)));
+
+void
+_x(event, value=NULL)
+  XEvent *event
+  SV *value
+  INIT:
+    int c_value= 0;
+  PPCODE:
+    if (value) { c_value= SvIV(value); }
     switch (event->type) {
+    case ButtonPress:
+    case ButtonRelease:
+      if (value) { event->xbutton.x = c_value; } else { c_value= event->xbutton.x; } break;
+    case ConfigureNotify:
+      if (value) { event->xconfigure.x = c_value; } else { c_value= event->xconfigure.x; } break;
+    case ConfigureRequest:
+      if (value) { event->xconfigurerequest.x = c_value; } else { c_value= event->xconfigurerequest.x; } break;
+    case CreateNotify:
+      if (value) { event->xcreatewindow.x = c_value; } else { c_value= event->xcreatewindow.x; } break;
+    case EnterNotify:
+    case LeaveNotify:
+      if (value) { event->xcrossing.x = c_value; } else { c_value= event->xcrossing.x; } break;
     case Expose:
-      if (value) { event->xexpose.count = c_value; } else { c_value= event->xexpose.count; } break;
+      if (value) { event->xexpose.x = c_value; } else { c_value= event->xexpose.x; } break;
     case GraphicsExpose:
-      if (value) { event->xgraphicsexpose.count = c_value; } else { c_value= event->xgraphicsexpose.count; } break;
-    case MappingNotify:
-      if (value) { event->xmapping.count = c_value; } else { c_value= event->xmapping.count; } break;
-    default: croak("Can't access XEvent.count for type=%d", event->type);
+      if (value) { event->xgraphicsexpose.x = c_value; } else { c_value= event->xgraphicsexpose.x; } break;
+    case GravityNotify:
+      if (value) { event->xgravity.x = c_value; } else { c_value= event->xgravity.x; } break;
+    case KeyPress:
+    case KeyRelease:
+      if (value) { event->xkey.x = c_value; } else { c_value= event->xkey.x; } break;
+    case MotionNotify:
+      if (value) { event->xmotion.x = c_value; } else { c_value= event->xmotion.x; } break;
+    case ReparentNotify:
+      if (value) { event->xreparent.x = c_value; } else { c_value= event->xreparent.x; } break;
+    default: croak("Can't access XEvent.x for type=%d", event->type);
+    }
+    PUSHs(value? value : sv_2mortal(newSViv(c_value)));
+
+void
+_x_root(event, value=NULL)
+  XEvent *event
+  SV *value
+  INIT:
+    int c_value= 0;
+  PPCODE:
+    if (value) { c_value= SvIV(value); }
+    switch (event->type) {
+    case ButtonPress:
+    case ButtonRelease:
+      if (value) { event->xbutton.x_root = c_value; } else { c_value= event->xbutton.x_root; } break;
+    case EnterNotify:
+    case LeaveNotify:
+      if (value) { event->xcrossing.x_root = c_value; } else { c_value= event->xcrossing.x_root; } break;
+    case KeyPress:
+    case KeyRelease:
+      if (value) { event->xkey.x_root = c_value; } else { c_value= event->xkey.x_root; } break;
+    case MotionNotify:
+      if (value) { event->xmotion.x_root = c_value; } else { c_value= event->xmotion.x_root; } break;
+    default: croak("Can't access XEvent.x_root for type=%d", event->type);
+    }
+    PUSHs(value? value : sv_2mortal(newSViv(c_value)));
+
+void
+_y(event, value=NULL)
+  XEvent *event
+  SV *value
+  INIT:
+    int c_value= 0;
+  PPCODE:
+    if (value) { c_value= SvIV(value); }
+    switch (event->type) {
+    case ButtonPress:
+    case ButtonRelease:
+      if (value) { event->xbutton.y = c_value; } else { c_value= event->xbutton.y; } break;
+    case ConfigureNotify:
+      if (value) { event->xconfigure.y = c_value; } else { c_value= event->xconfigure.y; } break;
+    case ConfigureRequest:
+      if (value) { event->xconfigurerequest.y = c_value; } else { c_value= event->xconfigurerequest.y; } break;
+    case CreateNotify:
+      if (value) { event->xcreatewindow.y = c_value; } else { c_value= event->xcreatewindow.y; } break;
+    case EnterNotify:
+    case LeaveNotify:
+      if (value) { event->xcrossing.y = c_value; } else { c_value= event->xcrossing.y; } break;
+    case Expose:
+      if (value) { event->xexpose.y = c_value; } else { c_value= event->xexpose.y; } break;
+    case GraphicsExpose:
+      if (value) { event->xgraphicsexpose.y = c_value; } else { c_value= event->xgraphicsexpose.y; } break;
+    case GravityNotify:
+      if (value) { event->xgravity.y = c_value; } else { c_value= event->xgravity.y; } break;
+    case KeyPress:
+    case KeyRelease:
+      if (value) { event->xkey.y = c_value; } else { c_value= event->xkey.y; } break;
+    case MotionNotify:
+      if (value) { event->xmotion.y = c_value; } else { c_value= event->xmotion.y; } break;
+    case ReparentNotify:
+      if (value) { event->xreparent.y = c_value; } else { c_value= event->xreparent.y; } break;
+    default: croak("Can't access XEvent.y for type=%d", event->type);
+    }
+    PUSHs(value? value : sv_2mortal(newSViv(c_value)));
+
+void
+_y_root(event, value=NULL)
+  XEvent *event
+  SV *value
+  INIT:
+    int c_value= 0;
+  PPCODE:
+    if (value) { c_value= SvIV(value); }
+    switch (event->type) {
+    case ButtonPress:
+    case ButtonRelease:
+      if (value) { event->xbutton.y_root = c_value; } else { c_value= event->xbutton.y_root; } break;
+    case EnterNotify:
+    case LeaveNotify:
+      if (value) { event->xcrossing.y_root = c_value; } else { c_value= event->xcrossing.y_root; } break;
+    case KeyPress:
+    case KeyRelease:
+      if (value) { event->xkey.y_root = c_value; } else { c_value= event->xkey.y_root; } break;
+    case MotionNotify:
+      if (value) { event->xmotion.y_root = c_value; } else { c_value= event->xmotion.y_root; } break;
+    default: croak("Can't access XEvent.y_root for type=%d", event->type);
+    }
+    PUSHs(value? value : sv_2mortal(newSViv(c_value)));
+
+# END GENERATED X11_Xlib_XEvent
+# ----------------------------------------------------------------------------
+# BEGIN GENERATED X11_Xlib_XVisualInfo
+
+MODULE = X11::Xlib                PACKAGE = X11::Xlib::XVisualInfo
+
+int
+_sizeof(ignored=NULL)
+    SV* ignored;
+    CODE:
+        RETVAL = sizeof(XVisualInfo);
+    OUTPUT:
+        RETVAL
+
+void
+_initialize(s)
+    SV *s
+    INIT:
+        void *sptr;
+    PPCODE:
+        sptr= PerlXlib_get_struct_ptr(s, 1, "X11::Xlib::XVisualInfo", sizeof(XVisualInfo),
+            (PerlXlib_struct_pack_fn*) &PerlXlib_XVisualInfo_pack
+        );
+        memset((void*) sptr, 0, sizeof(XVisualInfo));
+
+void
+_pack(s, fields, consume=0)
+    XVisualInfo *s
+    HV *fields
+    Bool consume
+    PPCODE:
+        PerlXlib_XVisualInfo_pack(s, fields, consume);
+
+void
+_unpack(s, fields)
+    XVisualInfo *s
+    HV *fields
+    PPCODE:
+        PerlXlib_XVisualInfo_unpack_obj(s, fields, ST(0));
+
+void
+bits_per_rgb(self, value=NULL)
+    XVisualInfo *self
+    SV *value
+  INIT:
+    XVisualInfo *s= self;
+  PPCODE:
+    if (value) {
+      s->bits_per_rgb= SvIV(value);
+      PUSHs(value);
+    } else {
+      PUSHs(sv_2mortal(newSViv(s->bits_per_rgb)));
+    }
+
+void
+blue_mask(self, value=NULL)
+    XVisualInfo *self
+    SV *value
+  INIT:
+    XVisualInfo *s= self;
+  PPCODE:
+    if (value) {
+      s->blue_mask= SvUV(value);
+      PUSHs(value);
+    } else {
+      PUSHs(sv_2mortal(newSVuv(s->blue_mask)));
+    }
+
+void
+class(self, value=NULL)
+    XVisualInfo *self
+    SV *value
+  INIT:
+    XVisualInfo *s= self;
+  PPCODE:
+    if (value) {
+      s->class= SvIV(value);
+      PUSHs(value);
+    } else {
+      PUSHs(sv_2mortal(newSViv(s->class)));
+    }
+
+void
+colormap_size(self, value=NULL)
+    XVisualInfo *self
+    SV *value
+  INIT:
+    XVisualInfo *s= self;
+  PPCODE:
+    if (value) {
+      s->colormap_size= SvIV(value);
+      PUSHs(value);
+    } else {
+      PUSHs(sv_2mortal(newSViv(s->colormap_size)));
     }
-    PUSHs(value? value : sv_2mortal(newSViv(c_value)));
 
 void
-_detail(event, value=NULL)
-  XEvent *event
-  SV *value
+depth(self, value=NULL)
+    XVisualInfo *self
+    SV *value
   INIT:
-    int c_value= 0;
+    XVisualInfo *s= self;
   PPCODE:
-    if (value) { c_value= SvIV(value); }
-    switch (event->type) {
-    case ConfigureRequest:
-      if (value) { event->xconfigurerequest.detail = c_value; } else { c_value= event->xconfigurerequest.detail; } break;
-    case EnterNotify:
-    case LeaveNotify:
-      if (value) { event->xcrossing.detail = c_value; } else { c_value= event->xcrossing.detail; } break;
-    case FocusIn:
-    case FocusOut:
-      if (value) { event->xfocus.detail = c_value; } else { c_value= event->xfocus.detail; } break;
-    default: croak("Can't access XEvent.detail for type=%d", event->type);
+    if (value) {
+      s->depth= SvIV(value);
+      PUSHs(value);
+    } else {
+      PUSHs(sv_2mortal(newSViv(s->depth)));
     }
-    PUSHs(value? value : sv_2mortal(newSViv(c_value)));
 
 void
-display(event, value=NULL)
-  XEvent *event
-  SV *value
+green_mask(self, value=NULL)
+    XVisualInfo *self
+    SV *value
+  INIT:
+    XVisualInfo *s= self;
   PPCODE:
     if (value) {
-      if (event->type) event->xany.display= PerlXlib_display_objref_get_pointer(value, PerlXlib_OR_NULL); else event->xerror.display= PerlXlib_display_objref_get_pointer(value, PerlXlib_OR_NULL);
+      s->green_mask= SvUV(value);
       PUSHs(value);
     } else {
-      PUSHs(sv_2mortal(newSVsv(PerlXlib_get_display_objref((event->type? event->xany.display : event->xerror.display), PerlXlib_AUTOCREATE))));
+      PUSHs(sv_2mortal(newSVuv(s->green_mask)));
     }
 
 void
-_drawable(event, value=NULL)
-  XEvent *event
-  SV *value
+red_mask(self, value=NULL)
+    XVisualInfo *self
+    SV *value
   INIT:
-    Drawable c_value= 0;
+    XVisualInfo *s= self;
   PPCODE:
-    if (value) { c_value= PerlXlib_sv_to_xid(value); }
-    switch (event->type) {
-    case GraphicsExpose:
-      if (value) { event->xgraphicsexpose.drawable = c_value; } else { c_value= event->xgraphicsexpose.drawable; } break;
-    case NoExpose:
-      if (value) { event->xnoexpose.drawable = c_value; } else { c_value= event->xnoexpose.drawable; } break;
-    default: croak("Can't access XEvent.drawable for type=%d", event->type);
+    if (value) {
+      s->red_mask= SvUV(value);
+      PUSHs(value);
+    } else {
+      PUSHs(sv_2mortal(newSVuv(s->red_mask)));
     }
-    PUSHs(value? value : sv_2mortal(newSVuv(c_value)));
 
 void
-_error_code(event, value=NULL)
-  XEvent *event
-  SV *value
+screen(self, value=NULL)
+    XVisualInfo *self
+    SV *value
   INIT:
-    unsigned char c_value= 0;
+    XVisualInfo *s= self;
   PPCODE:
-    if (value) { c_value= SvUV(value); }
-    switch (event->type) {
-    case 0:
-      if (value) { event->xerror.error_code = c_value; } else { c_value= event->xerror.error_code; } break;
-    default: croak("Can't access XEvent.error_code for type=%d", event->type);
+    if (value) {
+      s->screen= SvIV(value);
+      PUSHs(value);
+    } else {
+      PUSHs(sv_2mortal(newSViv(s->screen)));
     }
-    PUSHs(value? value : sv_2mortal(newSVuv(c_value)));
 
 void
-_event(event, value=NULL)
-  XEvent *event
-  SV *value
+visual(self, value=NULL)
+    SV *self
+    SV *value
   INIT:
-    Window c_value= 0;
+    XVisualInfo *s= ( XVisualInfo * ) PerlXlib_get_struct_ptr(
+           self, 0, "X11::Xlib::XVisualInfo", sizeof(XVisualInfo),
+           (PerlXlib_struct_pack_fn*) &PerlXlib_XVisualInfo_pack
+         );
+         SV *dpy_sv= PerlXlib_objref_get_display(self);
+         Display *dpy= PerlXlib_display_objref_get_pointer(dpy_sv, PerlXlib_OR_NULL);
   PPCODE:
-    if (value) { c_value= PerlXlib_sv_to_xid(value); }
-    switch (event->type) {
-    case CirculateNotify:
-      if (value) { event->xcirculate.event = c_value; } else { c_value= event->xcirculate.event; } break;
-    case ConfigureNotify:
-      if (value) { event->xconfigure.event = c_value; } else { c_value= event->xconfigure.event; } break;
-    case DestroyNotify:
-      if (value) { event->xdestroywindow.event = c_value; } else { c_value= event->xdestroywindow.event; } break;
-    case GravityNotify:
-      if (value) { event->xgravity.event = c_value; } else { c_value= event->xgravity.event; } break;
-    case MapNotify:
-      if (value) { event->xmap.event = c_value; } else { c_value= event->xmap.event; } break;
-    case ReparentNotify:
-      if (value) { event->xreparent.event = c_value; } else { c_value= event->xreparent.event; } break;
-    case UnmapNotify:
-      if (value) { event->xunmap.event = c_value; } else { c_value= event->xunmap.event; } break;
-    default: croak("Can't access XEvent.event for type=%d", event->type);
+    if (value) {
+      s->visual= (Visual *) PerlXlib_objref_get_pointer(value, "Visual", PerlXlib_OR_NULL);
+      PUSHs(value);
+    } else {
+      PUSHs(sv_mortalcopy(PerlXlib_get_objref(s->visual, PerlXlib_AUTOCREATE, "Visual", SVt_PVMG, "X11::Xlib::Visual", dpy)));
     }
-    PUSHs(value? value : sv_2mortal(newSVuv(c_value)));
 
 void
-_evtype(event, value=NULL)
-  XEvent *event
-  SV *value
+visualid(self, value=NULL)
+    XVisualInfo *self
+    SV *value
   INIT:
-    int c_value= 0;
+    XVisualInfo *s= self;
   PPCODE:
-    if (value) { c_value= SvIV(value); }
-    switch (event->type) {
-    case GenericEvent:
-      if (value) { event->xgeneric.evtype = c_value; } else { c_value= event->xgeneric.evtype; } break;
-    default: croak("Can't access XEvent.evtype for type=%d", event->type);
+    if (value) {
+      s->visualid= SvUV(value);
+      PUSHs(value);
+    } else {
+      PUSHs(sv_2mortal(newSVuv(s->visualid)));
     }
-    PUSHs(value? value : sv_2mortal(newSViv(c_value)));
+
+# END GENERATED X11_Xlib_XVisualInfo
+# ----------------------------------------------------------------------------
+# BEGIN GENERATED X11_Xlib_XWindowChanges
+
+MODULE = X11::Xlib                PACKAGE = X11::Xlib::XWindowChanges
+
+int
+_sizeof(ignored=NULL)
+    SV* ignored;
+    CODE:
+        RETVAL = sizeof(XWindowChanges);
+    OUTPUT:
+        RETVAL
 
 void
-_extension(event, value=NULL)
-  XEvent *event
-  SV *value
+_initialize(s)
+    SV *s
+    INIT:
+        void *sptr;
+    PPCODE:
+        sptr= PerlXlib_get_struct_ptr(s, 1, "X11::Xlib::XWindowChanges", sizeof(XWindowChanges),
+            (PerlXlib_struct_pack_fn*) &PerlXlib_XWindowChanges_pack
+        );
+        memset((void*) sptr, 0, sizeof(XWindowChanges));
+
+void
+_pack(s, fields, consume=0)
+    XWindowChanges *s
+    HV *fields
+    Bool consume
+    PPCODE:
+        PerlXlib_XWindowChanges_pack(s, fields, consume);
+
+void
+_unpack(s, fields)
+    XWindowChanges *s
+    HV *fields
+    PPCODE:
+        PerlXlib_XWindowChanges_unpack_obj(s, fields, ST(0));
+
+void
+border_width(self, value=NULL)
+    XWindowChanges *self
+    SV *value
   INIT:
-    int c_value= 0;
+    XWindowChanges *s= self;
   PPCODE:
-    if (value) { c_value= SvIV(value); }
-    switch (event->type) {
-    case GenericEvent:
-      if (value) { event->xgeneric.extension = c_value; } else { c_value= event->xgeneric.extension; } break;
-    default: croak("Can't access XEvent.extension for type=%d", event->type);
+    if (value) {
+      s->border_width= SvIV(value);
+      PUSHs(value);
+    } else {
+      PUSHs(sv_2mortal(newSViv(s->border_width)));
     }
-    PUSHs(value? value : sv_2mortal(newSViv(c_value)));
 
 void
-_first_keycode(event, value=NULL)
-  XEvent *event
-  SV *value
+height(self, value=NULL)
+    XWindowChanges *self
+    SV *value
   INIT:
-    int c_value= 0;
+    XWindowChanges *s= self;
   PPCODE:
-    if (value) { c_value= SvIV(value); }
-    switch (event->type) {
-    case MappingNotify:
-      if (value) { event->xmapping.first_keycode = c_value; } else { c_value= event->xmapping.first_keycode; } break;
-    default: croak("Can't access XEvent.first_keycode for type=%d", event->type);
+    if (value) {
+      s->height= SvIV(value);
+      PUSHs(value);
+    } else {
+      PUSHs(sv_2mortal(newSViv(s->height)));
     }
-    PUSHs(value? value : sv_2mortal(newSViv(c_value)));
 
 void
-_focus(event, value=NULL)
-  XEvent *event
-  SV *value
+sibling(self, value=NULL)
+    XWindowChanges *self
+    SV *value
   INIT:
-    Bool c_value= 0;
+    XWindowChanges *s= self;
   PPCODE:
-    if (value) { c_value= SvIV(value); }
-    switch (event->type) {
-    case EnterNotify:
-    case LeaveNotify:
-      if (value) { event->xcrossing.focus = c_value; } else { c_value= event->xcrossing.focus; } break;
-    default: croak("Can't access XEvent.focus for type=%d", event->type);
+    if (value) {
+      s->sibling= PerlXlib_sv_to_xid(value);
+      PUSHs(value);
+    } else {
+      PUSHs(sv_2mortal(newSVuv(s->sibling)));
     }
-    PUSHs(value? value : sv_2mortal(newSViv(c_value)));
 
 void
-_format(event, value=NULL)
-  XEvent *event
-  SV *value
+stack_mode(self, value=NULL)
+    XWindowChanges *self
+    SV *value
+  INIT:
+    XWindowChanges *s= self;
+  PPCODE:
+    if (value) {
+      s->stack_mode= SvIV(value);
+      PUSHs(value);
+    } else {
+      PUSHs(sv_2mortal(newSViv(s->stack_mode)));
+    }
+
+void
+width(self, value=NULL)
+    XWindowChanges *self
+    SV *value
   INIT:
-    int c_value= 0;
+    XWindowChanges *s= self;
   PPCODE:
-    if (value) { c_value= SvIV(value); }
-    switch (event->type) {
-    case ClientMessage:
-      if (value) { event->xclient.format = c_value; } else { c_value= event->xclient.format; } break;
-    default: croak("Can't access XEvent.format for type=%d", event->type);
+    if (value) {
+      s->width= SvIV(value);
+      PUSHs(value);
+    } else {
+      PUSHs(sv_2mortal(newSViv(s->width)));
     }
-    PUSHs(value? value : sv_2mortal(newSViv(c_value)));
 
 void
-_from_configure(event, value=NULL)
-  XEvent *event
-  SV *value
+x(self, value=NULL)
+    XWindowChanges *self
+    SV *value
   INIT:
-    Bool c_value= 0;
+    XWindowChanges *s= self;
   PPCODE:
-    if (value) { c_value= SvIV(value); }
-    switch (event->type) {
-    case UnmapNotify:
-      if (value) { event->xunmap.from_configure = c_value; } else { c_value= event->xunmap.from_configure; } break;
-    default: croak("Can't access XEvent.from_configure for type=%d", event->type);
+    if (value) {
+      s->x= SvIV(value);
+      PUSHs(value);
+    } else {
+      PUSHs(sv_2mortal(newSViv(s->x)));
     }
-    PUSHs(value? value : sv_2mortal(newSViv(c_value)));
 
 void
-_height(event, value=NULL)
-  XEvent *event
-  SV *value
+y(self, value=NULL)
+    XWindowChanges *self
+    SV *value
   INIT:
-    int c_value= 0;
+    XWindowChanges *s= self;
   PPCODE:
-    if (value) { c_value= SvIV(value); }
-    switch (event->type) {
-    case ConfigureNotify:
-      if (value) { event->xconfigure.height = c_value; } else { c_value= event->xconfigure.height; } break;
-    case ConfigureRequest:
-      if (value) { event->xconfigurerequest.height = c_value; } else { c_value= event->xconfigurerequest.height; } break;
-    case CreateNotify:
-      if (value) { event->xcreatewindow.height = c_value; } else { c_value= event->xcreatewindow.height; } break;
-    case Expose:
-      if (value) { event->xexpose.height = c_value; } else { c_value= event->xexpose.height; } break;
-    case GraphicsExpose:
-      if (value) { event->xgraphicsexpose.height = c_value; } else { c_value= event->xgraphicsexpose.height; } break;
-    case ResizeRequest:
-      if (value) { event->xresizerequest.height = c_value; } else { c_value= event->xresizerequest.height; } break;
-    default: croak("Can't access XEvent.height for type=%d", event->type);
+    if (value) {
+      s->y= SvIV(value);
+      PUSHs(value);
+    } else {
+      PUSHs(sv_2mortal(newSViv(s->y)));
     }
-    PUSHs(value? value : sv_2mortal(newSViv(c_value)));
+
+# END GENERATED X11_Xlib_XWindowChanges
+# ----------------------------------------------------------------------------
+# BEGIN GENERATED X11_Xlib_XWindowAttributes
+
+MODULE = X11::Xlib                PACKAGE = X11::Xlib::XWindowAttributes
+
+int
+_sizeof(ignored=NULL)
+    SV* ignored;
+    CODE:
+        RETVAL = sizeof(XWindowAttributes);
+    OUTPUT:
+        RETVAL
 
 void
-_is_hint(event, value=NULL)
-  XEvent *event
-  SV *value
+_initialize(s)
+    SV *s
+    INIT:
+        void *sptr;
+    PPCODE:
+        sptr= PerlXlib_get_struct_ptr(s, 1, "X11::Xlib::XWindowAttributes", sizeof(XWindowAttributes),
+            (PerlXlib_struct_pack_fn*) &PerlXlib_XWindowAttributes_pack
+        );
+        memset((void*) sptr, 0, sizeof(XWindowAttributes));
+
+void
+_pack(s, fields, consume=0)
+    XWindowAttributes *s
+    HV *fields
+    Bool consume
+    PPCODE:
+        PerlXlib_XWindowAttributes_pack(s, fields, consume);
+
+void
+_unpack(s, fields)
+    XWindowAttributes *s
+    HV *fields
+    PPCODE:
+        PerlXlib_XWindowAttributes_unpack_obj(s, fields, ST(0));
+
+void
+all_event_masks(self, value=NULL)
+    XWindowAttributes *self
+    SV *value
   INIT:
-    char c_value= 0;
+    XWindowAttributes *s= self;
   PPCODE:
-    if (value) { c_value= SvIV(value); }
-    switch (event->type) {
-    case MotionNotify:
-      if (value) { event->xmotion.is_hint = c_value; } else { c_value= event->xmotion.is_hint; } break;
-    default: croak("Can't access XEvent.is_hint for type=%d", event->type);
+    if (value) {
+      s->all_event_masks= SvIV(value);
+      PUSHs(value);
+    } else {
+      PUSHs(sv_2mortal(newSViv(s->all_event_masks)));
     }
-    PUSHs(value? value : sv_2mortal(newSViv(c_value)));
 
 void
-_key_vector(event, value=NULL)
-  XEvent *event
-  SV *value
+backing_pixel(self, value=NULL)
+    XWindowAttributes *self
+    SV *value
+  INIT:
+    XWindowAttributes *s= self;
   PPCODE:
-    switch (event->type) {
-    case KeymapNotify:
-      if (value) { { if (!SvPOK(value) || SvCUR(value) != sizeof(char)*32)  croak("Expected scalar of length %ld but got %ld", (long)(sizeof(char)*32), (long) SvCUR(value)); memcpy(event->xkeymap.key_vector, SvPVX(value), sizeof(char)*32);} } else { PUSHs(sv_2mortal(newSVpvn((void*)event->xkeymap.key_vector, sizeof(char)*32))); } break;
-    default: croak("Can't access XEvent.key_vector for type=%d", event->type);
+    if (value) {
+      s->backing_pixel= SvUV(value);
+      PUSHs(value);
+    } else {
+      PUSHs(sv_2mortal(newSVuv(s->backing_pixel)));
     }
 
 void
-_keycode(event, value=NULL)
-  XEvent *event
-  SV *value
+backing_planes(self, value=NULL)
+    XWindowAttributes *self
+    SV *value
   INIT:
-    unsigned int c_value= 0;
+    XWindowAttributes *s= self;
   PPCODE:
-    if (value) { c_value= SvUV(value); }
-    switch (event->type) {
-    case KeyPress:
-    case KeyRelease:
-      if (value) { event->xkey.keycode = c_value; } else { c_value= event->xkey.keycode; } break;
-    default: croak("Can't access XEvent.keycode for type=%d", event->type);
+    if (value) {
+      s->backing_planes= SvUV(value);
+      PUSHs(value);
+    } else {
+      PUSHs(sv_2mortal(newSVuv(s->backing_planes)));
     }
-    PUSHs(value? value : sv_2mortal(newSVuv(c_value)));
 
 void
-_l(event, value=NULL)
-  XEvent *event
-  SV *value
+backing_store(self, value=NULL)
+    XWindowAttributes *self
+    SV *value
+  INIT:
+    XWindowAttributes *s= self;
   PPCODE:
-    switch (event->type) {
-    case ClientMessage:
-      if (value) { { if (!SvPOK(value) || SvCUR(value) != sizeof(long)*5)  croak("Expected scalar of length %ld but got %ld", (long)(sizeof(long)*5), (long) SvCUR(value)); memcpy(event->xclient.data.l, SvPVX(value), sizeof(long)*5);} } else { PUSHs(sv_2mortal(newSVpvn((void*)event->xclient.data.l, sizeof(long)*5))); } break;
-    default: croak("Can't access XEvent.l for type=%d", event->type);
+    if (value) {
+      s->backing_store= SvIV(value);
+      PUSHs(value);
+    } else {
+      PUSHs(sv_2mortal(newSViv(s->backing_store)));
     }
 
 void
-_major_code(event, value=NULL)
-  XEvent *event
-  SV *value
+bit_gravity(self, value=NULL)
+    XWindowAttributes *self
+    SV *value
   INIT:
-    int c_value= 0;
+    XWindowAttributes *s= self;
   PPCODE:
-    if (value) { c_value= SvIV(value); }
-    switch (event->type) {
-    case GraphicsExpose:
-      if (value) { event->xgraphicsexpose.major_code = c_value; } else { c_value= event->xgraphicsexpose.major_code; } break;
-    case NoExpose:
-      if (value) { event->xnoexpose.major_code = c_value; } else { c_value= event->xnoexpose.major_code; } break;
-    default: croak("Can't access XEvent.major_code for type=%d", event->type);
+    if (value) {
+      s->bit_gravity= SvIV(value);
+      PUSHs(value);
+    } else {
+      PUSHs(sv_2mortal(newSViv(s->bit_gravity)));
     }
-    PUSHs(value? value : sv_2mortal(newSViv(c_value)));
 
 void
-_message_type(event, value=NULL)
-  XEvent *event
-  SV *value
+border_width(self, value=NULL)
+    XWindowAttributes *self
+    SV *value
   INIT:
-    Atom c_value= 0;
+    XWindowAttributes *s= self;
   PPCODE:
-    if (value) { c_value= PerlXlib_sv_to_xid(value); }
-    switch (event->type) {
-    case ClientMessage:
-      if (value) { event->xclient.message_type = c_value; } else { c_value= event->xclient.message_type; } break;
-    default: croak("Can't access XEvent.message_type for type=%d", event->type);
+    if (value) {
+      s->border_width= SvIV(value);
+      PUSHs(value);
+    } else {
+      PUSHs(sv_2mortal(newSViv(s->border_width)));
     }
-    PUSHs(value? value : sv_2mortal(newSVuv(c_value)));
 
 void
-_minor_code(event, value=NULL)
-  XEvent *event
-  SV *value
+class(self, value=NULL)
+    XWindowAttributes *self
+    SV *value
+  INIT:
+    XWindowAttributes *s= self;
   PPCODE:
-    switch (event->type) {
-    case 0:
-      if (value) { event->xerror.minor_code= SvUV(value); } else { PUSHs(sv_2mortal(newSVuv(event->xerror.minor_code))); } break;
-    case GraphicsExpose:
-      if (value) { event->xgraphicsexpose.minor_code= SvIV(value); } else { PUSHs(sv_2mortal(newSViv(event->xgraphicsexpose.minor_code))); } break;
-    case NoExpose:
-      if (value) { event->xnoexpose.minor_code= SvIV(value); } else { PUSHs(sv_2mortal(newSViv(event->xnoexpose.minor_code))); } break;
-    default: croak("Can't access XEvent.minor_code for type=%d", event->type);
+    if (value) {
+      s->class= SvIV(value);
+      PUSHs(value);
+    } else {
+      PUSHs(sv_2mortal(newSViv(s->class)));
     }
 
 void
-_mode(event, value=NULL)
-  XEvent *event
-  SV *value
+colormap(self, value=NULL)
+    XWindowAttributes *self
+    SV *value
   INIT:
-    int c_value= 0;
+    XWindowAttributes *s= self;
   PPCODE:
-    if (value) { c_value= SvIV(value); }
-    switch (event->type) {
-    case EnterNotify:
-    case LeaveNotify:
-      if (value) { event->xcrossing.mode = c_value; } else { c_value= event->xcrossing.mode; } break;
-    case FocusIn:
-    case FocusOut:
-      if (value) { event->xfocus.mode = c_value; } else { c_value= event->xfocus.mode; } break;
-    default: croak("Can't access XEvent.mode for type=%d", event->type);
+    if (value) {
+      s->colormap= PerlXlib_sv_to_xid(value);
+      PUSHs(value);
+    } else {
+      PUSHs(sv_2mortal(newSVuv(s->colormap)));
     }
-    PUSHs(value? value : sv_2mortal(newSViv(c_value)));
 
 void
-_new(event, value=NULL)
-  XEvent *event
-  SV *value
+depth(self, value=NULL)
+    XWindowAttributes *self
+    SV *value
   INIT:
-    Bool c_value= 0;
+    XWindowAttributes *s= self;
   PPCODE:
-    if (value) { c_value= SvIV(value); }
-    switch (event->type) {
-    case ColormapNotify:
-      if (value) { event->xcolormap.new = c_value; } else { c_value= event->xcolormap.new; } break;
-    default: croak("Can't access XEvent.new for type=%d", event->type);
+    if (value) {
+      s->depth= SvIV(value);
+      PUSHs(value);
+    } else {
+      PUSHs(sv_2mortal(newSViv(s->depth)));
     }
-    PUSHs(value? value : sv_2mortal(newSViv(c_value)));
 
 void
-_override_redirect(event, value=NULL)
-  XEvent *event
-  SV *value
+do_not_propagate_mask(self, value=NULL)
+    XWindowAttributes *self
+    SV *value
   INIT:
-    Bool c_value= 0;
+    XWindowAttributes *s= self;
   PPCODE:
-    if (value) { c_value= SvIV(value); }
-    switch (event->type) {
-    case ConfigureNotify:
-      if (value) { event->xconfigure.override_redirect = c_value; } else { c_value= event->xconfigure.override_redirect; } break;
-    case CreateNotify:
-      if (value) { event->xcreatewindow.override_redirect = c_value; } else { c_value= event->xcreatewindow.override_redirect; } break;
-    case MapNotify:
-      if (value) { event->xmap.override_redirect = c_value; } else { c_value= event->xmap.override_redirect; } break;
-    case ReparentNotify:
-      if (value) { event->xreparent.override_redirect = c_value; } else { c_value= event->xreparent.override_redirect; } break;
-    default: croak("Can't access XEvent.override_redirect for type=%d", event->type);
+    if (value) {
+      s->do_not_propagate_mask= SvIV(value);
+      PUSHs(value);
+    } else {
+      PUSHs(sv_2mortal(newSViv(s->do_not_propagate_mask)));
     }
-    PUSHs(value? value : sv_2mortal(newSViv(c_value)));
 
 void
-_owner(event, value=NULL)
-  XEvent *event
-  SV *value
+height(self, value=NULL)
+    XWindowAttributes *self
+    SV *value
   INIT:
-    Window c_value= 0;
+    XWindowAttributes *s= self;
   PPCODE:
-    if (value) { c_value= PerlXlib_sv_to_xid(value); }
-    switch (event->type) {
-    case SelectionRequest:
-      if (value) { event->xselectionrequest.owner = c_value; } else { c_value= event->xselectionrequest.owner; } break;
-    default: croak("Can't access XEvent.owner for type=%d", event->type);
+    if (value) {
+      s->height= SvIV(value);
+      PUSHs(value);
+    } else {
+      PUSHs(sv_2mortal(newSViv(s->height)));
     }
-    PUSHs(value? value : sv_2mortal(newSVuv(c_value)));
 
 void
-_pad(event, value=NULL)
-  XEvent *event
-  SV *value
+map_installed(self, value=NULL)
+    XWindowAttributes *self
+    SV *value
+  INIT:
+    XWindowAttributes *s= self;
   PPCODE:
-    switch (event->type) {
-    default: croak("Can't access XEvent.pad for type=%d", event->type);
+    if (value) {
+      s->map_installed= SvIV(value);
+      PUSHs(value);
+    } else {
+      PUSHs(sv_2mortal(newSViv(s->map_installed)));
     }
 
 void
-_parent(event, value=NULL)
-  XEvent *event
-  SV *value
+map_state(self, value=NULL)
+    XWindowAttributes *self
+    SV *value
   INIT:
-    Window c_value= 0;
+    XWindowAttributes *s= self;
   PPCODE:
-    if (value) { c_value= PerlXlib_sv_to_xid(value); }
-    switch (event->type) {
-    case CirculateRequest:
-      if (value) { event->xcirculaterequest.parent = c_value; } else { c_value= event->xcirculaterequest.parent; } break;
-    case ConfigureRequest:
-      if (value) { event->xconfigurerequest.parent = c_value; } else { c_value= event->xconfigurerequest.parent; } break;
-    case CreateNotify:
-      if (value) { event->xcreatewindow.parent = c_value; } else { c_value= event->xcreatewindow.parent; } break;
-    case MapRequest:
-      if (value) { event->xmaprequest.parent = c_value; } else { c_value= event->xmaprequest.parent; } break;
-    case ReparentNotify:
-      if (value) { event->xreparent.parent = c_value; } else { c_value= event->xreparent.parent; } break;
-    default: croak("Can't access XEvent.parent for type=%d", event->type);
+    if (value) {
+      s->map_state= SvIV(value);
+      PUSHs(value);
+    } else {
+      PUSHs(sv_2mortal(newSViv(s->map_state)));
     }
-    PUSHs(value? value : sv_2mortal(newSVuv(c_value)));
 
 void
-_place(event, value=NULL)
-  XEvent *event
-  SV *value
+override_redirect(self, value=NULL)
+    XWindowAttributes *self
+    SV *value
   INIT:
-    int c_value= 0;
+    XWindowAttributes *s= self;
   PPCODE:
-    if (value) { c_value= SvIV(value); }
-    switch (event->type) {
-    case CirculateNotify:
-      if (value) { event->xcirculate.place = c_value; } else { c_value= event->xcirculate.place; } break;
-    case CirculateRequest:
-      if (value) { event->xcirculaterequest.place = c_value; } else { c_value= event->xcirculaterequest.place; } break;
-    default: croak("Can't access XEvent.place for type=%d", event->type);
+    if (value) {
+      s->override_redirect= SvIV(value);
+      PUSHs(value);
+    } else {
+      PUSHs(sv_2mortal(newSViv(s->override_redirect)));
     }
-    PUSHs(value? value : sv_2mortal(newSViv(c_value)));
 
 void
-_property(event, value=NULL)
-  XEvent *event
-  SV *value
+root(self, value=NULL)
+    XWindowAttributes *self
+    SV *value
   INIT:
-    Atom c_value= 0;
+    XWindowAttributes *s= self;
   PPCODE:
-    if (value) { c_value= PerlXlib_sv_to_xid(value); }
-    switch (event->type) {
-    case SelectionNotify:
-      if (value) { event->xselection.property = c_value; } else { c_value= event->xselection.property; } break;
-    case SelectionRequest:
-      if (value) { event->xselectionrequest.property = c_value; } else { c_value= event->xselectionrequest.property; } break;
-    default: croak("Can't access XEvent.property for type=%d", event->type);
+    if (value) {
+      s->root= PerlXlib_sv_to_xid(value);
+      PUSHs(value);
+    } else {
+      PUSHs(sv_2mortal(newSVuv(s->root)));
     }
-    PUSHs(value? value : sv_2mortal(newSVuv(c_value)));
 
 void
-_request(event, value=NULL)
-  XEvent *event
-  SV *value
+save_under(self, value=NULL)
+    XWindowAttributes *self
+    SV *value
   INIT:
-    int c_value= 0;
+    XWindowAttributes *s= self;
   PPCODE:
-    if (value) { c_value= SvIV(value); }
-    switch (event->type) {
-    case MappingNotify:
-      if (value) { event->xmapping.request = c_value; } else { c_value= event->xmapping.request; } break;
-    default: croak("Can't access XEvent.request for type=%d", event->type);
+    if (value) {
+      s->save_under= SvIV(value);
+      PUSHs(value);
+    } else {
+      PUSHs(sv_2mortal(newSViv(s->save_under)));
     }
-    PUSHs(value? value : sv_2mortal(newSViv(c_value)));
 
 void
-_request_code(event, value=NULL)
-  XEvent *event
-  SV *value
+screen(self, value=NULL)
+    XWindowAttributes *self
+    SV *value
   INIT:
-    unsigned char c_value= 0;
+    XWindowAttributes *s= self;
   PPCODE:
-    if (value) { c_value= SvUV(value); }
-    switch (event->type) {
-    case 0:
-      if (value) { event->xerror.request_code = c_value; } else { c_value= event->xerror.request_code; } break;
-    default: croak("Can't access XEvent.request_code for type=%d", event->type);
+    if (value) {
+      s->screen= PerlXlib_screen_objref_get_pointer(value, PerlXlib_OR_NULL);
+      PUSHs(value);
+    } else {
+      PUSHs(sv_2mortal(newSVsv(PerlXlib_get_screen_objref(s->screen, PerlXlib_OR_UNDEF))));
     }
-    PUSHs(value? value : sv_2mortal(newSVuv(c_value)));
 
 void
-_requestor(event, value=NULL)
-  XEvent *event
-  SV *value
+visual(self, value=NULL)
+    SV *self
+    SV *value
   INIT:
-    Window c_value= 0;
+    XWindowAttributes *s= ( XWindowAttributes * ) PerlXlib_get_struct_ptr(
+           self, 0, "X11::Xlib::XWindowAttributes", sizeof(XWindowAttributes),
+           (PerlXlib_struct_pack_fn*) &PerlXlib_XWindowAttributes_pack
+         );
+         SV *dpy_sv= PerlXlib_objref_get_display(self);
+         Display *dpy= PerlXlib_display_objref_get_pointer(dpy_sv, PerlXlib_OR_NULL);
   PPCODE:
-    if (value) { c_value= PerlXlib_sv_to_xid(value); }
-    switch (event->type) {
-    case SelectionNotify:
-      if (value) { event->xselection.requestor = c_value; } else { c_value= event->xselection.requestor; } break;
-    case SelectionRequest:
-      if (value) { event->xselectionrequest.requestor = c_value; } else { c_value= event->xselectionrequest.requestor; } break;
-    default: croak("Can't access XEvent.requestor for type=%d", event->type);
+    if (value) {
+      s->visual= (Visual *) PerlXlib_objref_get_pointer(value, "Visual", PerlXlib_OR_NULL);
+      PUSHs(value);
+    } else {
+      PUSHs(sv_mortalcopy(PerlXlib_get_objref(s->visual, PerlXlib_AUTOCREATE, "Visual", SVt_PVMG, "X11::Xlib::Visual", dpy)));
     }
-    PUSHs(value? value : sv_2mortal(newSVuv(c_value)));
 
 void
-_resourceid(event, value=NULL)
-  XEvent *event
-  SV *value
+width(self, value=NULL)
+    XWindowAttributes *self
+    SV *value
   INIT:
-    XID c_value= 0;
+    XWindowAttributes *s= self;
   PPCODE:
-    if (value) { c_value= PerlXlib_sv_to_xid(value); }
-    switch (event->type) {
-    case 0:
-      if (value) { event->xerror.resourceid = c_value; } else { c_value= event->xerror.resourceid; } break;
-    default: croak("Can't access XEvent.resourceid for type=%d", event->type);
+    if (value) {
+      s->width= SvIV(value);
+      PUSHs(value);
+    } else {
+      PUSHs(sv_2mortal(newSViv(s->width)));
     }
-    PUSHs(value? value : sv_2mortal(newSVuv(c_value)));
 
 void
-_root(event, value=NULL)
-  XEvent *event
-  SV *value
-  INIT:
-    Window c_value= 0;
-  PPCODE:
-    if (value) { c_value= PerlXlib_sv_to_xid(value); }
-    switch (event->type) {
-    case ButtonPress:
-    case ButtonRelease:
-      if (value) { event->xbutton.root = c_value; } else { c_value= event->xbutton.root; } break;
-    case EnterNotify:
-    case LeaveNotify:
-      if (value) { event->xcrossing.root = c_value; } else { c_value= event->xcrossing.root; } break;
-    case KeyPress:
-    case KeyRelease:
-      if (value) { event->xkey.root = c_value; } else { c_value= event->xkey.root; } break;
-    case MotionNotify:
-      if (value) { event->xmotion.root = c_value; } else { c_value= event->xmotion.root; } break;
-    default: croak("Can't access XEvent.root for type=%d", event->type);
+win_gravity(self, value=NULL)
+    XWindowAttributes *self
+    SV *value
+  INIT:
+    XWindowAttributes *s= self;
+  PPCODE:
+    if (value) {
+      s->win_gravity= SvIV(value);
+      PUSHs(value);
+    } else {
+      PUSHs(sv_2mortal(newSViv(s->win_gravity)));
     }
-    PUSHs(value? value : sv_2mortal(newSVuv(c_value)));
 
 void
-_s(event, value=NULL)
-  XEvent *event
-  SV *value
+x(self, value=NULL)
+    XWindowAttributes *self
+    SV *value
+  INIT:
+    XWindowAttributes *s= self;
   PPCODE:
-    switch (event->type) {
-    case ClientMessage:
-      if (value) { { if (!SvPOK(value) || SvCUR(value) != sizeof(short)*10)  croak("Expected scalar of length %ld but got %ld", (long)(sizeof(short)*10), (long) SvCUR(value)); memcpy(event->xclient.data.s, SvPVX(value), sizeof(short)*10);} } else { PUSHs(sv_2mortal(newSVpvn((void*)event->xclient.data.s, sizeof(short)*10))); } break;
-    default: croak("Can't access XEvent.s for type=%d", event->type);
+    if (value) {
+      s->x= SvIV(value);
+      PUSHs(value);
+    } else {
+      PUSHs(sv_2mortal(newSViv(s->x)));
     }
 
 void
-_same_screen(event, value=NULL)
-  XEvent *event
-  SV *value
+y(self, value=NULL)
+    XWindowAttributes *self
+    SV *value
   INIT:
-    Bool c_value= 0;
+    XWindowAttributes *s= self;
   PPCODE:
-    if (value) { c_value= SvIV(value); }
-    switch (event->type) {
-    case ButtonPress:
-    case ButtonRelease:
-      if (value) { event->xbutton.same_screen = c_value; } else { c_value= event->xbutton.same_screen; } break;
-    case EnterNotify:
-    case LeaveNotify:
-      if (value) { event->xcrossing.same_screen = c_value; } else { c_value= event->xcrossing.same_screen; } break;
-    case KeyPress:
-    case KeyRelease:
-      if (value) { event->xkey.same_screen = c_value; } else { c_value= event->xkey.same_screen; } break;
-    case MotionNotify:
-      if (value) { event->xmotion.same_screen = c_value; } else { c_value= event->xmotion.same_screen; } break;
-    default: croak("Can't access XEvent.same_screen for type=%d", event->type);
+    if (value) {
+      s->y= SvIV(value);
+      PUSHs(value);
+    } else {
+      PUSHs(sv_2mortal(newSViv(s->y)));
     }
-    PUSHs(value? value : sv_2mortal(newSViv(c_value)));
 
 void
-_selection(event, value=NULL)
-  XEvent *event
-  SV *value
+your_event_mask(self, value=NULL)
+    XWindowAttributes *self
+    SV *value
   INIT:
-    Atom c_value= 0;
+    XWindowAttributes *s= self;
   PPCODE:
-    if (value) { c_value= PerlXlib_sv_to_xid(value); }
-    switch (event->type) {
-    case SelectionNotify:
-      if (value) { event->xselection.selection = c_value; } else { c_value= event->xselection.selection; } break;
-    case SelectionClear:
-      if (value) { event->xselectionclear.selection = c_value; } else { c_value= event->xselectionclear.selection; } break;
-    case SelectionRequest:
-      if (value) { event->xselectionrequest.selection = c_value; } else { c_value= event->xselectionrequest.selection; } break;
-    default: croak("Can't access XEvent.selection for type=%d", event->type);
+    if (value) {
+      s->your_event_mask= SvIV(value);
+      PUSHs(value);
+    } else {
+      PUSHs(sv_2mortal(newSViv(s->your_event_mask)));
     }
-    PUSHs(value? value : sv_2mortal(newSVuv(c_value)));
+
+# END GENERATED X11_Xlib_XWindowAttributes
+# ----------------------------------------------------------------------------
+# BEGIN GENERATED X11_Xlib_XSetWindowAttributes
+
+MODULE = X11::Xlib                PACKAGE = X11::Xlib::XSetWindowAttributes
+
+int
+_sizeof(ignored=NULL)
+    SV* ignored;
+    CODE:
+        RETVAL = sizeof(XSetWindowAttributes);
+    OUTPUT:
+        RETVAL
 
 void
-send_event(event, value=NULL)
-  XEvent *event
-  SV *value
+_initialize(s)
+    SV *s
+    INIT:
+        void *sptr;
+    PPCODE:
+        sptr= PerlXlib_get_struct_ptr(s, 1, "X11::Xlib::XSetWindowAttributes", sizeof(XSetWindowAttributes),
+            (PerlXlib_struct_pack_fn*) &PerlXlib_XSetWindowAttributes_pack
+        );
+        memset((void*) sptr, 0, sizeof(XSetWindowAttributes));
+
+void
+_pack(s, fields, consume=0)
+    XSetWindowAttributes *s
+    HV *fields
+    Bool consume
+    PPCODE:
+        PerlXlib_XSetWindowAttributes_pack(s, fields, consume);
+
+void
+_unpack(s, fields)
+    XSetWindowAttributes *s
+    HV *fields
+    PPCODE:
+        PerlXlib_XSetWindowAttributes_unpack_obj(s, fields, ST(0));
+
+void
+background_pixel(self, value=NULL)
+    XSetWindowAttributes *self
+    SV *value
+  INIT:
+    XSetWindowAttributes *s= self;
   PPCODE:
-    if (!event->type) croak("Can't access XEvent.send_event for type=%d", event->type);
     if (value) {
-      event->xany.send_event= SvIV(value);
+      s->background_pixel= SvUV(value);
       PUSHs(value);
     } else {
-      PUSHs(sv_2mortal(newSViv(event->xany.send_event)));
+      PUSHs(sv_2mortal(newSVuv(s->background_pixel)));
     }
 
 void
-serial(event, value=NULL)
-  XEvent *event
-  SV *value
+background_pixmap(self, value=NULL)
+    XSetWindowAttributes *self
+    SV *value
+  INIT:
+    XSetWindowAttributes *s= self;
   PPCODE:
     if (value) {
-      if (event->type) event->xany.serial= SvUV(value); else event->xerror.serial= SvUV(value);
+      s->background_pixmap= PerlXlib_sv_to_xid(value);
       PUSHs(value);
     } else {
-      PUSHs(sv_2mortal(newSVuv((event->type? event->xany.serial : event->xerror.serial))));
+      PUSHs(sv_2mortal(newSVuv(s->background_pixmap)));
     }
 
 void
-_state(event, value=NULL)
-  XEvent *event
-  SV *value
+backing_pixel(self, value=NULL)
+    XSetWindowAttributes *self
+    SV *value
+  INIT:
+    XSetWindowAttributes *s= self;
   PPCODE:
-    switch (event->type) {
-    case ButtonPress:
-    case ButtonRelease:
-      if (value) { event->xbutton.state= SvUV(value); } else { PUSHs(sv_2mortal(newSVuv(event->xbutton.state))); } break;
-    case ColormapNotify:
-      if (value) { event->xcolormap.state= SvIV(value); } else { PUSHs(sv_2mortal(newSViv(event->xcolormap.state))); } break;
-    case EnterNotify:
-    case LeaveNotify:
-      if (value) { event->xcrossing.state= SvUV(value); } else { PUSHs(sv_2mortal(newSVuv(event->xcrossing.state))); } break;
-    case KeyPress:
-    case KeyRelease:
-      if (value) { event->xkey.state= SvUV(value); } else { PUSHs(sv_2mortal(newSVuv(event->xkey.state))); } break;
-    case MotionNotify:
-      if (value) { event->xmotion.state= SvUV(value); } else { PUSHs(sv_2mortal(newSVuv(event->xmotion.state))); } break;
-    case PropertyNotify:
-      if (value) { event->xproperty.state= SvIV(value); } else { PUSHs(sv_2mortal(newSViv(event->xproperty.state))); } break;
-    case VisibilityNotify:
-      if (value) { event->xvisibility.state= SvIV(value); } else { PUSHs(sv_2mortal(newSViv(event->xvisibility.state))); } break;
-    default: croak("Can't access XEvent.state for type=%d", event->type);
+    if (value) {
+      s->backing_pixel= SvUV(value);
+      PUSHs(value);
+    } else {
+      PUSHs(sv_2mortal(newSVuv(s->backing_pixel)));
     }
 
 void
-_subwindow(event, value=NULL)
-  XEvent *event
-  SV *value
+backing_planes(self, value=NULL)
+    XSetWindowAttributes *self
+    SV *value
   INIT:
-    Window c_value= 0;
+    XSetWindowAttributes *s= self;
   PPCODE:
-    if (value) { c_value= PerlXlib_sv_to_xid(value); }
-    switch (event->type) {
-    case ButtonPress:
-    case ButtonRelease:
-      if (value) { event->xbutton.subwindow = c_value; } else { c_value= event->xbutton.subwindow; } break;
-    case EnterNotify:
-    case LeaveNotify:
-      if (value) { event->xcrossing.subwindow = c_value; } else { c_value= event->xcrossing.subwindow; } break;
-    case KeyPress:
-    case KeyRelease:
-      if (value) { event->xkey.subwindow = c_value; } else { c_value= event->xkey.subwindow; } break;
-    case MotionNotify:
-      if (value) { event->xmotion.subwindow = c_value; } else { c_value= event->xmotion.subwindow; } break;
-    default: croak("Can't access XEvent.subwindow for type=%d", event->type);
+    if (value) {
+      s->backing_planes= SvUV(value);
+      PUSHs(value);
+    } else {
+      PUSHs(sv_2mortal(newSVuv(s->backing_planes)));
     }
-    PUSHs(value? value : sv_2mortal(newSVuv(c_value)));
 
 void
-_target(event, value=NULL)
-  XEvent *event
-  SV *value
+backing_store(self, value=NULL)
+    XSetWindowAttributes *self
+    SV *value
   INIT:
-    Atom c_value= 0;
+    XSetWindowAttributes *s= self;
   PPCODE:
-    if (value) { c_value= PerlXlib_sv_to_xid(value); }
-    switch (event->type) {
-    case SelectionNotify:
-      if (value) { event->xselection.target = c_value; } else { c_value= event->xselection.target; } break;
-    case SelectionRequest:
-      if (value) { event->xselectionrequest.target = c_value; } else { c_value= event->xselectionrequest.target; } break;
-    default: croak("Can't access XEvent.target for type=%d", event->type);
+    if (value) {
+      s->backing_store= SvIV(value);
+      PUSHs(value);
+    } else {
+      PUSHs(sv_2mortal(newSViv(s->backing_store)));
     }
-    PUSHs(value? value : sv_2mortal(newSVuv(c_value)));
 
 void
-_time(event, value=NULL)
-  XEvent *event
-  SV *value
+bit_gravity(self, value=NULL)
+    XSetWindowAttributes *self
+    SV *value
   INIT:
-    Time c_value= 0;
+    XSetWindowAttributes *s= self;
   PPCODE:
-    if (value) { c_value= SvUV(value); }
-    switch (event->type) {
-    case ButtonPress:
-    case ButtonRelease:
-      if (value) { event->xbutton.time = c_value; } else { c_value= event->xbutton.time; } break;
-    case EnterNotify:
-    case LeaveNotify:
-      if (value) { event->xcrossing.time = c_value; } else { c_value= event->xcrossing.time; } break;
-    case KeyPress:
-    case KeyRelease:
-      if (value) { event->xkey.time = c_value; } else { c_value= event->xkey.time; } break;
-    case MotionNotify:
-      if (value) { event->xmotion.time = c_value; } else { c_value= event->xmotion.time; } break;
-    case PropertyNotify:
-      if (value) { event->xproperty.time = c_value; } else { c_value= event->xproperty.time; } break;
-    case SelectionNotify:
-      if (value) { event->xselection.time = c_value; } else { c_value= event->xselection.time; } break;
-    case SelectionClear:
-      if (value) { event->xselectionclear.time = c_value; } else { c_value= event->xselectionclear.time; } break;
-    case SelectionRequest:
-      if (value) { event->xselectionrequest.time = c_value; } else { c_value= event->xselectionrequest.time; } break;
-    default: croak("Can't access XEvent.time for type=%d", event->type);
+    if (value) {
+      s->bit_gravity= SvIV(value);
+      PUSHs(value);
+    } else {
+      PUSHs(sv_2mortal(newSViv(s->bit_gravity)));
     }
-    PUSHs(value? value : sv_2mortal(newSVuv(c_value)));
 
 void
-type(event, value=NULL)
-  XEvent *event
-  SV *value
+border_pixel(self, value=NULL)
+    XSetWindowAttributes *self
+    SV *value
   INIT:
-    const char *oldpkg, *newpkg;
+    XSetWindowAttributes *s= self;
   PPCODE:
     if (value) {
-      if (event->type != SvIV(value)) {
-        oldpkg= PerlXlib_xevent_pkg_for_type(event->type);
-        event->type= SvIV(value);
-        newpkg= PerlXlib_xevent_pkg_for_type(event->type);
-        if (oldpkg != newpkg) {
-          /* re-initialize all fields in the area that changed */
-          memset( ((char*)(void*)event) + sizeof(XAnyEvent), 0, sizeof(XEvent)-sizeof(XAnyEvent) );
-          /* re-bless the object if the thing passed to us was actually an object */
-          if (sv_derived_from(ST(0), "X11::Xlib::XEvent"))
-            sv_bless(ST(0), gv_stashpv(newpkg, GV_ADD));
-        }
-      }
+      s->border_pixel= SvUV(value);
+      PUSHs(value);
+    } else {
+      PUSHs(sv_2mortal(newSVuv(s->border_pixel)));
     }
-    PUSHs(sv_2mortal(newSViv(event->type)));
 
 void
-_value_mask(event, value=NULL)
-  XEvent *event
-  SV *value
+border_pixmap(self, value=NULL)
+    XSetWindowAttributes *self
+    SV *value
   INIT:
-    unsigned long c_value= 0;
+    XSetWindowAttributes *s= self;
   PPCODE:
-    if (value) { c_value= SvUV(value); }
-    switch (event->type) {
-    case ConfigureRequest:
-      if (value) { event->xconfigurerequest.value_mask = c_value; } else { c_value= event->xconfigurerequest.value_mask; } break;
-    default: croak("Can't access XEvent.value_mask for type=%d", event->type);
+    if (value) {
+      s->border_pixmap= PerlXlib_sv_to_xid(value);
+      PUSHs(value);
+    } else {
+      PUSHs(sv_2mortal(newSVuv(s->border_pixmap)));
     }
-    PUSHs(value? value : sv_2mortal(newSVuv(c_value)));
 
 void
-_width(event, value=NULL)
-  XEvent *event
-  SV *value
+colormap(self, value=NULL)
+    XSetWindowAttributes *self
+    SV *value
   INIT:
-    int c_value= 0;
+    XSetWindowAttributes *s= self;
   PPCODE:
-    if (value) { c_value= SvIV(value); }
-    switch (event->type) {
-    case ConfigureNotify:
-      if (value) { event->xconfigure.width = c_value; } else { c_value= event->xconfigure.width; } break;
-    case ConfigureRequest:
-      if (value) { event->xconfigurerequest.width = c_value; } else { c_value= event->xconfigurerequest.width; } break;
-    case CreateNotify:
-      if (value) { event->xcreatewindow.width = c_value; } else { c_value= event->xcreatewindow.width; } break;
-    case Expose:
-      if (value) { event->xexpose.width = c_value; } else { c_value= event->xexpose.width; } break;
-    case GraphicsExpose:
-      if (value) { event->xgraphicsexpose.width = c_value; } else { c_value= event->xgraphicsexpose.width; } break;
-    case ResizeRequest:
-      if (value) { event->xresizerequest.width = c_value; } else { c_value= event->xresizerequest.width; } break;
-    default: croak("Can't access XEvent.width for type=%d", event->type);
+    if (value) {
+      s->colormap= PerlXlib_sv_to_xid(value);
+      PUSHs(value);
+    } else {
+      PUSHs(sv_2mortal(newSVuv(s->colormap)));
     }
-    PUSHs(value? value : sv_2mortal(newSViv(c_value)));
 
 void
-_window(event, value=NULL)
-  XEvent *event
-  SV *value
+cursor(self, value=NULL)
+    XSetWindowAttributes *self
+    SV *value
   INIT:
-    Window c_value= 0;
+    XSetWindowAttributes *s= self;
   PPCODE:
-    if (value) { c_value= PerlXlib_sv_to_xid(value); }
-    switch (event->type) {
-    case ButtonPress:
-    case ButtonRelease:
-      if (value) { event->xbutton.window = c_value; } else { c_value= event->xbutton.window; } break;
-    case CirculateNotify:
-      if (value) { event->xcirculate.window = c_value; } else { c_value= event->xcirculate.window; } break;
-    case CirculateRequest:
-      if (value) { event->xcirculaterequest.window = c_value; } else { c_value= event->xcirculaterequest.window; } break;
-    case ClientMessage:
-      if (value) { event->xclient.window = c_value; } else { c_value= event->xclient.window; } break;
-    case ColormapNotify:
-      if (value) { event->xcolormap.window = c_value; } else { c_value= event->xcolormap.window; } break;
-    case ConfigureNotify:
-      if (value) { event->xconfigure.window = c_value; } else { c_value= event->xconfigure.window; } break;
-    case ConfigureRequest:
-      if (value) { event->xconfigurerequest.window = c_value; } else { c_value= event->xconfigurerequest.window; } break;
-    case CreateNotify:
-      if (value) { event->xcreatewindow.window = c_value; } else { c_value= event->xcreatewindow.window; } break;
-    case EnterNotify:
-    case LeaveNotify:
-      if (value) { event->xcrossing.window = c_value; } else { c_value= event->xcrossing.window; } break;
-    case DestroyNotify:
-      if (value) { event->xdestroywindow.window = c_value; } else { c_value= event->xdestroywindow.window; } break;
-    case Expose:
-      if (value) { event->xexpose.window = c_value; } else { c_value= event->xexpose.window; } break;
-    case FocusIn:
-    case FocusOut:
-      if (value) { event->xfocus.window = c_value; } else { c_value= event->xfocus.window; } break;
-    case GravityNotify:
-      if (value) { event->xgravity.window = c_value; } else { c_value= event->xgravity.window; } break;
-    case KeyPress:
-    case KeyRelease:
-      if (value) { event->xkey.window = c_value; } else { c_value= event->xkey.window; } break;
-    case KeymapNotify:
-      if (value) { event->xkeymap.window = c_value; } else { c_value= event->xkeymap.window; } break;
-    case MapNotify:
-      if (value) { event->xmap.window = c_value; } else { c_value= event->xmap.window; } break;
-    case MappingNotify:
-      if (value) { event->xmapping.window = c_value; } else { c_value= event->xmapping.window; } break;
-    case MapRequest:
-      if (value) { event->xmaprequest.window = c_value; } else { c_value= event->xmaprequest.window; } break;
-    case MotionNotify:
-      if (value) { event->xmotion.window = c_value; } else { c_value= event->xmotion.window; } break;
-    case PropertyNotify:
-      if (value) { event->xproperty.window = c_value; } else { c_value= event->xproperty.window; } break;
-    case ReparentNotify:
-      if (value) { event->xreparent.window = c_value; } else { c_value= event->xreparent.window; } break;
-    case ResizeRequest:
-      if (value) { event->xresizerequest.window = c_value; } else { c_value= event->xresizerequest.window; } break;
-    case SelectionClear:
-      if (value) { event->xselectionclear.window = c_value; } else { c_value= event->xselectionclear.window; } break;
-    case UnmapNotify:
-      if (value) { event->xunmap.window = c_value; } else { c_value= event->xunmap.window; } break;
-    case VisibilityNotify:
-      if (value) { event->xvisibility.window = c_value; } else { c_value= event->xvisibility.window; } break;
-    default: croak("Can't access XEvent.window for type=%d", event->type);
+    if (value) {
+      s->cursor= PerlXlib_sv_to_xid(value);
+      PUSHs(value);
+    } else {
+      PUSHs(sv_2mortal(newSVuv(s->cursor)));
     }
-    PUSHs(value? value : sv_2mortal(newSVuv(c_value)));
 
 void
-_x(event, value=NULL)
-  XEvent *event
-  SV *value
+do_not_propagate_mask(self, value=NULL)
+    XSetWindowAttributes *self
+    SV *value
   INIT:
-    int c_value= 0;
+    XSetWindowAttributes *s= self;
   PPCODE:
-    if (value) { c_value= SvIV(value); }
-    switch (event->type) {
-    case ButtonPress:
-    case ButtonRelease:
-      if (value) { event->xbutton.x = c_value; } else { c_value= event->xbutton.x; } break;
-    case ConfigureNotify:
-      if (value) { event->xconfigure.x = c_value; } else { c_value= event->xconfigure.x; } break;
-    case ConfigureRequest:
-      if (value) { event->xconfigurerequest.x = c_value; } else { c_value= event->xconfigurerequest.x; } break;
-    case CreateNotify:
-      if (value) { event->xcreatewindow.x = c_value; } else { c_value= event->xcreatewindow.x; } break;
-    case EnterNotify:
-    case LeaveNotify:
-      if (value) { event->xcrossing.x = c_value; } else { c_value= event->xcrossing.x; } break;
-    case Expose:
-      if (value) { event->xexpose.x = c_value; } else { c_value= event->xexpose.x; } break;
-    case GraphicsExpose:
-      if (value) { event->xgraphicsexpose.x = c_value; } else { c_value= event->xgraphicsexpose.x; } break;
-    case GravityNotify:
-      if (value) { event->xgravity.x = c_value; } else { c_value= event->xgravity.x; } break;
-    case KeyPress:
-    case KeyRelease:
-      if (value) { event->xkey.x = c_value; } else { c_value= event->xkey.x; } break;
-    case MotionNotify:
-      if (value) { event->xmotion.x = c_value; } else { c_value= event->xmotion.x; } break;
-    case ReparentNotify:
-      if (value) { event->xreparent.x = c_value; } else { c_value= event->xreparent.x; } break;
-    default: croak("Can't access XEvent.x for type=%d", event->type);
+    if (value) {
+      s->do_not_propagate_mask= SvIV(value);
+      PUSHs(value);
+    } else {
+      PUSHs(sv_2mortal(newSViv(s->do_not_propagate_mask)));
     }
-    PUSHs(value? value : sv_2mortal(newSViv(c_value)));
 
 void
-_x_root(event, value=NULL)
-  XEvent *event
-  SV *value
+event_mask(self, value=NULL)
+    XSetWindowAttributes *self
+    SV *value
   INIT:
-    int c_value= 0;
+    XSetWindowAttributes *s= self;
   PPCODE:
-    if (value) { c_value= SvIV(value); }
-    switch (event->type) {
-    case ButtonPress:
-    case ButtonRelease:
-      if (value) { event->xbutton.x_root = c_value; } else { c_value= event->xbutton.x_root; } break;
-    case EnterNotify:
-    case LeaveNotify:
-      if (value) { event->xcrossing.x_root = c_value; } else { c_value= event->xcrossing.x_root; } break;
-    case KeyPress:
-    case KeyRelease:
-      if (value) { event->xkey.x_root = c_value; } else { c_value= event->xkey.x_root; } break;
-    case MotionNotify:
-      if (value) { event->xmotion.x_root = c_value; } else { c_value= event->xmotion.x_root; } break;
-    default: croak("Can't access XEvent.x_root for type=%d", event->type);
+    if (value) {
+      s->event_mask= SvIV(value);
+      PUSHs(value);
+    } else {
+      PUSHs(sv_2mortal(newSViv(s->event_mask)));
     }
-    PUSHs(value? value : sv_2mortal(newSViv(c_value)));
 
 void
-_y(event, value=NULL)
-  XEvent *event
-  SV *value
+override_redirect(self, value=NULL)
+    XSetWindowAttributes *self
+    SV *value
   INIT:
-    int c_value= 0;
+    XSetWindowAttributes *s= self;
   PPCODE:
-    if (value) { c_value= SvIV(value); }
-    switch (event->type) {
-    case ButtonPress:
-    case ButtonRelease:
-      if (value) { event->xbutton.y = c_value; } else { c_value= event->xbutton.y; } break;
-    case ConfigureNotify:
-      if (value) { event->xconfigure.y = c_value; } else { c_value= event->xconfigure.y; } break;
-    case ConfigureRequest:
-      if (value) { event->xconfigurerequest.y = c_value; } else { c_value= event->xconfigurerequest.y; } break;
-    case CreateNotify:
-      if (value) { event->xcreatewindow.y = c_value; } else { c_value= event->xcreatewindow.y; } break;
-    case EnterNotify:
-    case LeaveNotify:
-      if (value) { event->xcrossing.y = c_value; } else { c_value= event->xcrossing.y; } break;
-    case Expose:
-      if (value) { event->xexpose.y = c_value; } else { c_value= event->xexpose.y; } break;
-    case GraphicsExpose:
-      if (value) { event->xgraphicsexpose.y = c_value; } else { c_value= event->xgraphicsexpose.y; } break;
-    case GravityNotify:
-      if (value) { event->xgravity.y = c_value; } else { c_value= event->xgravity.y; } break;
-    case KeyPress:
-    case KeyRelease:
-      if (value) { event->xkey.y = c_value; } else { c_value= event->xkey.y; } break;
-    case MotionNotify:
-      if (value) { event->xmotion.y = c_value; } else { c_value= event->xmotion.y; } break;
-    case ReparentNotify:
-      if (value) { event->xreparent.y = c_value; } else { c_value= event->xreparent.y; } break;
-    default: croak("Can't access XEvent.y for type=%d", event->type);
+    if (value) {
+      s->override_redirect= SvIV(value);
+      PUSHs(value);
+    } else {
+      PUSHs(sv_2mortal(newSViv(s->override_redirect)));
     }
-    PUSHs(value? value : sv_2mortal(newSViv(c_value)));
 
 void
-_y_root(event, value=NULL)
-  XEvent *event
-  SV *value
+save_under(self, value=NULL)
+    XSetWindowAttributes *self
+    SV *value
   INIT:
-    int c_value= 0;
+    XSetWindowAttributes *s= self;
   PPCODE:
-    if (value) { c_value= SvIV(value); }
-    switch (event->type) {
-    case ButtonPress:
-    case ButtonRelease:
-      if (value) { event->xbutton.y_root = c_value; } else { c_value= event->xbutton.y_root; } break;
-    case EnterNotify:
-    case LeaveNotify:
-      if (value) { event->xcrossing.y_root = c_value; } else { c_value= event->xcrossing.y_root; } break;
-    case KeyPress:
-    case KeyRelease:
-      if (value) { event->xkey.y_root = c_value; } else { c_value= event->xkey.y_root; } break;
-    case MotionNotify:
-      if (value) { event->xmotion.y_root = c_value; } else { c_value= event->xmotion.y_root; } break;
-    default: croak("Can't access XEvent.y_root for type=%d", event->type);
+    if (value) {
+      s->save_under= SvIV(value);
+      PUSHs(value);
+    } else {
+      PUSHs(sv_2mortal(newSViv(s->save_under)));
     }
-    PUSHs(value? value : sv_2mortal(newSViv(c_value)));
 
-# END GENERATED X11_Xlib_XEvent
+void
+win_gravity(self, value=NULL)
+    XSetWindowAttributes *self
+    SV *value
+  INIT:
+    XSetWindowAttributes *s= self;
+  PPCODE:
+    if (value) {
+      s->win_gravity= SvIV(value);
+      PUSHs(value);
+    } else {
+      PUSHs(sv_2mortal(newSViv(s->win_gravity)));
+    }
+
+# END GENERATED X11_Xlib_XSetWindowAttributes
 # ----------------------------------------------------------------------------
-# BEGIN GENERATED X11_Xlib_XVisualInfo
+# BEGIN GENERATED X11_Xlib_XSizeHints
 
-MODULE = X11::Xlib                PACKAGE = X11::Xlib::XVisualInfo
+MODULE = X11::Xlib                PACKAGE = X11::Xlib::XSizeHints
 
 int
 _sizeof(ignored=NULL)
     SV* ignored;
     CODE:
-        RETVAL = sizeof(XVisualInfo);
+        RETVAL = sizeof(XSizeHints);
     OUTPUT:
         RETVAL
 
@@ -3234,287 +7174,256 @@ _initialize(s)
     INIT:
         void *sptr;
     PPCODE:
-        sptr= PerlXlib_get_struct_ptr(s, 1, "X11::Xlib::XVisualInfo", sizeof(XVisualInfo),
-            (PerlXlib_struct_pack_fn*) &PerlXlib_XVisualInfo_pack
+        sptr= PerlXlib_get_struct_ptr(s, 1, "X11::Xlib::XSizeHints", sizeof(XSizeHints),
+            (PerlXlib_struct_pack_fn*) &PerlXlib_XSizeHints_pack
         );
-        memset((void*) sptr, 0, sizeof(XVisualInfo));
+        memset((void*) sptr, 0, sizeof(XSizeHints));
 
 void
 _pack(s, fields, consume=0)
-    XVisualInfo *s
+    XSizeHints *s
     HV *fields
     Bool consume
     PPCODE:
-        PerlXlib_XVisualInfo_pack(s, fields, consume);
+        PerlXlib_XSizeHints_pack(s, fields, consume);
 
 void
 _unpack(s, fields)
-    XVisualInfo *s
+    XSizeHints *s
     HV *fields
     PPCODE:
-        PerlXlib_XVisualInfo_unpack_obj(s, fields, ST(0));
+        PerlXlib_XSizeHints_unpack_obj(s, fields, ST(0));
 
 void
-bits_per_rgb(self, value=NULL)
-    XVisualInfo *self
+base_height(self, value=NULL)
+    XSizeHints *self
     SV *value
   INIT:
-    XVisualInfo *s= self;
+    XSizeHints *s= self;
   PPCODE:
     if (value) {
-      s->bits_per_rgb= SvIV(value);
+      s->base_height= SvIV(value);
       PUSHs(value);
     } else {
-      PUSHs(sv_2mortal(newSViv(s->bits_per_rgb)));
+      PUSHs(sv_2mortal(newSViv(s->base_height)));
     }
 
 void
-blue_mask(self, value=NULL)
-    XVisualInfo *self
+base_width(self, value=NULL)
+    XSizeHints *self
     SV *value
   INIT:
-    XVisualInfo *s= self;
+    XSizeHints *s= self;
   PPCODE:
     if (value) {
-      s->blue_mask= SvUV(value);
+      s->base_width= SvIV(value);
       PUSHs(value);
     } else {
-      PUSHs(sv_2mortal(newSVuv(s->blue_mask)));
+      PUSHs(sv_2mortal(newSViv(s->base_width)));
     }
 
 void
-class(self, value=NULL)
-    XVisualInfo *self
+flags(self, value=NULL)
+    XSizeHints *self
     SV *value
   INIT:
-    XVisualInfo *s= self;
+    XSizeHints *s= self;
   PPCODE:
     if (value) {
-      s->class= SvIV(value);
+      s->flags= SvIV(value);
       PUSHs(value);
     } else {
-      PUSHs(sv_2mortal(newSViv(s->class)));
+      PUSHs(sv_2mortal(newSViv(s->flags)));
     }
 
 void
-colormap_size(self, value=NULL)
-    XVisualInfo *self
+height(self, value=NULL)
+    XSizeHints *self
     SV *value
   INIT:
-    XVisualInfo *s= self;
+    XSizeHints *s= self;
   PPCODE:
     if (value) {
-      s->colormap_size= SvIV(value);
+      s->height= SvIV(value);
       PUSHs(value);
     } else {
-      PUSHs(sv_2mortal(newSViv(s->colormap_size)));
+      PUSHs(sv_2mortal(newSViv(s->height)));
     }
 
 void
-depth(self, value=NULL)
-    XVisualInfo *self
+height_inc(self, value=NULL)
+    XSizeHints *self
     SV *value
   INIT:
-    XVisualInfo *s= self;
+    XSizeHints *s= self;
   PPCODE:
     if (value) {
-      s->depth= SvIV(value);
+      s->height_inc= SvIV(value);
       PUSHs(value);
     } else {
-      PUSHs(sv_2mortal(newSViv(s->depth)));
+      PUSHs(sv_2mortal(newSViv(s->height_inc)));
     }
 
 void
-green_mask(self, value=NULL)
-    XVisualInfo *self
+max_aspect_x(self, value=NULL)
+    XSizeHints *self
     SV *value
   INIT:
-    XVisualInfo *s= self;
+    XSizeHints *s= self;
   PPCODE:
     if (value) {
-      s->green_mask= SvUV(value);
+      s->max_aspect.x= SvIV(value);
       PUSHs(value);
     } else {
-      PUSHs(sv_2mortal(newSVuv(s->green_mask)));
+      PUSHs(sv_2mortal(newSViv(s->max_aspect.x)));
     }
 
 void
-red_mask(self, value=NULL)
-    XVisualInfo *self
+max_aspect_y(self, value=NULL)
+    XSizeHints *self
     SV *value
   INIT:
-    XVisualInfo *s= self;
+    XSizeHints *s= self;
   PPCODE:
     if (value) {
-      s->red_mask= SvUV(value);
+      s->max_aspect.y= SvIV(value);
       PUSHs(value);
     } else {
-      PUSHs(sv_2mortal(newSVuv(s->red_mask)));
+      PUSHs(sv_2mortal(newSViv(s->max_aspect.y)));
     }
 
 void
-screen(self, value=NULL)
-    XVisualInfo *self
+max_height(self, value=NULL)
+    XSizeHints *self
     SV *value
   INIT:
-    XVisualInfo *s= self;
+    XSizeHints *s= self;
   PPCODE:
     if (value) {
-      s->screen= SvIV(value);
+      s->max_height= SvIV(value);
       PUSHs(value);
     } else {
-      PUSHs(sv_2mortal(newSViv(s->screen)));
+      PUSHs(sv_2mortal(newSViv(s->max_height)));
     }
 
 void
-visual(self, value=NULL)
-    SV *self
+max_width(self, value=NULL)
+    XSizeHints *self
     SV *value
   INIT:
-    XVisualInfo *s= ( XVisualInfo * ) PerlXlib_get_struct_ptr(
-           self, 0, "X11::Xlib::XVisualInfo", sizeof(XVisualInfo),
-           (PerlXlib_struct_pack_fn*) &PerlXlib_XVisualInfo_pack
-         );
-         SV *dpy_sv= PerlXlib_objref_get_display(self);
-         Display *dpy= PerlXlib_display_objref_get_pointer(dpy_sv, PerlXlib_OR_NULL);
+    XSizeHints *s= self;
   PPCODE:
     if (value) {
-      s->visual= (Visual *) PerlXlib_objref_get_pointer(value, "Visual", PerlXlib_OR_NULL);
+      s->max_width= SvIV(value);
       PUSHs(value);
     } else {
-      PUSHs(sv_mortalcopy(PerlXlib_get_objref(s->visual, PerlXlib_AUTOCREATE, "Visual", SVt_PVMG, "X11::Xlib::Visual", dpy)));
+      PUSHs(sv_2mortal(newSViv(s->max_width)));
     }
 
 void
-visualid(self, value=NULL)
-    XVisualInfo *self
+min_aspect_x(self, value=NULL)
+    XSizeHints *self
     SV *value
   INIT:
-    XVisualInfo *s= self;
+    XSizeHints *s= self;
   PPCODE:
     if (value) {
-      s->visualid= SvUV(value);
+      s->min_aspect.x= SvIV(value);
       PUSHs(value);
     } else {
-      PUSHs(sv_2mortal(newSVuv(s->visualid)));
+      PUSHs(sv_2mortal(newSViv(s->min_aspect.x)));
     }
 
-# END GENERATED X11_Xlib_XVisualInfo
-# ----------------------------------------------------------------------------
-# BEGIN GENERATED X11_Xlib_XWindowChanges
-
-MODULE = X11::Xlib                PACKAGE = X11::Xlib::XWindowChanges
-
-int
-_sizeof(ignored=NULL)
-    SV* ignored;
-    CODE:
-        RETVAL = sizeof(XWindowChanges);
-    OUTPUT:
-        RETVAL
-
-void
-_initialize(s)
-    SV *s
-    INIT:
-        void *sptr;
-    PPCODE:
-        sptr= PerlXlib_get_struct_ptr(s, 1, "X11::Xlib::XWindowChanges", sizeof(XWindowChanges),
-            (PerlXlib_struct_pack_fn*) &PerlXlib_XWindowChanges_pack
-        );
-        memset((void*) sptr, 0, sizeof(XWindowChanges));
-
-void
-_pack(s, fields, consume=0)
-    XWindowChanges *s
-    HV *fields
-    Bool consume
-    PPCODE:
-        PerlXlib_XWindowChanges_pack(s, fields, consume);
-
 void
-_unpack(s, fields)
-    XWindowChanges *s
-    HV *fields
-    PPCODE:
-        PerlXlib_XWindowChanges_unpack_obj(s, fields, ST(0));
+min_aspect_y(self, value=NULL)
+    XSizeHints *self
+    SV *value
+  INIT:
+    XSizeHints *s= self;
+  PPCODE:
+    if (value) {
+      s->min_aspect.y= SvIV(value);
+      PUSHs(value);
+    } else {
+      PUSHs(sv_2mortal(newSViv(s->min_aspect.y)));
+    }
 
 void
-border_width(self, value=NULL)
-    XWindowChanges *self
+min_height(self, value=NULL)
+    XSizeHints *self
     SV *value
   INIT:
-    XWindowChanges *s= self;
+    XSizeHints *s= self;
   PPCODE:
     if (value) {
-      s->border_width= SvIV(value);
+      s->min_height= SvIV(value);
       PUSHs(value);
     } else {
-      PUSHs(sv_2mortal(newSViv(s->border_width)));
+      PUSHs(sv_2mortal(newSViv(s->min_height)));
     }
 
 void
-height(self, value=NULL)
-    XWindowChanges *self
+min_width(self, value=NULL)
+    XSizeHints *self
     SV *value
   INIT:
-    XWindowChanges *s= self;
+    XSizeHints *s= self;
   PPCODE:
     if (value) {
-      s->height= SvIV(value);
+      s->min_width= SvIV(value);
       PUSHs(value);
     } else {
-      PUSHs(sv_2mortal(newSViv(s->height)));
+      PUSHs(sv_2mortal(newSViv(s->min_width)));
     }
 
 void
-sibling(self, value=NULL)
-    XWindowChanges *self
+width(self, value=NULL)
+    XSizeHints *self
     SV *value
   INIT:
-    XWindowChanges *s= self;
+    XSizeHints *s= self;
   PPCODE:
     if (value) {
-      s->sibling= PerlXlib_sv_to_xid(value);
+      s->width= SvIV(value);
       PUSHs(value);
     } else {
-      PUSHs(sv_2mortal(newSVuv(s->sibling)));
+      PUSHs(sv_2mortal(newSViv(s->width)));
     }
 
 void
-stack_mode(self, value=NULL)
-    XWindowChanges *self
+width_inc(self, value=NULL)
+    XSizeHints *self
     SV *value
   INIT:
-    XWindowChanges *s= self;
+    XSizeHints *s= self;
   PPCODE:
     if (value) {
-      s->stack_mode= SvIV(value);
+      s->width_inc= SvIV(value);
       PUSHs(value);
     } else {
-      PUSHs(sv_2mortal(newSViv(s->stack_mode)));
+      PUSHs(sv_2mortal(newSViv(s->width_inc)));
     }
 
 void
-width(self, value=NULL)
-    XWindowChanges *self
+win_gravity(self, value=NULL)
+    XSizeHints *self
     SV *value
   INIT:
-    XWindowChanges *s= self;
+    XSizeHints *s= self;
   PPCODE:
     if (value) {
-      s->width= SvIV(value);
+      s->win_gravity= SvIV(value);
       PUSHs(value);
     } else {
-      PUSHs(sv_2mortal(newSViv(s->width)));
+      PUSHs(sv_2mortal(newSViv(s->win_gravity)));
     }
 
 void
 x(self, value=NULL)
-    XWindowChanges *self
+    XSizeHints *self
     SV *value
   INIT:
-    XWindowChanges *s= self;
+    XSizeHints *s= self;
   PPCODE:
     if (value) {
       s->x= SvIV(value);
@@ -3525,10 +7434,10 @@ x(self, value=NULL)
 
 void
 y(self, value=NULL)
-    XWindowChanges *self
+    XSizeHints *self
     SV *value
   INIT:
-    XWindowChanges *s= self;
+    XSizeHints *s= self;
   PPCODE:
     if (value) {
       s->y= SvIV(value);
@@ -3537,17 +7446,17 @@ y(self, value=NULL)
       PUSHs(sv_2mortal(newSViv(s->y)));
     }
 
-# END GENERATED X11_Xlib_XWindowChanges
+# END GENERATED X11_Xlib_XSizeHints
 # ----------------------------------------------------------------------------
-# BEGIN GENERATED X11_Xlib_XWindowAttributes
+# BEGIN GENERATED X11_Xlib_XRectangle
 
-MODULE = X11::Xlib                PACKAGE = X11::Xlib::XWindowAttributes
+MODULE = X11::Xlib                PACKAGE = X11::Xlib::XRectangle
 
 int
 _sizeof(ignored=NULL)
     SV* ignored;
     CODE:
-        RETVAL = sizeof(XWindowAttributes);
+        RETVAL = sizeof(XRectangle);
     OUTPUT:
         RETVAL
 
@@ -3557,130 +7466,128 @@ _initialize(s)
     INIT:
         void *sptr;
     PPCODE:
-        sptr= PerlXlib_get_struct_ptr(s, 1, "X11::Xlib::XWindowAttributes", sizeof(XWindowAttributes),
-            (PerlXlib_struct_pack_fn*) &PerlXlib_XWindowAttributes_pack
+        sptr= PerlXlib_get_struct_ptr(s, 1, "X11::Xlib::XRectangle", sizeof(XRectangle),
+            (PerlXlib_struct_pack_fn*) &PerlXlib_XRectangle_pack
         );
-        memset((void*) sptr, 0, sizeof(XWindowAttributes));
+        memset((void*) sptr, 0, sizeof(XRectangle));
 
 void
 _pack(s, fields, consume=0)
-    XWindowAttributes *s
+    XRectangle *s
     HV *fields
     Bool consume
     PPCODE:
-        PerlXlib_XWindowAttributes_pack(s, fields, consume);
+        PerlXlib_XRectangle_pack(s, fields, consume);
 
 void
 _unpack(s, fields)
-    XWindowAttributes *s
+    XRectangle *s
     HV *fields
     PPCODE:
-        PerlXlib_XWindowAttributes_unpack_obj(s, fields, ST(0));
+        PerlXlib_XRectangle_unpack_obj(s, fields, ST(0));
 
 void
-all_event_masks(self, value=NULL)
-    XWindowAttributes *self
+height(self, value=NULL)
+    XRectangle *self
     SV *value
   INIT:
-    XWindowAttributes *s= self;
+    XRectangle *s= self;
   PPCODE:
     if (value) {
-      s->all_event_masks= SvIV(value);
+      s->height= SvUV(value);
       PUSHs(value);
     } else {
-      PUSHs(sv_2mortal(newSViv(s->all_event_masks)));
+      PUSHs(sv_2mortal(newSVuv(s->height)));
     }
 
 void
-backing_pixel(self, value=NULL)
-    XWindowAttributes *self
+width(self, value=NULL)
+    XRectangle *self
     SV *value
   INIT:
-    XWindowAttributes *s= self;
+    XRectangle *s= self;
   PPCODE:
     if (value) {
-      s->backing_pixel= SvUV(value);
+      s->width= SvUV(value);
       PUSHs(value);
     } else {
-      PUSHs(sv_2mortal(newSVuv(s->backing_pixel)));
+      PUSHs(sv_2mortal(newSVuv(s->width)));
     }
 
 void
-backing_planes(self, value=NULL)
-    XWindowAttributes *self
+x(self, value=NULL)
+    XRectangle *self
     SV *value
   INIT:
-    XWindowAttributes *s= self;
+    XRectangle *s= self;
   PPCODE:
     if (value) {
-      s->backing_planes= SvUV(value);
+      s->x= SvIV(value);
       PUSHs(value);
     } else {
-      PUSHs(sv_2mortal(newSVuv(s->backing_planes)));
+      PUSHs(sv_2mortal(newSViv(s->x)));
     }
 
 void
-backing_store(self, value=NULL)
-    XWindowAttributes *self
+y(self, value=NULL)
+    XRectangle *self
     SV *value
   INIT:
-    XWindowAttributes *s= self;
+    XRectangle *s= self;
   PPCODE:
     if (value) {
-      s->backing_store= SvIV(value);
+      s->y= SvIV(value);
       PUSHs(value);
     } else {
-      PUSHs(sv_2mortal(newSViv(s->backing_store)));
+      PUSHs(sv_2mortal(newSViv(s->y)));
     }
 
+# END GENERATED X11_Xlib_XRectangle
+# ----------------------------------------------------------------------------
+# BEGIN GENERATED X11_Xlib_XRenderPictFormat
+
+MODULE = X11::Xlib                PACKAGE = X11::Xlib::XRenderPictFormat
+
+int
+_sizeof(ignored=NULL)
+    SV* ignored;
+    CODE:
+        RETVAL = sizeof(XRenderPictFormat);
+    OUTPUT:
+        RETVAL
+
 void
-bit_gravity(self, value=NULL)
-    XWindowAttributes *self
-    SV *value
-  INIT:
-    XWindowAttributes *s= self;
-  PPCODE:
-    if (value) {
-      s->bit_gravity= SvIV(value);
-      PUSHs(value);
-    } else {
-      PUSHs(sv_2mortal(newSViv(s->bit_gravity)));
-    }
+_initialize(s)
+    SV *s
+    INIT:
+        void *sptr;
+    PPCODE:
+        sptr= PerlXlib_get_struct_ptr(s, 1, "X11::Xlib::XRenderPictFormat", sizeof(XRenderPictFormat),
+            (PerlXlib_struct_pack_fn*) &PerlXlib_XRenderPictFormat_pack
+        );
+        memset((void*) sptr, 0, sizeof(XRenderPictFormat));
 
 void
-border_width(self, value=NULL)
-    XWindowAttributes *self
-    SV *value
-  INIT:
-    XWindowAttributes *s= self;
-  PPCODE:
-    if (value) {
-      s->border_width= SvIV(value);
-      PUSHs(value);
-    } else {
-      PUSHs(sv_2mortal(newSViv(s->border_width)));
-    }
+_pack(s, fields, consume=0)
+    XRenderPictFormat *s
+    HV *fields
+    Bool consume
+    PPCODE:
+        PerlXlib_XRenderPictFormat_pack(s, fields, consume);
 
 void
-class(self, value=NULL)
-    XWindowAttributes *self
-    SV *value
-  INIT:
-    XWindowAttributes *s= self;
-  PPCODE:
-    if (value) {
-      s->class= SvIV(value);
-      PUSHs(value);
-    } else {
-      PUSHs(sv_2mortal(newSViv(s->class)));
-    }
+_unpack(s, fields)
+    XRenderPictFormat *s
+    HV *fields
+    PPCODE:
+        PerlXlib_XRenderPictFormat_unpack_obj(s, fields, ST(0));
 
 void
 colormap(self, value=NULL)
-    XWindowAttributes *self
+    XRenderPictFormat *self
     SV *value
   INIT:
-    XWindowAttributes *s= self;
+    XRenderPictFormat *s= self;
   PPCODE:
     if (value) {
       s->colormap= PerlXlib_sv_to_xid(value);
@@ -3691,10 +7598,10 @@ colormap(self, value=NULL)
 
 void
 depth(self, value=NULL)
-    XWindowAttributes *self
+    XRenderPictFormat *self
     SV *value
   INIT:
-    XWindowAttributes *s= self;
+    XRenderPictFormat *s= self;
   PPCODE:
     if (value) {
       s->depth= SvIV(value);
@@ -3704,217 +7611,156 @@ depth(self, value=NULL)
     }
 
 void
-do_not_propagate_mask(self, value=NULL)
-    XWindowAttributes *self
-    SV *value
-  INIT:
-    XWindowAttributes *s= self;
-  PPCODE:
-    if (value) {
-      s->do_not_propagate_mask= SvIV(value);
-      PUSHs(value);
-    } else {
-      PUSHs(sv_2mortal(newSViv(s->do_not_propagate_mask)));
-    }
-
-void
-height(self, value=NULL)
-    XWindowAttributes *self
-    SV *value
-  INIT:
-    XWindowAttributes *s= self;
-  PPCODE:
-    if (value) {
-      s->height= SvIV(value);
-      PUSHs(value);
-    } else {
-      PUSHs(sv_2mortal(newSViv(s->height)));
-    }
-
-void
-map_installed(self, value=NULL)
-    XWindowAttributes *self
-    SV *value
-  INIT:
-    XWindowAttributes *s= self;
-  PPCODE:
-    if (value) {
-      s->map_installed= SvIV(value);
-      PUSHs(value);
-    } else {
-      PUSHs(sv_2mortal(newSViv(s->map_installed)));
-    }
-
-void
-map_state(self, value=NULL)
-    XWindowAttributes *self
-    SV *value
-  INIT:
-    XWindowAttributes *s= self;
-  PPCODE:
-    if (value) {
-      s->map_state= SvIV(value);
-      PUSHs(value);
-    } else {
-      PUSHs(sv_2mortal(newSViv(s->map_state)));
-    }
-
-void
-override_redirect(self, value=NULL)
-    XWindowAttributes *self
+direct_alpha(self, value=NULL)
+    XRenderPictFormat *self
     SV *value
   INIT:
-    XWindowAttributes *s= self;
+    XRenderPictFormat *s= self;
   PPCODE:
     if (value) {
-      s->override_redirect= SvIV(value);
+      s->direct.alpha= SvIV(value);
       PUSHs(value);
     } else {
-      PUSHs(sv_2mortal(newSViv(s->override_redirect)));
+      PUSHs(sv_2mortal(newSViv(s->direct.alpha)));
     }
 
 void
-root(self, value=NULL)
-    XWindowAttributes *self
+direct_alphaMask(self, value=NULL)
+    XRenderPictFormat *self
     SV *value
   INIT:
-    XWindowAttributes *s= self;
+    XRenderPictFormat *s= self;
   PPCODE:
     if (value) {
-      s->root= PerlXlib_sv_to_xid(value);
+      s->direct.alphaMask= SvIV(value);
       PUSHs(value);
     } else {
-      PUSHs(sv_2mortal(newSVuv(s->root)));
+      PUSHs(sv_2mortal(newSViv(s->direct.alphaMask)));
     }
 
 void
-save_under(self, value=NULL)
-    XWindowAttributes *self
+direct_blue(self, value=NULL)
+    XRenderPictFormat *self
     SV *value
   INIT:
-    XWindowAttributes *s= self;
+    XRenderPictFormat *s= self;
   PPCODE:
     if (value) {
-      s->save_under= SvIV(value);
+      s->direct.blue= SvIV(value);
       PUSHs(value);
     } else {
-      PUSHs(sv_2mortal(newSViv(s->save_under)));
+      PUSHs(sv_2mortal(newSViv(s->direct.blue)));
     }
 
 void
-screen(self, value=NULL)
-    XWindowAttributes *self
+direct_blueMask(self, value=NULL)
+    XRenderPictFormat *self
     SV *value
   INIT:
-    XWindowAttributes *s= self;
+    XRenderPictFormat *s= self;
   PPCODE:
     if (value) {
-      s->screen= PerlXlib_screen_objref_get_pointer(value, PerlXlib_OR_NULL);
+      s->direct.blueMask= SvIV(value);
       PUSHs(value);
     } else {
-      PUSHs(sv_2mortal(newSVsv(PerlXlib_get_screen_objref(s->screen, PerlXlib_OR_UNDEF))));
+      PUSHs(sv_2mortal(newSViv(s->direct.blueMask)));
     }
 
 void
-visual(self, value=NULL)
-    SV *self
+direct_green(self, value=NULL)
+    XRenderPictFormat *self
     SV *value
   INIT:
-    XWindowAttributes *s= ( XWindowAttributes * ) PerlXlib_get_struct_ptr(
-           self, 0, "X11::Xlib::XWindowAttributes", sizeof(XWindowAttributes),
-           (PerlXlib_struct_pack_fn*) &PerlXlib_XWindowAttributes_pack
-         );
-         SV *dpy_sv= PerlXlib_objref_get_display(self);
-         Display *dpy= PerlXlib_display_objref_get_pointer(dpy_sv, PerlXlib_OR_NULL);
+    XRenderPictFormat *s= self;
   PPCODE:
     if (value) {
-      s->visual= (Visual *) PerlXlib_objref_get_pointer(value, "Visual", PerlXlib_OR_NULL);
+      s->direct.green= SvIV(value);
       PUSHs(value);
     } else {
-      PUSHs(sv_mortalcopy(PerlXlib_get_objref(s->visual, PerlXlib_AUTOCREATE, "Visual", SVt_PVMG, "X11::Xlib::Visual", dpy)));
+      PUSHs(sv_2mortal(newSViv(s->direct.green)));
     }
 
 void
-width(self, value=NULL)
-    XWindowAttributes *self
+direct_greenMask(self, value=NULL)
+    XRenderPictFormat *self
     SV *value
   INIT:
-    XWindowAttributes *s= self;
+    XRenderPictFormat *s= self;
   PPCODE:
     if (value) {
-      s->width= SvIV(value);
+      s->direct.greenMask= SvIV(value);
       PUSHs(value);
     } else {
-      PUSHs(sv_2mortal(newSViv(s->width)));
+      PUSHs(sv_2mortal(newSViv(s->direct.greenMask)));
     }
 
 void
-win_gravity(self, value=NULL)
-    XWindowAttributes *self
+direct_red(self, value=NULL)
+    XRenderPictFormat *self
     SV *value
   INIT:
-    XWindowAttributes *s= self;
+    XRenderPictFormat *s= self;
   PPCODE:
     if (value) {
-      s->win_gravity= SvIV(value);
+      s->direct.red= SvIV(value);
       PUSHs(value);
     } else {
-      PUSHs(sv_2mortal(newSViv(s->win_gravity)));
+      PUSHs(sv_2mortal(newSViv(s->direct.red)));
     }
 
 void
-x(self, value=NULL)
-    XWindowAttributes *self
+direct_redMask(self, value=NULL)
+    XRenderPictFormat *self
     SV *value
   INIT:
-    XWindowAttributes *s= self;
+    XRenderPictFormat *s= self;
   PPCODE:
     if (value) {
-      s->x= SvIV(value);
+      s->direct.redMask= SvIV(value);
       PUSHs(value);
     } else {
-      PUSHs(sv_2mortal(newSViv(s->x)));
+      PUSHs(sv_2mortal(newSViv(s->direct.redMask)));
     }
 
 void
-y(self, value=NULL)
-    XWindowAttributes *self
+id(self, value=NULL)
+    XRenderPictFormat *self
     SV *value
   INIT:
-    XWindowAttributes *s= self;
+    XRenderPictFormat *s= self;
   PPCODE:
     if (value) {
-      s->y= SvIV(value);
+      s->id= PerlXlib_sv_to_xid(value);
       PUSHs(value);
     } else {
-      PUSHs(sv_2mortal(newSViv(s->y)));
+      PUSHs(sv_2mortal(newSVuv(s->id)));
     }
 
 void
-your_event_mask(self, value=NULL)
-    XWindowAttributes *self
+type(self, value=NULL)
+    XRenderPictFormat *self
     SV *value
   INIT:
-    XWindowAttributes *s= self;
+    XRenderPictFormat *s= self;
   PPCODE:
     if (value) {
-      s->your_event_mask= SvIV(value);
+      s->type= SvIV(value);
       PUSHs(value);
     } else {
-      PUSHs(sv_2mortal(newSViv(s->your_event_mask)));
+      PUSHs(sv_2mortal(newSViv(s->type)));
     }
 
-# END GENERATED X11_Xlib_XWindowAttributes
+# END GENERATED X11_Xlib_XRenderPictFormat
 # ----------------------------------------------------------------------------
-# BEGIN GENERATED X11_Xlib_XSetWindowAttributes
+# BEGIN GENERATED X11_Xlib_XGCValues
 
-MODULE = X11::Xlib                PACKAGE = X11::Xlib::XSetWindowAttributes
+MODULE = X11::Xlib                PACKAGE = X11::Xlib::XGCValues
 
 int
 _sizeof(ignored=NULL)
     SV* ignored;
     CODE:
-        RETVAL = sizeof(XSetWindowAttributes);
+        RETVAL = sizeof(XGCValues);
     OUTPUT:
         RETVAL
 
@@ -3924,539 +7770,581 @@ _initialize(s)
     INIT:
         void *sptr;
     PPCODE:
-        sptr= PerlXlib_get_struct_ptr(s, 1, "X11::Xlib::XSetWindowAttributes", sizeof(XSetWindowAttributes),
-            (PerlXlib_struct_pack_fn*) &PerlXlib_XSetWindowAttributes_pack
+        sptr= PerlXlib_get_struct_ptr(s, 1, "X11::Xlib::XGCValues", sizeof(XGCValues),
+            (PerlXlib_struct_pack_fn*) &PerlXlib_XGCValues_pack
         );
-        memset((void*) sptr, 0, sizeof(XSetWindowAttributes));
+        memset((void*) sptr, 0, sizeof(XGCValues));
 
 void
 _pack(s, fields, consume=0)
-    XSetWindowAttributes *s
+    XGCValues *s
     HV *fields
     Bool consume
     PPCODE:
-        PerlXlib_XSetWindowAttributes_pack(s, fields, consume);
+        PerlXlib_XGCValues_pack(s, fields, consume);
 
 void
 _unpack(s, fields)
-    XSetWindowAttributes *s
+    XGCValues *s
     HV *fields
     PPCODE:
-        PerlXlib_XSetWindowAttributes_unpack_obj(s, fields, ST(0));
+        PerlXlib_XGCValues_unpack_obj(s, fields, ST(0));
 
 void
-background_pixel(self, value=NULL)
-    XSetWindowAttributes *self
+arc_mode(self, value=NULL)
+    XGCValues *self
     SV *value
   INIT:
-    XSetWindowAttributes *s= self;
+    XGCValues *s= self;
   PPCODE:
     if (value) {
-      s->background_pixel= SvUV(value);
+      s->arc_mode= SvIV(value);
       PUSHs(value);
     } else {
-      PUSHs(sv_2mortal(newSVuv(s->background_pixel)));
+      PUSHs(sv_2mortal(newSViv(s->arc_mode)));
     }
 
 void
-background_pixmap(self, value=NULL)
-    XSetWindowAttributes *self
+background(self, value=NULL)
+    XGCValues *self
     SV *value
   INIT:
-    XSetWindowAttributes *s= self;
+    XGCValues *s= self;
   PPCODE:
     if (value) {
-      s->background_pixmap= PerlXlib_sv_to_xid(value);
+      s->background= SvUV(value);
       PUSHs(value);
     } else {
-      PUSHs(sv_2mortal(newSVuv(s->background_pixmap)));
+      PUSHs(sv_2mortal(newSVuv(s->background)));
     }
 
 void
-backing_pixel(self, value=NULL)
-    XSetWindowAttributes *self
+cap_style(self, value=NULL)
+    XGCValues *self
     SV *value
   INIT:
-    XSetWindowAttributes *s= self;
+    XGCValues *s= self;
   PPCODE:
     if (value) {
-      s->backing_pixel= SvUV(value);
+      s->cap_style= SvIV(value);
       PUSHs(value);
     } else {
-      PUSHs(sv_2mortal(newSVuv(s->backing_pixel)));
+      PUSHs(sv_2mortal(newSViv(s->cap_style)));
     }
 
 void
-backing_planes(self, value=NULL)
-    XSetWindowAttributes *self
+clip_mask(self, value=NULL)
+    XGCValues *self
     SV *value
   INIT:
-    XSetWindowAttributes *s= self;
+    XGCValues *s= self;
   PPCODE:
     if (value) {
-      s->backing_planes= SvUV(value);
+      s->clip_mask= PerlXlib_sv_to_xid(value);
       PUSHs(value);
     } else {
-      PUSHs(sv_2mortal(newSVuv(s->backing_planes)));
+      PUSHs(sv_2mortal(newSVuv(s->clip_mask)));
     }
 
 void
-backing_store(self, value=NULL)
-    XSetWindowAttributes *self
+clip_x_origin(self, value=NULL)
+    XGCValues *self
     SV *value
   INIT:
-    XSetWindowAttributes *s= self;
+    XGCValues *s= self;
   PPCODE:
     if (value) {
-      s->backing_store= SvIV(value);
+      s->clip_x_origin= SvIV(value);
       PUSHs(value);
     } else {
-      PUSHs(sv_2mortal(newSViv(s->backing_store)));
+      PUSHs(sv_2mortal(newSViv(s->clip_x_origin)));
     }
 
 void
-bit_gravity(self, value=NULL)
-    XSetWindowAttributes *self
+clip_y_origin(self, value=NULL)
+    XGCValues *self
     SV *value
   INIT:
-    XSetWindowAttributes *s= self;
+    XGCValues *s= self;
   PPCODE:
     if (value) {
-      s->bit_gravity= SvIV(value);
+      s->clip_y_origin= SvIV(value);
       PUSHs(value);
     } else {
-      PUSHs(sv_2mortal(newSViv(s->bit_gravity)));
+      PUSHs(sv_2mortal(newSViv(s->clip_y_origin)));
     }
 
 void
-border_pixel(self, value=NULL)
-    XSetWindowAttributes *self
+dash_offset(self, value=NULL)
+    XGCValues *self
     SV *value
   INIT:
-    XSetWindowAttributes *s= self;
+    XGCValues *s= self;
   PPCODE:
     if (value) {
-      s->border_pixel= SvUV(value);
+      s->dash_offset= SvIV(value);
       PUSHs(value);
     } else {
-      PUSHs(sv_2mortal(newSVuv(s->border_pixel)));
+      PUSHs(sv_2mortal(newSViv(s->dash_offset)));
     }
 
 void
-border_pixmap(self, value=NULL)
-    XSetWindowAttributes *self
+dashes(self, value=NULL)
+    XGCValues *self
     SV *value
   INIT:
-    XSetWindowAttributes *s= self;
+    XGCValues *s= self;
   PPCODE:
     if (value) {
-      s->border_pixmap= PerlXlib_sv_to_xid(value);
+      s->dashes= SvIV(value);
       PUSHs(value);
     } else {
-      PUSHs(sv_2mortal(newSVuv(s->border_pixmap)));
+      PUSHs(sv_2mortal(newSViv(s->dashes)));
     }
 
 void
-colormap(self, value=NULL)
-    XSetWindowAttributes *self
+fill_rule(self, value=NULL)
+    XGCValues *self
     SV *value
   INIT:
-    XSetWindowAttributes *s= self;
+    XGCValues *s= self;
   PPCODE:
     if (value) {
-      s->colormap= PerlXlib_sv_to_xid(value);
+      s->fill_rule= SvIV(value);
       PUSHs(value);
     } else {
-      PUSHs(sv_2mortal(newSVuv(s->colormap)));
+      PUSHs(sv_2mortal(newSViv(s->fill_rule)));
     }
 
 void
-cursor(self, value=NULL)
-    XSetWindowAttributes *self
+fill_style(self, value=NULL)
+    XGCValues *self
     SV *value
   INIT:
-    XSetWindowAttributes *s= self;
+    XGCValues *s= self;
   PPCODE:
     if (value) {
-      s->cursor= PerlXlib_sv_to_xid(value);
+      s->fill_style= SvIV(value);
       PUSHs(value);
     } else {
-      PUSHs(sv_2mortal(newSVuv(s->cursor)));
+      PUSHs(sv_2mortal(newSViv(s->fill_style)));
     }
 
 void
-do_not_propagate_mask(self, value=NULL)
-    XSetWindowAttributes *self
+font(self, value=NULL)
+    XGCValues *self
     SV *value
   INIT:
-    XSetWindowAttributes *s= self;
+    XGCValues *s= self;
   PPCODE:
     if (value) {
-      s->do_not_propagate_mask= SvIV(value);
+      s->font= PerlXlib_sv_to_xid(value);
       PUSHs(value);
     } else {
-      PUSHs(sv_2mortal(newSViv(s->do_not_propagate_mask)));
+      PUSHs(sv_2mortal(newSVuv(s->font)));
     }
 
 void
-event_mask(self, value=NULL)
-    XSetWindowAttributes *self
+foreground(self, value=NULL)
+    XGCValues *self
     SV *value
   INIT:
-    XSetWindowAttributes *s= self;
+    XGCValues *s= self;
   PPCODE:
     if (value) {
-      s->event_mask= SvIV(value);
+      s->foreground= SvUV(value);
       PUSHs(value);
     } else {
-      PUSHs(sv_2mortal(newSViv(s->event_mask)));
+      PUSHs(sv_2mortal(newSVuv(s->foreground)));
     }
 
 void
-override_redirect(self, value=NULL)
-    XSetWindowAttributes *self
+function(self, value=NULL)
+    XGCValues *self
     SV *value
   INIT:
-    XSetWindowAttributes *s= self;
+    XGCValues *s= self;
   PPCODE:
     if (value) {
-      s->override_redirect= SvIV(value);
+      s->function= SvIV(value);
       PUSHs(value);
     } else {
-      PUSHs(sv_2mortal(newSViv(s->override_redirect)));
+      PUSHs(sv_2mortal(newSViv(s->function)));
     }
 
 void
-save_under(self, value=NULL)
-    XSetWindowAttributes *self
+graphics_exposures(self, value=NULL)
+    XGCValues *self
     SV *value
   INIT:
-    XSetWindowAttributes *s= self;
+    XGCValues *s= self;
   PPCODE:
     if (value) {
-      s->save_under= SvIV(value);
+      s->graphics_exposures= SvIV(value);
       PUSHs(value);
     } else {
-      PUSHs(sv_2mortal(newSViv(s->save_under)));
+      PUSHs(sv_2mortal(newSViv(s->graphics_exposures)));
     }
 
 void
-win_gravity(self, value=NULL)
-    XSetWindowAttributes *self
+join_style(self, value=NULL)
+    XGCValues *self
     SV *value
   INIT:
-    XSetWindowAttributes *s= self;
+    XGCValues *s= self;
   PPCODE:
     if (value) {
-      s->win_gravity= SvIV(value);
+      s->join_style= SvIV(value);
       PUSHs(value);
     } else {
-      PUSHs(sv_2mortal(newSViv(s->win_gravity)));
+      PUSHs(sv_2mortal(newSViv(s->join_style)));
     }
 
-# END GENERATED X11_Xlib_XSetWindowAttributes
-# ----------------------------------------------------------------------------
-# BEGIN GENERATED X11_Xlib_XSizeHints
-
-MODULE = X11::Xlib                PACKAGE = X11::Xlib::XSizeHints
-
-int
-_sizeof(ignored=NULL)
-    SV* ignored;
-    CODE:
-        RETVAL = sizeof(XSizeHints);
-    OUTPUT:
-        RETVAL
+void
+line_style(self, value=NULL)
+    XGCValues *self
+    SV *value
+  INIT:
+    XGCValues *s= self;
+  PPCODE:
+    if (value) {
+      s->line_style= SvIV(value);
+      PUSHs(value);
+    } else {
+      PUSHs(sv_2mortal(newSViv(s->line_style)));
+    }
 
 void
-_initialize(s)
-    SV *s
-    INIT:
-        void *sptr;
-    PPCODE:
-        sptr= PerlXlib_get_struct_ptr(s, 1, "X11::Xlib::XSizeHints", sizeof(XSizeHints),
-            (PerlXlib_struct_pack_fn*) &PerlXlib_XSizeHints_pack
-        );
-        memset((void*) sptr, 0, sizeof(XSizeHints));
+line_width(self, value=NULL)
+    XGCValues *self
+    SV *value
+  INIT:
+    XGCValues *s= self;
+  PPCODE:
+    if (value) {
+      s->line_width= SvIV(value);
+      PUSHs(value);
+    } else {
+      PUSHs(sv_2mortal(newSViv(s->line_width)));
+    }
 
 void
-_pack(s, fields, consume=0)
-    XSizeHints *s
-    HV *fields
-    Bool consume
-    PPCODE:
-        PerlXlib_XSizeHints_pack(s, fields, consume);
+plane_mask(self, value=NULL)
+    XGCValues *self
+    SV *value
+  INIT:
+    XGCValues *s= self;
+  PPCODE:
+    if (value) {
+      s->plane_mask= SvUV(value);
+      PUSHs(value);
+    } else {
+      PUSHs(sv_2mortal(newSVuv(s->plane_mask)));
+    }
 
 void
-_unpack(s, fields)
-    XSizeHints *s
-    HV *fields
-    PPCODE:
-        PerlXlib_XSizeHints_unpack_obj(s, fields, ST(0));
+stipple(self, value=NULL)
+    XGCValues *self
+    SV *value
+  INIT:
+    XGCValues *s= self;
+  PPCODE:
+    if (value) {
+      s->stipple= PerlXlib_sv_to_xid(value);
+      PUSHs(value);
+    } else {
+      PUSHs(sv_2mortal(newSVuv(s->stipple)));
+    }
 
 void
-base_height(self, value=NULL)
-    XSizeHints *self
+subwindow_mode(self, value=NULL)
+    XGCValues *self
     SV *value
   INIT:
-    XSizeHints *s= self;
+    XGCValues *s= self;
   PPCODE:
     if (value) {
-      s->base_height= SvIV(value);
+      s->subwindow_mode= SvIV(value);
       PUSHs(value);
     } else {
-      PUSHs(sv_2mortal(newSViv(s->base_height)));
+      PUSHs(sv_2mortal(newSViv(s->subwindow_mode)));
     }
 
 void
-base_width(self, value=NULL)
-    XSizeHints *self
+tile(self, value=NULL)
+    XGCValues *self
     SV *value
   INIT:
-    XSizeHints *s= self;
+    XGCValues *s= self;
   PPCODE:
     if (value) {
-      s->base_width= SvIV(value);
+      s->tile= PerlXlib_sv_to_xid(value);
       PUSHs(value);
     } else {
-      PUSHs(sv_2mortal(newSViv(s->base_width)));
+      PUSHs(sv_2mortal(newSVuv(s->tile)));
     }
 
 void
-flags(self, value=NULL)
-    XSizeHints *self
+ts_x_origin(self, value=NULL)
+    XGCValues *self
     SV *value
   INIT:
-    XSizeHints *s= self;
+    XGCValues *s= self;
   PPCODE:
     if (value) {
-      s->flags= SvIV(value);
+      s->ts_x_origin= SvIV(value);
       PUSHs(value);
     } else {
-      PUSHs(sv_2mortal(newSViv(s->flags)));
+      PUSHs(sv_2mortal(newSViv(s->ts_x_origin)));
     }
 
 void
-height(self, value=NULL)
-    XSizeHints *self
+ts_y_origin(self, value=NULL)
+    XGCValues *self
     SV *value
   INIT:
-    XSizeHints *s= self;
+    XGCValues *s= self;
   PPCODE:
     if (value) {
-      s->height= SvIV(value);
+      s->ts_y_origin= SvIV(value);
       PUSHs(value);
     } else {
-      PUSHs(sv_2mortal(newSViv(s->height)));
+      PUSHs(sv_2mortal(newSViv(s->ts_y_origin)));
     }
 
+# END GENERATED X11_Xlib_XGCValues
+# ----------------------------------------------------------------------------
+# BEGIN GENERATED X11_Xlib_XRenderPictureAttributes
+
+MODULE = X11::Xlib                PACKAGE = X11::Xlib::XRenderPictureAttributes
+
+int
+_sizeof(ignored=NULL)
+    SV* ignored;
+    CODE:
+        RETVAL = sizeof(XRenderPictureAttributes);
+    OUTPUT:
+        RETVAL
+
+void
+_initialize(s)
+    SV *s
+    INIT:
+        void *sptr;
+    PPCODE:
+        sptr= PerlXlib_get_struct_ptr(s, 1, "X11::Xlib::XRenderPictureAttributes", sizeof(XRenderPictureAttributes),
+            (PerlXlib_struct_pack_fn*) &PerlXlib_XRenderPictureAttributes_pack
+        );
+        memset((void*) sptr, 0, sizeof(XRenderPictureAttributes));
+
 void
-height_inc(self, value=NULL)
-    XSizeHints *self
-    SV *value
-  INIT:
-    XSizeHints *s= self;
-  PPCODE:
-    if (value) {
-      s->height_inc= SvIV(value);
-      PUSHs(value);
-    } else {
-      PUSHs(sv_2mortal(newSViv(s->height_inc)));
-    }
+_pack(s, fields, consume=0)
+    XRenderPictureAttributes *s
+    HV *fields
+    Bool consume
+    PPCODE:
+        PerlXlib_XRenderPictureAttributes_pack(s, fields, consume);
 
 void
-max_aspect_x(self, value=NULL)
-    XSizeHints *self
+_unpack(s, fields)
+    XRenderPictureAttributes *s
+    HV *fields
+    PPCODE:
+        PerlXlib_XRenderPictureAttributes_unpack_obj(s, fields, ST(0));
+
+void
+alpha_map(self, value=NULL)
+    XRenderPictureAttributes *self
     SV *value
   INIT:
-    XSizeHints *s= self;
+    XRenderPictureAttributes *s= self;
   PPCODE:
     if (value) {
-      s->max_aspect.x= SvIV(value);
+      s->alpha_map= PerlXlib_sv_to_xid(value);
       PUSHs(value);
     } else {
-      PUSHs(sv_2mortal(newSViv(s->max_aspect.x)));
+      PUSHs(sv_2mortal(newSVuv(s->alpha_map)));
     }
 
 void
-max_aspect_y(self, value=NULL)
-    XSizeHints *self
+alpha_x_origin(self, value=NULL)
+    XRenderPictureAttributes *self
     SV *value
   INIT:
-    XSizeHints *s= self;
+    XRenderPictureAttributes *s= self;
   PPCODE:
     if (value) {
-      s->max_aspect.y= SvIV(value);
+      s->alpha_x_origin= SvIV(value);
       PUSHs(value);
     } else {
-      PUSHs(sv_2mortal(newSViv(s->max_aspect.y)));
+      PUSHs(sv_2mortal(newSViv(s->alpha_x_origin)));
     }
 
 void
-max_height(self, value=NULL)
-    XSizeHints *self
+alpha_y_origin(self, value=NULL)
+    XRenderPictureAttributes *self
     SV *value
   INIT:
-    XSizeHints *s= self;
+    XRenderPictureAttributes *s= self;
   PPCODE:
     if (value) {
-      s->max_height= SvIV(value);
+      s->alpha_y_origin= SvIV(value);
       PUSHs(value);
     } else {
-      PUSHs(sv_2mortal(newSViv(s->max_height)));
+      PUSHs(sv_2mortal(newSViv(s->alpha_y_origin)));
     }
 
 void
-max_width(self, value=NULL)
-    XSizeHints *self
+clip_mask(self, value=NULL)
+    XRenderPictureAttributes *self
     SV *value
   INIT:
-    XSizeHints *s= self;
+    XRenderPictureAttributes *s= self;
   PPCODE:
     if (value) {
-      s->max_width= SvIV(value);
+      s->clip_mask= PerlXlib_sv_to_xid(value);
       PUSHs(value);
     } else {
-      PUSHs(sv_2mortal(newSViv(s->max_width)));
+      PUSHs(sv_2mortal(newSVuv(s->clip_mask)));
     }
 
 void
-min_aspect_x(self, value=NULL)
-    XSizeHints *self
+clip_x_origin(self, value=NULL)
+    XRenderPictureAttributes *self
     SV *value
   INIT:
-    XSizeHints *s= self;
+    XRenderPictureAttributes *s= self;
   PPCODE:
     if (value) {
-      s->min_aspect.x= SvIV(value);
+      s->clip_x_origin= SvIV(value);
       PUSHs(value);
     } else {
-      PUSHs(sv_2mortal(newSViv(s->min_aspect.x)));
+      PUSHs(sv_2mortal(newSViv(s->clip_x_origin)));
     }
 
 void
-min_aspect_y(self, value=NULL)
-    XSizeHints *self
+clip_y_origin(self, value=NULL)
+    XRenderPictureAttributes *self
     SV *value
   INIT:
-    XSizeHints *s= self;
+    XRenderPictureAttributes *s= self;
   PPCODE:
     if (value) {
-      s->min_aspect.y= SvIV(value);
+      s->clip_y_origin= SvIV(value);
       PUSHs(value);
     } else {
-      PUSHs(sv_2mortal(newSViv(s->min_aspect.y)));
+      PUSHs(sv_2mortal(newSViv(s->clip_y_origin)));
     }
 
 void
-min_height(self, value=NULL)
-    XSizeHints *self
+component_alpha(self, value=NULL)
+    XRenderPictureAttributes *self
     SV *value
   INIT:
-    XSizeHints *s= self;
+    XRenderPictureAttributes *s= self;
   PPCODE:
     if (value) {
-      s->min_height= SvIV(value);
+      s->component_alpha= SvIV(value);
       PUSHs(value);
     } else {
-      PUSHs(sv_2mortal(newSViv(s->min_height)));
+      PUSHs(sv_2mortal(newSViv(s->component_alpha)));
     }
 
 void
-min_width(self, value=NULL)
-    XSizeHints *self
+dither(self, value=NULL)
+    XRenderPictureAttributes *self
     SV *value
   INIT:
-    XSizeHints *s= self;
+    XRenderPictureAttributes *s= self;
   PPCODE:
     if (value) {
-      s->min_width= SvIV(value);
+      s->dither= PerlXlib_sv_to_xid(value);
       PUSHs(value);
     } else {
-      PUSHs(sv_2mortal(newSViv(s->min_width)));
+      PUSHs(sv_2mortal(newSVuv(s->dither)));
     }
 
 void
-width(self, value=NULL)
-    XSizeHints *self
+graphics_exposures(self, value=NULL)
+    XRenderPictureAttributes *self
     SV *value
   INIT:
-    XSizeHints *s= self;
+    XRenderPictureAttributes *s= self;
   PPCODE:
     if (value) {
-      s->width= SvIV(value);
+      s->graphics_exposures= SvIV(value);
       PUSHs(value);
     } else {
-      PUSHs(sv_2mortal(newSViv(s->width)));
+      PUSHs(sv_2mortal(newSViv(s->graphics_exposures)));
     }
 
 void
-width_inc(self, value=NULL)
-    XSizeHints *self
+poly_edge(self, value=NULL)
+    XRenderPictureAttributes *self
     SV *value
   INIT:
-    XSizeHints *s= self;
+    XRenderPictureAttributes *s= self;
   PPCODE:
     if (value) {
-      s->width_inc= SvIV(value);
+      s->poly_edge= SvIV(value);
       PUSHs(value);
     } else {
-      PUSHs(sv_2mortal(newSViv(s->width_inc)));
+      PUSHs(sv_2mortal(newSViv(s->poly_edge)));
     }
 
 void
-win_gravity(self, value=NULL)
-    XSizeHints *self
+poly_mode(self, value=NULL)
+    XRenderPictureAttributes *self
     SV *value
   INIT:
-    XSizeHints *s= self;
+    XRenderPictureAttributes *s= self;
   PPCODE:
     if (value) {
-      s->win_gravity= SvIV(value);
+      s->poly_mode= SvIV(value);
       PUSHs(value);
     } else {
-      PUSHs(sv_2mortal(newSViv(s->win_gravity)));
+      PUSHs(sv_2mortal(newSViv(s->poly_mode)));
     }
 
 void
-x(self, value=NULL)
-    XSizeHints *self
+repeat(self, value=NULL)
+    XRenderPictureAttributes *self
     SV *value
   INIT:
-    XSizeHints *s= self;
+    XRenderPictureAttributes *s= self;
   PPCODE:
     if (value) {
-      s->x= SvIV(value);
+      s->repeat= SvIV(value);
       PUSHs(value);
     } else {
-      PUSHs(sv_2mortal(newSViv(s->x)));
+      PUSHs(sv_2mortal(newSViv(s->repeat)));
     }
 
 void
-y(self, value=NULL)
-    XSizeHints *self
+subwindow_mode(self, value=NULL)
+    XRenderPictureAttributes *self
     SV *value
   INIT:
-    XSizeHints *s= self;
+    XRenderPictureAttributes *s= self;
   PPCODE:
     if (value) {
-      s->y= SvIV(value);
+      s->subwindow_mode= SvIV(value);
       PUSHs(value);
     } else {
-      PUSHs(sv_2mortal(newSViv(s->y)));
+      PUSHs(sv_2mortal(newSViv(s->subwindow_mode)));
     }
 
-# END GENERATED X11_Xlib_XSizeHints
+# END GENERATED X11_Xlib_XRenderPictureAttributes
 # ----------------------------------------------------------------------------
-# BEGIN GENERATED X11_Xlib_XRectangle
+# BEGIN GENERATED X11_Xlib_XRenderColor
 
-MODULE = X11::Xlib                PACKAGE = X11::Xlib::XRectangle
+MODULE = X11::Xlib                PACKAGE = X11::Xlib::XRenderColor
 
 int
 _sizeof(ignored=NULL)
     SV* ignored;
     CODE:
-        RETVAL = sizeof(XRectangle);
+        RETVAL = sizeof(XRenderColor);
     OUTPUT:
         RETVAL
 
@@ -4466,93 +8354,93 @@ _initialize(s)
     INIT:
         void *sptr;
     PPCODE:
-        sptr= PerlXlib_get_struct_ptr(s, 1, "X11::Xlib::XRectangle", sizeof(XRectangle),
-            (PerlXlib_struct_pack_fn*) &PerlXlib_XRectangle_pack
+        sptr= PerlXlib_get_struct_ptr(s, 1, "X11::Xlib::XRenderColor", sizeof(XRenderColor),
+            (PerlXlib_struct_pack_fn*) &PerlXlib_XRenderColor_pack
         );
-        memset((void*) sptr, 0, sizeof(XRectangle));
+        memset((void*) sptr, 0, sizeof(XRenderColor));
 
 void
 _pack(s, fields, consume=0)
-    XRectangle *s
+    XRenderColor *s
     HV *fields
     Bool consume
     PPCODE:
-        PerlXlib_XRectangle_pack(s, fields, consume);
+        PerlXlib_XRenderColor_pack(s, fields, consume);
 
 void
 _unpack(s, fields)
-    XRectangle *s
+    XRenderColor *s
     HV *fields
     PPCODE:
-        PerlXlib_XRectangle_unpack_obj(s, fields, ST(0));
+        PerlXlib_XRenderColor_unpack_obj(s, fields, ST(0));
 
 void
-height(self, value=NULL)
-    XRectangle *self
+alpha(self, value=NULL)
+    XRenderColor *self
     SV *value
   INIT:
-    XRectangle *s= self;
+    XRenderColor *s= self;
   PPCODE:
     if (value) {
-      s->height= SvUV(value);
+      s->alpha= SvUV(value);
       PUSHs(value);
     } else {
-      PUSHs(sv_2mortal(newSVuv(s->height)));
+      PUSHs(sv_2mortal(newSVuv(s->alpha)));
     }
 
 void
-width(self, value=NULL)
-    XRectangle *self
+blue(self, value=NULL)
+    XRenderColor *self
     SV *value
   INIT:
-    XRectangle *s= self;
+    XRenderColor *s= self;
   PPCODE:
     if (value) {
-      s->width= SvUV(value);
+      s->blue= SvUV(value);
       PUSHs(value);
     } else {
-      PUSHs(sv_2mortal(newSVuv(s->width)));
+      PUSHs(sv_2mortal(newSVuv(s->blue)));
     }
 
 void
-x(self, value=NULL)
-    XRectangle *self
+green(self, value=NULL)
+    XRenderColor *self
     SV *value
   INIT:
-    XRectangle *s= self;
+    XRenderColor *s= self;
   PPCODE:
     if (value) {
-      s->x= SvIV(value);
+      s->green= SvUV(value);
       PUSHs(value);
     } else {
-      PUSHs(sv_2mortal(newSViv(s->x)));
+      PUSHs(sv_2mortal(newSVuv(s->green)));
     }
 
 void
-y(self, value=NULL)
-    XRectangle *self
+red(self, value=NULL)
+    XRenderColor *self
     SV *value
   INIT:
-    XRectangle *s= self;
+    XRenderColor *s= self;
   PPCODE:
     if (value) {
-      s->y= SvIV(value);
+      s->red= SvUV(value);
       PUSHs(value);
     } else {
-      PUSHs(sv_2mortal(newSViv(s->y)));
+      PUSHs(sv_2mortal(newSVuv(s->red)));
     }
 
-# END GENERATED X11_Xlib_XRectangle
+# END GENERATED X11_Xlib_XRenderColor
 # ----------------------------------------------------------------------------
-# BEGIN GENERATED X11_Xlib_XRenderPictFormat
+# BEGIN GENERATED X11_Xlib_XGlyphInfo
 
-MODULE = X11::Xlib                PACKAGE = X11::Xlib::XRenderPictFormat
+MODULE = X11::Xlib                PACKAGE = X11::Xlib::XGlyphInfo
 
 int
 _sizeof(ignored=NULL)
     SV* ignored;
     CODE:
-        RETVAL = sizeof(XRenderPictFormat);
+        RETVAL = sizeof(XGlyphInfo);
     OUTPUT:
         RETVAL
 
@@ -4562,195 +8450,111 @@ _initialize(s)
     INIT:
         void *sptr;
     PPCODE:
-        sptr= PerlXlib_get_struct_ptr(s, 1, "X11::Xlib::XRenderPictFormat", sizeof(XRenderPictFormat),
-            (PerlXlib_struct_pack_fn*) &PerlXlib_XRenderPictFormat_pack
+        sptr= PerlXlib_get_struct_ptr(s, 1, "X11::Xlib::XGlyphInfo", sizeof(XGlyphInfo),
+            (PerlXlib_struct_pack_fn*) &PerlXlib_XGlyphInfo_pack
         );
-        memset((void*) sptr, 0, sizeof(XRenderPictFormat));
+        memset((void*) sptr, 0, sizeof(XGlyphInfo));
 
 void
 _pack(s, fields, consume=0)
-    XRenderPictFormat *s
+    XGlyphInfo *s
     HV *fields
     Bool consume
     PPCODE:
-        PerlXlib_XRenderPictFormat_pack(s, fields, consume);
+        PerlXlib_XGlyphInfo_pack(s, fields, consume);
 
 void
 _unpack(s, fields)
-    XRenderPictFormat *s
+    XGlyphInfo *s
     HV *fields
     PPCODE:
-        PerlXlib_XRenderPictFormat_unpack_obj(s, fields, ST(0));
-
-void
-colormap(self, value=NULL)
-    XRenderPictFormat *self
-    SV *value
-  INIT:
-    XRenderPictFormat *s= self;
-  PPCODE:
-    if (value) {
-      s->colormap= PerlXlib_sv_to_xid(value);
-      PUSHs(value);
-    } else {
-      PUSHs(sv_2mortal(newSVuv(s->colormap)));
-    }
-
-void
-depth(self, value=NULL)
-    XRenderPictFormat *self
-    SV *value
-  INIT:
-    XRenderPictFormat *s= self;
-  PPCODE:
-    if (value) {
-      s->depth= SvIV(value);
-      PUSHs(value);
-    } else {
-      PUSHs(sv_2mortal(newSViv(s->depth)));
-    }
-
-void
-direct_alpha(self, value=NULL)
-    XRenderPictFormat *self
-    SV *value
-  INIT:
-    XRenderPictFormat *s= self;
-  PPCODE:
-    if (value) {
-      s->direct.alpha= SvIV(value);
-      PUSHs(value);
-    } else {
-      PUSHs(sv_2mortal(newSViv(s->direct.alpha)));
-    }
-
-void
-direct_alphaMask(self, value=NULL)
-    XRenderPictFormat *self
-    SV *value
-  INIT:
-    XRenderPictFormat *s= self;
-  PPCODE:
-    if (value) {
-      s->direct.alphaMask= SvIV(value);
-      PUSHs(value);
-    } else {
-      PUSHs(sv_2mortal(newSViv(s->direct.alphaMask)));
-    }
-
-void
-direct_blue(self, value=NULL)
-    XRenderPictFormat *self
-    SV *value
-  INIT:
-    XRenderPictFormat *s= self;
-  PPCODE:
-    if (value) {
-      s->direct.blue= SvIV(value);
-      PUSHs(value);
-    } else {
-      PUSHs(sv_2mortal(newSViv(s->direct.blue)));
-    }
-
-void
-direct_blueMask(self, value=NULL)
-    XRenderPictFormat *self
-    SV *value
-  INIT:
-    XRenderPictFormat *s= self;
-  PPCODE:
-    if (value) {
-      s->direct.blueMask= SvIV(value);
-      PUSHs(value);
-    } else {
-      PUSHs(sv_2mortal(newSViv(s->direct.blueMask)));
-    }
+        PerlXlib_XGlyphInfo_unpack_obj(s, fields, ST(0));
 
 void
-direct_green(self, value=NULL)
-    XRenderPictFormat *self
+height(self, value=NULL)
+    XGlyphInfo *self
     SV *value
   INIT:
-    XRenderPictFormat *s= self;
+    XGlyphInfo *s= self;
   PPCODE:
     if (value) {
-      s->direct.green= SvIV(value);
+      s->height= SvUV(value);
       PUSHs(value);
     } else {
-      PUSHs(sv_2mortal(newSViv(s->direct.green)));
+      PUSHs(sv_2mortal(newSVuv(s->height)));
     }
 
 void
-direct_greenMask(self, value=NULL)
-    XRenderPictFormat *self
+width(self, value=NULL)
+    XGlyphInfo *self
     SV *value
   INIT:
-    XRenderPictFormat *s= self;
+    XGlyphInfo *s= self;
   PPCODE:
     if (value) {
-      s->direct.greenMask= SvIV(value);
+      s->width= SvUV(value);
       PUSHs(value);
     } else {
-      PUSHs(sv_2mortal(newSViv(s->direct.greenMask)));
+      PUSHs(sv_2mortal(newSVuv(s->width)));
     }
 
 void
-direct_red(self, value=NULL)
-    XRenderPictFormat *self
+x(self, value=NULL)
+    XGlyphInfo *self
     SV *value
   INIT:
-    XRenderPictFormat *s= self;
+    XGlyphInfo *s= self;
   PPCODE:
     if (value) {
-      s->direct.red= SvIV(value);
+      s->x= SvIV(value);
       PUSHs(value);
     } else {
-      PUSHs(sv_2mortal(newSViv(s->direct.red)));
+      PUSHs(sv_2mortal(newSViv(s->x)));
     }
 
 void
-direct_redMask(self, value=NULL)
-    XRenderPictFormat *self
+xOff(self, value=NULL)
+    XGlyphInfo *self
     SV *value
   INIT:
-    XRenderPictFormat *s= self;
+    XGlyphInfo *s= self;
   PPCODE:
     if (value) {
-      s->direct.redMask= SvIV(value);
+      s->xOff= SvIV(value);
       PUSHs(value);
     } else {
-      PUSHs(sv_2mortal(newSViv(s->direct.redMask)));
+      PUSHs(sv_2mortal(newSViv(s->xOff)));
     }
 
 void
-id(self, value=NULL)
-    XRenderPictFormat *self
+y(self, value=NULL)
+    XGlyphInfo *self
     SV *value
   INIT:
-    XRenderPictFormat *s= self;
+    XGlyphInfo *s= self;
   PPCODE:
     if (value) {
-      s->id= PerlXlib_sv_to_xid(value);
+      s->y= SvIV(value);
       PUSHs(value);
     } else {
-      PUSHs(sv_2mortal(newSVuv(s->id)));
+      PUSHs(sv_2mortal(newSViv(s->y)));
     }
 
 void
-type(self, value=NULL)
-    XRenderPictFormat *self
+yOff(self, value=NULL)
+    XGlyphInfo *self
     SV *value
   INIT:
-    XRenderPictFormat *s= self;
+    XGlyphInfo *s= self;
   PPCODE:
     if (value) {
-      s->type= SvIV(value);
+      s->yOff= SvIV(value);
       PUSHs(value);
     } else {
-      PUSHs(sv_2mortal(newSViv(s->type)));
+      PUSHs(sv_2mortal(newSViv(s->yOff)));
     }
 
-# END GENERATED X11_Xlib_XRenderPictFormat
+# END GENERATED X11_Xlib_XGlyphInfo
 # ----------------------------------------------------------------------------
 
 BOOT:
@@ -4845,6 +8649,12 @@ BOOT:
   newCONSTSUB(stash, "RevertToParent", newSViv(RevertToParent));
   newCONSTSUB(stash, "RevertToPointerRoot", newSViv(RevertToPointerRoot));
   newCONSTSUB(stash, "RevertToNone", newSViv(RevertToNone));
+  newCONSTSUB(stash, "MappingModifier", newSViv(MappingModifier));
+  newCONSTSUB(stash, "MappingKeyboard", newSViv(MappingKeyboard));
+  newCONSTSUB(stash, "MappingPointer", newSViv(MappingPointer));
+  newCONSTSUB(stash, "MappingSuccess", newSViv(MappingSuccess));
+  newCONSTSUB(stash, "MappingBusy", newSViv(MappingBusy));
+  newCONSTSUB(stash, "MappingFailed", newSViv(MappingFailed));
   newCONSTSUB(stash, "Success", newSViv(Success));
   newCONSTSUB(stash, "BadAccess", newSViv(BadAccess));
   newCONSTSUB(stash, "BadAlloc", newSViv(BadAlloc));
@@ -4875,6 +8685,69 @@ BOOT:
   newCONSTSUB(stash, "VisualAllMask", newSViv(VisualAllMask));
   newCONSTSUB(stash, "AllocAll", newSViv(AllocAll));
   newCONSTSUB(stash, "AllocNone", newSViv(AllocNone));
+  newCONSTSUB(stash, "LSBFirst", newSViv(LSBFirst));
+  newCONSTSUB(stash, "MSBFirst", newSViv(MSBFirst));
+  newCONSTSUB(stash, "GCFunction", newSViv(GCFunction));
+  newCONSTSUB(stash, "GCPlaneMask", newSViv(GCPlaneMask));
+  newCONSTSUB(stash, "GCForeground", newSViv(GCForeground));
+  newCONSTSUB(stash, "GCBackground", newSViv(GCBackground));
+  newCONSTSUB(stash, "GCLineWidth", newSViv(GCLineWidth));
+  newCONSTSUB(stash, "GCLineStyle", newSViv(GCLineStyle));
+  newCONSTSUB(stash, "GCCapStyle", newSViv(GCCapStyle));
+  newCONSTSUB(stash, "GCJoinStyle", newSViv(GCJoinStyle));
+  newCONSTSUB(stash, "GCFillStyle", newSViv(GCFillStyle));
+  newCONSTSUB(stash, "GCFillRule", newSViv(GCFillRule));
+  newCONSTSUB(stash, "GCTile", newSViv(GCTile));
+  newCONSTSUB(stash, "GCStipple", newSViv(GCStipple));
+  newCONSTSUB(stash, "GCTileStipXOrigin", newSViv(GCTileStipXOrigin));
+  newCONSTSUB(stash, "GCTileStipYOrigin", newSViv(GCTileStipYOrigin));
+  newCONSTSUB(stash, "GCFont", newSViv(GCFont));
+  newCONSTSUB(stash, "GCSubwindowMode", newSViv(GCSubwindowMode));
+  newCONSTSUB(stash, "GCGraphicsExposures", newSViv(GCGraphicsExposures));
+  newCONSTSUB(stash, "GCClipXOrigin", newSViv(GCClipXOrigin));
+  newCONSTSUB(stash, "GCClipYOrigin", newSViv(GCClipYOrigin));
+  newCONSTSUB(stash, "GCClipMask", newSViv(GCClipMask));
+  newCONSTSUB(stash, "GCDashOffset", newSViv(GCDashOffset));
+  newCONSTSUB(stash, "GCDashList", newSViv(GCDashList));
+  newCONSTSUB(stash, "GCArcMode", newSViv(GCArcMode));
+  newCONSTSUB(stash, "GXclear", newSViv(GXclear));
+  newCONSTSUB(stash, "GXand", newSViv(GXand));
+  newCONSTSUB(stash, "GXandReverse", newSViv(GXandReverse));
+  newCONSTSUB(stash, "GXcopy", newSViv(GXcopy));
+  newCONSTSUB(stash, "GXandInverted", newSViv(GXandInverted));
+  newCONSTSUB(stash, "GXnoop", newSViv(GXnoop));
+  newCONSTSUB(stash, "GXxor", newSViv(GXxor));
+  newCONSTSUB(stash, "GXor", newSViv(GXor));
+  newCONSTSUB(stash, "GXnor", newSViv(GXnor));
+  newCONSTSUB(stash, "GXequiv", newSViv(GXequiv));
+  newCONSTSUB(stash, "GXinvert", newSViv(GXinvert));
+  newCONSTSUB(stash, "GXorReverse", newSViv(GXorReverse));
+  newCONSTSUB(stash, "GXcopyInverted", newSViv(GXcopyInverted));
+  newCONSTSUB(stash, "GXorInverted", newSViv(GXorInverted));
+  newCONSTSUB(stash, "GXnand", newSViv(GXnand));
+  newCONSTSUB(stash, "GXset", newSViv(GXset));
+  newCONSTSUB(stash, "LineSolid", newSViv(LineSolid));
+  newCONSTSUB(stash, "LineOnOffDash", newSViv(LineOnOffDash));
+  newCONSTSUB(stash, "LineDoubleDash", newSViv(LineDoubleDash));
+  newCONSTSUB(stash, "CapNotLast", newSViv(CapNotLast));
+  newCONSTSUB(stash, "CapButt", newSViv(CapButt));
+  newCONSTSUB(stash, "CapRound", newSViv(CapRound));
+  newCONSTSUB(stash, "CapProjecting", newSViv(CapProjecting));
+  newCONSTSUB(stash, "JoinMiter", newSViv(JoinMiter));
+  newCONSTSUB(stash, "JoinRound", newSViv(JoinRound));
+  newCONSTSUB(stash, "JoinBevel", newSViv(JoinBevel));
+  newCONSTSUB(stash, "FillSolid", newSViv(FillSolid));
+  newCONSTSUB(stash, "FillTiled", newSViv(FillTiled));
+  newCONSTSUB(stash, "FillStippled", newSViv(FillStippled));
+  newCONSTSUB(stash, "FillOpaqueStippled", newSViv(FillOpaqueStippled));
+  newCONSTSUB(stash, "EvenOddRule", newSViv(EvenOddRule));
+  newCONSTSUB(stash, "WindingRule", newSViv(WindingRule));
+  newCONSTSUB(stash, "ArcChord", newSViv(ArcChord));
+  newCONSTSUB(stash, "ArcPieSlice", newSViv(ArcPieSlice));
+  newCONSTSUB(stash, "ClipByChildren", newSViv(ClipByChildren));
+  newCONSTSUB(stash, "IncludeInferiors", newSViv(IncludeInferiors));
+  newCONSTSUB(stash, "CoordModeOrigin", newSViv(CoordModeOrigin));
+  newCONSTSUB(stash, "CoordModePrevious", newSViv(CoordModePrevious));
   newCONSTSUB(stash, "AnyPropertyType", newSViv(AnyPropertyType));
   newCONSTSUB(stash, "PropModeReplace", newSViv(PropModeReplace));
   newCONSTSUB(stash, "PropModeAppend", newSViv(PropModeAppend));
@@ -4935,6 +8808,47 @@ BOOT:
   newCONSTSUB(stash, "PWinGravity", newSViv(PWinGravity));
   newCONSTSUB(stash, "CompositeRedirectAutomatic", newSViv(CompositeRedirectAutomatic));
   newCONSTSUB(stash, "CompositeRedirectManual", newSViv(CompositeRedirectManual));
+  newCONSTSUB(stash, "XDamageReportRawRectangles", newSViv(XDamageReportRawRectangles));
+  newCONSTSUB(stash, "XDamageReportDeltaRectangles", newSViv(XDamageReportDeltaRectangles));
+  newCONSTSUB(stash, "XDamageReportBoundingBox", newSViv(XDamageReportBoundingBox));
+  newCONSTSUB(stash, "XDamageReportNonEmpty", newSViv(XDamageReportNonEmpty));
+  newCONSTSUB(stash, "XDamageNotify", newSViv(XDamageNotify));
+  newCONSTSUB(stash, "PictOpClear", newSViv(PictOpClear));
+  newCONSTSUB(stash, "PictOpSrc", newSViv(PictOpSrc));
+  newCONSTSUB(stash, "PictOpDst", newSViv(PictOpDst));
+  newCONSTSUB(stash, "PictOpOver", newSViv(PictOpOver));
+  newCONSTSUB(stash, "PictOpOverReverse", newSViv(PictOpOverReverse));
+  newCONSTSUB(stash, "PictOpIn", newSViv(PictOpIn));
+  newCONSTSUB(stash, "PictOpInReverse", newSViv(PictOpInReverse));
+  newCONSTSUB(stash, "PictOpOut", newSViv(PictOpOut));
+  newCONSTSUB(stash, "PictOpOutReverse", newSViv(PictOpOutReverse));
+  newCONSTSUB(stash, "PictOpAtop", newSViv(PictOpAtop));
+  newCONSTSUB(stash, "PictOpAtopReverse", newSViv(PictOpAtopReverse));
+  newCONSTSUB(stash, "PictOpXor", newSViv(PictOpXor));
+  newCONSTSUB(stash, "PictOpAdd", newSViv(PictOpAdd));
+  newCONSTSUB(stash, "PictOpSaturate", newSViv(PictOpSaturate));
+  newCONSTSUB(stash, "PictStandardARGB32", newSViv(PictStandardARGB32));
+  newCONSTSUB(stash, "PictStandardRGB24", newSViv(PictStandardRGB24));
+  newCONSTSUB(stash, "PictStandardA8", newSViv(PictStandardA8));
+  newCONSTSUB(stash, "PictStandardA4", newSViv(PictStandardA4));
+  newCONSTSUB(stash, "PictStandardA1", newSViv(PictStandardA1));
+  newCONSTSUB(stash, "CPRepeat", newSViv(CPRepeat));
+  newCONSTSUB(stash, "CPAlphaMap", newSViv(CPAlphaMap));
+  newCONSTSUB(stash, "CPAlphaXOrigin", newSViv(CPAlphaXOrigin));
+  newCONSTSUB(stash, "CPAlphaYOrigin", newSViv(CPAlphaYOrigin));
+  newCONSTSUB(stash, "CPClipXOrigin", newSViv(CPClipXOrigin));
+  newCONSTSUB(stash, "CPClipYOrigin", newSViv(CPClipYOrigin));
+  newCONSTSUB(stash, "CPClipMask", newSViv(CPClipMask));
+  newCONSTSUB(stash, "CPGraphicsExposure", newSViv(CPGraphicsExposure));
+  newCONSTSUB(stash, "CPSubwindowMode", newSViv(CPSubwindowMode));
+  newCONSTSUB(stash, "CPPolyEdge", newSViv(CPPolyEdge));
+  newCONSTSUB(stash, "CPPolyMode", newSViv(CPPolyMode));
+  newCONSTSUB(stash, "CPDither", newSViv(CPDither));
+  newCONSTSUB(stash, "CPComponentAlpha", newSViv(CPComponentAlpha));
+  newCONSTSUB(stash, "RepeatNone", newSViv(RepeatNone));
+  newCONSTSUB(stash, "RepeatNormal", newSViv(RepeatNormal));
+  newCONSTSUB(stash, "RepeatPad", newSViv(RepeatPad));
+  newCONSTSUB(stash, "RepeatReflect", newSViv(RepeatReflect));
   newCONSTSUB(stash, "ShapeSet", newSViv(ShapeSet));
   newCONSTSUB(stash, "ShapeUnion", newSViv(ShapeUnion));
   newCONSTSUB(stash, "ShapeIntersect", newSViv(ShapeIntersect));
@@ -4943,5 +8857,42 @@ BOOT:
   newCONSTSUB(stash, "ShapeBounding", newSViv(ShapeBounding));
   newCONSTSUB(stash, "ShapeClip", newSViv(ShapeClip));
   newCONSTSUB(stash, "ShapeInput", newSViv(ShapeInput));
+  newCONSTSUB(stash, "XIAllDevices", newSViv(XIAllDevices));
+  newCONSTSUB(stash, "XIAllMasterDevices", newSViv(XIAllMasterDevices));
+  newCONSTSUB(stash, "XI_DeviceChanged", newSViv(XI_DeviceChanged));
+  newCONSTSUB(stash, "XI_KeyPress", newSViv(XI_KeyPress));
+  newCONSTSUB(stash, "XI_KeyRelease", newSViv(XI_KeyRelease));
+  newCONSTSUB(stash, "XI_ButtonPress", newSViv(XI_ButtonPress));
+  newCONSTSUB(stash, "XI_ButtonRelease", newSViv(XI_ButtonRelease));
+  newCONSTSUB(stash, "XI_Motion", newSViv(XI_Motion));
+  newCONSTSUB(stash, "XI_Enter", newSViv(XI_Enter));
+  newCONSTSUB(stash, "XI_Leave", newSViv(XI_Leave));
+  newCONSTSUB(stash, "XI_FocusIn", newSViv(XI_FocusIn));
+  newCONSTSUB(stash, "XI_FocusOut", newSViv(XI_FocusOut));
+  newCONSTSUB(stash, "XI_HierarchyChanged", newSViv(XI_HierarchyChanged));
+  newCONSTSUB(stash, "XI_PropertyEvent", newSViv(XI_PropertyEvent));
+  newCONSTSUB(stash, "XI_RawKeyPress", newSViv(XI_RawKeyPress));
+  newCONSTSUB(stash, "XI_RawKeyRelease", newSViv(XI_RawKeyRelease));
+  newCONSTSUB(stash, "XI_RawButtonPress", newSViv(XI_RawButtonPress));
+  newCONSTSUB(stash, "XI_RawButtonRelease", newSViv(XI_RawButtonRelease));
+  newCONSTSUB(stash, "XI_RawMotion", newSViv(XI_RawMotion));
+  newCONSTSUB(stash, "XI_TouchBegin", newSViv(XI_TouchBegin));
+  newCONSTSUB(stash, "XI_TouchUpdate", newSViv(XI_TouchUpdate));
+  newCONSTSUB(stash, "XI_TouchEnd", newSViv(XI_TouchEnd));
+  newCONSTSUB(stash, "XI_RawTouchBegin", newSViv(XI_RawTouchBegin));
+  newCONSTSUB(stash, "XI_RawTouchUpdate", newSViv(XI_RawTouchUpdate));
+  newCONSTSUB(stash, "XI_RawTouchEnd", newSViv(XI_RawTouchEnd));
+  newCONSTSUB(stash, "XIMasterPointer", newSViv(XIMasterPointer));
+  newCONSTSUB(stash, "XIMasterKeyboard", newSViv(XIMasterKeyboard));
+  newCONSTSUB(stash, "XISlavePointer", newSViv(XISlavePointer));
+  newCONSTSUB(stash, "XISlaveKeyboard", newSViv(XISlaveKeyboard));
+  newCONSTSUB(stash, "XIFloatingSlave", newSViv(XIFloatingSlave));
+  newCONSTSUB(stash, "XIKeyClass", newSViv(XIKeyClass));
+  newCONSTSUB(stash, "XIButtonClass", newSViv(XIButtonClass));
+  newCONSTSUB(stash, "XIValuatorClass", newSViv(XIValuatorClass));
+  newCONSTSUB(stash, "XIScrollClass", newSViv(XIScrollClass));
+  newCONSTSUB(stash, "XITouchClass", newSViv(XITouchClass));
 # END GENERATED BOOT CONSTANTS
+  PerlXlib_obj_cache_boot();
+  PerlXlib_trace_boot();
 #
@@ -0,0 +1,81 @@
+#! /usr/bin/env perl
+# Benchmarks of the code paths that don't need an X server: struct coercion
+# and packing, XEvent accessors, KeySym conversions, property unpacking, and
+# the object cache.  The inputs are fixed, so results from different runs
+# (and machines of the same kind) can be compared.
+#
+#   perl -Iblib/lib -Iblib/arch bench/cpu.pl [--json out.json] [--compare old.json]
+#
+# See bench/lib/X11/Xlib/Bench.pm for the options.
+use strict;
+use warnings;
+use FindBin;
+use lib "$FindBin::Bin/lib";
+use X11::Xlib ':all';
+use X11::Xlib::Bench;
+
+my $bench= X11::Xlib::Bench->new(suite => 'cpu', argv => \@ARGV);
+
+# --- C functions, in a C loop -----------------------------------------------
+
+$bench->run_c('c/is_an_integer/iv',        is_an_integer => 12345);
+$bench->run_c('c/is_an_integer/digits',    is_an_integer => '12345');
+$bench->run_c('c/is_an_integer/name',      is_an_integer => 'WM_NAME');
+$bench->run_c('c/sv_to_keysym/char',       sv_to_keysym => 'a');
+$bench->run_c('c/sv_to_keysym/utf8',       sv_to_keysym => "\x{20AC}");
+$bench->run_c('c/sv_to_keysym/name',       sv_to_keysym => 'Return');
+$bench->run_c('c/sv_to_keysym/number',     sv_to_keysym => '0x1008FF13');
+$bench->run_c('c/keysym_to_codepoint/latin1',  keysym_to_codepoint => 0x61);
+$bench->run_c('c/keysym_to_codepoint/legacy',  keysym_to_codepoint => 0x20AC);
+$bench->run_c('c/keysym_to_codepoint/unicode', keysym_to_codepoint => 0x1000439);
+$bench->run_c('c/codepoint_to_keysym/latin1',  codepoint_to_keysym => 0x61);
+$bench->run_c('c/codepoint_to_keysym/legacy',  codepoint_to_keysym => 0x20AC);
+$bench->run_c('c/codepoint_to_keysym/unicode', codepoint_to_keysym => 0x439);
+
+my $event= X11::Xlib::XEvent->new(type => KeyPress, keycode => 38, x => 10, y => 20, state => 1);
+my $event_buf= $$event;
+my %event_fields= (type => KeyPress, keycode => 38, x => 10, y => 20, state => 1);
+$bench->run_c('c/get_struct_ptr/object',  get_struct_ptr => $event);
+$bench->run_c('c/get_struct_ptr/buffer',  get_struct_ptr => $event_buf);
+$bench->run_c('c/get_struct_ptr/hashref', get_struct_ptr => \%event_fields);
+
+# Wrapper objects for fake Display pointers fill the object cache, as a busy
+# program would.  They aren't connected, so must never be used for requests.
+my @fake_ptrs= map { "\0" x length pack('J', 0) } 1 .. 1000;
+my @fake_dpys= map {
+    my $obj= bless {}, 'X11::Xlib';
+    X11::Xlib::_set_pointer_value($obj, $_);
+    $obj;
+} @fake_ptrs;
+my $fake= $fake_dpys[500];
+$bench->context(obj_cache_entries => scalar @fake_dpys);
+$bench->run_c('c/get_objref/hit',  get_objref => $fake);
+$bench->run_c('c/get_objref/miss', get_objref => 0x12345678);
+
+# --- XS calls -----------------------------------------------------------------
+
+$bench->run_call('xs/XEvent/get',         sub { $event->keycode });
+$bench->run_call('xs/XEvent/set',         sub { $event->keycode(38) });
+$bench->run_call('xs/XEvent/get_display', sub { $event->display });
+$event->display($fake);
+$bench->run_call('xs/XEvent/get_display_cached', sub { $event->display });
+$event->display(undef);
+$bench->run_call('xs/XEvent/new',    sub { X11::Xlib::XEvent->new(type => KeyPress) });
+$bench->run_call('xs/XEvent/pack',   sub { $event->pack(\%event_fields) });
+$bench->run_call('xs/XEvent/unpack', sub { $event->unpack });
+my $rect= X11::Xlib::XRectangle->new(x => 1, y => 2, width => 3, height => 4);
+$bench->run_call('xs/XRectangle/pack',   sub { $rect->pack({ x => 1, y => 2, width => 3, height => 4 }) });
+$bench->run_call('xs/XRectangle/unpack', sub { $rect->unpack });
+
+$bench->run_call('xs/keysym_to_codepoint', sub { X11::Xlib::keysym_to_codepoint(0x20AC) });
+$bench->run_call('xs/codepoint_to_keysym', sub { X11::Xlib::codepoint_to_keysym(0x20AC) });
+$bench->run_call('xs/char_to_keysym',      sub { X11::Xlib::char_to_keysym("\x{20AC}") });
+$bench->run_call('xs/is_an_integer',       sub { X11::Xlib::_is_an_integer('12345') });
+
+my $longs= pack('l!*', 1 .. 256);
+my $shorts= pack('s!*', 1 .. 256);
+$bench->run_call('xs/_unpack_prop/32x256', sub { my @v= X11::Xlib::_unpack_prop_unsigned(32, $longs, 256) });
+$bench->run_call('xs/_unpack_prop/16x256', sub { my @v= X11::Xlib::_unpack_prop_signed(16, $shorts, 256) });
+
+X11::Xlib::_set_pointer_value($_, undef) for @fake_dpys;
+exit $bench->finish;
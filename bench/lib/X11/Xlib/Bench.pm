@@ -0,0 +1,324 @@
+package X11::Xlib::Bench;
+use strict;
+use warnings;
+use Carp;
+use Getopt::Long ();
+use Time::HiRes ();
+use JSON::PP ();
+use X11::Xlib ();
+
+# All modules in dist share a version
+our $VERSION = '0.23';
+
+sub new {
+    my $class= shift;
+    my %args= (@_ == 1 && ref $_[0] eq 'HASH')? %{$_[0]} : @_;
+    my $self= bless {
+        suite     => $args{suite} || 'bench',
+        min_time  => 0.5,
+        threshold => 10,
+        results   => [],
+        context   => {},
+    }, $class;
+    my $argv= $args{argv} || [];
+    Getopt::Long::GetOptionsFromArray($argv,
+        'json=s'      => \$self->{json},
+        'compare=s'   => \$self->{compare},
+        'threshold=f' => \$self->{threshold},
+        'min-time=f'  => \$self->{min_time},
+        'filter=s'    => \$self->{filter},
+        'quiet'       => \$self->{quiet},
+    ) or croak "Usage: $0 [--json FILE] [--compare BASELINE.json [--threshold PCT]]"
+        ." [--min-time SECONDS] [--filter REGEX] [--quiet]";
+    return $self;
+}
+
+sub suite     { $_[0]{suite} }
+sub min_time  { $_[0]{min_time} }
+sub threshold { $_[0]{threshold} }
+sub results   { $_[0]{results} }
+
+sub context {
+    my ($self, %ctx)= @_;
+    @{ $self->{context} }{ keys %ctx }= values %ctx;
+    $self->{context};
+}
+
+sub wants {
+    my ($self, $name)= @_;
+    return !defined $self->{filter} || $name =~ /$self->{filter}/;
+}
+
+sub run {
+    my ($self, $name, $code, %opts)= @_;
+    my ($setup, $teardown)= @opts{qw( setup teardown )};
+    $self->_measure($name, sub {
+        my $n= shift;
+        $setup->($n) if $setup;
+        my $t0= Time::HiRes::time();
+        $code->($n);
+        my $elapsed= Time::HiRes::time() - $t0;
+        $teardown->($n) if $teardown;
+        return $elapsed;
+    }, %opts);
+}
+
+sub run_call {
+    my ($self, $name, $code, %opts)= @_;
+    $self->_measure($name, sub { X11::Xlib::_bench_call($code, $_[0]) }, %opts);
+}
+
+sub run_c {
+    my ($self, $name, $func, $arg, %opts)= @_;
+    $self->_measure($name, sub { X11::Xlib::_bench_c($func, $arg, $_[0]) }, %opts);
+}
+
+# $timer runs the operation $n times and returns the seconds it took, and
+# optionally the number of SVs it allocated.
+sub _measure {
+    my ($self, $name, $timer, %opts)= @_;
+    return unless $self->wants($name);
+    # A fixed count is for operations too slow (or too large) to repeat freely.
+    # Else grow the count until one run takes a tenth of min_time, then scale
+    # it up to take about min_time.
+    my $n= $opts{iterations};
+    my ($elapsed, $svs);
+    unless ($n) {
+        $timer->(1); # warm up caches
+        for ($n= 1; ($elapsed= ($timer->($n))[0]) < $self->{min_time} / 10; $n *= 10) {}
+        $n= int($n * $self->{min_time} / ($elapsed || 1e-9)) || 1;
+    }
+    ($elapsed, $svs)= $timer->($n);
+    my %result= (
+        name        => $name,
+        ops         => $n,
+        seconds     => 0+sprintf('%.6f', $elapsed),
+        ns_per_op   => 0+sprintf('%.1f', $elapsed * 1e9 / $n),
+        ops_per_sec => $elapsed > 0? 0+sprintf('%.1f', $n / $elapsed) : undef,
+        (defined $svs? (allocs_per_op => 0+sprintf('%.2f', $svs / $n)) : ()),
+        ($opts{bytes}? (bytes_per_sec => $elapsed > 0? int($opts{bytes} * $n / $elapsed) : undef) : ()),
+    );
+    push @{ $self->{results} }, \%result;
+    printf STDERR "%-40s %12.1f ns/op %14.1f ops/s%s\n", $name, $result{ns_per_op}, $result{ops_per_sec} || 0,
+        (defined $svs? sprintf(' %6.2f allocs/op', $result{allocs_per_op}) : '')
+        unless $self->{quiet};
+    return \%result;
+}
+
+sub skip {
+    my ($self, $name, $reason)= @_;
+    return unless $self->wants($name);
+    push @{ $self->{results} }, { name => $name, skipped => $reason };
+    printf STDERR "%-40s skipped: %s\n", $name, $reason
+        unless $self->{quiet};
+}
+
+sub report {
+    my $self= shift;
+    return {
+        suite   => $self->{suite},
+        version => $X11::Xlib::VERSION,
+        perl    => sprintf('%vd', $^V),
+        os      => $^O,
+        time    => time,
+        context => $self->{context},
+        results => $self->{results},
+    };
+}
+
+sub compare {
+    my ($self, $baseline)= @_;
+    my %base= map { $_->{name} => $_ } grep { defined $_->{ns_per_op} } @{ $baseline->{results} || [] };
+    my @regressed;
+    for my $r (@{ $self->{results} }) {
+        my $b= $base{ $r->{name} } or next;
+        next unless defined $r->{ns_per_op} && $b->{ns_per_op} > 0;
+        my $change= ($r->{ns_per_op} / $b->{ns_per_op} - 1) * 100;
+        $r->{baseline_ns_per_op}= $b->{ns_per_op};
+        $r->{change_pct}= 0+sprintf('%.1f', $change);
+        # Allocation counts don't vary between runs, so any growth is a regression
+        my $more_allocs= defined $r->{allocs_per_op} && defined $b->{allocs_per_op}
+            && $r->{allocs_per_op} - $b->{allocs_per_op} >= 0.5;
+        $r->{baseline_allocs_per_op}= $b->{allocs_per_op} if $more_allocs;
+        push @regressed, $r if $change > $self->{threshold} || $more_allocs;
+    }
+    return @regressed;
+}
+
+sub finish {
+    my $self= shift;
+    my @regressed;
+    if (defined $self->{compare}) {
+        open my $fh, '<', $self->{compare} or croak "open($self->{compare}): $!";
+        my $baseline= JSON::PP->new->decode(do { local $/; <$fh> });
+        @regressed= $self->compare($baseline);
+        for (@regressed) {
+            printf STDERR "REGRESSION %-29s %12.1f ns/op, was %.1f (%+.1f%%)%s\n",
+                @{$_}{qw( name ns_per_op baseline_ns_per_op change_pct )},
+                (defined $_->{baseline_allocs_per_op}
+                    ? sprintf(', %.2f allocs/op, was %.2f', @{$_}{qw( allocs_per_op baseline_allocs_per_op )}) : '');
+        }
+    }
+    my $json= JSON::PP->new->canonical->pretty->encode($self->report);
+    if (!defined $self->{json} || $self->{json} eq '-') {
+        print $json;
+    } else {
+        open my $fh, '>', $self->{json} or croak "open($self->{json}): $!";
+        print $fh $json;
+        close $fh or croak "close($self->{json}): $!";
+    }
+    return @regressed? 1 : 0;
+}
+
+1;
+
+__END__
+
+=head1 NAME
+
+X11::Xlib::Bench - Timing harness for the scripts in bench/
+
+=head1 SYNOPSIS
+
+  use X11::Xlib::Bench;
+  my $bench= X11::Xlib::Bench->new(suite => 'server', argv => \@ARGV);
+  $bench->run('atom/cached', sub { $display->atom('WM_NAME') for 1..$_[0] });
+  exit $bench->finish;
+
+  # from the shell:
+  perl -Iblib/lib -Iblib/arch bench/server.pl --json new.json --compare old.json --threshold 15
+
+=head1 DESCRIPTION
+
+This module is not installed.  It times blocks of code the same way for each
+benchmark script, and writes the results as JSON so that runs can be kept and
+compared.  Each result records C<name>, C<ops>, C<seconds>, C<ns_per_op> and
+C<ops_per_sec>, and L</run_call> and L</run_c> also record C<allocs_per_op>.
+
+With C<--compare>, the results are compared by name to a previous JSON
+report, and L</finish> returns 1 (for use as the exit code) if any benchmark
+got slower by more than C<--threshold> percent, or allocates half an SV per
+operation more than before.
+
+=head1 CONSTRUCTOR
+
+=head2 new
+
+  my $bench= X11::Xlib::Bench->new(
+    suite => $name,  # recorded in the report
+    argv  => \@ARGV, # command line options are removed from this
+  );
+
+The options are C<--json FILE> (default is stdout), C<--compare FILE>,
+C<--threshold PCT> (default 10), C<--min-time SECONDS> (default 0.5) and
+C<--filter REGEX> to run only some of the benchmarks.  C<--quiet> turns off
+the progress lines on stderr.
+
+=head1 ATTRIBUTES
+
+=head2 suite
+
+=head2 min_time
+
+=head2 threshold
+
+=head2 results
+
+Arrayref of the results so far.
+
+=head2 context
+
+  $bench->context(server => 'Xvfb');
+
+Add or read extra fields for the C<context> of the report.
+
+=head1 METHODS
+
+=head2 run
+
+  $bench->run($name, sub { my $n= shift; ... }, %options);
+
+Time a coderef which does the operation C<$n> times.  Unless C<iterations> is
+given, C<$n> is increased until the code runs for about C<min_time>.  Options:
+
+=over
+
+=item iterations
+
+Use this fixed count instead.
+
+=item setup, teardown
+
+Coderefs called with C<$n> before and after each timed run, and not timed.
+
+=item bytes
+
+Bytes handled per operation, to also report C<bytes_per_sec>.
+
+=back
+
+Returns the result hashref, or nothing if the name doesn't match C<--filter>.
+
+=head2 run_call
+
+  $bench->run_call($name, sub { $event->type }, %options);
+
+Time a coderef which does the operation once, calling it from C.  This adds
+the cost of a sub call to each operation, but also counts C<allocs_per_op>:
+the SVs allocated by each call and still alive when it returns (its return
+values, other mortals, and leaks).  Takes the C<iterations> option.
+
+=head2 run_c
+
+  $bench->run_c($name, $function, $argument, %options);
+
+Time one of the C functions of the module in a C loop, with a fixed argument,
+and count C<allocs_per_op> like L</run_call>.  The functions are
+C<is_an_integer>, C<sv_to_keysym>, C<keysym_to_codepoint>,
+C<codepoint_to_keysym>, C<get_struct_ptr> (as an C<XEvent> rvalue) and
+C<get_objref> (with an object or a pointer as an integer).  Takes the
+C<iterations> option.
+
+=head2 skip
+
+  $bench->skip($name, $reason);
+
+Record that a benchmark couldn't run here.
+
+=head2 wants
+
+True if the name matches C<--filter>.
+
+=head2 report
+
+The hashref that L</finish> writes as JSON.
+
+=head2 compare
+
+  my @regressed= $bench->compare($baseline_report);
+
+Annotate the results with C<baseline_ns_per_op> and C<change_pct>, and return
+the ones slower than the threshold.
+
+=head2 finish
+
+Compare against the baseline if requested, write the report, and return the
+exit code.
+
+=head1 AUTHOR
+
+Olivier Thauvin, E<lt>nanardon@nanardon.zarb.orgE<gt>
+
+Michael Conrad, E<lt>mike@nrdvana.netE<gt>
+
+=head1 COPYRIGHT AND LICENSE
+
+Copyright (C) 2009-2010 by Olivier Thauvin
+
+Copyright (C) 2017-2021 by Michael Conrad
+
+This library is free software; you can redistribute it and/or modify
+it under the same terms as Perl itself, either Perl version 5.10.0 or,
+at your option, any later version of Perl 5 you may have available.
+
+=cut
@@ -0,0 +1,209 @@
+#! /usr/bin/env perl
+# Benchmarks of the calls that talk to an X server, run against a private Xvfb
+# (or Xephyr) so that nothing else on the display disturbs them.
+#
+#   perl -Iblib/lib -Iblib/arch bench/server.pl [--json out.json] [--compare old.json]
+#
+# See bench/lib/X11/Xlib/Bench.pm for the options.  Set X11_BENCH_DISPLAY to
+# use an already-running server instead.
+use strict;
+use warnings;
+use FindBin;
+use lib "$FindBin::Bin/lib", "$FindBin::Bin/../t/lib";
+use X11::Xlib ':all';
+use X11::Xlib::Bench;
+use X11::SandboxServer;
+
+my $bench= X11::Xlib::Bench->new(suite => 'server', argv => \@ARGV);
+
+my ($server, $display, $connect);
+if ($connect= $ENV{X11_BENCH_DISPLAY}) {
+    $display= X11::Xlib->new(connect => $connect);
+    $bench->context(server => $connect);
+} else {
+    $server= eval { X11::SandboxServer->new(program => 'Xvfb') }
+        || eval { X11::SandboxServer->new }
+        or die "Need Xvfb or Xephyr (or set X11_BENCH_DISPLAY) to run the server benchmarks\n";
+    $display= $server->client;
+    $connect= $server->connect_string;
+    $bench->context(server => $server->program);
+}
+# A second connection, for making atoms that the first one hasn't seen
+my $other= X11::Xlib->new(connect => $connect);
+$bench->context(vendor => $display->XServerVendor, release => $display->XVendorRelease);
+
+my $win= $display->new_window(x => 0, y => 0, width => 64, height => 64);
+$display->XSync;
+
+# --- Events -----------------------------------------------------------------
+
+my $ev= X11::Xlib::XEvent->new(type => ClientMessage);
+$ev->window($win);
+$ev->message_type($display->mkatom('BENCH_MESSAGE'));
+$ev->format(32);
+my $queue_events= sub {
+    $display->XSendEvent($win, 0, 0, $ev) for 1 .. $_[0];
+    $display->XSync;
+};
+
+my $recv= X11::Xlib::XEvent->new;
+$bench->run('event/XNextEvent', sub {
+    $display->XNextEvent($recv) for 1 .. $_[0];
+}, setup => $queue_events);
+
+$bench->run('event/wait_event', sub {
+    $display->wait_event(timeout => 1) or die "missing event" for 1 .. $_[0];
+}, setup => $queue_events);
+
+$bench->run('event/send_receive', sub {
+    for (1 .. $_[0]) {
+        $display->XSendEvent($win, 0, 0, $ev);
+        $display->XNextEvent($recv);
+    }
+});
+
+if (!X11::Xlib->can('xi2_drain') || !X11::Xlib->can('XTestFakeMotionEvent')) {
+    $bench->skip('event/xi2_drain', 'XInput2 or XTest client lib is not available');
+} elsif (!$display->XIQueryVersion(2, 0)) {
+    $bench->skip('event/xi2_drain', 'XInput2 not supported by server');
+} else {
+    $display->XISelectEvents($display->root_window, { XIAllMasterDevices() => [ XI_RawMotion() ] });
+    $display->XSync;
+    $display->xi2_drain;
+    $bench->run('event/xi2_drain', sub {
+        my @ev= X11::Xlib::xi2_records($display->xi2_drain);
+    }, setup => sub {
+        $display->fake_motion(0, $_ & 63, $_ & 63, 0) for 1 .. $_[0];
+        $display->XSync;
+    });
+    $display->XISelectEvents($display->root_window, { XIAllMasterDevices() => [] });
+    $display->XSync;
+    $display->xi2_drain;
+}
+
+if (!X11::Xlib->can('XDamageCreate') || !X11::Xlib->can('XFixesCreateRegion')) {
+    $bench->skip('event/damage_accumulate', 'Xdamage client lib is not available');
+} elsif (!$display->XDamageQueryVersion) {
+    $bench->skip('event/damage_accumulate', 'Xdamage not supported by server');
+} else {
+    my $damage= $display->new_damage($win, XDamageReportRawRectangles());
+    my @regions= map $display->XFixesCreateRegion([
+        X11::Xlib::XRectangle->new(x => $_ * 3, y => $_ * 2, width => 8, height => 8)
+    ]), 0 .. 15;
+    $bench->run('event/damage_accumulate', sub {
+        $display->damage_accumulate;
+        $damage->take_rects;
+    }, setup => sub {
+        $display->XDamageAdd($win, $regions[$_ & 15]) for 1 .. $_[0];
+        $display->XSync;
+    });
+    $damage->subtract;
+    $display->XSync;
+}
+
+# --- Atoms ------------------------------------------------------------------
+
+$display->atom('WM_NAME');
+$bench->run('atom/cached', sub {
+    $display->atom('WM_NAME') for 1 .. $_[0];
+});
+
+# Names that exist on the server, but which neither Xlib nor the atom cache of
+# this connection has seen yet.
+my $atom_seq= 0;
+my @atom_names;
+$bench->run('atom/server_hit', sub {
+    $display->atom($_) for @atom_names;
+}, setup => sub {
+    @atom_names= map 'BENCH_ATOM_'.++$atom_seq, 1 .. $_[0];
+    $other->XInternAtoms(\@atom_names, 0);
+    $other->XSync;
+});
+
+$bench->run('atom/server_batch', sub {
+    $display->atom(@atom_names);
+}, setup => sub {
+    @atom_names= map 'BENCH_ATOM_'.++$atom_seq, 1 .. $_[0];
+    $other->XInternAtoms(\@atom_names, 0);
+    $other->XSync;
+});
+
+$bench->run('atom/miss', sub {
+    $display->atom($_) for @atom_names;
+}, setup => sub {
+    @atom_names= map 'BENCH_MISSING_'.++$atom_seq, 1 .. $_[0];
+});
+
+# --- Properties -------------------------------------------------------------
+
+my $prop= $display->mkatom('BENCH_PROPERTY');
+for ([ '1k', 1024 ], [ '1m', 1024*1024 ]) {
+    my ($label, $size)= @$_;
+    my $data= 'x' x $size;
+    $bench->run("property/set_$label", sub {
+        for (1 .. $_[0]) {
+            $display->XChangeProperty($win, $prop, $display->atom("STRING"), 8, PropModeReplace, $data, $size);
+            $display->XSync;
+        }
+    }, bytes => $size);
+    $bench->run("property/get_$label", sub {
+        my ($type, $format, $n, $after, $got);
+        for (1 .. $_[0]) {
+            $display->XGetWindowProperty($win, $prop, 0, ($size+3)/4, 0, AnyPropertyType,
+                $type, $format, $n, $after, $got)
+                && length $got == $size or die "XGetWindowProperty failed";
+        }
+    }, bytes => $size);
+}
+$display->XDeleteProperty($win, $prop);
+
+# --- Window tree ------------------------------------------------------------
+
+sub make_tree {
+    my ($parent, $depth)= @_;
+    return unless $depth;
+    for (1 .. 10) {
+        my $w= $display->XCreateSimpleWindow($parent, 0, 0, 1, 1, 0, 0, 0);
+        make_tree($w, $depth - 1);
+    }
+}
+
+sub walk_tree {
+    my $wnd= shift;
+    my (undef, undef, @children)= $display->XQueryTree($wnd);
+    my $n= 1;
+    $n += walk_tree($_) for @children;
+    $n;
+}
+
+for ([ '1k', 3 ], [ '10k', 4 ]) {
+    my ($label, $depth)= @$_;
+    my $top= $display->XCreateSimpleWindow($display->root_window, 0, 0, 1, 1, 0, 0, 0);
+    make_tree($top, $depth);
+    $display->XSync;
+    my $count= walk_tree($top);
+    $bench->context("tree_$label" => $count);
+    $bench->run("tree/walk_$label", sub {
+        walk_tree($top) == $count or die "tree changed" for 1 .. $_[0];
+    });
+    $display->XDestroyWindow($top);
+    $display->XSync;
+}
+
+# --- Keymap -----------------------------------------------------------------
+
+require X11::Xlib::Keymap;
+$bench->run('keymap/load_xkb', sub {
+    X11::Xlib::Keymap->new(display => $display, use_xkb => 1)->xkb for 1 .. $_[0];
+});
+$bench->run('keymap/load_core', sub {
+    X11::Xlib::Keymap->new(display => $display)->xkb for 1 .. $_[0];
+});
+$bench->run('keymap/load_arrays', sub {
+    X11::Xlib::Keymap->new(display => $display)->keymap for 1 .. $_[0];
+});
+
+$display->XDestroyWindow($win);
+$other->XCloseDisplay;
+$server->close if $server;
+exit $bench->finish;
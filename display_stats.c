@@ -0,0 +1,101 @@
+/* Per-display request and round-trip counters, for X11::Xlib::stats.
+ *
+ * This file is included by PerlXlib.c
+ *
+ * The stats live in the display object (as a PerlXlib_display_stats in the
+ * "_stats" key) and cost nothing when no display has them enabled.  Bytes
+ * flushed are counted by an Xlib "before flush" hook on a private extension
+ * of the display, which sees every buffer Xlib writes to the socket.  The
+ * number of requests is the difference in request serial since the reset.
+ * Calls that wait for a reply are timed by PerlXlib_ROUND_TRIP around the
+ * Xlib call in the XS.
+ */
+
+#include <time.h>
+
+int PerlXlib_display_stats_active= 0;
+
+const char * PerlXlib_display_stats_names[PerlXlib_STAT_COUNT]= {
+    "XSync", "XInternAtom", "XInternAtoms",
+    "XGetAtomName", "XGetAtomNames", "XGetGeometry",
+    "XListProperties", "XGetWindowProperty", "XGetWMProtocols",
+    "XGetWMSizeHints", "XGetWMNormalHints", "XGetWindowAttributes",
+    "XQueryTree", "XTranslateCoordinates", "XQueryKeymap",
+    "XQueryPointer", "XGrabKeyboard", "XGrabPointer",
+    "XGetKeyboardMapping", "XGetModifierMapping", "XkbGetMap",
+    "XkbGetMapChanges", "XFixesFetchRegion", "XIQueryDevice",
+    "XQueryExtension",
+};
+
+I64 PerlXlib_stats_now_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (I64) ts.tv_sec * 1000000000 + ts.tv_nsec;
+}
+
+static PerlXlib_display_stats * display_stats_of_hv(SV *dpy_hv) {
+    SV **ent;
+    if (!dpy_hv || SvTYPE(dpy_hv) != SVt_PVHV)
+        return NULL;
+    ent= hv_fetch((HV*) dpy_hv, "_stats", 6, 0);
+    return ent && SvPOK(*ent) && SvCUR(*ent) >= sizeof(PerlXlib_display_stats)
+        ? (PerlXlib_display_stats*) SvPVX(*ent) : NULL;
+}
+
+/* The stats of a display object, or NULL if it doesn't have them */
+PerlXlib_display_stats * PerlXlib_display_stats_of(SV *dpy_obj) {
+    return dpy_obj && SvROK(dpy_obj)? display_stats_of_hv(SvRV(dpy_obj)) : NULL;
+}
+
+/* Look up the stats from the object cache directly, since this runs inside
+ * Xlib calls and shouldn't create mortal references.
+ */
+static PerlXlib_display_stats * display_stats_lookup(Display *dpy) {
+    return display_stats_of_hv(PerlXlib_obj_cache_find(dpy));
+}
+
+static void display_stats_before_flush(Display *dpy, XExtCodes *codes, _Xconst char *data, long len) {
+    PerlXlib_display_stats *stats;
+    if (PerlXlib_display_stats_active && len > 0 && (stats= display_stats_lookup(dpy)))
+        stats->bytes_flushed += len;
+}
+
+/* Install the flush hook.  It can't be removed again (Xlib would call a NULL
+ * hook) so call this only once per display; the hook does nothing after the
+ * stats are disabled.
+ */
+void PerlXlib_display_stats_hook(Display *dpy) {
+    XExtCodes *codes= XAddExtension(dpy);
+    if (!codes)
+        croak("XAddExtension failed");
+    XESetBeforeFlush(dpy, codes->extension, &display_stats_before_flush);
+}
+
+/* Drop the stats of a display object that is being freed without
+ * stats_disable or XCloseDisplay, so it stops counting as active.
+ */
+void PerlXlib_display_stats_release(SV *dpy_hv) {
+    if (display_stats_of_hv(dpy_hv)) {
+        hv_delete((HV*) dpy_hv, "_stats", 6, G_DISCARD);
+        PerlXlib_display_stats_active--;
+    }
+}
+
+void PerlXlib_display_stats_reset(Display *dpy, PerlXlib_display_stats *stats) {
+    memset(stats, 0, sizeof(*stats));
+    stats->base_serial= NextRequest(dpy);
+}
+
+/* Record a call that started waiting for a reply at 'start_ns' */
+void PerlXlib_display_stats_wait(Display *dpy, int call, I64 start_ns) {
+    PerlXlib_display_stats *stats= display_stats_lookup(dpy);
+    I64 ns, us;
+    int bucket= 0;
+    if (!stats) return;
+    ns= PerlXlib_stats_now_ns() - start_ns;
+    stats->calls[call]++;
+    stats->wait_ns[call] += ns;
+    for (us= ns / 1000; us > 1 && bucket < PerlXlib_STATS_BUCKETS - 1; us >>= 1)
+        bucket++;
+    stats->wait_histogram[bucket]++;
+}
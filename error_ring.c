@@ -0,0 +1,76 @@
+/* A per-display ring of X errors, for X11::Xlib::error_ring_enable.
+ *
+ * This file is included by PerlXlib.c
+ *
+ * When a display has a ring, PerlXlib_X_error_handler appends the error to it
+ * instead of calling into Perl, so a burst of BadWindow from probing windows
+ * that might be gone costs a few stores each.  The ring keeps the newest
+ * errors; when it is full the oldest record is overwritten and counted in
+ * 'dropped'.  Records are taken out by filter, and the ones that don't match
+ * stay in the ring in their original order.
+ */
+
+/* 'capacity' must be a power of 2, and the ring PerlXlib_ERROR_RING_SIZE(capacity) bytes */
+void PerlXlib_error_ring_init(PerlXlib_error_ring *ring, U32 capacity) {
+    memset(ring, 0, sizeof(*ring));
+    ring->mask= capacity - 1;
+}
+
+void PerlXlib_error_ring_push(PerlXlib_error_ring *ring, const XErrorEvent *e) {
+    PerlXlib_error_record *rec;
+    if (ring->count > ring->mask) {
+        rec= ring->rec + ring->head;
+        ring->head= (ring->head + 1) & ring->mask;
+        ring->dropped++;
+    }
+    else
+        rec= ring->rec + ((ring->head + ring->count++) & ring->mask);
+    rec->serial=       e->serial;
+    rec->resourceid=   e->resourceid;
+    rec->error_code=   e->error_code;
+    rec->request_code= e->request_code;
+    rec->minor_code=   e->minor_code;
+    rec->pad= 0;
+}
+
+void PerlXlib_error_filter_init(PerlXlib_error_filter *filter) {
+    memset(filter, 0, sizeof(*filter));
+    filter->error_code= filter->request_code= filter->minor_code= -1;
+    filter->max_serial= ~0UL;
+}
+
+static int error_filter_match(const PerlXlib_error_filter *f, const PerlXlib_error_record *rec) {
+    return (f->error_code < 0 || f->error_code == rec->error_code)
+        && (f->request_code < 0 || f->request_code == rec->request_code)
+        && (f->minor_code < 0 || f->minor_code == rec->minor_code)
+        && (!f->has_resourceid || f->resourceid == rec->resourceid)
+        && rec->serial >= f->min_serial && rec->serial <= f->max_serial;
+}
+
+int PerlXlib_error_ring_count(const PerlXlib_error_ring *ring, const PerlXlib_error_filter *filter) {
+    U32 i;
+    int n= 0;
+    for (i= 0; i < ring->count; i++)
+        n += error_filter_match(filter, ring->rec + ((ring->head + i) & ring->mask));
+    return n;
+}
+
+/* Move the matching records to 'out' (which needs room for ring->count of
+ * them), oldest first, and close up the gaps.  Returns the number moved.
+ */
+int PerlXlib_error_ring_take(PerlXlib_error_ring *ring, const PerlXlib_error_filter *filter,
+    PerlXlib_error_record *out
+) {
+    PerlXlib_error_record *rec;
+    U32 i, kept= 0;
+    int n= 0;
+    for (i= 0; i < ring->count; i++) {
+        rec= ring->rec + ((ring->head + i) & ring->mask);
+        if (error_filter_match(filter, rec))
+            out[n++]= *rec;
+        else if (kept++ < i)
+            ring->rec[(ring->head + kept - 1) & ring->mask]= *rec;
+    }
+    ring->count= kept;
+    return n;
+}
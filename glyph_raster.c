@@ -0,0 +1,90 @@
+/* FreeType rasterizer for the XRender glyph cache (X11::Xlib::GlyphCache).
+ *
+ * This file is included by PerlXlib.c when built with HAVE_FREETYPE.
+ *
+ * Faces stay open in a small cache keyed by file path, so rasterizing the
+ * glyphs of a label doesn't re-open the font for every character.  Glyphs are
+ * rendered as 8-bit coverage with each row padded to 4 bytes, which is the
+ * image layout XRenderAddGlyphs expects for an A8 GlyphSet.
+ */
+
+#include <ft2build.h>
+#include FT_FREETYPE_H
+
+#define GLYPHRASTER_MAX_FACES 8
+
+static FT_Library glyphraster_lib= NULL;
+static struct { char *path; FT_Face face; } glyphraster_faces[GLYPHRASTER_MAX_FACES];
+static int glyphraster_next_slot= 0;
+
+static FT_Face glyphraster_face(const char *path) {
+    FT_Face face;
+    int i;
+    if (!glyphraster_lib && FT_Init_FreeType(&glyphraster_lib)) {
+        glyphraster_lib= NULL;
+        croak("Can't initialize FreeType");
+    }
+    for (i= 0; i < GLYPHRASTER_MAX_FACES; i++)
+        if (glyphraster_faces[i].path && 0 == strcmp(glyphraster_faces[i].path, path))
+            return glyphraster_faces[i].face;
+    if (FT_New_Face(glyphraster_lib, path, 0, &face))
+        croak("Can't load font '%s'", path);
+    /* replace the oldest face */
+    i= glyphraster_next_slot;
+    glyphraster_next_slot= (i + 1) % GLYPHRASTER_MAX_FACES;
+    if (glyphraster_faces[i].path) {
+        FT_Done_Face(glyphraster_faces[i].face);
+        Safefree(glyphraster_faces[i].path);
+    }
+    glyphraster_faces[i].path= savepv(path);
+    glyphraster_faces[i].face= face;
+    return face;
+}
+
+/* Render 'codepoint' from the font file at 'path' at 'pixel_size' pixels per
+ * em.  Fills in 'info' and returns a new SV holding the A8 image.
+ */
+SV * PerlXlib_ft_render_glyph(const char *path, int pixel_size, UV codepoint, XGlyphInfo *info) {
+    FT_Face face= glyphraster_face(path);
+    FT_GlyphSlot slot;
+    FT_Bitmap *bmp;
+    const U8 *src;
+    U8 *dst;
+    size_t stride;
+    int x, y;
+    SV *img;
+
+    if (pixel_size <= 0 || FT_Set_Pixel_Sizes(face, 0, pixel_size))
+        croak("Can't set font '%s' to size %d", path, pixel_size);
+    if (FT_Load_Char(face, codepoint, FT_LOAD_RENDER))
+        croak("Can't render U+%04lX from '%s'", (unsigned long) codepoint, path);
+    slot= face->glyph;
+    bmp= &slot->bitmap;
+    if (bmp->pixel_mode != FT_PIXEL_MODE_GRAY && bmp->pixel_mode != FT_PIXEL_MODE_MONO)
+        croak("Unsupported FreeType pixel mode %d", (int) bmp->pixel_mode);
+
+    info->width= bmp->width;
+    info->height= bmp->rows;
+    info->x= -slot->bitmap_left;
+    info->y= slot->bitmap_top;
+    info->xOff= (slot->advance.x + 32) >> 6;
+    info->yOff= -((slot->advance.y + 32) >> 6);
+
+    stride= ((size_t) bmp->width + 3) & ~(size_t)3;
+    img= newSV(stride * bmp->rows + 1);
+    SvPOK_on(img);
+    SvCUR_set(img, stride * bmp->rows);
+    dst= (U8*) SvPVX(img);
+    memset(dst, 0, stride * bmp->rows + 1);
+    for (y= 0; y < (int) bmp->rows; y++, dst+= stride) {
+        /* a negative pitch means the rows are stored bottom-up */
+        src= bmp->pitch >= 0? bmp->buffer + (size_t) y * bmp->pitch
+            : bmp->buffer + (size_t)(bmp->rows - 1 - y) * -bmp->pitch;
+        if (bmp->pixel_mode == FT_PIXEL_MODE_GRAY)
+            memcpy(dst, src, bmp->width);
+        else
+            for (x= 0; x < (int) bmp->width; x++)
+                dst[x]= (src[x >> 3] & (0x80 >> (x & 7)))? 0xFF : 0;
+    }
+    return img;
+}
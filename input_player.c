@@ -0,0 +1,93 @@
+/* Play a list of fake input events on a schedule, for X11::Xlib::play_input.
+ *
+ * This file is included by PerlXlib.c
+ *
+ * Each action's delay is relative to the scheduled time of the one before, so
+ * lateness doesn't accumulate.  Actions that are due are queued with no XTest
+ * delay, and the queue is flushed only when the next action isn't due yet (and
+ * at the end), so a chord or a burst of motion goes out in one write.  The
+ * lateness of each action is the time its flush finished minus the time it
+ * was scheduled for, on the monotonic clock.
+ */
+
+#include <time.h>
+
+static I64 input_now_us(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (I64) ts.tv_sec * 1000000 + ts.tv_nsec / 1000;
+}
+
+/* Sleep until the monotonic clock reaches 'when', resuming after signals */
+static void input_sleep_until(I64 when) {
+    struct timespec ts;
+    I64 now;
+    while ((now= input_now_us()) < when) {
+        ts.tv_sec= (when - now) / 1000000;
+        ts.tv_nsec= ((when - now) % 1000000) * 1000;
+        nanosleep(&ts, NULL);
+    }
+}
+
+/* Sleep for 'ms' milliseconds */
+void PerlXlib_sleep_ms(int ms) {
+    input_sleep_until(input_now_us() + (I64) ms * 1000);
+}
+
+/* Return NULL if the action can be played, else a description of the problem */
+const char* PerlXlib_input_action_check(const PerlXlib_input_action *act) {
+    if (act->delay_ms < 0)
+        return "negative delay";
+    switch (act->type) {
+    case KeyPress: case KeyRelease:
+        return act->detail < 8 || act->detail > 255? "keycode out of range" : NULL;
+    case ButtonPress: case ButtonRelease:
+        return act->detail < 1 || act->detail > 255? "button out of range" : NULL;
+    case MotionNotify: case PerlXlib_INPUT_RELATIVE_MOTION:
+        return NULL;
+    }
+    return "unknown action type";
+}
+
+static void input_send(Display *dpy, const PerlXlib_input_action *act) {
+    switch (act->type) {
+    case KeyPress: case KeyRelease:
+        XTestFakeKeyEvent(dpy, act->detail, act->type == KeyPress, CurrentTime);
+        break;
+    case ButtonPress: case ButtonRelease:
+        XTestFakeButtonEvent(dpy, act->detail, act->type == ButtonPress, CurrentTime);
+        break;
+    case MotionNotify:
+        XTestFakeMotionEvent(dpy, act->detail, act->x, act->y, CurrentTime);
+        break;
+    case PerlXlib_INPUT_RELATIVE_MOTION:
+        XTestFakeRelativeMotionEvent(dpy, act->x, act->y, CurrentTime);
+        break;
+    }
+}
+
+/* Play 'n' actions, which must have passed PerlXlib_input_action_check.
+ * Writes the lateness of each action in microseconds to 'late_us' and
+ * returns the total time taken.
+ */
+I64 PerlXlib_input_play(Display *dpy, const PerlXlib_input_action *acts, int n, I64 *late_us) {
+    I64 start= input_now_us(), sched= start, now;
+    int i, unflushed= 0;
+    for (i= 0; i < n; i++) {
+        sched += (I64) acts[i].delay_ms * 1000;
+        if (sched > input_now_us()) {
+            if (unflushed < i) {
+                XFlush(dpy);
+                for (now= input_now_us(); unflushed < i; unflushed++)
+                    late_us[unflushed]= now - late_us[unflushed];
+            }
+            input_sleep_until(sched);
+        }
+        input_send(dpy, acts + i);
+        late_us[i]= sched; /* replaced with the lateness once flushed */
+    }
+    XFlush(dpy);
+    for (now= input_now_us(); unflushed < n; unflushed++)
+        late_us[unflushed]= now - late_us[unflushed];
+    return now - start;
+}
@@ -0,0 +1,159 @@
+/* Key event sequences that type a string, for X11::Xlib::Display::type_text.
+ *
+ * This file is included by PerlXlib.c
+ *
+ * Each character is looked up in a keymap index (see keymap_index.c) to find
+ * its keycode and the modifiers for its level (from the key type, if the index
+ * has XKB data).  Modifier keys are pressed and released only when the next
+ * character needs a different set, so a run of capitals holds Shift down
+ * once.  A character with no key (or whose level needs a modifier that has no
+ * key) is typed on a spare keycode that gets remapped to its KeySym.  Spare
+ * keycodes are used round-robin, and a spare that already holds the KeySym is
+ * reused without remapping again.  At the end every modifier is released and
+ * every remapped spare is restored.
+ *
+ * Clients decode a key event with whatever keymap they fetch after the
+ * MappingNotify, so a spare must not be remapped (or restored) while an event
+ * typed on it might not have been read yet.  When every spare has been used
+ * since the last one, and before the final restore, the plan has a SYNC step
+ * where the caller waits for the server and gives the clients time to read.
+ */
+
+/* Keycodes that have no KeySyms and aren't modifiers, which can be borrowed
+ * for characters missing from the keymap.  Returns the number found.
+ */
+int PerlXlib_keymap_index_spare_keycodes(const PerlXlib_keymap_index *ki, KeyCode *out) {
+    const KeyCode *mm= PerlXlib_keymap_index_modmap(ki);
+    const KeySym *row;
+    int i, j, n= 0, used;
+    for (i= ki->min_keycode; i <= ki->max_keycode; i++) {
+        row= PerlXlib_keymap_index_rows(ki, i);
+        for (j= 0, used= 0; j < ki->nsym && !used; j++)
+            used= row[j] != NoSymbol;
+        for (j= 0; j < 8 * ki->max_keypermod && !used; j++)
+            used= mm[j] == i;
+        if (!used) out[n++]= i;
+    }
+    return n;
+}
+
+/* The keycode of modifier bit 'mod', or 0 if no key produces it */
+static int keyseq_mod_keycode(const PerlXlib_keymap_index *ki, int mod) {
+    const KeyCode *mm= PerlXlib_keymap_index_modmap(ki) + mod * ki->max_keypermod;
+    int i;
+    for (i= 0; i < ki->max_keypermod; i++)
+        if (mm[i]) return mm[i];
+    return 0;
+}
+
+/* KeySym to type for a character.  Prefer the legacy KeySym, since more
+ * keymaps have those, and newline means Return rather than Linefeed.
+ */
+static KeySym keyseq_char_keysym(UV codepoint) {
+    KeySym sym;
+    if (codepoint == '\n')
+        return XK_Return;
+    sym= PerlXlib_codepoint_to_legacy_keysym(codepoint);
+    return sym != NoSymbol? sym : PerlXlib_codepoint_to_keysym(codepoint);
+}
+
+static PerlXlib_key_step* keyseq_push(PerlXlib_key_step *out, int op, int keycode, KeySym sym, int wait) {
+    out->op= op;
+    out->keycode= keycode;
+    out->wait= wait;
+    out->sym= sym;
+    return out + 1;
+}
+
+/* Move the held modifiers from *held to 'want', updating held_kc */
+static PerlXlib_key_step* keyseq_set_mods(const PerlXlib_keymap_index *ki, PerlXlib_key_step *out,
+    int *held, int want, KeyCode *held_kc, int wait
+) {
+    int i;
+    for (i= 0; i < 8; i++) {
+        if ((*held & (1 << i)) && !(want & (1 << i))) {
+            out= keyseq_push(out, PerlXlib_KEY_RELEASE, held_kc[i], NoSymbol, wait);
+            wait= PerlXlib_KEY_WAIT_NONE;
+        }
+    }
+    for (i= 0; i < 8; i++) {
+        if (!(*held & (1 << i)) && (want & (1 << i))) {
+            held_kc[i]= keyseq_mod_keycode(ki, i);
+            out= keyseq_push(out, PerlXlib_KEY_PRESS, held_kc[i], NoSymbol, wait);
+            wait= PerlXlib_KEY_WAIT_NONE;
+        }
+    }
+    *held= want;
+    return out;
+}
+
+/* Write the steps to type 'n' codepoints to 'out', which needs room for
+ * PerlXlib_KEY_STEPS_MAX(n, nspare) steps, and return the number written.
+ * Returns -1 - i if codepoint i can't be typed because there are no spares.
+ */
+int PerlXlib_keymap_index_plan_text(const PerlXlib_keymap_index *ki, const UV *codepoints, int n,
+    const KeyCode *spare, int nspare, PerlXlib_key_step *out
+) {
+    PerlXlib_key_step *start= out, *before;
+    KeySym sym, spare_sym[256];
+    KeyCode held_kc[8];
+    char remapped[256], busy[256];
+    int i, j, keycode, level, mods, held= 0, next_spare= 0, nbusy= 0, slot, wait;
+    if (nspare > 256) nspare= 256;
+    memset(remapped, 0, sizeof(remapped));
+    memset(busy, 0, sizeof(busy));
+    for (i= 0; i < nspare; i++)
+        spare_sym[i]= NoSymbol;
+    for (i= 0; i < n; i++) {
+        sym= keyseq_char_keysym(codepoints[i]);
+        keycode= PerlXlib_keymap_index_find_keycode(ki, sym, &level);
+        mods= keycode? PerlXlib_keymap_index_key_mods(ki, keycode, level) : -1;
+        /* an XKB group other than the first can't be reached by holding keys */
+        if (mods & ~0xFF) mods= -1;
+        for (j= 0; j < 8 && mods > 0; j++)
+            if ((mods & (1 << j)) && !keyseq_mod_keycode(ki, j))
+                mods= -1;
+        slot= -1;
+        if (mods < 0) {
+            for (slot= 0; slot < nspare && spare_sym[slot] != sym; slot++);
+            if (slot == nspare) {
+                if (!nspare) return -1 - i;
+                /* every spare has events in flight, so wait before remapping one */
+                if (nbusy == nspare) {
+                    out= keyseq_push(out, PerlXlib_KEY_SYNC, 0, NoSymbol, PerlXlib_KEY_WAIT_NONE);
+                    memset(busy, 0, sizeof(busy));
+                    nbusy= 0;
+                }
+                while (busy[next_spare])
+                    next_spare= (next_spare + 1) % nspare;
+                slot= next_spare;
+                next_spare= (next_spare + 1) % nspare;
+            }
+            if (!busy[slot]) {
+                busy[slot]= 1;
+                nbusy++;
+            }
+            keycode= spare[slot];
+            mods= 0;
+        }
+        /* the pause between characters goes on whichever event comes first */
+        wait= i? PerlXlib_KEY_WAIT_DELAY : PerlXlib_KEY_WAIT_NONE;
+        before= out;
+        out= keyseq_set_mods(ki, out, &held, mods, held_kc, wait);
+        if (out != before) wait= PerlXlib_KEY_WAIT_NONE;
+        if (slot >= 0 && spare_sym[slot] != sym) {
+            out= keyseq_push(out, PerlXlib_KEY_REMAP, keycode, sym, PerlXlib_KEY_WAIT_NONE);
+            spare_sym[slot]= sym;
+            remapped[keycode]= 1;
+        }
+        out= keyseq_push(out, PerlXlib_KEY_PRESS, keycode, NoSymbol, wait);
+        out= keyseq_push(out, PerlXlib_KEY_RELEASE, keycode, NoSymbol, PerlXlib_KEY_WAIT_HOLD);
+    }
+    out= keyseq_set_mods(ki, out, &held, 0, held_kc, PerlXlib_KEY_WAIT_NONE);
+    if (nbusy)
+        out= keyseq_push(out, PerlXlib_KEY_SYNC, 0, NoSymbol, PerlXlib_KEY_WAIT_NONE);
+    for (i= 0; i < 256; i++)
+        if (remapped[i])
+            out= keyseq_push(out, PerlXlib_KEY_RESTORE, i, NoSymbol, PerlXlib_KEY_WAIT_NONE);
+    return out - start;
+}
@@ -0,0 +1,403 @@
+/* Compact keymap tables for X11::Xlib::Keymap.
+ *
+ * This file is included by PerlXlib.c
+ *
+ * The index is one PV holding a PerlXlib_keymap_index header followed by
+ *   KeySym   syms[256 * nsym]           keycode x level -> KeySym
+ *   KeyCode  modmap[8 * max_keypermod]  as returned by XGetModifierMapping
+ *   entry    rev[rev_mask + 1]          open-addressing hash KeySym -> (keycode, level)
+ * The reverse hash holds the lowest keycode (and lowest level of that keycode)
+ * for each KeySym, matching what the old Perl 'rkeymap' hash produced.  It
+ * also holds an alias for each KeySym that has a Unicode equivalent under a
+ * different KeySym value (like the legacy Latin-2 KeySyms vs. 0x1000000+U),
+ * so that a character finds its key whichever form the keymap uses.  A real
+ * entry always wins over an alias.
+ *
+ * When the server reports a change to a range of keycodes, only those rows
+ * are replaced, and only the hash entries that pointed to them are redone.
+ *
+ * An index loaded through XKB has a PerlXlib_keymap_xkb section at the end
+ * (see xkb_keymap.c), which lookups use in place of the core rules for keys
+ * it describes.  Replacing rows from core data drops those keys from it.
+ */
+
+typedef struct PerlXlib_keymap_rev_ent {
+    KeySym sym;
+    U8 keycode, level, alias;
+} PerlXlib_keymap_rev_ent;
+
+#define KMIDX_SYMS(ki)   ((KeySym*) ((ki) + 1))
+#define KMIDX_MODMAP(ki) ((KeyCode*) (KMIDX_SYMS(ki) + 256 * (ki)->nsym))
+#define KMIDX_REV(ki)    ((PerlXlib_keymap_rev_ent*) (((size_t) (KMIDX_MODMAP(ki) + 8 * (ki)->max_keypermod) \
+                            + sizeof(KeySym) - 1) & ~(size_t)(sizeof(KeySym) - 1)))
+#define KMIDX_XKB(ki)    ((ki)->xkb_off? (PerlXlib_keymap_xkb*) ((char*) (ki) + (ki)->xkb_off) : NULL)
+
+static U32 kmidx_hash(KeySym sym) {
+    U32 h= (U32) sym ^ (U32) (sym >> 16);
+    return h * 2654435761U;
+}
+
+static PerlXlib_keymap_rev_ent* kmidx_rev_slot(const PerlXlib_keymap_index *ki, KeySym sym) {
+    PerlXlib_keymap_rev_ent *rev= KMIDX_REV(ki);
+    U32 i= kmidx_hash(sym) & ki->rev_mask;
+    while (rev[i].sym && rev[i].sym != sym)
+        i= (i + 1) & ki->rev_mask;
+    return rev + i;
+}
+
+/* Remove an entry, shifting later entries of the probe sequence back into the hole */
+static void kmidx_rev_delete(const PerlXlib_keymap_index *ki, PerlXlib_keymap_rev_ent *ent) {
+    PerlXlib_keymap_rev_ent *rev= KMIDX_REV(ki);
+    U32 i= ent - rev, j= i, home;
+    while (1) {
+        j= (j + 1) & ki->rev_mask;
+        if (!rev[j].sym) break;
+        home= kmidx_hash(rev[j].sym) & ki->rev_mask;
+        /* leave it if its home slot is cyclically within (i, j] */
+        if (i <= j? (i < home && home <= j) : (i < home || home <= j))
+            continue;
+        rev[i]= rev[j];
+        i= j;
+    }
+    rev[i].sym= NoSymbol;
+}
+
+/* Record (keycode, level) for 'sym' if the hash has nothing better for it */
+static void kmidx_offer(const PerlXlib_keymap_index *ki, KeySym sym, int keycode, int level, int alias) {
+    PerlXlib_keymap_rev_ent *ent= kmidx_rev_slot(ki, sym);
+    if (ent->sym && (
+        alias != ent->alias? alias > ent->alias
+        : keycode != ent->keycode? keycode > ent->keycode
+        : level >= ent->level))
+        return;
+    ent->sym= sym;
+    ent->keycode= keycode;
+    ent->level= level;
+    ent->alias= alias;
+}
+
+/* The other KeySym that means the same Unicode character, or NoSymbol */
+static KeySym kmidx_alias(KeySym sym) {
+    int cp= PerlXlib_keysym_to_codepoint(sym);
+    KeySym alias;
+    if (cp < 0) return NoSymbol;
+    alias= PerlXlib_codepoint_to_keysym(cp);
+    return alias == sym? NoSymbol : alias;
+}
+
+/* Offer every KeySym of keycodes first..last, and their aliases */
+static void kmidx_offer_rows(const PerlXlib_keymap_index *ki, int first, int last) {
+    KeySym sym, alias;
+    int i, j;
+    for (i= first; i <= last; i++) {
+        for (j= 0; j < ki->nsym; j++) {
+            if ((sym= KMIDX_SYMS(ki)[i * ki->nsym + j]) == NoSymbol) continue;
+            kmidx_offer(ki, sym, i, j, 0);
+            if ((alias= kmidx_alias(sym)) != NoSymbol)
+                kmidx_offer(ki, alias, i, j, 1);
+        }
+    }
+}
+
+/* True if any key in modifier group 'mod' has KeySym 'sym' at any level */
+static int kmidx_mod_has_sym(const PerlXlib_keymap_index *ki, int mod, KeySym sym) {
+    const KeyCode *mm= KMIDX_MODMAP(ki) + mod * ki->max_keypermod;
+    const KeySym *row;
+    int i, j;
+    for (i= 0; i < ki->max_keypermod; i++) {
+        if (!mm[i]) continue;
+        row= KMIDX_SYMS(ki) + mm[i] * ki->nsym;
+        for (j= 0; j < ki->nsym; j++)
+            if (row[j] == sym) return 1;
+    }
+    return 0;
+}
+
+/* Identify modifier groups, the same way as Keymap::modmap_ident */
+static void kmidx_ident(PerlXlib_keymap_index *ki) {
+    int i;
+    ki->capslock= ki->shiftlock= ki->numlock= ki->mode= -1;
+    if (!ki->max_keypermod) return;
+    if (kmidx_mod_has_sym(ki, LockMapIndex, XK_Caps_Lock))
+        ki->capslock= LockMapIndex;
+    else if (kmidx_mod_has_sym(ki, LockMapIndex, XK_Shift_Lock))
+        ki->shiftlock= LockMapIndex;
+    for (i= Mod1MapIndex; i <= Mod5MapIndex; i++) {
+        if (kmidx_mod_has_sym(ki, i, XK_Num_Lock))    ki->numlock= i;
+        if (kmidx_mod_has_sym(ki, i, XK_Mode_switch)) ki->mode= i;
+    }
+}
+
+/* Build the index into 'out' from the keysyms of keycodes min_keycode..max_keycode
+ * (nsym per keycode) and the modifier map.
+ */
+void PerlXlib_keymap_index_build(SV *out, const KeySym *syms, int min_keycode, int max_keycode, int nsym,
+    const KeyCode *modmap, int max_keypermod
+) {
+    PerlXlib_keymap_index *ki;
+    size_t size, rev_size;
+
+    if (min_keycode < 0) min_keycode= 0;
+    if (max_keycode > 255) max_keycode= 255;
+    if (nsym < 1) nsym= 1;
+    if (max_keypermod < 0) max_keypermod= 0;
+    /* at most two entries per KeySym, so the hash stays under half full */
+    for (rev_size= 64; rev_size < (size_t)(max_keycode - min_keycode + 1) * nsym * 4; rev_size <<= 1) {}
+    size= sizeof(PerlXlib_keymap_index) + 256 * nsym * sizeof(KeySym) + 8 * max_keypermod
+        + sizeof(KeySym) + rev_size * sizeof(PerlXlib_keymap_rev_ent);
+    sv_setpvn(out, "", 0);
+    ki= (PerlXlib_keymap_index*) SvGROW(out, size + 1);
+    memset(ki, 0, size + 1);
+    SvCUR_set(out, size);
+    ki->min_keycode= min_keycode;
+    ki->max_keycode= max_keycode;
+    ki->nsym= nsym;
+    ki->max_keypermod= max_keypermod;
+    ki->rev_mask= rev_size - 1;
+    if (max_keycode >= min_keycode)
+        memcpy(KMIDX_SYMS(ki) + min_keycode * nsym, syms, (max_keycode - min_keycode + 1) * nsym * sizeof(KeySym));
+    if (max_keypermod)
+        memcpy(KMIDX_MODMAP(ki), modmap, 8 * max_keypermod);
+
+    kmidx_offer_rows(ki, min_keycode, max_keycode);
+    kmidx_ident(ki);
+}
+
+/* Build the index again with new dimensions, keeping its XKB section */
+static void kmidx_rebuild(SV *idx, const KeySym *syms, int nsym, const KeyCode *modmap, int max_keypermod) {
+    PerlXlib_keymap_index *ki= (PerlXlib_keymap_index*) SvPVX(idx);
+    char *xkb= NULL;
+    STRLEN xkb_len= ki->xkb_off? SvCUR(idx) - ki->xkb_off : 0;
+    if (xkb_len) {
+        Newx(xkb, xkb_len, char);
+        Copy((char*) ki + ki->xkb_off, xkb, xkb_len, char);
+    }
+    PerlXlib_keymap_index_build(idx, syms, ki->min_keycode, ki->max_keycode, nsym, modmap, max_keypermod);
+    if (xkb_len) {
+        PerlXlib_keymap_index_attach_xkb(idx, xkb, xkb_len);
+        Safefree(xkb);
+    }
+}
+
+/* Replace the KeySyms of keycodes first..first+count-1 with 'syms' (nsym per
+ * keycode), as returned by XGetKeyboardMapping for a MappingNotify event.
+ */
+void PerlXlib_keymap_index_update(SV *idx, const KeySym *syms, int first, int count, int nsym) {
+    PerlXlib_keymap_index *ki= (PerlXlib_keymap_index*) SvPVX(idx);
+    PerlXlib_keymap_rev_ent *ent;
+    PerlXlib_keymap_xkb *xkb;
+    KeySym *row, *lost, *tmp, sym, key;
+    KeyCode *mm;
+    int last= first + count - 1, n_lost= 0, i, j, k, n_rows;
+
+    if (first < ki->min_keycode) {
+        syms += (ki->min_keycode - first) * nsym;
+        first= ki->min_keycode;
+    }
+    if (last > ki->max_keycode)
+        last= ki->max_keycode;
+    if (first > last || nsym < 1)
+        return;
+
+    if ((xkb= KMIDX_XKB(ki)))
+        for (i= first; i <= last; i++)
+            xkb->num_groups[i]= 0;
+
+    /* More levels than the table has room for: rebuild it wider */
+    if (nsym > ki->nsym) {
+        n_rows= ki->max_keycode - ki->min_keycode + 1;
+        Newxz(tmp, n_rows * nsym, KeySym);
+        Newx(mm, 8 * ki->max_keypermod + 1, KeyCode);
+        for (i= ki->min_keycode; i <= ki->max_keycode; i++) {
+            if (i >= first && i <= last)
+                Copy(syms + (i - first) * nsym, tmp + (i - ki->min_keycode) * nsym, nsym, KeySym);
+            else
+                Copy(KMIDX_SYMS(ki) + i * ki->nsym, tmp + (i - ki->min_keycode) * nsym, ki->nsym, KeySym);
+        }
+        Copy(KMIDX_MODMAP(ki), mm, 8 * ki->max_keypermod, KeyCode);
+        kmidx_rebuild(idx, tmp, nsym, mm, ki->max_keypermod);
+        Safefree(tmp);
+        Safefree(mm);
+        return;
+    }
+
+    /* Drop the hash entries that point into the range, remembering their keys */
+    Newx(lost, (last - first + 1) * ki->nsym * 2, KeySym);
+    for (i= first; i <= last; i++) {
+        row= KMIDX_SYMS(ki) + i * ki->nsym;
+        for (j= 0; j < ki->nsym; j++) {
+            for (k= 0, key= row[j]; k < 2 && key != NoSymbol; k++, key= kmidx_alias(row[j])) {
+                ent= kmidx_rev_slot(ki, key);
+                if (ent->sym && ent->keycode >= first && ent->keycode <= last) {
+                    kmidx_rev_delete(ki, ent);
+                    lost[n_lost++]= key;
+                }
+            }
+        }
+    }
+    for (i= first; i <= last; i++) {
+        row= KMIDX_SYMS(ki) + i * ki->nsym;
+        for (j= 0; j < ki->nsym; j++)
+            row[j]= j < nsym? syms[(i - first) * nsym + j] : NoSymbol;
+    }
+    kmidx_offer_rows(ki, first, last);
+
+    /* A key that got a real entry back from the new rows has its best one,
+     * because any lower keycode outside the range would already have held it.
+     * The rest may still exist on other keys.
+     */
+    for (i= j= 0; i < n_lost; i++) {
+        ent= kmidx_rev_slot(ki, lost[i]);
+        if (!ent->sym || ent->alias)
+            lost[j++]= lost[i];
+    }
+    if ((n_lost= j)) {
+        for (i= ki->min_keycode; i <= ki->max_keycode; i++) {
+            if (i == first) { i= last; continue; }
+            row= KMIDX_SYMS(ki) + i * ki->nsym;
+            for (j= 0; j < ki->nsym; j++) {
+                if ((sym= row[j]) == NoSymbol) continue;
+                key= kmidx_alias(sym);
+                for (k= 0; k < n_lost; k++) {
+                    if (lost[k] == sym) kmidx_offer(ki, sym, i, j, 0);
+                    else if (lost[k] == key) kmidx_offer(ki, key, i, j, 1);
+                }
+            }
+        }
+    }
+    Safefree(lost);
+    kmidx_ident(ki);
+}
+
+/* Replace the modifier map, as returned by XGetModifierMapping */
+void PerlXlib_keymap_index_set_modmap(SV *idx, const KeyCode *modmap, int max_keypermod) {
+    PerlXlib_keymap_index *ki= (PerlXlib_keymap_index*) SvPVX(idx);
+    KeySym *tmp;
+    int n_rows;
+    if (max_keypermod == ki->max_keypermod) {
+        Copy(modmap, KMIDX_MODMAP(ki), 8 * max_keypermod, KeyCode);
+        kmidx_ident(ki);
+        return;
+    }
+    /* The tables after the modmap move, so rebuild */
+    n_rows= ki->max_keycode - ki->min_keycode + 1;
+    Newx(tmp, n_rows * ki->nsym + 1, KeySym);
+    Copy(KMIDX_SYMS(ki) + ki->min_keycode * ki->nsym, tmp, n_rows * ki->nsym, KeySym);
+    kmidx_rebuild(idx, tmp, ki->nsym, modmap, max_keypermod);
+    Safefree(tmp);
+}
+
+/* Replace the XKB section of an index (or remove it, if len is 0) */
+void PerlXlib_keymap_index_attach_xkb(SV *idx, const char *xkb, STRLEN len) {
+    PerlXlib_keymap_index *ki= (PerlXlib_keymap_index*) SvPVX(idx);
+    STRLEN base= ki->xkb_off? ki->xkb_off : (SvCUR(idx) + 7) & ~(STRLEN)7;
+    ki= (PerlXlib_keymap_index*) SvGROW(idx, base + len + 1);
+    if (len) Copy(xkb, (char*) ki + base, len, char);
+    ki->xkb_off= len? base : 0;
+    SvCUR_set(idx, len? base + len : base);
+}
+
+/* KeySym at (keycode, level), or NoSymbol */
+KeySym PerlXlib_keymap_index_get(const PerlXlib_keymap_index *ki, int keycode, int level) {
+    if (keycode < ki->min_keycode || keycode > ki->max_keycode || level < 0 || level >= ki->nsym)
+        return NoSymbol;
+    return KMIDX_SYMS(ki)[keycode * ki->nsym + level];
+}
+
+/* The KeySyms of 'keycode' and the rows after it, nsym per row, or NULL */
+const KeySym* PerlXlib_keymap_index_rows(const PerlXlib_keymap_index *ki, int keycode) {
+    if (keycode < ki->min_keycode || keycode > ki->max_keycode)
+        return NULL;
+    return KMIDX_SYMS(ki) + keycode * ki->nsym;
+}
+
+/* Write to 'ranges' the (first, last) pairs of the keycodes in min..max whose
+ * KeySyms differ between two indexes, and return the number of pairs.  Runs
+ * of differing keys separated by no more than 'gap' equal keys are merged
+ * into one range.  'ranges' needs room for 256 pairs.
+ */
+int PerlXlib_keymap_index_diff(const PerlXlib_keymap_index *a, const PerlXlib_keymap_index *b,
+    int min, int max, int gap, int *ranges
+) {
+    int i, j, n= 0, nsym= a->nsym > b->nsym? a->nsym : b->nsym, differs;
+    if (min < 0) min= 0;
+    if (max > 255) max= 255;
+    for (i= min; i <= max; i++) {
+        for (j= 0, differs= 0; j < nsym && !differs; j++)
+            differs= PerlXlib_keymap_index_get(a, i, j) != PerlXlib_keymap_index_get(b, i, j);
+        if (!differs) continue;
+        if (n && i - ranges[n*2-1] - 1 <= gap)
+            ranges[n*2-1]= i;
+        else {
+            ranges[n*2]= ranges[n*2+1]= i;
+            n++;
+        }
+    }
+    return n;
+}
+
+/* The modifier map, 8 groups of max_keypermod keycodes */
+const KeyCode* PerlXlib_keymap_index_modmap(const PerlXlib_keymap_index *ki) {
+    return KMIDX_MODMAP(ki);
+}
+
+/* Modifier bits needed to reach 'level' of a key: Shift for odd levels, and
+ * the Mode_switch modifier for levels 2 and 3.  Returns -1 if the level can't
+ * be reached with modifiers alone.
+ */
+int PerlXlib_keymap_index_level_mods(const PerlXlib_keymap_index *ki, int level) {
+    if (level < 0 || level > 3 || (level >= 2 && ki->mode < 0))
+        return -1;
+    return ((level & 1)? ShiftMask : 0) | ((level & 2)? (1 << ki->mode) : 0);
+}
+
+/* Modifier bits needed to reach 'level' of one key.  With XKB data for the
+ * key this comes from its key type, and may include group bits (see
+ * PerlXlib_keymap_xkb_key_mods), else it is PerlXlib_keymap_index_level_mods.
+ */
+int PerlXlib_keymap_index_key_mods(const PerlXlib_keymap_index *ki, int keycode, int level) {
+    const PerlXlib_keymap_xkb *xkb= KMIDX_XKB(ki);
+    if (xkb && keycode >= 0 && keycode < 256 && xkb->num_groups[keycode])
+        return PerlXlib_keymap_xkb_key_mods(ki, keycode, level);
+    return PerlXlib_keymap_index_level_mods(ki, level);
+}
+
+/* Find the keycode for a KeySym, or 0.  Optionally also return its level. */
+int PerlXlib_keymap_index_find_keycode(const PerlXlib_keymap_index *ki, KeySym sym, int *level) {
+    PerlXlib_keymap_rev_ent *ent;
+    if (sym == NoSymbol) return 0;
+    ent= kmidx_rev_slot(ki, sym);
+    if (!ent->sym && (sym= kmidx_alias(sym)) != NoSymbol)
+        ent= kmidx_rev_slot(ki, sym);
+    if (!ent->sym) return 0;
+    if (level) *level= ent->level;
+    return ent->keycode;
+}
+
+/* Interpret a keycode under the given modifier state, like Keymap::find_keysym */
+KeySym PerlXlib_keymap_index_find_keysym(const PerlXlib_keymap_index *ki, int keycode, unsigned modifiers) {
+    const PerlXlib_keymap_xkb *xkb= KMIDX_XKB(ki);
+    KeySym lower, upper, sym;
+    int shift, capslock, shiftlock, numlock, mode;
+    if (keycode < ki->min_keycode || keycode > ki->max_keycode)
+        return NoSymbol;
+    if (xkb && xkb->num_groups[keycode])
+        return PerlXlib_keymap_xkb_translate(ki, keycode, modifiers);
+    if (!modifiers)
+        return PerlXlib_keymap_index_get(ki, keycode, 0);
+    shift=     modifiers & ShiftMask;
+    capslock=  ki->capslock >= 0  && (modifiers & (1 << ki->capslock));
+    shiftlock= ki->shiftlock >= 0 && (modifiers & (1 << ki->shiftlock));
+    numlock=   ki->numlock >= 0   && (modifiers & (1 << ki->numlock));
+    mode=      (ki->mode >= 0 && (modifiers & (1 << ki->mode)))? 2 : 0;
+    sym= PerlXlib_keymap_index_get(ki, keycode, 1);
+    if (numlock && (IsKeypadKey(sym) || IsPrivateKeypadKey(sym)))
+        return PerlXlib_keymap_index_get(ki, keycode, (shift || shiftlock)? mode : mode + 1);
+    if (!shift && !capslock && !shiftlock)
+        return PerlXlib_keymap_index_get(ki, keycode, mode);
+    if (capslock) {
+        XConvertCase(PerlXlib_keymap_index_get(ki, keycode, shift? mode + 1 : mode), &lower, &upper);
+        return upper;
+    }
+    return PerlXlib_keymap_index_get(ki, keycode, mode + 1);
+}
@@ -39,14 +39,45 @@ my %_constants= (
     VisibilityChangeMask )],
   const_ext_composite => [qw( CompositeRedirectAutomatic
     CompositeRedirectManual )],
+  const_ext_damage => [qw( XDamageNotify XDamageReportBoundingBox
+    XDamageReportDeltaRectangles XDamageReportNonEmpty
+    XDamageReportRawRectangles )],
+  const_ext_render => [qw( CPAlphaMap CPAlphaXOrigin CPAlphaYOrigin CPClipMask
+    CPClipXOrigin CPClipYOrigin CPComponentAlpha CPDither CPGraphicsExposure
+    CPPolyEdge CPPolyMode CPRepeat CPSubwindowMode PictOpAdd PictOpAtop
+    PictOpAtopReverse PictOpClear PictOpDst PictOpIn PictOpInReverse PictOpOut
+    PictOpOutReverse PictOpOver PictOpOverReverse PictOpSaturate PictOpSrc
+    PictOpXor PictStandardA1 PictStandardA4 PictStandardA8 PictStandardARGB32
+    PictStandardRGB24 RepeatNone RepeatNormal RepeatPad RepeatReflect )],
   const_ext_shape => [qw( ShapeBounding ShapeClip ShapeInput ShapeIntersect
     ShapeInvert ShapeSet ShapeSubtract ShapeUnion )],
+  const_ext_xi2 => [qw( XIAllDevices XIAllMasterDevices XIButtonClass
+    XIFloatingSlave XIKeyClass XIMasterKeyboard XIMasterPointer XIScrollClass
+    XISlaveKeyboard XISlavePointer XITouchClass XIValuatorClass XI_ButtonPress
+    XI_ButtonRelease XI_DeviceChanged XI_Enter XI_FocusIn XI_FocusOut
+    XI_HierarchyChanged XI_KeyPress XI_KeyRelease XI_Leave XI_Motion
+    XI_PropertyEvent XI_RawButtonPress XI_RawButtonRelease XI_RawKeyPress
+    XI_RawKeyRelease XI_RawMotion XI_RawTouchBegin XI_RawTouchEnd
+    XI_RawTouchUpdate XI_TouchBegin XI_TouchEnd XI_TouchUpdate )],
+  const_gc => [qw( ArcChord ArcPieSlice CapButt CapNotLast CapProjecting
+    CapRound ClipByChildren CoordModeOrigin CoordModePrevious EvenOddRule
+    FillOpaqueStippled FillSolid FillStippled FillTiled GCArcMode GCBackground
+    GCCapStyle GCClipMask GCClipXOrigin GCClipYOrigin GCDashList GCDashOffset
+    GCFillRule GCFillStyle GCFont GCForeground GCFunction GCGraphicsExposures
+    GCJoinStyle GCLineStyle GCLineWidth GCPlaneMask GCStipple GCSubwindowMode
+    GCTile GCTileStipXOrigin GCTileStipYOrigin GXand GXandInverted
+    GXandReverse GXclear GXcopy GXcopyInverted GXequiv GXinvert GXnand GXnoop
+    GXnor GXor GXorInverted GXorReverse GXset GXxor IncludeInferiors JoinBevel
+    JoinMiter JoinRound LineDoubleDash LineOnOffDash LineSolid WindingRule
+    )],
+  const_image => [qw( LSBFirst MSBFirst )],
   const_input => [qw( AnyKey AnyModifier AsyncBoth AsyncKeyboard AsyncPointer
     Button1Mask Button2Mask Button3Mask Button4Mask Button5Mask ControlMask
-    GrabModeAsync GrabModeSync LockMask Mod1Mask Mod2Mask Mod3Mask Mod4Mask
-    Mod5Mask NoSymbol PointerRoot ReplayKeyboard ReplayPointer RevertToNone
-    RevertToParent RevertToPointerRoot ShiftMask SyncBoth SyncKeyboard
-    SyncPointer XK_VoidSymbol )],
+    GrabModeAsync GrabModeSync LockMask MappingBusy MappingFailed
+    MappingKeyboard MappingModifier MappingPointer MappingSuccess Mod1Mask
+    Mod2Mask Mod3Mask Mod4Mask Mod5Mask NoSymbol PointerRoot ReplayKeyboard
+    ReplayPointer RevertToNone RevertToParent RevertToPointerRoot ShiftMask
+    SyncBoth SyncKeyboard SyncPointer XK_VoidSymbol )],
   const_sizehint => [qw( PAspect PBaseSize PMaxSize PMinSize PPosition
     PResizeInc PSize PWinGravity USPosition USSize )],
   const_visual => [qw( VisualAllMask VisualBitsPerRGBMask VisualBlueMaskMask
@@ -69,12 +100,17 @@ my %_constants= (
 my %_functions= (
 # BEGIN GENERATED XS FUNCTION LIST
   fn_atom => [qw( XGetAtomName XGetAtomNames XInternAtom XInternAtoms )],
-  fn_conn => [qw( ConnectionNumber XCloseDisplay XDisplayName XOpenDisplay
-    XServerVendor XSetCloseDownMode XVendorRelease )],
+  fn_conn => [qw( ConnectionNumber LastKnownRequestProcessed NextRequest
+    XCloseDisplay XDisplayName XOpenDisplay XServerVendor XSetCloseDownMode
+    XVendorRelease )],
   fn_event => [qw( XCheckMaskEvent XCheckTypedEvent XCheckTypedWindowEvent
-    XCheckWindowEvent XEventsQueued XFlush XGetErrorDatabaseText XGetErrorText
-    XNextEvent XPending XPutBackEvent XQLength XSelectInput XSendEvent XSync
-    )],
+    XCheckWindowEvent XEventsQueued XFlush XFreeEventData
+    XGetErrorDatabaseText XGetErrorText XGetEventData XNextEvent XPending
+    XPutBackEvent XQLength XSelectInput XSendEvent XSync )],
+  fn_gc => [qw( XChangeGC XCreateGC XDrawArcs XDrawLines XDrawPoints
+    XDrawRectangles XDrawSegments XFillArcs XFillRectangles XFreeGC
+    XGetGCValues XSetBackground XSetForeground )],
+  fn_image => [qw( convert_pixels tile_diff )],
   fn_input => [qw( XAllowEvents XBell XGrabButton XGrabKey XGrabKeyboard
     XGrabPointer XQueryKeymap XQueryPointer XSetInputFocus XUngrabButton
     XUngrabKey XUngrabKeyboard XUngrabPointer keyboard_leds )],
@@ -83,7 +119,8 @@ my %_functions= (
     load_keymap save_keymap )],
   fn_keysym => [qw( IsFunctionKey IsKeypadKey IsMiscFunctionKey IsModifierKey
     IsPFKey IsPrivateKeypadKey XConvertCase XKeysymToString XStringToKeysym
-    char_to_keysym codepoint_to_keysym keysym_to_char keysym_to_codepoint )],
+    char_to_keysym codepoint_to_keysym keysym_to_char keysym_to_codepoint
+    keysyms_to_string string_to_keysyms )],
   fn_pix => [qw( XCreateBitmapFromData XCreatePixmap
     XCreatePixmapFromBitmapData XFreePixmap )],
   fn_screen => [qw( DefaultColormap DefaultDepth DefaultGC DefaultScreen
@@ -103,7 +140,7 @@ my %_functions= (
     XSetWindowBorderWidth XSetWindowColormap XTranslateCoordinates
     XUndefineCursor XUnmapWindow )],
   fn_xtest => [qw( XTestFakeButtonEvent XTestFakeKeyEvent XTestFakeMotionEvent
-    )],
+    play_input )],
 # END GENERATED XS FUNCTION LIST
 );
 our @EXPORT_OK= map { @$_ } values %_constants, values %_functions;
@@ -119,15 +156,14 @@ our @EXPORT= @{ $EXPORT_TAGS{fn_keysym} }; # backward compatibility
 # Used by XS.  In the spirit of letting perl users violate encapsulation
 #  as needed, the XS code exposes its globals to Perl.
 our (
-    %_obj_cache,                # weak-ref set of all Xlib objects, keyed by *raw pointer*
     $_error_nonfatal_installed, # boolean, whether handler is installed
     $_error_fatal_installed,    # boolean, whether handler is installed
     $_error_fatal_trapped,      # boolean, whether Xlib is dead from fatal error
     $on_error,                  # application-supplied callback
 );
-sub _all_connections {
-    grep defined && $_->isa('X11::Xlib'), values %_obj_cache;
-}
+# The objects wrapping Xlib pointers are cached in C, keyed by the pointer and
+# without holding a reference.  _obj_cache_get($pointer_value) looks one up,
+# and _all_connections lists the Display objects.  See obj_cache.c
 
 sub new {
     require X11::Xlib::Display;
@@ -208,11 +244,11 @@ sub _mark_dead {
     my $pointer_value= $self->_pointer_value;
     # Clearing the pointer of a Display object cascades to all objects whose pointers
     # depend on the connection (which Xlib has now freed) and sets them all to NULL.
-    # That, in turn, removes them all from the _obj_cache
+    # That, in turn, removes them all from the object cache
     $self->_set_pointer_value(undef);
-    # The Display* still exists, so we should still allow finding this object vy looking up that pointer
+    # The Display* still exists, so we should still allow finding this object by looking up that pointer
     $self->{_pointer_value}= $pointer_value;
-    Scalar::Util::weaken( $_obj_cache{$pointer_value}= $self );
+    $self->_cache_pointer_value($pointer_value);
 }
 
 1;
@@ -395,6 +431,21 @@ Return the file descriptor (integer) of the socket connected to the server.
 This is useful for select/poll designs.
 (See also: L<X11::Xlib::Display/wait_event>)
 
+=head3 NextRequest
+
+  my $serial= NextRequest($display);
+
+The serial number that the next request will be sent with.
+
+=head3 LastKnownRequestProcessed
+
+  my $serial= LastKnownRequestProcessed($display);
+
+The serial number of the last request the server is known to have processed,
+which is the most recent one that Xlib has read a reply, event, or error for.
+Every error for a request at or below this serial has already been delivered.
+(See also: L<X11::Xlib::Display/error_trap>)
+
 =head3 XSetCloseDownMode
 
   XSetCloseDownMode($display, $close_mode)
@@ -515,6 +566,21 @@ Push an XEvent back onto your own incoming queue.
 This can presumably put arbitrarily bogus events onto your own queue
 since it returns void.
 
+=head3 XGetEventData
+
+  if (XGetEventData($display, $xevent)) { ... XFreeEventData($display, $xevent) }
+
+For a GenericEvent (the kind extensions like XInput2 send), fetch the extra
+data of the event from Xlib.  Returns false for other events, or if the data
+was already fetched or is no longer available.  Every successful call must be
+followed by L</XFreeEventData> on the same event.
+
+=head3 XFreeEventData
+
+  XFreeEventData($display, $xevent)
+
+Release the data fetched by L</XGetEventData>.
+
 =head3 XFlush
 
   XFlush($display)
@@ -743,6 +809,139 @@ This function uses a bitmap (1 bit per pixel) and a foreground and background
 color to build a pixmap of those two colors.  It's basically upscaling color
 from monochrome to C<$depth>.
 
+=head2 GRAPHICS CONTEXT FUNCTIONS
+
+=head3 XCreateGC
+
+  my $gc= XCreateGC($display, $drawable, $valuemask, \%values_or_XGCValues);
+
+Create a new L<GC|X11::Xlib::GC> for drawing on drawables of the same screen
+and depth as C<$drawable>.  C<$valuemask> is a bitwise OR of C<GCForeground>,
+C<GCLineWidth>, etc. naming which fields of the L<XGCValues|X11::Xlib::XGCValues>
+to use.  Both may be omitted to get the defaults.
+
+The object-oriented L<X11::Xlib::Display/new_gc> builds the mask for you and
+frees the GC when the object goes out of scope.
+
+=head3 XChangeGC
+
+  XChangeGC($display, $gc, $valuemask, \%values_or_XGCValues);
+
+=head3 XGetGCValues
+
+  XGetGCValues($display, $gc, $valuemask, my $values)
+    or die "Can't read GC";
+  say $values->foreground;
+
+Read back the named fields of the GC into an L<XGCValues|X11::Xlib::XGCValues>.
+(Xlib refuses to return C<GCClipMask> or C<GCDashList>)
+
+=head3 XFreeGC
+
+  XFreeGC($display, $gc);
+
+Free the GC, and clear the pointer held by the C<$gc> object so that further
+use of it dies instead of crashing.
+
+=head3 XSetForeground
+
+  XSetForeground($display, $gc, $pixel);
+
+=head3 XSetBackground
+
+  XSetBackground($display, $gc, $pixel);
+
+=head3 XDrawPoints
+
+  XDrawPoints($display, $drawable, $gc, $points, $mode = CoordModeOrigin);
+
+=head3 XDrawLines
+
+  XDrawLines($display, $drawable, $gc, $points, $mode = CoordModeOrigin);
+
+=head3 XDrawSegments
+
+  XDrawSegments($display, $drawable, $gc, $segments);
+
+=head3 XDrawRectangles
+
+  XDrawRectangles($display, $drawable, $gc, $rects);
+
+=head3 XFillRectangles
+
+  XFillRectangles($display, $drawable, $gc, $rects);
+
+=head3 XDrawArcs
+
+  XDrawArcs($display, $drawable, $gc, $arcs);
+
+=head3 XFillArcs
+
+  XFillArcs($display, $drawable, $gc, $arcs);
+
+Each of these draws any number of shapes with a single call to Xlib, which
+queues them as one protocol request (or as few as the server's maximum
+request size allows).  The shapes may be given as:
+
+=over
+
+=item an arrayref of arrayrefs
+
+  [ [ $x, $y, $w, $h ], ... ]
+
+with the values in C struct order:  C<XPoint> is C<< [x, y] >>,
+C<XSegment> is C<< [x1, y1, x2, y2] >>, C<XRectangle> is
+C<< [x, y, width, height] >> and C<XArc> is
+C<< [x, y, width, height, angle1, angle2] >> (angles in 64ths of a degree).
+Rectangles may also be L<XRectangle|X11::Xlib::XRectangle> objects or hashrefs.
+
+=item a packed string
+
+  pack('(s2S2)*', map @$_, @rects)
+
+in the native layout of the struct array (every field is 16 bits), such as
+one built up once and re-used for every frame.  This avoids creating any
+perl values per shape.  A scalar-ref to the string also works.
+
+=back
+
+=head2 IMAGE FUNCTIONS
+
+=head3 convert_pixels
+
+  my $rgba= convert_pixels($visual_info, $data, $width, $height, $bits_per_pixel,
+    $bytes_per_line, $dst_format, $byte_order);
+
+Convert image data in the server's native pixel layout into tightly packed
+C<"RGBA">, C<"RGB">, or C<"GRAY"> bytes (C<$dst_format> defaults to RGBA).
+The layout of the source pixels is described by the C<red_mask>, C<green_mask>
+and C<blue_mask> of C<$visual_info> (an L<X11::Xlib::XVisualInfo> or a hashref
+of those fields) along with C<$bits_per_pixel> (8, 16, 24, or 32),
+C<$bytes_per_line> (0 means rows are tightly packed), and C<$byte_order>
+(C<LSBFirst> or C<MSBFirst>, default C<LSBFirst>).  C<$data> may be a string
+or a reference to one.
+
+32bpp and 24bpp with 8-bit channels, and 16bpp 565, are converted with
+SSE2, SSSE3 or AVX2 code when the CPU supports it; other layouts use a slower
+generic path.  All paths give identical results.
+
+=head3 tile_diff
+
+  my @changed= tile_diff($state, $data, $width, $height, $bits_per_pixel,
+    $bytes_per_line, $tile_width, $tile_height);
+  my $region= $display->XFixesCreateRegion(\@changed) if @changed;
+
+Split an image into tiles (64x64 by default), hash each tile, and compare with
+the hashes from the previous call.  Returns a list of L<X11::Xlib::XRectangle>
+covering the tiles that changed, with adjacent changed tiles merged into larger
+rectangles.  C<$state> is any scalar variable; it is overwritten with the tile
+hashes for use on the next call, and if it is empty or was made for a different
+geometry then every tile is reported as changed.  C<$bytes_per_line> of 0 means
+the rows are tightly packed.
+
+The hash is a fast non-cryptographic one, computed with SSE2 or AVX2 when
+available.
+
 =head2 WINDOW FUNCTIONS
 
 =head3 XCreateWindow
@@ -1066,6 +1265,38 @@ before sending the event. The default is 10 milliseconds.
 
 See L<X11::Xlib::Keymap/EXAMPLES>.
 
+=head3 play_input
+
+  my $report= play_input($display, $actions, $samples);
+  # $actions= [ [ MotionNotify, -1, 100, 100, 0 ], [ ButtonPress, 1, 0, 0, 50 ], ... ]
+  # $actions= pack('(l5)*', ...)
+
+Play a whole list of fake input events from C, each C<[ $type, $detail, $x,
+$y, $delay_ms ]>.  C<$type> is one of C<KeyPress>, C<KeyRelease>,
+C<ButtonPress>, C<ButtonRelease> or C<MotionNotify>, and C<$detail> is the
+keycode, the button number, or the screen to move the pointer on (-1 for the
+current one).  C<$x> and C<$y> only apply to motion.  C<$delay_ms> is the time
+after the previous action was scheduled (so being late for one action doesn't
+push back the rest), and is waited out on the monotonic clock instead of with
+the XTest send delay.  Actions can also be given as a string of native 32-bit
+integers, five per action.
+
+The request buffer is flushed whenever the next action isn't due yet, so
+actions with no delay between them are sent together.  This returns after the
+last action has been sent, with a hashref describing the timing:
+
+  count          number of actions
+  scheduled_us   total of the delays
+  duration_us    time actually taken
+  late_mean_us   how long after its scheduled time each action was flushed
+  late_p50_us
+  late_p99_us
+  late_max_us
+  late_us        arrayref of each action's lateness, if $samples is true
+
+The whole list is checked before anything is sent, and croaks if an action is
+invalid.
+
 =head2 KEYSYM FUNCTIONS
 
 These utility functions help identify and convert KeySym values, and do not
@@ -1118,6 +1349,26 @@ have a first character.
 Like L</keysym_to_codepoint> example above, but returns a string if there is
 a valid codepoint, and C<undef> otherwise.
 
+=head3 keysyms_to_string
+
+  my $str= keysyms_to_string(\@keysyms);
+  my $str= keysyms_to_string(\@keysyms, $replacement_char);
+
+Convert a whole list of KeySyms to a string in one call.  KeySyms that have
+no character are left out, or replaced by the first character of
+C<$replacement_char> if given.
+
+=head3 string_to_keysyms
+
+  my @keysyms= string_to_keysyms($str);
+  my @keysyms= string_to_keysyms($str, $prefer_legacy);
+
+Convert every character of a string to a KeySym in one call, the same as
+L</char_to_keysym> on each character.  If C<$prefer_legacy> is true,
+characters that have one of the older pre-Unicode KeySyms (like
+C<Ccircumflex> or C<Cyrillic_a>, and C<Tab> or C<Return> for control
+characters) get that KeySym instead of the C<0x1000000 + codepoint> form.
+
 =head3 XConvertCase
 
   XConvertCase($keysym, $lowercase_out, $uppercase_out);
@@ -1420,6 +1671,57 @@ None of these functions are exportable.
 
   $display->XCompositeReleaseOverlayWindow($window);
 
+=head2 EXTENSION XFIXES
+
+This is an optional extension.  If you have Xfixes available when this
+module was installed, then the following functions will be available.
+None of these functions are exportable.
+
+  sudo apt-get install libxfixes-dev   # Debian/Mint/Ubuntu
+  sudo yum install libXfixes-devel     # Fedora/RHEL
+
+See L<X11::Xlib::Region> for building regions on the client side and
+uploading or downloading them with a single request.
+
+=head3 XFixesVersion
+
+  my $version_integer= X11::Xlib::XFixesVersion()
+    if X11::Xlib->can('XFixesVersion');
+
+=head3 XFixesQueryExtension
+
+  my ($event_base, $error_base)= $display->XFixesQueryExtension
+    if $display->can('XFixesQueryExtension');
+
+=head3 XFixesQueryVersion
+
+  my ($major, $minor)= $display->XFixesQueryVersion
+    if $display->can('XFixesQueryVersion');
+
+=head3 XFixesCreateRegion
+
+  my $XserverRegion= $display->XFixesCreateRegion(\@rects);
+  my $XserverRegion= $display->XFixesCreateRegion($packed_rects);
+  my $XserverRegion= $display->XFixesCreateRegion($region);
+
+Create a server-side region from an arrayref of L<X11::Xlib::XRectangle>
+(or hashrefs or C<[ $x, $y, $w, $h ]> arrayrefs), a string of packed
+XRectangle structs, or an L<X11::Xlib::Region>.
+
+=head3 XFixesFetchRegion
+
+  my @rects= $display->XFixesFetchRegion($XserverRegion);
+
+Return the rectangles of a server-side region as L<X11::Xlib::XRectangle>.
+
+=head3 XFixesDestroyRegion
+
+  $display->XFixesDestroyRegion($XserverRegion);
+
+=head3 XFixesSetWindowShapeRegion
+
+  $display->XFixesSetWindowShapeRegion($window, $shape_kind, $x_off, $y_off, $XserverRegion);
+
 =head2 EXTENSION XRENDER
 
 This is an optional extension.  If you have Xrender available when this
@@ -1445,6 +1747,248 @@ None of these functions are exportable.
 
 Takes a L<X11::Xlib::Visual>, and returns a L<X11::Xlib::XRenderPictFormat>.
 
+=head3 XRenderFindStandardFormat
+
+  my $pfmt= $display->XRenderFindStandardFormat( PictStandardARGB32 );
+
+Returns the L<X11::Xlib::XRenderPictFormat> for one of C<PictStandardARGB32>,
+C<PictStandardRGB24>, C<PictStandardA8>, C<PictStandardA4> or C<PictStandardA1>.
+
+=head3 XRenderCreatePicture
+
+  my $picture= $display->XRenderCreatePicture($drawable, $pfmt, $valuemask, \%attrs);
+
+Create a Picture for the drawable, interpreting its pixels with the given
+L<XRenderPictFormat|X11::Xlib::XRenderPictFormat>.  C<$valuemask> is a bitwise
+OR of C<CPRepeat>, C<CPClipMask>, etc. naming which fields of the
+L<XRenderPictureAttributes|X11::Xlib::XRenderPictureAttributes> to use.
+Both may be omitted.
+On L<X11::Xlib::Display>, this returns a L<X11::Xlib::Picture> object; see also
+L<X11::Xlib::Display/new_picture>.
+
+=head3 XRenderChangePicture
+
+  $display->XRenderChangePicture($picture, $valuemask, \%attrs);
+
+=head3 XRenderFreePicture
+
+  $display->XRenderFreePicture($picture);
+
+=head3 XRenderComposite
+
+  $display->XRenderComposite($op, $src, $mask, $dst,
+    $src_x, $src_y, $mask_x, $mask_y, $dst_x, $dst_y, $width, $height);
+
+Blend a rectangle of C<$src> (optionally through the alpha of C<$mask>, which
+may be C<None>) onto C<$dst> using operator C<$op> such as C<PictOpOver>.
+Any transform and filter of C<$src> are applied, so this is also how to scale
+an image on the server.
+
+=head3 XRenderFillRectangles
+
+  $display->XRenderFillRectangles($op, $dst, $color, $rects);
+
+Fill any number of rectangles with an L<XRenderColor|X11::Xlib::XRenderColor>
+(or hashref of C<red>, C<green>, C<blue>, C<alpha>) in one request.
+C<$rects> is either an arrayref of C<< [x, y, width, height] >> /
+L<XRectangle|X11::Xlib::XRectangle>, or a packed string of XRectangle, the same
+as for L</XFillRectangles>.
+
+=head3 XRenderSetPictureTransform
+
+  $display->XRenderSetPictureTransform($picture, [ [ $sx, 0, 0 ], [ 0, $sy, 0 ], [ 0, 0, 1 ] ]);
+
+Set the 3x3 projective transform used when the picture is the source of a
+composite.  The matrix maps destination coordinates to source coordinates, so
+to shrink an image by half, use a scale of C<2>.  The matrix may also be given
+as a flat list of 9 values.
+
+=head3 XRenderSetPictureFilter
+
+  $display->XRenderSetPictureFilter($picture, 'bilinear', \@params);
+
+Set the filter used when sampling a transformed picture, such as C<'nearest'>,
+C<'bilinear'>, C<'fast'>, C<'good'>, C<'best'> or C<'convolution'> (which takes
+the kernel width, height and values as C<@params>).
+
+=head3 XRenderCreateGlyphSet
+
+  my $glyphset= $display->XRenderCreateGlyphSet($pfmt);
+
+Create a GlyphSet whose glyph images have the given format, usually
+C<XRenderFindStandardFormat(PictStandardA8)>.  L<X11::Xlib::GlyphCache>
+manages one for you.
+
+=head3 XRenderFreeGlyphSet
+
+  $display->XRenderFreeGlyphSet($glyphset);
+
+=head3 XRenderAddGlyphs
+
+  $display->XRenderAddGlyphs($glyphset, \@glyph_ids, $infos, $images);
+
+Upload any number of glyphs in one request.  C<$infos> is an arrayref of
+L<XGlyphInfo|X11::Xlib::XGlyphInfo> (or hashrefs, or C<< [width, height, x, y,
+xOff, yOff] >>) or a packed string of them, with one per glyph id.
+C<$images> is the concatenation of the glyph images, each row of which is
+padded to a multiple of 4 bytes.
+
+=head3 XRenderFreeGlyphs
+
+  $display->XRenderFreeGlyphs($glyphset, \@glyph_ids);
+
+=head3 XRenderCompositeString32
+
+  $display->XRenderCompositeString32($op, $src, $dst, $mask_pfmt, $glyphset,
+    $src_x, $src_y, $dst_x, $dst_y, $glyphs);
+
+Draw a run of glyphs starting at the origin C<($dst_x, $dst_y)>.  C<$glyphs>
+is either an arrayref of glyph ids or a packed string of 32-bit ids
+(C<pack('L*', ...)>).  C<$mask_pfmt> may be undef, in which case each glyph is
+composited individually.
+
+=head3 ft_render_glyph
+
+  my ($image, $glyph_info)= X11::Xlib::ft_render_glyph($font_file, $pixel_size, $codepoint);
+
+Only available if FreeType was found when this module was built.  Rasterize one
+character of a font file into an 8-bit alpha image (rows padded to 4 bytes) and
+an L<XGlyphInfo|X11::Xlib::XGlyphInfo>, ready for L</XRenderAddGlyphs>.
+Opened fonts are kept in a small cache.
+
+=head2 EXTENSION XDAMAGE
+
+This is an optional extension.  If you have Xdamage available when this
+module was installed, then the following functions will be available.
+None of these functions are exportable.
+
+  sudo apt-get install libxdamage-dev   # Debian/Mint/Ubuntu
+  sudo yum install libXdamage-devel     # Fedora/RHEL
+
+DamageNotify events are delivered as L<X11::Xlib::XEvent/XDamageNotifyEvent>
+once the extension has been queried (which L</XDamageCreate> does for you).
+
+=head3 XDamageQueryExtension
+
+  my ($event_base, $error_base)= $display->XDamageQueryExtension()
+    if $display->can('XDamageQueryExtension');
+
+=head3 XDamageQueryVersion
+
+  my ($major, $minor)= $display->XDamageQueryVersion()
+    if $display->can('XDamageQueryVersion');
+
+=head3 XDamageCreate
+
+  my $damage= $display->XDamageCreate($drawable, $report_level);
+
+Returns a L<X11::Xlib::Damage>.  C<$report_level> is one of
+C<XDamageReportRawRectangles>, C<XDamageReportDeltaRectangles>,
+C<XDamageReportBoundingBox>, or C<XDamageReportNonEmpty>.
+
+=head3 XDamageDestroy
+
+  $display->XDamageDestroy($damage);
+
+=head3 XDamageSubtract
+
+  $display->XDamageSubtract($damage, $repair_region, $parts_region);
+
+Either region may be C<None> (0).
+
+=head3 XDamageAdd
+
+  $display->XDamageAdd($drawable, $region);
+
+=head3 damage_accumulate
+
+  my @damage_xids= X11::Xlib::damage_accumulate($display, $max_events);
+
+Drain queued DamageNotify events (up to C<$max_events>, default all) and merge
+their rectangles into a per-Damage list, in C.  Returns the XIDs which have
+pending rectangles.  See L<X11::Xlib::Display/damage_accumulate> for the
+object-returning version.
+
+=head3 damage_take_rects
+
+  my @rects= $display->damage_take_rects($damage);
+
+Return the accumulated L<X11::Xlib::XRectangle> list for a Damage, and clear it.
+
+=head2 EXTENSION XINPUT2
+
+This is an optional extension.  If you have libXi available when this
+module was installed, then the following functions will be available.
+None of these functions are exportable, but the C<:const_ext_xi2> constants
+are (and are defined either way).
+
+  sudo apt-get install libxi-dev   # Debian/Mint/Ubuntu
+  sudo yum install libXi-devel     # Fedora/RHEL
+
+=head3 XIQueryVersion
+
+  my ($major, $minor)= $display->XIQueryVersion(2, 2)
+    if $display->can('XIQueryVersion');
+
+Tell the server which version of XInput2 you speak (default 2.2), and get back
+the version it will use.  Returns an empty list if the server has no XInput2.
+Call this before any other XI function.
+
+=head3 XISelectEvents
+
+  $display->XISelectEvents($window, {
+    XIAllMasterDevices() => [ XI_RawMotion, XI_RawButtonPress ],
+  });
+
+Select XI2 events on a window, as a hashref of device ID to an arrayref of
+event types.  Raw events can only be selected on the root window.
+
+=head3 XIQueryDevice
+
+  my @devices= $display->XIQueryDevice(XIAllDevices);
+  # ( { deviceid => 2, name => 'Virtual core pointer', use => XIMasterPointer,
+  #     attachment => 3, enabled => 1, classes => [ { type => XIButtonClass,
+  #     sourceid => 2, num_buttons => 10 }, ... ] }, ... )
+
+Returns a hashref for each device.  The C<classes> hold the fields of their
+type: C<num_keycodes>; C<num_buttons>; C<number>, C<label>, C<min>, C<max>,
+C<value>, C<resolution>, C<mode> for valuators; C<number>, C<scroll_type>,
+C<increment>, C<flags> for scroll classes; or C<mode>, C<num_touches>.
+
+=head3 xi2_decode
+
+  my $record= $display->xi2_decode($xevent);
+
+Decode the device or raw XI2 event in a GenericEvent into a packed record (see
+L</xi2_records>), or return undef if it is some other event.  This fetches and
+frees the cookie data itself unless you already called L</XGetEventData>.
+
+=head3 xi2_drain
+
+  my $records= $display->xi2_drain($max_events);
+
+Take every queued XI2 device and raw event (up to C<$max_events>, default all)
+out of the event queue and decode them in C, returning one string of packed
+records.  Other events, including other XI2 events, stay in the queue in their
+original order.  This is the cheap way to follow high-rate input like raw
+motion, since no Perl object is created per event.
+
+=head3 xi2_records
+
+  my @events= X11::Xlib::xi2_records($records);
+  # ( { evtype => XI_RawMotion, deviceid => 2, sourceid => 11, detail => 0,
+  #     time => 12345, flags => 0, valuators => { 0 => 1.5, 1 => -2 },
+  #     raw_values => { 0 => 1, 1 => -1 } }, ... )
+
+Unpack records to hashrefs.  Device events have C<window>, C<event_x>,
+C<event_y>, C<root_x> and C<root_y> instead of C<raw_values>.
+
+Each record is C<pack('L8 d20')>: C<evtype>, C<deviceid>, C<sourceid>,
+C<detail>, C<time>, C<flags>, a bitmask of which valuators are present, and
+C<window>; then C<event_x>, C<event_y>, C<root_x>, C<root_y>, 8 valuator
+values, and 8 raw valuator values.  Only the first 8 valuators of a device are
+recorded, which covers the axes of ordinary pointers and tablets.
+
 =head1 STRUCTURES
 
 Xlib has a lot of C B<struct>s.  Most of them do not have much "depth"
@@ -1470,6 +2014,10 @@ can be shared among any program connected to the same display, this module
 allows a mix of simple scalar values or blessed objects when calling any
 function that expects an C<XID>.  The blessed objects derive from L<X11::Xlib::XID>.
 
+Functions that take an array of structs accept an arrayref of struct objects
+or hashrefs, a string of packed structs, or an L<X11::Xlib::StructArray>,
+which is passed to Xlib without copying.
+
 Most supported structures have their own package with further documentation,
 but here is a quick list:
 
@@ -1515,6 +2063,12 @@ An B<XID> referencing a rectangular pixel buffer.  Has dimensions and color
 depth and is bound to a L</Screen>.  Can be used for copying images, or tiling.
 When using the object-oriented C<Display>, these are wrapped by L<X11::Xlib::Pixmap>.
 
+=head2 GC
+
+An B<opaque pointer> to a graphics context, which holds the colors, line style,
+font, etc. used by drawing requests.  See L<X11::Xlib::GC>, and
+L<X11::Xlib::XGCValues> for the attributes.
+
 =head2 Window
 
 An B<XID> referencing a Window.  Used for painting, event/input delivery, and
@@ -1546,6 +2100,55 @@ If you really need your program to keep running your best bet is to state-dump
 to shared memory and then C<exec()> a fresh copy of your script and reload the
 dumped state.  Or use XCB instead of Xlib.
 
+=head2 Error Ring
+
+Every non-fatal error normally creates an XErrorEvent object and runs the
+L</on_error> callbacks, which gets expensive when errors are expected in bulk,
+such as when probing thousands of windows that might have been destroyed.
+A display with an error ring instead records each error in a fixed-size
+buffer in C, and neither the global nor the per-display C<on_error> callbacks
+are called for that display.  You then collect the errors when convenient:
+
+  $display->error_ring_enable(4096);
+  $display->XGetWindowAttributes($_, my $attrs) for @maybe_gone;
+  $display->XSync;
+  my %gone= map { $_->{resourceid} => 1 }
+    $display->error_ring_drain(error_code => BadWindow);
+
+=head3 error_ring_enable
+
+  $display->error_ring_enable($capacity // 1024);
+
+Start recording this display's errors in a ring that holds the most recent
+C<$capacity> of them (rounded up to a power of 2).  When the ring is full, the
+oldest error is overwritten.  If the ring was already enabled, its newest
+records are carried over to the new one.
+
+=head3 error_ring_disable
+
+Discard the ring and go back to delivering errors to C<on_error>.
+
+=head3 error_ring_count
+
+  my $n= $display->error_ring_count(%filter);
+
+Number of recorded errors that match the filter, which has any of the keys
+C<error_code>, C<request_code>, C<minor_code>, C<resourceid>, C<min_serial>
+and C<max_serial> (inclusive).  With no filter, this counts all of them.
+
+=head3 error_ring_drain
+
+  my @errors= $display->error_ring_drain(%filter);
+
+Remove the errors that match the filter (as for L</error_ring_count>) and
+return them oldest first, as hashrefs of C<serial>, C<error_code>,
+C<request_code>, C<minor_code> and C<resourceid>.  Errors that don't match
+stay in the ring, in order.
+
+=head3 error_ring_dropped
+
+Number of errors that were overwritten because the ring was full.
+
 =head1 SYSTEM DEPENDENCIES
 
 Xlib libraries are found on most graphical Unixes, but you might lack the header
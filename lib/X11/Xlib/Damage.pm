@@ -0,0 +1,91 @@
+package X11::Xlib::Damage;
+use strict;
+use warnings;
+use Carp;
+use parent 'X11::Xlib::XID';
+
+# All modules in dist share a version
+our $VERSION = '0.23';
+
+sub subtract {
+    my ($self, $repair, $parts)= @_;
+    $self->display->XDamageSubtract($self->xid, $repair || 0, $parts || 0);
+}
+
+sub take_rects {
+    my $self= shift;
+    $self->display->damage_take_rects($self->xid);
+}
+
+sub DESTROY {
+    my $self= shift;
+    if ($self->autofree && $self->xid) {
+        $self->display->XDamageDestroy($self->xid);
+        # discard anything accumulated but never collected
+        $self->display->damage_take_rects($self->xid);
+    }
+}
+
+1;
+
+__END__
+
+=head1 NAME
+
+X11::Xlib::Damage - XID wrapper for Damage objects of the DAMAGE extension
+
+=head1 SYNOPSIS
+
+  my $damage= $display->new_damage($window, XDamageReportRawRectangles);
+  while (1) {
+    $display->wait_event(timeout => .02) ...
+    for my $d ($display->damage_accumulate) {
+      my @rects= $d->take_rects;
+      $d->subtract;
+      # ... repaint @rects
+    }
+  }
+
+=head1 DESCRIPTION
+
+Object representing a Damage handle, which asks the server to report the areas
+of a drawable that have been modified.
+
+=head1 ATTRIBUTES
+
+See L<X11::Xlib::XID> for base-class attributes.
+
+=head1 METHODS
+
+=head2 subtract
+
+  $damage->subtract;                  # clear all damage
+  $damage->subtract($repair, $parts);
+
+Calls L<XDamageSubtract|X11::Xlib/XDamageSubtract>.  C<$repair> and C<$parts>
+are L<X11::Xlib::XserverRegion> objects (or XIDs) and default to C<None>.
+
+=head2 take_rects
+
+  my @rects= $damage->take_rects;
+
+Return the list of L<X11::Xlib::XRectangle> collected for this Damage by
+L<X11::Xlib::Display/damage_accumulate>, and reset the list.
+
+=head1 AUTHOR
+
+Olivier Thauvin, E<lt>nanardon@nanardon.zarb.orgE<gt>
+
+Michael Conrad, E<lt>mike@nrdvana.netE<gt>
+
+=head1 COPYRIGHT AND LICENSE
+
+Copyright (C) 2009-2010 by Olivier Thauvin
+
+Copyright (C) 2017-2021 by Michael Conrad
+
+This library is free software; you can redistribute it and/or modify
+it under the same terms as Perl itself, either Perl version 5.10.0 or,
+at your option, any later version of Perl 5 you may have available.
+
+=cut
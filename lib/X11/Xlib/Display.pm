@@ -12,7 +12,10 @@ require X11::Xlib::Screen;
 require X11::Xlib::Colormap;
 require X11::Xlib::Window;
 require X11::Xlib::Pixmap;
+require X11::Xlib::GC;
 require X11::Xlib::XserverRegion;
+require X11::Xlib::Damage;
+require X11::Xlib::Picture;
 
 =head1 NAME
 
@@ -85,7 +88,8 @@ sub screen {
     }
   });
 
-See L<X11::Xlib/on_error>.
+See L<X11::Xlib/on_error>.  To record errors in bulk without calling back
+into perl, see L<X11::Xlib/"Error Ring">.
 
 =head1 METHODS
 
@@ -232,6 +236,36 @@ sub flush              { shift->XFlush }
 sub flush_sync         { shift->XSync }
 sub flush_sync_discard { shift->XSync(1) }
 
+=head3 error_trap
+
+  my $trap= $display->error_trap;
+  ... # Xlib calls
+  $trap->end;
+  # or
+  my $trap= $display->error_trap(sub { ... });
+  ...
+  warn "failed" unless $trap->ok;
+
+Return a L<X11::Xlib::ErrorTrap> that collects the errors of the requests
+made between now and C<< $trap->end >> (or during the coderef, if given),
+found by request serial number instead of with an C<XSync> around the block.
+Asking for the errors is the only thing that might wait for the server, and
+one wait resolves every trap that has ended, so many blocks can share a single
+round trip.
+
+=cut
+
+sub error_trap {
+    my ($self, $code)= @_;
+    require X11::Xlib::ErrorTrap;
+    my $trap= X11::Xlib::ErrorTrap->new(display => $self);
+    if ($code) {
+        $code->($self);
+        $trap->end;
+    }
+    return $trap;
+}
+
 =head3 fake_motion
 
   $display->fake_motion($screen, $x, $y, $send_delay = 10);
@@ -252,12 +286,145 @@ Generate a fake mouse button press or release.
 
 Generate a fake key press or release.  See L<X11::Xlib::Keymap/EXAMPLES>.
 
+=head3 play_input
+
+  my $report= $display->play_input(\@actions, $samples);
+
+Play a list of fake key, button and motion events on a precise schedule.  See
+L<X11::Xlib/play_input>.
+
+=head3 fake_path
+
+  my $report= $display->fake_path(\@points, %options);
+  $display->fake_path([ [ 10, 10 ], [ 200, 10 ], [ 200, 150 ] ], duration => 400, button => 1);
+
+Move the pointer along a path in one call, with the motion events generated
+and timed in C (using L</play_input>), and return the same timing report.
+C<@points> are C<[ $x, $y ]> pairs.  The pointer first jumps to the first
+point, then moves through the rest.
+
+Options:
+
+=over
+
+=item curve
+
+C<'linear'> (default) follows straight lines from point to point at constant
+speed.  C<'bezier'> follows one Bezier curve with the points as its control
+points, so it starts and ends at the first and last point and bends toward
+the ones in between.
+
+=item ease
+
+C<'none'> (default), C<'in'>, C<'out'> or C<'in_out'>, to start slow, end slow,
+or both.
+
+=item duration
+
+Milliseconds from the first point to the last.  Default 250.
+
+=item rate
+
+Motion events per second.  Default 100.  Positions that round to the same
+pixel as the previous event are skipped.  Dies if C<duration> times C<rate>
+comes to more than a million steps.
+
+=item button
+
+Button number to press at the first point and release at the last, for drags.
+
+=item screen
+
+Screen number for the coordinates.  Default -1, the screen the pointer is on.
+
+=item relative
+
+If true, move relative to wherever the pointer already is, by the same
+offsets as the path, using relative motion events.
+
+=item samples
+
+Include each event's lateness in the report.
+
+=back
+
+=head3 type_text
+
+  my $count= $display->type_text($string, %options);
+
+Type a string of characters with fake key events, and return the number of
+characters typed.  Each character is looked up in the L</keymap>, and Shift or
+Mode_switch is pressed as needed (and held across characters that need the
+same modifiers).  A character that isn't on any key is typed by temporarily
+mapping it onto a keycode the keymap doesn't use, which is restored at the end.
+Every event is queued with its delay for the server to apply, and sent with a
+single flush, so this returns before the typing is finished.
+
+Other clients decode a key with the keymap they fetch after being told it
+changed, so a spare keycode is never remapped while its events might not have
+been read.  If the string needs more different characters than there are
+spare keycodes, and before restoring the spares at the end, this waits with
+L</XSync> and then sleeps for C<settle> milliseconds.  So a string that uses
+spare keycodes doesn't return until its events have been sent.
+
+This assumes no modifiers are held down when it starts, and croaks (before
+sending anything) if a character needs a spare keycode and none are available.
+
+Options:
+
+=over
+
+=item delay
+
+Milliseconds between characters.  Default 0.
+
+=item rate
+
+Characters per second, as an alternative to C<delay>.
+
+=item hold
+
+Milliseconds each key is held down.  Default 0.
+
+=item settle
+
+Milliseconds to give other clients to read the events typed on spare keycodes
+before remapping or restoring those keycodes.  Default 50.
+
+=item spare_keycodes
+
+Arrayref of keycodes that may be remapped for characters missing from the
+keymap.  Default is every keycode with no KeySyms that isn't a modifier.
+
+=back
+
 =cut
 
 sub fake_motion { shift->XTestFakeMotionEvent(@_) }
 sub fake_button { shift->XTestFakeButtonEvent(@_) }
 sub fake_key    { shift->XTestFakeKeyEvent(@_) }
 
+my %_path_curve= ( linear => 0, bezier => 1 );
+my %_path_ease= ( none => 0, in => 1, out => 2, in_out => 3 );
+sub fake_path {
+    my ($self, $points, %opts)= @_;
+    my $curve= $_path_curve{ $opts{curve} || 'linear' };
+    defined $curve or croak "Unknown curve '$opts{curve}'";
+    my $ease= $_path_ease{ $opts{ease} || 'none' };
+    defined $ease or croak "Unknown ease '$opts{ease}'";
+    my $actions= X11::Xlib::_pointer_path_actions($points, $curve, $ease,
+        defined $opts{duration}? $opts{duration} : 250, $opts{rate} || 100, $opts{button} || 0,
+        defined $opts{screen}? $opts{screen} : -1, $opts{relative}? 1 : 0);
+    $self->play_input($actions, $opts{samples});
+}
+
+sub type_text {
+    my ($self, $str, %opts)= @_;
+    my $delay= $opts{rate}? int(1000 / $opts{rate}) : $opts{delay} || 0;
+    X11::Xlib::Keymap::_type_text($self, $self->keymap->_server, $str,
+        $opts{spare_keycodes}, $delay, $opts{hold} || 0, defined $opts{settle}? $opts{settle} : 50);
+}
+
 =head2 ATOM
 
 =head3 atom
@@ -375,6 +542,11 @@ Search for a visual on C<$scren_num> that matches the color depth and class.
 Search for a visual by any of its L<X11::Xlib::XVisualInfo> members.
 You can specify as many or as few fields as you like.
 
+These three methods load the list of visuals once per connection and index it
+in C by visualid, by screen/depth/class, and by color masks, so repeated
+lookups don't call L<XGetVisualInfo|X11::Xlib/XGetVisualInfo> again.  Each
+call still returns new XVisualInfo objects, so they are safe to modify.
+
 =cut
 
 # Attach a pointer to self to each of the returned structs
@@ -390,16 +562,18 @@ sub visual_info {
     my $id= !defined $visual_or_id? $self->default_screen->visual->id
         : ref $visual_or_id? $visual_or_id->id
         : $visual_or_id;
-    my $tpl= X11::Xlib::XVisualInfo->new({ visualid => $id });
-    my ($match)= $self->XGetVisualInfo(X11::Xlib::VisualIDMask, $tpl);
+    my ($match)= $self->_visual_index_search(X11::Xlib::VisualIDMask, { visualid => $id }, 1);
     return $match;
 }
 
 sub match_visual_info {
     my ($self, $screen, $depth, $class)= @_;
-    my $info;
-    return $self->XMatchVisualInfo($screen, $depth, $class, $info)?
-        $info : undef;
+    $screen= $screen->screen_number if ref $screen;
+    my ($match)= $self->_visual_index_search(
+        X11::Xlib::VisualScreenMask | X11::Xlib::VisualDepthMask | X11::Xlib::VisualClassMask,
+        { screen => $screen, depth => $depth, class => $class }, 1
+    );
+    return $match;
 }
 
 sub search_visual_info {
@@ -415,7 +589,7 @@ sub search_visual_info {
         | (defined $args{blue_mask}?     X11::Xlib::VisualBlueMaskMask : 0)
         | (defined $args{colormap_size}? X11::Xlib::VisualColormapSizeMask : 0)
         | (defined $args{bits_per_rgb}?  X11::Xlib::VisualBitsPerRGBMask : 0);
-    return $self->XGetVisualInfo($flags, \%args);
+    return $self->_visual_index_search($flags, \%args);
 }
 
 =head2 RESOURCE CREATION
@@ -504,6 +678,64 @@ sub XCreatePixmapFromBitmapData {
     $_[0]->get_cached_pixmap($xid, autofree => 1);
 } if X11::Xlib->can('XCompositeNameWindowPixmap');
 
+=head3 new_gc
+
+  my $gc= $display->new_gc($drawable, foreground => $pixel, line_width => 2, ...);
+
+Create a new graphics context with L<XCreateGC|X11::Xlib/XCreateGC>, setting
+the C<valuemask> from the names of the L<XGCValues|X11::Xlib::XGCValues>
+fields you pass.  The returned L<X11::Xlib::GC> calls
+L<XFreeGC|X11::Xlib/XFreeGC> when it goes out of scope.
+
+C<$drawable> only determines the screen and depth, and may also be a
+L<Screen|X11::Xlib::Screen> object.
+
+=cut
+
+my %_gc_field_mask= (
+    function           => X11::Xlib::GCFunction,
+    plane_mask         => X11::Xlib::GCPlaneMask,
+    foreground         => X11::Xlib::GCForeground,
+    background         => X11::Xlib::GCBackground,
+    line_width         => X11::Xlib::GCLineWidth,
+    line_style         => X11::Xlib::GCLineStyle,
+    cap_style          => X11::Xlib::GCCapStyle,
+    join_style         => X11::Xlib::GCJoinStyle,
+    fill_style         => X11::Xlib::GCFillStyle,
+    fill_rule          => X11::Xlib::GCFillRule,
+    tile               => X11::Xlib::GCTile,
+    stipple            => X11::Xlib::GCStipple,
+    ts_x_origin        => X11::Xlib::GCTileStipXOrigin,
+    ts_y_origin        => X11::Xlib::GCTileStipYOrigin,
+    font               => X11::Xlib::GCFont,
+    subwindow_mode     => X11::Xlib::GCSubwindowMode,
+    graphics_exposures => X11::Xlib::GCGraphicsExposures,
+    clip_x_origin      => X11::Xlib::GCClipXOrigin,
+    clip_y_origin      => X11::Xlib::GCClipYOrigin,
+    clip_mask          => X11::Xlib::GCClipMask,
+    dash_offset        => X11::Xlib::GCDashOffset,
+    dashes             => X11::Xlib::GCDashList,
+    arc_mode           => X11::Xlib::GCArcMode,
+);
+sub new_gc {
+    my ($self, $drawable, %values)= @_;
+    $drawable ||= $self->screen->root_window;
+    $drawable= $drawable->root_window
+        if ref $drawable && $drawable->isa('X11::Xlib::Screen');
+    my $mask= 0;
+    for (keys %values) {
+        defined $_gc_field_mask{$_} or croak "Unknown GC attribute '$_'";
+        $mask |= $_gc_field_mask{$_};
+    }
+    return $self->XCreateGC($drawable, $mask, $mask? \%values : ());
+}
+
+sub XCreateGC {
+    my $gc= &X11::Xlib::XCreateGC;
+    $gc->autofree(1) if $gc;
+    $gc;
+}
+
 =head3 new_window
 
   my $win= $display->new_window(
@@ -647,6 +879,97 @@ sub XCreateSimpleWindow {
     $self->get_cached_region( $xid, autofree => 1 );
 } if X11::Xlib->can('XFixesCreateRegion');
 
+=head3 new_picture
+
+  my $pic= $display->new_picture($drawable, $format, %attributes);
+
+Create a new L<Picture|X11::Xlib/XRenderCreatePicture> for C<$drawable>,
+wrapped with a L<X11::Xlib::Picture> object which frees it when it goes out of
+scope.  C<$format> is a L<X11::Xlib::XRenderPictFormat>, and defaults to the
+format of the default visual.  The C<valuemask> is built from the names of the
+L<XRenderPictureAttributes|X11::Xlib::XRenderPictureAttributes> you pass.
+Only available if Xlib was built with the RENDER extension.
+
+=cut
+
+my %_picture_attr_mask= (
+    repeat             => X11::Xlib::CPRepeat,
+    alpha_map          => X11::Xlib::CPAlphaMap,
+    alpha_x_origin     => X11::Xlib::CPAlphaXOrigin,
+    alpha_y_origin     => X11::Xlib::CPAlphaYOrigin,
+    clip_x_origin      => X11::Xlib::CPClipXOrigin,
+    clip_y_origin      => X11::Xlib::CPClipYOrigin,
+    clip_mask          => X11::Xlib::CPClipMask,
+    graphics_exposures => X11::Xlib::CPGraphicsExposure,
+    subwindow_mode     => X11::Xlib::CPSubwindowMode,
+    poly_edge          => X11::Xlib::CPPolyEdge,
+    poly_mode          => X11::Xlib::CPPolyMode,
+    dither             => X11::Xlib::CPDither,
+    component_alpha    => X11::Xlib::CPComponentAlpha,
+);
+sub new_picture {
+    my ($self, $drawable, $format, %attrs)= @_;
+    $format ||= $self->XRenderFindVisualFormat($self->screen->visual);
+    my $mask= 0;
+    for (keys %attrs) {
+        defined $_picture_attr_mask{$_} or croak "Unknown Picture attribute '$_'";
+        $mask |= $_picture_attr_mask{$_};
+    }
+    $self->XRenderCreatePicture($drawable, $format, $mask, $mask? \%attrs : ());
+}
+
+*X11::Xlib::Display::XRenderCreatePicture= sub {
+    my $self= $_[0];
+    my $xid= &X11::Xlib::XRenderCreatePicture;
+    $self->get_cached_picture( $xid, autofree => 1 );
+} if X11::Xlib->can('XRenderCreatePicture');
+
+=head3 new_damage
+
+  my $damage= $display->new_damage($drawable, $report_level);
+
+Create a new L<Damage|X11::Xlib/XDamageCreate> on the server for C<$drawable>,
+wrapped with a L<X11::Xlib::Damage> object.  C<$report_level> defaults to
+C<XDamageReportRawRectangles>.  Only available if Xlib was built with the
+DAMAGE extension.
+
+=cut
+
+sub new_damage {
+    my ($self, $drawable, $level)= @_;
+    $self->XDamageCreate($drawable, defined $level? $level : X11::Xlib::XDamageReportRawRectangles());
+}
+
+*X11::Xlib::Display::XDamageCreate= sub {
+    my $self= $_[0];
+    my $xid= &X11::Xlib::XDamageCreate;
+    $self->get_cached_damage( $xid, autofree => 1 );
+} if X11::Xlib->can('XDamageCreate');
+
+=head2 DAMAGE
+
+=head3 damage_accumulate
+
+  my @damage= $display->damage_accumulate;
+  my @damage= $display->damage_accumulate($max_events);
+
+Remove all queued DamageNotify events from the Xlib event queue (leaving other
+events in place) and merge their areas into a short per-Damage list of
+rectangles, entirely in C.  Returns the L<X11::Xlib::Damage> objects which
+have pending rectangles; collect them with L<X11::Xlib::Damage/take_rects>.
+
+The new areas are merged with the ones already pending into one region, so
+each pixel is reported at most once, as the non-overlapping rectangles of
+L<X11::Xlib::Region>.  If that would take more than a small fixed number of
+rectangles, the bounding box of the region is reported instead.
+
+=cut
+
+*X11::Xlib::Display::damage_accumulate= sub {
+    my $self= $_[0];
+    map { $self->get_cached_damage($_) } &X11::Xlib::damage_accumulate;
+} if X11::Xlib->can('damage_accumulate');
+
 =head2 INPUT
 
 =head3 keymap
@@ -662,7 +985,9 @@ See L<X11::Xlib::Keymap> for details.
 
 The first time you access C<keymap> it fetches the tables from the server.
 The tables may change on the fly, so you should watch for MappingNotify events
-to know when to reload the keymap.
+and pass them to L<X11::Xlib::Keymap/mapping_notify>.  To load the tables
+through XKB instead, assign C<< X11::Xlib::Keymap->new(display => $display, use_xkb => 1) >>
+to this attribute, and read L<X11::Xlib::Keymap/xkb> first.
 
 Note that if you only need Latin-1 translation of key codes, you can just use
 L<X11::Xlib/XLookupString> and L<X11::Xlib/XRefreshKeyboardMapping> to have
@@ -697,6 +1022,118 @@ Each LED gets one bit of the integer, starting from the least significant.
 
 # comes from XS
 
+=head2 STATISTICS
+
+=head3 stats_enable
+
+  $display->stats_enable;
+
+Start counting the requests, flushed bytes, and round trips of this display.
+This is cheap enough to leave on: the counters are kept in C, and a call that
+waits for a reply costs two extra clock reads, which is nothing next to the
+round trip.  Displays without stats (or a program with none enabled) skip
+even those.
+
+=head3 stats_disable
+
+Stop counting and discard the counters.
+
+=head3 stats
+
+  my $stats= $display->stats;
+  my $stats= $display->stats(1); # and reset them
+
+Return a hashref of the counters since C<stats_enable> (or the last reset):
+
+  {
+    requests       => $n,     # requests sent, by serial number
+    bytes_flushed  => $bytes, # written to the socket
+    round_trips    => $n,     # calls that waited for a reply
+    wait_us        => $us,    # total time spent in those calls
+    calls          => { XGetWindowProperty => { count => $n, wait_us => $us }, ... },
+    wait_histogram => [ ... ],
+  }
+
+C<calls> only lists functions that were called, out of C<XSync>,
+C<XInternAtom>, C<XInternAtoms>, C<XGetAtomName>, C<XGetAtomNames>,
+C<XGetGeometry>, C<XListProperties>, C<XGetWindowProperty>, C<XGetWMProtocols>,
+C<XGetWMSizeHints>, C<XGetWMNormalHints>, C<XGetWindowAttributes>,
+C<XQueryTree>, C<XTranslateCoordinates>, C<XQueryKeymap>, C<XQueryPointer>,
+C<XGrabKeyboard>, C<XGrabPointer>, C<XGetKeyboardMapping>,
+C<XGetModifierMapping>, C<XkbGetMap>, C<XkbGetMapChanges>,
+C<XFixesFetchRegion>, C<XIQueryDevice> and C<XQueryExtension>.  These include
+the calls that L</atom>, L</keymap>, L</type_text> and the other helpers make
+for you.  Element C<$i> of C<wait_histogram> counts the calls
+that waited from C<2**$i> up to C<2**($i+1)> microseconds, except that the
+first element starts at 0 and the last one has no upper limit.
+
+Round trips made inside other Xlib functions or extension libraries aren't
+in C<calls>, but their requests and bytes are still counted.
+
+=head3 stats_reset
+
+Set all the counters back to zero.
+
+=cut
+
+# comes from XS
+
+=head2 TRACING
+
+=head3 trace_enable
+
+  $display->trace_enable($capacity // 65536);
+
+Record every XS function called with this display as its first argument:
+the start and end times, the request serial numbers before and after, and
+the file and line of the code that called into X11::Xlib (not counting
+frames inside X11::Xlib's own modules).  Records go into a ring of
+C<$capacity> entries (rounded up to a power of 2) kept in C, and the oldest
+are overwritten when it is full.
+
+While any display is traced, every XS function of X11::Xlib (including the
+ones in X11::Xlib::Display and X11::Xlib::Keymap) goes through a
+small wrapper that checks its first argument, so this is meant for finding
+problems rather than leaving on.  When tracing stops on the last display,
+the wrappers are removed.
+
+=head3 trace_disable
+
+Stop tracing and discard the records.
+
+=head3 trace_clear
+
+Discard the records, but keep tracing.
+
+=head3 trace_json
+
+  my $json= $display->trace_json;
+
+The records as Chrome trace-event JSON, which you can load into
+C<chrome://tracing> or L<Perfetto|https://ui.perfetto.dev>.  Each call is a
+complete event named after the function, with C<serial_begin>,
+C<serial_end> and C<caller> (C<"file:line">) in its C<args>.  Functions
+outside the C<X11::Xlib> package are named with the rest of their package,
+like C<Display::atom> or C<Keymap::_index_load>.  The C<tid> of the events
+numbers the perl interpreter (thread) that owns the display.
+
+=head3 trace_dump
+
+  $display->trace_dump("startup-trace.json");
+
+Write L</trace_json> to a file.
+
+=cut
+
+sub trace_dump {
+    my ($self, $path)= @_;
+    my $json= $self->trace_json;
+    open my $fh, '>', $path or croak "open($path): $!";
+    print $fh $json or croak "write($path): $!";
+    close $fh or croak "close($path): $!";
+    return $path;
+}
+
 =head2 CACHE MANAGEMENT
 
 The Display object keeps weak references to the wrapper objects it creates so
@@ -756,6 +1193,12 @@ Shortcut for L</get_cached_xobj> that implies a class of L<X11::Xlib::Pixmap>
 
 Shortcut for L</get_cached_xobj> that implies a class of L<X11::Xlib::Window>
 
+=head3 get_cached_picture
+
+  my $picture= $display->get_cached_picture($xid, @new_args);
+
+Shortcut for L</get_cached_xobj> that implies a class of L<X11::Xlib::Picture>
+
 =cut
 
 sub get_cached_colormap {
@@ -770,6 +1213,12 @@ sub get_cached_window {
 sub get_cached_region {
     shift->get_cached_xobj(shift, 'X11::Xlib::XserverRegion', @_);
 }
+sub get_cached_damage {
+    shift->get_cached_xobj(shift, 'X11::Xlib::Damage', @_);
+}
+sub get_cached_picture {
+    shift->get_cached_xobj(shift, 'X11::Xlib::Picture', @_);
+}
 
 1;
 
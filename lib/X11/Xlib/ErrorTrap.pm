@@ -0,0 +1,175 @@
+package X11::Xlib::ErrorTrap;
+use strict;
+use warnings;
+use Carp;
+use X11::Xlib ();
+
+# All modules in dist share a version
+our $VERSION = '0.23';
+
+sub new {
+    my $class= shift;
+    my %args= (@_ == 1 && ref $_[0] eq 'HASH')? %{$_[0]} : @_;
+    my $dpy= $args{display} or croak "display is required";
+    $dpy->error_ring_enable($args{ring_capacity} || 1024)
+        unless exists $dpy->{_error_ring};
+    return bless {
+        display      => $dpy,
+        begin_serial => X11::Xlib::NextRequest($dpy),
+        end_serial   => undef,
+        dropped      => $dpy->error_ring_dropped,
+        errors       => undef, # arrayref, once resolved
+        incomplete   => undef,
+    }, $class;
+}
+
+sub display      { $_[0]{display} }
+sub begin_serial { $_[0]{begin_serial} }
+sub end_serial   { $_[0]{end_serial} }
+
+sub end {
+    my $self= shift;
+    $self->{end_serial}= X11::Xlib::NextRequest($self->{display})
+        unless defined $self->{end_serial};
+    $self;
+}
+
+sub is_resolved {
+    my $self= shift;
+    return 1 if $self->{errors};
+    return 0 unless defined $self->{end_serial};
+    return $self->_resolve(0);
+}
+
+sub errors {
+    my $self= shift;
+    $self->end->_resolve(1) unless $self->{errors};
+    return @{ $self->{errors} };
+}
+
+sub ok { !scalar $_[0]->errors }
+
+sub incomplete {
+    my $self= shift;
+    $self->errors;
+    $self->{incomplete};
+}
+
+sub _resolve {
+    my ($self, $block)= @_;
+    my ($dpy, $begin, $end)= @{$self}{qw( display begin_serial end_serial )};
+    # With no requests in the trap there is nothing to wait for
+    return 0 if $end > $begin && !X11::Xlib::_error_trap_poll($dpy, $end - 1, $block);
+    $self->{errors}= [ $end > $begin? $dpy->error_ring_drain(min_serial => $begin, max_serial => $end - 1) : () ];
+    $self->{incomplete}= $dpy->error_ring_dropped != $self->{dropped};
+    return 1;
+}
+
+1;
+
+__END__
+
+=head1 NAME
+
+X11::Xlib::ErrorTrap - Collect the X errors caused by a block of requests
+
+=head1 SYNOPSIS
+
+  my %trap;
+  for my $wnd (@maybe_gone) {
+    $trap{$wnd}= $display->error_trap(sub { $display->XChangeProperty($wnd, ...) });
+  }
+  # At most one XSync, for all of them
+  my @gone= grep !$trap{$_}->ok, @maybe_gone;
+
+=head1 DESCRIPTION
+
+Xlib reports errors asynchronously, so the usual way to find out whether a
+block of calls failed is to call C<XSync> before and after it, which costs a
+round trip per block.  A trap instead remembers the request serial numbers
+(L<NextRequest|X11::Xlib/NextRequest>) at its beginning and end, and takes
+the errors with serials in that range out of the display's
+L<error ring|X11::Xlib/"Error Ring">.
+
+The trap is resolved once Xlib has read a reply, event or error for a
+request at or after the end of the trap
+(L<LastKnownRequestProcessed|X11::Xlib/LastKnownRequestProcessed>), because
+any error from the block would have arrived before that.  Checking
+L</is_resolved> never blocks, and only asking for L</errors> of an
+unresolved trap waits, with an C<XSync> that then resolves every trap ended
+before it.
+
+Creating a trap turns on the display's error ring, if it wasn't already, so
+from then on errors outside of traps stay in the ring instead of going to
+L<on_error|X11::Xlib/on_error>.  If traps overlap, the first one resolved
+takes the errors of the overlapping requests.
+
+=head1 CONSTRUCTOR
+
+=head2 new
+
+  my $trap= X11::Xlib::ErrorTrap->new(
+    display       => $display, # required
+    ring_capacity => 1024,     # default, if this enables the error ring
+  );
+
+Begin a trap at the next request.  Usually created by
+L<X11::Xlib::Display/error_trap>.
+
+=head1 ATTRIBUTES
+
+=head2 display
+
+=head2 begin_serial
+
+Serial of the first request in the trap.
+
+=head2 end_serial
+
+Serial of the first request after the trap, or undef until L</end>.
+
+=head1 METHODS
+
+=head2 end
+
+End the trap at the most recent request.  Returns the trap.
+
+=head2 is_resolved
+
+Read any data the server has already sent, without waiting, and return true
+if the trap's errors are known.  Always false before L</end>.
+
+=head2 errors
+
+  my @errors= $trap->errors;
+
+Return the errors of the trap, as hashrefs in the format of
+L<X11::Xlib/error_ring_drain>, waiting for the server if the trap isn't
+resolved yet.  This ends the trap if it wasn't already.
+
+=head2 ok
+
+True if the trap has no errors.  Waits like L</errors>.
+
+=head2 incomplete
+
+True if the error ring overflowed before the trap was resolved, so some of its
+errors may have been lost.  Waits like L</errors>.
+
+=head1 AUTHOR
+
+Olivier Thauvin, E<lt>nanardon@nanardon.zarb.orgE<gt>
+
+Michael Conrad, E<lt>mike@nrdvana.netE<gt>
+
+=head1 COPYRIGHT AND LICENSE
+
+Copyright (C) 2009-2010 by Olivier Thauvin
+
+Copyright (C) 2017-2021 by Michael Conrad
+
+This library is free software; you can redistribute it and/or modify
+it under the same terms as Perl itself, either Perl version 5.10.0 or,
+at your option, any later version of Perl 5 you may have available.
+
+=cut
@@ -1,7 +1,19 @@
 package X11::Xlib::GC;
+use strict;
+use warnings;
 require X11::Xlib::Opaque;
-# parent class "Opaque" and XS handle all methods.
-# No need to load this package.
+# parent class "Opaque" and XS handle everything except the lifespan.
+
+sub autofree { my $self= shift; $self->{autofree}= shift if @_; $self->{autofree} }
+
+sub DESTROY {
+    my $self= shift;
+    my $dpy= $self->display;
+    $dpy->XFreeGC($self)
+        if $self->{autofree} && $dpy && $self->pointer_int;
+}
+
+1;
 
 __END__
 
@@ -12,8 +24,9 @@ X11::Xlib::GC - Wrapper for GC* pointers
 =head1 DESCRIPTION
 
 This is an opaque structure describing a X11 Graphic Context.
-None of the GC API has been implemented yet, so this just allows you to
-pass around references to a GC such as the DefaultGC of a Screen.
+You get one either from L<X11::Xlib/DefaultGC> or from
+L<X11::Xlib::Display/new_gc> (or L<X11::Xlib/XCreateGC>), and pass it to
+the drawing functions such as L<X11::Xlib/XFillRectangles>.
 
 =head1 ATTRIBUTES
 
@@ -29,6 +42,13 @@ See L<X1::Xlib::Opaque/pointer_bytes>
 
 See L<X1::Xlib::Opaque/pointer_int>
 
+=head2 autofree
+
+Whether to call L<XFreeGC|X11::Xlib/XFreeGC> when the object goes out of
+scope.  This is set for GCs created by L<X11::Xlib::Display/new_gc>, and
+never for the shared C<DefaultGC>.  After C<XFreeGC> the pointer is cleared,
+so the GC can't be freed twice.
+
 =head1 AUTHOR
 
 Olivier Thauvin, E<lt>nanardon@nanardon.zarb.orgE<gt>
@@ -39,7 +59,7 @@ Michael Conrad, E<lt>mike@nrdvana.netE<gt>
 
 Copyright (C) 2009-2010 by Olivier Thauvin
 
-Copyright (C) 2017-2020 by Michael Conrad
+Copyright (C) 2017-2021 by Michael Conrad
 
 This library is free software; you can redistribute it and/or modify
 it under the same terms as Perl itself, either Perl version 5.10.0 or,
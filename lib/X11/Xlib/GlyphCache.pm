@@ -0,0 +1,255 @@
+package X11::Xlib::GlyphCache;
+use strict;
+use warnings;
+use Carp;
+use X11::Xlib ();
+
+# All modules in dist share a version
+our $VERSION = '0.23';
+
+sub new {
+    my $class= shift;
+    my %args= (@_ == 1 && ref $_[0] eq 'HASH')? %{$_[0]} : @_;
+    my $dpy= $args{display} or croak "display is required";
+    my $self= bless {
+        display    => $dpy,
+        max_glyphs => $args{max_glyphs} || 4096,
+        rasterizer => $args{rasterizer},
+        mask_format=> $args{mask_format},
+        by_face    => {},  # "$font\0$size" => { $codepoint => [ $glyph_id, $tick ] }
+        count      => 0,
+        tick       => 0,
+        next_id    => 1,
+        free_ids   => [],
+    }, $class;
+    $self->{rasterizer} ||= \&X11::Xlib::ft_render_glyph
+        if X11::Xlib->can('ft_render_glyph');
+    $self->{format}= $dpy->XRenderFindStandardFormat(X11::Xlib::PictStandardA8())
+        or croak "Server has no A8 picture format";
+    $self->{glyphset}= $dpy->XRenderCreateGlyphSet($self->{format});
+    return $self;
+}
+
+sub display    { $_[0]{display} }
+sub glyphset   { $_[0]{glyphset} }
+sub max_glyphs { $_[0]{max_glyphs} }
+sub count      { $_[0]{count} }
+
+sub add_glyph {
+    my ($self, $font, $size, $codepoint, $image, $info)= @_;
+    $self->_upload([ [ $font, $size, $codepoint, $image, $info ] ], ++$self->{tick});
+}
+
+sub glyph_string {
+    my ($self, $font, $size, $text)= @_;
+    my $tick= ++$self->{tick};
+    my $tbl= $self->{by_face}{"$font\0$size"} ||= {};
+    my (@ids, %miss, $ent);
+    for my $cp (unpack 'W*', $text) {
+        if ($ent= $tbl->{$cp}) {
+            $ent->[1]= $tick;
+            push @ids, $ent->[0];
+        } else {
+            push @{ $miss{$cp} }, scalar @ids;
+            push @ids, 0;
+        }
+    }
+    if (%miss) {
+        my $rasterizer= $self->{rasterizer}
+            or croak "Glyph U+".sprintf('%04X', (keys %miss)[0])." of $font $size is not cached, and no rasterizer is available";
+        $self->_upload([ map { [ $font, $size, $_, $rasterizer->($font, $size, $_) ] } keys %miss ], $tick);
+        for my $cp (keys %miss) {
+            $ids[$_]= $tbl->{$cp}[0] for @{ $miss{$cp} };
+        }
+    }
+    return pack 'L*', @ids;
+}
+
+sub draw {
+    my ($self, $dst, $src, $x, $y, $font, $size, $text, %opts)= @_;
+    my $ids= $self->glyph_string($font, $size, $text);
+    $self->{display}->XRenderCompositeString32(
+        defined $opts{op}? $opts{op} : X11::Xlib::PictOpOver(),
+        $src, $dst, $opts{mask_format} || $self->{mask_format}, $self->{glyphset},
+        $opts{src_x} || 0, $opts{src_y} || 0, $x, $y, $ids
+    );
+}
+
+sub clear {
+    my $self= shift;
+    my @ids= map { map { $_->[0] } values %$_ } values %{ $self->{by_face} };
+    $self->{display}->XRenderFreeGlyphs($self->{glyphset}, \@ids) if @ids;
+    $self->{by_face}= {};
+    $self->{count}= 0;
+    $self->{next_id}= 1;
+    $self->{free_ids}= [];
+}
+
+# Upload a batch of [ font, size, codepoint, image, info ] with one XRenderAddGlyphs,
+# first evicting the least recently used glyphs if the batch doesn't fit.
+sub _upload {
+    my ($self, $batch, $tick)= @_;
+    my $n= @$batch;
+    $self->_evict($self->{count} + $n - $self->{max_glyphs}, $tick)
+        if $self->{count} + $n > $self->{max_glyphs};
+    my (@gids, @infos, $images);
+    $images= '';
+    for (@$batch) {
+        my ($font, $size, $cp, $image, $info)= @$_;
+        $info= X11::Xlib::XGlyphInfo->new($info) if ref $info eq 'HASH';
+        my ($w, $h)= ($info->width, $info->height);
+        my $stride= ($w + 3) & ~3;
+        # accept tightly packed rows, and pad them as the server expects
+        $image= pack "(a$w x".($stride - $w).")$h", unpack "(a$w)$h", $image
+            if $stride != $w && length($image) == $w * $h;
+        length($image) == $stride * $h
+            or croak "Glyph image for U+".sprintf('%04X', $cp)." should be $h rows of $stride bytes";
+        my $id= @{ $self->{free_ids} }? pop @{ $self->{free_ids} } : $self->{next_id}++;
+        my $tbl= $self->{by_face}{"$font\0$size"} ||= {};
+        if (my $old= $tbl->{$cp}) {
+            push @{ $self->{free_ids} }, $old->[0];
+            $self->{display}->XRenderFreeGlyphs($self->{glyphset}, [ $old->[0] ]);
+            --$self->{count};
+        }
+        $tbl->{$cp}= [ $id, $tick ];
+        ++$self->{count};
+        push @gids, $id;
+        push @infos, $info;
+        $images .= $image;
+    }
+    $self->{display}->XRenderAddGlyphs($self->{glyphset}, \@gids, \@infos, $images);
+}
+
+# Free at least $need glyphs (and a quarter of the cache, so that this doesn't
+# run again on the next miss), oldest first, but never ones used by the
+# current string.
+sub _evict {
+    my ($self, $need, $tick)= @_;
+    my $quarter= int($self->{max_glyphs} / 4);
+    $need= $quarter if $need < $quarter;
+    my @ents;
+    for my $tbl (values %{ $self->{by_face} }) {
+        push @ents, map { [ $tbl, $_, @{ $tbl->{$_} } ] } grep { $tbl->{$_}[1] != $tick } keys %$tbl;
+    }
+    @ents= sort { $a->[3] <=> $b->[3] } @ents;
+    $#ents= $need - 1 if @ents > $need;
+    return unless @ents;
+    delete $_->[0]{$_->[1]} for @ents;
+    my @ids= map { $_->[2] } @ents;
+    push @{ $self->{free_ids} }, @ids;
+    $self->{count} -= @ids;
+    $self->{display}->XRenderFreeGlyphs($self->{glyphset}, \@ids);
+}
+
+sub DESTROY {
+    my $self= shift;
+    $self->{display}->XRenderFreeGlyphSet($self->{glyphset})
+        if $self->{display} && $self->{glyphset};
+}
+
+1;
+
+__END__
+
+=head1 NAME
+
+X11::Xlib::GlyphCache - Server-side cache of rendered glyphs for XRender text
+
+=head1 SYNOPSIS
+
+  my $cache= X11::Xlib::GlyphCache->new(display => $display, max_glyphs => 2048);
+  # $dst and $src are Pictures; $src is usually a 1x1 repeating solid color
+  $cache->draw($dst, $src, $x, $baseline, '/usr/share/fonts/.../DejaVuSans.ttf', 14, $label);
+
+=head1 DESCRIPTION
+
+This uploads each glyph to an XRender GlyphSet the first time it is drawn,
+and after that draws strings by sending only the 32-bit glyph ids, with a
+single L<XRenderCompositeString32|X11::Xlib/XRenderCompositeString32> per
+string.
+
+Glyphs are keyed by C<($font, $size, $codepoint)>.  The C<$font> is any string
+you like, and is passed to the rasterizer along with the size and codepoint
+when a glyph is missing.  If X11::Xlib was built with FreeType, the default
+rasterizer is L<X11::Xlib/ft_render_glyph>, and C<$font> is the path of a font
+file and C<$size> is in pixels.  Otherwise, supply your own rasterizer or add
+the bitmaps with L</add_glyph>.
+
+When the cache is full, the least recently drawn quarter of the glyphs is
+freed on the server in one request.  Glyphs of the string being drawn are
+never evicted to make room for each other.
+
+=head1 CONSTRUCTOR
+
+=head2 new
+
+  my $cache= X11::Xlib::GlyphCache->new(
+    display     => $display,      # required
+    max_glyphs  => 4096,          # default
+    rasterizer  => sub { my ($font, $size, $codepoint)= @_; ...; return ($image, $info) },
+    mask_format => $pict_format,  # default undef, see XRenderCompositeString32
+  );
+
+The rasterizer returns an 8-bit alpha image and a L<X11::Xlib::XGlyphInfo>
+(or hashref of its fields).  The image rows may be tightly packed or padded to
+a multiple of 4 bytes.
+
+=head1 ATTRIBUTES
+
+=head2 display
+
+=head2 glyphset
+
+The XID of the GlyphSet, which is freed when this object is destroyed.
+
+=head2 max_glyphs
+
+=head2 count
+
+Number of glyphs currently uploaded.
+
+=head1 METHODS
+
+=head2 add_glyph
+
+  $cache->add_glyph($font, $size, $codepoint, $image, $info);
+
+Upload a caller-supplied A8 bitmap, replacing any glyph cached for that key.
+
+=head2 glyph_string
+
+  my $packed_ids= $cache->glyph_string($font, $size, $text);
+
+Return the glyph ids of the characters of C<$text> as a packed string of
+32-bit integers, rasterizing and uploading any that are missing with a single
+L<XRenderAddGlyphs|X11::Xlib/XRenderAddGlyphs>.
+
+=head2 draw
+
+  $cache->draw($dst, $src, $x, $y, $font, $size, $text, %opts);
+
+Composite C<$text> onto Picture C<$dst> with its origin (baseline) at
+C<($x, $y)>, using the colors of Picture C<$src>.  Options are C<op>
+(default C<PictOpOver>), C<src_x>, C<src_y>, and C<mask_format>.
+
+=head2 clear
+
+Free all cached glyphs.
+
+=head1 AUTHOR
+
+Olivier Thauvin, E<lt>nanardon@nanardon.zarb.orgE<gt>
+
+Michael Conrad, E<lt>mike@nrdvana.netE<gt>
+
+=head1 COPYRIGHT AND LICENSE
+
+Copyright (C) 2009-2010 by Olivier Thauvin
+
+Copyright (C) 2017-2021 by Michael Conrad
+
+This library is free software; you can redistribute it and/or modify
+it under the same terms as Perl itself, either Perl version 5.10.0 or,
+at your option, any later version of Perl 5 you may have available.
+
+=cut
@@ -67,6 +67,14 @@ Each key's array can contain additonal vendor-specific elements.
 
 This table is stored exactly as loaded from the X11 server.
 
+Lookups (L</find_keycode>, L</find_keysym>, L</find_key>) don't use this
+arrayref directly; they use a compact C copy of the keymap and modifier map
+with a reverse index from KeySym to key code.  The copy is rebuilt whenever
+you assign a new L</keymap> or L</modmap>, or call one of the methods below
+that change them, but not if you modify the arrays in place.  After editing
+them in place, assign them back (C<< $keymap->keymap($keymap->keymap) >>)
+to refresh the index.
+
 =head2 rkeymap
 
 A hashref mapping from the symbolic name of a key to its scan code.
@@ -75,8 +83,8 @@ A hashref mapping from the symbolic name of a key to its scan code.
 
 sub keymap {
     my $self= shift;
-    if (@_) { $self->{keymap}= shift; delete $self->{rkeymap}; }
-    $self->{keymap} ||= defined wantarray? $self->display->load_keymap : undef;
+    if (@_) { $self->{keymap}= shift; delete @{$self}{qw( rkeymap modmap_ident _index )}; }
+    $self->{keymap} ||= defined wantarray? _index_keymap($self->{_index} || $self->_server) : undef;
 }
 
 sub rkeymap {
@@ -119,8 +127,59 @@ setups, but I've not tested/confirmed this.
 
 sub modmap {
     my $self= shift;
-    if (@_) { $self->{modmap}= shift; delete $self->{modmap_ident}; }
-    $self->{modmap} ||= defined wantarray? $self->display->XGetModifierMapping : undef;
+    if (@_) { $self->{modmap}= shift; delete @{$self}{qw( modmap_ident _index )}; }
+    $self->{modmap} ||= defined wantarray? _index_modmap($self->{_index} || $self->_server) : undef;
+}
+
+# The C lookup tables.  When nothing has been loaded yet, they come straight
+# from the server without building the Perl arrays at all.
+sub _index {
+    my $self= shift;
+    $self->{_index} ||= ($self->{keymap} || $self->{modmap})
+        ? _index_from_tables($self->keymap, $self->modmap)
+        : $self->_server;
+}
+
+# Same tables, for what the server has as of the last load or save
+sub _server {
+    my $self= shift;
+    $self->{_server} ||= do {
+        my ($idx, $event_base)= $self->{use_xkb}? _index_load_xkb($self->display) : ();
+        $self->{xkb}= defined $idx? 1 : 0;
+        $self->{_xkb_event_base}= $event_base;
+        defined $idx? $idx : _index_load($self->display);
+    };
+}
+
+=head2 xkb
+
+True if the tables were loaded through the XKB extension.  This only happens
+if you pass C<< use_xkb => 1 >> to L</new> and the server has XKB; otherwise
+the tables are loaded with core protocol requests.  Accessing this attribute
+loads the tables.
+
+With XKB, the key code, KeySym and modifier tables come from one
+C<XkbGetMap> request instead of three core requests, and lookups follow the
+key types of the server, so keys with more than one group (multi-layout
+keyboards) or with levels on modifiers other than Shift and Mode_switch (like
+AltGr) resolve the same way Xlib's own XKB lookups do.  The L</keymap> array
+keeps the core layout: C<[ $group1_level1, $group1_level2, $group2_level1,
+$group2_level2, @group1_more_levels, @group2_more_levels, @group3, @group4 ]>.
+
+Loading through XKB also selects C<XkbMapNotify> events for the keyboard.
+This affects the whole connection, not just this object: from then on Xlib
+delivers C<XkbMapNotify> in place of the core C<MappingNotify> events for
+keymap changes, so any other code on the same L<Display|X11::Xlib::Display>
+that waits for C<MappingNotify> stops seeing them.  Pass the events to
+L</mapping_notify>, and to L<XRefreshKeyboardMapping|X11::Xlib/XRefreshKeyboardMapping>
+if you use Xlib's own lookups.  This is why XKB is not the default.
+
+=cut
+
+sub xkb {
+    my $self= shift;
+    $self->_server if $self->display;
+    $self->{xkb};
 }
 
 sub modmap_ident {
@@ -162,7 +221,8 @@ sub modmap_ident {
 
 Initialize a keymap with the list of parameters.  L</display> is required
 for any load/save operations.  You can use most of the class with just the
-L</keymap> and L</modmap> attributes.
+L</keymap> and L</modmap> attributes.  Set C<use_xkb> to 1 to load the tables
+through the XKB extension (see L</xkb> for what that changes).
 
 =cut
 
@@ -182,8 +242,24 @@ sub new {
 Return a keycode for the parameter, which is either a KeySym name
 (L<XStringToKeysym|X11::Xlib/XStringToKeysym>) or a string holding a unicode character
 (L<char_to_keysym|X11::Xlib/char_to_keysym>).  If more than one key code can map to
-the KeySym, this returns an arbitrary one of them.  Returns undef if
-no matches were found.
+the KeySym, this returns the lowest one.  A character also matches a key whose
+KeySym is a different code for the same character (for instance the Latin-2
+C<Ccircumflex> KeySym and Unicode KeySym C<U0108>).  Returns undef if no
+matches were found.
+
+=head2 find_key
+
+  my ($keycode, $modifiers, $level)= $keymap->find_key( $key_sym_or_char );
+
+Like L</find_keycode>, but also return the modifier bits needed to produce
+the KeySym from that key (Shift, and the Mode_switch modifier for levels 2 and
+3) and the index of the KeySym within the key's row of the L</keymap>.
+C<$modifiers> is undef if the KeySym is in a vendor-specific slot, or needs
+Mode_switch and no modifier has that key.  Returns an empty list if not found.
+
+For a keymap loaded through L</xkb>, C<$modifiers> is the state the key type
+of the server maps to that level, with the keyboard group in bits 13-14
+(as in the C<state> of a key event).
 
 =head2 find_keysym
 
@@ -194,29 +270,30 @@ Returns the symbolic name of a key, given its scan code and current modifier bit
 
 For convenience, you can pass an L<XKeyEvent|X11::Xlib::XEvent/XKeyEvent> object.
 
-If you don't have modifier bits, pass 0.
+If you don't have modifier bits, pass 0.  With Caps Lock in effect, the
+result is the upper-case form of the KeySym, as from C<XConvertCase>.
+
+For a keymap loaded through L</xkb>, the group in bits 13-14 of the state
+selects the layout, and the key type of the key picks the level, like
+C<XkbTranslateKeyCode>.  Keys changed locally (by assigning L</keymap>) use
+the core rules until they are saved and reloaded.
+
+=head2 xkb_keysym
+
+  my $sym_name= $keymap->xkb_keysym( $key_code, $group, $level );
+
+Return the KeySym at a group and level of a key (both counting from 0), like
+C<XkbKeycodeToKeysym>, or undef.  Without XKB data for the key, groups 0 and 1
+with levels 0 and 1 come from the core layout.
 
 =cut
 
 sub find_keycode {
-    my ($self, $sym)= @_;
-    my $code= $self->rkeymap->{$sym};
-    return $code if defined $code;
-    # If length==1, assume it is a character and then try the name and symbol value
-    if (length $sym == 1) {
-        my $sym_val= X11::Xlib::char_to_keysym($sym);
-        my $sym_name= X11::Xlib::XKeysymToString($sym_val);
-        $code= $self->rkeymap->{$sym_name} if $sym_val && defined $sym_name;
-        $code= $self->rkeymap->{$sym_val} if $sym_val && !defined $code;
-    }
-    # Else assume it is a symbol name and try to find the symbol character
-    else {
-        my $sym_val= X11::Xlib::XStringToKeysym($sym);
-        my $sym_char= X11::Xlib::keysym_to_char($sym_val);
-        $code= $self->rkeymap->{$sym_char} if $sym_val && defined $sym_char;
-        $code= $self->rkeymap->{$sym_val} if $sym_val && !defined $code;
-    }
-    return $code;
+    return scalar _find_key($_[0]{_index} || $_[0]->_index, $_[1]);
+}
+
+sub find_key {
+    return _find_key($_[0]{_index} || $_[0]->_index, $_[1]);
 }
 
 sub find_keysym {
@@ -225,29 +302,12 @@ sub find_keysym {
         @_ == 1 && ref($_[0]) && ref($_[0])->can('pack')? ( $_[0]->keycode, $_[0]->state )
         : @_ == 2? @_
         : croak "Expected XKeyEvent or (code,modifiers)";
-    my $km= $self->keymap->[$keycode]
-        or return undef;
-    # Shortcut
-    return $km->[0] unless $modifiers;
-    
-    my $mod_id=    $self->modmap_ident;
-    my $shift=     $modifiers & 1;
-    my $capslock=  $mod_id->{capslock}  && ($modifiers & (1 << $mod_id->{capslock}));
-    my $shiftlock= $mod_id->{shiftlock} && ($modifiers & (1 << $mod_id->{shiftlock}));
-    my $numlock=   $mod_id->{numlock}   && ($modifiers & (1 << $mod_id->{numlock}));
-    my $mode=      ($mod_id->{mode} && ($modifiers & (1 << $mod_id->{mode})))? 2 : 0;
-    # If numlock and Num keypad KeySym...
-    if ($numlock && ($km->[1] =~ /^KP_/)) {
-        return (($shift || $shiftlock)? $km->[$mode+0] : $km->[$mode+1]);
-    } elsif (!$shift && !$capslock && !$shiftlock) {
-        return $km->[$mode];
-    } elsif (!$shift && $capslock) {
-        return uc($km->[$mode]);
-    } elsif ($shift && $capslock) {
-        return uc($km->[$mode+1]);
-    } else { # if ($shift || $shiftlock)
-        return $km->[$mode+1];
-    }
+    return _find_keysym($self->{_index} || $self->_index, $keycode, $modifiers || 0);
+}
+
+sub xkb_keysym {
+    my ($self, $keycode, $group, $level)= @_;
+    return _xkb_keysym($self->{_index} || $self->_index, $keycode, $group || 0, $level || 0);
 }
 
 =head2 keymap_reload
@@ -261,6 +321,37 @@ If C<@codes> are given, then only load from C<min(@codes)> to C<max(@codes)>.
  less than the cost of multiple round trips to the server to pick only
  the specific codes)
 
+Only the reloaded keys are replaced in the lookup index and, if it has been
+loaded, in the L</keymap> array.  If neither has been loaded yet, this does
+nothing, since they will be current whenever they are first used.
+
+=head2 modmap_reload
+
+  $keymap->modmap_reload();
+
+Reload the modifier map from the server, if it has been loaded.
+
+=head2 mapping_notify
+
+  $keymap->mapping_notify($event);
+
+Bring the keymap up to date after a
+L<MappingNotify|X11::Xlib::XEvent/XMappingEvent> event.  For a
+C<MappingKeyboard> change this reloads only the keys from C<first_keycode>
+through C<first_keycode + count - 1>, and for C<MappingModifier> only the
+modifier map.  C<MappingPointer> changes are ignored.
+
+For a keymap loaded through L</xkb>, also pass the C<XkbMapNotify> events
+(any event is fine; others are ignored).  The changed KeySyms and modifier map
+keys are fetched in one request, or the whole keymap if a key type changed.
+Reloading the whole keymap keeps the unsaved changes you made to L</keymap>
+or L</modmap>: those keys (and the modifier map, if you changed it) stay as
+you left them, and the rest come from the server.
+
+You probably also want to pass the event to
+L<XRefreshKeyboardMapping|X11::Xlib/XRefreshKeyboardMapping> so that Xlib's
+own functions like L<XLookupString|X11::Xlib/XLookupString> see the change.
+
 =head2 keymap_save
 
   $keymap->keymap_save(@codes);    # Save changes to keymap (not modmap)
@@ -268,6 +359,11 @@ If C<@codes> are given, then only load from C<min(@codes)> to C<max(@codes)>.
 Save any changes to L</keymap> back to the server.
 If C<@codes> are given, then only save from C<min(@codes)> to C<max(@codes)>.
 
+Only keys that differ from what was last loaded from (or saved to) the server
+are sent, as a few contiguous ranges.  Each range sent makes every client on
+the server reload it, so nearby changes are sent together as one range.
+Returns the number of ranges sent.
+
 See L</save> to save both the L</keymap> and L</modmap>.
 
 =cut
@@ -276,17 +372,103 @@ sub keymap_reload {
     my ($self, @codes)= @_;
     my ($min, $max)= @codes? ($codes[0], $codes[0]) : (0,255);
     for (@codes) { $min= $_ if $_ < $min; $max= $_ if $_ > $max; }
-    my $km= $self->display->load_keymap(2, $min, $max);
-    splice(@{$self->keymap}, $min, $max-$min+1, @$km);
-    $self->keymap;
+    delete $self->{rkeymap};
+    # Patch the C tables in place, and the Perl array only if it was loaded
+    my @idx= grep defined, @{$self}{qw( _server _index )};
+    if (@idx) {
+        $self->{xkb}? _index_reload_xkb($self->display, 0, $min, $max, 1, 0, @idx)
+            : _index_reload($self->display, $min, $max, @idx);
+        splice(@{$self->{keymap}}, $min, $max-$min+1, @{ _index_keymap($idx[0], 2, $min, $max) })
+            if $self->{keymap};
+    }
+    elsif ($self->{keymap}) {
+        splice(@{$self->{keymap}}, $min, $max-$min+1, @{ $self->display->load_keymap(2, $min, $max) });
+    }
+    $self->{keymap};
+}
+
+sub modmap_reload {
+    my $self= shift;
+    delete $self->{modmap_ident};
+    my @idx= grep defined, @{$self}{qw( _server _index )};
+    if (@idx) {
+        $self->{xkb}? _index_reload_xkb($self->display, 0, 1, 0, 0, 255, @idx)
+            : _index_reload_modmap($self->display, @idx);
+        $self->{modmap}= _index_modmap($idx[0]) if $self->{modmap};
+    }
+    elsif ($self->{modmap}) {
+        $self->{modmap}= $self->display->XGetModifierMapping;
+    }
+    $self->{modmap};
+}
+
+sub mapping_notify {
+    my ($self, $event)= @_;
+    if ($self->{xkb} && $event->type == $self->{_xkb_event_base}) {
+        my ($types, $first, $last, $first_mod, $last_mod)= _xkb_map_notify($event, $self->{_xkb_event_base})
+            or return;
+        delete @{$self}{qw( rkeymap modmap_ident )};
+        if ($types) { $self->_xkb_reload_all; return; }
+        my @idx= grep defined, @{$self}{qw( _server _index )};
+        _index_reload_xkb($self->display, $types, $first, $last, $first_mod, $last_mod, @idx);
+        splice(@{$self->{keymap}}, $first, $last-$first+1, @{ _index_keymap($idx[0], 2, $first, $last) })
+            if $self->{keymap} && $first <= $last;
+        $self->{modmap}= _index_modmap($idx[0])
+            if $self->{modmap} && $first_mod <= $last_mod;
+        return;
+    }
+    return unless $event->type == X11::Xlib::MappingNotify();
+    my $request= $event->request;
+    if ($request == X11::Xlib::MappingKeyboard()) {
+        $self->keymap_reload($event->first_keycode, $event->first_keycode + $event->count - 1)
+            if $event->count > 0;
+    }
+    elsif ($request == X11::Xlib::MappingModifier()) {
+        $self->modmap_reload;
+    }
+}
+
+# After a key type change, reload everything from the server, but keep the
+# keys and modifier map that were changed locally and not saved yet.
+sub _xkb_reload_all {
+    my $self= shift;
+    my $old= $self->{_server} or return;
+    # in-place edits of the arrays only show up after re-indexing them
+    my $local= ($self->{keymap} || $self->{modmap})
+        ? _index_from_tables($self->keymap, $self->modmap)
+        : $self->{_index};
+    _index_reload_xkb($self->display, 1, 1, 0, 1, 0, $self->{_server});
+    return unless defined $local;
+    $self->{_index}= _index_merge($local, $old, $self->{_server});
+    $self->{keymap}= _index_keymap($self->{_index}) if $self->{keymap};
+    $self->{modmap}= _index_modmap($self->{_index}) if $self->{modmap};
+}
+
+# Copy of index $new with the keys (and modifier map) where $local differs
+# from $old put back on top.  The keys put back use the core rules.
+sub _index_merge {
+    my ($local, $old, $new)= @_;
+    my $merged= $new;
+    _index_update($merged, $_->[0], _index_keymap($local, 2, @$_))
+        for _index_diff($local, $old, 0, 255, 0);
+    my $mm_local= _index_modmap($local);
+    my $mm_str= sub { join ';', map { join ',', sort { $a <=> $b } grep $_, @$_ } @{$_[0]} };
+    _index_set_modmap($merged, $mm_local)
+        if $mm_str->($mm_local) ne $mm_str->(_index_modmap($old));
+    return $merged;
 }
 
 sub keymap_save {
     my ($self, @codes)= @_;
-    my $km= $self->keymap;
-    my ($min, $max)= @codes? ($codes[0], $codes[0]) : (0, $#$km);
+    # If the keymap array was never loaded, it can't have been changed
+    return 0 unless $self->{keymap};
+    my ($min, $max)= @codes? ($codes[0], $codes[0]) : (0, 255);
     for (@codes) { $min= $_ if $_ < $min; $max= $_ if $_ > $max; }
-    $self->display->save_keymap($km, $min, $max);
+    # Re-index in case the array was edited in place, then diff against the server
+    my $server= $self->_server;
+    $self->{_index}= _index_from_tables($self->{keymap}, $self->modmap);
+    delete $self->{rkeymap};
+    _index_save($self->display, $self->{_index}, $server, $min, $max);
 }
 
 =head2 modmap_sym_list
@@ -342,15 +524,15 @@ sub modmap_add_codes {
     @$modcodes= grep { !$seen{$_}++ } @$modcodes;
     my $n= @$modcodes;
     push @$modcodes, grep { !$seen{$_}++ } @codes;
+    delete $self->{_index};
     return @$modcodes - $n;
 }
 
 sub modmap_add_syms {
     my ($self, $modifier, @names)= @_;
-    my $rkeymap= $self->rkeymap;
     my (@codes, @notfound);
     for (@names) {
-        my $c= $rkeymap->{$_};
+        my $c= $self->find_keycode($_);
         defined $c? push(@codes, $c) : push(@notfound, $_);
     }
     croak "Key codes not found: ".join(' ', @notfound)
@@ -400,15 +582,15 @@ sub modmap_del_codes {
             $count += $n - @$_;
         }
     }
+    delete $self->{_index};
     return $count;
 }
 
 sub modmap_del_syms {
     my ($self, $modifier, @names)= @_;
-    my $rkeymap= $self->rkeymap;
     my (@codes, @notfound);
     for (@names) {
-        my $c= $rkeymap->{$_};
+        my $c= $self->find_keycode($_);
         defined $c? push(@codes, $c) : push(@notfound, $_);
     }
     carp "Key codes not found: ".join(' ', @notfound)
@@ -420,7 +602,9 @@ sub modmap_del_syms {
 
   $keymap->modmap_save;
 
-Call L<X11::Xlib/XSetModifierMapping> for the current L</modmap>.
+Call L<X11::Xlib/XSetModifierMapping> for the current L</modmap>, unless it
+has the same keys in each modifier as the server already has, in which case
+nothing is sent and this returns C<MappingSuccess>.
 
 =head2 save
 
@@ -432,8 +616,16 @@ Save the full L</keymap> and L</modmap>.
 
 sub modmap_save {
     my ($self, $new_modmap)= @_;
-    $self->{modmap}= $new_modmap if defined $new_modmap;
-    $self->display->XSetModifierMapping($self->modmap);
+    $self->modmap($new_modmap) if defined $new_modmap;
+    my $modmap= $self->modmap;
+    # Every client gets a MappingNotify for a new modmap, so don't send an unchanged one
+    my $canonical= sub { join ';', map { join ',', sort { $a <=> $b } grep $_, @$_ } @{$_[0]} };
+    return X11::Xlib::MappingSuccess()
+        if $canonical->($modmap) eq $canonical->(_index_modmap($self->_server));
+    my $ret= $self->display->XSetModifierMapping($modmap);
+    _index_set_modmap($self->{_server}, $modmap)
+        if $ret == X11::Xlib::MappingSuccess();
+    return $ret;
 }
 
 sub save {
@@ -459,6 +651,14 @@ You might bang out a quick perl one-liner like this:
      while (1) { $d->fake_key($r, 1); $d->fake_key($r, 0);
       $d->flush; sleep 1; }'
 
+=head2 Type Text
+
+To type a whole string, let L<X11::Xlib::Display/type_text> do the lookups,
+so each character gets its modifiers (and a temporary key, if the keymap has
+none for it):
+
+  $display->type_text("Hello, W\x{f6}rld!\n", rate => 20);
+
 =head1 AUTHOR
 
 Olivier Thauvin, E<lt>nanardon@nanardon.zarb.orgE<gt>
@@ -0,0 +1,105 @@
+package X11::Xlib::Picture;
+use strict;
+use warnings;
+use Carp;
+use parent 'X11::Xlib::XID';
+
+# All modules in dist share a version
+our $VERSION = '0.23';
+
+sub composite {
+    my ($self, $op, $src, $mask, $src_x, $src_y, $mask_x, $mask_y, $dst_x, $dst_y, $w, $h)= @_;
+    $self->display->XRenderComposite($op, $src, $mask || 0, $self->xid,
+        $src_x, $src_y, $mask_x, $mask_y, $dst_x, $dst_y, $w, $h);
+}
+
+sub fill_rects {
+    my ($self, $op, $color, $rects)= @_;
+    $self->display->XRenderFillRectangles($op, $self->xid, $color, $rects);
+}
+
+sub set_transform {
+    my ($self, $matrix)= @_;
+    $self->display->XRenderSetPictureTransform($self->xid, $matrix);
+}
+
+sub set_filter {
+    my ($self, $filter, $params)= @_;
+    $self->display->XRenderSetPictureFilter($self->xid, $filter, $params || []);
+}
+
+sub DESTROY {
+    my $self= shift;
+    $self->display->XRenderFreePicture($self->xid)
+        if $self->autofree && $self->xid;
+}
+
+1;
+
+__END__
+
+=head1 NAME
+
+X11::Xlib::Picture - XID wrapper for Picture objects of the RENDER extension
+
+=head1 SYNOPSIS
+
+  my $fmt= $display->XRenderFindStandardFormat(PictStandardARGB32);
+  my $pic= $display->new_picture($pixmap, $fmt);
+  $pic->fill_rects(PictOpOver, { red => 0x8000, alpha => 0x8000 }, \@rects);
+  $win_pic->composite(PictOpOver, $pic, None, 0,0, 0,0, $x,$y, $w,$h);
+
+=head1 DESCRIPTION
+
+Object representing a Picture, which is a drawable combined with a pixel format
+so that the server can blend and scale it.
+
+=head1 ATTRIBUTES
+
+See L<X11::Xlib::XID> for base-class attributes.
+
+=head1 METHODS
+
+=head2 composite
+
+  $dst->composite($op, $src, $mask, $src_x, $src_y, $mask_x, $mask_y,
+                  $dst_x, $dst_y, $width, $height);
+
+Calls L<XRenderComposite|X11::Xlib/XRenderComposite> with this picture as the
+destination.  C<$mask> may be C<None>.
+
+=head2 fill_rects
+
+  $pic->fill_rects($op, $color, $rects);
+
+Calls L<XRenderFillRectangles|X11::Xlib/XRenderFillRectangles>.
+
+=head2 set_transform
+
+  $pic->set_transform([ [ $sx, 0, 0 ], [ 0, $sy, 0 ], [ 0, 0, 1 ] ]);
+
+Calls L<XRenderSetPictureTransform|X11::Xlib/XRenderSetPictureTransform>.
+
+=head2 set_filter
+
+  $pic->set_filter('bilinear');
+
+Calls L<XRenderSetPictureFilter|X11::Xlib/XRenderSetPictureFilter>.
+
+=head1 AUTHOR
+
+Olivier Thauvin, E<lt>nanardon@nanardon.zarb.orgE<gt>
+
+Michael Conrad, E<lt>mike@nrdvana.netE<gt>
+
+=head1 COPYRIGHT AND LICENSE
+
+Copyright (C) 2009-2010 by Olivier Thauvin
+
+Copyright (C) 2017-2021 by Michael Conrad
+
+This library is free software; you can redistribute it and/or modify
+it under the same terms as Perl itself, either Perl version 5.10.0 or,
+at your option, any later version of Perl 5 you may have available.
+
+=cut
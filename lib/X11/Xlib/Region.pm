@@ -0,0 +1,166 @@
+package X11::Xlib::Region;
+use strict;
+use warnings;
+use Carp;
+use X11::Xlib ();
+
+# All modules in dist share a version
+our $VERSION = '0.23';
+
+sub new {
+    my $class= shift;
+    $class->_from_rects(\@_);
+}
+
+sub new_from_packed {
+    my ($class, $packed)= @_;
+    $class->_from_rects($packed);
+}
+
+sub to_server {
+    my ($self, $display)= @_;
+    $display->XFixesCreateRegion($self);
+}
+
+1;
+
+__END__
+
+=head1 NAME
+
+X11::Xlib::Region - Client-side region arithmetic on rectangle lists
+
+=head1 SYNOPSIS
+
+  my $dirty= X11::Xlib::Region->new([ 0, 0, 100, 20 ], { x => 50, y => 10, width => 80, height => 80 });
+  $dirty= $dirty->union(\@more_rects)->subtract($opaque_overlay);
+  if ($dirty->contains_point($x, $y)) { ... }
+  my $xserver_region= $dirty->to_server($display);
+  ...
+  my $clip= X11::Xlib::Region->from_server($display, $xserver_region);
+
+=head1 DESCRIPTION
+
+A Region is an area made of rectangles, stored in the same "y-x banded" form
+the X server uses: non-overlapping boxes sorted top to bottom then left to
+right, with each horizontal band holding boxes of identical height.  All the
+operations are done in C on that representation without contacting the
+server, and every area has exactly one banded form, so regions can be
+compared for equality directly.
+
+Coordinates are 32-bit internally, so intermediate results may extend beyond
+the 16-bit limits of the X protocol.  They are clamped when converted back to
+L<X11::Xlib::XRectangle>.
+
+Regions are immutable; every operation returns a new Region.  Any method that
+takes another region also accepts anything that L</new> would.
+
+=head1 CONSTRUCTORS
+
+=head2 new
+
+  my $region= X11::Xlib::Region->new(@rects);
+
+Build the union of any number of (possibly overlapping) rectangles, each of
+which is an L<X11::Xlib::XRectangle>, a hashref of its fields, or an arrayref
+of C<[ $x, $y, $width, $height ]>.  Empty rectangles are ignored.
+
+=head2 new_from_packed
+
+  my $region= X11::Xlib::Region->new_from_packed($packed_xrectangles);
+
+Like L</new>, but from a string of packed XRectangle structs, such as the
+output of L</packed_rects>.
+
+=head2 from_server
+
+  my $region= X11::Xlib::Region->from_server($display, $xserver_region);
+
+Download an Xfixes L<XserverRegion|X11::Xlib::XserverRegion> with a single
+L<XFixesFetchRegion|X11::Xlib/XFixesFetchRegion>.  Only available if Xlib was
+built with the Xfixes extension.
+
+=head1 METHODS
+
+=head2 union
+
+=head2 intersect
+
+=head2 subtract
+
+  my $r3= $r1->union($r2);
+  my $r3= $r1->intersect([ [ 0, 0, 10, 10 ] ]);
+  my $r3= $r1->subtract($r2);
+
+=head2 translate
+
+  my $moved= $region->translate($dx, $dy);
+
+Coordinates stop at the limits of a 32-bit integer instead of wrapping around,
+so boxes moved past the limit get squashed against it (or vanish).
+
+=head2 bbox
+
+  my $rect= $region->bbox;
+
+The smallest L<X11::Xlib::XRectangle> containing the region, or an empty list
+if the region is empty.
+
+=head2 contains_point
+
+  if ($region->contains_point($x, $y)) { ... }
+
+=head2 count
+
+Number of rectangles in the banded form.
+
+=head2 is_empty
+
+=head2 equal
+
+  if ($r1->equal($r2)) { ... }
+
+True if both regions cover exactly the same pixels.
+
+=head2 rects
+
+  my @xrectangles= $region->rects;
+
+=head2 packed_rects
+
+  my $bytes= $region->packed_rects;
+
+The rectangles as a string of packed XRectangle structs, which can be passed
+to any function that takes an array of XRectangle.
+
+=head2 boxes
+
+  my $arrayref= $region->boxes;  # [ [ $x1, $y1, $x2, $y2 ], ... ]
+
+The internal 32-bit boxes, with exclusive C<$x2>, C<$y2>.
+
+=head2 to_server
+
+  my $xserver_region= $region->to_server($display);
+
+Upload the region with a single L<XFixesCreateRegion|X11::Xlib/XFixesCreateRegion>.
+On a L<X11::Xlib::Display> this returns an L<X11::Xlib::XserverRegion> which
+is destroyed when it goes out of scope.
+
+=head1 AUTHOR
+
+Olivier Thauvin, E<lt>nanardon@nanardon.zarb.orgE<gt>
+
+Michael Conrad, E<lt>mike@nrdvana.netE<gt>
+
+=head1 COPYRIGHT AND LICENSE
+
+Copyright (C) 2009-2010 by Olivier Thauvin
+
+Copyright (C) 2017-2021 by Michael Conrad
+
+This library is free software; you can redistribute it and/or modify
+it under the same terms as Perl itself, either Perl version 5.10.0 or,
+at your option, any later version of Perl 5 you may have available.
+
+=cut
@@ -57,6 +57,20 @@ sub new {
     $self;
 }
 
+=head2 new_array
+
+  my $array= X11::Xlib::....->new_array( @elements );
+
+Create an L<X11::Xlib::StructArray> of this struct type.
+
+=cut
+
+sub new_array {
+    my $class= shift;
+    require X11::Xlib::StructArray;
+    X11::Xlib::StructArray->new($class, @_);
+}
+
 =head2 initialize
 
 Set all struct fields to a sensible initial value (like zero)
@@ -155,6 +169,14 @@ $X11::Xlib::XSizeHints::VERSION= $VERSION;
 $X11::Xlib::XRectangle::VERSION= $VERSION;
 @X11::Xlib::XRenderPictFormat::ISA= ( __PACKAGE__ );
 $X11::Xlib::XRenderPictFormat::VERSION= $VERSION;
+@X11::Xlib::XGCValues::ISA= ( __PACKAGE__ );
+$X11::Xlib::XGCValues::VERSION= $VERSION;
+@X11::Xlib::XRenderPictureAttributes::ISA= ( __PACKAGE__ );
+$X11::Xlib::XRenderPictureAttributes::VERSION= $VERSION;
+@X11::Xlib::XRenderColor::ISA= ( __PACKAGE__ );
+$X11::Xlib::XRenderColor::VERSION= $VERSION;
+@X11::Xlib::XGlyphInfo::ISA= ( __PACKAGE__ );
+$X11::Xlib::XGlyphInfo::VERSION= $VERSION;
 
 1;
 
@@ -0,0 +1,185 @@
+package X11::Xlib::StructArray;
+use strict;
+use warnings;
+use Carp;
+use X11::Xlib ();
+
+# All modules in dist share a version
+our $VERSION = '0.23';
+
+sub new {
+    my ($class, $type)= (shift, shift);
+    defined $type or croak "Struct type is required";
+    $type= ref $type if ref $type;
+    # events are blessed into subclasses by type, but all share one struct
+    $type= 'X11::Xlib::XEvent' if $type->isa('X11::Xlib::XEvent');
+    my $self= $class->_new($type);
+    $self->reserve(scalar @_);
+    $self->push(@_) if @_;
+    return $self;
+}
+
+sub new_from_packed {
+    my ($class, $type, $packed)= @_;
+    my $self= $class->new($type);
+    length($packed) % $self->elem_size == 0
+        or croak "Length of packed data is not a multiple of ".$self->elem_size;
+    $self->reserve(length($packed) / $self->elem_size);
+    $self->push(map { \$_ } unpack '(a'.$self->elem_size.')*', $packed);
+    return $self;
+}
+
+sub elems {
+    my $self= shift;
+    map { $self->elem($_) } 0 .. $self->count - 1;
+}
+
+sub bytes { ${$_[0]} }
+
+1;
+
+__END__
+
+=head1 NAME
+
+X11::Xlib::StructArray - Contiguous array of Xlib structs
+
+=head1 SYNOPSIS
+
+  my $rects= X11::Xlib::XRectangle->new_array([ 0, 0, 10, 10 ], { x => 20, width => 5, height => 5 });
+  $rects->push($another_xrectangle);
+  $rects->elem(0)->width(100);    # modifies the array in place
+  $display->XFillRectangles($window, $gc, $rects);   # no per-element copying
+
+=head1 DESCRIPTION
+
+A StructArray holds any number of one type of struct back to back in a single
+buffer, the same as a C array.  XS functions that take an array of structs
+(C<T*> and a count) use that buffer directly, instead of building one from an
+arrayref of individual struct objects.
+
+Like the structs themselves, the object is a blessed scalar ref, and C<$$array>
+is the packed bytes of all the elements.
+
+Supported element types are L<XEvent|X11::Xlib::XEvent>,
+L<XVisualInfo|X11::Xlib::XVisualInfo>,
+L<XWindowChanges|X11::Xlib::XWindowChanges>,
+L<XWindowAttributes|X11::Xlib::XWindowAttributes>,
+L<XSetWindowAttributes|X11::Xlib::XSetWindowAttributes>,
+L<XSizeHints|X11::Xlib::XSizeHints>, L<XRectangle|X11::Xlib::XRectangle>,
+L<XGCValues|X11::Xlib::XGCValues>,
+L<XRenderPictFormat|X11::Xlib::XRenderPictFormat>,
+L<XRenderPictureAttributes|X11::Xlib::XRenderPictureAttributes>,
+L<XRenderColor|X11::Xlib::XRenderColor>, and
+L<XGlyphInfo|X11::Xlib::XGlyphInfo>.
+
+=head1 CONSTRUCTORS
+
+=head2 new
+
+  my $array= X11::Xlib::StructArray->new($type, @elements);
+  my $array= X11::Xlib::XRectangle->new_array(@elements);
+
+C<$type> is a struct class name, with or without the C<X11::Xlib::> prefix, or
+an instance of one.  Elements may be struct objects, hashrefs of fields, or (for
+structs made entirely of 16-bit fields like XRectangle) arrayrefs of field
+values in C struct order.
+
+=head2 new_from_packed
+
+  my $array= X11::Xlib::StructArray->new_from_packed($type, $bytes);
+
+=head1 ATTRIBUTES
+
+=head2 elem_class
+
+Full package name of the element type.
+
+=head2 elem_size
+
+=head2 count
+
+Number of elements.
+
+=head2 capacity
+
+Number of elements that fit in the buffer before it needs to be reallocated.
+
+=head1 METHODS
+
+=head2 elem
+
+  my $struct= $array->elem($idx);
+
+Return a view of element C<$idx> (negative counts from the end).  This is an
+ordinary struct object of the element class, but its bytes are the bytes of
+the array, so changing its fields changes the array.  A view keeps the array's
+buffer alive, and refers to a position rather than to an element, so it sees
+whatever L</splice> moves into that position.
+
+While any views exist, the buffer can't be reallocated, and an operation that
+would need to grow it beyond its L</capacity> dies.  Call L</reserve> first if
+you need to keep views while adding elements.
+
+A view can't be given new bytes with C<$$view= ...>, which would separate it
+from the array; that dies.  Use the field accessors or L</set> instead.
+
+=head2 elems
+
+Return a view of every element.
+
+=head2 get
+
+  my $struct= $array->get($idx);
+
+Return a copy of element C<$idx>.
+
+=head2 set
+
+  $array->set($idx, $struct_or_hashref);
+
+=head2 push
+
+  my $new_count= $array->push(@elements);
+
+=head2 splice
+
+  my $removed= $array->splice($offset, $length, @replacements);
+
+Like Perl's C<splice>, except the removed elements are returned as a new
+StructArray.
+
+=head2 slice
+
+  my $copy= $array->slice($offset, $length);
+
+Return a new StructArray holding a copy of C<$length> elements (default all
+remaining) starting from C<$offset>.
+
+=head2 reserve
+
+  $array->reserve($count);
+
+Make room for at least C<$count> elements.
+
+=head2 bytes
+
+The packed bytes of all the elements.
+
+=head1 AUTHOR
+
+Olivier Thauvin, E<lt>nanardon@nanardon.zarb.orgE<gt>
+
+Michael Conrad, E<lt>mike@nrdvana.netE<gt>
+
+=head1 COPYRIGHT AND LICENSE
+
+Copyright (C) 2009-2010 by Olivier Thauvin
+
+Copyright (C) 2017-2021 by Michael Conrad
+
+This library is free software; you can redistribute it and/or modify
+it under the same terms as Perl itself, either Perl version 5.10.0 or,
+at your option, any later version of Perl 5 you may have available.
+
+=cut
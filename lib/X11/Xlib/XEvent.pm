@@ -734,6 +734,25 @@ Used for event type: VisibilityNotify
 # END GENERATED X11_Xlib_XEvent
 # ----------------------------------------------------------------------------
 
+@X11::Xlib::XDamageNotifyEvent::ISA= ( __PACKAGE__ );
+
+=head2 XDamageNotifyEvent
+
+Used for the DamageNotify event of the optional DAMAGE extension.  The event
+type number is assigned by the server, so this class is only used after
+L<XDamageQueryExtension|X11::Xlib/XDamageQueryExtension> has been called on
+the connection.
+
+  area              - XRectangle
+  damage            - Damage
+  drawable          - Drawable
+  geometry          - XRectangle
+  level             - int
+  more              - Bool
+  timestamp         - Time
+
+=cut
+
 1;
 
 __END__
@@ -0,0 +1,61 @@
+package X11::Xlib::XGCValues;
+require X11::Xlib::Struct;
+__END__
+
+=head1 NAME
+
+X11::Xlib::XGCValues - Struct holding the attributes of a graphics context
+
+=head1 DESCRIPTION
+
+Used with L<XCreateGC|X11::Xlib/XCreateGC>, L<XChangeGC|X11::Xlib/XChangeGC>
+and L<XGetGCValues|X11::Xlib/XGetGCValues>.  Only the fields named by the
+C<valuemask> (C<GCForeground>, C<GCLineWidth>, ...) are read by the server.
+
+=head1 ATTRIBUTES
+
+  int function              /* GXcopy, GXxor, ... */
+  unsigned long plane_mask
+  unsigned long foreground
+  unsigned long background
+  int line_width
+  int line_style            /* LineSolid, LineOnOffDash, LineDoubleDash */
+  int cap_style             /* CapNotLast, CapButt, CapRound, CapProjecting */
+  int join_style            /* JoinMiter, JoinRound, JoinBevel */
+  int fill_style            /* FillSolid, FillTiled, FillStippled, FillOpaqueStippled */
+  int fill_rule             /* EvenOddRule, WindingRule */
+  int arc_mode              /* ArcChord, ArcPieSlice */
+  Pixmap tile               /* XID */
+  Pixmap stipple            /* XID */
+  int ts_x_origin
+  int ts_y_origin
+  Font font                 /* XID */
+  int subwindow_mode        /* ClipByChildren, IncludeInferiors */
+  Bool graphics_exposures
+  int clip_x_origin
+  int clip_y_origin
+  Pixmap clip_mask          /* XID */
+  int dash_offset
+  char dashes
+
+=head1 METHODS
+
+See parent class L<X11::Xlib::Struct>
+
+=head1 AUTHOR
+
+Olivier Thauvin, E<lt>nanardon@nanardon.zarb.orgE<gt>
+
+Michael Conrad, E<lt>mike@nrdvana.netE<gt>
+
+=head1 COPYRIGHT AND LICENSE
+
+Copyright (C) 2009-2010 by Olivier Thauvin
+
+Copyright (C) 2017-2021 by Michael Conrad
+
+This library is free software; you can redistribute it and/or modify
+it under the same terms as Perl itself, either Perl version 5.10.0 or,
+at your option, any later version of Perl 5 you may have available.
+
+=cut
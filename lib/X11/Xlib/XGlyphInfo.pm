@@ -0,0 +1,61 @@
+package X11::Xlib::XGlyphInfo;
+require X11::Xlib::Struct;
+__END__
+
+=head1 NAME
+
+X11::Xlib::XGlyphInfo - Struct describing the metrics of an XRender glyph image
+
+=head1 DESCRIPTION
+
+Used with L<XRenderAddGlyphs|X11::Xlib/XRenderAddGlyphs>.
+
+=head1 ATTRIBUTES
+
+=head2 width
+
+Width of the glyph image, 16-bit unsigned
+
+=head2 height
+
+Height of the glyph image, 16-bit unsigned
+
+=head2 x
+
+Distance from the left edge of the image to the glyph origin (usually the
+negative of the left bearing), 16-bit signed
+
+=head2 y
+
+Distance from the top edge of the image to the glyph origin (the baseline),
+16-bit signed
+
+=head2 xOff
+
+Horizontal advance to the origin of the next glyph, 16-bit signed
+
+=head2 yOff
+
+Vertical advance to the origin of the next glyph, 16-bit signed
+
+=head1 METHODS
+
+See parent class L<X11::Xlib::Struct>
+
+=head1 AUTHOR
+
+Olivier Thauvin, E<lt>nanardon@nanardon.zarb.orgE<gt>
+
+Michael Conrad, E<lt>mike@nrdvana.netE<gt>
+
+=head1 COPYRIGHT AND LICENSE
+
+Copyright (C) 2009-2010 by Olivier Thauvin
+
+Copyright (C) 2017-2021 by Michael Conrad
+
+This library is free software; you can redistribute it and/or modify
+it under the same terms as Perl itself, either Perl version 5.10.0 or,
+at your option, any later version of Perl 5 you may have available.
+
+=cut
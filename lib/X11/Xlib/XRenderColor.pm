@@ -0,0 +1,52 @@
+package X11::Xlib::XRenderColor;
+require X11::Xlib::Struct;
+__END__
+
+=head1 NAME
+
+X11::Xlib::XRenderColor - Struct defining a 16-bit-per-channel RGBA color
+
+=head1 DESCRIPTION
+
+Colors for XRender are premultiplied by alpha, so half-transparent white
+is C<< { red => 0x8000, green => 0x8000, blue => 0x8000, alpha => 0x8000 } >>.
+
+=head1 ATTRIBUTES
+
+=head2 red
+
+16-bit unsigned
+
+=head2 green
+
+16-bit unsigned
+
+=head2 blue
+
+16-bit unsigned
+
+=head2 alpha
+
+16-bit unsigned
+
+=head1 METHODS
+
+See parent class L<X11::Xlib::Struct>
+
+=head1 AUTHOR
+
+Olivier Thauvin, E<lt>nanardon@nanardon.zarb.orgE<gt>
+
+Michael Conrad, E<lt>mike@nrdvana.netE<gt>
+
+=head1 COPYRIGHT AND LICENSE
+
+Copyright (C) 2009-2010 by Olivier Thauvin
+
+Copyright (C) 2017-2021 by Michael Conrad
+
+This library is free software; you can redistribute it and/or modify
+it under the same terms as Perl itself, either Perl version 5.10.0 or,
+at your option, any later version of Perl 5 you may have available.
+
+=cut
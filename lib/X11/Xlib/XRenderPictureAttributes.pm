@@ -0,0 +1,51 @@
+package X11::Xlib::XRenderPictureAttributes;
+require X11::Xlib::Struct;
+__END__
+
+=head1 NAME
+
+X11::Xlib::XRenderPictureAttributes - Struct holding the attributes of a Picture
+
+=head1 DESCRIPTION
+
+Used with L<XRenderCreatePicture|X11::Xlib/XRenderCreatePicture> and
+L<XRenderChangePicture|X11::Xlib/XRenderChangePicture>.  Only the fields named
+by the C<valuemask> (C<CPRepeat>, C<CPClipMask>, ...) are read by the server.
+
+=head1 ATTRIBUTES
+
+  int repeat                /* RepeatNone, RepeatNormal, RepeatPad, RepeatReflect */
+  Picture alpha_map         /* XID */
+  int alpha_x_origin
+  int alpha_y_origin
+  int clip_x_origin
+  int clip_y_origin
+  Pixmap clip_mask          /* XID */
+  Bool graphics_exposures
+  int subwindow_mode        /* ClipByChildren, IncludeInferiors */
+  int poly_edge
+  int poly_mode
+  Atom dither
+  Bool component_alpha
+
+=head1 METHODS
+
+See parent class L<X11::Xlib::Struct>
+
+=head1 AUTHOR
+
+Olivier Thauvin, E<lt>nanardon@nanardon.zarb.orgE<gt>
+
+Michael Conrad, E<lt>mike@nrdvana.netE<gt>
+
+=head1 COPYRIGHT AND LICENSE
+
+Copyright (C) 2009-2010 by Olivier Thauvin
+
+Copyright (C) 2017-2021 by Michael Conrad
+
+This library is free software; you can redistribute it and/or modify
+it under the same terms as Perl itself, either Perl version 5.10.0 or,
+at your option, any later version of Perl 5 you may have available.
+
+=cut
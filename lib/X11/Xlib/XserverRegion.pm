@@ -25,7 +25,8 @@ X11::Xlib::XserverRegion - XID wrapper for XserverRegion
 
 Object representing a clip region, as used by the Xfixes extension.
 
-Not much of that API is exposed by this module, yet.
+To build or inspect regions without a round trip per operation, use
+L<X11::Xlib::Region> and its C<to_server> / C<from_server> methods.
 
 =head1 ATTRIBUTES
 
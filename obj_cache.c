@@ -0,0 +1,187 @@
+/* The cache of wrapper objects, keyed by the C pointer they wrap.
+ *
+ * This file is included by PerlXlib.c
+ *
+ * PerlXlib_get_objref runs on every typemap conversion that returns a
+ * Display*, Visual*, GC, etc, so the lookup is an open-addressing table of
+ * {pointer, object} with linear probing instead of a perl hash.  The table
+ * holds the inner SV of each object without a reference count, like a weak
+ * reference: PerlXlib_fields_set_ptr adds the object when it gets a pointer
+ * and removes it when the pointer is cleared, which the magic free hook does
+ * for every object as it is freed.  Display objects are also kept in a second
+ * table, the connection registry, so that listing the connections doesn't
+ * need to look at every cached object.
+ *
+ * Each perl interpreter has its own tables (MY_CXT), since the objects can't
+ * be shared between threads.  The count of traced displays and the thread
+ * number for request_trace.c are kept here too, as MY_CXT can only be
+ * declared once.
+ */
+
+typedef struct obj_table_slot {
+    void *ptr;  /* NULL for an empty slot */
+    SV *obj;    /* inner SV/HV/AV of the object, not reference-counted */
+} obj_table_slot;
+
+typedef struct obj_table {
+    obj_table_slot *slots;
+    U32 mask, count;
+} obj_table;
+
+#define MY_CXT_KEY "X11::Xlib::_obj_cache" XS_VERSION
+typedef struct {
+    obj_table objs;   /* every object with a pointer */
+    obj_table conns;  /* Display objects, including dead connections */
+    int trace_displays;  /* displays with tracing enabled */
+    int trace_tid;       /* number of this interpreter in trace events */
+} my_cxt_t;
+START_MY_CXT
+
+static U32 obj_table_hash(void *ptr) {
+    /* Pointers are aligned, and allocations tend to be close together, so mix
+     * the upper bits into the low ones that pick the slot. */
+    UV h= PTR2UV(ptr) >> 3;
+#if UVSIZE >= 8
+    h *= (UV) 0x9E3779B97F4A7C15ULL;
+    return (U32) (h >> 32);
+#else
+    h *= (UV) 0x9E3779B1UL;
+    return (U32) (h ^ (h >> 16));
+#endif
+}
+
+static obj_table_slot * obj_table_slot_for(obj_table *t, void *ptr) {
+    U32 i= obj_table_hash(ptr) & t->mask;
+    while (t->slots[i].ptr && t->slots[i].ptr != ptr)
+        i= (i + 1) & t->mask;
+    return t->slots + i;
+}
+
+static SV * obj_table_find(obj_table *t, void *ptr) {
+    return t->count? obj_table_slot_for(t, ptr)->obj : NULL;
+}
+
+static void obj_table_store(obj_table *t, void *ptr, SV *obj) {
+    obj_table_slot *old, *slot;
+    U32 old_cap, i;
+    /* keep it at most half full, so probe sequences stay short */
+    if (!t->slots || (t->count + 1) * 2 > t->mask + 1) {
+        old= t->slots;
+        old_cap= old? t->mask + 1 : 0;
+        t->mask= old_cap? old_cap * 2 - 1 : 63;
+        Newxz(t->slots, t->mask + 1, obj_table_slot);
+        for (i= 0; i < old_cap; i++)
+            if (old[i].ptr)
+                *obj_table_slot_for(t, old[i].ptr)= old[i];
+        Safefree(old);
+    }
+    slot= obj_table_slot_for(t, ptr);
+    if (!slot->ptr) {
+        slot->ptr= ptr;
+        t->count++;
+    }
+    slot->obj= obj;
+}
+
+/* Remove the entry for 'ptr', if it belongs to 'obj'.  Later entries of the
+ * probe sequence are shifted back into the gap, so no tombstones are needed.
+ */
+static void obj_table_delete(obj_table *t, void *ptr, SV *obj) {
+    obj_table_slot *slot;
+    U32 gap, i, home;
+    if (!t->count) return;
+    slot= obj_table_slot_for(t, ptr);
+    if (!slot->ptr || slot->obj != obj)
+        return;
+    gap= slot - t->slots;
+    for (i= (gap + 1) & t->mask; t->slots[i].ptr; i= (i + 1) & t->mask) {
+        home= obj_table_hash(t->slots[i].ptr) & t->mask;
+        /* move it if its home slot is not in the range (gap, i] */
+        if (((i - home) & t->mask) >= ((i - gap) & t->mask)) {
+            t->slots[gap]= t->slots[i];
+            gap= i;
+        }
+    }
+    t->slots[gap].ptr= NULL;
+    t->slots[gap].obj= NULL;
+    t->count--;
+}
+
+void PerlXlib_obj_cache_boot(void) {
+    MY_CXT_INIT;
+    Zero(&MY_CXT, 1, my_cxt_t);
+}
+
+/* A new thread starts with empty tables; the parent's objects aren't cloned */
+void PerlXlib_obj_cache_clone(void) {
+    MY_CXT_CLONE;
+    Zero(&MY_CXT, 1, my_cxt_t);
+}
+
+/* The inner SV of the live object wrapping 'ptr', or NULL */
+SV * PerlXlib_obj_cache_find(void *ptr) {
+    dMY_CXT;
+    SV *obj= ptr? obj_table_find(&MY_CXT.objs, ptr) : NULL;
+    return obj && SvREFCNT(obj)? obj : NULL;
+}
+
+/* Register the object under 'ptr', remembering the key in its fields so it
+ * can be removed again.  Display objects also go in the connection registry.
+ */
+static void PerlXlib_fields_cache(struct PerlXlib_fields *fields, void *ptr, Bool is_conn) {
+    dMY_CXT;
+    fields->cache_key= ptr;
+    fields->cache_conn= is_conn? 1 : 0;
+    obj_table_store(&MY_CXT.objs, ptr, fields->self);
+    if (is_conn)
+        obj_table_store(&MY_CXT.conns, ptr, fields->self);
+}
+
+static void PerlXlib_fields_uncache(struct PerlXlib_fields *fields) {
+    dMY_CXT;
+    if (!fields->cache_key)
+        return;
+    obj_table_delete(&MY_CXT.objs, fields->cache_key, fields->self);
+    if (fields->cache_conn)
+        obj_table_delete(&MY_CXT.conns, fields->cache_key, fields->self);
+    fields->cache_key= NULL;
+    fields->cache_conn= 0;
+}
+
+/* A mortal array of references to every registered connection */
+AV * PerlXlib_all_connections(void) {
+    dMY_CXT;
+    AV *ret= (AV*) sv_2mortal((SV*) newAV());
+    obj_table *t= &MY_CXT.conns;
+    U32 i;
+    for (i= 0; t->count && i <= t->mask; i++)
+        if (t->slots[i].ptr && SvREFCNT(t->slots[i].obj))
+            av_push(ret, newRV_inc(t->slots[i].obj));
+    return ret;
+}
+
+/* For PerlXlib_sanity_check_data_structures */
+static void PerlXlib_obj_cache_check(void) {
+    dMY_CXT;
+    obj_table *tables[2];
+    obj_table_slot *slot;
+    struct PerlXlib_fields *fields;
+    U32 i, n;
+    int t;
+    tables[0]= &MY_CXT.objs;
+    tables[1]= &MY_CXT.conns;
+    for (t= 0; t < 2; t++) {
+        for (i= 0, n= 0; tables[t]->count && i <= tables[t]->mask; i++) {
+            slot= tables[t]->slots + i;
+            if (!slot->ptr) continue;
+            n++;
+            if (obj_table_slot_for(tables[t], slot->ptr) != slot)
+                croak("Object cache entry for %p is not reachable", slot->ptr);
+            fields= slot->obj? PerlXlib_get_magic_fields(slot->obj, OR_NULL) : NULL;
+            if (!fields || fields->cache_key != slot->ptr || (t == 1 && !fields->cache_conn))
+                croak("Object cache entry for %p doesn't match its object", slot->ptr);
+        }
+        if (n != tables[t]->count)
+            croak("Object cache count is %u but has %u entries", (unsigned) tables[t]->count, (unsigned) n);
+    }
+}
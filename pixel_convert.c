@@ -0,0 +1,403 @@
+/* Conversion of image data from the server's native pixel layout (as described
+ * by the masks of an XVisualInfo) into RGBA, RGB, or grayscale bytes.
+ *
+ * This file is included by PerlXlib.c
+ *
+ * The common layouts (32bpp and 24bpp with 8-bit channels, and 16bpp 565) have
+ * dedicated row kernels, with SSE2/SSSE3/AVX2 versions selected at runtime on
+ * x86.  Anything else goes through a generic per-pixel path driven by the masks.
+ * All paths produce identical output; channels narrower than 8 bits are widened
+ * by bit replication, and gray is (77*R + 150*G + 29*B + 128) >> 8.
+ */
+
+#if (defined(__x86_64__) || defined(__i386__)) \
+ && (defined(__clang__) || (defined(__GNUC__) && (__GNUC__ > 4 || (__GNUC__ == 4 && __GNUC_MINOR__ >= 9))))
+#define PERLXLIB_PIXCONV_X86 1
+#include <immintrin.h>
+#endif
+
+#define PIXCONV_GRAY(r, g, b) ((77*(r) + 150*(g) + 29*(b) + 128) >> 8)
+
+typedef void pixconv_row_fn(const U8 *s, U8 *d, size_t n, int r_low);
+
+/* Scalar kernels.  'r_low' means red is in the least significant bits of the
+ * pixel, which for LSBFirst 24/32bpp means red is the first byte in memory.
+ */
+
+static void pixconv_32_rgba(const U8 *s, U8 *d, size_t n, int r_low) {
+    int ri= r_low? 0 : 2, bi= 2 - ri;
+    for (; n; n--, s+= 4, d+= 4) { d[0]= s[ri]; d[1]= s[1]; d[2]= s[bi]; d[3]= 0xFF; }
+}
+static void pixconv_32_rgb(const U8 *s, U8 *d, size_t n, int r_low) {
+    int ri= r_low? 0 : 2, bi= 2 - ri;
+    for (; n; n--, s+= 4, d+= 3) { d[0]= s[ri]; d[1]= s[1]; d[2]= s[bi]; }
+}
+static void pixconv_32_gray(const U8 *s, U8 *d, size_t n, int r_low) {
+    int ri= r_low? 0 : 2, bi= 2 - ri;
+    for (; n; n--, s+= 4, d++) *d= PIXCONV_GRAY(s[ri], s[1], s[bi]);
+}
+static void pixconv_24_rgba(const U8 *s, U8 *d, size_t n, int r_low) {
+    int ri= r_low? 0 : 2, bi= 2 - ri;
+    for (; n; n--, s+= 3, d+= 4) { d[0]= s[ri]; d[1]= s[1]; d[2]= s[bi]; d[3]= 0xFF; }
+}
+static void pixconv_24_rgb(const U8 *s, U8 *d, size_t n, int r_low) {
+    int ri= r_low? 0 : 2, bi= 2 - ri;
+    for (; n; n--, s+= 3, d+= 3) { d[0]= s[ri]; d[1]= s[1]; d[2]= s[bi]; }
+}
+static void pixconv_24_gray(const U8 *s, U8 *d, size_t n, int r_low) {
+    int ri= r_low? 0 : 2, bi= 2 - ri;
+    for (; n; n--, s+= 3, d++) *d= PIXCONV_GRAY(s[ri], s[1], s[bi]);
+}
+
+#define PIXCONV_565(s, r_low, r, g, b) do { \
+        unsigned p_= (s)[0] | ((s)[1] << 8), hi_= p_ >> 11, lo_= p_ & 0x1F; \
+        g= (p_ >> 5) & 0x3F; g= (g << 2) | (g >> 4); \
+        hi_= (hi_ << 3) | (hi_ >> 2); lo_= (lo_ << 3) | (lo_ >> 2); \
+        r= r_low? lo_ : hi_; b= r_low? hi_ : lo_; \
+    } while (0)
+
+static void pixconv_16_rgba(const U8 *s, U8 *d, size_t n, int r_low) {
+    unsigned r, g, b;
+    for (; n; n--, s+= 2, d+= 4) { PIXCONV_565(s, r_low, r, g, b); d[0]= r; d[1]= g; d[2]= b; d[3]= 0xFF; }
+}
+static void pixconv_16_rgb(const U8 *s, U8 *d, size_t n, int r_low) {
+    unsigned r, g, b;
+    for (; n; n--, s+= 2, d+= 3) { PIXCONV_565(s, r_low, r, g, b); d[0]= r; d[1]= g; d[2]= b; }
+}
+static void pixconv_16_gray(const U8 *s, U8 *d, size_t n, int r_low) {
+    unsigned r, g, b;
+    for (; n; n--, s+= 2, d++) { PIXCONV_565(s, r_low, r, g, b); *d= PIXCONV_GRAY(r, g, b); }
+}
+
+#ifdef PERLXLIB_PIXCONV_X86
+
+/* SSE2 */
+
+__attribute__((target("sse2")))
+static void pixconv_32_rgba_sse2(const U8 *s, U8 *d, size_t n, int r_low) {
+    const __m128i alpha= _mm_set1_epi32((int) 0xFF000000), m8= _mm_set1_epi32(0xFF), mg= _mm_set1_epi32(0xFF00);
+    __m128i p;
+    size_t i= 0;
+    for (; i + 4 <= n; i+= 4) {
+        p= _mm_loadu_si128((const __m128i*)(s + i*4));
+        if (!r_low)
+            p= _mm_or_si128(
+                _mm_or_si128(_mm_and_si128(_mm_srli_epi32(p, 16), m8), _mm_slli_epi32(_mm_and_si128(p, m8), 16)),
+                _mm_and_si128(p, mg));
+        _mm_storeu_si128((__m128i*)(d + i*4), _mm_or_si128(p, alpha));
+    }
+    pixconv_32_rgba(s + i*4, d + i*4, n - i, r_low);
+}
+
+__attribute__((target("sse2")))
+static __m128i pixconv_gray4_sse2(__m128i p, __m128i w0, __m128i w1, __m128i w2) {
+    const __m128i m8= _mm_set1_epi32(0xFF), round= _mm_set1_epi32(128);
+    /* each channel is < 256 and each weight < 256, so a 16-bit multiply is enough */
+    __m128i sum= _mm_add_epi32(
+        _mm_add_epi32(_mm_mullo_epi16(_mm_and_si128(p, m8), w0),
+                      _mm_mullo_epi16(_mm_and_si128(_mm_srli_epi32(p, 8), m8), w1)),
+        _mm_add_epi32(_mm_mullo_epi16(_mm_and_si128(_mm_srli_epi32(p, 16), m8), w2), round));
+    return _mm_srli_epi32(sum, 8);
+}
+
+__attribute__((target("sse2")))
+static void pixconv_32_gray_sse2(const U8 *s, U8 *d, size_t n, int r_low) {
+    const __m128i w0= _mm_set1_epi32(r_low? 77 : 29), w1= _mm_set1_epi32(150), w2= _mm_set1_epi32(r_low? 29 : 77);
+    __m128i a, b, c, e;
+    size_t i= 0;
+    for (; i + 16 <= n; i+= 16) {
+        a= pixconv_gray4_sse2(_mm_loadu_si128((const __m128i*)(s + i*4)),      w0, w1, w2);
+        b= pixconv_gray4_sse2(_mm_loadu_si128((const __m128i*)(s + i*4 + 16)), w0, w1, w2);
+        c= pixconv_gray4_sse2(_mm_loadu_si128((const __m128i*)(s + i*4 + 32)), w0, w1, w2);
+        e= pixconv_gray4_sse2(_mm_loadu_si128((const __m128i*)(s + i*4 + 48)), w0, w1, w2);
+        _mm_storeu_si128((__m128i*)(d + i),
+            _mm_packus_epi16(_mm_packs_epi32(a, b), _mm_packs_epi32(c, e)));
+    }
+    pixconv_32_gray(s + i*4, d + i, n - i, r_low);
+}
+
+/* Expand four 565 pixels (one per 32-bit lane) into RGBA */
+__attribute__((target("sse2")))
+static __m128i pixconv_565x4_sse2(__m128i p, int r_low) {
+    const __m128i m5= _mm_set1_epi32(0x1F), m6= _mm_set1_epi32(0x3F), alpha= _mm_set1_epi32((int) 0xFF000000);
+    __m128i hi= _mm_srli_epi32(p, 11), g= _mm_and_si128(_mm_srli_epi32(p, 5), m6), lo= _mm_and_si128(p, m5);
+    hi= _mm_or_si128(_mm_slli_epi32(hi, 3), _mm_srli_epi32(hi, 2));
+    lo= _mm_or_si128(_mm_slli_epi32(lo, 3), _mm_srli_epi32(lo, 2));
+    g=  _mm_or_si128(_mm_slli_epi32(g, 2),  _mm_srli_epi32(g, 4));
+    return _mm_or_si128(
+        _mm_or_si128(r_low? lo : hi, _mm_slli_epi32(r_low? hi : lo, 16)),
+        _mm_or_si128(_mm_slli_epi32(g, 8), alpha));
+}
+
+__attribute__((target("sse2")))
+static void pixconv_16_rgba_sse2(const U8 *s, U8 *d, size_t n, int r_low) {
+    const __m128i zero= _mm_setzero_si128();
+    __m128i p;
+    size_t i= 0;
+    for (; i + 8 <= n; i+= 8) {
+        p= _mm_loadu_si128((const __m128i*)(s + i*2));
+        _mm_storeu_si128((__m128i*)(d + i*4),      pixconv_565x4_sse2(_mm_unpacklo_epi16(p, zero), r_low));
+        _mm_storeu_si128((__m128i*)(d + i*4 + 16), pixconv_565x4_sse2(_mm_unpackhi_epi16(p, zero), r_low));
+    }
+    pixconv_16_rgba(s + i*2, d + i*4, n - i, r_low);
+}
+
+/* SSSE3, for the byte shuffles between 3 and 4 byte pixels */
+
+__attribute__((target("ssse3")))
+static void pixconv_24_rgba_ssse3(const U8 *s, U8 *d, size_t n, int r_low) {
+    const __m128i alpha= _mm_set1_epi32((int) 0xFF000000);
+    const __m128i shuf= r_low
+        ? _mm_setr_epi8(0,1,2,-1, 3,4,5,-1, 6,7,8,-1, 9,10,11,-1)
+        : _mm_setr_epi8(2,1,0,-1, 5,4,3,-1, 8,7,6,-1, 11,10,9,-1);
+    size_t i= 0;
+    /* Each step reads 16 bytes to consume 12, so stop while 6 pixels remain */
+    for (; i + 6 <= n; i+= 4)
+        _mm_storeu_si128((__m128i*)(d + i*4),
+            _mm_or_si128(_mm_shuffle_epi8(_mm_loadu_si128((const __m128i*)(s + i*3)), shuf), alpha));
+    pixconv_24_rgba(s + i*3, d + i*4, n - i, r_low);
+}
+
+__attribute__((target("ssse3")))
+static void pixconv_32_rgb_ssse3(const U8 *s, U8 *d, size_t n, int r_low) {
+    const __m128i shuf= r_low
+        ? _mm_setr_epi8(0,1,2, 4,5,6, 8,9,10, 12,13,14, -1,-1,-1,-1)
+        : _mm_setr_epi8(2,1,0, 6,5,4, 10,9,8, 14,13,12, -1,-1,-1,-1);
+    size_t i= 0;
+    /* Each step writes 16 bytes to produce 12, so stop while 6 pixels remain */
+    for (; i + 6 <= n; i+= 4)
+        _mm_storeu_si128((__m128i*)(d + i*3),
+            _mm_shuffle_epi8(_mm_loadu_si128((const __m128i*)(s + i*4)), shuf));
+    pixconv_32_rgb(s + i*4, d + i*3, n - i, r_low);
+}
+
+/* AVX2 */
+
+__attribute__((target("avx2")))
+static void pixconv_32_rgba_avx2(const U8 *s, U8 *d, size_t n, int r_low) {
+    const __m256i alpha= _mm256_set1_epi32((int) 0xFF000000), m8= _mm256_set1_epi32(0xFF), mg= _mm256_set1_epi32(0xFF00);
+    __m256i p;
+    size_t i= 0;
+    for (; i + 8 <= n; i+= 8) {
+        p= _mm256_loadu_si256((const __m256i*)(s + i*4));
+        if (!r_low)
+            p= _mm256_or_si256(
+                _mm256_or_si256(_mm256_and_si256(_mm256_srli_epi32(p, 16), m8), _mm256_slli_epi32(_mm256_and_si256(p, m8), 16)),
+                _mm256_and_si256(p, mg));
+        _mm256_storeu_si256((__m256i*)(d + i*4), _mm256_or_si256(p, alpha));
+    }
+    pixconv_32_rgba(s + i*4, d + i*4, n - i, r_low);
+}
+
+__attribute__((target("avx2")))
+static __m256i pixconv_gray8_avx2(__m256i p, __m256i w0, __m256i w1, __m256i w2) {
+    const __m256i m8= _mm256_set1_epi32(0xFF), round= _mm256_set1_epi32(128);
+    __m256i sum= _mm256_add_epi32(
+        _mm256_add_epi32(_mm256_mullo_epi16(_mm256_and_si256(p, m8), w0),
+                         _mm256_mullo_epi16(_mm256_and_si256(_mm256_srli_epi32(p, 8), m8), w1)),
+        _mm256_add_epi32(_mm256_mullo_epi16(_mm256_and_si256(_mm256_srli_epi32(p, 16), m8), w2), round));
+    return _mm256_srli_epi32(sum, 8);
+}
+
+__attribute__((target("avx2")))
+static void pixconv_32_gray_avx2(const U8 *s, U8 *d, size_t n, int r_low) {
+    const __m256i w0= _mm256_set1_epi32(r_low? 77 : 29), w1= _mm256_set1_epi32(150), w2= _mm256_set1_epi32(r_low? 29 : 77);
+    /* the packs operate within 128-bit lanes, so the dwords come out interleaved */
+    const __m256i unshuffle= _mm256_setr_epi32(0, 4, 1, 5, 2, 6, 3, 7);
+    __m256i a, b, c, e;
+    size_t i= 0;
+    for (; i + 32 <= n; i+= 32) {
+        a= pixconv_gray8_avx2(_mm256_loadu_si256((const __m256i*)(s + i*4)),      w0, w1, w2);
+        b= pixconv_gray8_avx2(_mm256_loadu_si256((const __m256i*)(s + i*4 + 32)), w0, w1, w2);
+        c= pixconv_gray8_avx2(_mm256_loadu_si256((const __m256i*)(s + i*4 + 64)), w0, w1, w2);
+        e= pixconv_gray8_avx2(_mm256_loadu_si256((const __m256i*)(s + i*4 + 96)), w0, w1, w2);
+        _mm256_storeu_si256((__m256i*)(d + i),
+            _mm256_permutevar8x32_epi32(
+                _mm256_packus_epi16(_mm256_packs_epi32(a, b), _mm256_packs_epi32(c, e)),
+                unshuffle));
+    }
+    pixconv_32_gray_sse2(s + i*4, d + i, n - i, r_low);
+}
+
+__attribute__((target("avx2")))
+static void pixconv_16_rgba_avx2(const U8 *s, U8 *d, size_t n, int r_low) {
+    const __m256i m5= _mm256_set1_epi32(0x1F), m6= _mm256_set1_epi32(0x3F), alpha= _mm256_set1_epi32((int) 0xFF000000);
+    __m256i p, hi, g, lo;
+    size_t i= 0;
+    for (; i + 8 <= n; i+= 8) {
+        p= _mm256_cvtepu16_epi32(_mm_loadu_si128((const __m128i*)(s + i*2)));
+        hi= _mm256_srli_epi32(p, 11);
+        g=  _mm256_and_si256(_mm256_srli_epi32(p, 5), m6);
+        lo= _mm256_and_si256(p, m5);
+        hi= _mm256_or_si256(_mm256_slli_epi32(hi, 3), _mm256_srli_epi32(hi, 2));
+        lo= _mm256_or_si256(_mm256_slli_epi32(lo, 3), _mm256_srli_epi32(lo, 2));
+        g=  _mm256_or_si256(_mm256_slli_epi32(g, 2),  _mm256_srli_epi32(g, 4));
+        _mm256_storeu_si256((__m256i*)(d + i*4), _mm256_or_si256(
+            _mm256_or_si256(r_low? lo : hi, _mm256_slli_epi32(r_low? hi : lo, 16)),
+            _mm256_or_si256(_mm256_slli_epi32(g, 8), alpha)));
+    }
+    pixconv_16_rgba(s + i*2, d + i*4, n - i, r_low);
+}
+
+#endif /* PERLXLIB_PIXCONV_X86 */
+
+/* Runtime selection of the instruction set.  The detected level is cached,
+ * and can be lowered (but not raised) for testing and benchmarking.
+ */
+static int PerlXlib_pixconv_detected= -1;
+static int PerlXlib_pixconv_active= -1;
+
+int PerlXlib_pixconv_level(int max_level) {
+    if (PerlXlib_pixconv_detected < 0) {
+        PerlXlib_pixconv_detected= PerlXlib_PIXCONV_SCALAR;
+        #ifdef PERLXLIB_PIXCONV_X86
+        __builtin_cpu_init();
+        if (__builtin_cpu_supports("avx2"))       PerlXlib_pixconv_detected= PerlXlib_PIXCONV_AVX2;
+        else if (__builtin_cpu_supports("ssse3")) PerlXlib_pixconv_detected= PerlXlib_PIXCONV_SSSE3;
+        else if (__builtin_cpu_supports("sse2"))  PerlXlib_pixconv_detected= PerlXlib_PIXCONV_SSE2;
+        #endif
+        PerlXlib_pixconv_active= PerlXlib_pixconv_detected;
+    }
+    if (max_level >= 0)
+        PerlXlib_pixconv_active= max_level < PerlXlib_pixconv_detected? max_level : PerlXlib_pixconv_detected;
+    return PerlXlib_pixconv_active;
+}
+
+static pixconv_row_fn * pixconv_pick(int src_bpp, int dst_format, int level) {
+    #ifdef PERLXLIB_PIXCONV_X86
+    if (level >= PerlXlib_PIXCONV_AVX2) {
+        if (src_bpp == 32 && dst_format == PerlXlib_PIXFMT_RGBA) return &pixconv_32_rgba_avx2;
+        if (src_bpp == 32 && dst_format == PerlXlib_PIXFMT_GRAY) return &pixconv_32_gray_avx2;
+        if (src_bpp == 16 && dst_format == PerlXlib_PIXFMT_RGBA) return &pixconv_16_rgba_avx2;
+    }
+    if (level >= PerlXlib_PIXCONV_SSSE3) {
+        if (src_bpp == 24 && dst_format == PerlXlib_PIXFMT_RGBA) return &pixconv_24_rgba_ssse3;
+        if (src_bpp == 32 && dst_format == PerlXlib_PIXFMT_RGB)  return &pixconv_32_rgb_ssse3;
+    }
+    if (level >= PerlXlib_PIXCONV_SSE2) {
+        if (src_bpp == 32 && dst_format == PerlXlib_PIXFMT_RGBA) return &pixconv_32_rgba_sse2;
+        if (src_bpp == 32 && dst_format == PerlXlib_PIXFMT_GRAY) return &pixconv_32_gray_sse2;
+        if (src_bpp == 16 && dst_format == PerlXlib_PIXFMT_RGBA) return &pixconv_16_rgba_sse2;
+    }
+    #endif
+    switch (src_bpp * 10 + dst_format) {
+    case 320 + PerlXlib_PIXFMT_RGBA: return &pixconv_32_rgba;
+    case 320 + PerlXlib_PIXFMT_RGB:  return &pixconv_32_rgb;
+    case 320 + PerlXlib_PIXFMT_GRAY: return &pixconv_32_gray;
+    case 240 + PerlXlib_PIXFMT_RGBA: return &pixconv_24_rgba;
+    case 240 + PerlXlib_PIXFMT_RGB:  return &pixconv_24_rgb;
+    case 240 + PerlXlib_PIXFMT_GRAY: return &pixconv_24_gray;
+    case 160 + PerlXlib_PIXFMT_RGBA: return &pixconv_16_rgba;
+    case 160 + PerlXlib_PIXFMT_RGB:  return &pixconv_16_rgb;
+    case 160 + PerlXlib_PIXFMT_GRAY: return &pixconv_16_gray;
+    }
+    return NULL;
+}
+
+/* Generic path for any other combination of masks, depth, and byte order */
+
+typedef struct pixconv_chan {
+    int shift, bits;
+    U8 lut[256];
+} pixconv_chan;
+
+static void pixconv_chan_init(pixconv_chan *c, unsigned long mask) {
+    unsigned v, r, s;
+    c->shift= c->bits= 0;
+    if (!mask) return;
+    while (!(mask & 1)) { mask >>= 1; c->shift++; }
+    while (mask & 1)    { mask >>= 1; c->bits++; }
+    if (c->bits <= 8)
+        for (v= 0; v < (1u << c->bits); v++) {
+            r= v << (8 - c->bits);
+            for (s= c->bits; s < 8; s*= 2) r |= r >> s;
+            c->lut[v]= r & 0xFF;
+        }
+}
+
+static U8 pixconv_chan_get(const pixconv_chan *c, unsigned long p) {
+    unsigned long v;
+    if (!c->bits) return 0;
+    v= (p >> c->shift) & (((unsigned long) 2 << (c->bits - 1)) - 1);
+    return c->bits <= 8? c->lut[v] : (U8)(v >> (c->bits - 8));
+}
+
+static void pixconv_generic(const U8 *src, size_t src_stride, int width, int height,
+    int bits_per_pixel, int byte_order,
+    unsigned long red_mask, unsigned long green_mask, unsigned long blue_mask,
+    int dst_format, U8 *dst
+) {
+    pixconv_chan red, green, blue;
+    int x, y, bytes= bits_per_pixel / 8;
+    unsigned long p;
+    const U8 *s;
+    U8 r, g, b;
+    pixconv_chan_init(&red, red_mask);
+    pixconv_chan_init(&green, green_mask);
+    pixconv_chan_init(&blue, blue_mask);
+    for (y= 0; y < height; y++) {
+        s= src + y * src_stride;
+        for (x= 0; x < width; x++, s+= bytes) {
+            switch (bytes) {
+            case 1: p= s[0]; break;
+            case 2: p= byte_order == LSBFirst? s[0] | (s[1] << 8) : (s[0] << 8) | s[1]; break;
+            case 3: p= byte_order == LSBFirst? s[0] | (s[1] << 8) | ((unsigned long) s[2] << 16)
+                                             : ((unsigned long) s[0] << 16) | (s[1] << 8) | s[2]; break;
+            default:
+                    p= byte_order == LSBFirst? s[0] | (s[1] << 8) | ((unsigned long) s[2] << 16) | ((unsigned long) s[3] << 24)
+                                             : ((unsigned long) s[0] << 24) | ((unsigned long) s[1] << 16) | (s[2] << 8) | s[3];
+            }
+            r= pixconv_chan_get(&red, p);
+            g= pixconv_chan_get(&green, p);
+            b= pixconv_chan_get(&blue, p);
+            switch (dst_format) {
+            case PerlXlib_PIXFMT_RGBA: dst[3]= 0xFF; /* fall through */
+            case PerlXlib_PIXFMT_RGB:  dst[0]= r; dst[1]= g; dst[2]= b; break;
+            default:                   dst[0]= PIXCONV_GRAY(r, g, b);
+            }
+            dst += dst_format;
+        }
+    }
+}
+
+/* Convert 'height' rows of 'width' pixels from 'src' (rows 'src_stride' bytes
+ * apart) into tightly packed rows of 'dst_format' (which is also the number of
+ * bytes per output pixel).  The caller is responsible for the buffer sizes.
+ */
+void PerlXlib_convert_pixels(const char *src, size_t src_stride, int width, int height,
+    int bits_per_pixel, int byte_order,
+    unsigned long red_mask, unsigned long green_mask, unsigned long blue_mask,
+    int dst_format, char *dst
+) {
+    pixconv_row_fn *row_fn= NULL;
+    int y, r_low= 0;
+    size_t dst_stride= (size_t) width * dst_format, row_pixels= width;
+
+    if (bits_per_pixel != 8 && bits_per_pixel != 16 && bits_per_pixel != 24 && bits_per_pixel != 32)
+        croak("Unsupported bits_per_pixel %d", bits_per_pixel);
+    if (dst_format != PerlXlib_PIXFMT_RGBA && dst_format != PerlXlib_PIXFMT_RGB && dst_format != PerlXlib_PIXFMT_GRAY)
+        croak("Unsupported destination format %d", dst_format);
+
+    if (byte_order == LSBFirst) {
+        if ((bits_per_pixel == 32 || bits_per_pixel == 24) && green_mask == 0xFF00
+            && ((red_mask == 0xFF0000 && blue_mask == 0xFF) || (r_low= (red_mask == 0xFF && blue_mask == 0xFF0000)))
+        )
+            row_fn= pixconv_pick(bits_per_pixel, dst_format, PerlXlib_pixconv_level(-1));
+        else if (bits_per_pixel == 16 && green_mask == 0x7E0
+            && ((red_mask == 0xF800 && blue_mask == 0x1F) || (r_low= (red_mask == 0x1F && blue_mask == 0xF800)))
+        )
+            row_fn= pixconv_pick(16, dst_format, PerlXlib_pixconv_level(-1));
+    }
+    if (!row_fn) {
+        pixconv_generic((const U8*) src, src_stride, width, height, bits_per_pixel, byte_order,
+            red_mask, green_mask, blue_mask, dst_format, (U8*) dst);
+        return;
+    }
+    /* A tightly packed image can be converted as one long row */
+    if (src_stride == (size_t) width * (bits_per_pixel/8)) {
+        row_pixels *= height;
+        height= 1;
+    }
+    for (y= 0; y < height; y++)
+        row_fn((const U8*)(src + y * src_stride), (U8*)(dst + y * dst_stride), row_pixels, r_low);
+}
@@ -0,0 +1,113 @@
+/* Pointer motion along a path, for X11::Xlib::Display::fake_path.
+ *
+ * This file is included by PerlXlib.c
+ *
+ * The path is either a polyline through the points (followed at constant
+ * speed along its length), or one Bezier curve with the points as its control
+ * points.  It is sampled 'rate' times per second over 'duration_ms', with an
+ * easing function applied to the time, and the samples become a list of
+ * PerlXlib_input_action for PerlXlib_input_play (see input_player.c).  Samples
+ * that round to the same pixel as the previous one are dropped, and their time
+ * goes to the next event, so slow drags don't send redundant motion.
+ */
+
+static double path_ease(double t, int ease) {
+    switch (ease) {
+    case PerlXlib_PATH_EASE_IN:     return t * t * t;
+    case PerlXlib_PATH_EASE_OUT:    return 1 - (1 - t) * (1 - t) * (1 - t);
+    case PerlXlib_PATH_EASE_IN_OUT: return t < .5? 4 * t * t * t : 1 - 4 * (1 - t) * (1 - t) * (1 - t);
+    }
+    return t;
+}
+
+/* Position at fraction 's' of the way along the path.  'lengths' holds the
+ * polyline length up to each point, and 'work' has room for 2*npoints doubles.
+ */
+static void path_point(const PerlXlib_pointer_path *path, double s, const double *lengths, double *work,
+    double *x, double *y
+) {
+    const double *pts= path->points;
+    double target, f;
+    int n= path->npoints, i, j;
+    if (path->curve == PerlXlib_PATH_BEZIER) {
+        /* de Casteljau */
+        memcpy(work, pts, 2 * n * sizeof(double));
+        for (j= n - 1; j > 0; j--)
+            for (i= 0; i < j; i++) {
+                work[i*2]=   work[i*2]   + (work[i*2+2] - work[i*2])   * s;
+                work[i*2+1]= work[i*2+1] + (work[i*2+3] - work[i*2+1]) * s;
+            }
+        *x= work[0];
+        *y= work[1];
+        return;
+    }
+    target= s * lengths[n-1];
+    for (i= 1; i < n - 1 && lengths[i] < target; i++);
+    if (i >= n || lengths[i] <= lengths[i-1]) {
+        *x= pts[(i < n? i : n - 1) * 2];
+        *y= pts[(i < n? i : n - 1) * 2 + 1];
+        return;
+    }
+    f= (target - lengths[i-1]) / (lengths[i] - lengths[i-1]);
+    *x= pts[i*2-2] + (pts[i*2]   - pts[i*2-2]) * f;
+    *y= pts[i*2-1] + (pts[i*2+1] - pts[i*2-1]) * f;
+}
+
+static I32 path_round(double v) {
+    return (I32) floor(v + .5);
+}
+
+/* Write the actions for a path to 'out', which needs room for
+ * PerlXlib_POINTER_PATH_MAX_ACTIONS(path) of them, and return the number
+ * written.  'scratch' needs room for 3*npoints doubles.
+ */
+int PerlXlib_pointer_path_actions(const PerlXlib_pointer_path *path, double *scratch, PerlXlib_input_action *out) {
+    PerlXlib_input_action *start= out;
+    int steps= PerlXlib_POINTER_PATH_STEPS(path), i, ms, prev_ms= 0;
+    I32 px, py, x, y;
+    double fx, fy;
+    if (path->npoints < 1)
+        return 0;
+    scratch[0]= 0;
+    for (i= 1; i < path->npoints; i++)
+        scratch[i]= scratch[i-1] + hypot(path->points[i*2] - path->points[i*2-2],
+            path->points[i*2+1] - path->points[i*2-1]);
+    px= path_round(path->points[0]);
+    py= path_round(path->points[1]);
+    memset(out, 0, PerlXlib_POINTER_PATH_MAX_ACTIONS(path) * sizeof(*out));
+    if (!path->relative) {
+        out->type= MotionNotify;
+        out->detail= path->screen;
+        out->x= px;
+        out->y= py;
+        out++;
+    }
+    if (path->button) {
+        out->type= ButtonPress;
+        out->detail= path->button;
+        out++;
+    }
+    for (i= 1; i <= steps; i++) {
+        path_point(path, path_ease((double) i / steps, path->ease), scratch, scratch + path->npoints, &fx, &fy);
+        x= path_round(fx);
+        y= path_round(fy);
+        if (x == px && y == py) continue;
+        ms= (int) ((I64) path->duration_ms * i / steps);
+        out->type= path->relative? PerlXlib_INPUT_RELATIVE_MOTION : MotionNotify;
+        out->detail= path->relative? 0 : path->screen;
+        out->x= path->relative? x - px : x;
+        out->y= path->relative? y - py : y;
+        out->delay_ms= ms - prev_ms;
+        out++;
+        prev_ms= ms;
+        px= x;
+        py= y;
+    }
+    if (path->button) {
+        out->type= ButtonRelease;
+        out->detail= path->button;
+        out->delay_ms= path->duration_ms - prev_ms;
+        out++;
+    }
+    return out - start;
+}
@@ -0,0 +1,203 @@
+/* Client-side region algebra for X11::Xlib::Region.
+ *
+ * This file is included by PerlXlib.c
+ *
+ * A region is an array of PerlXlib_box in "y-x banded" form, the same layout
+ * the X server uses:  the boxes are sorted by y1 then x1, boxes with the same
+ * y1 form a band and all have the same y2, bands don't overlap, boxes within a
+ * band neither overlap nor touch, and vertically adjacent bands never have the
+ * same list of x spans (they would have been merged).  So every region has
+ * exactly one representation, and two regions are equal when their box arrays
+ * are byte-for-byte equal.
+ *
+ * The boolean operations walk both regions one horizontal slab at a time
+ * (between consecutive band edges of either input), combine the x spans of the
+ * two bands covering that slab, and append the result to the output SV,
+ * merging it into the previous band when the spans are identical.
+ */
+
+/* Append one box to the output buffer */
+static void region_push(SV *out, I32 x1, I32 y1, I32 x2, I32 y2) {
+    PerlXlib_box *b;
+    STRLEN len= SvCUR(out);
+    b= (PerlXlib_box*) (SvGROW(out, len + sizeof(PerlXlib_box) + 1) + len);
+    b->x1= x1; b->y1= y1; b->x2= x2; b->y2= y2;
+    SvCUR_set(out, len + sizeof(PerlXlib_box));
+}
+
+/* Append spans (pairs of x1,x2 in 'xs') as the band y1..y2, or stretch the
+ * previous band down to y2 if it ends at y1 and has the same spans.
+ */
+static void region_push_band(SV *out, size_t *prev_band, const I32 *xs, size_t nspan, I32 y1, I32 y2) {
+    PerlXlib_box *boxes= (PerlXlib_box*) SvPVX(out);
+    size_t n= SvCUR(out) / sizeof(PerlXlib_box), prev= *prev_band, i;
+    if (!nspan) return;
+    if (prev < n && n - prev == nspan && boxes[prev].y2 == y1) {
+        for (i= 0; i < nspan; i++)
+            if (boxes[prev+i].x1 != xs[i*2] || boxes[prev+i].x2 != xs[i*2+1])
+                break;
+        if (i == nspan) {
+            for (i= prev; i < n; i++) boxes[i].y2= y2;
+            return;
+        }
+    }
+    *prev_band= n;
+    for (i= 0; i < nspan; i++)
+        region_push(out, xs[i*2], y1, xs[i*2+1], y2);
+}
+
+/* Combine two sorted lists of disjoint spans.  Each list is given as the boxes
+ * of one band (or NULL, 0).  Result spans are written to 'xs' as pairs.
+ */
+static size_t region_combine_spans(const PerlXlib_box *a, size_t na, const PerlXlib_box *b, size_t nb,
+    int op, I32 *xs
+) {
+    size_t i= 0, j= 0, n= 0;
+    int in_a= 0, in_b= 0, was_in= 0, now_in;
+    I32 x, xa, xb, start= 0;
+    while (i < na*2 || j < nb*2) {
+        xa= i < na*2? (i & 1? a[i>>1].x2 : a[i>>1].x1) : I32_MAX;
+        xb= j < nb*2? (j & 1? b[j>>1].x2 : b[j>>1].x1) : I32_MAX;
+        x= xa < xb? xa : xb;
+        if (xa == x) { in_a= !in_a; i++; }
+        if (xb == x) { in_b= !in_b; j++; }
+        now_in= op == PerlXlib_REGION_UNION? (in_a || in_b)
+            : op == PerlXlib_REGION_INTERSECT? (in_a && in_b)
+            : (in_a && !in_b);
+        if (now_in && !was_in)
+            start= x;
+        else if (!now_in && was_in && x > start) {
+            xs[n*2]= start;
+            xs[n*2+1]= x;
+            n++;
+        }
+        was_in= now_in;
+    }
+    return n;
+}
+
+static int region_cmp_i32(const void *a, const void *b) {
+    I32 x= *(const I32*)a, y= *(const I32*)b;
+    return x < y? -1 : x > y? 1 : 0;
+}
+
+/* Length of the band starting at boxes[i] */
+static size_t region_band_len(const PerlXlib_box *boxes, size_t n, size_t i) {
+    size_t j= i;
+    while (j < n && boxes[j].y1 == boxes[i].y1) j++;
+    return j - i;
+}
+
+/* Append (a op b) to 'out', which should be empty. */
+void PerlXlib_region_op(SV *out, const PerlXlib_box *a, size_t na, const PerlXlib_box *b, size_t nb, int op) {
+    I32 *ys, *xs;
+    size_t nys= 0, i, ia= 0, ib= 0, la, lb, prev_band= (size_t)-1, nspan;
+    if (op == PerlXlib_REGION_INTERSECT && (!na || !nb))
+        return;
+    /* every band edge of either input is a slab boundary */
+    Newx(ys, (na + nb) * 2 + 1, I32);
+    SAVEFREEPV(ys);
+    Newx(xs, (na + nb) * 2 + 1, I32);
+    SAVEFREEPV(xs);
+    for (i= 0; i < na; i+= region_band_len(a, na, i)) { ys[nys++]= a[i].y1; ys[nys++]= a[i].y2; }
+    for (i= 0; i < nb; i+= region_band_len(b, nb, i)) { ys[nys++]= b[i].y1; ys[nys++]= b[i].y2; }
+    qsort(ys, nys, sizeof(I32), region_cmp_i32);
+    for (i= 0; i + 1 < nys; i++) {
+        if (ys[i] == ys[i+1]) continue;
+        /* skip bands that end above this slab */
+        while (ia < na && a[ia].y2 <= ys[i]) ia+= region_band_len(a, na, ia);
+        while (ib < nb && b[ib].y2 <= ys[i]) ib+= region_band_len(b, nb, ib);
+        la= (ia < na && a[ia].y1 <= ys[i])? region_band_len(a, na, ia) : 0;
+        lb= (ib < nb && b[ib].y1 <= ys[i])? region_band_len(b, nb, ib) : 0;
+        nspan= region_combine_spans(a + ia, la, b + ib, lb, op, xs);
+        region_push_band(out, &prev_band, xs, nspan, ys[i], ys[i+1]);
+    }
+}
+
+static int region_cmp_box_y1x1(const void *a, const void *b) {
+    const PerlXlib_box *p= (const PerlXlib_box*) a, *q= (const PerlXlib_box*) b;
+    return p->y1 < q->y1? -1 : p->y1 > q->y1? 1 : p->x1 < q->x1? -1 : p->x1 > q->x1? 1 : 0;
+}
+
+/* Append the union of any list of (possibly overlapping, unsorted) boxes to 'out'.
+ * Empty boxes are ignored.
+ *
+ * The boxes are sorted once by y1 then x1, and swept from top to bottom while
+ * keeping the boxes which cover the current slab in a list sorted by x1.  At
+ * each slab edge, the boxes ending there are dropped and the ones starting
+ * there (already in x order) are merged in, so the spans of each band come
+ * out of one pass over that list.
+ */
+void PerlXlib_region_from_boxes(SV *out, const PerlXlib_box *boxes, size_t n) {
+    PerlXlib_box *bx, *active, *merged, *tmp;
+    I32 *ys, *xs;
+    size_t nbx= 0, nys= 0, nact= 0, i, j, k, next= 0, ia, ib, prev_band= (size_t)-1;
+    if (!n) return;
+    Newx(bx, n, PerlXlib_box);
+    SAVEFREEPV(bx);
+    Newx(active, n, PerlXlib_box);
+    SAVEFREEPV(active);
+    Newx(merged, n, PerlXlib_box);
+    SAVEFREEPV(merged);
+    Newx(ys, n * 2, I32);
+    SAVEFREEPV(ys);
+    Newx(xs, n * 2, I32);
+    SAVEFREEPV(xs);
+    for (i= 0; i < n; i++) {
+        if (boxes[i].x1 >= boxes[i].x2 || boxes[i].y1 >= boxes[i].y2) continue;
+        bx[nbx++]= boxes[i];
+        ys[nys++]= boxes[i].y1;
+        ys[nys++]= boxes[i].y2;
+    }
+    qsort(bx, nbx, sizeof(PerlXlib_box), region_cmp_box_y1x1);
+    qsort(ys, nys, sizeof(I32), region_cmp_i32);
+    for (i= 0; i + 1 < nys; i++) {
+        if (ys[i] == ys[i+1]) continue;
+        /* drop the boxes that ended */
+        for (j= 0, k= 0; j < nact; j++)
+            if (active[j].y2 > ys[i])
+                active[k++]= active[j];
+        nact= k;
+        /* merge in the boxes that start here */
+        if (next < nbx && bx[next].y1 == ys[i]) {
+            j= next;
+            while (j < nbx && bx[j].y1 == ys[i]) j++;
+            for (ia= 0, ib= next, k= 0; ia < nact || ib < j; )
+                merged[k++]= (ib >= j || (ia < nact && active[ia].x1 <= bx[ib].x1))? active[ia++] : bx[ib++];
+            next= j;
+            nact= k;
+            tmp= active; active= merged; merged= tmp;
+        }
+        /* join the overlapping or touching spans */
+        for (j= 0, k= 0; j < nact; j++) {
+            if (k && active[j].x1 <= xs[k*2-1]) {
+                if (active[j].x2 > xs[k*2-1]) xs[k*2-1]= active[j].x2;
+            } else {
+                xs[k*2]= active[j].x1;
+                xs[k*2+1]= active[j].x2;
+                k++;
+            }
+        }
+        region_push_band(out, &prev_band, xs, k, ys[i], ys[i+1]);
+    }
+}
+
+
+/* True if the point (x,y) is inside the region */
+int PerlXlib_region_contains_point(const PerlXlib_box *boxes, size_t n, I32 x, I32 y) {
+    size_t lo= 0, hi= n, mid;
+    /* binary search for the first box with y2 > y; bands are sorted, so this
+     * is the first box of the only band that could contain y.
+     */
+    while (lo < hi) {
+        mid= (lo + hi) / 2;
+        if (boxes[mid].y2 <= y) lo= mid + 1;
+        else hi= mid;
+    }
+    if (lo >= n || boxes[lo].y1 > y)
+        return 0;
+    for (mid= lo; mid < n && boxes[mid].y1 == boxes[lo].y1; mid++)
+        if (x < boxes[mid].x1) return 0;
+        else if (x < boxes[mid].x2) return 1;
+    return 0;
+}
@@ -0,0 +1,309 @@
+/* Tracing of the XS calls made on a display, for X11::Xlib::trace_enable.
+ *
+ * This file is included by PerlXlib.c
+ *
+ * While any display is traced, every XSUB of the packages that take a display
+ * (X11::Xlib, and the ones in X11::Xlib::Display and X11::Xlib::Keymap) has
+ * its C function swapped for PerlXlib_trace_xsub, which calls the original and, if
+ * the first argument is a traced display, writes a record of the call to the
+ * display's ring: start and end time, the request serials before and after,
+ * and the file and line of the perl code that made the call (skipping frames
+ * inside X11::Xlib's own modules).  When the last display stops tracing, the
+ * original functions are put back, so tracing costs nothing when unused.
+ *
+ * The table of original functions is shared by all perl interpreters, so it
+ * is keyed by package and name rather than by CV: a thread gets its own
+ * copies of the CVs.  Each interpreter counts its own traced displays (in
+ * MY_CXT), and a new thread starts with its functions unwrapped, since its
+ * parent's traced displays aren't cloned.  Each interpreter also gets its own
+ * number, used as the "tid" of its trace events.
+ *
+ * The ring is written only by the perl thread that owns the display (these
+ * objects can't be shared between threads) and is never resized while in
+ * use, so no locking is needed.  When full, the oldest records are
+ * overwritten.  PerlXlib_trace_json formats it as Chrome trace-event JSON.
+ */
+
+static struct trace_xsub {
+    const char *pkg, *name;
+    XSUBADDR_t orig;
+} *trace_xsubs= NULL;
+static int trace_xsub_count= 0, trace_interp_count= 0;
+
+/* The packages with XSUBs that take a display as the first argument */
+static const char * const trace_packages[]= { "X11::Xlib", "X11::Xlib::Display", "X11::Xlib::Keymap", NULL };
+
+/* Caller file names, indexed by PerlXlib_trace_record.file */
+static const char *TRACE_FILES_NAME= "X11::Xlib::_trace_files";
+static const char *TRACE_FILE_IDS_NAME= "X11::Xlib::_trace_file_ids";
+
+/* The ring of a display object, or NULL if it isn't traced */
+PerlXlib_trace_ring * PerlXlib_display_trace_ring(SV *dpy_obj) {
+    SV **ent;
+    if (!dpy_obj || !SvROK(dpy_obj) || SvTYPE(SvRV(dpy_obj)) != SVt_PVHV)
+        return NULL;
+    ent= hv_fetch((HV*) SvRV(dpy_obj), "_trace", 6, 0);
+    return ent && SvPOK(*ent) && SvCUR(*ent) >= sizeof(PerlXlib_trace_ring)
+        ? (PerlXlib_trace_ring*) SvPVX(*ent) : NULL;
+}
+
+static int trace_xsub_cmp(const void *a, const void *b) {
+    const struct trace_xsub *x= (const struct trace_xsub*) a, *y= (const struct trace_xsub*) b;
+    int c= strcmp(x->pkg, y->pkg);
+    return c? c : strcmp(x->name, y->name);
+}
+
+static struct trace_xsub * trace_xsub_find(const char *pkg, const char *name) {
+    struct trace_xsub key;
+    key.pkg= pkg;
+    key.name= name;
+    return (struct trace_xsub*) bsearch(&key, trace_xsubs, trace_xsub_count, sizeof(key), &trace_xsub_cmp);
+}
+
+/* The table entry of a wrapped CV of any interpreter */
+static struct trace_xsub * trace_xsub_of_cv(CV *cv) {
+    GV *gv= CvGV(cv);
+    const char *pkg= gv && GvSTASH(gv)? HvNAME(GvSTASH(gv)) : NULL;
+    return pkg && trace_xsubs? trace_xsub_find(pkg, GvNAME(gv)) : NULL;
+}
+
+static Bool trace_is_own_cop(const COP *cop) {
+    const char *pkg= CopSTASHPV(cop);
+    return pkg && strncmp(pkg, "X11::Xlib", 9) == 0 && (pkg[9] == 0 || pkg[9] == ':');
+}
+
+/* The statement that called into X11::Xlib, like caller() would find */
+static const COP * trace_caller(void) {
+    const PERL_CONTEXT *cx;
+    I32 i;
+    if (!trace_is_own_cop(PL_curcop))
+        return PL_curcop;
+    for (i= cxstack_ix; i >= 0; i--) {
+        cx= &cxstack[i];
+        if (CxTYPE(cx) == CXt_SUB && cx->blk_oldcop && !trace_is_own_cop(cx->blk_oldcop))
+            return cx->blk_oldcop;
+    }
+    return PL_curcop;
+}
+
+static U32 trace_file_id(const char *file) {
+    HV *ids= get_hv(TRACE_FILE_IDS_NAME, GV_ADD);
+    AV *files;
+    SV **ent;
+    I32 len;
+    if (!file) file= "";
+    len= strlen(file);
+    if ((ent= hv_fetch(ids, file, len, 0)) && SvIOK(*ent))
+        return SvUV(*ent);
+    files= get_av(TRACE_FILES_NAME, GV_ADD);
+    av_push(files, newSVpvn(file, len));
+    hv_store(ids, file, len, newSVuv(av_len(files)), 0);
+    return av_len(files);
+}
+
+/* Look up the traced display at the head of the argument list, without
+ * removing the mark that the original XSUB needs.
+ */
+static HV * trace_display_hv(pTHX) {
+    SV **args= PL_stack_base + *PL_markstack_ptr + 1;
+    SV *first= args <= PL_stack_sp? args[0] : NULL;
+    return PerlXlib_display_trace_ring(first)? (HV*) SvRV(first) : NULL;
+}
+
+XS(PerlXlib_trace_xsub) {
+    struct trace_xsub *xs= trace_xsub_of_cv(cv);
+    HV *dpy_hv;
+    SV *dpy_obj;
+    Display *dpy;
+    PerlXlib_trace_ring *ring;
+    PerlXlib_trace_record *rec;
+    const COP *caller;
+    UV slot;
+    if (!xs)
+        croak("No original XSUB for traced function");
+    if (!(dpy_hv= trace_display_hv(aTHX))) {
+        xs->orig(aTHX_ cv);
+        return;
+    }
+    /* Hold the display object until the call is recorded, even if it croaks */
+    ENTER;
+    dpy_obj= newRV_inc((SV*) dpy_hv);
+    SAVEFREESV(dpy_obj);
+    ring= PerlXlib_display_trace_ring(dpy_obj);
+    dpy= PerlXlib_display_objref_get_pointer(dpy_obj, OR_NULL);
+    caller= trace_caller();
+    /* Claim the slot before the call, so calls that croak are still listed */
+    slot= ring->head++;
+    rec= ring->rec + (slot & ring->mask);
+    rec->fn= xs - trace_xsubs;
+    rec->file= trace_file_id(CopFILE(caller));
+    rec->line= CopLINE(caller);
+    rec->pad= 0;
+    rec->serial_begin= rec->serial_end= dpy? NextRequest(dpy) : 0;
+    rec->start_ns= rec->end_ns= PerlXlib_stats_now_ns();
+    xs->orig(aTHX_ cv);
+    /* The call might have disabled tracing or closed the display */
+    if (ring == PerlXlib_display_trace_ring(dpy_obj) && ring->head - slot <= ring->mask) {
+        rec->end_ns= PerlXlib_stats_now_ns();
+        dpy= PerlXlib_display_objref_get_pointer(dpy_obj, OR_NULL);
+        if (dpy) rec->serial_end= NextRequest(dpy);
+    }
+    LEAVE;
+}
+
+/* Build the table of XSUBs to trace.  This is done only once per process,
+ * since the records refer to it by index.  The names are copied to shared
+ * memory, so the table outlives the interpreter that built it.
+ */
+static void trace_find_xsubs(void) {
+    struct trace_xsub *tbl;
+    HV *stash;
+    HE *he;
+    GV *gv;
+    CV *cv;
+    const char *name;
+    int n= 0, size= 0, p;
+    for (p= 0; trace_packages[p]; p++)
+        if ((stash= gv_stashpv(trace_packages[p], 0)))
+            size += HvUSEDKEYS(stash);
+    tbl= (struct trace_xsub*) PerlMemShared_malloc((size + 1) * sizeof(struct trace_xsub));
+    for (p= 0; trace_packages[p]; p++) {
+        if (!(stash= gv_stashpv(trace_packages[p], 0)))
+            continue;
+        hv_iterinit(stash);
+        while ((he= hv_iternext(stash)) && n < size) {
+            gv= (GV*) HeVAL(he);
+            if (!isGV_with_GP(gv) || !(cv= GvCV(gv)) || !CvISXSUB(cv) || CvCONST(cv)
+                || CvXSUB(cv) == &PerlXlib_trace_xsub)
+                continue;
+            /* the tracing API itself isn't traced */
+            name= GvNAME(gv);
+            if (strstr(name, "trace_") == name || strstr(name, "_trace_") == name)
+                continue;
+            tbl[n].pkg= trace_packages[p];
+            tbl[n].name= savesharedpv(name);
+            tbl[n].orig= CvXSUB(cv);
+            n++;
+        }
+    }
+    qsort(tbl, n, sizeof(*tbl), &trace_xsub_cmp);
+    trace_xsub_count= n;
+    trace_xsubs= tbl;
+}
+
+/* Swap the XSUBs of this interpreter's traced packages */
+static void trace_swap_xsubs(Bool wrap) {
+    struct trace_xsub *xs;
+    HV *stash;
+    HE *he;
+    GV *gv;
+    CV *cv;
+    int p;
+    OP_REFCNT_LOCK;
+    if (!trace_xsubs)
+        trace_find_xsubs();
+    OP_REFCNT_UNLOCK;
+    for (p= 0; trace_packages[p]; p++) {
+        if (!(stash= gv_stashpv(trace_packages[p], 0)))
+            continue;
+        hv_iterinit(stash);
+        while ((he= hv_iternext(stash))) {
+            gv= (GV*) HeVAL(he);
+            if (!isGV_with_GP(gv) || !(cv= GvCV(gv)) || !CvISXSUB(cv)
+                || !(xs= trace_xsub_find(trace_packages[p], GvNAME(gv))))
+                continue;
+            if (CvXSUB(cv) == xs->orig || CvXSUB(cv) == &PerlXlib_trace_xsub)
+                CvXSUB(cv)= wrap? &PerlXlib_trace_xsub : xs->orig;
+        }
+    }
+}
+
+/* Count one more (or one less) traced display, and swap the XSUBs when the
+ * first one starts or the last one stops.
+ */
+void PerlXlib_trace_install(Bool enable) {
+    dMY_CXT;
+    if (enable && MY_CXT.trace_displays++ == 0)
+        trace_swap_xsubs(1);
+    else if (!enable && MY_CXT.trace_displays > 0 && --MY_CXT.trace_displays == 0)
+        trace_swap_xsubs(0);
+}
+
+/* Stop tracing a display object that is being freed without trace_disable */
+void PerlXlib_trace_release(SV *dpy_hv) {
+    dMY_CXT;
+    SV **ent;
+    if (!MY_CXT.trace_displays || SvTYPE(dpy_hv) != SVt_PVHV)
+        return;
+    ent= hv_fetch((HV*) dpy_hv, "_trace", 6, 0);
+    if (ent && SvPOK(*ent) && SvCUR(*ent) >= sizeof(PerlXlib_trace_ring)) {
+        hv_delete((HV*) dpy_hv, "_trace", 6, G_DISCARD);
+        PerlXlib_trace_install(0);
+    }
+}
+
+/* Number this interpreter, for the "tid" of its trace events */
+void PerlXlib_trace_boot(void) {
+    dMY_CXT;
+    OP_REFCNT_LOCK;
+    MY_CXT.trace_tid= ++trace_interp_count;
+    OP_REFCNT_UNLOCK;
+}
+
+/* A new thread has no traced displays, but its CVs are copies of the wrapped
+ * ones, so put the originals back.
+ */
+void PerlXlib_trace_clone(void) {
+    PerlXlib_trace_boot();
+    if (trace_xsubs)
+        trace_swap_xsubs(0);
+}
+
+static void trace_json_chars(SV *out, const char *str) {
+    const char *p;
+    for (p= str; *p; p++) {
+        if (*p == '"' || *p == '\\')
+            sv_catpvf(out, "\\%c", *p);
+        else if ((U8) *p < 0x20)
+            sv_catpvf(out, "\\u%04x", (U8) *p);
+        else
+            sv_catpvn(out, p, 1);
+    }
+}
+
+/* Format the ring, oldest first, as a Chrome trace-event JSON object of
+ * complete ("X") events, with times in microseconds.
+ */
+SV * PerlXlib_trace_json(const PerlXlib_trace_ring *ring) {
+    dMY_CXT;
+    SV *out= newSVpvs("{\"traceEvents\":[");
+    AV *files= get_av(TRACE_FILES_NAME, GV_ADD);
+    const PerlXlib_trace_record *rec;
+    const struct trace_xsub *xs;
+    SV **file;
+    UV i, first= ring->head > ring->mask? ring->head - ring->mask - 1 : 0;
+    for (i= first; i < ring->head; i++) {
+        rec= ring->rec + (i & ring->mask);
+        sv_catpv(out, i > first? ",\n{\"name\":\"" : "\n{\"name\":\"");
+        if (rec->fn >= trace_xsub_count)
+            trace_json_chars(out, "?");
+        else {
+            /* functions of the other packages are named like Display::atom */
+            xs= trace_xsubs + rec->fn;
+            if (strcmp(xs->pkg, "X11::Xlib") != 0) {
+                trace_json_chars(out, xs->pkg + 11);
+                sv_catpvs(out, "::");
+            }
+            trace_json_chars(out, xs->name);
+        }
+        sv_catpvf(out, "\",\"cat\":\"xlib\",\"ph\":\"X\",\"pid\":%d,\"tid\":%d,\"ts\":%.3f,\"dur\":%.3f,"
+            "\"args\":{\"serial_begin\":%" UVuf ",\"serial_end\":%" UVuf ",\"caller\":\"",
+            (int) getpid(), MY_CXT.trace_tid, rec->start_ns / 1000.0, (rec->end_ns - rec->start_ns) / 1000.0,
+            (UV) rec->serial_begin, (UV) rec->serial_end);
+        file= av_fetch(files, rec->file, 0);
+        trace_json_chars(out, file && SvPOK(*file)? SvPVX(*file) : "");
+        sv_catpvf(out, ":%u\"}}", (unsigned) rec->line);
+    }
+    sv_catpvf(out, "\n],\"displayTimeUnit\":\"ms\",\"otherData\":{\"dropped\":%" UVuf "}}\n", first);
+    return out;
+}
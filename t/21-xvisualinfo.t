@@ -2,7 +2,7 @@
 
 use strict;
 use warnings;
-use Test::More tests => 11;
+use Test::More tests => 12;
 use Scalar::Util 'weaken';
 
 use_ok('X11::Xlib::XVisualInfo') or die;
@@ -51,3 +51,40 @@ subtest associated_with_display => sub {
     done_testing;
 };
 
+
+subtest indexed_lookups => sub {
+    plan skip_all => "No X11 Server available"
+        unless defined $ENV{DISPLAY};
+
+    my $conn= X11::Xlib->new();
+    my @all= $conn->XGetVisualInfo(0, {});
+    my $ids= sub { [ map { $_->visualid } @_ ] };
+    is_deeply( $ids->($conn->search_visual_info), $ids->(@all), 'all visuals, same order' );
+    for my $v (@all[0, -1]) {
+        is( $conn->visual_info($v->visualid)->visualid, $v->visualid, 'visual_info by id' );
+        is( $conn->visual_info($v->visual)->visualid, $v->visualid, 'visual_info by Visual' );
+        for my $search (
+            { screen => $v->screen },
+            { screen => $v->screen, depth => $v->depth },
+            { depth => $v->depth, class => $v->class },
+            { red_mask => $v->red_mask, green_mask => $v->green_mask, blue_mask => $v->blue_mask },
+            { screen => $v->screen, bits_per_rgb => $v->bits_per_rgb },
+        ) {
+            my $desc= join ',', map "$_=$search->{$_}", sort keys %$search;
+            my $mask= 0;
+            $mask |= X11::Xlib::VisualScreenMask() if exists $search->{screen};
+            $mask |= X11::Xlib::VisualDepthMask() if exists $search->{depth};
+            $mask |= X11::Xlib::VisualClassMask() if exists $search->{class};
+            $mask |= X11::Xlib::VisualRedMaskMask()|X11::Xlib::VisualGreenMaskMask()|X11::Xlib::VisualBlueMaskMask()
+                if exists $search->{red_mask};
+            $mask |= X11::Xlib::VisualBitsPerRGBMask() if exists $search->{bits_per_rgb};
+            is_deeply( $ids->($conn->search_visual_info(%$search)), $ids->($conn->XGetVisualInfo($mask, $search)), $desc );
+        }
+        my $info;
+        $conn->XMatchVisualInfo($v->screen, $v->depth, $v->class, $info);
+        is( $conn->match_visual_info($v->screen, $v->depth, $v->class)->visualid, $info->visualid, 'match_visual_info' );
+    }
+    is( $conn->visual_info(0x7FFFFFFF), undef, 'unknown visualid' );
+    is( $conn->visual_info->display, $conn, 'result is tagged with display' );
+    done_testing;
+};
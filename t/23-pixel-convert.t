@@ -0,0 +1,69 @@
+#!/usr/bin/env perl
+
+use strict;
+use warnings;
+use Test::More;
+use X11::Xlib qw( convert_pixels LSBFirst MSBFirst );
+
+my %bgr32= ( red_mask => 0xFF0000, green_mask => 0xFF00, blue_mask => 0xFF );
+my %rgb32= ( red_mask => 0xFF, green_mask => 0xFF00, blue_mask => 0xFF0000 );
+my %rgb565= ( red_mask => 0xF800, green_mask => 0x7E0, blue_mask => 0x1F );
+my %rgb555= ( red_mask => 0x7C00, green_mask => 0x3E0, blue_mask => 0x1F );
+
+sub gray { (77*$_[0] + 150*$_[1] + 29*$_[2] + 128) >> 8 }
+
+# A few known pixels
+is( convert_pixels(\%bgr32, "\x03\x02\x01\x00", 1, 1, 32), "\x01\x02\x03\xFF", 'BGRX -> RGBA' );
+is( convert_pixels(\%rgb32, "\x01\x02\x03\x00", 1, 1, 32, 0, 'RGB'), "\x01\x02\x03", 'RGBX -> RGB' );
+is( convert_pixels(\%bgr32, "\x03\x02\x01", 1, 1, 24, 0, 'RGB'), "\x01\x02\x03", 'BGR -> RGB' );
+is( convert_pixels(\%rgb565, pack('v', 0xFFFF), 1, 1, 16), "\xFF\xFF\xFF\xFF", '565 white' );
+is( convert_pixels(\%rgb565, pack('v', 0xF800), 1, 1, 16, 0, 'RGB'), "\xFF\x00\x00", '565 red' );
+is( convert_pixels(\%rgb565, pack('n', 0x07E0), 1, 1, 16, 0, 'RGB', MSBFirst), "\x00\xFF\x00", '565 MSBFirst green' );
+is( convert_pixels(\%rgb555, pack('v', 0x7C00), 1, 1, 16, 0, 'RGB'), "\xFF\x00\x00", '555 red (generic path)' );
+is( convert_pixels(\%bgr32, "\x00\x00\xFF\x00", 1, 1, 32, 0, 'GRAY'), chr(gray(255,0,0)), 'gray of red' );
+is( convert_pixels(\%bgr32, "", 0, 0, 32), "", 'empty image' );
+
+# Row padding is skipped
+is( convert_pixels(\%bgr32, "\x03\x02\x01\x00PADD\x06\x05\x04\x00PADD", 1, 2, 32, 8, 'RGB'),
+    "\x01\x02\x03\x04\x05\x06", 'bytes_per_line respected' );
+
+like( eval { convert_pixels(\%bgr32, "1234", 2, 1, 32); 1 } ? '' : $@, qr/too short/, 'short buffer detected' );
+like( eval { convert_pixels(\%bgr32, "1234", 1, 1, 32, 0, 'XYZ'); 1 } ? '' : $@, qr/Unknown destination/, 'bad format detected' );
+like( eval { convert_pixels(\%bgr32, "1234" x 4, 1, 2, 32, -8); 1 } ? '' : $@, qr/Invalid bytes_per_line/, 'negative bytes_per_line detected' );
+
+# Every SIMD level must agree with the scalar code and the generic path, for
+# every width around the vector boundaries.
+srand(42);
+my $max_level= X11::Xlib::_pixconv_level();
+note "SIMD level: $max_level";
+my @levels= ('scalar', 'sse2', 'ssse3', 'avx2');
+my $n_levels= 1 + (grep { $levels[$_] eq $max_level } 0..$#levels)[0];
+my %masks= ( bgr32 => \%bgr32, rgb32 => \%rgb32, rgb565 => \%rgb565 );
+for my $case ([ bgr32 => 32 ], [ rgb32 => 32 ], [ bgr32 => 24 ], [ rgb32 => 24 ], [ rgb565 => 16 ], [ bgr565 => 16 ]) {
+    my ($name, $bpp)= @$case;
+    my $vinfo= $masks{$name} || { red_mask => 0x1F, green_mask => 0x7E0, blue_mask => 0xF800 };
+    for my $fmt (qw( RGBA RGB GRAY )) {
+        my $ok= 1;
+        for my $width (1..37, 64, 67) {
+            my $height= 3;
+            my $data= join '', map chr(int rand 256), 1 .. $width * $height * $bpp/8;
+            # Reference via the generic path, by declaring MSBFirst and byte-swapping the input
+            my $swapped= join '', map { scalar reverse $_ } unpack('(a'.($bpp/8).')*', $data);
+            my $expected= convert_pixels($vinfo, $swapped, $width, $height, $bpp, 0, $fmt, MSBFirst);
+            for my $level (0 .. $n_levels-1) {
+                X11::Xlib::_pixconv_level($level);
+                my $got= convert_pixels($vinfo, $data, $width, $height, $bpp, 0, $fmt);
+                if ($got ne $expected) {
+                    $ok= 0;
+                    diag "mismatch at width=$width level=$levels[$level]";
+                    last;
+                }
+            }
+            X11::Xlib::_pixconv_level(99);
+            last unless $ok;
+        }
+        ok( $ok, "$name ${bpp}bpp -> $fmt consistent across SIMD levels" );
+    }
+}
+
+done_testing;
@@ -0,0 +1,58 @@
+#!/usr/bin/env perl
+
+use strict;
+use warnings;
+use Test::More;
+use X11::Xlib qw( tile_diff );
+
+sub rects { [ map { [ $_->x, $_->y, $_->width, $_->height ] } @_ ] }
+
+srand(7);
+my ($w, $h)= (200, 150);
+my $frame= join '', map chr(int rand 256), 1 .. $w * $h * 4;
+my $state;
+
+is_deeply( rects(tile_diff($state, $frame, $w, $h, 32)), [ [ 0, 0, 200, 150 ] ], 'first frame is entirely changed' );
+is_deeply( rects(tile_diff($state, $frame, $w, $h, 32)), [], 'identical frame has no changes' );
+
+# Change one pixel in the tile at column 1, row 2
+substr($frame, (130 * $w + 70) * 4, 1)= chr(1 + ord substr($frame, (130 * $w + 70) * 4, 1));
+is_deeply( rects(tile_diff($state, $frame, $w, $h, 32)), [ [ 64, 128, 64, 22 ] ], 'one changed tile, clipped at the edge' );
+
+# Change a block spanning 2x2 tiles
+for my $y (10 .. 70) {
+    substr($frame, ($y * $w + 5) * 4, 4 * 120)= "\0" x (4 * 120);
+}
+is_deeply( rects(tile_diff($state, $frame, $w, $h, 32)), [ [ 0, 0, 128, 128 ] ], 'adjacent tiles merged' );
+
+# Swapping two rows within a tile is detected
+my $row_a= substr($frame, 140 * $w * 4, $w * 4);
+my $row_b= substr($frame, 141 * $w * 4, $w * 4);
+substr($frame, 140 * $w * 4, $w * 4)= $row_b;
+substr($frame, 141 * $w * 4, $w * 4)= $row_a;
+is_deeply( rects(tile_diff($state, $frame, $w, $h, 32)), [ [ 0, 128, 200, 22 ] ], 'row swap detected' );
+
+# Row padding and tile size are respected
+my $padded= join '', map { substr($frame, $_ * $w * 4, $w * 4) . "PAD!" } 0 .. $h-1;
+my $state2;
+tile_diff($state2, $padded, $w, $h, 32, $w * 4 + 4, 32, 32);
+substr($padded, 4, 4)= "PAD?"; # pixel 1 of row 0
+is_deeply( rects(tile_diff($state2, $padded, $w, $h, 32, $w * 4 + 4, 32, 32)), [ [ 0, 0, 32, 32 ] ], 'custom tile size' );
+substr($padded, $w * 4, 4)= "PAD?"; # padding only
+is_deeply( rects(tile_diff($state2, $padded, $w, $h, 32, $w * 4 + 4, 32, 32)), [], 'padding ignored' );
+
+# A geometry change resets the state
+is( scalar(() = tile_diff($state, $frame, $w, $h, 32, 0, 32, 32)), 1, 'new tile size reports everything (merged)' );
+
+# The hash values are the same for every SIMD level
+my $max= X11::Xlib::_pixconv_level();
+for my $level (0 .. 3) {
+    X11::Xlib::_pixconv_level($level);
+    is_deeply( rects(tile_diff($state, $frame, $w, $h, 32, 0, 32, 32)), [], 'no change at level '.X11::Xlib::_pixconv_level() );
+}
+X11::Xlib::_pixconv_level(99);
+
+like( eval { tile_diff($state, "1234", 2, 2, 32); 1 }? '' : $@, qr/too short/, 'short buffer detected' );
+like( eval { tile_diff($state, "1234" x 4, 1, 2, 32, -8); 1 }? '' : $@, qr/Invalid bytes_per_line/, 'negative bytes_per_line detected' );
+
+done_testing;
@@ -0,0 +1,98 @@
+#!/usr/bin/env perl
+
+use strict;
+use warnings;
+use Test::More;
+use X11::Xlib;
+use X11::Xlib::GlyphCache;
+
+plan skip_all => 'Xrender client lib is not available'
+    unless X11::Xlib->can('XRenderCreateGlyphSet');
+
+# Stand-in for a Display, recording the requests the cache makes
+{ package MockDisplay;
+    sub new { bless { glyphs => {}, log => [] }, shift }
+    sub XRenderFindStandardFormat { X11::Xlib::XRenderPictFormat->new(depth => 8) }
+    sub XRenderCreateGlyphSet { 42 }
+    sub XRenderFreeGlyphSet { push @{$_[0]{log}}, ['FreeGlyphSet', $_[1]] }
+    sub XRenderAddGlyphs {
+        my ($self, $gs, $ids, $infos, $images)= @_;
+        push @{$self->{log}}, ['AddGlyphs', [@$ids], length $images];
+        $self->{glyphs}{$_}= 1 for @$ids;
+    }
+    sub XRenderFreeGlyphs {
+        my ($self, $gs, $ids)= @_;
+        push @{$self->{log}}, ['FreeGlyphs', [@$ids]];
+        delete $self->{glyphs}{$_} for @$ids;
+    }
+    sub XRenderCompositeString32 { push @{$_[0]{log}}, ['Composite', $_[-1]] }
+}
+
+my $dpy= MockDisplay->new;
+my @rastered;
+my $cache= X11::Xlib::GlyphCache->new(
+    display    => $dpy,
+    max_glyphs => 8,
+    rasterizer => sub {
+        my ($font, $size, $cp)= @_;
+        push @rastered, chr $cp;
+        # 3x2 bitmap, tightly packed
+        return ("\xFF" x 6, { width => 3, height => 2, xOff => 4 });
+    },
+);
+
+my $ids= $cache->glyph_string('mono', 10, 'abca');
+is( length $ids, 16, '4 packed ids' );
+my @ids= unpack 'L*', $ids;
+is( $ids[0], $ids[3], 'repeated char has same id' );
+is( scalar(keys %{{ map { $_ => 1 } @ids }}), 3, '3 distinct glyphs' );
+is( join('', sort @rastered), 'abc', 'each glyph rasterized once' );
+is_deeply( $dpy->{log}, [ ['AddGlyphs', [ sort { $a <=> $b } @ids[0..2] ], 3*8] ], 'one upload, rows padded to 4' )
+    or diag explain $dpy->{log};
+
+@rastered= (); @{$dpy->{log}}= ();
+is( $cache->glyph_string('mono', 10, 'cab'), pack('L*', @ids[2,0,1]), 'cached ids reused' );
+is( scalar @rastered, 0, 'no rasterizing' );
+is( scalar @{$dpy->{log}}, 0, 'no requests' );
+
+$cache->glyph_string('mono', 12, 'a');
+is( $cache->count, 4, 'size is part of the key' );
+
+# 'c' and 'b' were used more recently than a/12, so overflow evicts that first
+$cache->glyph_string('mono', 10, 'defg');
+is( $cache->count, 8, 'cache full' );
+$cache->glyph_string('mono', 10, 'h');
+ok( (grep { $_->[0] eq 'FreeGlyphs' } @{$dpy->{log}}), 'eviction freed glyphs on server' );
+ok( $cache->count <= 8, 'count within limit' );
+is( scalar keys %{$dpy->{glyphs}}, $cache->count, 'server and cache agree' );
+@rastered= ();
+$cache->glyph_string('mono', 10, 'h');
+is( scalar @rastered, 0, 'newest glyph survived eviction' );
+
+# A string with more distinct glyphs than the cache holds still works
+@{$dpy->{log}}= ();
+$ids= $cache->draw(1, 2, 0, 0, 'mono', 10, join('', map chr, 0x100 .. 0x10B));
+my ($composite)= grep { $_->[0] eq 'Composite' } @{$dpy->{log}};
+my %uniq= map { $_ => 1 } unpack 'L*', $composite->[1];
+is( scalar keys %uniq, 12, 'all glyphs of long string are distinct' );
+
+$cache->add_glyph('mono', 10, ord('h'), "\0" x 8, { width => 3, height => 2 });
+is( scalar keys %{$dpy->{glyphs}}, $cache->count, 'replaced glyph freed' );
+
+undef $cache;
+is( $dpy->{log}[-1][0], 'FreeGlyphSet', 'glyphset freed on destroy' );
+
+SKIP: {
+    skip 'Not built with FreeType', 4 unless X11::Xlib->can('ft_render_glyph');
+    my ($font)= grep { -f } $ENV{TEST_FONT_FILE} || (),
+        map { glob "$_/*.ttf $_/*/*.ttf $_/*/*/*.ttf" } '/usr/share/fonts', '/usr/local/share/fonts';
+    skip 'No TrueType font found (set TEST_FONT_FILE)', 4 unless $font;
+    note "Using $font";
+    my ($img, $info)= X11::Xlib::ft_render_glyph($font, 24, ord 'M');
+    isa_ok( $info, 'X11::Xlib::XGlyphInfo' );
+    ok( $info->width > 0 && $info->height > 0, 'glyph has size' );
+    is( length $img, (($info->width + 3) & ~3) * $info->height, 'rows padded to 4 bytes' );
+    ok( $info->xOff >= $info->width, 'advance covers glyph' );
+}
+
+done_testing;
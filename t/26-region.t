@@ -0,0 +1,116 @@
+#!/usr/bin/env perl
+
+use strict;
+use warnings;
+use Test::More;
+use X11::Xlib;
+use X11::Xlib::Region;
+
+sub R { X11::Xlib::Region->new(@_) }
+
+# Rasterize a region or list of [x,y,w,h] onto a set of "x,y" pixels within 0..$size
+sub pixels_of_region {
+    my ($r, $size)= @_;
+    my %px;
+    for my $box (@{ $r->boxes }) {
+        for my $y ($box->[1] .. $box->[3]-1) { for my $x ($box->[0] .. $box->[2]-1) {
+            $px{"$x,$y"}= 1 if $x >= 0 && $y >= 0 && $x < $size && $y < $size;
+        } }
+    }
+    return \%px;
+}
+
+subtest basics => sub {
+    my $r= R();
+    ok( $r->is_empty, 'empty region' );
+    is( $r->count, 0, 'no rects' );
+    is_deeply( [ $r->bbox ], [], 'no bbox' );
+    is( $r->packed_rects, '', 'no packed rects' );
+
+    $r= R([ 10, 20, 30, 40 ]);
+    is( $r->count, 1, 'one rect' );
+    is_deeply( $r->boxes, [ [ 10, 20, 40, 60 ] ], 'box' );
+    ok( $r->contains_point(10, 20), 'contains top-left' );
+    ok( $r->contains_point(39, 59), 'contains bottom-right' );
+    ok( !$r->contains_point(40, 30), 'right edge is exclusive' );
+    ok( !$r->contains_point(20, 60), 'bottom edge is exclusive' );
+    ok( !$r->contains_point(9, 30), 'left of box' );
+
+    my $r2= R({ x => 10, y => 20, width => 30, height => 40 }, [ 0, 0, 0, 10 ]);
+    ok( $r->equal($r2), 'hashref constructor, empty rect ignored' );
+    ok( $r->equal(X11::Xlib::Region->new_from_packed($r->packed_rects)), 'packed round trip' );
+    is_deeply( [ map { [ $_->x, $_->y, $_->width, $_->height ] } $r->rects ], [ [ 10, 20, 30, 40 ] ], 'rects' );
+    isa_ok( $r->union($r2), 'X11::Xlib::Region', 'result of union' );
+};
+
+subtest banding => sub {
+    # Two overlapping squares make three bands
+    my $r= R([ 0, 0, 10, 10 ], [ 5, 5, 10, 10 ]);
+    is_deeply( $r->boxes, [ [ 0, 0, 10, 5 ], [ 0, 5, 15, 10 ], [ 5, 10, 15, 15 ] ], 'overlapping squares' );
+    # Stacked rects with identical spans merge into one band
+    $r= R([ 0, 0, 10, 5 ], [ 0, 5, 10, 5 ], [ 0, 10, 10, 5 ]);
+    is_deeply( $r->boxes, [ [ 0, 0, 10, 15 ] ], 'vertically adjacent rects coalesce' );
+    # Side-by-side touching rects merge into one span
+    $r= R([ 0, 0, 5, 5 ], [ 5, 0, 5, 5 ]);
+    is_deeply( $r->boxes, [ [ 0, 0, 10, 5 ] ], 'horizontally adjacent rects coalesce' );
+    # Same area built two different ways is equal
+    ok( R([ 0, 0, 20, 10 ], [ 0, 10, 10, 10 ])->equal(R([ 0, 0, 10, 20 ], [ 10, 0, 10, 10 ])), 'canonical form' );
+};
+
+subtest operations => sub {
+    my $r1= R([ 0, 0, 10, 10 ]);
+    my $r2= R([ 5, 5, 10, 10 ]);
+    is_deeply( $r1->intersect($r2)->boxes, [ [ 5, 5, 10, 10 ] ], 'intersect' );
+    is_deeply( $r1->subtract($r2)->boxes, [ [ 0, 0, 10, 5 ], [ 0, 5, 5, 10 ] ], 'subtract' );
+    is_deeply( $r1->union([ [ 5, 5, 10, 10 ] ])->boxes, R([ 0, 0, 10, 10 ], [ 5, 5, 10, 10 ])->boxes, 'union with rect list' );
+    ok( $r1->subtract($r1)->is_empty, 'a - a is empty' );
+    ok( $r1->intersect(R([ 20, 20, 5, 5 ]))->is_empty, 'disjoint intersect is empty' );
+    is_deeply( $r1->translate(-3, 100)->boxes, [ [ -3, 100, 7, 110 ] ], 'translate' );
+    my $bbox= $r1->union(R([ 30, -5, 1, 1 ]))->bbox;
+    is_deeply( [ $bbox->x, $bbox->y, $bbox->width, $bbox->height ], [ 0, -5, 31, 15 ], 'bbox' );
+    # A hole in the middle
+    my $ring= R([ 0, 0, 30, 30 ])->subtract([ [ 10, 10, 10, 10 ] ]);
+    is( $ring->count, 4, 'ring has 4 boxes' );
+    ok( !$ring->contains_point(15, 15), 'hole not contained' );
+    ok( $ring->contains_point(25, 15), 'right side contained' );
+};
+
+subtest clamping => sub {
+    my $r= R([ 32000, 0, 60000, 1 ])->translate(1000, 0);
+    is_deeply( $r->boxes, [ [ 33000, 0, 93000, 1 ] ], '32-bit internal coordinates' );
+    my ($rect)= $r->rects;
+    is_deeply( [ $rect->x, $rect->width ], [ 32767, 60233 ], 'clamped to protocol limits' );
+    my $max= 2**31 - 1;
+    is_deeply( R([ 0, 0, 10, 10 ])->translate($max - 5, 0)->boxes, [ [ $max - 5, 0, $max, 10 ] ],
+        'translate saturates at the 32-bit limit' );
+    ok( R([ 0, 0, 10, 10 ])->translate(0, -2**32)->is_empty, 'translated past the limit is empty' );
+    is_deeply( R([ 0, 0, 10, 10 ], [ 0, 12, 10, 10 ])->translate(0, $max - 8)->boxes, [ [ 0, $max - 8, 10, $max ] ],
+        'boxes squashed against the limit are dropped' );
+};
+
+subtest random_vs_pixels => sub {
+    srand(42);
+    my $size= 40;
+    for my $iter (1..60) {
+        my @ra= map { [ int rand $size, int rand $size, int rand 15, int rand 15 ] } 1 .. 1 + int rand 6;
+        my @rb= map { [ int rand $size, int rand $size, int rand 15, int rand 15 ] } 1 .. 1 + int rand 6;
+        my ($r1, $r2)= (R(@ra), R(@rb));
+        my ($pa, $pb)= (pixels_of_region($r1, $size+20), pixels_of_region($r2, $size+20));
+        my %pa_rects= map { my $b= $_; map { my $y= $_; map +("$_,$y" => 1), $b->[0] .. $b->[0]+$b->[2]-1 } $b->[1] .. $b->[1]+$b->[3]-1 } @ra;
+        my %u= (%$pa, %$pb);
+        my %i= map { $_ => 1 } grep { $pb->{$_} } keys %$pa;
+        my %s= map { $_ => 1 } grep { !$pb->{$_} } keys %$pa;
+        my $ok= 1;
+        $ok &&= is_deeply( $pa, \%pa_rects, "from rects $iter" );
+        $ok &&= is_deeply( pixels_of_region($r1->union($r2), $size+20), \%u, "union $iter" );
+        $ok &&= is_deeply( pixels_of_region($r1->intersect($r2), $size+20), \%i, "intersect $iter" );
+        $ok &&= is_deeply( pixels_of_region($r1->subtract($r2), $size+20), \%s, "subtract $iter" );
+        # Rebuilding the union from its own rects must give the identical banded form
+        $ok &&= ok( $r1->union($r2)->equal(R($r1->union($r2)->rects)), "canonical $iter" );
+        my ($x, $y)= (int rand $size, int rand $size);
+        $ok &&= is( !!$r1->contains_point($x, $y), !!$pa->{"$x,$y"}, "contains_point $iter" );
+        last unless $ok;
+    }
+};
+
+done_testing;
@@ -0,0 +1,98 @@
+#!/usr/bin/env perl
+
+use strict;
+use warnings;
+use Test::More;
+use X11::Xlib;
+use X11::Xlib::StructArray;
+use X11::Xlib::Region;
+
+sub rects { [ map { [ $_->x, $_->y, $_->width, $_->height ] } @_ ] }
+
+subtest construct => sub {
+    my $arr= X11::Xlib::XRectangle->new_array([ 1, 2, 3, 4 ], { x => 5, y => 6, width => 7, height => 8 });
+    isa_ok( $arr, 'X11::Xlib::StructArray' );
+    is( $arr->elem_class, 'X11::Xlib::XRectangle', 'elem_class' );
+    is( $arr->elem_size, X11::Xlib::XRectangle->_sizeof, 'elem_size' );
+    is( $arr->count, 2, 'count' );
+    is( length($arr->bytes), 2 * $arr->elem_size, 'bytes' );
+    is_deeply( rects(map $arr->get($_), 0, 1), [ [ 1, 2, 3, 4 ], [ 5, 6, 7, 8 ] ], 'elements' );
+    is_deeply( rects($arr->get(-1)), [ [ 5, 6, 7, 8 ] ], 'negative index' );
+
+    my $arr2= X11::Xlib::StructArray->new_from_packed('XRectangle', $arr->bytes);
+    is( $arr2->bytes, $arr->bytes, 'new_from_packed' );
+    is( X11::Xlib::StructArray->new('X11::Xlib::XVisualInfo')->elem_class, 'X11::Xlib::XVisualInfo', 'full class name' );
+    ok( !eval { X11::Xlib::StructArray->new('Nonexistent'); 1 }, 'unknown type dies' );
+    ok( !eval { $arr->get(2); 1 }, 'out of bounds dies' );
+};
+
+subtest views => sub {
+    my $arr= X11::Xlib::XRectangle->new_array([ 1, 2, 3, 4 ], [ 5, 6, 7, 8 ]);
+    my $v= $arr->elem(1);
+    isa_ok( $v, 'X11::Xlib::XRectangle', 'view' );
+    $v->width(70);
+    is( $arr->get(1)->width, 70, 'write through view changes array' );
+    $arr->set(1, { x => -1, y => -2, width => 9, height => 9 });
+    is( $v->x, -1, 'view sees set()' );
+    my $copy= $arr->get(0);
+    $copy->x(99);
+    is( $arr->get(0)->x, 1, 'get() returns a copy' );
+
+    # A view passed to an XS function is used in place
+    X11::Xlib::XRectangle::_initialize($v);
+    is_deeply( rects($arr->get(1)), [ [ 0, 0, 0, 0 ] ], 'XS lvalue on a view modifies array' );
+
+    # Assigning a new buffer to the view would detach it from the array
+    ok( !eval { $$v= pack('s!s!S!S!', 1, 1, 1, 1); 1 }, 'assign to view dies' );
+    like( $@, qr/Can't assign to an element view/, 'error message' );
+    ok( !eval { undef $$v; 1 }, 'undef view dies' );
+    $v->x(42);
+    is( $arr->get(1)->x, 42, 'view still refers to the array' );
+
+    # Growing past capacity with live views dies, but reserve allows it
+    my $cap= $arr->capacity;
+    ok( !eval { $arr->push(([ 0, 0, 1, 1 ]) x ($cap + 1)); 1 }, 'grow with live views dies' );
+    like( $@, qr/views/, 'error mentions views' );
+    undef $v;
+    $arr->push(([ 0, 0, 1, 1 ]) x ($cap + 1));
+    is( $arr->count, $cap + 3, 'grow after views released' );
+
+    # Views keep the buffer alive
+    my $v2= X11::Xlib::XRectangle->new_array([ 9, 8, 7, 6 ])->elem(0);
+    is_deeply( rects($v2), [ [ 9, 8, 7, 6 ] ], 'view outlives array object' );
+};
+
+subtest splice_slice => sub {
+    my $arr= X11::Xlib::XRectangle->new_array(map [ $_, 0, 1, 1 ], 0..9);
+    my $s= $arr->slice(2, 3);
+    is_deeply( [ map $_->x, $s->elems ], [ 2, 3, 4 ], 'slice' );
+    is( $arr->count, 10, 'slice does not modify' );
+    is_deeply( [ map $_->x, $arr->slice(-2)->elems ], [ 8, 9 ], 'slice from end' );
+
+    my $removed= $arr->splice(1, 2, [ 100, 0, 1, 1 ]);
+    is_deeply( [ map $_->x, $removed->elems ], [ 1, 2 ], 'splice returns removed' );
+    is_deeply( [ map $_->x, $arr->elems ], [ 0, 100, 3, 4, 5, 6, 7, 8, 9 ], 'splice shrink' );
+    $arr->splice(0, 0, [ -1, 0, 1, 1 ], [ -2, 0, 1, 1 ]);
+    is_deeply( [ map $_->x, $arr->elems ], [ -1, -2, 0, 100, 3, 4, 5, 6, 7, 8, 9 ], 'splice insert' );
+    $arr->splice(5);
+    is_deeply( [ map $_->x, $arr->elems ], [ -1, -2, 0, 100, 3 ], 'splice truncate' );
+    is( $arr->push([ 42, 0, 1, 1 ]), 6, 'push returns count' );
+};
+
+subtest xs_args => sub {
+    my $arr= X11::Xlib::XRectangle->new_array([ 0, 0, 10, 10 ], [ 5, 5, 10, 10 ]);
+    my $r= X11::Xlib::Region->new_from_packed($arr);
+    ok( $r->equal(X11::Xlib::Region->new([ 0, 0, 10, 10 ], [ 5, 5, 10, 10 ])), 'StructArray accepted as XRectangle array' );
+    my $wrong= X11::Xlib::StructArray->new('XGlyphInfo', [ 1, 1, 0, 0, 1, 0 ]);
+    ok( !eval { X11::Xlib::Region->new_from_packed($wrong); 1 }, 'wrong element type rejected' );
+    like( $@, qr/XRectangle/, 'error names expected type' );
+};
+
+subtest xevent => sub {
+    my $arr= X11::Xlib::StructArray->new('XEvent', { type => X11::Xlib::KeyPress, keycode => 38 }, { type => X11::Xlib::ButtonPress, button => 1 });
+    isa_ok( $arr->elem(0), 'X11::Xlib::XKeyEvent' );
+    isa_ok( $arr->get(1), 'X11::Xlib::XButtonEvent' );
+    is( $arr->elem(0)->keycode, 38, 'event field' );
+};
+
+done_testing;
@@ -0,0 +1,294 @@
+#!/usr/bin/env perl
+
+use strict;
+use warnings;
+use Test::More;
+use X11::Xlib;
+use X11::Xlib::Keymap;
+
+# A small hand-made keymap, in the form load_keymap(2) returns it
+my @kmap;
+$kmap[10]= [ '1', '!' ];
+$kmap[38]= [ 'a', 'A' ];
+$kmap[39]= [ 's', 'S', "\x{df}", "\x{1e9e}" ];
+$kmap[40]= [ 'a', 'A' ];
+$kmap[50]= [ 'Shift_L' ];
+$kmap[54]= [ 'Ccircumflex' ];
+$kmap[60]= [ 'Cyrillic_a', 'Cyrillic_A' ];
+$kmap[66]= [ 'Caps_Lock' ];
+$kmap[77]= [ 'Num_Lock' ];
+$kmap[79]= [ 'KP_Home', 'KP_7' ];
+$kmap[92]= [ 'Mode_switch' ];
+$kmap[93]= [ 'Shift_Lock' ];
+my @mmap= ( [ 50 ], [ 66 ], [], [], [ 77 ], [], [], [ 92 ] );
+
+sub new_keymap {
+    X11::Xlib::Keymap->new(keymap => [ map { $_? [ @$_ ] : undef } @kmap ], modmap => [ map [ @$_ ], @_? @_ : @mmap ]);
+}
+
+subtest find_keycode => sub {
+    my $km= new_keymap();
+    is( $km->find_keycode('a'), 38, 'char' );
+    is( $km->find_keycode('A'), 38, 'shifted char, lowest keycode' );
+    is( $km->find_keycode('exclam'), 10, 'name of a char' );
+    is( $km->find_keycode('Shift_L'), 50, 'name' );
+    is( $km->find_keycode("\x{df}"), 39, 'mode_switch level' );
+    is( $km->find_keycode("\x{108}"), 54, 'char of a legacy KeySym' );
+    is( $km->find_keycode('U0108'), 54, 'Unicode KeySym name of a legacy KeySym' );
+    is( $km->find_keycode('Nonexistent'), undef, 'unknown name' );
+    is( $km->find_keycode('z'), undef, 'char not in keymap' );
+    my @list= $km->find_keycode('a');
+    is_deeply( \@list, [ 38 ], 'one value in list context' );
+};
+
+subtest find_key => sub {
+    my $km= new_keymap();
+    is_deeply( [ $km->find_key('a') ], [ 38, 0, 0 ], 'level 0' );
+    is_deeply( [ $km->find_key('A') ], [ 38, X11::Xlib::ShiftMask(), 1 ], 'level 1 needs Shift' );
+    is_deeply( [ $km->find_key("\x{df}") ], [ 39, X11::Xlib::Mod5Mask(), 2 ], 'level 2 needs Mode_switch' );
+    is_deeply( [ $km->find_key("\x{1e9e}") ], [ 39, X11::Xlib::Mod5Mask()|X11::Xlib::ShiftMask(), 3 ], 'level 3' );
+    is_deeply( [ $km->find_key('z') ], [], 'not found' );
+    $km= new_keymap([ 50 ], [ 66 ], [], [], [ 77 ], [], [], []);
+    is_deeply( [ $km->find_key("\x{df}") ], [ 39, undef, 2 ], 'unreachable without Mode_switch' );
+};
+
+subtest find_keysym => sub {
+    my $km= new_keymap();
+    my ($shift, $caps, $num, $mode)= (1, 2, 16, 128);
+    is( $km->find_keysym(38, 0), 'a', 'plain' );
+    is( $km->find_keysym(38, $shift), 'A', 'shift' );
+    is( $km->find_keysym(38, $caps), 'A', 'capslock' );
+    is( $km->find_keysym(38, $caps|$shift), 'A', 'capslock+shift' );
+    is( $km->find_keysym(60, $caps), 'Cyrillic_A', 'capslock on a named KeySym' );
+    is( $km->find_keysym(39, $mode), "\x{df}", 'mode_switch' );
+    is( $km->find_keysym(39, $mode|$shift), "\x{1e9e}", 'mode_switch+shift' );
+    is( $km->find_keysym(79, 0), 'KP_Home', 'keypad' );
+    is( $km->find_keysym(79, $num), 'KP_7', 'keypad with numlock' );
+    is( $km->find_keysym(79, $num|$shift), 'KP_Home', 'keypad with numlock+shift' );
+    is( $km->find_keysym(38, $num), 'a', 'numlock on other keys' );
+    is( $km->find_keysym(50, $shift), undef, 'no shifted KeySym' );
+    is( $km->find_keysym(200, 0), undef, 'unused keycode' );
+    my $ev= X11::Xlib::XEvent->new(type => X11::Xlib::KeyPress(), keycode => 10, state => $shift);
+    is( $km->find_keysym($ev), '!', 'from XKeyEvent' );
+
+    $km= new_keymap([ 50 ], [ 93 ], [], [], [ 77 ], [], [], [ 92 ]);
+    is( $km->find_keysym(38, $caps), 'A', 'shiftlock' );
+    is( $km->find_keysym(79, $num|$caps), 'KP_Home', 'keypad with numlock+shiftlock' );
+};
+
+subtest refresh => sub {
+    my $km= new_keymap();
+    is( $km->find_keycode('q'), undef, 'q not mapped' );
+    $km->keymap->[38]= [ 'q', 'Q' ];
+    $km->keymap($km->keymap);
+    is( $km->find_keycode('q'), 38, 'index rebuilt after assigning keymap' );
+    is( $km->find_keycode('a'), 40, 'old mapping moves to next key' );
+    is_deeply( [ $km->find_key("\x{df}") ], [ 39, X11::Xlib::Mod5Mask(), 2 ], 'mode_switch before modmap change' );
+    $km->modmap_del_codes('mode', 92);
+    $km->modmap_add_codes('mod4', 92);
+    is_deeply( [ $km->find_key("\x{df}") ], [ 39, X11::Xlib::Mod4Mask(), 2 ], 'mode_switch after modmap change' );
+    $km->modmap_add_syms('mod3', 'Shift_Lock');
+    is( $km->modmap->[5][0], 93, 'modmap_add_syms' );
+};
+
+subtest tables => sub {
+    my $idx= X11::Xlib::Keymap::_index_from_tables([ undef, [ 'a', 'A' ], [ 'b' ] ], [ ([]) x 8 ]);
+    is_deeply( X11::Xlib::Keymap::_index_keymap($idx), [ undef, [ 'a', 'A' ], [ 'b' ] ], 'keymap round trip' );
+    is_deeply( X11::Xlib::Keymap::_index_modmap(X11::Xlib::Keymap::_index_from_tables([], [ [ 1, 2 ], ([]) x 7 ])),
+        [ [ 1, 2 ], ([ 0, 0 ]) x 7 ], 'modmap padded like XGetModifierMapping' );
+    ok( !eval { X11::Xlib::Keymap::_index_from_tables([ [ 'NoSuchKeySym' ] ], [ ([]) x 8 ]); 1 }, 'bad KeySym dies' );
+    ok( !eval { X11::Xlib::Keymap::_index_from_tables([], [ ([]) x 7 ]); 1 }, 'short modmap dies' );
+};
+
+subtest diff => sub {
+    my @base= (undef, map [ "F$_" ], 1 .. 30);
+    my $idx= X11::Xlib::Keymap::_index_from_tables(\@base, \@mmap);
+    is_deeply( [ X11::Xlib::Keymap::_index_diff($idx, $idx) ], [], 'no changes' );
+    my @changed= map { $_? [ @$_ ] : undef } @base;
+    $changed[3]= [ 'a' ];
+    $changed[5][1]= 'A';
+    $changed[20]= [];
+    $changed[30]= [ 'F30', undef, undef, 'b' ];
+    my $idx2= X11::Xlib::Keymap::_index_from_tables(\@changed, \@mmap);
+    is_deeply( [ X11::Xlib::Keymap::_index_diff($idx2, $idx) ], [ [ 3, 5 ], [ 20, 20 ], [ 30, 30 ] ], 'nearby changes merged' );
+    is_deeply( [ X11::Xlib::Keymap::_index_diff($idx2, $idx, 0, 255, 0) ], [ [ 3, 3 ], [ 5, 5 ], [ 20, 20 ], [ 30, 30 ] ], 'exact ranges' );
+    is_deeply( [ X11::Xlib::Keymap::_index_diff($idx2, $idx, 4, 25) ], [ [ 5, 5 ], [ 20, 20 ] ], 'limited to min..max' );
+    X11::Xlib::Keymap::_index_update($idx, 3, [ @changed[3..5] ]);
+    is_deeply( [ X11::Xlib::Keymap::_index_diff($idx2, $idx) ], [ [ 20, 20 ], [ 30, 30 ] ], 'after updating the base' );
+};
+
+subtest incremental_update => sub {
+    # Patching ranges of the index in place must give the same answers as
+    # building it from scratch
+    srand(7);
+    my @pool= ( 'a', 'A', 'b', 'B', 'Ccircumflex', "\x{108}", 'U0108', 'Cyrillic_a', "\x{430}",
+        'KP_Home', 'KP_7', 'Mode_switch', 'Num_Lock', 'Caps_Lock', 'F1', "\x{df}" );
+    my $rand_row= sub { [ map { rand() < .2? undef : $pool[rand @pool] } 1 .. 1 + int rand(rand() < .05? 6 : 4) ] };
+    my @table= (undef) x 8;
+    push @table, $rand_row->() for 8 .. 40;
+    my @modmap= ( [ 9 ], [ 10 ], [], [], [ 11, 12 ], [], [], [ 13 ] );
+    my $idx= X11::Xlib::Keymap::_index_from_tables(\@table, \@modmap);
+    my @mods= ( 0, 1, 2, 3, 16, 17, 128, 129, 130, 144 );
+    my $ok= 1;
+    for my $iter (1 .. 100) {
+        my $first= 8 + int rand 33;
+        my $count= 1 + int rand 4;
+        $count= 41 - $first if $first + $count > 41;
+        my @rows= map $rand_row->(), 1 .. $count;
+        splice(@table, $first, $count, @rows);
+        X11::Xlib::Keymap::_index_update($idx, $first, \@rows);
+        my $fresh= X11::Xlib::Keymap::_index_from_tables(\@table, \@modmap);
+        $ok &&= is_deeply(
+            [ map [ X11::Xlib::Keymap::_find_key($idx, $_) ], @pool, 'z' ],
+            [ map [ X11::Xlib::Keymap::_find_key($fresh, $_) ], @pool, 'z' ],
+            "find_key after update $iter" );
+        $ok &&= is_deeply(
+            [ map { my $c= $_; map X11::Xlib::Keymap::_find_keysym($idx, $c, $_), @mods } 8 .. 40 ],
+            [ map { my $c= $_; map X11::Xlib::Keymap::_find_keysym($fresh, $c, $_), @mods } 8 .. 40 ],
+            "find_keysym after update $iter" );
+        last unless $ok;
+    }
+    is_deeply( X11::Xlib::Keymap::_index_keymap($idx), X11::Xlib::Keymap::_index_keymap(X11::Xlib::Keymap::_index_from_tables(\@table, \@modmap)),
+        'keymap after updates' );
+};
+
+subtest xkb => sub {
+    # Core rows as the server lays out an XKB keymap, plus the XKB section:
+    # key types ONE_LEVEL, TWO_LEVEL, ALPHABETIC and FOUR_LEVEL (AltGr on Mod5)
+    my @rows;
+    $rows[10]= [ '1', 'exclam', '1', 'exclam' ];
+    $rows[24]= [ 'q', 'Q', 'Cyrillic_shorti', 'Cyrillic_SHORTI' ];
+    $rows[26]= [ 'e', 'E', 'e', 'E', 'EuroSign', 'cent' ];
+    $rows[27]= [ 'r', 'R', 'Cyrillic_ka', 'Cyrillic_KA' ];
+    $rows[36]= [ 'Return', undef, 'Return' ];
+    $rows[38]= [ 'a', 'A', 'a', 'A' ];
+    $rows[50]= [ 'Shift_L', undef, 'Shift_L' ];
+    $rows[92]= [ 'ISO_Level3_Shift', undef, 'ISO_Level3_Shift' ];
+    my @modmap= ( [ 50 ], [], [], [], [], [], [], [ 92 ] );
+    my @types= ( [ 0, 1 ], [ 1, 2, [ 1, 1 ] ], [ 3, 2, [ 1, 1 ], [ 2, 1 ] ],
+        [ 0x81, 4, [ 1, 1 ], [ 0x80, 2 ], [ 0x81, 3 ] ] );
+    my %keys= ( 10 => [ 0, 1 ], 24 => [ 2, 2, 2 ], 26 => [ 0, 3 ], 27 => [ 0x40, 2, 2 ],
+        36 => [ 0, 0 ], 38 => [ 0, 2 ], 50 => [ 0, 0 ], 92 => [ 0, 0 ] );
+    my @ngroups= (0) x 256;
+    my @info= (0) x 256;
+    my @kt= (0) x 1024;
+    for my $kc (keys %keys) {
+        my ($action, @kt_idx)= @{ $keys{$kc} };
+        $ngroups[$kc]= @kt_idx;
+        $info[$kc]= $action | scalar @kt_idx;
+        @kt[$kc*4 .. $kc*4 + $#kt_idx]= @kt_idx;
+    }
+    my ($type_recs, $entry_recs, $n_ent)= ('', '', 0);
+    for (@types) {
+        my ($mods, $levels, @ent)= @$_;
+        $type_recs .= pack('C2 S2', $mods, $levels, $n_ent, scalar @ent);
+        $entry_recs .= pack('C4', $_->[0], $_->[1], 0, 1) for @ent;
+        $n_ent += @ent;
+    }
+    my $section= pack('S2 C256 C256 C1024', scalar @types, $n_ent, @ngroups, @info, @kt) . $type_recs . $entry_recs;
+    my $idx= X11::Xlib::Keymap::_index_from_tables(\@rows, \@modmap);
+    ok( !X11::Xlib::Keymap::_index_has_xkb($idx), 'no XKB section from tables' );
+    X11::Xlib::Keymap::_index_set_xkb($idx, $section);
+    ok( X11::Xlib::Keymap::_index_has_xkb($idx), 'XKB section attached' );
+    ok( !eval { X11::Xlib::Keymap::_index_set_xkb($idx, substr($section, 1)); 1 }, 'truncated section dies' );
+
+    my ($shift, $lock, $altgr, $g2, $g3, $g4)= (1, 2, 0x80, 1 << 13, 2 << 13, 3 << 13);
+    my $sym= sub { X11::Xlib::Keymap::_find_keysym($idx, $_[0], $_[1], 0) };
+    is( $sym->(38, 0), 0x61, 'alphabetic' );
+    is( $sym->(38, $shift), 0x41, 'alphabetic shift' );
+    is( $sym->(38, $lock), 0x41, 'alphabetic lock' );
+    is( $sym->(38, $shift|$lock), 0x61, 'alphabetic shift+lock cancel out' );
+    is( $sym->(26, $altgr), 0x20AC, 'four-level AltGr' );
+    is( $sym->(26, $altgr|$shift), 0xA2, 'four-level AltGr+shift' );
+    is( $sym->(26, $lock), 0x45, 'lock not used by the type means caps lock' );
+    is( $sym->(10, $lock), 0x31, 'caps lock on a digit' );
+    is( $sym->(24, $g2), 0x6CA, 'second group' );
+    is( $sym->(24, $g2|$shift), 0x6EA, 'second group shift' );
+    is( $sym->(24, $g3), 0x71, 'group wraps' );
+    is( $sym->(24, $g4|$shift), 0x6EA, 'group wraps to second' );
+    is( $sym->(27, $g4), 0x6CB, 'group clamps' );
+    is( $sym->(36, $g2|$shift), 0xFF0D, 'one-level key in any group' );
+
+    is_deeply( [ X11::Xlib::Keymap::_find_key($idx, 'EuroSign') ], [ 26, $altgr, 4 ], 'find_key AltGr level' );
+    is_deeply( [ X11::Xlib::Keymap::_find_key($idx, 'Cyrillic_SHORTI') ], [ 24, $g2|$shift, 3 ], 'find_key group 2' );
+    is_deeply( [ X11::Xlib::Keymap::_find_key($idx, 'A') ], [ 38, $shift, 1 ], 'find_key shifted' );
+    is( X11::Xlib::Keymap::_xkb_keysym($idx, 26, 0, 3, 0), 0xA2, 'xkb_keysym' );
+    is( X11::Xlib::Keymap::_xkb_keysym($idx, 36, 0, 1, 0), 0xFF0D, 'xkb_keysym one-level key at level 2' );
+    is( X11::Xlib::Keymap::_xkb_keysym($idx, 36, 1, 0, 0), undef, 'xkb_keysym missing group' );
+    is( X11::Xlib::Keymap::_xkb_keysym($idx, 24, 1, 1, 0), 0x6EA, 'xkb_keysym group 2' );
+    is_deeply( [ X11::Xlib::Keymap::_type_plan($idx, "\x{20ac}", []) ], [
+        [ press => 92 ], [ press => 26 ], [ release => 26, 'hold' ], [ release => 92 ],
+    ], 'type_plan presses AltGr for its level' );
+    is_deeply( [ map $_->[0], X11::Xlib::Keymap::_type_plan($idx, "\x{439}", [ 11 ]) ],
+        [ qw( remap press release sync restore ) ], 'type_plan uses a spare for another group' );
+
+    # A full reload after a key type change keeps unsaved local changes
+    my $old= X11::Xlib::Keymap::_index_from_tables(\@rows, \@modmap);
+    X11::Xlib::Keymap::_index_set_xkb($old, $section);
+    my @new_rows= @rows;
+    $new_rows[10]= [ '2', 'at', '2', 'at' ];
+    $new_rows[38]= [ 'b', 'B', 'b', 'B' ];
+    my $new= X11::Xlib::Keymap::_index_from_tables(\@new_rows, \@modmap);
+    X11::Xlib::Keymap::_index_set_xkb($new, $section);
+    my @local_rows= @rows;
+    $local_rows[38]= [ 'z', 'Z', 'z', 'Z' ];
+    my $local= X11::Xlib::Keymap::_index_from_tables(\@local_rows, \@modmap);
+    my $merged= X11::Xlib::Keymap::_index_merge($local, $old, $new);
+    my $km= X11::Xlib::Keymap::_index_keymap($merged);
+    is_deeply( $km->[38], [ 'z', 'Z', 'z', 'Z' ], 'merge keeps the locally changed key' );
+    is_deeply( $km->[10], [ '2', '@', '2', '@' ], 'merge takes the other keys from the server' );
+    ok( X11::Xlib::Keymap::_index_has_xkb($merged), 'merge keeps the XKB section' );
+    is( X11::Xlib::Keymap::_find_keysym($merged, 26, $altgr, 0), 0x20AC, '...for unchanged keys' );
+    is_deeply( X11::Xlib::Keymap::_index_modmap($merged), X11::Xlib::Keymap::_index_modmap($new), 'unchanged modmap from the server' );
+    $local= X11::Xlib::Keymap::_index_from_tables(\@rows, [ [ 50 ], [], [], [ 92 ], [], [], [], [] ]);
+    $merged= X11::Xlib::Keymap::_index_merge($local, $old, $new);
+    is_deeply( X11::Xlib::Keymap::_index_modmap($merged)->[3], [ 92 ], 'merge keeps a locally changed modmap' );
+    is_deeply( X11::Xlib::Keymap::_index_keymap($merged)->[38], [ 'b', 'B', 'b', 'B' ], '...and takes the keys' );
+
+    # Keys replaced from core rows fall back to the core rules; a rebuild keeps the rest
+    X11::Xlib::Keymap::_index_update($idx, 26, [ [ 'e', 'E', 'e', 'E', 'EuroSign', 'cent', 'x' ] ]);
+    is( $sym->(26, $altgr), 0x65, 'updated key uses core rules' );
+    is( $sym->(24, $g2), 0x6CA, 'other keys still use XKB' );
+    X11::Xlib::Keymap::_index_set_modmap($idx, [ [ 50, 0 ], ([]) x 6, [ 92 ] ]);
+    is( $sym->(27, $g4), 0x6CB, 'XKB kept after modmap rebuild' );
+};
+
+subtest type_plan => sub {
+    my $idx= new_keymap()->_index;
+    my @spare= X11::Xlib::Keymap::_index_spare_keycodes($idx);
+    is( scalar(grep { $_ == 38 || $_ == 50 } @spare), 0, 'spare keycodes exclude used keys' );
+    is_deeply( [ @spare[0..2] ], [ 11, 12, 13 ], 'spare keycodes' );
+    is_deeply( [ X11::Xlib::Keymap::_type_plan($idx, "aA!a", []) ], [
+        [ press => 38 ], [ release => 38, 'hold' ],
+        [ press => 50, 'delay' ], [ press => 38 ], [ release => 38, 'hold' ],
+        [ press => 10, 'delay' ], [ release => 10, 'hold' ],
+        [ release => 50, 'delay' ], [ press => 38 ], [ release => 38, 'hold' ],
+    ], 'Shift held across shifted characters' );
+    is_deeply( [ X11::Xlib::Keymap::_type_plan($idx, "\x{df}", []) ], [
+        [ press => 92 ], [ press => 39 ], [ release => 39, 'hold' ], [ release => 92 ],
+    ], 'Mode_switch level' );
+    is_deeply( [ X11::Xlib::Keymap::_type_plan($idx, "\x{108}\x{430}", []) ], [
+        [ press => 54 ], [ release => 54, 'hold' ], [ press => 60, 'delay' ], [ release => 60, 'hold' ],
+    ], 'characters of legacy KeySyms' );
+    ok( !eval { X11::Xlib::Keymap::_type_plan($idx, "az", []); 1 }, 'missing character without spares dies' );
+    like( $@, qr/U\+007A/, 'error names the character' );
+    is_deeply( [ X11::Xlib::Keymap::_type_plan($idx, "zaz\n", [ 11, 12 ]) ], [
+        [ remap => 11, 0x7A ], [ press => 11 ], [ release => 11, 'hold' ],
+        [ press => 38, 'delay' ], [ release => 38, 'hold' ],
+        [ press => 11, 'delay' ], [ release => 11, 'hold' ],
+        [ remap => 12, 0xFF0D ], [ press => 12, 'delay' ], [ release => 12, 'hold' ],
+        [ sync => 0 ], [ restore => 11 ], [ restore => 12 ],
+    ], 'spare keycodes remapped once per character' );
+    # A spare is only remapped, or restored, after a sync following its events
+    is_deeply( [ map $_->[0].$_->[1], X11::Xlib::Keymap::_type_plan($idx, "xyx", [ 11 ]) ],
+        [ qw( remap11 press11 release11 sync0 remap11 press11 release11 sync0
+              remap11 press11 release11 sync0 restore11 ) ],
+        'single spare reused after sync' );
+    is_deeply( [ map $_->[0].$_->[1], X11::Xlib::Keymap::_type_plan($idx, "xyxz", [ 11, 12 ]) ],
+        [ qw( remap11 press11 release11 remap12 press12 release12 press11 release11 sync0
+              remap11 press11 release11 sync0 restore11 restore12 ) ],
+        'spares not remapped until all are used' );
+    is( scalar(() = X11::Xlib::Keymap::_type_plan($idx, "")), 0, 'empty string' );
+};
+
+done_testing;
@@ -0,0 +1,48 @@
+#!/usr/bin/env perl
+
+use strict;
+use warnings;
+use Test::More;
+use X11::Xlib qw( :fn_keysym );
+
+subtest tables => sub {
+    for (
+        [ 0x0000061 => 0x000061, 'a' ],
+        [ 0x00000E9 => 0x0000E9, 'eacute' ],
+        [ 0x00001A1 => 0x000104, 'Aogonek' ],
+        [ 0x00002C6 => 0x000108, 'Ccircumflex' ],
+        [ 0x00006C1 => 0x000430, 'Cyrillic_a' ],
+        [ 0x00004B6 => 0x0030AB, 'kana_KA' ],
+        [ 0x0000ABC => 0x0027E8, 'leftanglebracket' ],
+        [ 0x00020AC => 0x0020AC, 'EuroSign' ],
+        [ 0x000FF09 => 0x000009, 'Tab' ],
+        [ 0x000FFB7 => 0x000037, 'KP_7' ],
+        [ 0x10030AB => 0x0030AB, 'U30AB' ],
+        [ 0x000FFBE => undef,    'F1' ],
+        [ 0x0000100 => undef,    'unassigned legacy KeySym' ],
+        [ 0x0012345 => undef,    'beyond the tables' ],
+    ) {
+        my ($keysym, $codepoint, $desc)= @$_;
+        is( keysym_to_codepoint($keysym), $codepoint, "keysym_to_codepoint: $desc" );
+    }
+    # Every legacy KeySym with a character is its preferred legacy form, except keypad keys
+    is_deeply( [ string_to_keysyms("a\x{e9}\x{104}\x{108}\x{430}\x{30ab}\t7", 1) ],
+        [ 0x61, 0xE9, 0x1A1, 0x2C6, 0x6C1, 0x4B6, 0xFF09, 0x37 ], 'string_to_keysyms legacy' );
+    is_deeply( [ string_to_keysyms("a\x{e9}\x{104}\x{1F600}") ],
+        [ 0x61, 0xE9, 0x1000104, 0x101F600 ], 'string_to_keysyms unicode' );
+    is_deeply( [ string_to_keysyms('') ], [], 'empty string' );
+    is_deeply( [ map char_to_keysym($_), split //, "a\x{e9}\x{104}" ],
+        [ string_to_keysyms("a\x{e9}\x{104}") ], 'same as char_to_keysym' );
+};
+
+subtest keysyms_to_string => sub {
+    is( keysyms_to_string([ 0x61, 0x2C6, 0x6C1, 0x101F600 ]), "a\x{108}\x{430}\x{1F600}", 'mixed KeySyms' );
+    is( keysyms_to_string([ 0x61, 0xFFBE, undef, 0x62 ]), 'ab', 'KeySyms without characters skipped' );
+    is( keysyms_to_string([ 0x61, 0xFFBE, 0x62 ], "\x{FFFD}"), "a\x{FFFD}b", 'replacement character' );
+    is( keysyms_to_string([]), '', 'empty list' );
+    my $str= join '', map chr, 0x20 .. 0x7E, 0xA0 .. 0x17F, 0x400 .. 0x45F;
+    is( keysyms_to_string([ string_to_keysyms($str, 1) ]), $str, 'round trip through legacy KeySyms' );
+    is( keysyms_to_string([ string_to_keysyms($str) ]), $str, 'round trip through Unicode KeySyms' );
+};
+
+done_testing;
@@ -2,7 +2,6 @@
 
 use strict;
 use warnings;
-use Scalar::Util 'isweak';
 use IO::Handle;
 use Test::More;
 
@@ -22,9 +21,9 @@ my $pointer1= $conn->_pointer_value;
 ok( defined $pointer1,     'pointer defined' );
 is( ref $pointer1, '',     'is a plain scalar' );
 ok( length $pointer1 > 3,  'valid length' );
-ok( exists $X11::Xlib::_obj_cache{$pointer1}, 'registered' );
-is( $X11::Xlib::_obj_cache{$pointer1}, $conn, 'as the right object' );
-ok( isweak($X11::Xlib::_obj_cache{$pointer1}), 'and is weakref' );
+ok( defined X11::Xlib::_obj_cache_get($pointer1), 'registered' );
+is( X11::Xlib::_obj_cache_get($pointer1), $conn, 'as the right object' );
+is( Internals::SvREFCNT(%$conn), 1, 'and not referenced by the cache' );
 
 my $conn2= X11::Xlib::XOpenDisplay();
 isa_ok( $conn, 'X11::Xlib', 'new connection' );
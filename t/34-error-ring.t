@@ -0,0 +1,57 @@
+#!/usr/bin/env perl
+
+use strict;
+use warnings;
+use Test::More;
+
+plan skip_all => "No X11 Server available"
+    unless $ENV{DISPLAY};
+plan tests => 20;
+
+use X11::Xlib;
+
+my $conn= X11::Xlib->new;
+isa_ok( $conn, 'X11::Xlib', 'display connection' );
+
+my $callbacks= 0;
+$conn->on_error(sub { $callbacks++ if $_[1] });
+
+$conn->error_ring_enable(4);
+ok( $X11::Xlib::_error_nonfatal_installed, 'nonfatal handler installed' );
+
+# X_UnmapWindow of windows that don't exist
+sub unmap_missing { $conn->XUnmapWindow(0x1234560 + $_) for @_; $conn->XSync; }
+
+unmap_missing(1..3);
+is( $conn->error_ring_count, 3, 'three errors recorded' );
+is( $conn->error_ring_count(resourceid => 0x1234562), 1, 'count by resourceid' );
+is( $conn->error_ring_count(request_code => 10, error_code => 3), 3, 'count by request and error code' );
+
+my @taken= $conn->error_ring_drain(resourceid => 0x1234562);
+is( scalar @taken, 1, 'drained one' );
+is_deeply( [ @{$taken[0]}{qw( error_code request_code minor_code resourceid )} ], [ 3, 10, 0, 0x1234562 ], 'record fields' );
+
+my @rest= $conn->error_ring_drain(min_serial => 0);
+is_deeply( [ map $_->{resourceid}, @rest ], [ 0x1234561, 0x1234563 ], 'others kept in order' );
+ok( $rest[0]{serial} < $rest[1]{serial}, 'serials ascending' );
+
+unmap_missing(1..6);
+is( $conn->error_ring_dropped, 2, 'oldest overwritten when full' );
+is_deeply( [ map $_->{resourceid}, $conn->error_ring_drain ], [ map 0x1234560 + $_, 3..6 ], 'newest kept' );
+
+is( $callbacks, 0, 'on_error not called while the ring is enabled' );
+$conn->error_ring_disable;
+unmap_missing(1);
+is( $callbacks, 1, 'on_error called again after disable' );
+
+# Traps find their errors by serial, and share one sync
+my $t1= $conn->error_trap(sub { $conn->XUnmapWindow(0x1234571) });
+my $t2= $conn->error_trap(sub { $conn->XSelectInput($conn->RootWindow, 0) });
+my $t3= $conn->error_trap(sub { $conn->XUnmapWindow(0x1234572); $conn->XUnmapWindow(0x1234573) });
+ok( $conn->error_trap->end->is_resolved, 'trap with no requests is resolved' );
+is_deeply( [ map $_->{resourceid}, $t3->errors ], [ 0x1234572, 0x1234573 ], 'errors of last trap' );
+ok( $t1->is_resolved, 'earlier trap resolved by the same sync' );
+is_deeply( [ map $_->{resourceid}, $t1->errors ], [ 0x1234571 ], 'errors of first trap' );
+ok( $t2->ok, 'trap without errors' );
+ok( !$t3->incomplete, 'nothing dropped' );
+is( $callbacks, 1, 'on_error not called for trapped errors' );
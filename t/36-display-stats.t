@@ -0,0 +1,44 @@
+#!/usr/bin/env perl
+
+use strict;
+use warnings;
+use Test::More;
+use List::Util 'sum';
+
+plan skip_all => "No X11 Server available"
+    unless $ENV{DISPLAY};
+plan tests => 13;
+
+use X11::Xlib;
+
+my $dpy= X11::Xlib->new;
+ok( !eval { $dpy->stats; 1 }, 'no stats until enabled' );
+
+$dpy->stats_enable;
+$dpy->XInternAtom("X11_XLIB_STATS_$_", 0) for 1..3;
+$dpy->XSync;
+my $stats= $dpy->stats(1);
+is( $stats->{round_trips}, 4, 'four round trips' );
+is( $stats->{calls}{XInternAtom}{count}, 3, 'XInternAtom counted' );
+is( $stats->{calls}{XSync}{count}, 1, 'XSync counted' );
+cmp_ok( $stats->{requests}, '>=', 4, 'requests counted' );
+cmp_ok( $stats->{bytes_flushed}, '>=', 4*8, 'bytes flushed' );
+is( sum(@{ $stats->{wait_histogram} }), 4, 'histogram has every round trip' );
+cmp_ok( $stats->{wait_us}, '>', 0, 'time spent waiting' );
+
+is( $dpy->stats->{round_trips}, 0, 'reset' );
+$dpy->atom("X11_XLIB_STATS_ATOM");
+$stats= $dpy->stats(1);
+is( $stats->{calls}{XInternAtoms}{count}, 1, 'atom() lookup counted' );
+$dpy->stats_disable;
+$dpy->XSync;
+ok( !eval { $dpy->stats; 1 }, 'disabled' );
+
+# A display freed with stats enabled must stop counting as active
+my $active= X11::Xlib::_stats_active();
+my $other= X11::Xlib->new;
+$other->stats_enable;
+is( X11::Xlib::_stats_active(), $active + 1, 'enabled display is active' );
+$other->autoclose(0);
+undef $other;
+is( X11::Xlib::_stats_active(), $active, 'freed display no longer active' );
@@ -123,6 +123,12 @@ subtest keymap_wrapper => sub {
         skip_destructive 1;
         is( err{ $keymap->keymap_save   }, '', 'keymap_save' );
     }
+    my $event= X11::Xlib::XEvent->new(type => MappingNotify, request => MappingKeyboard, first_keycode => $min, count => 2);
+    is( err{ $keymap->mapping_notify($event) }, '', 'mapping_notify keyboard' );
+    is_deeply( $keymap->keymap, $dpy->load_keymap, 'keymap matches server' );
+    $event->request(MappingModifier);
+    is( err{ $keymap->mapping_notify($event) }, '', 'mapping_notify modifier' );
+    is_deeply( $keymap->modmap, $dpy->XGetModifierMapping, 'modmap matches server' );
     is( err{ $keymap->modmap_sym_list('shift') }, '', 'modmap_sym_list' );
     SKIP: {
         skip_destructive 1;
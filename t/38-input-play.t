@@ -0,0 +1,37 @@
+#!/usr/bin/env perl
+
+use strict;
+use warnings;
+use Test::More;
+use X11::Xlib ':all';
+
+plan skip_all => "No X11 Server available"
+    unless $ENV{DISPLAY};
+
+my $dpy= new_ok( 'X11::Xlib', [], 'connect to X11' );
+my $root= RootWindow($dpy);
+
+subtest validate => sub {
+    for ([ [ 99, 0, 0, 0, 0 ] ], [ [ KeyPress, 3, 0, 0, 0 ] ], [ [ MotionNotify, -1, 0, 0, -5 ] ], "abc") {
+        ok( !eval { play_input($dpy, $_); 1 }, 'invalid actions die' );
+    }
+    is( play_input($dpy, [])->{count}, 0, 'empty list' );
+};
+
+subtest motion => sub {
+    my @actions= map [ MotionNotify, -1, 10 + $_ * 2, 20 + $_, $_ % 2? 5 : 0 ], 0..19;
+    my $report= play_input($dpy, \@actions, 1);
+    is( $report->{count}, 20, 'count' );
+    is( $report->{scheduled_us}, 50000, 'scheduled_us' );
+    cmp_ok( $report->{duration_us}, '>=', $report->{scheduled_us}, 'waited for the schedule' );
+    is( scalar @{ $report->{late_us} }, 20, 'late_us samples' );
+    cmp_ok( $report->{late_max_us}, '>=', $report->{late_p50_us}, 'max >= p50' );
+    cmp_ok( (grep { $_ < 0 } @{ $report->{late_us} }), '==', 0, 'nothing sent early' );
+    my ($root_x, $root_y)= (XQueryPointer($dpy, $root))[2,3];
+    is_deeply( [ $root_x, $root_y ], [ 48, 39 ], 'pointer at final position' );
+
+    my $packed= pack('(l5)*', map @$_, @actions[0..3]);
+    is( $dpy->play_input($packed)->{count}, 4, 'packed actions' );
+};
+
+done_testing;
@@ -0,0 +1,60 @@
+#!/usr/bin/env perl
+
+use strict;
+use warnings;
+use Test::More;
+use X11::Xlib ':all';
+
+sub path_actions {
+    my $packed= X11::Xlib::_pointer_path_actions(@_);
+    my @n= unpack '(l5)*', $packed;
+    return [ map [ @n[$_*5 .. $_*5+4] ], 0 .. $#n/5 ];
+}
+
+subtest linear => sub {
+    my $acts= path_actions([ [ 0, 0 ], [ 100, 0 ], [ 100, 50 ] ], 0, 0, 150, 20);
+    is( scalar @$acts, 4, 'start plus 3 steps' );
+    is_deeply( $acts->[0], [ MotionNotify, -1, 0, 0, 0 ], 'jump to first point' );
+    is_deeply( $acts->[1], [ MotionNotify, -1, 50, 0, 50 ], 'constant speed along length' );
+    is_deeply( $acts->[2], [ MotionNotify, -1, 100, 0, 50 ], 'corner' );
+    is_deeply( $acts->[3], [ MotionNotify, -1, 100, 50, 50 ], 'last point' );
+    my $total= 0;
+    $total += $_->[4] for @{ path_actions([ [ 0, 0 ], [ 500, 300 ] ], 0, 0, 1000, 60) };
+    is( $total, 1000, 'delays add up to duration' );
+};
+
+subtest bezier => sub {
+    my $acts= path_actions([ [ 0, 0 ], [ 50, 100 ], [ 100, 0 ] ], 1, 0, 100, 20);
+    is_deeply( [ map [ @$_[2,3] ], @$acts ], [ [ 0, 0 ], [ 50, 50 ], [ 100, 0 ] ], 'quadratic curve' );
+};
+
+subtest ease => sub {
+    my @x= map $_->[2], @{ path_actions([ [ 0, 0 ], [ 1000, 0 ] ], 0, 3, 1000, 10) };
+    my @step= map $x[$_] - $x[$_-1], 2 .. $#x;
+    cmp_ok( $step[0], '<', $step[4], 'in_out starts slow' );
+    cmp_ok( $step[-1], '<', $step[4], 'in_out ends slow' );
+    is( $x[-1], 1000, 'ends at last point' );
+    @x= map $_->[2], @{ path_actions([ [ 0, 0 ], [ 1000, 0 ] ], 0, 1, 1000, 10) };
+    cmp_ok( $x[1], '<', 10, 'in starts slow' );
+};
+
+subtest drag_relative => sub {
+    my $acts= path_actions([ [ 10, 10 ], [ 13, 10 ] ], 0, 0, 100, 100, 1, 0, 1);
+    is_deeply( $acts->[0], [ ButtonPress, 1, 0, 0, 0 ], 'button pressed first' );
+    my @moves= @{$acts}[1 .. $#$acts-1];
+    is( scalar @moves, 3, 'repeated pixels skipped' );
+    is_deeply( [ map $_->[2], @moves ], [ 1, 1, 1 ], 'relative offsets' );
+    isnt( $moves[0][0], MotionNotify, 'relative motion type' );
+    is_deeply( $acts->[-1], [ ButtonRelease, 1, 0, 0, 10 ], 'released at end of duration' );
+    my $total= 0;
+    $total += $_->[4] for @$acts;
+    is( $total, 100, 'skipped time carried to later events' );
+};
+
+ok( !eval { X11::Xlib::_pointer_path_actions([], 0, 0, 100, 10); 1 }, 'empty path dies' );
+ok( !eval { X11::Xlib::_pointer_path_actions([[0,0]], 0, 0, 2**31 - 1, 2**31 - 1); 1 }, 'overflowing step count dies' );
+like( $@, qr/exceeds \d+ steps/, '...with a message about the limit' );
+ok( !eval { X11::Xlib::_pointer_path_actions([[0,0]], 0, 0, 2**40, 10); 1 }, 'duration beyond int dies' );
+ok( !eval { X11::Xlib::_pointer_path_actions([[0,0]], 0, 0, 1000, -5); 1 }, 'negative rate dies' );
+
+done_testing;
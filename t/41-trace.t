@@ -0,0 +1,40 @@
+#!/usr/bin/env perl
+
+use strict;
+use warnings;
+use Test::More;
+use JSON::PP;
+
+plan skip_all => "No X11 Server available"
+    unless $ENV{DISPLAY};
+plan tests => 9;
+
+use X11::Xlib;
+
+my $dpy= X11::Xlib->new;
+$dpy->XSync;
+$dpy->trace_enable(16);
+$dpy->XInternAtom("X11_XLIB_TRACE", 0);
+$dpy->flush_sync; my $sync_line= __LINE__;
+eval { $dpy->XGetAtomName() }; # croaks, but is still listed
+my $trace= decode_json($dpy->trace_json);
+my @events= @{ $trace->{traceEvents} };
+is_deeply( [ map $_->{name}, @events ], [qw( XInternAtom XSync XGetAtomName )], 'calls recorded in order' );
+is( $events[0]{ph}, 'X', 'complete events' );
+is( $events[0]{args}{serial_end} - $events[0]{args}{serial_begin}, 1, 'XInternAtom made one request' );
+is( $events[1]{args}{caller}, __FILE__.":$sync_line", 'caller is outside X11::Xlib' );
+cmp_ok( $events[1]{dur}, '>', 0, 'XSync took time' );
+
+$dpy->trace_clear;
+$dpy->XFlush;
+is( scalar @{ decode_json($dpy->trace_json)->{traceEvents} }, 1, 'cleared' );
+$dpy->XFlush for 1..20;
+is( decode_json($dpy->trace_json)->{otherData}{dropped}, 5, 'oldest overwritten' );
+
+$dpy->trace_disable;
+ok( !eval { $dpy->trace_json; 1 }, 'disabled' );
+$dpy->XSync;
+$dpy->trace_enable;
+$dpy->XFlush;
+is_deeply( [ map $_->{name}, @{ decode_json($dpy->trace_json)->{traceEvents} } ], [ 'XFlush' ], 'only calls while enabled' );
+$dpy->trace_disable;
@@ -0,0 +1,37 @@
+#!/usr/bin/env perl
+
+use strict;
+use warnings;
+use Test::More;
+use X11::Xlib qw( :all );
+sub err(&) { my $code= shift; my $ret; { local $@= ''; eval { $code->() }; $ret= $@; } $ret }
+
+plan skip_all => "No X11 Server available"
+    unless $ENV{DISPLAY};
+plan tests => 15;
+
+my $dpy= new_ok( 'X11::Xlib::Display', [], 'connect to X11' );
+my $s= $dpy->screen;
+my $pmap= $dpy->new_pixmap($s->root_window, 64, 64, $s->visual_info->depth);
+
+ok( (my $gc= $dpy->new_gc($pmap, foreground => 1, line_width => 2)), 'new_gc' );
+isa_ok( $gc, 'X11::Xlib::GC' );
+ok( $gc->autofree, 'autofree set' );
+ok( XGetGCValues($dpy, $gc, GCForeground|GCLineWidth, my $values), 'XGetGCValues' );
+is( $values->foreground, 1, 'foreground' );
+is( $values->line_width, 2, 'line_width' );
+is( err{ XChangeGC($dpy, $gc, GCLineWidth, { line_width => 3 }) }, '', 'XChangeGC' );
+
+my @rects= map [ $_, $_, 4, 4 ], 0..59;
+is( err{ XFillRectangles($dpy, $pmap, $gc, \@rects) }, '', 'XFillRectangles arrayref' );
+is( err{ XDrawRectangles($dpy, $pmap, $gc, pack('(s2S2)*', map @$_, @rects)) }, '', 'XDrawRectangles packed' );
+is( err{ XDrawSegments($dpy, $pmap, $gc, [ [0,0,63,63], [63,0,0,63] ]) }, '', 'XDrawSegments' );
+is( err{ XDrawLines($dpy, $pmap, $gc, pack('s*', 0,0, 10,0, 0,10), CoordModePrevious) }, '', 'XDrawLines' );
+is( err{ XFillArcs($dpy, $pmap, $gc, [ [10,10,20,20,0,360*64] ]) }, '', 'XFillArcs' );
+like( err{ XDrawPoints($dpy, $pmap, $gc, "\0\0\0") }, qr/multiple/, 'bad packed length' );
+$dpy->XSync;
+
+XFreeGC($dpy, $gc);
+is( $gc->pointer_int, 0, 'pointer cleared by XFreeGC' );
+undef $gc; # must not free twice
+$dpy->XSync;
@@ -0,0 +1,52 @@
+#!/usr/bin/env perl
+
+use strict;
+use warnings;
+use Config;
+use Test::More;
+
+BEGIN {
+    plan skip_all => "Perl was built without ithreads"
+        unless $Config{useithreads};
+}
+use threads;
+use JSON::PP;
+use X11::Xlib;
+
+plan tests => 6;
+
+# A fake connection is enough to turn tracing on, as long as no calls are made
+# with it.  Freeing it without trace_disable must not leave the functions
+# wrapped, and a thread must be able to call them either way.
+{
+    my $ptr= "\0" x length pack('J', 0);
+    my $fake= bless {}, 'X11::Xlib';
+    X11::Xlib::_set_pointer_value($fake, $ptr);
+    $fake->trace_enable(4);
+    ok( X11::Xlib::_is_an_integer('12'), 'call while tracing' );
+    X11::Xlib::_set_pointer_value($fake, undef);
+}
+my $thread= threads->create(sub { X11::Xlib::_is_an_integer('12')? 'ok' : 'wrong' });
+is( $thread->join, 'ok', 'call in a new thread' );
+ok( X11::Xlib::_is_an_integer('12'), 'call in the parent after the thread' );
+
+# Trace one call of an XSUB from X11::Xlib::Display on a fake display, and
+# return the event.  The wrapper reads the request serial through the
+# pointer, so the 8-byte pointer value is the start of a zeroed buffer.
+sub trace_fake_atom {
+    my $ptr= "\0" x 65536;
+    substr($ptr, length pack('J', 0), length($ptr), '');
+    my $fake= bless {}, 'X11::Xlib';
+    X11::Xlib::_set_pointer_value($fake, $ptr);
+    $fake->trace_enable(4);
+    X11::Xlib::Display::atom($fake);
+    my $events= decode_json($fake->trace_json)->{traceEvents};
+    $fake->trace_disable;
+    X11::Xlib::_set_pointer_value($fake, undef);
+    return $events->[0];
+}
+my $event= trace_fake_atom();
+is( $event->{name}, 'Display::atom', 'XSUB of X11::Xlib::Display traced' );
+my $thread_tid= threads->create(sub { trace_fake_atom()->{tid} })->join;
+ok( defined $thread_tid, 'traced in a thread' );
+isnt( $thread_tid, $event->{tid}, 'thread has its own tid' );
@@ -0,0 +1,74 @@
+#!/usr/bin/env perl
+
+use strict;
+use warnings;
+use Test::More;
+use Try::Tiny;
+use X11::Xlib ':all';
+use FindBin;
+use lib "$FindBin::Bin/lib";
+use X11::SandboxServer;
+
+plan skip_all => "No X11 Server available"
+    unless $ENV{DISPLAY};
+
+plan skip_all => 'Xdamage client lib is not available'
+    unless X11::Xlib->can('XDamageCreate') && X11::Xlib->can('XFixesCreateRegion');
+
+my $x= try { X11::SandboxServer->new(title => $FindBin::Script) };
+plan skip_all => 'Need Xephyr to run Xdamage tests'
+    unless defined $x;
+
+my $display= $x->client;
+plan skip_all => 'Xdamage not supported by server'
+    unless $display->XDamageQueryVersion;
+
+sub err(&) { my $code= shift; my $ret; { local $@= ''; eval { $code->() }; $display->flush_sync; $ret= $@; } $ret }
+
+my ($win, $damage, @pending);
+is( err{ $win= $display->new_window(x => 0, y => 0, width => 64, height => 64) }, '', 'new_window' );
+is( err{ $damage= $display->new_damage($win, XDamageReportRawRectangles) }, '', 'new_damage' );
+isa_ok( $damage, 'X11::Xlib::Damage' );
+
+sub add_damage {
+    for (@_) {
+        my $region= $display->XFixesCreateRegion([
+            X11::Xlib::XRectangle->new(x => $_->[0], y => $_->[1], width => $_->[2], height => $_->[3])
+        ]);
+        $display->XDamageAdd($win, $region);
+    }
+    $display->flush_sync;
+}
+sub take_rects { [ map { [ $_->x, $_->y, $_->width, $_->height ] } $damage->take_rects ] }
+
+# Report overlapping and contained rectangles, which should be merged
+add_damage([ 0, 0, 10, 10 ], [ 2, 2, 4, 4 ], [ 20, 20, 5, 5 ], [ 0, 0, 12, 12 ]);
+
+is( err{ @pending= $display->damage_accumulate }, '', 'damage_accumulate' );
+is_deeply( [ map { $_->xid } @pending ], [ $damage->xid ], 'damage pending for our object' );
+my @got= sort { $a->[0] <=> $b->[0] } map { [ $_->x, $_->y, $_->width, $_->height ] } $damage->take_rects;
+is_deeply( \@got, [ [ 0, 0, 12, 12 ], [ 20, 20, 5, 5 ] ], 'covered rects were merged' )
+    or diag explain \@got;
+is_deeply( [ $damage->take_rects ], [], 'take_rects resets the list' );
+is( err{ $damage->subtract }, '', 'subtract' );
+
+# Partly overlapping damage comes back as the bands of one region
+add_damage([ 0, 0, 10, 10 ], [ 5, 5, 10, 10 ]);
+$display->damage_accumulate;
+is_deeply( take_rects(), [ [ 0, 0, 10, 5 ], [ 0, 5, 15, 5 ], [ 5, 10, 10, 5 ] ], 'overlap merged into one region' );
+
+# Too many separate pieces are reported as their bounding box
+add_damage(map [ $_ * 3, 0, 1, 1 ], 0 .. 39);
+$display->damage_accumulate;
+is_deeply( take_rects(), [ [ 0, 0, 118, 1 ] ], 'bounding box beyond the rect limit' );
+$damage->subtract;
+
+my $ev= X11::Xlib::XEvent->new(type => ($display->XDamageQueryExtension)[0] + XDamageNotify);
+isa_ok( $ev, 'X11::Xlib::XDamageNotifyEvent' );
+$ev->pack({ damage => $damage->xid, area => { x => 1, y => 2, width => 3, height => 4 } });
+is( $ev->damage, $damage->xid, 'event damage field' );
+is( $ev->unpack->{area}->height, 4, 'event area field' );
+like( err{ X11::Xlib::XDamageNotifyEvent::damage(X11::Xlib::XEvent->new(type => KeyPress)) },
+    qr/Can't access XDamageNotifyEvent/, 'damage accessors check the event type' );
+
+done_testing;
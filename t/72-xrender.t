@@ -0,0 +1,43 @@
+#!/usr/bin/env perl
+
+use strict;
+use warnings;
+use Test::More;
+use X11::Xlib ':all';
+
+plan skip_all => "No X11 Server available"
+    unless $ENV{DISPLAY};
+
+plan skip_all => 'Xrender client lib is not available'
+    unless X11::Xlib->can('XRenderCreatePicture');
+
+my $display= X11::Xlib::Display->new;
+plan skip_all => 'Xrender not supported by server'
+    unless $display->XRenderQueryVersion;
+
+sub err(&) { my $code= shift; my $ret; { local $@= ''; eval { $code->() }; $display->flush_sync; $ret= $@; } $ret }
+
+my $argb= $display->XRenderFindStandardFormat(PictStandardARGB32);
+isa_ok( $argb, 'X11::Xlib::XRenderPictFormat', 'ARGB32 format' );
+is( $argb->depth, 32, 'depth 32' );
+
+my $src_pix= $display->new_pixmap($display->root_window, 64, 64, 32);
+my $dst_pix= $display->new_pixmap($display->root_window, 32, 32, 32);
+my ($src, $dst);
+is( err{ $src= $display->new_picture($src_pix, $argb, repeat => RepeatPad) }, '', 'new_picture with attrs' );
+isa_ok( $src, 'X11::Xlib::Picture' );
+is( err{ $dst= $display->new_picture($dst_pix, $argb) }, '', 'new_picture' );
+
+my @rects= map { [ ($_ % 16) * 4, int($_ / 16) * 4, 3, 3 ] } 0..255;
+is( err{ $src->fill_rects(PictOpSrc, { red => 0x8000, alpha => 0x8000 }, \@rects) }, '', 'fill arrayref of rects' );
+is( err{ $src->fill_rects(PictOpOver, { blue => 0xFFFF, alpha => 0xFFFF }, pack('(s2S2)*', map @$_, @rects)) }, '', 'fill packed rects' );
+is( err{ $src->set_transform([ [2,0,0], [0,2,0], [0,0,1] ]) }, '', 'set_transform' );
+is( err{ $src->set_filter('bilinear') }, '', 'set_filter' );
+is( err{ $dst->composite(PictOpOver, $src, None, 0,0, 0,0, 0,0, 32,32) }, '', 'composite' );
+like( err{ $display->XRenderSetPictureTransform($src, [1,2,3]) }, qr/3x3/, 'bad transform' );
+
+undef $src;
+undef $dst;
+is( err{ $display->XSync }, '', 'pictures freed' );
+
+done_testing;
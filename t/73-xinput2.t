@@ -0,0 +1,55 @@
+#!/usr/bin/env perl
+
+use strict;
+use warnings;
+use Test::More;
+use Try::Tiny;
+use X11::Xlib ':all';
+use FindBin;
+use lib "$FindBin::Bin/lib";
+use X11::SandboxServer;
+
+plan skip_all => 'XInput2 client lib is not available'
+    unless X11::Xlib->can('xi2_records');
+
+subtest records => sub {
+    my $raw= pack('L8 d20', XI_RawMotion, 2, 11, 0, 1234, 0, 0b101, 0,
+        (0) x 4, 1.5, 0, -2, (0) x 5, 1, 0, -1, (0) x 5);
+    my $dev= pack('L8 d20', XI_ButtonPress, 2, 11, 1, 1240, 0, 0, 0x400001,
+        10, 20, 110, 120, (0) x 16);
+    my @ev= X11::Xlib::xi2_records($raw . $dev);
+    is( scalar @ev, 2, 'two records' );
+    is_deeply( $ev[0], { evtype => XI_RawMotion, deviceid => 2, sourceid => 11, detail => 0,
+        time => 1234, flags => 0, valuators => { 0 => 1.5, 2 => -2 }, raw_values => { 0 => 1, 2 => -1 } },
+        'raw event' ) or diag explain $ev[0];
+    is_deeply( $ev[1], { evtype => XI_ButtonPress, deviceid => 2, sourceid => 11, detail => 1,
+        time => 1240, flags => 0, window => 0x400001, event_x => 10, event_y => 20,
+        root_x => 110, root_y => 120, valuators => {} },
+        'device event' ) or diag explain $ev[1];
+    is_deeply( [ X11::Xlib::xi2_records('') ], [], 'empty' );
+    ok( !eval { X11::Xlib::xi2_records('x'); 1 }, 'croak on partial record' );
+};
+
+SKIP: {
+    skip 'No X11 Server available', 1 unless $ENV{DISPLAY};
+    my $x= try { X11::SandboxServer->new(title => $FindBin::Script) };
+    skip 'Need Xephyr to run XInput2 tests', 1 unless defined $x;
+    my $display= $x->client;
+    skip 'XInput2 not supported by server', 1 unless $display->XIQueryVersion(2, 0);
+    subtest server => sub {
+        my @dev= $display->XIQueryDevice(XIAllMasterDevices);
+        ok( (grep { $_->{use} == XIMasterPointer } @dev), 'found master pointer' )
+            or diag explain \@dev;
+        $display->XISelectEvents($display->root_window, { XIAllMasterDevices() => [ XI_RawMotion ] });
+        $display->fake_motion(0, 10, 10);
+        $display->fake_motion(0, 20, 25);
+        $display->flush_sync;
+        my @ev= X11::Xlib::xi2_records($display->xi2_drain);
+        ok( scalar @ev, 'got raw motion' );
+        is( $ev[0]{evtype}, XI_RawMotion, 'evtype' ) if @ev;
+        is( length $display->xi2_drain, 0, 'queue drained' );
+        done_testing;
+    };
+}
+
+done_testing;
@@ -7,8 +7,9 @@ use Try::Tiny;
 =head1 DESCRIPTION
 
 This module attempts to create a child process X server, primarily for testing
-purposes.  Right now it only checks for Xephyr, but I'd like to expand it to
-support others like Xnest or Xdmx or Xvfb.
+purposes.  It uses Xephyr if available, else Xvfb (which has no window, and is
+what the benchmarks in bench/ prefer).  Pass C<< program => 'Xvfb' >> to pick
+one.  I'd like to expand it to support others like Xnest or Xdmx.
 
 This may eventually be officially published with this package, or made into
 its own package.
@@ -24,14 +25,20 @@ sub host_programs {
                 class => 'X11::SandboxServer::Xephyr'
             },
         }
+        if (`Xvfb -help 2>&1`) {
+            $progs{Xvfb}= {
+                class => 'X11::SandboxServer::Xvfb'
+            },
+        }
         \%progs;
     };
 }
 
 sub new {
     my ($class, %attrs)= @_;
-    my $prog= host_programs->{Xephyr}
-        || croak("No sandboxing Xserver program is available");
+    my $prog= $attrs{program}? host_programs->{$attrs{program}}
+        : host_programs->{Xephyr} || host_programs->{Xvfb};
+    $prog or croak("No sandboxing Xserver program is available");
     $prog->{class}->new(%attrs);
 }
 
@@ -53,9 +60,16 @@ use POSIX ":sys_wait_h";
 sub new {
     my ($class, %attrs)= @_;
     my $title= $attrs{title};
+    $class->_spawn(Xephyr => ($title? (-title => $title) : ()));
+}
+
+# Start the server program on the first display number that works, and
+# connect to it.  Extra arguments go after the display number.
+sub _spawn {
+    my ($class, $program, @args)= @_;
     # No good way to determine which display numbers are free, when other
     # test cases might be running in parallel, so just iterate 10 times and give up.
-    my ($dpy, $pid);
+    my ($dpy, $pid, $connect);
     for my $disp_num (1..11) {
         # Can't find any way to start it and connect without a race condition.
         # Some other server could be occupting the display number, and then Xephyr
@@ -66,36 +80,57 @@ sub new {
         $pid= fork();
         defined $pid or die "fork: $!";
         unless ($pid) {
-            exec("Xephyr", ":$disp_num", ($title? (-title => $title) : ()) );
-            warn("exec(Xephyr): $!");
+            exec($program, ":$disp_num", @args);
+            warn("exec($program): $!");
             exec($^X, '-e', 'die "exec failed"'); # attempt to end process abruptly
             exit(2); # This could run perl cleanup code that breaks things, but oh well...
         }
         sleep 1;
         next if (waitpid($pid, WNOHANG) == $pid);
 
-        $dpy= try { X11::Xlib->new(connect => ":$disp_num") }
+        $connect= ":$disp_num";
+        $dpy= try { X11::Xlib->new(connect => $connect) }
             and last;
 
         kill TERM => $pid;
         waitpid($pid, 0) > 0 or die "waitpid: $!";
     }
-    defined $dpy or croak("Can't start and connect to Xephyr");
+    defined $dpy or croak("Can't start and connect to $program");
     
-    return bless { display => $dpy, pid => $pid }, $class;
+    return bless { display => $dpy, pid => $pid, program => $program, connect => $connect }, $class;
 }
 
 sub client {
     shift->{display}
 }
 
+sub program {
+    shift->{program}
+}
+
+sub connect_string {
+    shift->{connect}
+}
+
 sub close {
     my $self= shift;
-    my $dpy= delete $self->{display};
+    my $dpy= delete $self->{display}
+        or return;
     $dpy->XCloseDisplay;
     my $pid= delete $self->{pid};
     kill TERM => $pid;
     waitpid($pid, 0) > 0 or die "waitpid: $!";
 }
 
+package X11::SandboxServer::Xvfb;
+@X11::SandboxServer::Xvfb::ISA= 'X11::SandboxServer::Xephyr';
+use strict;
+use warnings;
+
+sub new {
+    my ($class, %attrs)= @_;
+    my $screen= $attrs{screen} || '1280x1024x24';
+    $class->_spawn(Xvfb => -screen => 0, $screen, -nolisten => 'tcp');
+}
+
 1;
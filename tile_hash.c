@@ -0,0 +1,166 @@
+/* Tile hashing for change detection between successive captures of an image.
+ *
+ * This file is included by PerlXlib.c after pixel_convert.c, and shares its
+ * CPU detection.
+ *
+ * Each tile is hashed by running the bytes of each of its rows through four
+ * 64-bit accumulator lanes, 32 bytes (one "stripe") at a time, with a short
+ * stripe at the end of a row zero-padded.  The key mixed into each stripe
+ * depends on the stripe's position in the tile, so moving rows around inside
+ * a tile changes the hash.  The SSE2 and AVX2 versions compute exactly the
+ * same values as the scalar one.
+ */
+
+#define TILEHASH_STEP 0x9E3779B97F4A7C15ULL
+
+static const uint64_t tilehash_key[4]= {
+    0xC2B2AE3D27D4EB4FULL, 0x165667B19E3779F9ULL, 0x85EBCA77C2B2AE63ULL, 0x27D4EB2F165667C5ULL
+};
+
+typedef void tilehash_rows_fn(const U8 *src, size_t stride, size_t row_bytes, int rows, uint64_t acc[4]);
+
+static uint64_t tilehash_load64(const U8 *p) {
+    uint64_t v;
+    memcpy(&v, p, 8);
+    return v;
+}
+
+static void tilehash_rows_scalar(const U8 *src, size_t stride, size_t row_bytes, int rows, uint64_t acc[4]) {
+    uint64_t key[4], d, dk;
+    U8 tail[32];
+    const U8 *p;
+    size_t off;
+    int y, i;
+    for (i= 0; i < 4; i++) key[i]= tilehash_key[i];
+    for (y= 0; y < rows; y++, src+= stride) {
+        for (off= 0; off < row_bytes; off+= 32) {
+            p= src + off;
+            if (row_bytes - off < 32) {
+                memset(tail, 0, 32);
+                memcpy(tail, p, row_bytes - off);
+                p= tail;
+            }
+            for (i= 0; i < 4; i++) {
+                d= tilehash_load64(p + i*8);
+                dk= d ^ key[i];
+                acc[i] += d + (dk & 0xFFFFFFFF) * (dk >> 32);
+                key[i] += TILEHASH_STEP;
+            }
+        }
+    }
+}
+
+#ifdef PERLXLIB_PIXCONV_X86
+
+__attribute__((target("sse2")))
+static void tilehash_rows_sse2(const U8 *src, size_t stride, size_t row_bytes, int rows, uint64_t acc[4]) {
+    __m128i acc0= _mm_loadu_si128((const __m128i*) acc), acc1= _mm_loadu_si128((const __m128i*)(acc+2));
+    __m128i key0= _mm_loadu_si128((const __m128i*) tilehash_key), key1= _mm_loadu_si128((const __m128i*)(tilehash_key+2));
+    const __m128i step= _mm_set1_epi64x((long long) TILEHASH_STEP);
+    __m128i d0, d1, k0, k1;
+    U8 tail[32];
+    const U8 *p;
+    size_t off;
+    int y;
+    for (y= 0; y < rows; y++, src+= stride) {
+        for (off= 0; off < row_bytes; off+= 32) {
+            p= src + off;
+            if (row_bytes - off < 32) {
+                memset(tail, 0, 32);
+                memcpy(tail, p, row_bytes - off);
+                p= tail;
+            }
+            d0= _mm_loadu_si128((const __m128i*) p);
+            d1= _mm_loadu_si128((const __m128i*)(p+16));
+            k0= _mm_xor_si128(d0, key0);
+            k1= _mm_xor_si128(d1, key1);
+            acc0= _mm_add_epi64(acc0, _mm_add_epi64(d0, _mm_mul_epu32(k0, _mm_srli_epi64(k0, 32))));
+            acc1= _mm_add_epi64(acc1, _mm_add_epi64(d1, _mm_mul_epu32(k1, _mm_srli_epi64(k1, 32))));
+            key0= _mm_add_epi64(key0, step);
+            key1= _mm_add_epi64(key1, step);
+        }
+    }
+    _mm_storeu_si128((__m128i*) acc, acc0);
+    _mm_storeu_si128((__m128i*)(acc+2), acc1);
+}
+
+__attribute__((target("avx2")))
+static void tilehash_rows_avx2(const U8 *src, size_t stride, size_t row_bytes, int rows, uint64_t acc[4]) {
+    __m256i accv= _mm256_loadu_si256((const __m256i*) acc);
+    __m256i key= _mm256_loadu_si256((const __m256i*) tilehash_key);
+    const __m256i step= _mm256_set1_epi64x((long long) TILEHASH_STEP);
+    __m256i d, k;
+    U8 tail[32];
+    const U8 *p;
+    size_t off;
+    int y;
+    for (y= 0; y < rows; y++, src+= stride) {
+        for (off= 0; off < row_bytes; off+= 32) {
+            p= src + off;
+            if (row_bytes - off < 32) {
+                memset(tail, 0, 32);
+                memcpy(tail, p, row_bytes - off);
+                p= tail;
+            }
+            d= _mm256_loadu_si256((const __m256i*) p);
+            k= _mm256_xor_si256(d, key);
+            accv= _mm256_add_epi64(accv, _mm256_add_epi64(d, _mm256_mul_epu32(k, _mm256_srli_epi64(k, 32))));
+            key= _mm256_add_epi64(key, step);
+        }
+    }
+    _mm256_storeu_si256((__m256i*) acc, accv);
+}
+
+#endif /* PERLXLIB_PIXCONV_X86 */
+
+static uint64_t tilehash_rotl(uint64_t v, int n) {
+    return (v << n) | (v >> (64 - n));
+}
+
+static uint64_t tilehash_finish(uint64_t acc[4], size_t len) {
+    uint64_t h= len * TILEHASH_STEP;
+    h ^= acc[0] ^ tilehash_rotl(acc[1], 17) ^ tilehash_rotl(acc[2], 31) ^ tilehash_rotl(acc[3], 47);
+    h ^= h >> 33; h *= 0xFF51AFD7ED558CCDULL;
+    h ^= h >> 33; h *= 0xC4CEB9FE1A85EC53ULL;
+    h ^= h >> 33;
+    return h;
+}
+
+/* Hash every tile of an image into 'hashes' (row-major, columns * rows entries)
+ * and set 'changed' (if given) to 1 for each tile whose hash differs from the
+ * value previously in 'hashes'.  Returns the number of changed tiles.
+ */
+size_t PerlXlib_tile_hash_diff(const char *src, size_t stride, int width, int height, int bytes_per_pixel,
+    int tile_width, int tile_height, uint64_t *hashes, U8 *changed
+) {
+    tilehash_rows_fn *rows_fn= &tilehash_rows_scalar;
+    int cols= (width + tile_width - 1) / tile_width, rows= (height + tile_height - 1) / tile_height;
+    int tx, ty, tw, th, level= PerlXlib_pixconv_level(-1);
+    uint64_t acc[4], h;
+    size_t n_changed= 0, t;
+
+    #ifdef PERLXLIB_PIXCONV_X86
+    if (level >= PerlXlib_PIXCONV_AVX2) rows_fn= &tilehash_rows_avx2;
+    else if (level >= PerlXlib_PIXCONV_SSE2) rows_fn= &tilehash_rows_sse2;
+    #endif
+    for (ty= 0; ty < rows; ty++) {
+        th= height - ty * tile_height;
+        if (th > tile_height) th= tile_height;
+        for (tx= 0; tx < cols; tx++) {
+            tw= width - tx * tile_width;
+            if (tw > tile_width) tw= tile_width;
+            acc[0]= acc[1]= acc[2]= acc[3]= 0;
+            rows_fn((const U8*) src + ty * tile_height * stride + (size_t) tx * tile_width * bytes_per_pixel,
+                stride, (size_t) tw * bytes_per_pixel, th, acc);
+            h= tilehash_finish(acc, (size_t) tw * bytes_per_pixel * th);
+            t= (size_t) ty * cols + tx;
+            if (hashes[t] != h) {
+                hashes[t]= h;
+                ++n_changed;
+                if (changed) changed[t]= 1;
+            }
+            else if (changed) changed[t]= 0;
+        }
+    }
+    return n_changed;
+}
@@ -7,7 +7,7 @@ $keysym_def_h && -f $keysym_def_h
     or die "Missing required argument DEF_H (i.e. /usr/include/X11/keysymdefs.h)";
 
 open my $fh, "<", $keysym_def_h or die "open: $!";
-my @keysym;
+my (@keysym, @codepoint);
 # Control chars
 $keysym[0xFF00+$_]= $_ for 0x08, 0x09, 0x0A, 0x0B, 0x0D, 0x1B;
 # Num Keypad
@@ -19,74 +19,79 @@ while (<$fh>) {
         next if ($sym >= 0x20 && $sym < 0x7F) # Don't need the table
                 or ($sym >= 0xA0 && $sym <= 0xFF)
                 or (($sym & 0xFF000000) == 0x01000000); # These don't need the table
-        die "Codepoint above 0x7FFF" if $codepoint > 0x7FFF;
+        die sprintf("KeySym 0x%X above 0xFFFF", $sym) if $sym > 0xFFFF;
+        die sprintf("Codepoint U+%X above 0xFFFF", $codepoint) if $codepoint > 0xFFFF;
         $keysym[$sym]= $codepoint;
     }
 }
+# Mappings corrected in newer keysymdef.h, so the output doesn't depend on
+# which version of the header it was generated from.
+$keysym[0x0ABC]= 0x27E8; # leftanglebracket
+$keysym[0x0ABE]= 0x27E9; # rightanglebracket
 
-# Identify consecutive ranges in the keysym table
-my @ranges;
-my $range_start= undef;
-my $offset= 0;
-for (my $i= 0; $i <= @keysym; $i++) {
-    if (defined $keysym[$i] && !defined $range_start) {
-        $range_start= $i;
-        # ignore small gaps in the table
-        if (@ranges && $ranges[-1][1]+4 > $i) {
-            ($range_start, undef, $offset)= @{ pop @ranges };
-        }
-    } elsif (!defined $keysym[$i] && defined $range_start) {
-        push @ranges, [ $range_start, $i, $offset ];
-        $offset += $i - $range_start;
-        $range_start= undef;
-    }
+# Reverse direction: the lowest legacy KeySym for each codepoint, but never a
+# keypad KeySym, since those are a different key than the plain character.
+for (my $sym= $#keysym; $sym > 0; $sym--) {
+    next unless defined $keysym[$sym];
+    next if $sym >= 0xFF80 && $sym <= 0xFFBD;
+    $codepoint[$keysym[$sym]]= $sym;
 }
 
-# Build binary search "if" tree of ranges
-sub detect_ranges {
-    my ($indent, $start_checked, @r)= @_;
-    if (@r > 2) {
-        # compare on start of mid, then recurse
-        my $mid= @r / 2;
-        return $indent . sprintf("if (keysym < 0x%04X) {\n", $r[$mid][0])
-            . detect_ranges("$indent  ", $start_checked, @r[0..$mid-1])
-            . $indent . "} else {\n"
-            . detect_ranges("$indent  ", 1, @r[$mid..$#r])
-            . $indent . "}\n";
-    } else {
-        my $ret= $indent . "if (".($start_checked? "":sprintf("keysym >= 0x%04X && ", $r[0][0]))
-            .sprintf("keysym < 0x%04X) {", $r[0][1])
-            ." return symtab[keysym - $r[0][0] + $r[0][2] ]; }\n";
-        $ret .= $indent . sprintf("if (keysym >= 0x%04X && keysym < 0x%04X) {", $r[1][0], $r[1][1])
-            ." return symtab[keysym - $r[1][0] + $r[1][2] ]; }\n"
-            if @r > 1;
-        return $ret;
+# Split a sparse 16-bit table into 256-entry pages, sharing one all-zero page
+# for every high byte that has no entries.
+sub paged_table {
+    my ($name, $comment, $table)= @_;
+    my @page_of= (0) x 256;
+    my @pages= ( [ (0) x 256 ] );
+    for my $hi (0..255) {
+        my @page= map { $table->[$hi * 256 + $_] || 0 } 0..255;
+        next unless grep $_, @page;
+        $page_of[$hi]= scalar @pages;
+        push @pages, \@page;
+    }
+    die "Too many pages for $name" if @pages > 256;
+    my $out= "/* $comment: ${name}_tab[${name}_page[x >> 8]][x & 0xFF] */\n"
+        . "static const unsigned char ${name}_page[256]= {\n";
+    $out .= '  ' . join(',', map sprintf('%2d', $_), @page_of[$_*16 .. $_*16+15]) . ",\n" for 0..15;
+    substr($out, -2)= "\n};\n";
+    $out .= "static const unsigned short ${name}_tab[".scalar(@pages)."][256]= {\n";
+    for my $p (0..$#pages) {
+        my ($hi)= grep { $page_of[$_] == $p } 0..255;
+        $out .= $p? sprintf("  { /* 0x%02X00 */\n", $hi) : "  { /* empty */\n";
+        $out .= '    ' . join(',', map sprintf('0x%04X', $_), @{$pages[$p]}[$_*8 .. $_*8+7]) . ",\n" for 0..31;
+        substr($out, -2)= "\n  },\n";
     }
+    substr($out, -2)= "\n};\n";
+    return $out;
 }
 
-my $table_values= '';
-for (@ranges) {
-    my ($begin, $end)= @$_;
-    --$end;
-    $table_values .= join '',
-        sprintf("  /* 0x%04X - 0x%04X */\n", $begin, $end),
-        '  ', (map { defined $_? sprintf("0x%04X,", $_) : "-1," } @keysym[$begin..$end]),
-        "\n";
-}
-substr($table_values, -2)= '';
-my $if_tree= detect_ranges("    ", 0, @ranges);
+my $keysym_tab= paged_table('keysym_cp', 'Codepoint of each legacy KeySym below 0x10000, or 0', \@keysym);
+my $codepoint_tab= paged_table('cp_keysym', 'Legacy KeySym of each codepoint below 0x10000, or 0', \@codepoint);
 print <<"@";
-static short symtab[]= {
-$table_values
-};
+/* Generated by util/gen_keysym_codepoint.pl from keysymdef.h */
+
+$keysym_tab
+$codepoint_tab
 int PerlXlib_keysym_to_codepoint(KeySym keysym) {
+    int codepoint;
     /* If Latin-1 or direct-to-unicode, skip table lookup */
     if ((keysym >= 0x0020 && keysym <= 0x007e) ||
         (keysym >= 0x00a0 && keysym <= 0x00ff))
         return keysym;
     if ((keysym & 0xff000000) == 0x01000000)
         return keysym & 0x00ffffff;
-$if_tree
-    return -1;
+    if (keysym > 0xFFFF)
+        return -1;
+    codepoint= keysym_cp_tab[keysym_cp_page[keysym >> 8]][keysym & 0xFF];
+    return codepoint? codepoint : -1;
+}
+
+KeySym PerlXlib_codepoint_to_legacy_keysym(int codepoint) {
+    /* Latin-1 is identical */
+    if ((codepoint >= 0x0020 && codepoint <= 0x007E) || (codepoint >= 0x00A0 && codepoint <= 0x00FF))
+        return codepoint;
+    if (codepoint < 0 || codepoint > 0xFFFF)
+        return NoSymbol;
+    return cp_keysym_tab[cp_keysym_page[codepoint >> 8]][codepoint & 0xFF];
 }
 @
@@ -368,7 +368,7 @@ const char* PerlXlib_xevent_pkg_for_type(int type) {
     $c .= qq{  case $_: return "X11::Xlib::$type_to_struct{$_}";\n}
         for sort keys %type_to_struct;
     $c .= <<"@";
-  default: return "X11::Xlib::XEvent";
+  default: return PerlXlib_xevent_ext_pkg_for_type(type);
   }
 }
 
@@ -432,7 +432,8 @@ void PerlXlib_${goal}_pack($goal *s, HV *fields, Bool consume) {
 
     $c .= <<"@";
     default:
-      warn("Unknown ${goal} type %d", s->type);
+      if (!PerlXlib_xevent_ext_pack(s, fields, consume))
+        warn("Unknown ${goal} type %d", s->type);
     }
 }
 @
@@ -481,7 +482,8 @@ void PerlXlib_${goal}_unpack($goal *s, HV *fields) {
 
     $c .= <<"@";
     default:
-      warn("Unknown ${goal} type %d", s->type);
+      if (!PerlXlib_xevent_ext_unpack(s, fields))
+        warn("Unknown ${goal} type %d", s->type);
     }
     return;
     store_fail:
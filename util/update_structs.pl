@@ -8,4 +8,8 @@ $d/generate_struct_xs.pl XWindowAttributes < /usr/include/X11/Xlib.h
 $d/generate_struct_xs.pl XSetWindowAttributes < /usr/include/X11/Xlib.h
 $d/generate_struct_xs.pl XRectangle < /usr/include/X11/Xlib.h
 $d/generate_struct_xs.pl XRenderPictFormat < /usr/include/X11/extensions/Xrender.h
+$d/generate_struct_xs.pl XGCValues < /usr/include/X11/Xlib.h
+$d/generate_struct_xs.pl XRenderPictureAttributes < /usr/include/X11/extensions/Xrender.h
+$d/generate_struct_xs.pl XRenderColor < /usr/include/X11/extensions/Xrender.h
+$d/generate_struct_xs.pl XGlyphInfo < /usr/include/X11/extensions/Xrender.h
 echo done
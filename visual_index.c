@@ -0,0 +1,167 @@
+/* Per-display index of XVisualInfo, for X11::Xlib::Display's visual methods.
+ *
+ * This file is included by PerlXlib.c
+ *
+ * The full list from XGetVisualInfo is copied once into a PV stored in the
+ * Display object's hash, followed by three permutations of it: sorted by
+ * visualid, by (screen, depth, class), and by (red_mask, green_mask,
+ * blue_mask).  Each sort is stable, so equal keys keep the order Xlib
+ * returned them in, which is the same order XMatchVisualInfo searches.
+ * Visuals never change for the life of a connection, so the index is never
+ * rebuilt.
+ */
+
+typedef struct PerlXlib_visual_index {
+    int count, pad;
+    /* followed by XVisualInfo infos[count], U32 by_id[count], by_sdc[count], by_rgb[count] */
+} PerlXlib_visual_index;
+
+#define VISIDX_INFOS(vi)  ((XVisualInfo*) ((vi) + 1))
+#define VISIDX_BY_ID(vi)  ((U32*) (VISIDX_INFOS(vi) + (vi)->count))
+#define VISIDX_BY_SDC(vi) (VISIDX_BY_ID(vi) + (vi)->count)
+#define VISIDX_BY_RGB(vi) (VISIDX_BY_SDC(vi) + (vi)->count)
+
+/* Compare the first 'nkeys' fields of one of the sort orders */
+static int visidx_cmp(const XVisualInfo *a, const XVisualInfo *b, int order, int nkeys) {
+#define VISIDX_CMP_FIELD(f) if (a->f != b->f) return a->f < b->f? -1 : 1;
+    if (order == 0) {
+        VISIDX_CMP_FIELD(visualid)
+    } else if (order == 1) {
+        VISIDX_CMP_FIELD(screen)
+        if (nkeys > 1) { VISIDX_CMP_FIELD(depth) }
+        if (nkeys > 2) { VISIDX_CMP_FIELD(class) }
+    } else {
+        VISIDX_CMP_FIELD(red_mask)
+        VISIDX_CMP_FIELD(green_mask)
+        VISIDX_CMP_FIELD(blue_mask)
+    }
+#undef VISIDX_CMP_FIELD
+    return 0;
+}
+
+/* Stable insertion sort of indices; there are rarely more than a few hundred visuals */
+static void visidx_sort(const XVisualInfo *infos, U32 *idx, int n, int order) {
+    int i, j;
+    U32 tmp;
+    for (i= 0; i < n; i++) idx[i]= i;
+    for (i= 1; i < n; i++) {
+        tmp= idx[i];
+        for (j= i; j > 0 && visidx_cmp(infos + idx[j-1], infos + tmp, order, 3) > 0; j--)
+            idx[j]= idx[j-1];
+        idx[j]= tmp;
+    }
+}
+
+/* Find the range [*lo, *hi) of 'idx' whose first nkeys fields equal those of tpl */
+static void visidx_range(const XVisualInfo *infos, const U32 *idx, int n, int order, int nkeys,
+    const XVisualInfo *tpl, int *lo, int *hi
+) {
+    int a= 0, b= n, mid;
+    while (a < b) {
+        mid= (a + b) / 2;
+        if (visidx_cmp(infos + idx[mid], tpl, order, nkeys) < 0) a= mid + 1;
+        else b= mid;
+    }
+    *lo= a;
+    b= n;
+    while (a < b) {
+        mid= (a + b) / 2;
+        if (visidx_cmp(infos + idx[mid], tpl, order, nkeys) <= 0) a= mid + 1;
+        else b= mid;
+    }
+    *hi= a;
+}
+
+/* Return the index for a display object, building it on first use */
+static PerlXlib_visual_index* visidx_get(SV *dpy_obj) {
+    Display *dpy= PerlXlib_display_objref_get_pointer(dpy_obj, OR_DIE);
+    PerlXlib_visual_index *vi;
+    XVisualInfo tpl, *list;
+    SV **ent;
+    int n= 0;
+    size_t size;
+    if (!SvROK(dpy_obj) || SvTYPE(SvRV(dpy_obj)) != SVt_PVHV)
+        croak("Expected X11::Xlib display object");
+    ent= hv_fetch((HV*) SvRV(dpy_obj), "_visual_index", 13, 1);
+    if (!ent) croak("Can't store _visual_index");
+    if (SvPOK(*ent) && SvCUR(*ent) >= sizeof(PerlXlib_visual_index))
+        return (PerlXlib_visual_index*) SvPVX(*ent);
+
+    memset(&tpl, 0, sizeof(tpl));
+    list= XGetVisualInfo(dpy, VisualNoMask, &tpl, &n);
+    if (!list) n= 0;
+    size= sizeof(PerlXlib_visual_index) + n * (sizeof(XVisualInfo) + 3 * sizeof(U32));
+    sv_setpvn(*ent, "", 0);
+    vi= (PerlXlib_visual_index*) SvGROW(*ent, size + 1);
+    SvCUR_set(*ent, size);
+    vi->count= n;
+    vi->pad= 0;
+    if (n) memcpy(VISIDX_INFOS(vi), list, n * sizeof(XVisualInfo));
+    if (list) XFree(list);
+    visidx_sort(VISIDX_INFOS(vi), VISIDX_BY_ID(vi),  n, 0);
+    visidx_sort(VISIDX_INFOS(vi), VISIDX_BY_SDC(vi), n, 1);
+    visidx_sort(VISIDX_INFOS(vi), VISIDX_BY_RGB(vi), n, 2);
+    return vi;
+}
+
+/* Number of visuals in the index, and a pointer to the first */
+const XVisualInfo* PerlXlib_visual_index_list(SV *dpy_obj, int *count) {
+    PerlXlib_visual_index *vi= visidx_get(dpy_obj);
+    *count= vi->count;
+    return VISIDX_INFOS(vi);
+}
+
+/* Find the XVisualInfo for a visualid, or NULL */
+const XVisualInfo* PerlXlib_visual_index_by_id(SV *dpy_obj, VisualID id) {
+    PerlXlib_visual_index *vi= visidx_get(dpy_obj);
+    XVisualInfo tpl;
+    int lo, hi;
+    tpl.visualid= id;
+    visidx_range(VISIDX_INFOS(vi), VISIDX_BY_ID(vi), vi->count, 0, 1, &tpl, &lo, &hi);
+    return lo < hi? VISIDX_INFOS(vi) + VISIDX_BY_ID(vi)[lo] : NULL;
+}
+
+/* Find the XVisualInfo for a Visual*, or NULL.  Doesn't allocate anything. */
+const XVisualInfo* PerlXlib_visual_index_for_visual(SV *dpy_obj, Visual *vis) {
+    return vis? PerlXlib_visual_index_by_id(dpy_obj, XVisualIDFromVisual(vis)) : NULL;
+}
+
+/* Same as XGetVisualInfo, but writes the positions (within
+ * PerlXlib_visual_index_list) of the matching visuals to 'out', which must have
+ * room for all of them, and returns the number found.
+ */
+int PerlXlib_visual_index_search(SV *dpy_obj, long mask, const XVisualInfo *tpl, int *out) {
+    PerlXlib_visual_index *vi= visidx_get(dpy_obj);
+    const XVisualInfo *infos= VISIDX_INFOS(vi), *v;
+    const U32 *idx= NULL;
+    int lo= 0, hi= vi->count, i, j, n= 0, tmp;
+
+    /* narrow down the candidates with whichever index fits the mask */
+    if (mask & VisualIDMask)
+        visidx_range(infos, idx= VISIDX_BY_ID(vi), vi->count, 0, 1, tpl, &lo, &hi);
+    else if (mask & VisualScreenMask)
+        visidx_range(infos, idx= VISIDX_BY_SDC(vi), vi->count, 1,
+            !(mask & VisualDepthMask)? 1 : !(mask & VisualClassMask)? 2 : 3, tpl, &lo, &hi);
+    else if ((mask & (VisualRedMaskMask|VisualGreenMaskMask|VisualBlueMaskMask))
+        == (VisualRedMaskMask|VisualGreenMaskMask|VisualBlueMaskMask))
+        visidx_range(infos, idx= VISIDX_BY_RGB(vi), vi->count, 2, 3, tpl, &lo, &hi);
+
+    for (i= lo; i < hi; i++) {
+        v= infos + (idx? idx[i] : i);
+        if ((mask & VisualIDMask)           && v->visualid != tpl->visualid) continue;
+        if ((mask & VisualScreenMask)       && v->screen != tpl->screen) continue;
+        if ((mask & VisualDepthMask)        && v->depth != tpl->depth) continue;
+        if ((mask & VisualClassMask)        && v->class != tpl->class) continue;
+        if ((mask & VisualRedMaskMask)      && v->red_mask != tpl->red_mask) continue;
+        if ((mask & VisualGreenMaskMask)    && v->green_mask != tpl->green_mask) continue;
+        if ((mask & VisualBlueMaskMask)     && v->blue_mask != tpl->blue_mask) continue;
+        if ((mask & VisualColormapSizeMask) && v->colormap_size != tpl->colormap_size) continue;
+        if ((mask & VisualBitsPerRGBMask)   && v->bits_per_rgb != tpl->bits_per_rgb) continue;
+        /* keep the results in Xlib's order */
+        tmp= v - infos;
+        for (j= n++; j > 0 && out[j-1] > tmp; j--)
+            out[j]= out[j-1];
+        out[j]= tmp;
+    }
+    return n;
+}
@@ -0,0 +1,75 @@
+/* XInput2 events as fixed-size records, for X11::Xlib::xi2_drain.
+ *
+ * This file is included by PerlXlib.c
+ *
+ * The cookie data of a device event (XIDeviceEvent) or raw event (XIRawEvent)
+ * is copied into a PerlXlib_xi2_record, with the first PerlXlib_XI2_VALUATORS
+ * valuators at fixed positions instead of packed by mask, so a batch of
+ * events is one string that Perl can unpack without an object per event.
+ */
+
+/* True for the event types PerlXlib_xi2_decode understands */
+int PerlXlib_xi2_is_record_type(int evtype) {
+    switch (evtype) {
+    case XI_KeyPress: case XI_KeyRelease: case XI_ButtonPress: case XI_ButtonRelease: case XI_Motion:
+    case XI_RawKeyPress: case XI_RawKeyRelease: case XI_RawButtonPress: case XI_RawButtonRelease: case XI_RawMotion:
+#ifdef XI_TouchBegin
+    case XI_TouchBegin: case XI_TouchUpdate: case XI_TouchEnd:
+    case XI_RawTouchBegin: case XI_RawTouchUpdate: case XI_RawTouchEnd:
+#endif
+        return 1;
+    }
+    return 0;
+}
+
+/* Spread the mask-packed valuator values to their positions in the record */
+static void xi2_valuators(const XIValuatorState *vs, const double *raw, PerlXlib_xi2_record *rec) {
+    int i, n= 0;
+    for (i= 0; i < vs->mask_len * 8 && i < PerlXlib_XI2_VALUATORS; i++) {
+        if (!XIMaskIsSet(vs->mask, i)) continue;
+        rec->valuator_mask |= 1 << i;
+        rec->values[i]= vs->values[n];
+        if (raw) rec->raw_values[i]= raw[n];
+        n++;
+    }
+}
+
+/* Fill a record from the data of a cookie that XGetEventData has fetched.
+ * Returns 0 if the event isn't a device or raw event.
+ */
+int PerlXlib_xi2_decode(const XGenericEventCookie *cookie, PerlXlib_xi2_record *rec) {
+    const XIDeviceEvent *dev;
+    const XIRawEvent *raw;
+    if (!cookie->data || !PerlXlib_xi2_is_record_type(cookie->evtype))
+        return 0;
+    memset(rec, 0, sizeof(*rec));
+    rec->evtype= cookie->evtype;
+    switch (cookie->evtype) {
+    case XI_RawKeyPress: case XI_RawKeyRelease: case XI_RawButtonPress: case XI_RawButtonRelease: case XI_RawMotion:
+#ifdef XI_RawTouchBegin
+    case XI_RawTouchBegin: case XI_RawTouchUpdate: case XI_RawTouchEnd:
+#endif
+        raw= (const XIRawEvent*) cookie->data;
+        rec->deviceid= raw->deviceid;
+        rec->sourceid= raw->sourceid;
+        rec->detail=   raw->detail;
+        rec->time=     raw->time;
+        rec->flags=    raw->flags;
+        xi2_valuators(&raw->valuators, raw->raw_values, rec);
+        break;
+    default:
+        dev= (const XIDeviceEvent*) cookie->data;
+        rec->deviceid= dev->deviceid;
+        rec->sourceid= dev->sourceid;
+        rec->detail=   dev->detail;
+        rec->time=     dev->time;
+        rec->flags=    dev->flags;
+        rec->window=   dev->event;
+        rec->event_x=  dev->event_x;
+        rec->event_y=  dev->event_y;
+        rec->root_x=   dev->root_x;
+        rec->root_y=   dev->root_y;
+        xi2_valuators(&dev->valuators, NULL, rec);
+    }
+    return 1;
+}
@@ -0,0 +1,393 @@
+/* XKB keymaps for X11::Xlib::Keymap.
+ *
+ * This file is included by PerlXlib.c
+ *
+ * XkbGetMap fetches the key types, KeySyms and per-key modifiers in one
+ * request, where the core protocol needs XDisplayKeycodes, XGetKeyboardMapping
+ * and XGetModifierMapping.  The KeySyms are stored in the index (see
+ * keymap_index.c) in the core order the server reports them for
+ * XGetKeyboardMapping, so Keymap->keymap and saving work as before, and the
+ * key types and groups of each key go in its PerlXlib_keymap_xkb section.
+ * With those, a keycode and modifier state resolve to a KeySym the way
+ * XkbTranslateKeyCode does: the group comes from the state (wrapped, clamped
+ * or redirected into the groups of the key), and the level from the first
+ * active map entry of the key type of that group that matches the state.
+ *
+ * An XkbMapNotify names the ranges of KeySyms and modifier map keys that
+ * changed, and XkbGetMapChanges fetches just those in one request.  A change
+ * to the key types reloads everything, since it can change any key.
+ */
+
+#define XKB_TYPES(x)   ((PerlXlib_keymap_xkb_type*) ((x) + 1))
+#define XKB_ENTRIES(x) ((PerlXlib_keymap_xkb_entry*) (XKB_TYPES(x) + (x)->ntypes))
+
+static int xkb_group_width(const PerlXlib_keymap_xkb *xkb, int keycode, int group) {
+    int type= xkb->kt[keycode][group];
+    return type < xkb->ntypes? XKB_TYPES(xkb)[type].num_levels : 1;
+}
+
+/* Column of (group, level) in the core row of a key: levels 1-2 of groups 1
+ * and 2, then the other levels of group 1, of group 2, then groups 3 and 4.
+ */
+static int xkb_core_col(const PerlXlib_keymap_xkb *xkb, int keycode, int group, int level) {
+    int col= 4, i, w;
+    if (group < 2 && level < 2)
+        return group * 2 + level;
+    for (i= 0; i < group && i < 2; i++)
+        if ((w= xkb_group_width(xkb, keycode, i)) > 2)
+            col += w - 2;
+    if (group < 2)
+        return col + level - 2;
+    for (i= 2; i < group; i++)
+        col += xkb_group_width(xkb, keycode, i);
+    return col + level;
+}
+
+/* Length of the core row of a key.  A key with one group repeats it as group 2. */
+static int xkb_core_width(const PerlXlib_keymap_xkb *xkb, int keycode) {
+    int ng= xkb->num_groups[keycode], w;
+    if (!ng) return 0;
+    w= xkb_core_col(xkb, keycode, ng - 1, xkb_group_width(xkb, keycode, ng - 1) - 1) + 1;
+    if (ng == 1 && w < 4)
+        w= w == 1? 3 : 4;
+    return w;
+}
+
+static void xkb_pack_key(XkbDescPtr desc, PerlXlib_keymap_xkb *xkb, int keycode) {
+    int g, ng= XkbKeyNumGroups(desc, keycode);
+    xkb->num_groups[keycode]= ng;
+    xkb->group_info[keycode]= XkbKeyGroupInfo(desc, keycode);
+    for (g= 0; g < XkbNumKbdGroups; g++)
+        xkb->kt[keycode][g]= g < ng? XkbKeyKeyTypeIndex(desc, keycode, g) : 0;
+}
+
+/* Write the key types of 'desc' and the groups of its keys to 'out' */
+static void xkb_pack_section(XkbDescPtr desc, SV *out) {
+    XkbClientMapPtr map= desc->map;
+    PerlXlib_keymap_xkb *xkb;
+    PerlXlib_keymap_xkb_type *type;
+    PerlXlib_keymap_xkb_entry *ent;
+    XkbKeyTypePtr kt;
+    int nentries= 0, i, j;
+    size_t size;
+    for (i= 0; i < map->num_types; i++)
+        nentries += map->types[i].map_count;
+    size= sizeof(*xkb) + map->num_types * sizeof(*type) + nentries * sizeof(*ent);
+    sv_setpvn(out, "", 0);
+    xkb= (PerlXlib_keymap_xkb*) SvGROW(out, size + 1);
+    memset(xkb, 0, size + 1);
+    SvCUR_set(out, size);
+    xkb->ntypes= map->num_types;
+    xkb->nentries= nentries;
+    type= XKB_TYPES(xkb);
+    ent= XKB_ENTRIES(xkb);
+    for (i= 0; i < map->num_types; i++) {
+        kt= map->types + i;
+        type->mods= kt->mods.mask;
+        type->num_levels= kt->num_levels;
+        type->first_entry= ent - XKB_ENTRIES(xkb);
+        type->map_count= kt->map_count;
+        type++;
+        for (j= 0; j < kt->map_count; j++, ent++) {
+            ent->mods= kt->map[j].mods.mask;
+            ent->level= kt->map[j].level;
+            ent->active= kt->map[j].active;
+            ent->preserve= kt->preserve? kt->preserve[j].mask : 0;
+        }
+    }
+    for (i= desc->min_key_code; i <= desc->max_key_code; i++)
+        xkb_pack_key(desc, xkb, i);
+}
+
+/* Core rows of keycodes first..last (allocated with Newx), and their width */
+static KeySym* xkb_core_rows(XkbDescPtr desc, const PerlXlib_keymap_xkb *xkb, int first, int last, int *nsym_out) {
+    KeySym *rows, *row;
+    int nsym= 1, i, g, l, w, ng;
+    for (i= first; i <= last; i++)
+        if ((w= xkb_core_width(xkb, i)) > nsym)
+            nsym= w;
+    Newxz(rows, (last - first + 1) * nsym + 1, KeySym);
+    for (i= first; i <= last; i++) {
+        row= rows + (i - first) * nsym;
+        ng= xkb->num_groups[i];
+        for (g= 0; g < ng; g++) {
+            w= xkb_group_width(xkb, i, g);
+            if (w > XkbKeyGroupsWidth(desc, i)) w= XkbKeyGroupsWidth(desc, i);
+            for (l= 0; l < w; l++)
+                row[xkb_core_col(xkb, i, g, l)]= XkbKeySymEntry(desc, i, l, g);
+        }
+        if (ng == 1)
+            for (l= 0; l < 2 && l + 2 < nsym; l++)
+                row[l + 2]= row[l];
+    }
+    *nsym_out= nsym;
+    return rows;
+}
+
+/* Core modifier map (allocated with Newx) from the modifier bits of each key.
+ * Returns max_keypermod.
+ */
+static int xkb_core_modmap(const unsigned char *keymods, int min, int max, KeyCode **out) {
+    int count[8], n= 0, i, m;
+    Zero(count, 8, int);
+    for (i= min; i <= max; i++)
+        for (m= 0; m < 8; m++)
+            if (keymods[i] & (1 << m) && ++count[m] > n)
+                n= count[m];
+    Newxz(*out, 8 * n + 1, KeyCode);
+    Zero(count, 8, int);
+    for (i= min; i <= max; i++)
+        for (m= 0; m < 8; m++)
+            if (keymods[i] & (1 << m))
+                (*out)[m * n + count[m]++]= i;
+    return n;
+}
+
+/* Load the keymap through XKB into 'out'.  Returns 0 if the server didn't
+ * answer with a complete map.
+ */
+int PerlXlib_keymap_index_load_xkb(Display *dpy, SV *out) {
+    XkbDescPtr desc;
+    SV *section;
+    KeySym *rows;
+    KeyCode *modmap;
+    int nsym, max_keypermod;
+    PerlXlib_ROUND_TRIP(dpy, XkbGetMap,
+        desc= XkbGetMap(dpy, XkbKeyTypesMask | XkbKeySymsMask | XkbModifierMapMask, XkbUseCoreKbd));
+    if (!desc)
+        return 0;
+    if (!desc->map || !desc->map->types || !desc->map->key_sym_map || !desc->map->modmap) {
+        XkbFreeKeyboard(desc, XkbAllComponentsMask, True);
+        return 0;
+    }
+    section= sv_2mortal(newSVpvn("", 0));
+    xkb_pack_section(desc, section);
+    rows= xkb_core_rows(desc, (PerlXlib_keymap_xkb*) SvPVX(section), desc->min_key_code, desc->max_key_code, &nsym);
+    max_keypermod= xkb_core_modmap(desc->map->modmap, desc->min_key_code, desc->max_key_code, &modmap);
+    PerlXlib_keymap_index_build(out, rows, desc->min_key_code, desc->max_key_code, nsym, modmap, max_keypermod);
+    PerlXlib_keymap_index_attach_xkb(out, SvPVX(section), SvCUR(section));
+    Safefree(rows);
+    Safefree(modmap);
+    XkbFreeKeyboard(desc, XkbAllComponentsMask, True);
+    return 1;
+}
+
+/* Bring 'n' indexes up to date with the server after a change to the key
+ * types (which reloads everything), to the KeySyms of keycodes
+ * first_sym..last_sym, and to the modifiers of keycodes first_mod..last_mod.
+ * Indexes without an XKB section only get the new rows and modifier map.
+ * After a key type change, indexes with one are replaced outright, so an
+ * index with local changes should not be passed for that (Keymap.pm merges
+ * them back itself).  Returns 0 if the server couldn't be queried.
+ */
+int PerlXlib_keymap_index_reload_xkb(Display *dpy, int types, int first_sym, int last_sym,
+    int first_mod, int last_mod, SV **idx, int n
+) {
+    PerlXlib_keymap_index *ki;
+    PerlXlib_keymap_xkb *xkb= NULL, *fresh_xkb;
+    XkbMapChangesRec changes;
+    XkbDescPtr desc;
+    SV *fresh= NULL;
+    KeySym *rows;
+    KeyCode *modmap;
+    const KeyCode *mm;
+    unsigned char keymods[256];
+    int i, j, k, nsym, max_keypermod;
+    Status status;
+
+    if (n < 1)
+        return 1;
+    /* The key types are only in the XKB section, so without one, load it all */
+    for (i= 0; i < n && !xkb; i++)
+        xkb= KMIDX_XKB((PerlXlib_keymap_index*) SvPVX(idx[i]));
+    if (types || !xkb) {
+        fresh= sv_2mortal(newSVpvn("", 0));
+        if (!PerlXlib_keymap_index_load_xkb(dpy, fresh))
+            return 0;
+        ki= (PerlXlib_keymap_index*) SvPVX(fresh);
+        for (i= 0; i < n; i++) {
+            if (KMIDX_XKB((PerlXlib_keymap_index*) SvPVX(idx[i]))) {
+                sv_setsv(idx[i], fresh);
+                continue;
+            }
+            PerlXlib_keymap_index_update(idx[i], PerlXlib_keymap_index_rows(ki, ki->min_keycode),
+                ki->min_keycode, ki->max_keycode - ki->min_keycode + 1, ki->nsym);
+            PerlXlib_keymap_index_set_modmap(idx[i], KMIDX_MODMAP(ki), ki->max_keypermod);
+        }
+        return 1;
+    }
+
+    ki= (PerlXlib_keymap_index*) SvPVX(idx[0]);
+    if (first_sym < ki->min_keycode) first_sym= ki->min_keycode;
+    if (last_sym > ki->max_keycode)  last_sym= ki->max_keycode;
+    if (first_mod < ki->min_keycode) first_mod= ki->min_keycode;
+    if (last_mod > ki->max_keycode)  last_mod= ki->max_keycode;
+    Zero(&changes, 1, XkbMapChangesRec);
+    if (first_sym <= last_sym) {
+        changes.changed |= XkbKeySymsMask;
+        changes.first_key_sym= first_sym;
+        changes.num_key_syms= last_sym - first_sym + 1;
+    }
+    if (first_mod <= last_mod) {
+        changes.changed |= XkbModifierMapMask;
+        changes.first_modmap_key= first_mod;
+        changes.num_modmap_keys= last_mod - first_mod + 1;
+    }
+    if (!changes.changed)
+        return 1;
+    if (!(desc= XkbAllocKeyboard()))
+        return 0;
+    desc->dpy= dpy;
+    desc->device_spec= XkbUseCoreKbd;
+    desc->min_key_code= ki->min_keycode;
+    desc->max_key_code= ki->max_keycode;
+    PerlXlib_ROUND_TRIP(dpy, XkbGetMapChanges, status= XkbGetMapChanges(dpy, desc, &changes));
+    if (status != Success || !desc->map
+        || ((changes.changed & XkbKeySymsMask) && !desc->map->key_sym_map)
+        || ((changes.changed & XkbModifierMapMask) && !desc->map->modmap)
+    ) {
+        XkbFreeKeyboard(desc, XkbAllComponentsMask, True);
+        return 0;
+    }
+
+    if (changes.changed & XkbKeySymsMask) {
+        /* New groups of the keys, with the key types already known */
+        fresh= sv_2mortal(newSVpvn((char*) xkb, sizeof(*xkb)
+            + xkb->ntypes * sizeof(PerlXlib_keymap_xkb_type) + xkb->nentries * sizeof(PerlXlib_keymap_xkb_entry)));
+        fresh_xkb= (PerlXlib_keymap_xkb*) SvPVX(fresh);
+        for (i= first_sym; i <= last_sym; i++)
+            xkb_pack_key(desc, fresh_xkb, i);
+        rows= xkb_core_rows(desc, fresh_xkb, first_sym, last_sym, &nsym);
+        for (i= 0; i < n; i++) {
+            PerlXlib_keymap_index_update(idx[i], rows, first_sym, last_sym - first_sym + 1, nsym);
+            if (!(xkb= KMIDX_XKB((PerlXlib_keymap_index*) SvPVX(idx[i]))))
+                continue;
+            for (j= first_sym; j <= last_sym; j++) {
+                xkb->num_groups[j]= fresh_xkb->num_groups[j];
+                xkb->group_info[j]= fresh_xkb->group_info[j];
+                Copy(fresh_xkb->kt[j], xkb->kt[j], 4, U8);
+            }
+        }
+        Safefree(rows);
+    }
+    if (changes.changed & XkbModifierMapMask) {
+        for (i= 0; i < n; i++) {
+            ki= (PerlXlib_keymap_index*) SvPVX(idx[i]);
+            mm= KMIDX_MODMAP(ki);
+            Zero(keymods, 256, unsigned char);
+            for (j= 0; j < 8; j++)
+                for (k= 0; k < ki->max_keypermod; k++)
+                    if (mm[j * ki->max_keypermod + k])
+                        keymods[mm[j * ki->max_keypermod + k]] |= 1 << j;
+            for (j= first_mod; j <= last_mod; j++)
+                keymods[j]= desc->map->modmap[j];
+            max_keypermod= xkb_core_modmap(keymods, 0, 255, &modmap);
+            PerlXlib_keymap_index_set_modmap(idx[i], modmap, max_keypermod);
+            Safefree(modmap);
+        }
+    }
+    XkbFreeKeyboard(desc, XkbAllComponentsMask, True);
+    return 1;
+}
+
+/* The group a state selects on a key, after the out-of-range rule of the key */
+static int xkb_effective_group(const PerlXlib_keymap_xkb *xkb, int keycode, unsigned state) {
+    int ng= xkb->num_groups[keycode], info= xkb->group_info[keycode];
+    int group= XkbGroupForCoreState(state);
+    if (group < ng)
+        return group;
+    switch (XkbOutOfRangeGroupAction(info)) {
+    case XkbClampIntoRange:
+        return ng - 1;
+    case XkbRedirectIntoRange:
+        group= XkbOutOfRangeGroupNumber(info);
+        return group < ng? group : 0;
+    }
+    return group % ng;
+}
+
+/* KeySym at (group, level) of a key, like XkbKeycodeToKeysym */
+KeySym PerlXlib_keymap_xkb_keysym(const PerlXlib_keymap_index *ki, int keycode, int group, int level) {
+    const PerlXlib_keymap_xkb *xkb= KMIDX_XKB(ki);
+    int width;
+    if (keycode < ki->min_keycode || keycode > ki->max_keycode || group < 0 || level < 0)
+        return NoSymbol;
+    if (!xkb || !xkb->num_groups[keycode])
+        return group < 2 && level < 2? PerlXlib_keymap_index_get(ki, keycode, group * 2 + level) : NoSymbol;
+    if (group >= xkb->num_groups[keycode])
+        return NoSymbol;
+    width= xkb_group_width(xkb, keycode, group);
+    if (level >= width) {
+        /* the core protocol always has two levels in groups 1 and 2 */
+        if (group > 1 || width != 1 || level != 1)
+            return NoSymbol;
+        level= 0;
+    }
+    return PerlXlib_keymap_index_get(ki, keycode, xkb_core_col(xkb, keycode, group, level));
+}
+
+/* KeySym of a key under a modifier and group state, like XkbTranslateKeyCode,
+ * and with Caps Lock applied if the key type doesn't use Lock.
+ */
+KeySym PerlXlib_keymap_xkb_translate(const PerlXlib_keymap_index *ki, int keycode, unsigned state) {
+    const PerlXlib_keymap_xkb *xkb= KMIDX_XKB(ki);
+    const PerlXlib_keymap_xkb_type *type;
+    const PerlXlib_keymap_xkb_entry *ent;
+    KeySym sym, lower, upper;
+    int group, level= 0, consumed, i;
+    if (!xkb || keycode < ki->min_keycode || keycode > ki->max_keycode || !xkb->num_groups[keycode])
+        return NoSymbol;
+    group= xkb_effective_group(xkb, keycode, state);
+    if (xkb->kt[keycode][group] >= xkb->ntypes)
+        return NoSymbol;
+    type= XKB_TYPES(xkb) + xkb->kt[keycode][group];
+    consumed= type->mods;
+    ent= XKB_ENTRIES(xkb) + type->first_entry;
+    for (i= 0; i < type->map_count; i++, ent++) {
+        if (ent->active && (state & type->mods) == ent->mods) {
+            level= ent->level;
+            consumed &= ~ent->preserve;
+            break;
+        }
+    }
+    sym= PerlXlib_keymap_index_get(ki, keycode, xkb_core_col(xkb, keycode, group, level));
+    if ((state & LockMask) && !(consumed & LockMask)) {
+        XConvertCase(sym, &lower, &upper);
+        sym= upper;
+    }
+    return sym;
+}
+
+/* State that selects core column 'col' of a key: the modifiers of the first
+ * active map entry for its level, and its group in bits 13-14.  Returns -1 if
+ * no state selects it (such as the copy of group 1 in a one-group key).
+ */
+int PerlXlib_keymap_xkb_key_mods(const PerlXlib_keymap_index *ki, int keycode, int col) {
+    const PerlXlib_keymap_xkb *xkb= KMIDX_XKB(ki);
+    const PerlXlib_keymap_xkb_type *type;
+    const PerlXlib_keymap_xkb_entry *ent;
+    int group, level, mods= -1, i;
+    if (!xkb || keycode < ki->min_keycode || keycode > ki->max_keycode)
+        return -1;
+    for (group= 0; group < xkb->num_groups[keycode]; group++)
+        for (level= 0; level < xkb_group_width(xkb, keycode, group); level++)
+            if (xkb_core_col(xkb, keycode, group, level) == col)
+                goto found;
+    return -1;
+found:
+    if (xkb->kt[keycode][group] >= xkb->ntypes)
+        return -1;
+    type= XKB_TYPES(xkb) + xkb->kt[keycode][group];
+    ent= XKB_ENTRIES(xkb) + type->first_entry;
+    for (i= 0; i < type->map_count && mods < 0; i++)
+        if (ent[i].active && ent[i].level == level)
+            mods= ent[i].mods;
+    /* the first level is what no entry matches, unless an entry takes no modifiers */
+    if (mods < 0 && level == 0) {
+        mods= 0;
+        for (i= 0; i < type->map_count; i++)
+            if (ent[i].active && ent[i].mods == 0 && ent[i].level != 0)
+                mods= -1;
+    }
+    return mods < 0? -1 : mods | (group << 13);
+}